@@ -0,0 +1,1590 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBBinaryCodec.h"
+#include "SpacetimeDBPropertyHelper.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
+#include "UObject/TextProperty.h"
+#include "UObject/SoftObjectPtr.h"
+#include "Misc/Crc.h"
+
+// The wire format is little-endian; values are copied straight from native memory
+static_assert(PLATFORM_LITTLE_ENDIAN, "SpacetimeDB binary property encoding assumes a little-endian platform");
+
+//============================
+// Writer / Reader
+//============================
+
+void FSpacetimeDBBinaryWriter::WriteBytes(const void* Data, int32 Num)
+{
+    if (Num <= 0)
+    {
+        return;
+    }
+
+    const int32 Start = Bytes.AddUninitialized(Num);
+    FMemory::Memcpy(Bytes.GetData() + Start, Data, Num);
+}
+
+void FSpacetimeDBBinaryWriter::WriteString(const FString& Value)
+{
+    FTCHARToUTF8 Utf8(*Value);
+    WriteUInt32(static_cast<uint32>(Utf8.Length()));
+    WriteBytes(Utf8.Get(), Utf8.Length());
+}
+
+void FSpacetimeDBBinaryWriter::WriteVarUInt64(uint64 Value)
+{
+    while (Value >= 0x80)
+    {
+        Bytes.Add(static_cast<uint8>(Value) | 0x80);
+        Value >>= 7;
+    }
+    Bytes.Add(static_cast<uint8>(Value));
+}
+
+bool FSpacetimeDBBinaryReader::ReadBytes(void* Out, int32 Num)
+{
+    if (bError || Num < 0 || Num > Size - Offset)
+    {
+        bError = true;
+        if (Num > 0)
+        {
+            FMemory::Memzero(Out, Num);
+        }
+        return false;
+    }
+
+    FMemory::Memcpy(Out, Data + Offset, Num);
+    Offset += Num;
+    return true;
+}
+
+FString FSpacetimeDBBinaryReader::ReadString()
+{
+    const uint32 Length = ReadUInt32();
+    if (bError || Length > static_cast<uint32>(Size - Offset))
+    {
+        bError = true;
+        return FString();
+    }
+
+    FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Offset), static_cast<int32>(Length));
+    Offset += static_cast<int32>(Length);
+    return FString(Converted.Length(), Converted.Get());
+}
+
+uint64 FSpacetimeDBBinaryReader::ReadVarUInt64()
+{
+    uint64 Value = 0;
+    for (int32 Shift = 0; Shift < 64; Shift += 7)
+    {
+        if (bError || Offset >= Size)
+        {
+            bError = true;
+            return 0;
+        }
+
+        const uint8 Byte = Data[Offset++];
+        Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+        if ((Byte & 0x80) == 0)
+        {
+            return Value;
+        }
+    }
+
+    // More than ten bytes can't be a valid 64-bit varint
+    bError = true;
+    return 0;
+}
+
+//============================
+// Helpers
+//============================
+
+static bool IsNumericTag(ESpacetimeDBPropertyType Tag)
+{
+    return Tag >= ESpacetimeDBPropertyType::Byte && Tag <= ESpacetimeDBPropertyType::Double;
+}
+
+static bool IsStringTag(ESpacetimeDBPropertyType Tag)
+{
+    return Tag == ESpacetimeDBPropertyType::String || Tag == ESpacetimeDBPropertyType::Name || Tag == ESpacetimeDBPropertyType::Text;
+}
+
+static const FNumericProperty* GetNumericProperty(const FProperty* Property)
+{
+    if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+    {
+        return EnumProp->GetUnderlyingProperty();
+    }
+    return CastField<FNumericProperty>(Property);
+}
+
+static void GatherStructFields(const UScriptStruct* Struct, TArray<const FProperty*, TInlineAllocator<16>>& OutFields)
+{
+    for (TFieldIterator<FProperty> It(Struct); It; ++It)
+    {
+        OutFields.Add(*It);
+    }
+}
+
+static FString GetObjectReferencePath(const FProperty* Property, const void* PropertyAddr)
+{
+    if (CastField<FSoftObjectProperty>(Property))
+    {
+        return static_cast<const FSoftObjectPtr*>(PropertyAddr)->ToString();
+    }
+
+    if (const FObjectPropertyBase* ObjProp = CastField<FObjectPropertyBase>(Property))
+    {
+        UObject* Object = ObjProp->GetObjectPropertyValue(PropertyAddr);
+        return Object ? Object->GetPathName() : FString();
+    }
+
+    return FString();
+}
+
+static bool SetObjectReferencePath(const FProperty* Property, void* PropertyAddr, const FString& ObjectPath)
+{
+    if (CastField<FSoftObjectProperty>(Property))
+    {
+        *static_cast<FSoftObjectPtr*>(PropertyAddr) = FSoftObjectPath(ObjectPath);
+        return true;
+    }
+
+    if (const FObjectPropertyBase* ObjProp = CastField<FObjectPropertyBase>(Property))
+    {
+        UObject* FoundObject = nullptr;
+        if (!ObjectPath.IsEmpty())
+        {
+            FoundObject = FindObject<UObject>(nullptr, *ObjectPath);
+            if (!FoundObject)
+            {
+                FoundObject = StaticLoadObject(ObjProp->PropertyClass, nullptr, *ObjectPath);
+            }
+        }
+        ObjProp->SetObjectPropertyValue(PropertyAddr, FoundObject);
+        return true;
+    }
+
+    return false;
+}
+
+/** Edits in an array or map delta; map keys are either updated (added if missing) or removed */
+enum class EDeltaOp : uint8
+{
+    Update = 0,
+    Insert = 1,
+    Remove = 2
+};
+
+/** A default-initialized value of a property in temporary memory */
+struct FScopedPropertyValue
+{
+    explicit FScopedPropertyValue(const FProperty* InProperty)
+        : Property(InProperty)
+        , Memory(FMemory::Malloc(FMath::Max(InProperty->GetSize(), 1), InProperty->GetMinAlignment()))
+    {
+        Property->InitializeValue(Memory);
+    }
+
+    ~FScopedPropertyValue()
+    {
+        Property->DestroyValue(Memory);
+        FMemory::Free(Memory);
+    }
+
+    FScopedPropertyValue(const FScopedPropertyValue&) = delete;
+    FScopedPropertyValue& operator=(const FScopedPropertyValue&) = delete;
+
+    const FProperty* Property;
+    void* Memory;
+};
+
+//============================
+// FSpacetimeDBBinaryCodec
+//============================
+
+ESpacetimeDBPropertyType FSpacetimeDBBinaryCodec::GetPropertyTypeTag(const FProperty* Property)
+{
+    if (!Property)
+    {
+        return ESpacetimeDBPropertyType::None;
+    }
+
+    if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+    {
+        return GetPropertyTypeTag(EnumProp->GetUnderlyingProperty());
+    }
+
+    if (Property->IsA<FBoolProperty>())
+    {
+        return ESpacetimeDBPropertyType::Bool;
+    }
+
+    if (const FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
+    {
+        if (Property->IsA<FByteProperty>())
+        {
+            return ESpacetimeDBPropertyType::Byte;
+        }
+        if (Property->IsA<FInt64Property>())
+        {
+            return ESpacetimeDBPropertyType::Int64;
+        }
+        if (Property->IsA<FUInt32Property>())
+        {
+            return ESpacetimeDBPropertyType::UInt32;
+        }
+        if (Property->IsA<FUInt64Property>())
+        {
+            return ESpacetimeDBPropertyType::UInt64;
+        }
+        if (Property->IsA<FFloatProperty>())
+        {
+            return ESpacetimeDBPropertyType::Float;
+        }
+        if (Property->IsA<FDoubleProperty>())
+        {
+            return ESpacetimeDBPropertyType::Double;
+        }
+
+        // int8, int16, uint16 and int32 are all carried as Int32
+        return NumericProp->IsFloatingPoint() ? ESpacetimeDBPropertyType::Double : ESpacetimeDBPropertyType::Int32;
+    }
+
+    if (Property->IsA<FStrProperty>())
+    {
+        return ESpacetimeDBPropertyType::String;
+    }
+    if (Property->IsA<FNameProperty>())
+    {
+        return ESpacetimeDBPropertyType::Name;
+    }
+    if (Property->IsA<FTextProperty>())
+    {
+        return ESpacetimeDBPropertyType::Text;
+    }
+
+    if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
+    {
+        const UScriptStruct* Struct = StructProp->Struct;
+        if (Struct == TBaseStructure<FVector>::Get())
+        {
+            return ESpacetimeDBPropertyType::Vector;
+        }
+        if (Struct == TBaseStructure<FRotator>::Get())
+        {
+            return ESpacetimeDBPropertyType::Rotator;
+        }
+        if (Struct == TBaseStructure<FQuat>::Get())
+        {
+            return ESpacetimeDBPropertyType::Quat;
+        }
+        if (Struct == TBaseStructure<FTransform>::Get())
+        {
+            return ESpacetimeDBPropertyType::Transform;
+        }
+        if (Struct == TBaseStructure<FColor>::Get())
+        {
+            return ESpacetimeDBPropertyType::Color;
+        }
+        return ESpacetimeDBPropertyType::Custom;
+    }
+
+    // Class references must be checked before the object property base they derive from
+    if (Property->IsA<FClassProperty>() || Property->IsA<FSoftClassProperty>())
+    {
+        return ESpacetimeDBPropertyType::ClassReference;
+    }
+    if (Property->IsA<FObjectPropertyBase>())
+    {
+        return ESpacetimeDBPropertyType::ObjectReference;
+    }
+
+    if (Property->IsA<FArrayProperty>())
+    {
+        return ESpacetimeDBPropertyType::Array;
+    }
+    if (Property->IsA<FMapProperty>())
+    {
+        return ESpacetimeDBPropertyType::Map;
+    }
+    if (Property->IsA<FSetProperty>())
+    {
+        return ESpacetimeDBPropertyType::Set;
+    }
+
+    return ESpacetimeDBPropertyType::None;
+}
+
+bool FSpacetimeDBBinaryCodec::EncodeProperty(const FProperty* Property, const void* PropertyAddr, TArray<uint8>& OutBytes)
+{
+    const ESpacetimeDBPropertyType Tag = GetPropertyTypeTag(Property);
+    if (Tag == ESpacetimeDBPropertyType::None || !PropertyAddr)
+    {
+        return false;
+    }
+
+    const int32 StartNum = OutBytes.Num();
+    FSpacetimeDBBinaryWriter Writer(OutBytes);
+    Writer.WriteUInt8(static_cast<uint8>(Tag));
+    if (!WritePayload(Property, PropertyAddr, Writer))
+    {
+        // Don't leave a partial value behind in a shared buffer
+        OutBytes.SetNum(StartNum, EAllowShrinking::No);
+        return false;
+    }
+    return true;
+}
+
+bool FSpacetimeDBBinaryCodec::DecodeProperty(const FProperty* Property, void* PropertyAddr, const uint8* Data, int32 Size)
+{
+    if (!Property || !PropertyAddr || !Data || Size <= 0)
+    {
+        return false;
+    }
+
+    FSpacetimeDBBinaryReader Reader(Data, Size);
+    const ESpacetimeDBPropertyType Tag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+    if (!ReadPayload(Property, PropertyAddr, Tag, Reader) || Reader.IsError())
+    {
+        return false;
+    }
+
+    if (!Reader.IsAtEnd())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBBinaryCodec: %d trailing bytes after value for property %s"),
+            Size - Reader.GetOffset(), *Property->GetName());
+    }
+    return true;
+}
+
+bool FSpacetimeDBBinaryCodec::EncodeProperty(const FSpacetimeDBPropertyDescriptor& Descriptor, const UObject* Object, TArray<uint8>& OutBytes)
+{
+    if (!Descriptor.BinaryEncode || !Object)
+    {
+        return EncodeProperty(Descriptor.Property, Object ? Descriptor.GetValuePtr(Object) : nullptr, OutBytes);
+    }
+
+    FSpacetimeDBBinaryWriter Writer(OutBytes);
+    Writer.WriteUInt8(static_cast<uint8>(Descriptor.TypeTag));
+    Descriptor.BinaryEncode(Object, Writer);
+    return true;
+}
+
+bool FSpacetimeDBBinaryCodec::DecodeProperty(const FSpacetimeDBPropertyDescriptor& Descriptor, UObject* Object, const uint8* Data, int32 Size)
+{
+    if (!Descriptor.BinaryDecode || !Object || !Data || Size <= 0 || static_cast<ESpacetimeDBPropertyType>(Data[0]) != Descriptor.TypeTag)
+    {
+        // Widened or narrowed values go through the reflection path, which converts them
+        return DecodeProperty(Descriptor.Property, Object ? Descriptor.GetValuePtr(Object) : nullptr, Data, Size);
+    }
+
+    FSpacetimeDBBinaryReader Reader(Data + 1, Size - 1);
+    Descriptor.BinaryDecode(Object, Reader);
+    if (Reader.IsError())
+    {
+        return false;
+    }
+
+    if (!Reader.IsAtEnd())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBBinaryCodec: %d trailing bytes after value for property %s"),
+            Reader.Size - Reader.GetOffset(), *Descriptor.Name.ToString());
+    }
+    return true;
+}
+
+bool FSpacetimeDBBinaryCodec::SerializePropertyToBinary(UObject* Object, const FString& PropertyName, TArray<uint8>& OutBytes)
+{
+    OutBytes.Reset();
+
+    if (!Object)
+    {
+        return false;
+    }
+
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName);
+    if (!Descriptor)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBBinaryCodec: Property %s not found in object %s"), *PropertyName, *Object->GetName());
+        return false;
+    }
+
+    if (!EncodeProperty(*Descriptor, Object, OutBytes))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBBinaryCodec: Unsupported property type for binary encoding: %s"), *PropertyName);
+        return false;
+    }
+    return true;
+}
+
+bool FSpacetimeDBBinaryCodec::ApplyBinaryToProperty(UObject* Object, const FString& PropertyName, const uint8* Data, int32 Size)
+{
+    if (!Object)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBBinaryCodec: Cannot apply property update to null object. Property: %s"), *PropertyName);
+        return false;
+    }
+
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName);
+    if (!Descriptor)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBBinaryCodec: Property not found: %s on object %s"), *PropertyName, *Object->GetName());
+        return false;
+    }
+
+    return ApplyBinaryToDescriptor(*Descriptor, Object, Data, Size);
+}
+
+bool FSpacetimeDBBinaryCodec::ApplyBinaryToProperty(UObject* Object, FName PropertyName, const uint8* Data, int32 Size)
+{
+    if (!Object)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBBinaryCodec: Cannot apply property update to null object. Property: %s"), *PropertyName.ToString());
+        return false;
+    }
+
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName);
+    if (!Descriptor)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBBinaryCodec: Property not found: %s on object %s"), *PropertyName.ToString(), *Object->GetName());
+        return false;
+    }
+
+    return ApplyBinaryToDescriptor(*Descriptor, Object, Data, Size);
+}
+
+bool FSpacetimeDBBinaryCodec::ApplyBinaryToDescriptor(const FSpacetimeDBPropertyDescriptor& Descriptor, UObject* Object, const uint8* Data, int32 Size)
+{
+    if (IsDelta(Data, Size))
+    {
+        if (ApplyDelta(Descriptor, Object, Data, Size) != ESpacetimeDBDeltaResult::Applied)
+        {
+            return false;
+        }
+    }
+    else if (!DecodeProperty(Descriptor, Object, Data, Size))
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBBinaryCodec: Failed to decode %d bytes for property %s on object %s"),
+            Size, *Descriptor.Name.ToString(), *Object->GetName());
+        return false;
+    }
+
+    FSpacetimeDBPropertyHelper::InvokeRepNotify(Object, Descriptor);
+    return true;
+}
+
+bool FSpacetimeDBBinaryCodec::DecodePropertyValue(const uint8* Data, int32 Size, FSpacetimeDBCompactPropertyValue& OutValue)
+{
+    OutValue.Reset();
+    if (!Data || Size <= 0)
+    {
+        return false;
+    }
+
+    // A delta only makes sense against the receiver's value, so listeners just get its type
+    if (IsDelta(Data, Size))
+    {
+        const ESpacetimeDBPropertyType DeltaType = static_cast<ESpacetimeDBPropertyType>(Data[0] & ~DeltaTagFlag);
+        if (DeltaType >= ESpacetimeDBPropertyType::None)
+        {
+            return false;
+        }
+        OutValue.SetTypeOnly(DeltaType);
+        return true;
+    }
+
+    FSpacetimeDBBinaryReader Reader(Data, Size);
+    const ESpacetimeDBPropertyType Tag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+    if (Tag > ESpacetimeDBPropertyType::None)
+    {
+        return false;
+    }
+
+    switch (Tag)
+    {
+    case ESpacetimeDBPropertyType::Bool:
+        OutValue.SetBool(Reader.ReadUInt8() != 0);
+        break;
+    case ESpacetimeDBPropertyType::Byte:
+        OutValue.SetByte(Reader.ReadUInt8());
+        break;
+    case ESpacetimeDBPropertyType::Int32:
+        OutValue.SetInt32(Reader.ReadInt32());
+        break;
+    case ESpacetimeDBPropertyType::Int64:
+        OutValue.SetInt64(Reader.ReadInt64());
+        break;
+    case ESpacetimeDBPropertyType::UInt32:
+        OutValue.SetUInt32(Reader.ReadUInt32());
+        break;
+    case ESpacetimeDBPropertyType::UInt64:
+        OutValue.SetUInt64(Reader.ReadUInt64());
+        break;
+    case ESpacetimeDBPropertyType::Float:
+        OutValue.SetFloat(Reader.ReadFloat());
+        break;
+    case ESpacetimeDBPropertyType::Double:
+        OutValue.SetDouble(Reader.ReadDouble());
+        break;
+    case ESpacetimeDBPropertyType::String:
+    case ESpacetimeDBPropertyType::Name:
+    case ESpacetimeDBPropertyType::Text:
+    case ESpacetimeDBPropertyType::ObjectReference:
+    case ESpacetimeDBPropertyType::ClassReference:
+        // Object references travel as paths, so they are reported as strings
+        OutValue.SetString(Tag, Reader.ReadString());
+        break;
+    case ESpacetimeDBPropertyType::Vector:
+        {
+            FVector Vector;
+            Vector.X = Reader.ReadFloat();
+            Vector.Y = Reader.ReadFloat();
+            Vector.Z = Reader.ReadFloat();
+            OutValue.SetVector(Vector);
+        }
+        break;
+    case ESpacetimeDBPropertyType::Rotator:
+        {
+            FRotator Rotator;
+            Rotator.Pitch = Reader.ReadFloat();
+            Rotator.Yaw = Reader.ReadFloat();
+            Rotator.Roll = Reader.ReadFloat();
+            OutValue.SetRotator(Rotator);
+        }
+        break;
+    case ESpacetimeDBPropertyType::Quat:
+        {
+            FQuat Quat;
+            Quat.X = Reader.ReadFloat();
+            Quat.Y = Reader.ReadFloat();
+            Quat.Z = Reader.ReadFloat();
+            Quat.W = Reader.ReadFloat();
+            OutValue.SetQuat(Quat);
+        }
+        break;
+    case ESpacetimeDBPropertyType::Transform:
+        {
+            FVector Location, Scale;
+            FQuat Rotation;
+            Location.X = Reader.ReadFloat();
+            Location.Y = Reader.ReadFloat();
+            Location.Z = Reader.ReadFloat();
+            Rotation.X = Reader.ReadFloat();
+            Rotation.Y = Reader.ReadFloat();
+            Rotation.Z = Reader.ReadFloat();
+            Rotation.W = Reader.ReadFloat();
+            Scale.X = Reader.ReadFloat();
+            Scale.Y = Reader.ReadFloat();
+            Scale.Z = Reader.ReadFloat();
+            OutValue.SetTransform(FTransform(Rotation, Location, Scale));
+        }
+        break;
+    case ESpacetimeDBPropertyType::Color:
+        {
+            FColor Color;
+            Color.R = Reader.ReadUInt8();
+            Color.G = Reader.ReadUInt8();
+            Color.B = Reader.ReadUInt8();
+            Color.A = Reader.ReadUInt8();
+            OutValue.SetColor(Color);
+        }
+        break;
+    default:
+        // Containers and custom structs: type only
+        OutValue.SetTypeOnly(Tag);
+        break;
+    }
+
+    return !Reader.IsError();
+}
+
+bool FSpacetimeDBBinaryCodec::DecodePropertyValue(const uint8* Data, int32 Size, FSpacetimeDBPropertyValue& OutValue)
+{
+    FSpacetimeDBCompactPropertyValue Compact;
+    const bool bDecoded = DecodePropertyValue(Data, Size, Compact);
+    Compact.ToPropertyValue(OutValue);
+    return bDecoded;
+}
+
+bool FSpacetimeDBBinaryCodec::WritePayload(const FProperty* Property, const void* PropertyAddr, FSpacetimeDBBinaryWriter& Writer)
+{
+    const ESpacetimeDBPropertyType Tag = GetPropertyTypeTag(Property);
+
+    switch (Tag)
+    {
+    case ESpacetimeDBPropertyType::Bool:
+        Writer.WriteUInt8(CastFieldChecked<const FBoolProperty>(Property)->GetPropertyValue(PropertyAddr) ? 1 : 0);
+        return true;
+    case ESpacetimeDBPropertyType::Byte:
+        Writer.WriteUInt8(static_cast<uint8>(GetNumericProperty(Property)->GetUnsignedIntPropertyValue(PropertyAddr)));
+        return true;
+    case ESpacetimeDBPropertyType::Int32:
+        Writer.WriteInt32(static_cast<int32>(GetNumericProperty(Property)->GetSignedIntPropertyValue(PropertyAddr)));
+        return true;
+    case ESpacetimeDBPropertyType::Int64:
+        Writer.WriteInt64(GetNumericProperty(Property)->GetSignedIntPropertyValue(PropertyAddr));
+        return true;
+    case ESpacetimeDBPropertyType::UInt32:
+        Writer.WriteUInt32(static_cast<uint32>(GetNumericProperty(Property)->GetUnsignedIntPropertyValue(PropertyAddr)));
+        return true;
+    case ESpacetimeDBPropertyType::UInt64:
+        Writer.WriteUInt64(GetNumericProperty(Property)->GetUnsignedIntPropertyValue(PropertyAddr));
+        return true;
+    case ESpacetimeDBPropertyType::Float:
+        Writer.WriteFloat(static_cast<float>(GetNumericProperty(Property)->GetFloatingPointPropertyValue(PropertyAddr)));
+        return true;
+    case ESpacetimeDBPropertyType::Double:
+        Writer.WriteDouble(GetNumericProperty(Property)->GetFloatingPointPropertyValue(PropertyAddr));
+        return true;
+    case ESpacetimeDBPropertyType::String:
+        Writer.WriteString(*static_cast<const FString*>(PropertyAddr));
+        return true;
+    case ESpacetimeDBPropertyType::Name:
+        Writer.WriteString(static_cast<const FName*>(PropertyAddr)->ToString());
+        return true;
+    case ESpacetimeDBPropertyType::Text:
+        Writer.WriteString(static_cast<const FText*>(PropertyAddr)->ToString());
+        return true;
+    case ESpacetimeDBPropertyType::Vector:
+        {
+            const FVector& Vector = *static_cast<const FVector*>(PropertyAddr);
+            Writer.WriteFloat(static_cast<float>(Vector.X));
+            Writer.WriteFloat(static_cast<float>(Vector.Y));
+            Writer.WriteFloat(static_cast<float>(Vector.Z));
+        }
+        return true;
+    case ESpacetimeDBPropertyType::Rotator:
+        {
+            const FRotator& Rotator = *static_cast<const FRotator*>(PropertyAddr);
+            Writer.WriteFloat(static_cast<float>(Rotator.Pitch));
+            Writer.WriteFloat(static_cast<float>(Rotator.Yaw));
+            Writer.WriteFloat(static_cast<float>(Rotator.Roll));
+        }
+        return true;
+    case ESpacetimeDBPropertyType::Quat:
+        {
+            const FQuat& Quat = *static_cast<const FQuat*>(PropertyAddr);
+            Writer.WriteFloat(static_cast<float>(Quat.X));
+            Writer.WriteFloat(static_cast<float>(Quat.Y));
+            Writer.WriteFloat(static_cast<float>(Quat.Z));
+            Writer.WriteFloat(static_cast<float>(Quat.W));
+        }
+        return true;
+    case ESpacetimeDBPropertyType::Transform:
+        {
+            const FTransform& Transform = *static_cast<const FTransform*>(PropertyAddr);
+            const FVector Location = Transform.GetLocation();
+            const FQuat Rotation = Transform.GetRotation();
+            const FVector Scale = Transform.GetScale3D();
+            Writer.WriteFloat(static_cast<float>(Location.X));
+            Writer.WriteFloat(static_cast<float>(Location.Y));
+            Writer.WriteFloat(static_cast<float>(Location.Z));
+            Writer.WriteFloat(static_cast<float>(Rotation.X));
+            Writer.WriteFloat(static_cast<float>(Rotation.Y));
+            Writer.WriteFloat(static_cast<float>(Rotation.Z));
+            Writer.WriteFloat(static_cast<float>(Rotation.W));
+            Writer.WriteFloat(static_cast<float>(Scale.X));
+            Writer.WriteFloat(static_cast<float>(Scale.Y));
+            Writer.WriteFloat(static_cast<float>(Scale.Z));
+        }
+        return true;
+    case ESpacetimeDBPropertyType::Color:
+        {
+            // FColor is stored BGRA in memory; the wire order is RGBA
+            const FColor& Color = *static_cast<const FColor*>(PropertyAddr);
+            Writer.WriteUInt8(Color.R);
+            Writer.WriteUInt8(Color.G);
+            Writer.WriteUInt8(Color.B);
+            Writer.WriteUInt8(Color.A);
+        }
+        return true;
+    case ESpacetimeDBPropertyType::ObjectReference:
+    case ESpacetimeDBPropertyType::ClassReference:
+        Writer.WriteString(GetObjectReferencePath(Property, PropertyAddr));
+        return true;
+    case ESpacetimeDBPropertyType::Array:
+        {
+            const FArrayProperty* ArrayProp = CastFieldChecked<const FArrayProperty>(Property);
+            const ESpacetimeDBPropertyType InnerTag = GetPropertyTypeTag(ArrayProp->Inner);
+            if (InnerTag == ESpacetimeDBPropertyType::None)
+            {
+                return false;
+            }
+
+            FScriptArrayHelper ArrayHelper(ArrayProp, PropertyAddr);
+            Writer.WriteUInt8(static_cast<uint8>(InnerTag));
+            Writer.WriteUInt32(static_cast<uint32>(ArrayHelper.Num()));
+            for (int32 i = 0; i < ArrayHelper.Num(); ++i)
+            {
+                if (!WritePayload(ArrayProp->Inner, ArrayHelper.GetRawPtr(i), Writer))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    case ESpacetimeDBPropertyType::Set:
+        {
+            const FSetProperty* SetProp = CastFieldChecked<const FSetProperty>(Property);
+            const ESpacetimeDBPropertyType ElementTag = GetPropertyTypeTag(SetProp->ElementProp);
+            if (ElementTag == ESpacetimeDBPropertyType::None)
+            {
+                return false;
+            }
+
+            FScriptSetHelper SetHelper(SetProp, PropertyAddr);
+            Writer.WriteUInt8(static_cast<uint8>(ElementTag));
+            Writer.WriteUInt32(static_cast<uint32>(SetHelper.Num()));
+            for (int32 i = 0; i < SetHelper.GetMaxIndex(); ++i)
+            {
+                if (SetHelper.IsValidIndex(i) && !WritePayload(SetProp->ElementProp, SetHelper.GetElementPtr(i), Writer))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    case ESpacetimeDBPropertyType::Map:
+        {
+            const FMapProperty* MapProp = CastFieldChecked<const FMapProperty>(Property);
+            const ESpacetimeDBPropertyType KeyTag = GetPropertyTypeTag(MapProp->KeyProp);
+            const ESpacetimeDBPropertyType ValueTag = GetPropertyTypeTag(MapProp->ValueProp);
+            if (KeyTag == ESpacetimeDBPropertyType::None || ValueTag == ESpacetimeDBPropertyType::None)
+            {
+                return false;
+            }
+
+            FScriptMapHelper MapHelper(MapProp, PropertyAddr);
+            Writer.WriteUInt8(static_cast<uint8>(KeyTag));
+            Writer.WriteUInt8(static_cast<uint8>(ValueTag));
+            Writer.WriteUInt32(static_cast<uint32>(MapHelper.Num()));
+            for (int32 i = 0; i < MapHelper.GetMaxIndex(); ++i)
+            {
+                if (!MapHelper.IsValidIndex(i))
+                {
+                    continue;
+                }
+                if (!WritePayload(MapProp->KeyProp, MapHelper.GetKeyPtr(i), Writer) ||
+                    !WritePayload(MapProp->ValueProp, MapHelper.GetValuePtr(i), Writer))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    case ESpacetimeDBPropertyType::Custom:
+        {
+            const FStructProperty* StructProp = CastFieldChecked<const FStructProperty>(Property);
+            TArray<const FProperty*, TInlineAllocator<16>> Fields;
+            GatherStructFields(StructProp->Struct, Fields);
+
+            Writer.WriteUInt16(static_cast<uint16>(Fields.Num()));
+            for (const FProperty* Field : Fields)
+            {
+                const ESpacetimeDBPropertyType FieldTag = GetPropertyTypeTag(Field);
+                if (FieldTag == ESpacetimeDBPropertyType::None)
+                {
+                    return false;
+                }
+                Writer.WriteUInt8(static_cast<uint8>(FieldTag));
+                if (!WritePayload(Field, Field->ContainerPtrToValuePtr<void>(PropertyAddr), Writer))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool FSpacetimeDBBinaryCodec::ReadPayload(const FProperty* Property, void* PropertyAddr, ESpacetimeDBPropertyType Tag, FSpacetimeDBBinaryReader& Reader)
+{
+    // Numeric values are accepted into any numeric property so the server may widen or narrow types
+    if (IsNumericTag(Tag))
+    {
+        const FNumericProperty* NumericProp = GetNumericProperty(Property);
+        if (!NumericProp)
+        {
+            return false;
+        }
+
+        int64 IntValue = 0;
+        uint64 UnsignedValue = 0;
+        double FloatValue = 0.0;
+        bool bIsFloat = false;
+        bool bIsUnsigned = false;
+
+        switch (Tag)
+        {
+        case ESpacetimeDBPropertyType::Byte:   IntValue = Reader.ReadUInt8(); break;
+        case ESpacetimeDBPropertyType::Int32:  IntValue = Reader.ReadInt32(); break;
+        case ESpacetimeDBPropertyType::Int64:  IntValue = Reader.ReadInt64(); break;
+        case ESpacetimeDBPropertyType::UInt32: IntValue = Reader.ReadUInt32(); break;
+        case ESpacetimeDBPropertyType::UInt64: UnsignedValue = Reader.ReadUInt64(); bIsUnsigned = true; break;
+        case ESpacetimeDBPropertyType::Float:  FloatValue = Reader.ReadFloat(); bIsFloat = true; break;
+        case ESpacetimeDBPropertyType::Double: FloatValue = Reader.ReadDouble(); bIsFloat = true; break;
+        default: break;
+        }
+
+        if (Reader.IsError())
+        {
+            return false;
+        }
+
+        if (NumericProp->IsFloatingPoint())
+        {
+            const double Value = bIsFloat ? FloatValue : (bIsUnsigned ? static_cast<double>(UnsignedValue) : static_cast<double>(IntValue));
+            NumericProp->SetFloatingPointPropertyValue(PropertyAddr, Value);
+        }
+        else if (bIsUnsigned)
+        {
+            NumericProp->SetIntPropertyValue(PropertyAddr, UnsignedValue);
+        }
+        else
+        {
+            NumericProp->SetIntPropertyValue(PropertyAddr, bIsFloat ? static_cast<int64>(FloatValue) : IntValue);
+        }
+        return true;
+    }
+
+    // String, Name and Text are interchangeable on the wire
+    if (IsStringTag(Tag))
+    {
+        const FString Value = Reader.ReadString();
+        if (Reader.IsError())
+        {
+            return false;
+        }
+
+        if (Property->IsA<FStrProperty>())
+        {
+            *static_cast<FString*>(PropertyAddr) = Value;
+        }
+        else if (Property->IsA<FNameProperty>())
+        {
+            *static_cast<FName*>(PropertyAddr) = FName(*Value);
+        }
+        else if (Property->IsA<FTextProperty>())
+        {
+            *static_cast<FText*>(PropertyAddr) = FText::FromString(Value);
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    // Everything else must match the property's own tag
+    if (GetPropertyTypeTag(Property) != Tag)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBBinaryCodec: Type tag %d does not match property %s"),
+            static_cast<int32>(Tag), *Property->GetName());
+        return false;
+    }
+
+    switch (Tag)
+    {
+    case ESpacetimeDBPropertyType::Bool:
+        CastFieldChecked<const FBoolProperty>(Property)->SetPropertyValue(PropertyAddr, Reader.ReadUInt8() != 0);
+        break;
+    case ESpacetimeDBPropertyType::Vector:
+        {
+            FVector& Vector = *static_cast<FVector*>(PropertyAddr);
+            Vector.X = Reader.ReadFloat();
+            Vector.Y = Reader.ReadFloat();
+            Vector.Z = Reader.ReadFloat();
+        }
+        break;
+    case ESpacetimeDBPropertyType::Rotator:
+        {
+            FRotator& Rotator = *static_cast<FRotator*>(PropertyAddr);
+            Rotator.Pitch = Reader.ReadFloat();
+            Rotator.Yaw = Reader.ReadFloat();
+            Rotator.Roll = Reader.ReadFloat();
+        }
+        break;
+    case ESpacetimeDBPropertyType::Quat:
+        {
+            FQuat& Quat = *static_cast<FQuat*>(PropertyAddr);
+            Quat.X = Reader.ReadFloat();
+            Quat.Y = Reader.ReadFloat();
+            Quat.Z = Reader.ReadFloat();
+            Quat.W = Reader.ReadFloat();
+        }
+        break;
+    case ESpacetimeDBPropertyType::Transform:
+        {
+            FVector Location, Scale;
+            FQuat Rotation;
+            Location.X = Reader.ReadFloat();
+            Location.Y = Reader.ReadFloat();
+            Location.Z = Reader.ReadFloat();
+            Rotation.X = Reader.ReadFloat();
+            Rotation.Y = Reader.ReadFloat();
+            Rotation.Z = Reader.ReadFloat();
+            Rotation.W = Reader.ReadFloat();
+            Scale.X = Reader.ReadFloat();
+            Scale.Y = Reader.ReadFloat();
+            Scale.Z = Reader.ReadFloat();
+            if (Reader.IsError())
+            {
+                return false;
+            }
+            static_cast<FTransform*>(PropertyAddr)->SetComponents(Rotation, Location, Scale);
+        }
+        break;
+    case ESpacetimeDBPropertyType::Color:
+        {
+            FColor& Color = *static_cast<FColor*>(PropertyAddr);
+            Color.R = Reader.ReadUInt8();
+            Color.G = Reader.ReadUInt8();
+            Color.B = Reader.ReadUInt8();
+            Color.A = Reader.ReadUInt8();
+        }
+        break;
+    case ESpacetimeDBPropertyType::ObjectReference:
+    case ESpacetimeDBPropertyType::ClassReference:
+        {
+            const FString ObjectPath = Reader.ReadString();
+            if (Reader.IsError())
+            {
+                return false;
+            }
+            return SetObjectReferencePath(Property, PropertyAddr, ObjectPath);
+        }
+    case ESpacetimeDBPropertyType::Array:
+        {
+            const FArrayProperty* ArrayProp = CastFieldChecked<const FArrayProperty>(Property);
+            const ESpacetimeDBPropertyType InnerTag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+            const uint32 Count = Reader.ReadUInt32();
+
+            // Every element takes at least one byte, which bounds the allocation for corrupt counts
+            if (Reader.IsError() || Count > static_cast<uint32>(Reader.Size - Reader.Offset))
+            {
+                return false;
+            }
+
+            FScriptArrayHelper ArrayHelper(ArrayProp, PropertyAddr);
+            ArrayHelper.EmptyValues();
+            ArrayHelper.Resize(static_cast<int32>(Count));
+            for (int32 i = 0; i < static_cast<int32>(Count); ++i)
+            {
+                if (!ReadPayload(ArrayProp->Inner, ArrayHelper.GetRawPtr(i), InnerTag, Reader))
+                {
+                    return false;
+                }
+            }
+        }
+        break;
+    case ESpacetimeDBPropertyType::Set:
+        {
+            const FSetProperty* SetProp = CastFieldChecked<const FSetProperty>(Property);
+            const ESpacetimeDBPropertyType ElementTag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+            const uint32 Count = Reader.ReadUInt32();
+            if (Reader.IsError() || Count > static_cast<uint32>(Reader.Size - Reader.Offset))
+            {
+                return false;
+            }
+
+            FScriptSetHelper SetHelper(SetProp, PropertyAddr);
+            SetHelper.EmptyElements();
+            for (uint32 i = 0; i < Count; ++i)
+            {
+                const int32 Index = SetHelper.AddDefaultValue_Invalid_NeedsRehash();
+                if (!ReadPayload(SetProp->ElementProp, SetHelper.GetElementPtr(Index), ElementTag, Reader))
+                {
+                    SetHelper.Rehash();
+                    return false;
+                }
+            }
+            SetHelper.Rehash();
+        }
+        break;
+    case ESpacetimeDBPropertyType::Map:
+        {
+            const FMapProperty* MapProp = CastFieldChecked<const FMapProperty>(Property);
+            const ESpacetimeDBPropertyType KeyTag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+            const ESpacetimeDBPropertyType ValueTag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+            const uint32 Count = Reader.ReadUInt32();
+            if (Reader.IsError() || Count > static_cast<uint32>(Reader.Size - Reader.Offset))
+            {
+                return false;
+            }
+
+            FScriptMapHelper MapHelper(MapProp, PropertyAddr);
+            MapHelper.EmptyValues();
+            for (uint32 i = 0; i < Count; ++i)
+            {
+                const int32 Index = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
+                if (!ReadPayload(MapProp->KeyProp, MapHelper.GetKeyPtr(Index), KeyTag, Reader) ||
+                    !ReadPayload(MapProp->ValueProp, MapHelper.GetValuePtr(Index), ValueTag, Reader))
+                {
+                    MapHelper.Rehash();
+                    return false;
+                }
+            }
+            MapHelper.Rehash();
+        }
+        break;
+    case ESpacetimeDBPropertyType::Custom:
+        {
+            const FStructProperty* StructProp = CastFieldChecked<const FStructProperty>(Property);
+            TArray<const FProperty*, TInlineAllocator<16>> Fields;
+            GatherStructFields(StructProp->Struct, Fields);
+
+            const uint16 FieldCount = Reader.ReadUInt16();
+            if (Reader.IsError() || FieldCount != Fields.Num())
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBBinaryCodec: Struct %s field count mismatch (%d on wire, %d local)"),
+                    *StructProp->Struct->GetName(), FieldCount, Fields.Num());
+                return false;
+            }
+
+            for (const FProperty* Field : Fields)
+            {
+                const ESpacetimeDBPropertyType FieldTag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+                if (!ReadPayload(Field, Field->ContainerPtrToValuePtr<void>(PropertyAddr), FieldTag, Reader))
+                {
+                    return false;
+                }
+            }
+        }
+        break;
+    default:
+        return false;
+    }
+
+    return !Reader.IsError();
+}
+
+//============================
+// Deltas
+//============================
+
+bool FSpacetimeDBBinaryCodec::SupportsDelta(const FProperty* Property)
+{
+    if (!Property || Property->ArrayDim != 1)
+    {
+        return false;
+    }
+
+    const ESpacetimeDBPropertyType Tag = GetPropertyTypeTag(Property);
+    return Tag == ESpacetimeDBPropertyType::Custom || Tag == ESpacetimeDBPropertyType::Array || Tag == ESpacetimeDBPropertyType::Map;
+}
+
+bool FSpacetimeDBBinaryCodec::EncodeDelta(const FProperty* Property, const uint8* BaseData, int32 BaseSize, const void* PropertyAddr, TArray<uint8>& OutBytes)
+{
+    if (!SupportsDelta(Property) || !PropertyAddr || !BaseData || BaseSize <= 0)
+    {
+        return false;
+    }
+
+    // The edits are computed against the decoded base, element by element
+    FScopedPropertyValue Base(Property);
+    if (!DecodeProperty(Property, Base.Memory, BaseData, BaseSize))
+    {
+        return false;
+    }
+
+    TArray<uint8> Scratch;
+    uint32 BaseChecksum = 0;
+    if (!ComputeChecksum(Property, Base.Memory, Scratch, BaseChecksum))
+    {
+        return false;
+    }
+
+    const int32 StartNum = OutBytes.Num();
+    FSpacetimeDBBinaryWriter Writer(OutBytes);
+    Writer.WriteUInt8(static_cast<uint8>(GetPropertyTypeTag(Property)) | DeltaTagFlag);
+    Writer.WriteUInt32(BaseChecksum);
+    if (!WriteDeltaPayload(Property, Base.Memory, PropertyAddr, Writer))
+    {
+        OutBytes.SetNum(StartNum, EAllowShrinking::No);
+        return false;
+    }
+    return true;
+}
+
+ESpacetimeDBDeltaResult FSpacetimeDBBinaryCodec::ApplyDelta(const FSpacetimeDBPropertyDescriptor& Descriptor, UObject* Object, const uint8* Data, int32 Size)
+{
+    if (!Object || !IsDelta(Data, Size) || !SupportsDelta(Descriptor.Property))
+    {
+        return ESpacetimeDBDeltaResult::Malformed;
+    }
+
+    FSpacetimeDBBinaryReader Reader(Data, Size);
+    const ESpacetimeDBPropertyType Tag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8() & ~DeltaTagFlag);
+    const uint32 BaseChecksum = Reader.ReadUInt32();
+    if (Reader.IsError() || Tag != Descriptor.TypeTag)
+    {
+        return ESpacetimeDBDeltaResult::Malformed;
+    }
+
+    // Equal values give the same checksum on both sides, even maps whose entries were added in another order
+    TArray<uint8> Scratch;
+    uint32 CurrentChecksum = 0;
+    if (!ComputeChecksum(Descriptor.Property, Descriptor.GetValuePtr(Object), Scratch, CurrentChecksum) || CurrentChecksum != BaseChecksum)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBBinaryCodec: Delta for property %s on object %s doesn't match the current value"),
+            *Descriptor.Name.ToString(), *Object->GetName());
+        return ESpacetimeDBDeltaResult::BaseMismatch;
+    }
+
+    if (!ReadDeltaPayload(Descriptor.Property, Descriptor.GetValuePtr(Object), Reader) || Reader.IsError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBBinaryCodec: Malformed delta for property %s on object %s"),
+            *Descriptor.Name.ToString(), *Object->GetName());
+        return ESpacetimeDBDeltaResult::Malformed;
+    }
+
+    if (!Reader.IsAtEnd())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBBinaryCodec: %d trailing bytes after delta for property %s"),
+            Size - Reader.GetOffset(), *Descriptor.Name.ToString());
+    }
+    return ESpacetimeDBDeltaResult::Applied;
+}
+
+bool FSpacetimeDBBinaryCodec::ComputeChecksum(const FProperty* Property, const void* PropertyAddr, TArray<uint8>& Scratch, uint32& OutChecksum)
+{
+    const ESpacetimeDBPropertyType Tag = GetPropertyTypeTag(Property);
+    const uint8 TagByte = static_cast<uint8>(Tag);
+    uint32 Checksum = FCrc::MemCrc32(&TagByte, sizeof(TagByte));
+
+    switch (Tag)
+    {
+    case ESpacetimeDBPropertyType::None:
+        return false;
+    case ESpacetimeDBPropertyType::Array:
+        {
+            const FArrayProperty* ArrayProp = CastFieldChecked<const FArrayProperty>(Property);
+            FScriptArrayHelper ArrayHelper(ArrayProp, PropertyAddr);
+            const uint32 Num = static_cast<uint32>(ArrayHelper.Num());
+            Checksum = FCrc::MemCrc32(&Num, sizeof(Num), Checksum);
+            for (int32 i = 0; i < ArrayHelper.Num(); ++i)
+            {
+                uint32 Element = 0;
+                if (!ComputeChecksum(ArrayProp->Inner, ArrayHelper.GetRawPtr(i), Scratch, Element))
+                {
+                    return false;
+                }
+                Checksum = FCrc::MemCrc32(&Element, sizeof(Element), Checksum);
+            }
+        }
+        break;
+    case ESpacetimeDBPropertyType::Set:
+        {
+            const FSetProperty* SetProp = CastFieldChecked<const FSetProperty>(Property);
+            FScriptSetHelper SetHelper(SetProp, PropertyAddr);
+            const uint32 Num = static_cast<uint32>(SetHelper.Num());
+            uint32 Sum = 0;
+            for (int32 i = 0; i < SetHelper.GetMaxIndex(); ++i)
+            {
+                uint32 Element = 0;
+                if (SetHelper.IsValidIndex(i))
+                {
+                    if (!ComputeChecksum(SetProp->ElementProp, SetHelper.GetElementPtr(i), Scratch, Element))
+                    {
+                        return false;
+                    }
+                    Sum += Element;
+                }
+            }
+            Checksum = FCrc::MemCrc32(&Num, sizeof(Num), Checksum);
+            Checksum = FCrc::MemCrc32(&Sum, sizeof(Sum), Checksum);
+        }
+        break;
+    case ESpacetimeDBPropertyType::Map:
+        {
+            const FMapProperty* MapProp = CastFieldChecked<const FMapProperty>(Property);
+            FScriptMapHelper MapHelper(MapProp, PropertyAddr);
+            const uint32 Num = static_cast<uint32>(MapHelper.Num());
+            uint32 Sum = 0;
+            for (int32 i = 0; i < MapHelper.GetMaxIndex(); ++i)
+            {
+                if (!MapHelper.IsValidIndex(i))
+                {
+                    continue;
+                }
+                uint32 Key = 0;
+                uint32 Value = 0;
+                if (!ComputeChecksum(MapProp->KeyProp, MapHelper.GetKeyPtr(i), Scratch, Key) ||
+                    !ComputeChecksum(MapProp->ValueProp, MapHelper.GetValuePtr(i), Scratch, Value))
+                {
+                    return false;
+                }
+                // Each entry keeps its key and value paired; only the entries themselves are unordered
+                Sum += FCrc::MemCrc32(&Value, sizeof(Value), Key);
+            }
+            Checksum = FCrc::MemCrc32(&Num, sizeof(Num), Checksum);
+            Checksum = FCrc::MemCrc32(&Sum, sizeof(Sum), Checksum);
+        }
+        break;
+    case ESpacetimeDBPropertyType::Custom:
+        {
+            const FStructProperty* StructProp = CastFieldChecked<const FStructProperty>(Property);
+            TArray<const FProperty*, TInlineAllocator<16>> Fields;
+            GatherStructFields(StructProp->Struct, Fields);
+            for (const FProperty* Field : Fields)
+            {
+                uint32 FieldChecksum = 0;
+                if (!ComputeChecksum(Field, Field->ContainerPtrToValuePtr<void>(PropertyAddr), Scratch, FieldChecksum))
+                {
+                    return false;
+                }
+                Checksum = FCrc::MemCrc32(&FieldChecksum, sizeof(FieldChecksum), Checksum);
+            }
+        }
+        break;
+    default:
+        {
+            Scratch.Reset();
+            FSpacetimeDBBinaryWriter Writer(Scratch);
+            if (!WritePayload(Property, PropertyAddr, Writer))
+            {
+                return false;
+            }
+            Checksum = FCrc::MemCrc32(Scratch.GetData(), Scratch.Num(), Checksum);
+        }
+        break;
+    }
+
+    OutChecksum = Checksum;
+    return true;
+}
+
+bool FSpacetimeDBBinaryCodec::WriteDeltaPayload(const FProperty* Property, const void* BaseAddr, const void* PropertyAddr, FSpacetimeDBBinaryWriter& Writer)
+{
+    switch (GetPropertyTypeTag(Property))
+    {
+    case ESpacetimeDBPropertyType::Custom:
+        {
+            const FStructProperty* StructProp = CastFieldChecked<const FStructProperty>(Property);
+            TArray<const FProperty*, TInlineAllocator<16>> Fields;
+            GatherStructFields(StructProp->Struct, Fields);
+
+            TArray<int32, TInlineAllocator<16>> ChangedFields;
+            for (int32 i = 0; i < Fields.Num(); ++i)
+            {
+                if (!Fields[i]->Identical(Fields[i]->ContainerPtrToValuePtr<void>(BaseAddr), Fields[i]->ContainerPtrToValuePtr<void>(PropertyAddr)))
+                {
+                    ChangedFields.Add(i);
+                }
+            }
+
+            // Changed fields are sent tagged and in full, like in a full Custom value
+            Writer.WriteUInt16(static_cast<uint16>(Fields.Num()));
+            Writer.WriteVarUInt64(ChangedFields.Num());
+            for (int32 FieldIndex : ChangedFields)
+            {
+                const FProperty* Field = Fields[FieldIndex];
+                const ESpacetimeDBPropertyType FieldTag = GetPropertyTypeTag(Field);
+                if (FieldTag == ESpacetimeDBPropertyType::None)
+                {
+                    return false;
+                }
+                Writer.WriteVarUInt64(FieldIndex);
+                Writer.WriteUInt8(static_cast<uint8>(FieldTag));
+                if (!WritePayload(Field, Field->ContainerPtrToValuePtr<void>(PropertyAddr), Writer))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    case ESpacetimeDBPropertyType::Array:
+        {
+            const FArrayProperty* ArrayProp = CastFieldChecked<const FArrayProperty>(Property);
+            const ESpacetimeDBPropertyType InnerTag = GetPropertyTypeTag(ArrayProp->Inner);
+            if (InnerTag == ESpacetimeDBPropertyType::None)
+            {
+                return false;
+            }
+
+            FScriptArrayHelper BaseHelper(ArrayProp, BaseAddr);
+            FScriptArrayHelper ArrayHelper(ArrayProp, PropertyAddr);
+            const int32 BaseNum = BaseHelper.Num();
+            const int32 Num = ArrayHelper.Num();
+            const int32 MinNum = FMath::Min(BaseNum, Num);
+
+            // Trim the common ends so a single insertion or removal doesn't shift every later slot
+            int32 Prefix = 0;
+            while (Prefix < MinNum && ArrayProp->Inner->Identical(BaseHelper.GetRawPtr(Prefix), ArrayHelper.GetRawPtr(Prefix)))
+            {
+                ++Prefix;
+            }
+            int32 Suffix = 0;
+            while (Suffix < MinNum - Prefix && ArrayProp->Inner->Identical(BaseHelper.GetRawPtr(BaseNum - 1 - Suffix), ArrayHelper.GetRawPtr(Num - 1 - Suffix)))
+            {
+                ++Suffix;
+            }
+
+            const int32 BaseMiddle = BaseNum - Prefix - Suffix;
+            const int32 Middle = Num - Prefix - Suffix;
+            const int32 Overlap = FMath::Min(BaseMiddle, Middle);
+
+            TArray<int32, TInlineAllocator<16>> Updated;
+            for (int32 i = Prefix; i < Prefix + Overlap; ++i)
+            {
+                if (!ArrayProp->Inner->Identical(BaseHelper.GetRawPtr(i), ArrayHelper.GetRawPtr(i)))
+                {
+                    Updated.Add(i);
+                }
+            }
+
+            Writer.WriteUInt8(static_cast<uint8>(InnerTag));
+            Writer.WriteUInt32(static_cast<uint32>(Num));
+            Writer.WriteVarUInt64(Updated.Num() + FMath::Abs(Middle - BaseMiddle));
+
+            for (int32 Index : Updated)
+            {
+                Writer.WriteUInt8(static_cast<uint8>(EDeltaOp::Update));
+                Writer.WriteVarUInt64(Index);
+                if (!WritePayload(ArrayProp->Inner, ArrayHelper.GetRawPtr(Index), Writer))
+                {
+                    return false;
+                }
+            }
+
+            // Whatever the overlap didn't cover is inserted or removed right after it
+            const int32 EditIndex = Prefix + Overlap;
+            for (int32 i = 0; i < Middle - BaseMiddle; ++i)
+            {
+                Writer.WriteUInt8(static_cast<uint8>(EDeltaOp::Insert));
+                Writer.WriteVarUInt64(EditIndex + i);
+                if (!WritePayload(ArrayProp->Inner, ArrayHelper.GetRawPtr(EditIndex + i), Writer))
+                {
+                    return false;
+                }
+            }
+            for (int32 i = 0; i < BaseMiddle - Middle; ++i)
+            {
+                Writer.WriteUInt8(static_cast<uint8>(EDeltaOp::Remove));
+                Writer.WriteVarUInt64(EditIndex);
+            }
+        }
+        return true;
+    case ESpacetimeDBPropertyType::Map:
+        {
+            const FMapProperty* MapProp = CastFieldChecked<const FMapProperty>(Property);
+            const ESpacetimeDBPropertyType KeyTag = GetPropertyTypeTag(MapProp->KeyProp);
+            const ESpacetimeDBPropertyType ValueTag = GetPropertyTypeTag(MapProp->ValueProp);
+            if (KeyTag == ESpacetimeDBPropertyType::None || ValueTag == ESpacetimeDBPropertyType::None)
+            {
+                return false;
+            }
+
+            FScriptMapHelper BaseHelper(MapProp, BaseAddr);
+            FScriptMapHelper MapHelper(MapProp, PropertyAddr);
+
+            TArray<int32, TInlineAllocator<16>> Removed;
+            for (int32 i = 0; i < BaseHelper.GetMaxIndex(); ++i)
+            {
+                if (BaseHelper.IsValidIndex(i) && MapHelper.FindMapIndexWithKey(BaseHelper.GetKeyPtr(i)) == INDEX_NONE)
+                {
+                    Removed.Add(i);
+                }
+            }
+
+            TArray<int32, TInlineAllocator<16>> Updated;
+            for (int32 i = 0; i < MapHelper.GetMaxIndex(); ++i)
+            {
+                if (!MapHelper.IsValidIndex(i))
+                {
+                    continue;
+                }
+                const int32 BaseIndex = BaseHelper.FindMapIndexWithKey(MapHelper.GetKeyPtr(i));
+                if (BaseIndex == INDEX_NONE || !MapProp->ValueProp->Identical(BaseHelper.GetValuePtr(BaseIndex), MapHelper.GetValuePtr(i)))
+                {
+                    Updated.Add(i);
+                }
+            }
+
+            Writer.WriteUInt8(static_cast<uint8>(KeyTag));
+            Writer.WriteUInt8(static_cast<uint8>(ValueTag));
+            Writer.WriteVarUInt64(Removed.Num() + Updated.Num());
+
+            for (int32 Index : Removed)
+            {
+                Writer.WriteUInt8(static_cast<uint8>(EDeltaOp::Remove));
+                if (!WritePayload(MapProp->KeyProp, BaseHelper.GetKeyPtr(Index), Writer))
+                {
+                    return false;
+                }
+            }
+            for (int32 Index : Updated)
+            {
+                Writer.WriteUInt8(static_cast<uint8>(EDeltaOp::Update));
+                if (!WritePayload(MapProp->KeyProp, MapHelper.GetKeyPtr(Index), Writer) ||
+                    !WritePayload(MapProp->ValueProp, MapHelper.GetValuePtr(Index), Writer))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool FSpacetimeDBBinaryCodec::ReadDeltaPayload(const FProperty* Property, void* PropertyAddr, FSpacetimeDBBinaryReader& Reader)
+{
+    switch (GetPropertyTypeTag(Property))
+    {
+    case ESpacetimeDBPropertyType::Custom:
+        {
+            const FStructProperty* StructProp = CastFieldChecked<const FStructProperty>(Property);
+            TArray<const FProperty*, TInlineAllocator<16>> Fields;
+            GatherStructFields(StructProp->Struct, Fields);
+
+            const uint16 FieldCount = Reader.ReadUInt16();
+            const uint64 NumChanged = Reader.ReadVarUInt64();
+            if (Reader.IsError() || FieldCount != Fields.Num() || NumChanged > static_cast<uint64>(Fields.Num()))
+            {
+                return false;
+            }
+
+            for (uint64 i = 0; i < NumChanged; ++i)
+            {
+                const uint64 FieldIndex = Reader.ReadVarUInt64();
+                const ESpacetimeDBPropertyType FieldTag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+                if (Reader.IsError() || FieldIndex >= static_cast<uint64>(Fields.Num()))
+                {
+                    return false;
+                }
+
+                const FProperty* Field = Fields[static_cast<int32>(FieldIndex)];
+                if (!ReadPayload(Field, Field->ContainerPtrToValuePtr<void>(PropertyAddr), FieldTag, Reader))
+                {
+                    return false;
+                }
+            }
+        }
+        break;
+    case ESpacetimeDBPropertyType::Array:
+        {
+            const FArrayProperty* ArrayProp = CastFieldChecked<const FArrayProperty>(Property);
+            const ESpacetimeDBPropertyType InnerTag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+            const uint32 FinalCount = Reader.ReadUInt32();
+            const uint64 NumOps = Reader.ReadVarUInt64();
+
+            // Every op takes at least two bytes, which bounds the loop for corrupt counts
+            if (Reader.IsError() || NumOps > static_cast<uint64>(Reader.Size - Reader.Offset))
+            {
+                return false;
+            }
+
+            FScriptArrayHelper ArrayHelper(ArrayProp, PropertyAddr);
+            for (uint64 i = 0; i < NumOps; ++i)
+            {
+                const EDeltaOp Op = static_cast<EDeltaOp>(Reader.ReadUInt8());
+                const uint64 Index = Reader.ReadVarUInt64();
+                if (Reader.IsError())
+                {
+                    return false;
+                }
+
+                switch (Op)
+                {
+                case EDeltaOp::Update:
+                    if (Index >= static_cast<uint64>(ArrayHelper.Num()) ||
+                        !ReadPayload(ArrayProp->Inner, ArrayHelper.GetRawPtr(static_cast<int32>(Index)), InnerTag, Reader))
+                    {
+                        return false;
+                    }
+                    break;
+                case EDeltaOp::Insert:
+                    if (Index > static_cast<uint64>(ArrayHelper.Num()))
+                    {
+                        return false;
+                    }
+                    ArrayHelper.InsertValues(static_cast<int32>(Index));
+                    if (!ReadPayload(ArrayProp->Inner, ArrayHelper.GetRawPtr(static_cast<int32>(Index)), InnerTag, Reader))
+                    {
+                        return false;
+                    }
+                    break;
+                case EDeltaOp::Remove:
+                    if (Index >= static_cast<uint64>(ArrayHelper.Num()))
+                    {
+                        return false;
+                    }
+                    ArrayHelper.RemoveValues(static_cast<int32>(Index));
+                    break;
+                default:
+                    return false;
+                }
+            }
+
+            if (ArrayHelper.Num() != static_cast<int32>(FinalCount))
+            {
+                return false;
+            }
+        }
+        break;
+    case ESpacetimeDBPropertyType::Map:
+        {
+            const FMapProperty* MapProp = CastFieldChecked<const FMapProperty>(Property);
+            const ESpacetimeDBPropertyType KeyTag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+            const ESpacetimeDBPropertyType ValueTag = static_cast<ESpacetimeDBPropertyType>(Reader.ReadUInt8());
+            const uint64 NumOps = Reader.ReadVarUInt64();
+            if (Reader.IsError() || NumOps > static_cast<uint64>(Reader.Size - Reader.Offset))
+            {
+                return false;
+            }
+
+            FScriptMapHelper MapHelper(MapProp, PropertyAddr);
+            FScopedPropertyValue Key(MapProp->KeyProp);
+            for (uint64 i = 0; i < NumOps; ++i)
+            {
+                const EDeltaOp Op = static_cast<EDeltaOp>(Reader.ReadUInt8());
+                if (Reader.IsError() || !ReadPayload(MapProp->KeyProp, Key.Memory, KeyTag, Reader))
+                {
+                    return false;
+                }
+
+                if (Op == EDeltaOp::Remove)
+                {
+                    if (!MapHelper.RemovePair(Key.Memory))
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                if (Op != EDeltaOp::Update)
+                {
+                    return false;
+                }
+
+                int32 Index = MapHelper.FindMapIndexWithKey(Key.Memory);
+                if (Index == INDEX_NONE)
+                {
+                    Index = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
+                    MapProp->KeyProp->CopySingleValue(MapHelper.GetKeyPtr(Index), Key.Memory);
+                    const bool bRead = ReadPayload(MapProp->ValueProp, MapHelper.GetValuePtr(Index), ValueTag, Reader);
+                    MapHelper.Rehash();
+                    if (!bRead)
+                    {
+                        return false;
+                    }
+                }
+                else if (!ReadPayload(MapProp->ValueProp, MapHelper.GetValuePtr(Index), ValueTag, Reader))
+                {
+                    return false;
+                }
+            }
+        }
+        break;
+    default:
+        return false;
+    }
+
+    return !Reader.IsError();
+}
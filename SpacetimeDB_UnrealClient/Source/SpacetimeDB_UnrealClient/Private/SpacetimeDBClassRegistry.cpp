@@ -0,0 +1,210 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBClassRegistry.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/Class.h"
+#include "Engine/BlueprintCore.h"
+
+namespace
+{
+    /** A server class ID slot; the class is re-resolved from its path if it was unloaded */
+    struct FClassIdEntry
+    {
+        FString ClassPath;
+        TWeakObjectPtr<UClass> Class;
+    };
+
+    TArray<FClassIdEntry> GClassesById;
+    TMap<int32, FClassIdEntry> GSparseClassesById;
+
+    /** Name lookups that succeeded */
+    TMap<FString, TWeakObjectPtr<UClass>> GClassesByName;
+
+    /** Name lookups that failed; cleared whenever new classes may have been loaded */
+    TSet<FString> GUnknownClassNames;
+
+    FDelegateHandle GReloadCompleteHandle;
+    FDelegateHandle GAssetLoadedHandle;
+
+    const FSpacetimeDBCoreClassId GCoreClassIds[] =
+    {
+        { TEXT("/Script/CoreUObject.Object"), 1 },
+        { TEXT("/Script/Engine.ActorComponent"), 2 },
+        { TEXT("/Script/Engine.SceneComponent"), 3 },
+        { TEXT("/Script/Engine.PrimitiveComponent"), 4 },
+        { TEXT("/Script/Engine.MeshComponent"), 5 },
+        { TEXT("/Script/Engine.StaticMeshComponent"), 6 },
+        { TEXT("/Script/Engine.SkeletalMeshComponent"), 7 },
+        { TEXT("/Script/Engine.Actor"), 10 },
+        { TEXT("/Script/Engine.Pawn"), 11 },
+        { TEXT("/Script/Engine.Character"), 12 },
+        { TEXT("/Script/Engine.Controller"), 13 },
+        { TEXT("/Script/Engine.PlayerController"), 14 },
+        { TEXT("/Script/Engine.AIController"), 15 },
+        { TEXT("/Script/Engine.GameMode"), 16 },
+        { TEXT("/Script/Engine.GameState"), 17 },
+        { TEXT("/Script/Engine.PlayerState"), 18 },
+        { TEXT("/Script/Engine.MovementComponent"), 20 },
+        { TEXT("/Script/Engine.CharacterMovementComponent"), 21 },
+    };
+
+    FClassIdEntry* FindEntry(int32 ClassId)
+    {
+        if (ClassId >= 0 && ClassId < FSpacetimeDBClassRegistry::MaxDirectClassId)
+        {
+            return GClassesById.IsValidIndex(ClassId) ? &GClassesById[ClassId] : nullptr;
+        }
+        return GSparseClassesById.Find(ClassId);
+    }
+}
+
+void FSpacetimeDBClassRegistry::Startup()
+{
+    for (const FSpacetimeDBCoreClassId& Core : GCoreClassIds)
+    {
+        RegisterClassId(Core.ClassId, Core.ClassPath);
+    }
+
+    // New modules and Blueprint classes can make a previously unknown name resolvable
+    GReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+    {
+        ClearUnknownClasses();
+    });
+    GAssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddLambda([](UObject* Object)
+    {
+        // Most loaded assets are meshes, textures and the like that can't add a class. In the
+        // editor a Blueprint package reports the Blueprint rather than its generated class.
+        if (Cast<UClass>(Object) || Cast<UBlueprintCore>(Object))
+        {
+            ClearUnknownClasses();
+        }
+    });
+}
+
+void FSpacetimeDBClassRegistry::Shutdown()
+{
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(GReloadCompleteHandle);
+    GReloadCompleteHandle.Reset();
+    FCoreUObjectDelegates::OnAssetLoaded.Remove(GAssetLoadedHandle);
+    GAssetLoadedHandle.Reset();
+
+    GClassesById.Empty();
+    GSparseClassesById.Empty();
+    GClassesByName.Empty();
+    GUnknownClassNames.Empty();
+}
+
+TConstArrayView<FSpacetimeDBCoreClassId> FSpacetimeDBClassRegistry::GetCoreClassIds()
+{
+    return MakeArrayView(GCoreClassIds);
+}
+
+void FSpacetimeDBClassRegistry::RegisterClassId(int32 ClassId, const FString& ClassPath)
+{
+    if (ClassId <= 0 || ClassPath.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBClassRegistry: Ignoring invalid class registration %d -> '%s'"), ClassId, *ClassPath);
+        return;
+    }
+
+    FClassIdEntry* Entry = nullptr;
+    if (ClassId < MaxDirectClassId)
+    {
+        if (ClassId >= GClassesById.Num())
+        {
+            GClassesById.SetNum(ClassId + 1);
+        }
+        Entry = &GClassesById[ClassId];
+    }
+    else
+    {
+        Entry = &GSparseClassesById.FindOrAdd(ClassId);
+    }
+
+    if (!Entry->ClassPath.IsEmpty() && Entry->ClassPath != ClassPath)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBClassRegistry: Class ID %d changed from '%s' to '%s'"), ClassId, *Entry->ClassPath, *ClassPath);
+    }
+
+    Entry->ClassPath = ClassPath;
+    Entry->Class = FindObject<UClass>(nullptr, *ClassPath);
+}
+
+UClass* FSpacetimeDBClassRegistry::FindClassById(int32 ClassId)
+{
+    FClassIdEntry* Entry = FindEntry(ClassId);
+    if (!Entry || Entry->ClassPath.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    if (UClass* Class = Entry->Class.Get())
+    {
+        return Class;
+    }
+
+    // Not loaded at registration time, or unloaded since
+    UClass* Class = FindClassByName(Entry->ClassPath);
+    Entry->Class = Class;
+    return Class;
+}
+
+UClass* FSpacetimeDBClassRegistry::FindClassByName(const FString& ClassName)
+{
+    if (ClassName.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    if (const TWeakObjectPtr<UClass>* Cached = GClassesByName.Find(ClassName))
+    {
+        if (UClass* Class = Cached->Get())
+        {
+            return Class;
+        }
+    }
+
+    if (GUnknownClassNames.Contains(ClassName))
+    {
+        return nullptr;
+    }
+
+    UClass* Class = ResolveClassByName(ClassName);
+    if (Class)
+    {
+        GClassesByName.Add(ClassName, Class);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBClassRegistry: Caching unknown class '%s'"), *ClassName);
+        GClassesByName.Remove(ClassName);
+        GUnknownClassNames.Add(ClassName);
+    }
+    return Class;
+}
+
+void FSpacetimeDBClassRegistry::ClearUnknownClasses()
+{
+    GUnknownClassNames.Reset();
+}
+
+UClass* FSpacetimeDBClassRegistry::ResolveClassByName(const FString& ClassName)
+{
+    // Try to find the class by its path directly
+    if (UClass* Class = FindObject<UClass>(nullptr, *ClassName))
+    {
+        return Class;
+    }
+
+    // Then with the native U and A prefixes
+    if (!ClassName.StartsWith(TEXT("U")) && !ClassName.StartsWith(TEXT("A")))
+    {
+        if (UClass* Class = FindObject<UClass>(nullptr, *(TEXT("U") + ClassName)))
+        {
+            return Class;
+        }
+        return FindObject<UClass>(nullptr, *(TEXT("A") + ClassName));
+    }
+
+    return nullptr;
+}
@@ -2,37 +2,87 @@
 
 #include "SpacetimeDBClient.h"
 #include "HAL/UnrealMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
 #include "Async/Async.h"
 #include "SpacetimeDBSubsystem.h"
-#include "Engine/GameInstance.h"
 #include "ffi.h" // Include the generated FFI header file
+#include "SpacetimeDBFFI.h"
+#include "SpacetimeDBSettings.h"
 #include "SpacetimeDB_ErrorHandler.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "SpacetimeDBStats.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
 
-// Initialize static singleton instance for callbacks
-FSpacetimeDBClient* FSpacetimeDBClient::Instance = nullptr;
+namespace
+{
+    /** The connection FFI calls on this thread currently act on, to skip redundant selects */
+    thread_local uint64 GSelectedConnection = 0;
+    
+    /** Contexts of the clients alive in this process; a callback with any other context is dropped */
+    struct FLiveClients
+    {
+        FRWLock Lock;
+        TSet<uintptr_t> Contexts;
+    };
+    
+    FLiveClients& GetLiveClients()
+    {
+        static FLiveClients LiveClients;
+        return LiveClients;
+    }
+}
 
 FSpacetimeDBClient::FSpacetimeDBClient()
+    : Subscriptions(*this)
 {
-    // Set the singleton instance for callbacks
-    // Note: This approach assumes a single instance of FSpacetimeDBClient
-    // For multiple instances, a more sophisticated approach would be needed
-    if (Instance == nullptr)
+    FLiveClients& LiveClients = GetLiveClients();
+    FWriteScopeLock Lock(LiveClients.Lock);
+    LiveClients.Contexts.Add(reinterpret_cast<uintptr_t>(this));
+}
+
+FSpacetimeDBClient::~FSpacetimeDBClient()
+{
+    // Callbacks arriving from here on are dropped rather than reaching a client being torn down
     {
-        Instance = this;
+        FLiveClients& LiveClients = GetLiveClients();
+        FWriteScopeLock Lock(LiveClients.Lock);
+        LiveClients.Contexts.Remove(reinterpret_cast<uintptr_t>(this));
     }
-    else
+    
+    // The replay thread feeds the callbacks, which need this instance
+    StopReplay();
+    
+    if (ConnectionHandle != 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Multiple FSpacetimeDBClient instances created. Callback behavior may be unpredictable."));
+        Disconnect(); // Ensure we're disconnected
+        
+        // Waits for callbacks in flight, so none can reach this instance afterwards
+        destroy_connection(ConnectionHandle);
+        if (GSelectedConnection == ConnectionHandle)
+        {
+            GSelectedConnection = 0;
+        }
+        ConnectionHandle = 0;
     }
 }
 
-FSpacetimeDBClient::~FSpacetimeDBClient()
+FSpacetimeDBClient* FSpacetimeDBClient::FromCallbackContext(uintptr_t Context)
+{
+    FLiveClients& LiveClients = GetLiveClients();
+    FReadScopeLock Lock(LiveClients.Lock);
+    return LiveClients.Contexts.Contains(Context) ? reinterpret_cast<FSpacetimeDBClient*>(Context) : nullptr;
+}
+
+void FSpacetimeDBClient::SelectConnection() const
 {
-    // Only clean up if this is the active instance
-    if (Instance == this)
+    if (GSelectedConnection != ConnectionHandle)
     {
-        Disconnect(); // Ensure we're disconnected
-        Instance = nullptr;
+        select_connection(ConnectionHandle);
+        GSelectedConnection = ConnectionHandle;
     }
 }
 
@@ -43,34 +93,32 @@ bool FSpacetimeDBClient::Connect(const FString& Host, const FString& DatabaseNam
     // Validate input parameters
     if (Host.IsEmpty())
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Empty host provided for connection"),
             ESpacetimeDBErrorSeverity::Error,
             TEXT("Connection"),
-            1001
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::EmptyHost))
+        {
+            BroadcastError(ErrorInfo);
+        }
         
         return false;
     }
     
     if (DatabaseName.IsEmpty())
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Empty database name provided for connection"),
             ESpacetimeDBErrorSeverity::Error,
             TEXT("Connection"),
-            1002
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::EmptyDatabaseName))
+        {
+            BroadcastError(ErrorInfo);
+        }
         
         return false;
     }
@@ -78,21 +126,81 @@ bool FSpacetimeDBClient::Connect(const FString& Host, const FString& DatabaseNam
     // Check if already connected
     if (IsConnected())
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Already connected to SpacetimeDB. Disconnect first before connecting again."),
             ESpacetimeDBErrorSeverity::Warning,
             TEXT("Connection"),
-            1003
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::AlreadyConnected))
+        {
+            BroadcastError(ErrorInfo);
+        }
         
         return false;
     }
     
+    // A replay's events would interleave with the server's
+    if (IsReplaying())
+    {
+        UE_LOG(LogSpacetimeDB, Warning, TEXT("Stopping the event replay to connect"));
+        StopReplay();
+    }
+    
+    // Only a call from the application starts the retry count over
+    if (!bInReconnectAttempt)
+    {
+        CancelReconnect();
+    }
+    bDisconnectRequested = false;
+    LastHost = Host;
+    LastDatabaseName = DatabaseName;
+    LastAuthToken = AuthToken;
+    
+    // Create the inbound queue before any callback can fire
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    InitializeInboundQueue();
+    
+    // A library built against other headers would misread the calls below and the callback contexts
+    const uint32 LibraryAbiVersion = get_ffi_abi_version();
+    if (LibraryAbiVersion != SPACETIMEDB_FFI_ABI_VERSION)
+    {
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
+            TEXT("The stdb_client library doesn't match this plugin; rebuild ClientModule"),
+            ESpacetimeDBErrorSeverity::Critical,
+            TEXT("Connection"),
+            SpacetimeDBErrorCodes::LibraryVersionMismatch,
+            [LibraryAbiVersion]() { return FString::Printf(TEXT("Library interface version: %u, expected: %u"), LibraryAbiVersion, (uint32)SPACETIMEDB_FFI_ABI_VERSION); }))
+        {
+            BroadcastError(ErrorInfo);
+        }
+        return false;
+    }
+    
+    // Callbacks of the connection carry this client as their context
+    if (ConnectionHandle == 0)
+    {
+        ConnectionHandle = create_connection(reinterpret_cast<uintptr_t>(this));
+        if (ConnectionHandle == 0)
+        {
+            FSpacetimeDBErrorInfo ErrorInfo;
+            if (FSpacetimeDBErrorHandler::ReportError(
+                ErrorInfo,
+                TEXT("Failed to create a SpacetimeDB connection"),
+                ESpacetimeDBErrorSeverity::Error,
+                TEXT("Connection"),
+                SpacetimeDBErrorCodes::ConnectFailed,
+                [&Host, &DatabaseName]() { return FString::Printf(TEXT("Host: %s, Database: %s"), *Host, *DatabaseName); }))
+            {
+                BroadcastError(ErrorInfo);
+            }
+            return false;
+        }
+    }
+    SelectConnection();
+    
     // Create FFI connection config
     stdb::ffi::ConnectionConfig config;
     config.host = TCHAR_TO_UTF8(*Host);
@@ -116,24 +224,45 @@ bool FSpacetimeDBClient::Connect(const FString& Host, const FString& DatabaseNam
     callbacks.on_component_added = reinterpret_cast<uintptr_t>(&FSpacetimeDBClient::OnComponentAddedCallback);
     callbacks.on_component_removed = reinterpret_cast<uintptr_t>(&FSpacetimeDBClient::OnComponentRemovedCallback);
     
+    // Property updates use the binary wire format unless JSON is forced for debugging
+    const bool bUseBinaryProperties = !Settings->bUseJsonPropertyEncoding;
+    set_binary_property_callback(bUseBinaryProperties ? reinterpret_cast<uintptr_t>(&FSpacetimeDBClient::OnPropertyUpdatedBinaryCallback) : 0);
+    
+    // Spawns identify their class by server class ID, so no class path is sent or looked up
+    set_object_created_by_class_id_callback(reinterpret_cast<uintptr_t>(&FSpacetimeDBClient::OnObjectCreatedByClassIdCallback));
+    
+    // Interned property IDs replace names on the binary path once the server announces them
+    const bool bUsePropertyIds = bUseBinaryProperties && Settings->bUseInternedPropertyIds;
+    set_property_name_callback(bUsePropertyIds ? reinterpret_cast<uintptr_t>(&FSpacetimeDBClient::OnPropertyNameRegisteredCallback) : 0);
+    set_binary_property_by_id_callback(bUsePropertyIds ? reinterpret_cast<uintptr_t>(&FSpacetimeDBClient::OnPropertyUpdatedBinaryByIdCallback) : 0);
+    
+    // Typed client RPCs arrive by function ID with binary arguments
+    set_client_rpc_binary_callback(reinterpret_cast<uintptr_t>(&FSpacetimeDBClient::OnClientRpcBinaryCallback));
+    
+    // Lets the subscription manager report when each query's initial rows are in
+    set_subscription_applied_callback(reinterpret_cast<uintptr_t>(&FSpacetimeDBClient::OnSubscriptionAppliedCallback));
+    
     // Call the Rust function through FFI and capture the result
-    bool bResult = stdb::ffi::connect_to_server(config, callbacks);
+    bool bResult;
+    {
+        SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_Connect);
+        bResult = stdb::ffi::connect_to_server(config, callbacks);
+    }
     
     // No need for try/catch in UE4/5 - it doesn't support exceptions
     if (!bResult)
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Failed to initiate connection to SpacetimeDB"),
             ESpacetimeDBErrorSeverity::Error,
             TEXT("Connection"),
-            1004,
-            FString::Printf(TEXT("Host: %s, Database: %s"), *Host, *DatabaseName)
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::ConnectFailed,
+            [&Host, &DatabaseName]() { return FString::Printf(TEXT("Host: %s, Database: %s"), *Host, *DatabaseName); }))
+        {
+            BroadcastError(ErrorInfo);
+        }
     }
     
     return bResult;
@@ -143,6 +272,10 @@ bool FSpacetimeDBClient::Disconnect()
 {
     UE_LOG(LogSpacetimeDB, Log, TEXT("Disconnecting from SpacetimeDB"));
     
+    // Closed on purpose, so the drop isn't retried; also ends a retry already under way
+    bDisconnectRequested = true;
+    CancelReconnect();
+    
     // Check if already disconnected
     if (!IsConnected())
     {
@@ -150,51 +283,121 @@ bool FSpacetimeDBClient::Disconnect()
         return true; // Not an error, already disconnected
     }
     
+    // Calls made earlier this frame still go out
+    if (IsInGameThread())
+    {
+        FlushReducerCalls();
+    }
+    
     // Call the FFI function and capture the result
-    bool bResult = stdb::ffi::disconnect_from_server();
+    SelectConnection();
+    bool bResult;
+    {
+        SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_Disconnect);
+        bResult = stdb::ffi::disconnect_from_server();
+    }
     
     if (!bResult)
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Failed to disconnect from SpacetimeDB"),
             ESpacetimeDBErrorSeverity::Warning, // Warning, not Error since we can try again
             TEXT("Connection"),
-            1010
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::DisconnectFailed))
+        {
+            BroadcastError(ErrorInfo);
+        }
     }
     
     return bResult;
 }
 
+void FSpacetimeDBClient::CancelReconnect()
+{
+    ReconnectAttempt = 0;
+    NextReconnectTime = 0.0;
+}
+
+void FSpacetimeDBClient::ScheduleReconnect()
+{
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    if (!Settings->bAutoReconnect || Settings->MaxReconnectionAttempts <= 0 || LastHost.IsEmpty() || IsReplaying())
+    {
+        return;
+    }
+    
+    if (ReconnectAttempt >= Settings->MaxReconnectionAttempts)
+    {
+        UE_LOG(LogSpacetimeDB, Warning, TEXT("Giving up reconnecting to %s/%s after %d attempts"), *LastHost, *LastDatabaseName, ReconnectAttempt);
+        CancelReconnect();
+        OnReconnectFailed.Broadcast();
+        return;
+    }
+    
+    // Exponential backoff, jittered so clients dropped together don't all come back at once
+    ++ReconnectAttempt;
+    const float BaseDelay = FMath::Min(Settings->ReconnectionDelay * FMath::Pow(2.0f, static_cast<float>(ReconnectAttempt - 1)), Settings->MaxReconnectionDelay);
+    const float Delay = BaseDelay * FMath::FRandRange(0.5f, 1.0f);
+    NextReconnectTime = FPlatformTime::Seconds() + Delay;
+    
+    UE_LOG(LogSpacetimeDB, Log, TEXT("Reconnecting to %s/%s in %.1fs (attempt %d of %d)"),
+        *LastHost, *LastDatabaseName, Delay, ReconnectAttempt, Settings->MaxReconnectionAttempts);
+    OnReconnecting.Broadcast(ReconnectAttempt, Delay);
+}
+
+void FSpacetimeDBClient::TickReconnect()
+{
+    NextReconnectTime = 0.0;
+    
+    // Connect stores its arguments as the last ones, so pass copies
+    const FString Host = LastHost;
+    const FString DatabaseName = LastDatabaseName;
+    const FString AuthToken = LastAuthToken;
+    
+    bool bStarted;
+    {
+        TGuardValue<bool> AttemptGuard(bInReconnectAttempt, true);
+        bStarted = Connect(Host, DatabaseName, AuthToken);
+    }
+    
+    // A connection that starts but fails later is retried from its disconnect event
+    if (!bStarted)
+    {
+        ScheduleReconnect();
+    }
+}
+
 bool FSpacetimeDBClient::IsConnected() const
 {
+    if (ConnectionHandle == 0)
+    {
+        return false;
+    }
+    SelectConnection();
     return stdb::ffi::is_client_connected();
 }
 
 bool FSpacetimeDBClient::CallReducer(const FString& ReducerName, const FString& ArgsJson)
 {
-    UE_LOG(LogSpacetimeDB, Log, TEXT("Calling reducer %s with args: %s"), *ReducerName, *ArgsJson);
+    UE_LOG(LogSpacetimeDB, Verbose, TEXT("Calling reducer %s"), *ReducerName);
+    UE_LOG(LogSpacetimeDB, VeryVerbose, TEXT("Reducer %s args: %s"), *ReducerName, *ArgsJson);
     
     // Check connection state
     if (!IsConnected())
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Cannot call reducer - Not connected to SpacetimeDB"),
             ESpacetimeDBErrorSeverity::Error,
             TEXT("Reducer"),
-            2001,
-            FString::Printf(TEXT("Reducer: %s"), *ReducerName)
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::ReducerNotConnected,
+            [&ReducerName]() { return FString::Printf(TEXT("Reducer: %s"), *ReducerName); }))
+        {
+            BroadcastError(ErrorInfo);
+        }
         
         return false;
     }
@@ -202,42 +405,134 @@ bool FSpacetimeDBClient::CallReducer(const FString& ReducerName, const FString&
     // Validate parameters
     if (ReducerName.IsEmpty())
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Empty reducer name provided"),
             ESpacetimeDBErrorSeverity::Error,
             TEXT("Reducer"),
-            2002
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::EmptyReducerName))
+        {
+            BroadcastError(ErrorInfo);
+        }
         
         return false;
     }
     
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    if (Settings->bBatchReducerCalls && IsInGameThread())
+    {
+        FTCHARToUTF8 NameUtf8(*ReducerName);
+        FTCHARToUTF8 ArgsUtf8(*ArgsJson);
+        const int32 EncodedSize = 2 * sizeof(uint32) + NameUtf8.Length() + ArgsUtf8.Length();
+        
+        // Too big to share a batch; keeping order means everything queued before it goes first
+        if (EncodedSize > Settings->MaxReducerBatchBytes)
+        {
+            FlushReducerCalls();
+            return CallReducerNow(ReducerName, ArgsJson);
+        }
+        
+        if (ReducerBatchBuffer.Num() + EncodedSize > Settings->MaxReducerBatchBytes)
+        {
+            FlushReducerCalls();
+        }
+        
+        FSpacetimeDBBinaryWriter Writer(ReducerBatchBuffer);
+        Writer.WriteUInt32(static_cast<uint32>(NameUtf8.Length()));
+        Writer.WriteBytes(NameUtf8.Get(), NameUtf8.Length());
+        Writer.WriteUInt32(static_cast<uint32>(ArgsUtf8.Length()));
+        Writer.WriteBytes(ArgsUtf8.Get(), ArgsUtf8.Length());
+        QueuedReducerNames.Add(ReducerName);
+        RecordTraffic(ReducerName, true, EncodedSize);
+        return true;
+    }
+    
+    // Calls from other threads would race the queue; they go out directly
+    if (QueuedReducerNames.Num() > 0 && IsInGameThread())
+    {
+        FlushReducerCalls();
+    }
+    return CallReducerNow(ReducerName, ArgsJson);
+}
+
+void FSpacetimeDBClient::FlushReducerCalls()
+{
+    check(IsInGameThread());
+    
+    if (QueuedReducerNames.Num() == 0)
+    {
+        return;
+    }
+    
+    const uint32 CallCount = static_cast<uint32>(QueuedReducerNames.Num());
+    uint32 Accepted = 0;
+    if (IsConnected())
+    {
+        SelectConnection();
+        SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_CallReducersBatched);
+        INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, ReducerBatchBuffer.Num());
+        Accepted = call_reducers_batched(ReducerBatchBuffer.GetData(), ReducerBatchBuffer.Num(), CallCount);
+    }
+    
+    UE_LOG(LogSpacetimeDB, Verbose, TEXT("Submitted %u of %u batched reducer calls (%d bytes)"), Accepted, CallCount, ReducerBatchBuffer.Num());
+    
+    if (Accepted < CallCount)
+    {
+        // Report the failed calls together; the first one that failed is named for context
+        const bool bConnected = IsConnected();
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
+            bConnected ? TEXT("Failed to call batched reducers") : TEXT("Cannot call batched reducers - Not connected to SpacetimeDB"),
+            ESpacetimeDBErrorSeverity::Error,
+            TEXT("Reducer"),
+            bConnected ? SpacetimeDBErrorCodes::ReducerCallFailed : SpacetimeDBErrorCodes::ReducerNotConnected,
+            [this, Accepted, CallCount]()
+            {
+                TArray<FString> FailedNames(QueuedReducerNames.GetData() + Accepted, CallCount - Accepted);
+                return FString::Printf(TEXT("%u of %u calls failed: %s"), CallCount - Accepted, CallCount, *FString::Join(FailedNames, TEXT(", ")));
+            }))
+        {
+            BroadcastError(ErrorInfo);
+        }
+    }
+    
+    // Keep the buffer's memory for the next frame
+    ReducerBatchBuffer.Reset();
+    QueuedReducerNames.Reset();
+}
+
+bool FSpacetimeDBClient::CallReducerNow(const FString& ReducerName, const FString& ArgsJson)
+{
     // Prepare strings for FFI - convert to std::string as required by the FFI function
     std::string stdReducerName = TCHAR_TO_UTF8(*ReducerName);
     std::string stdArgsJson = TCHAR_TO_UTF8(*ArgsJson);
     
+    RecordTraffic(ReducerName, true, static_cast<int32>(stdReducerName.size() + stdArgsJson.size()));
+    
     // Call the FFI function and capture the result
-    bool bResult = stdb::ffi::call_reducer(stdReducerName, stdArgsJson);
+    SelectConnection();
+    bool bResult;
+    {
+        SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_CallReducer);
+        INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, stdReducerName.size() + stdArgsJson.size());
+        bResult = stdb::ffi::call_reducer(stdReducerName, stdArgsJson);
+    }
     
     if (!bResult)
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Failed to call reducer"),
             ESpacetimeDBErrorSeverity::Error,
             TEXT("Reducer"),
-            2003,
-            FString::Printf(TEXT("Reducer: %s, Args: %s"), *ReducerName, *ArgsJson)
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::ReducerCallFailed,
+            [&ReducerName, &ArgsJson]() { return FString::Printf(TEXT("Reducer: %s, Args: %s"), *ReducerName, *ArgsJson); }))
+        {
+            BroadcastError(ErrorInfo);
+        }
     }
     
     return bResult;
@@ -261,17 +556,16 @@ bool FSpacetimeDBClient::SubscribeToTables(const TArray<FString>& TableNames)
     // Check if connected
     if (!IsConnected())
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Cannot subscribe to tables - Not connected to SpacetimeDB"),
             ESpacetimeDBErrorSeverity::Error,
             TEXT("Subscription"),
-            3001
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::SubscribeNotConnected))
+        {
+            BroadcastError(ErrorInfo);
+        }
         
         return false;
     }
@@ -279,17 +573,16 @@ bool FSpacetimeDBClient::SubscribeToTables(const TArray<FString>& TableNames)
     // Check if we have tables to subscribe to
     if (TableNames.Num() == 0)
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("No tables specified for subscription"),
             ESpacetimeDBErrorSeverity::Warning,
             TEXT("Subscription"),
-            3002
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::NoTablesToSubscribe))
+        {
+            BroadcastError(ErrorInfo);
+        }
         
         return false;
     }
@@ -302,22 +595,74 @@ bool FSpacetimeDBClient::SubscribeToTables(const TArray<FString>& TableNames)
     }
     
     // Call the FFI function and capture the result
-    bool bResult = stdb::ffi::subscribe_to_tables(stdTableNames);
+    SelectConnection();
+    bool bResult;
+    {
+        SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_SubscribeToTables);
+        bResult = stdb::ffi::subscribe_to_tables(stdTableNames);
+    }
     
     if (!bResult)
     {
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::LogError(
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
             TEXT("Failed to subscribe to tables"),
             ESpacetimeDBErrorSeverity::Error,
             TEXT("Subscription"),
-            3003,
-            FString::Printf(TEXT("Tables: [%s]"), *TablesStr)
-        );
-        
-        // Execute on game thread to ensure thread safety
-        AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
-            OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+            SpacetimeDBErrorCodes::SubscribeFailed,
+            [&TablesStr]() { return FString::Printf(TEXT("Tables: [%s]"), *TablesStr); }))
+        {
+            BroadcastError(ErrorInfo);
+        }
+    }
+    
+    return bResult;
+}
+
+bool FSpacetimeDBClient::UnsubscribeFromTables(const TArray<FString>& TableNames)
+{
+    if (TableNames.Num() == 0)
+    {
+        return true;
+    }
+    
+    FString TablesStr = FString::Join(TableNames, TEXT(", "));
+    UE_LOG(LogSpacetimeDB, Log, TEXT("Unsubscribing from tables: [%s]"), *TablesStr);
+    
+    // Subscriptions end with the connection; nothing to undo
+    if (!IsConnected())
+    {
+        return false;
+    }
+    
+    std::vector<std::string> stdTableNames;
+    stdTableNames.reserve(TableNames.Num());
+    for (const FString& TableName : TableNames)
+    {
+        stdTableNames.push_back(TCHAR_TO_UTF8(*TableName));
+    }
+    
+    SelectConnection();
+    bool bResult;
+    {
+        SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_UnsubscribeFromTables);
+        bResult = stdb::ffi::unsubscribe_from_tables(stdTableNames);
+    }
+    
+    if (!bResult)
+    {
+        FSpacetimeDBErrorInfo ErrorInfo;
+        if (FSpacetimeDBErrorHandler::ReportError(
+            ErrorInfo,
+            TEXT("Failed to unsubscribe from tables"),
+            ESpacetimeDBErrorSeverity::Error,
+            TEXT("Subscription"),
+            SpacetimeDBErrorCodes::UnsubscribeFailed,
+            [&TablesStr]() { return FString::Printf(TEXT("Tables: [%s]"), *TablesStr); }))
+        {
+            BroadcastError(ErrorInfo);
+        }
     }
     
     return bResult;
@@ -325,6 +670,11 @@ bool FSpacetimeDBClient::SubscribeToTables(const TArray<FString>& TableNames)
 
 FString FSpacetimeDBClient::GetClientIdentity() const
 {
+    if (ConnectionHandle == 0)
+    {
+        return FString();
+    }
+    SelectConnection();
     rust::String identityStr = stdb::ffi::get_client_identity();
     return UTF8_TO_TCHAR(identityStr.c_str());
 }
@@ -337,188 +687,742 @@ uint64 FSpacetimeDBClient::GetClientID() const
         return 0;
     }
     
+    SelectConnection();
     return stdb::ffi::get_client_id();
 }
 
-// ---- Static callback implementations ----
+// ---- Inbound event queue ----
 
-void FSpacetimeDBClient::OnConnectedCallback()
+int32 FSpacetimeDBClient::ProcessInboundEvents(double TimeBudgetSeconds)
 {
-    // Execute on game thread
-    if (Instance)
+    if (!InboundEvents.IsValid())
+    {
+        return 0;
+    }
+    
+    SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_ProcessInbound);
+    SET_DWORD_STAT(STAT_SpacetimeDB_InboundQueueDepth, InboundEvents->Num());
+    
+    const double StartTime = FPlatformTime::Seconds();
+    const double Deadline = StartTime + TimeBudgetSeconds;
+    int32 Processed = 0;
+    
+    while (InboundEvents->Dequeue(DrainEvent))
+    {
+        if (Recorder.IsOpen())
+        {
+            Recorder.Record(DrainEvent);
+        }
+        
+        DispatchingPayload = &DrainEvent.Decoded;
+        DispatchInboundEvent(DrainEvent);
+        DispatchingPayload = nullptr;
+        ++Processed;
+        
+        // Reading the clock per event is measurable in large bursts, so only sample it
+        if ((Processed & 15) == 0 && FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
+    }
+    
+    // Nothing decoded during the drain outlives it
+    FrameArena.Reset();
+    
+    // Storms that went quiet still get their summary line
+    FSpacetimeDBErrorHandler::FlushErrorSummaries();
+    
+    if (Replayer.IsValid())
+    {
+        TickReplay();
+    }
+    
+    if (NextReconnectTime > 0.0 && FPlatformTime::Seconds() >= NextReconnectTime)
     {
-        AsyncTask(ENamedThreads::GameThread, []() {
-            UE_LOG(LogSpacetimeDB, Log, TEXT("Connected successfully to SpacetimeDB"));
-            Instance->OnConnected.Broadcast();
-        });
+        TickReconnect();
     }
+    
+    LastDrainCount = Processed;
+    INC_DWORD_STAT_BY(STAT_SpacetimeDB_InboundEvents, Processed);
+    LastDrainTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    
+    if (Processed > 0 && InboundEvents->Num() > 0)
+    {
+        UE_LOG(LogSpacetimeDB, Verbose, TEXT("Inbound event budget exhausted after %d events, %d still queued"), Processed, InboundEvents->Num());
+    }
+    
+    return Processed;
 }
 
-void FSpacetimeDBClient::OnDisconnectedCallback(const char* Reason)
+void FSpacetimeDBClient::InitializeInboundQueue()
 {
-    if (Instance)
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    if (!InboundEvents.IsValid())
     {
-        FString ReasonStr = UTF8_TO_TCHAR(Reason);
-        
-        // Execute on game thread
-        AsyncTask(ENamedThreads::GameThread, [ReasonStr]() {
-            UE_LOG(LogSpacetimeDB, Log, TEXT("Disconnected from SpacetimeDB - Reason: %s"), *ReasonStr);
-            Instance->OnDisconnected.Broadcast(ReasonStr);
-        });
+        InboundEvents = MakeUnique<FSpacetimeDBEventQueue>(static_cast<uint32>(Settings->InboundEventQueueCapacity));
     }
+    BackpressureTimeoutSeconds = Settings->InboundEventBackpressureTimeoutMs / 1000.0;
+    bDecodePayloadsOffGameThread = Settings->bDecodePayloadsOffGameThread;
 }
 
-void FSpacetimeDBClient::OnEventReceivedCallback(const char* EventData, const char* TableName)
+FSpacetimeDBEventQueueStats FSpacetimeDBClient::GetInboundQueueStats() const
 {
-    if (Instance)
+    FSpacetimeDBEventQueueStats Stats;
+    if (InboundEvents.IsValid())
     {
-        FString EventDataStr = UTF8_TO_TCHAR(EventData);
-        FString TableNameStr = UTF8_TO_TCHAR(TableName);
-        
-        // Execute on game thread
-        AsyncTask(ENamedThreads::GameThread, [EventDataStr, TableNameStr]() {
-            UE_LOG(LogSpacetimeDB, Verbose, TEXT("Event received for table '%s'"), *TableNameStr);
-            Instance->OnEventReceived.Broadcast(TableNameStr, EventDataStr);
-        });
+        Stats.QueueDepth = InboundEvents->Num();
+        Stats.Capacity = InboundEvents->GetCapacity();
+        Stats.HighWaterMark = InboundEvents->GetHighWaterMark();
     }
+    Stats.TotalEnqueued = TotalEnqueuedEvents.GetValue();
+    Stats.TotalBackpressureWaits = TotalBackpressureWaits.GetValue();
+    Stats.TotalDropped = TotalDroppedEvents.GetValue();
+    Stats.LastDrainCount = LastDrainCount;
+    Stats.LastDrainTimeMs = LastDrainTimeMs;
+    Stats.FrameArenaHighWaterMark = FrameArena.GetHighWaterMark();
+    Stats.FrameArenaReserved = FrameArena.GetBytesReserved();
+    return Stats;
 }
 
-void FSpacetimeDBClient::OnErrorOccurredCallback(const char* ErrorMessage)
+void FSpacetimeDBClient::GetTrafficStats(TArray<FSpacetimeDBTrafficStats>& OutStats) const
 {
-    if (Instance)
+    FScopeLock Lock(&TrafficLock);
+    OutStats.Reset(InboundTraffic.Num() + OutboundTraffic.Num());
+    for (const TPair<FString, FSpacetimeDBTrafficStats>& Pair : InboundTraffic)
     {
-        FString ErrorMessageStr = UTF8_TO_TCHAR(ErrorMessage);
-        
-        // Process the error and create a structured error info object
-        FSpacetimeDBErrorInfo ErrorInfo = FSpacetimeDBErrorHandler::HandleFFIError(
-            TEXT("FFI_Callback"),  // Generic function name since this is a callback
-            ErrorMessageStr,
-            false  // Don't log stack trace here as we're in a callback
-        );
-        
-        // Execute on game thread
-        AsyncTask(ENamedThreads::GameThread, [ErrorInfo]() {
-            // Use our dedicated log category instead of LogTemp
-            UE_LOG(LogSpacetimeDB, Error, TEXT("Error: %s"), *ErrorInfo.Message);
-            
-            // Broadcast with rich error info
-            Instance->OnErrorOccurred.Broadcast(ErrorInfo);
-        });
+        OutStats.Add(Pair.Value);
+    }
+    for (const TPair<FString, FSpacetimeDBTrafficStats>& Pair : OutboundTraffic)
+    {
+        OutStats.Add(Pair.Value);
     }
 }
 
-// --- New callback implementations ---
+bool FSpacetimeDBClient::IsCollectingTrafficStats()
+{
+#if STATS
+    if (FThreadStats::IsCollectingData())
+    {
+        return true;
+    }
+#endif
+    return UE_TRACE_CHANNELEXPR_IS_ENABLED(SpacetimeDBChannel) || USpacetimeDBSettings::Get()->bCollectTrafficStats;
+}
 
-void FSpacetimeDBClient::OnPropertyUpdatedCallback(uint64 ObjectId, const char* PropertyName, const char* ValueJson)
+void FSpacetimeDBClient::RecordTraffic(const FString& Name, bool bOutbound, int32 Bytes)
 {
-    if (Instance)
+    if (!IsCollectingTrafficStats())
     {
-        FString PropertyNameStr = UTF8_TO_TCHAR(PropertyName);
-        FString ValueJsonStr = UTF8_TO_TCHAR(ValueJson);
-        
-        // Execute on game thread
-        AsyncTask(ENamedThreads::GameThread, [ObjectId, PropertyNameStr, ValueJsonStr]() {
-            UE_LOG(LogSpacetimeDB, Verbose, TEXT("Property updated - Object %llu, Property '%s'"), ObjectId, *PropertyNameStr);
-            Instance->OnPropertyUpdated.Broadcast(ObjectId, PropertyNameStr, ValueJsonStr);
-        });
+        return;
     }
+    
+    FScopeLock Lock(&TrafficLock);
+    TMap<FString, FSpacetimeDBTrafficStats>& Traffic = bOutbound ? OutboundTraffic : InboundTraffic;
+    FSpacetimeDBTrafficStats* Stats = Traffic.Find(Name);
+    if (!Stats)
+    {
+        Stats = &Traffic.Add(Name);
+        Stats->Name = Name;
+        Stats->bOutbound = bOutbound;
+    }
+    ++Stats->Messages;
+    Stats->Bytes += Bytes;
 }
 
-void FSpacetimeDBClient::OnObjectCreatedCallback(uint64 ObjectId, const char* ClassName, const char* DataJson)
+// ---- Event capture and replay ----
+
+namespace
 {
-    if (Instance)
+    /** Puts relative capture paths under Saved/SpacetimeDB */
+    FString ResolveCapturePath(const FString& FilePath)
     {
-        FString ClassNameStr = UTF8_TO_TCHAR(ClassName);
-        FString DataJsonStr = UTF8_TO_TCHAR(DataJson);
-        
-        // Execute on game thread
-        AsyncTask(ENamedThreads::GameThread, [ObjectId, ClassNameStr, DataJsonStr]() {
-            UE_LOG(LogSpacetimeDB, Log, TEXT("Object created - ID: %llu, Class: '%s'"), ObjectId, *ClassNameStr);
-            Instance->OnObjectCreated.Broadcast(ObjectId, ClassNameStr, DataJsonStr);
-        });
+        return FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SpacetimeDB"), FilePath) : FilePath;
+    }
+}
+
+bool FSpacetimeDBClient::StartRecording(const FString& FilePath)
+{
+    check(IsInGameThread());
+    return Recorder.Open(ResolveCapturePath(FilePath));
+}
+
+void FSpacetimeDBClient::StopRecording()
+{
+    check(IsInGameThread());
+    Recorder.Close();
+}
+
+bool FSpacetimeDBClient::StartReplay(const FString& FilePath, bool bAsFastAsPossible)
+{
+    check(IsInGameThread());
+    
+    if (IsReplaying())
+    {
+        UE_LOG(LogSpacetimeDB, Warning, TEXT("An event replay is already running"));
+        return false;
+    }
+    if (IsConnected())
+    {
+        UE_LOG(LogSpacetimeDB, Warning, TEXT("Cannot replay events while connected to SpacetimeDB"));
+        return false;
+    }
+    
+    InitializeInboundQueue();
+    
+    Replayer = MakeUnique<FSpacetimeDBEventReplayer>([this](const FSpacetimeDBInboundEvent& Event) { ReplayInboundEvent(Event); }, bAsFastAsPossible);
+    if (!Replayer->Start(ResolveCapturePath(FilePath)))
+    {
+        Replayer.Reset();
+        return false;
     }
+    
+    ReplayStats = FSpacetimeDBReplayStats();
+    ReplayStats.bReplaying = true;
+    ReplayStartTime = FPlatformTime::Seconds();
+    ReplayFrameTimeSum = 0.0;
+    return true;
 }
 
-void FSpacetimeDBClient::OnObjectDestroyedCallback(uint64 ObjectId)
+void FSpacetimeDBClient::StopReplay()
 {
-    if (Instance)
+    if (!Replayer.IsValid())
+    {
+        return;
+    }
+    
+    Replayer->Cancel();
+    ReplayStats.EventsReplayed = Replayer->GetNumReplayed();
+    ReplayStats.bReplaying = false;
+    Replayer.Reset();
+    UE_LOG(LogSpacetimeDB, Log, TEXT("Event replay stopped after %lld events"), ReplayStats.EventsReplayed);
+}
+
+void FSpacetimeDBClient::TickReplay()
+{
+    // The frame that started the replay isn't part of it
+    if (ReplayStats.EventsReplayed > 0 || ReplayStats.Frames > 0)
+    {
+        const double FrameMs = FApp::GetDeltaTime() * 1000.0;
+        ReplayFrameTimeSum += FrameMs;
+        ++ReplayStats.Frames;
+        ReplayStats.AverageFrameMs = static_cast<float>(ReplayFrameTimeSum / ReplayStats.Frames);
+        ReplayStats.MaxFrameMs = FMath::Max(ReplayStats.MaxFrameMs, static_cast<float>(FrameMs));
+    }
+    ReplayStats.EventsReplayed = Replayer->GetNumReplayed();
+    ReplayStats.DurationSeconds = static_cast<float>(FPlatformTime::Seconds() - ReplayStartTime);
+    
+    if (!Replayer->IsFinished() || InboundEvents->Num() > 0)
     {
-        // Execute on game thread
-        AsyncTask(ENamedThreads::GameThread, [ObjectId]() {
-            UE_LOG(LogSpacetimeDB, Log, TEXT("Object destroyed - ID: %llu"), ObjectId);
-            Instance->OnObjectDestroyed.Broadcast(ObjectId);
-        });
+        return;
     }
+    
+    Replayer->Cancel();
+    Replayer.Reset();
+    ReplayStats.bReplaying = false;
+    UE_LOG(LogSpacetimeDB, Log, TEXT("Event replay finished: %lld events in %.2fs over %d frames, %.2f ms average frame, %.2f ms longest"),
+        ReplayStats.EventsReplayed, ReplayStats.DurationSeconds, ReplayStats.Frames, ReplayStats.AverageFrameMs, ReplayStats.MaxFrameMs);
 }
 
-void FSpacetimeDBClient::OnObjectIdRemappedCallback(uint64 TempId, uint64 ServerId)
+void FSpacetimeDBClient::ReplayInboundEvent(const FSpacetimeDBInboundEvent& Event)
 {
-    if (Instance)
+    FTCHARToUTF8 NameUtf8(*Event.Name);
+    FTCHARToUTF8 DataUtf8(*Event.Data);
+    const char* Name = reinterpret_cast<const char*>(NameUtf8.Get());
+    const char* Data = reinterpret_cast<const char*>(DataUtf8.Get());
+    const uint8* Payload = Event.Payload.GetData();
+    const size_t PayloadLen = static_cast<size_t>(Event.Payload.Num());
+    const uintptr_t Context = reinterpret_cast<uintptr_t>(this);
+    
+    switch (Event.Type)
     {
-        // Execute on game thread
-        AsyncTask(ENamedThreads::GameThread, [TempId, ServerId]() {
-            UE_LOG(LogSpacetimeDB, Log, TEXT("Object ID remapped - Temp ID: %llu -> Server ID: %llu"), TempId, ServerId);
-            Instance->OnObjectIdRemapped.Broadcast(TempId, ServerId);
-        });
+    case ESpacetimeDBInboundEventType::Connected:
+        OnConnectedCallback(Context);
+        break;
+    case ESpacetimeDBInboundEventType::Disconnected:
+        OnDisconnectedCallback(Context, Name);
+        break;
+    case ESpacetimeDBInboundEventType::IdentityReceived:
+        OnIdentityReceivedCallback(Context, Name);
+        break;
+    case ESpacetimeDBInboundEventType::EventReceived:
+        OnEventReceivedCallback(Context, Data, Name);
+        break;
+    case ESpacetimeDBInboundEventType::ErrorOccurred:
+        OnErrorOccurredCallback(Context, Data);
+        break;
+    case ESpacetimeDBInboundEventType::PropertyUpdated:
+        OnPropertyUpdatedCallback(Context, Event.Id, Name, Data);
+        break;
+    case ESpacetimeDBInboundEventType::PropertyUpdatedBinary:
+        OnPropertyUpdatedBinaryCallback(Context, Event.Id, Name, Payload, PayloadLen);
+        break;
+    case ESpacetimeDBInboundEventType::PropertyNameRegistered:
+        OnPropertyNameRegisteredCallback(Context, static_cast<uint32>(Event.SecondaryId), Name);
+        break;
+    case ESpacetimeDBInboundEventType::PropertyUpdatedBinaryById:
+        OnPropertyUpdatedBinaryByIdCallback(Context, Event.Id, static_cast<uint32>(Event.SecondaryId), Payload, PayloadLen);
+        break;
+    case ESpacetimeDBInboundEventType::ClientRpcBinary:
+        OnClientRpcBinaryCallback(Context, Event.Id, static_cast<uint32>(Event.SecondaryId), Payload, PayloadLen);
+        break;
+    case ESpacetimeDBInboundEventType::ObjectCreated:
+        OnObjectCreatedCallback(Context, Event.Id, Name, Data);
+        break;
+    case ESpacetimeDBInboundEventType::ObjectCreatedByClassId:
+        OnObjectCreatedByClassIdCallback(Context, Event.Id, static_cast<uint32>(Event.SecondaryId), Data);
+        break;
+    case ESpacetimeDBInboundEventType::ObjectDestroyed:
+        OnObjectDestroyedCallback(Context, Event.Id);
+        break;
+    case ESpacetimeDBInboundEventType::ObjectIdRemapped:
+        OnObjectIdRemappedCallback(Context, Event.Id, Event.SecondaryId);
+        break;
+    case ESpacetimeDBInboundEventType::ComponentAdded:
+        OnComponentAddedCallback(Context, Event.Id, Event.SecondaryId, Name, Data);
+        break;
+    case ESpacetimeDBInboundEventType::ComponentRemoved:
+        OnComponentRemovedCallback(Context, Event.Id, Event.SecondaryId);
+        break;
+    case ESpacetimeDBInboundEventType::SubscriptionApplied:
+        OnSubscriptionAppliedCallback(Context, Name);
+        break;
     }
 }
 
-void FSpacetimeDBClient::OnComponentAddedCallback(uint64 ActorId, uint64 ComponentId, const char* ComponentClassName, const char* DataJson)
+template<typename FillFunc>
+void FSpacetimeDBClient::PushInboundEvent(uintptr_t Context, FillFunc&& Fill)
 {
-    if (Instance)
+    FSpacetimeDBClient* Client = FromCallbackContext(Context);
+    if (!Client || !Client->InboundEvents.IsValid())
     {
-        FString ComponentClassNameStr = UTF8_TO_TCHAR(ComponentClassName);
-        FString DataJsonStr = UTF8_TO_TCHAR(DataJson);
+        return;
+    }
+    
+    if (Client->InboundEvents->EnqueueWith(Fill))
+    {
+        Client->TotalEnqueuedEvents.Increment();
+        return;
+    }
+    
+    // The queue is full. Holding the network thread pushes back on the server connection
+    // instead of losing state, but the game thread can never wait on itself.
+    if (!IsInGameThread())
+    {
+        Client->TotalBackpressureWaits.Increment();
         
-        // Execute on game thread
-        AsyncTask(ENamedThreads::GameThread, [ActorId, ComponentId, ComponentClassNameStr, DataJsonStr]() {
-            UE_LOG(LogSpacetimeDB, Log, TEXT("Component added - Actor: %llu, Component: %llu, Class: '%s'"), 
-                ActorId, ComponentId, *ComponentClassNameStr);
-            Instance->OnComponentAdded.Broadcast(ActorId, ComponentId, ComponentClassNameStr);
-            
-            // Find the subsystem to handle component creation
-            for (TObjectIterator<UGameInstance> It; It; ++It)
+        const double Deadline = FPlatformTime::Seconds() + Client->BackpressureTimeoutSeconds;
+        while (FPlatformTime::Seconds() < Deadline)
+        {
+            FPlatformProcess::SleepNoStats(0.0005f);
+            if (Client->InboundEvents->EnqueueWith(Fill))
             {
-                if (UGameInstance* GameInstance = *It)
-                {
-                    if (IsValid(GameInstance) && GameInstance->GetWorld() && GameInstance->GetWorld()->IsGameWorld())
-                    {
-                        if (USpacetimeDBSubsystem* Subsystem = GameInstance->GetSubsystem<USpacetimeDBSubsystem>())
-                        {
-                            Subsystem->HandleComponentAdded(ActorId, ComponentId, ComponentClassNameStr, DataJsonStr);
-                            break;
-                        }
-                    }
-                }
+                Client->TotalEnqueuedEvents.Increment();
+                return;
             }
-        });
+        }
+    }
+    
+    const int64 Dropped = Client->TotalDroppedEvents.Increment();
+    if (Dropped == 1 || (Dropped % 1000) == 0)
+    {
+        UE_LOG(LogSpacetimeDB, Warning, TEXT("Inbound event queue full (%d events) - dropped %lld events so far"), 
+            Client->InboundEvents->GetCapacity(), Dropped);
     }
 }
 
-void FSpacetimeDBClient::OnComponentRemovedCallback(uint64 ActorId, uint64 ComponentId)
+void FSpacetimeDBClient::BroadcastError(const FSpacetimeDBErrorInfo& ErrorInfo)
+{
+    // Execute on game thread to ensure thread safety
+    AsyncTask(ENamedThreads::GameThread, [this, ErrorInfo]() {
+        OnErrorOccurred.Broadcast(ErrorInfo);
+    });
+}
+
+void FSpacetimeDBClient::DispatchInboundEvent(FSpacetimeDBInboundEvent& Event)
 {
-    if (Instance)
+    INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesIn, Event.Name.Len() + Event.Data.Len() + Event.Payload.Num());
+    
+    switch (Event.Type)
     {
-        // Execute on game thread
-        AsyncTask(ENamedThreads::GameThread, [ActorId, ComponentId]() {
-            UE_LOG(LogSpacetimeDB, Log, TEXT("Component removed - Actor: %llu, Component: %llu"), ActorId, ComponentId);
-            Instance->OnComponentRemoved.Broadcast(ActorId, ComponentId);
-            
-            // Find the subsystem to handle component removal
-            for (TObjectIterator<UGameInstance> It; It; ++It)
+    case ESpacetimeDBInboundEventType::Connected:
+        UE_LOG(LogSpacetimeDB, Log, TEXT("Connected successfully to SpacetimeDB"));
+        if (ReconnectAttempt > 0)
+        {
+            UE_LOG(LogSpacetimeDB, Log, TEXT("Reconnected after %d attempts"), ReconnectAttempt);
+            CancelReconnect();
+        }
+        Subscriptions.HandleConnected();
+        OnConnected.Broadcast();
+        break;
+        
+    case ESpacetimeDBInboundEventType::Disconnected:
+        UE_LOG(LogSpacetimeDB, Log, TEXT("Disconnected from SpacetimeDB - Reason: %s"), *Event.Name);
+        Subscriptions.HandleDisconnected();
+        
+        // The next connection interns its own IDs
+        InternedProperties.Reset();
+        InternedPropertyIds.Reset();
+        
+        // A drop nobody asked for is retried; listeners see IsReconnecting already set
+        if (!bDisconnectRequested)
+        {
+            ScheduleReconnect();
+        }
+        
+        OnDisconnected.Broadcast(Event.Name);
+        break;
+        
+    case ESpacetimeDBInboundEventType::IdentityReceived:
+        OnIdentityReceived.Broadcast(Event.Name);
+        break;
+        
+    case ESpacetimeDBInboundEventType::EventReceived:
+        UE_LOG(LogSpacetimeDB, Verbose, TEXT("Event received for table '%s'"), *Event.Name);
+        if (IsCollectingTrafficStats())
+        {
+            // Counted in the UTF-8 bytes the server sent, like outbound traffic
+            RecordTraffic(Event.Name, false, FPlatformString::ConvertedLength<UTF8CHAR>(*Event.Data, Event.Data.Len()));
+        }
+        OnEventReceived.Broadcast(Event.Name, Event.Data);
+        break;
+        
+    case ESpacetimeDBInboundEventType::ErrorOccurred:
+        {
+            // Process the error and create a structured error info object; a code over
+            // its rate limit is only counted
+            FSpacetimeDBErrorInfo ErrorInfo;
+            if (FSpacetimeDBErrorHandler::ReportFFIError(
+                ErrorInfo,
+                TEXT("FFI_Callback"),  // Generic function name since this is a callback
+                Event.Data))
             {
-                if (UGameInstance* GameInstance = *It)
-                {
-                    if (IsValid(GameInstance) && GameInstance->GetWorld() && GameInstance->GetWorld()->IsGameWorld())
-                    {
-                        if (USpacetimeDBSubsystem* Subsystem = GameInstance->GetSubsystem<USpacetimeDBSubsystem>())
-                        {
-                            Subsystem->HandleComponentRemoved(ActorId, ComponentId);
-                            break;
-                        }
-                    }
-                }
+                // Broadcast with rich error info
+                OnErrorOccurred.Broadcast(ErrorInfo);
             }
-        });
+        }
+        break;
+        
+    case ESpacetimeDBInboundEventType::PropertyUpdated:
+        UE_LOG(LogSpacetimeDB, Verbose, TEXT("Property updated - Object %llu, Property '%s'"), Event.Id, *Event.Name);
+        OnPropertyUpdated.Broadcast(Event.Id, Event.Name, Event.Data);
+        break;
+        
+    case ESpacetimeDBInboundEventType::PropertyUpdatedBinary:
+        UE_LOG(LogSpacetimeDB, Verbose, TEXT("Property updated (binary) - Object %llu, Property '%s', %d bytes"), Event.Id, *Event.Name, Event.Payload.Num());
+        OnPropertyUpdatedBinary.Broadcast(Event.Id, Event.Name, Event.Payload);
+        break;
+        
+    case ESpacetimeDBInboundEventType::PropertyNameRegistered:
+        RegisterInternedProperty(static_cast<uint32>(Event.SecondaryId), Event.Name);
+        break;
+        
+    case ESpacetimeDBInboundEventType::PropertyUpdatedBinaryById:
+        UE_LOG(LogSpacetimeDB, VeryVerbose, TEXT("Property updated (binary) - Object %llu, Property ID %llu, %d bytes"), Event.Id, Event.SecondaryId, Event.Payload.Num());
+        OnPropertyUpdatedBinaryById.Broadcast(Event.Id, static_cast<uint32>(Event.SecondaryId), Event.Payload);
+        break;
+        
+    case ESpacetimeDBInboundEventType::ClientRpcBinary:
+        UE_LOG(LogSpacetimeDB, VeryVerbose, TEXT("Client RPC - Object %llu, Function ID %llu, %d bytes"), Event.Id, Event.SecondaryId, Event.Payload.Num());
+        OnClientRpcBinary.Broadcast(Event.Id, static_cast<uint32>(Event.SecondaryId), Event.Payload);
+        break;
+        
+    case ESpacetimeDBInboundEventType::ObjectCreated:
+        UE_LOG(LogSpacetimeDB, Log, TEXT("Object created - ID: %llu, Class: '%s'"), Event.Id, *Event.Name);
+        OnObjectCreated.Broadcast(Event.Id, Event.Name, Event.Data);
+        break;
+        
+    case ESpacetimeDBInboundEventType::ObjectCreatedByClassId:
+        UE_LOG(LogSpacetimeDB, Log, TEXT("Object created - ID: %llu, Class ID: %llu"), Event.Id, Event.SecondaryId);
+        OnObjectCreatedByClassId.Broadcast(Event.Id, static_cast<uint32>(Event.SecondaryId), Event.Data);
+        break;
+        
+    case ESpacetimeDBInboundEventType::ObjectDestroyed:
+        UE_LOG(LogSpacetimeDB, Log, TEXT("Object destroyed - ID: %llu"), Event.Id);
+        OnObjectDestroyed.Broadcast(Event.Id);
+        break;
+        
+    case ESpacetimeDBInboundEventType::ObjectIdRemapped:
+        UE_LOG(LogSpacetimeDB, Log, TEXT("Object ID remapped - Temp ID: %llu -> Server ID: %llu"), Event.Id, Event.SecondaryId);
+        OnObjectIdRemapped.Broadcast(Event.Id, Event.SecondaryId);
+        break;
+        
+    case ESpacetimeDBInboundEventType::ComponentAdded:
+        UE_LOG(LogSpacetimeDB, Log, TEXT("Component added - Actor: %llu, Component: %llu, Class: '%s'"), 
+            Event.Id, Event.SecondaryId, *Event.Name);
+        OnComponentAdded.Broadcast(Event.Id, Event.SecondaryId, Event.Name);
+        
+        // The owning subsystem creates the component
+        if (Owner)
+        {
+            Owner->HandleComponentAdded(Event.Id, Event.SecondaryId, Event.Name, Event.Data);
+        }
+        break;
+        
+    case ESpacetimeDBInboundEventType::ComponentRemoved:
+        UE_LOG(LogSpacetimeDB, Log, TEXT("Component removed - Actor: %llu, Component: %llu"), Event.Id, Event.SecondaryId);
+        OnComponentRemoved.Broadcast(Event.Id, Event.SecondaryId);
+        
+        // The owning subsystem removes the component
+        if (Owner)
+        {
+            Owner->HandleComponentRemoved(Event.Id, Event.SecondaryId);
+        }
+        break;
+        
+    case ESpacetimeDBInboundEventType::SubscriptionApplied:
+        UE_LOG(LogSpacetimeDB, Verbose, TEXT("Subscription applied - '%s'"), *Event.Name);
+        Subscriptions.HandleApplied(Event.Name);
+        break;
+    }
+}
+
+void FSpacetimeDBClient::RegisterInternedProperty(uint32 PropertyId, const FString& PropertyName)
+{
+    // IDs are expected to be dense; anything wild would cost a huge table
+    constexpr uint32 MaxPropertyId = 1 << 20;
+    if (PropertyId == 0 || PropertyId >= MaxPropertyId || PropertyName.IsEmpty())
+    {
+        UE_LOG(LogSpacetimeDB, Warning, TEXT("Ignoring interned property %u '%s'"), PropertyId, *PropertyName);
+        return;
+    }
+    
+    if (static_cast<uint32>(InternedProperties.Num()) <= PropertyId)
+    {
+        InternedProperties.SetNum(PropertyId + 1);
+    }
+    
+    FSpacetimeDBInternedProperty& Entry = InternedProperties[PropertyId];
+    if (!Entry.Name.IsNone())
+    {
+        InternedPropertyIds.Remove(Entry.WireName);
+    }
+    Entry.WireName = PropertyName;
+    Entry.Name = FName(*PropertyName);
+    InternedPropertyIds.Add(PropertyName, PropertyId);
+    
+    UE_LOG(LogSpacetimeDB, Verbose, TEXT("Interned property %u '%s'"), PropertyId, *PropertyName);
+}
+
+// ---- Static callback implementations ----
+// These run on the network thread: they only copy their arguments into a queue cell, which
+// the game thread drains once per frame. Cells reuse their buffers, so in steady state
+// converting the FFI strings allocates nothing.
+
+namespace
+{
+    /** Clears every field of a recycled event and sets its type */
+    void ResetInboundEvent(FSpacetimeDBInboundEvent& Event, ESpacetimeDBInboundEventType Type)
+    {
+        Event.Type = Type;
+        Event.Id = 0;
+        Event.SecondaryId = 0;
+        Event.Name.Reset();
+        Event.Data.Reset();
+        Event.Payload.Reset();
+        Event.Decoded.Reset();
+    }
+
+    
+    /** Converts an FFI string into a recycled FString, keeping its allocation */
+    void AssignUtf8(FString& Out, const char* Utf8)
+    {
+        if (Utf8)
+        {
+            Out.AppendChars(reinterpret_cast<const UTF8CHAR*>(Utf8), FCStringAnsi::Strlen(Utf8));
+        }
+    }
+    
+    /** Copies an FFI buffer, which is only valid for the duration of the callback */
+    void AssignPayload(TArray<uint8>& Out, const uint8* Data, size_t DataLen)
+    {
+        if (Data && DataLen > 0)
+        {
+            Out.Append(Data, static_cast<int32>(DataLen));
+        }
     }
-} 
\ No newline at end of file
+}
+
+void FSpacetimeDBClient::OnConnectedCallback(uintptr_t Context)
+{
+    PushInboundEvent(Context, [](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::Connected);
+    });
+}
+
+void FSpacetimeDBClient::OnDisconnectedCallback(uintptr_t Context, const char* Reason)
+{
+    PushInboundEvent(Context, [Reason](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::Disconnected);
+        AssignUtf8(Event.Name, Reason);
+    });
+}
+
+void FSpacetimeDBClient::OnIdentityReceivedCallback(uintptr_t Context, const char* Identity)
+{
+    PushInboundEvent(Context, [Identity](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::IdentityReceived);
+        AssignUtf8(Event.Name, Identity);
+    });
+}
+
+void FSpacetimeDBClient::OnEventReceivedCallback(uintptr_t Context, const char* EventData, const char* TableName)
+{
+    PushInboundEvent(Context, [EventData, TableName](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::EventReceived);
+        AssignUtf8(Event.Name, TableName);
+        AssignUtf8(Event.Data, EventData);
+    });
+}
+
+void FSpacetimeDBClient::OnErrorOccurredCallback(uintptr_t Context, const char* ErrorMessage)
+{
+    PushInboundEvent(Context, [ErrorMessage](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::ErrorOccurred);
+        AssignUtf8(Event.Data, ErrorMessage);
+    });
+}
+
+void FSpacetimeDBClient::OnPropertyUpdatedCallback(uintptr_t Context, uint64 ObjectId, const char* PropertyName, const char* ValueJson)
+{
+    PushInboundEvent(Context, [Context, ObjectId, PropertyName, ValueJson](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::PropertyUpdated);
+        Event.Id = ObjectId;
+        AssignUtf8(Event.Name, PropertyName);
+        AssignUtf8(Event.Data, ValueJson);
+        if (ShouldDecodePayloads(Context))
+        {
+            FSpacetimeDBPayloadDecoder::DecodeScalar(Event.Data, Event.Decoded.Scalar);
+        }
+    });
+}
+
+void FSpacetimeDBClient::OnPropertyUpdatedBinaryCallback(uintptr_t Context, uint64 ObjectId, const char* PropertyName, const uint8* Data, size_t DataLen)
+{
+    PushInboundEvent(Context, [ObjectId, PropertyName, Data, DataLen](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::PropertyUpdatedBinary);
+        Event.Id = ObjectId;
+        AssignUtf8(Event.Name, PropertyName);
+        AssignPayload(Event.Payload, Data, DataLen);
+    });
+}
+
+void FSpacetimeDBClient::OnPropertyNameRegisteredCallback(uintptr_t Context, uint32 PropertyId, const char* PropertyName)
+{
+    PushInboundEvent(Context, [PropertyId, PropertyName](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::PropertyNameRegistered);
+        Event.SecondaryId = PropertyId;
+        AssignUtf8(Event.Name, PropertyName);
+    });
+}
+
+void FSpacetimeDBClient::OnPropertyUpdatedBinaryByIdCallback(uintptr_t Context, uint64 ObjectId, uint32 PropertyId, const uint8* Data, size_t DataLen)
+{
+    // No name crosses the FFI, so only the payload is copied
+    PushInboundEvent(Context, [ObjectId, PropertyId, Data, DataLen](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::PropertyUpdatedBinaryById);
+        Event.Id = ObjectId;
+        Event.SecondaryId = PropertyId;
+        AssignPayload(Event.Payload, Data, DataLen);
+    });
+}
+
+void FSpacetimeDBClient::OnClientRpcBinaryCallback(uintptr_t Context, uint64 ObjectId, uint32 FunctionId, const uint8* Data, size_t DataLen)
+{
+    // The arguments stay encoded until the handler decodes them into its typed parameters
+    PushInboundEvent(Context, [ObjectId, FunctionId, Data, DataLen](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::ClientRpcBinary);
+        Event.Id = ObjectId;
+        Event.SecondaryId = FunctionId;
+        AssignPayload(Event.Payload, Data, DataLen);
+    });
+}
+
+void FSpacetimeDBClient::OnObjectCreatedCallback(uintptr_t Context, uint64 ObjectId, const char* ClassName, const char* DataJson)
+{
+    PushInboundEvent(Context, [Context, ObjectId, ClassName, DataJson](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::ObjectCreated);
+        Event.Id = ObjectId;
+        AssignUtf8(Event.Name, ClassName);
+        AssignUtf8(Event.Data, DataJson);
+        if (ShouldDecodePayloads(Context))
+        {
+            FSpacetimeDBPayloadDecoder::DecodeSpawn(Event.Data, Event.Decoded);
+        }
+    });
+}
+
+void FSpacetimeDBClient::OnObjectCreatedByClassIdCallback(uintptr_t Context, uint64 ObjectId, uint32 ClassId, const char* DataJson)
+{
+    PushInboundEvent(Context, [Context, ObjectId, ClassId, DataJson](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::ObjectCreatedByClassId);
+        Event.Id = ObjectId;
+        Event.SecondaryId = ClassId;
+        AssignUtf8(Event.Data, DataJson);
+        if (ShouldDecodePayloads(Context))
+        {
+            FSpacetimeDBPayloadDecoder::DecodeSpawn(Event.Data, Event.Decoded);
+        }
+    });
+}
+
+void FSpacetimeDBClient::OnObjectDestroyedCallback(uintptr_t Context, uint64 ObjectId)
+{
+    PushInboundEvent(Context, [ObjectId](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::ObjectDestroyed);
+        Event.Id = ObjectId;
+    });
+}
+
+void FSpacetimeDBClient::OnObjectIdRemappedCallback(uintptr_t Context, uint64 TempId, uint64 ServerId)
+{
+    PushInboundEvent(Context, [TempId, ServerId](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::ObjectIdRemapped);
+        Event.Id = TempId;
+        Event.SecondaryId = ServerId;
+    });
+}
+
+void FSpacetimeDBClient::OnComponentAddedCallback(uintptr_t Context, uint64 ActorId, uint64 ComponentId, const char* ComponentClassName, const char* DataJson)
+{
+    PushInboundEvent(Context, [ActorId, ComponentId, ComponentClassName, DataJson](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::ComponentAdded);
+        Event.Id = ActorId;
+        Event.SecondaryId = ComponentId;
+        AssignUtf8(Event.Name, ComponentClassName);
+        AssignUtf8(Event.Data, DataJson);
+    });
+}
+
+void FSpacetimeDBClient::OnComponentRemovedCallback(uintptr_t Context, uint64 ActorId, uint64 ComponentId)
+{
+    PushInboundEvent(Context, [ActorId, ComponentId](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::ComponentRemoved);
+        Event.Id = ActorId;
+        Event.SecondaryId = ComponentId;
+    });
+}
+
+void FSpacetimeDBClient::OnSubscriptionAppliedCallback(uintptr_t Context, const char* Query)
+{
+    PushInboundEvent(Context, [Query](FSpacetimeDBInboundEvent& Event)
+    {
+        ResetInboundEvent(Event, ESpacetimeDBInboundEventType::SubscriptionApplied);
+        AssignUtf8(Event.Name, Query);
+    });
+}
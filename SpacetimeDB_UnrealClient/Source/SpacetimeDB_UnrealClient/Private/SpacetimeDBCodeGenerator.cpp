@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SpacetimeDBCodeGenerator.h"
+#include "SpacetimeDBClassRegistry.h"
 #include "HAL/FileManager.h"
 #include "Misc/FileHelper.h"
 #include "Engine/Blueprint.h"
@@ -19,9 +20,57 @@
 #include "UObject/Class.h"
 #include "Misc/PackageName.h"
 #include "Misc/Paths.h"
+#include "Hash/CityHash.h"
+#include "Misc/EngineVersion.h"
+#include "Modules/ModuleManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /** IDs below this are reserved for FSpacetimeDBClassRegistry's core classes */
+    constexpr int32 FirstProjectClassId = 100;
+
+    /** Bump when the generated output changes shape so every output is rewritten once */
+    constexpr int32 GeneratorVersion = 4;
+
+    /**
+     * The header a generated accessor table includes to name a native class, or an empty string
+     * if a game module can't include it. Only the project's own modules qualify, and the include
+     * path is only known while metadata is loaded.
+     */
+    FString GetAccessorIncludePath(const UClass* Class)
+    {
+#if WITH_METADATA
+        const FString ModuleName = FPackageName::GetShortName(Class->GetOutermost()->GetName());
+        const FString ModuleFile = FModuleManager::Get().GetModuleFilename(FName(*ModuleName));
+        if (ModuleFile.IsEmpty()
+            || !FPaths::IsUnderDirectory(FPaths::ConvertRelativePathToFull(ModuleFile), FPaths::ConvertRelativePathToFull(FPaths::ProjectDir())))
+        {
+            return FString();
+        }
+        return Class->GetMetaData(TEXT("IncludePath"));
+#else
+        return FString();
+#endif
+    }
+
+    uint64 HashString(const FString& Value)
+    {
+        return CityHash64(reinterpret_cast<const char*>(*Value), Value.Len() * sizeof(TCHAR));
+    }
+
+    FString HashToString(uint64 Hash)
+    {
+        return FString::Printf(TEXT("%016llx"), Hash);
+    }
+}
 
 USpacetimeDBCodeGenerator::USpacetimeDBCodeGenerator()
-    : NextClassId(100) // Start at 100 to leave space for hardcoded core classes
+    : ClassIdManifestPath(TEXT("SpacetimeDB/ClassIdManifest.json"))
+    , MaxPropertyId(0)
+    , bManifestDirty(false)
 {
 }
 
@@ -30,36 +79,31 @@ void USpacetimeDBCodeGenerator::Initialize(FSubsystemCollectionBase& Collection)
     Super::Initialize(Collection);
     
     // Initialize with core class mappings
-    // IMPORTANT: This generator is the SINGLE SOURCE OF TRUTH for class IDs!
-    // Both core engine classes (IDs 1-99) and game-specific classes (IDs 100+) 
-    // are defined here and exported to the server module.
-    ClassIdMap.Add(TEXT("/Script/CoreUObject.Object"), 1);
-    ClassIdMap.Add(TEXT("/Script/Engine.ActorComponent"), 2);
-    ClassIdMap.Add(TEXT("/Script/Engine.SceneComponent"), 3);
-    ClassIdMap.Add(TEXT("/Script/Engine.PrimitiveComponent"), 4);
-    ClassIdMap.Add(TEXT("/Script/Engine.MeshComponent"), 5);
-    ClassIdMap.Add(TEXT("/Script/Engine.StaticMeshComponent"), 6);
-    ClassIdMap.Add(TEXT("/Script/Engine.SkeletalMeshComponent"), 7);
-    ClassIdMap.Add(TEXT("/Script/Engine.Actor"), 10);
-    ClassIdMap.Add(TEXT("/Script/Engine.Pawn"), 11);
-    ClassIdMap.Add(TEXT("/Script/Engine.Character"), 12);
-    ClassIdMap.Add(TEXT("/Script/Engine.Controller"), 13);
-    ClassIdMap.Add(TEXT("/Script/Engine.PlayerController"), 14);
-    ClassIdMap.Add(TEXT("/Script/Engine.AIController"), 15);
-    ClassIdMap.Add(TEXT("/Script/Engine.GameMode"), 16);
-    ClassIdMap.Add(TEXT("/Script/Engine.GameState"), 17);
-    ClassIdMap.Add(TEXT("/Script/Engine.PlayerState"), 18);
-    ClassIdMap.Add(TEXT("/Script/Engine.MovementComponent"), 20);
-    ClassIdMap.Add(TEXT("/Script/Engine.CharacterMovementComponent"), 21);
-
-    // Update next ID to avoid conflicts
-    NextClassId = 100;
+    // IMPORTANT: This generator is the SINGLE SOURCE OF TRUTH for exported class IDs!
+    // Core engine classes (IDs 1-99) come from FSpacetimeDBClassRegistry, which the client
+    // also resolves spawns with; game-specific classes (IDs 100+) are assigned here.
+    // Both are exported to the server module.
+    for (const FSpacetimeDBCoreClassId& Core : FSpacetimeDBClassRegistry::GetCoreClassIds())
+    {
+        ClassIdMap.Add(Core.ClassPath, Core.ClassId);
+        ClassPathById.Add(Core.ClassId, Core.ClassPath);
+    }
+
+    // Project class IDs are hashed from the class path; the manifest pins the ones that collided
+    LoadManifest();
 }
 
 void USpacetimeDBCodeGenerator::Deinitialize()
 {
+    SaveManifest();
+
     // Cleanup
     ClassIdMap.Empty();
+    ClassPathById.Empty();
+    PropertyIdMap.Empty();
+    MaxPropertyId = 0;
+    ClassFingerprints.Empty();
+    OutputFingerprints.Empty();
     Super::Deinitialize();
 }
 
@@ -77,6 +121,20 @@ bool USpacetimeDBCodeGenerator::GenerateRustClassRegistry(const FString& OutputP
     TArray<UClass*> RelevantClasses;
     GetAllRelevantClasses(RelevantClasses);
 
+    // Nothing to do if no class was added, removed or changed since the last run
+    FString Inputs;
+    for (UClass* Class : RelevantClasses)
+    {
+        Inputs += FString::Printf(TEXT("%s=%d:%s;"), *GetClassPath(Class), GenerateClassId(Class), *ComputeClassFingerprint(Class));
+    }
+    const FString Fingerprint = ComputeOutputFingerprint(Inputs);
+    if (IsOutputUpToDate(OutputPath, Fingerprint))
+    {
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBCodeGenerator: %s is up to date"), *OutputPath);
+        SaveManifest();
+        return true;
+    }
+
     // Generate file content
     TArray<FString> Lines;
     Lines.Add(TEXT("// AUTO-GENERATED FILE - DO NOT EDIT"));
@@ -95,35 +153,19 @@ bool USpacetimeDBCodeGenerator::GenerateRustClassRegistry(const FString& OutputP
     Lines.Add(TEXT("    // Register core engine classes"));
     Lines.Add(TEXT("    log::debug!(\"Registering core engine classes\");"));
     
-    for (const auto& ClassPair : ClassIdMap)
+    for (const FSpacetimeDBCoreClassId& Core : FSpacetimeDBClassRegistry::GetCoreClassIds())
     {
-        FString ClassName = ClassPair.Key.Replace(TEXT("/Script/"), TEXT("."));
-        UClass* Class = nullptr;
-        
-        // First try to find class in its package
-        FString PackageName, ClassName_NoPackage;
-        if (ClassName.Split(TEXT("."), &PackageName, &ClassName_NoPackage))
+        if (UClass* Class = FindObject<UClass>(nullptr, Core.ClassPath))
         {
-            FString FullPath = TEXT("/Script/") + PackageName + TEXT(".") + ClassName_NoPackage;
-            Class = FindObject<UClass>(nullptr, *FullPath);
-        }
-        
-        // If not found, try direct lookup
-        if (!Class)
-        {
-            Class = FindObject<UClass>(nullptr, *ClassName);
-        }
-
-        if (Class)
-        {
-            FString Registration = GenerateClassRegistration(Class, ClassPair.Value);
+            FString Registration = GenerateClassRegistration(Class, Core.ClassId);
             Lines.Add(FString::Printf(TEXT("    // Register %s"), *Class->GetName()));
             Lines.Add(Registration);
             Lines.Add(TEXT(""));
         }
     }
     
-    Lines.Add(FString::Printf(TEXT("    log::debug!(\"Registered {} core engine classes\", %d)"), ClassIdMap.Num()));
+    const int32 CoreClassCount = FSpacetimeDBClassRegistry::GetCoreClassIds().Num();
+    Lines.Add(FString::Printf(TEXT("    log::debug!(\"Registered {} core engine classes\", %d)"), CoreClassCount));
     Lines.Add(TEXT(""));
 
     // Then register project-specific classes (these will have IDs 100+)
@@ -133,14 +175,13 @@ bool USpacetimeDBCodeGenerator::GenerateRustClassRegistry(const FString& OutputP
     int32 ProjectClassCount = 0;
     for (UClass* Class : RelevantClasses)
     {
-        // Skip classes that are already in the core class map
-        FString ClassPath = Class->GetPathName();
-        if (ClassIdMap.Contains(ClassPath))
+        // Core classes were registered above
+        int32 ClassId = GenerateClassId(Class);
+        if (ClassId < FirstProjectClassId)
         {
             continue;
         }
 
-        int32 ClassId = GenerateClassId(Class);
         FString Registration = GenerateClassRegistration(Class, ClassId);
         Lines.Add(FString::Printf(TEXT("    // Register %s"), *Class->GetName()));
         Lines.Add(Registration);
@@ -149,7 +190,7 @@ bool USpacetimeDBCodeGenerator::GenerateRustClassRegistry(const FString& OutputP
     }
 
     Lines.Add(FString::Printf(TEXT("    log::debug!(\"Registered {} project-specific classes\", %d)"), ProjectClassCount));
-    Lines.Add(FString::Printf(TEXT("    log::info!(\"Registered {} total classes\", %d)"), ClassIdMap.Num() + ProjectClassCount));
+    Lines.Add(FString::Printf(TEXT("    log::info!(\"Registered {} total classes\", %d)"), CoreClassCount + ProjectClassCount));
     Lines.Add(TEXT("}"));
     Lines.Add(TEXT(""));
 
@@ -163,28 +204,11 @@ bool USpacetimeDBCodeGenerator::GenerateRustClassRegistry(const FString& OutputP
     Lines.Add(TEXT("    // Register properties for core engine classes"));
     Lines.Add(TEXT("    log::debug!(\"Registering core engine class properties\");"));
     
-    for (const auto& ClassPair : ClassIdMap)
+    for (const FSpacetimeDBCoreClassId& Core : FSpacetimeDBClassRegistry::GetCoreClassIds())
     {
-        FString ClassName = ClassPair.Key.Replace(TEXT("/Script/"), TEXT("."));
-        UClass* Class = nullptr;
-        
-        // First try to find class in its package
-        FString PackageName, ClassName_NoPackage;
-        if (ClassName.Split(TEXT("."), &PackageName, &ClassName_NoPackage))
-        {
-            FString FullPath = TEXT("/Script/") + PackageName + TEXT(".") + ClassName_NoPackage;
-            Class = FindObject<UClass>(nullptr, *FullPath);
-        }
-        
-        // If not found, try direct lookup
-        if (!Class)
-        {
-            Class = FindObject<UClass>(nullptr, *ClassName);
-        }
-
-        if (Class)
+        if (UClass* Class = FindObject<UClass>(nullptr, Core.ClassPath))
         {
-            FString PropertyRegistrations = GeneratePropertyRegistrations(Class, ClassPair.Value);
+            FString PropertyRegistrations = GeneratePropertyRegistrations(Class, Core.ClassId);
             if (!PropertyRegistrations.IsEmpty())
             {
                 Lines.Add(FString::Printf(TEXT("    // Register properties for %s"), *Class->GetName()));
@@ -202,14 +226,13 @@ bool USpacetimeDBCodeGenerator::GenerateRustClassRegistry(const FString& OutputP
     
     for (UClass* Class : RelevantClasses)
     {
-        // Skip classes that are already in the core class map
-        FString ClassPath = Class->GetPathName();
-        if (ClassIdMap.Contains(ClassPath))
+        // Core classes were registered above
+        int32 ClassId = GenerateClassId(Class);
+        if (ClassId < FirstProjectClassId)
         {
             continue;
         }
 
-        int32 ClassId = GenerateClassId(Class);
         FString PropertyRegistrations = GeneratePropertyRegistrations(Class, ClassId);
         if (!PropertyRegistrations.IsEmpty())
         {
@@ -223,7 +246,7 @@ bool USpacetimeDBCodeGenerator::GenerateRustClassRegistry(const FString& OutputP
     Lines.Add(TEXT("}"));
 
     // Write to file
-    return FFileHelper::SaveStringArrayToFile(Lines, *OutputPath);
+    return SaveOutput(Lines, OutputPath, Fingerprint);
 }
 
 bool USpacetimeDBCodeGenerator::GenerateRustComponentMappings(const FString& OutputPath)
@@ -250,6 +273,33 @@ bool USpacetimeDBCodeGenerator::GenerateRustComponentMappings(const FString& Out
         }
     }
 
+    // Iteration order isn't stable across launches; the output has to be
+    ActorClasses.Sort([](UClass& A, UClass& B) { return A.GetPathName() < B.GetPathName(); });
+
+    TMap<UClass*, TMap<FString, FString>> ComponentsByClass;
+    FString Inputs;
+    for (UClass* Class : ActorClasses)
+    {
+        TMap<FString, FString>& Components = ComponentsByClass.Add(Class);
+        GetDefaultComponentsForClass(Class, Components);
+        Components.KeySort(TLess<FString>());
+
+        Inputs += FString::Printf(TEXT("%s=%d:%s"), *GetClassPath(Class), GenerateClassId(Class), *ComputeClassFingerprint(Class));
+        for (const TPair<FString, FString>& Pair : Components)
+        {
+            Inputs += FString::Printf(TEXT(",%s=%s"), *Pair.Key, *Pair.Value);
+        }
+        Inputs += TEXT(";");
+    }
+
+    const FString Fingerprint = ComputeOutputFingerprint(Inputs);
+    if (IsOutputUpToDate(OutputPath, Fingerprint))
+    {
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBCodeGenerator: %s is up to date"), *OutputPath);
+        SaveManifest();
+        return true;
+    }
+
     // Generate file content
     TArray<FString> Lines;
     Lines.Add(TEXT("// AUTO-GENERATED FILE - DO NOT EDIT"));
@@ -267,19 +317,16 @@ bool USpacetimeDBCodeGenerator::GenerateRustComponentMappings(const FString& Out
     // Generate component mappings for each class
     for (UClass* Class : ActorClasses)
     {
-        TMap<FString, FString> Components;
-        GetDefaultComponentsForClass(Class, Components);
+        const TMap<FString, FString>& Components = ComponentsByClass.FindChecked(Class);
 
         if (Components.Num() > 0)
         {
-            FString ClassPath = FString::Printf(TEXT("/Script/%s.%s"), 
-                *FPackageName::GetShortName(Class->GetOutermost()->GetName()),
-                *Class->GetName());
+            FString ClassPath = GetClassPath(Class);
             
             Lines.Add(FString::Printf(TEXT("            \"%s\" => {"), *ClassPath));
             Lines.Add(TEXT("                // Components for ") + Class->GetName());
             
-            for (auto& Pair : Components)
+            for (const auto& Pair : Components)
             {
                 int32 ComponentClassId = GenerateClassId(FindObject<UClass>(nullptr, *Pair.Value));
                 Lines.Add(FString::Printf(TEXT("                add_component(ctx, actor_id, %d, \"%s\");"), 
@@ -329,7 +376,79 @@ bool USpacetimeDBCodeGenerator::GenerateRustComponentMappings(const FString& Out
     Lines.Add(TEXT("}"));
 
     // Write to file
-    return FFileHelper::SaveStringArrayToFile(Lines, *OutputPath);
+    return SaveOutput(Lines, OutputPath, Fingerprint);
+}
+
+bool USpacetimeDBCodeGenerator::GenerateCppPropertyAccessors(const FString& OutputPath)
+{
+    // Create output directory if needed
+    FString Directory = FPaths::GetPath(OutputPath);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    // Collect classes to register
+    TArray<UClass*> RelevantClasses;
+    GetAllRelevantClasses(RelevantClasses);
+    RelevantClasses.RemoveAll([](UClass* Class) { return !Class->HasAnyClassFlags(CLASS_Native) || GetAccessorIncludePath(Class).IsEmpty(); });
+
+    // Offsets are part of each class fingerprint, so a layout change regenerates the file
+    FString Inputs;
+    for (UClass* Class : RelevantClasses)
+    {
+        Inputs += FString::Printf(TEXT("%s:%s;"), *GetClassPath(Class), *ComputeClassFingerprint(Class));
+    }
+    const FString Fingerprint = ComputeOutputFingerprint(Inputs);
+    if (IsOutputUpToDate(OutputPath, Fingerprint))
+    {
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBCodeGenerator: %s is up to date"), *OutputPath);
+        SaveManifest();
+        return true;
+    }
+
+    // Generate file content
+    TArray<FString> Lines;
+    Lines.Add(TEXT("// AUTO-GENERATED FILE - DO NOT EDIT"));
+    Lines.Add(TEXT("// Generated by SpacetimeDBCodeGenerator"));
+    Lines.Add(TEXT("//"));
+    Lines.Add(TEXT("// Member offsets are taken by the compiler, so they match the configuration this file"));
+    Lines.Add(TEXT("// is built in. Tags and sizes are still checked against reflection when classes are"));
+    Lines.Add(TEXT("// described. Regenerate after changing replicated properties of the classes below."));
+    Lines.Add(TEXT(""));
+    Lines.Add(TEXT("#include \"SpacetimeDBGeneratedAccessors.h\""));
+
+    int32 ClassCount = 0;
+    TArray<FString> IncludePaths;
+    TArray<FString> TableLines;
+    // Blueprint layouts aren't known to C++; those classes were dropped above and stay on reflection
+    for (UClass* Class : RelevantClasses)
+    {
+        FString Accessors = GeneratePropertyAccessors(Class);
+        if (!Accessors.IsEmpty())
+        {
+            IncludePaths.AddUnique(GetAccessorIncludePath(Class));
+            TableLines.Add(Accessors);
+            TableLines.Add(TEXT(""));
+            ClassCount++;
+        }
+    }
+
+    for (const FString& IncludePath : IncludePaths)
+    {
+        Lines.Add(FString::Printf(TEXT("#include \"%s\""), *IncludePath));
+    }
+    Lines.Add(TEXT(""));
+    Lines.Add(TEXT("namespace"));
+    Lines.Add(TEXT("{"));
+    Lines.Append(TableLines);
+    Lines.Add(TEXT("}"));
+
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBCodeGenerator: Generated property accessors for %d classes"), ClassCount);
+
+    // Write to file
+    return SaveOutput(Lines, OutputPath, Fingerprint);
 }
 
 void USpacetimeDBCodeGenerator::GetAllRelevantClasses(TArray<UClass*>& OutClasses)
@@ -361,16 +480,28 @@ void USpacetimeDBCodeGenerator::GetAllRelevantClasses(TArray<UClass*>& OutClasse
         }
     }
 
-    // Sort classes to ensure parent classes are registered first
-    OutClasses.Sort([](UClass& A, UClass& B) {
-        // If B inherits from A, A should come first
-        if (B.IsChildOf(&A))
-            return true;
-        // If A inherits from B, B should come first
-        if (A.IsChildOf(&B))
-            return false;
-        // Otherwise sort by name for stable ordering
-        return A.GetName() < B.GetName();
+    // Sort classes so parents are registered first: a parent is always shallower than its children.
+    // Ties are broken by path so the output doesn't depend on object iteration order.
+    auto GetDepth = [](const UClass* Class) {
+        int32 Depth = 0;
+        for (const UClass* Super = Class->GetSuperClass(); Super; Super = Super->GetSuperClass())
+            ++Depth;
+        return Depth;
+    };
+
+    TMap<const UClass*, int32> Depths;
+    Depths.Reserve(OutClasses.Num());
+    for (const UClass* Class : OutClasses)
+    {
+        Depths.Add(Class, GetDepth(Class));
+    }
+
+    OutClasses.Sort([&Depths](const UClass& A, const UClass& B) {
+        const int32 DepthA = Depths.FindChecked(&A);
+        const int32 DepthB = Depths.FindChecked(&B);
+        if (DepthA != DepthB)
+            return DepthA < DepthB;
+        return A.GetPathName() < B.GetPathName();
     });
 }
 
@@ -380,19 +511,8 @@ FString USpacetimeDBCodeGenerator::GenerateClassRegistration(UClass* Class, int3
     int32 ParentClassId = 0;
     if (Class->GetSuperClass())
     {
-        FString ParentPath = FString::Printf(TEXT("/Script/%s.%s"), 
-            *FPackageName::GetShortName(Class->GetSuperClass()->GetOutermost()->GetName()),
-            *Class->GetSuperClass()->GetName());
-        
         // Look up parent ID or generate one
-        if (!ClassIdMap.Contains(ParentPath))
-        {
-            ParentClassId = GenerateClassId(Class->GetSuperClass());
-        }
-        else
-        {
-            ParentClassId = ClassIdMap[ParentPath];
-        }
+        ParentClassId = GenerateClassId(Class->GetSuperClass());
     }
 
     // Get class attributes
@@ -402,9 +522,7 @@ FString USpacetimeDBCodeGenerator::GenerateClassRegistration(UClass* Class, int3
                       (IsActor && Class->GetDefaultObject<AActor>()->GetIsReplicated());
 
     // Get class path
-    FString ClassPath = FString::Printf(TEXT("/Script/%s.%s"), 
-        *FPackageName::GetShortName(Class->GetOutermost()->GetName()),
-        *Class->GetName());
+    FString ClassPath = GetClassPath(Class);
 
     // Generate Rust code
     FString Code = FString::Printf(TEXT("    ctx.db.object_class().insert(ObjectClass {\n"));
@@ -479,6 +597,7 @@ FString USpacetimeDBCodeGenerator::GeneratePropertyRegistrations(UClass* Class,
             FString PropLine = FString::Printf(TEXT("    ctx.db.class_property().insert(ClassProperty {\n"));
             PropLine += FString::Printf(TEXT("        class_id: %d,\n"), ClassId);
             PropLine += FString::Printf(TEXT("        property_name: \"%s\".to_string(),\n"), *Property->GetName());
+            PropLine += FString::Printf(TEXT("        property_id: %d,\n"), GeneratePropertyId(Property->GetName()));
             PropLine += FString::Printf(TEXT("        property_type: %s,\n"), *PropertyType);
             PropLine += FString::Printf(TEXT("        replicated: %s,\n"), IsReplicated ? TEXT("true") : TEXT("false"));
             PropLine += FString::Printf(TEXT("        readonly: %s,\n"), IsReadonly ? TEXT("true") : TEXT("false"));
@@ -491,6 +610,92 @@ FString USpacetimeDBCodeGenerator::GeneratePropertyRegistrations(UClass* Class,
     return FString::Join(PropertyLines, TEXT("\n"));
 }
 
+FString USpacetimeDBCodeGenerator::GeneratePropertyAccessors(UClass* Class)
+{
+    // Helper to map a property to the C++ type its accessor is compiled for
+    auto MapAccessorType = [](FProperty* Property) -> const TCHAR* {
+        if (const FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+            return BoolProp->IsNativeBool() ? TEXT("bool") : nullptr;
+        else if (Property->IsA<FByteProperty>())
+            return TEXT("uint8");
+        else if (Property->IsA<FIntProperty>())
+            return TEXT("int32");
+        else if (Property->IsA<FInt64Property>())
+            return TEXT("int64");
+        else if (Property->IsA<FUInt32Property>())
+            return TEXT("uint32");
+        else if (Property->IsA<FUInt64Property>())
+            return TEXT("uint64");
+        else if (Property->IsA<FFloatProperty>())
+            return TEXT("float");
+        else if (Property->IsA<FDoubleProperty>())
+            return TEXT("double");
+        else if (Property->IsA<FStrProperty>())
+            return TEXT("FString");
+        else if (Property->IsA<FNameProperty>())
+            return TEXT("FName");
+        else if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
+        {
+            if (StructProp->Struct == TBaseStructure<FVector>::Get())
+                return TEXT("FVector");
+            else if (StructProp->Struct == TBaseStructure<FRotator>::Get())
+                return TEXT("FRotator");
+            else if (StructProp->Struct == TBaseStructure<FQuat>::Get())
+                return TEXT("FQuat");
+            else if (StructProp->Struct == TBaseStructure<FTransform>::Get())
+                return TEXT("FTransform");
+            else if (StructProp->Struct == TBaseStructure<FColor>::Get())
+                return TEXT("FColor");
+        }
+
+        // Enums, text, references, containers and other structs use reflection
+        return nullptr;
+    };
+
+    TArray<FString> AccessorLines;
+
+    // Inherited properties are covered by the table of the class that declares them
+    for (TFieldIterator<FProperty> PropIt(Class, EFieldIteratorFlags::ExcludeSuper); PropIt; ++PropIt)
+    {
+        FProperty* Property = *PropIt;
+
+        // Same selection as the replicated properties registered with the server
+        if (!Property->HasAnyPropertyFlags(CPF_Net) || Property->HasAnyPropertyFlags(CPF_RepSkip | CPF_EditorOnly | CPF_Transient))
+            continue;
+
+        // The table names the member to take its offset, so protected and private ones stay on reflection
+        if (!Property->HasAnyPropertyFlags(CPF_NativeAccessSpecifierPublic))
+            continue;
+
+        const TCHAR* AccessorType = MapAccessorType(Property);
+        if (!AccessorType || Property->GetArrayDim() != 1)
+            continue;
+
+        AccessorLines.Add(FString::Printf(TEXT("        SPACETIMEDB_PROPERTY_ACCESSOR(TEXT(\"%s\"), %s, STRUCT_OFFSET(%s%s, %s)),"),
+            *Property->GetName(), AccessorType, Class->GetPrefixCPP(), *Class->GetName(), *Property->GetName()));
+    }
+
+    if (AccessorLines.Num() == 0)
+    {
+        return FString();
+    }
+
+    // Class names are only unique per package
+    const FString TableName = FString::Printf(TEXT("G%s_%sAccessors"),
+        *FPackageName::GetShortName(Class->GetOutermost()->GetName()), *Class->GetName());
+
+    TArray<FString> Lines;
+    Lines.Add(FString::Printf(TEXT("    // %s"), *Class->GetPathName()));
+    Lines.Add(FString::Printf(TEXT("    const FSpacetimeDBGeneratedPropertyAccessor %s[] ="), *TableName));
+    Lines.Add(TEXT("    {"));
+    Lines.Append(AccessorLines);
+    Lines.Add(TEXT("    };"));
+    Lines.Add(FString::Printf(TEXT("    FSpacetimeDBGeneratedAccessorRegistrar %sRegistrar(TEXT(\"%s\"), %s);"),
+        *TableName, *Class->GetPathName(), *TableName));
+
+    return FString::Join(Lines, TEXT("\n"));
+}
+
 void USpacetimeDBCodeGenerator::GetDefaultComponentsForClass(UClass* Class, TMap<FString, FString>& OutComponents)
 {
     // Only process actor classes
@@ -541,18 +746,250 @@ int32 USpacetimeDBCodeGenerator::GenerateClassId(UClass* Class)
         return 0;
         
     // Get class path
-    FString ClassPath = FString::Printf(TEXT("/Script/%s.%s"), 
-        *FPackageName::GetShortName(Class->GetOutermost()->GetName()),
-        *Class->GetName());
+    FString ClassPath = GetClassPath(Class);
     
     // If already mapped, return existing ID
-    if (ClassIdMap.Contains(ClassPath))
+    if (const int32* Existing = ClassIdMap.Find(ClassPath))
     {
-        return ClassIdMap[ClassPath];
+        return *Existing;
+    }
+    
+    // Hash the path into the project range so the ID doesn't depend on discovery order. The range ends
+    // below the registry's direct table, so every generated ID resolves with an array index.
+    // A collision takes the next free ID; the manifest keeps that choice from then on.
+    constexpr int32 LastProjectClassId = FSpacetimeDBClassRegistry::MaxDirectClassId - 1;
+    constexpr uint32 ProjectIdRange = static_cast<uint32>(LastProjectClassId - FirstProjectClassId + 1);
+    int32 ClassId = FirstProjectClassId + static_cast<int32>(HashString(ClassPath) % ProjectIdRange);
+    while (const FString* Owner = ClassPathById.Find(ClassId))
+    {
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBCodeGenerator: Class ID %d of %s collides with %s"), ClassId, *ClassPath, **Owner);
+        ClassId = ClassId == LastProjectClassId ? FirstProjectClassId : ClassId + 1;
     }
     
-    // Generate new ID and store in map
-    int32 ClassId = NextClassId++;
     ClassIdMap.Add(ClassPath, ClassId);
+    ClassPathById.Add(ClassId, ClassPath);
+    bManifestDirty = true;
     return ClassId;
-} 
\ No newline at end of file
+}
+
+int32 USpacetimeDBCodeGenerator::GeneratePropertyId(const FString& PropertyName)
+{
+    if (const int32* Existing = PropertyIdMap.Find(PropertyName))
+    {
+        return *Existing;
+    }
+    
+    // 0 is the wire's "name follows" marker, so IDs start at 1
+    const int32 PropertyId = ++MaxPropertyId;
+    PropertyIdMap.Add(PropertyName, PropertyId);
+    bManifestDirty = true;
+    return PropertyId;
+}
+
+FString USpacetimeDBCodeGenerator::GetClassPath(const UClass* Class)
+{
+    return Class->GetPathName();
+}
+
+FString USpacetimeDBCodeGenerator::ComputeClassFingerprint(UClass* Class)
+{
+    // Everything the generated outputs read from the class itself
+    const bool IsActor = Class->IsChildOf(AActor::StaticClass());
+    FString Layout = FString::Printf(TEXT("%s|%d|%d|%d"),
+        Class->GetSuperClass() ? *GetClassPath(Class->GetSuperClass()) : TEXT(""),
+        IsActor ? 1 : 0,
+        Class->IsChildOf(UActorComponent::StaticClass()) ? 1 : 0,
+        Class->HasMetaData(TEXT("IsSpatiallyReplicatable")) || (IsActor && Class->GetDefaultObject<AActor>()->GetIsReplicated()) ? 1 : 0);
+
+    constexpr EPropertyFlags RelevantFlags = CPF_Net | CPF_RepSkip | CPF_SaveGame | CPF_Config | CPF_Edit | CPF_EditorOnly | CPF_Transient | CPF_DuplicateTransient;
+    for (TFieldIterator<FProperty> PropIt(Class, EFieldIteratorFlags::ExcludeSuper); PropIt; ++PropIt)
+    {
+        FProperty* Property = *PropIt;
+        Layout += FString::Printf(TEXT(";%s:%s:%llx:%d:%d"), *Property->GetName(), *Property->GetCPPType(),
+            static_cast<uint64>(Property->GetPropertyFlags() & RelevantFlags), Property->GetOffset_ForInternal(), Property->GetArrayDim());
+    }
+
+    const FString Fingerprint = HashToString(HashString(Layout));
+    FString& Stored = ClassFingerprints.FindOrAdd(GetClassPath(Class));
+    if (Stored != Fingerprint)
+    {
+        if (!Stored.IsEmpty())
+        {
+            UE_LOG(LogTemp, Log, TEXT("SpacetimeDBCodeGenerator: Layout of %s changed"), *Class->GetName());
+        }
+        Stored = Fingerprint;
+        bManifestDirty = true;
+    }
+    return Fingerprint;
+}
+
+FString USpacetimeDBCodeGenerator::ComputeOutputFingerprint(const FString& Inputs) const
+{
+    // Core classes are emitted whether or not they are in the inputs; the engine version covers them
+    return HashToString(HashString(FString::Printf(TEXT("v%d;%s;%s"), GeneratorVersion, *FEngineVersion::Current().ToString(), *Inputs)));
+}
+
+bool USpacetimeDBCodeGenerator::IsOutputUpToDate(const FString& OutputPath, const FString& Fingerprint) const
+{
+    const FString* Stored = OutputFingerprints.Find(FPaths::ConvertRelativePathToFull(OutputPath));
+    return Stored && *Stored == Fingerprint && FPaths::FileExists(OutputPath);
+}
+
+bool USpacetimeDBCodeGenerator::SaveOutput(const TArray<FString>& Lines, const FString& OutputPath, const FString& Fingerprint)
+{
+    // Leave the file (and its timestamp) alone if the content is the same, so nothing downstream rebuilds
+    FString Existing;
+    const FString Content = FString::Join(Lines, LINE_TERMINATOR) + LINE_TERMINATOR;
+    if (!FFileHelper::LoadFileToString(Existing, *OutputPath) || Existing != Content)
+    {
+        if (!FFileHelper::SaveStringToFile(Content, *OutputPath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBCodeGenerator: Failed to write %s"), *OutputPath);
+            return false;
+        }
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBCodeGenerator: Wrote %s"), *OutputPath);
+    }
+
+    OutputFingerprints.Add(FPaths::ConvertRelativePathToFull(OutputPath), Fingerprint);
+    bManifestDirty = true;
+    SaveManifest();
+    return true;
+}
+
+FString USpacetimeDBCodeGenerator::GetManifestFilePath() const
+{
+    return FPaths::Combine(FPaths::ProjectDir(), ClassIdManifestPath);
+}
+
+void USpacetimeDBCodeGenerator::LoadManifest()
+{
+    FString ManifestJson;
+    if (!FFileHelper::LoadFileToString(ManifestJson, *GetManifestFilePath()))
+    {
+        return;
+    }
+
+    TSharedPtr<FJsonObject> Manifest;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ManifestJson);
+    if (!FJsonSerializer::Deserialize(Reader, Manifest) || !Manifest.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBCodeGenerator: Ignoring unreadable class ID manifest %s"), *GetManifestFilePath());
+        return;
+    }
+
+    const TSharedPtr<FJsonObject>* Classes = nullptr;
+    if (Manifest->TryGetObjectField(TEXT("classes"), Classes))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*Classes)->Values)
+        {
+            const TSharedPtr<FJsonObject>* ClassEntry = nullptr;
+            int32 ClassId = 0;
+            if (!Entry.Value->TryGetObject(ClassEntry) || !(*ClassEntry)->TryGetNumberField(TEXT("id"), ClassId) || ClassId < FirstProjectClassId)
+            {
+                continue;
+            }
+
+            if (const FString* Owner = ClassPathById.Find(ClassId))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBCodeGenerator: Manifest assigns class ID %d to both %s and %s"), ClassId, **Owner, *Entry.Key);
+                continue;
+            }
+
+            ClassIdMap.Add(Entry.Key, ClassId);
+            ClassPathById.Add(ClassId, Entry.Key);
+
+            FString Fingerprint;
+            if ((*ClassEntry)->TryGetStringField(TEXT("fingerprint"), Fingerprint))
+            {
+                ClassFingerprints.Add(Entry.Key, Fingerprint);
+            }
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* Properties = nullptr;
+    if (Manifest->TryGetObjectField(TEXT("properties"), Properties))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*Properties)->Values)
+        {
+            int32 PropertyId = 0;
+            if (Entry.Value->TryGetNumber(PropertyId) && PropertyId > 0)
+            {
+                PropertyIdMap.Add(Entry.Key, PropertyId);
+                MaxPropertyId = FMath::Max(MaxPropertyId, PropertyId);
+            }
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* Outputs = nullptr;
+    if (Manifest->TryGetObjectField(TEXT("outputs"), Outputs))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*Outputs)->Values)
+        {
+            OutputFingerprints.Add(Entry.Key, Entry.Value->AsString());
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBCodeGenerator: Loaded %d class IDs from %s"), ClassPathById.Num(), *GetManifestFilePath());
+}
+
+void USpacetimeDBCodeGenerator::SaveManifest()
+{
+    if (!bManifestDirty)
+    {
+        return;
+    }
+
+    // Sorted so the manifest diffs cleanly under source control
+    TArray<FString> ClassPaths;
+    ClassIdMap.GenerateKeyArray(ClassPaths);
+    ClassPaths.Sort();
+
+    TSharedRef<FJsonObject> Classes = MakeShared<FJsonObject>();
+    for (const FString& ClassPath : ClassPaths)
+    {
+        const int32 ClassId = ClassIdMap.FindChecked(ClassPath);
+        if (ClassId < FirstProjectClassId)
+        {
+            continue;
+        }
+
+        TSharedRef<FJsonObject> ClassEntry = MakeShared<FJsonObject>();
+        ClassEntry->SetNumberField(TEXT("id"), ClassId);
+        if (const FString* Fingerprint = ClassFingerprints.Find(ClassPath))
+        {
+            ClassEntry->SetStringField(TEXT("fingerprint"), *Fingerprint);
+        }
+        Classes->SetObjectField(ClassPath, ClassEntry);
+    }
+
+    PropertyIdMap.KeySort(TLess<FString>());
+    TSharedRef<FJsonObject> Properties = MakeShared<FJsonObject>();
+    for (const TPair<FString, int32>& Entry : PropertyIdMap)
+    {
+        Properties->SetNumberField(Entry.Key, Entry.Value);
+    }
+
+    OutputFingerprints.KeySort(TLess<FString>());
+    TSharedRef<FJsonObject> Outputs = MakeShared<FJsonObject>();
+    for (const TPair<FString, FString>& Entry : OutputFingerprints)
+    {
+        Outputs->SetStringField(Entry.Key, Entry.Value);
+    }
+
+    TSharedRef<FJsonObject> Manifest = MakeShared<FJsonObject>();
+    Manifest->SetNumberField(TEXT("version"), GeneratorVersion);
+    Manifest->SetObjectField(TEXT("classes"), Classes);
+    Manifest->SetObjectField(TEXT("properties"), Properties);
+    Manifest->SetObjectField(TEXT("outputs"), Outputs);
+
+    FString ManifestJson;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ManifestJson);
+    if (FJsonSerializer::Serialize(Manifest, Writer) && FFileHelper::SaveStringToFile(ManifestJson, *GetManifestFilePath()))
+    {
+        bManifestDirty = false;
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBCodeGenerator: Failed to write class ID manifest %s"), *GetManifestFilePath());
+    }
+}
@@ -0,0 +1,162 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBEventCapture.h"
+#include "SpacetimeDB_UnrealClient.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+    /** "STDB" */
+    constexpr uint32 CaptureMagic = 0x42445453;
+    constexpr uint32 CaptureVersion = 1;
+
+    /** Longest a replay sleeps at once, so cancelling never waits long */
+    constexpr double MaxReplaySleepSeconds = 0.01;
+}
+
+FSpacetimeDBEventRecorder::~FSpacetimeDBEventRecorder()
+{
+    Close();
+}
+
+bool FSpacetimeDBEventRecorder::Open(const FString& FilePath)
+{
+    Close();
+
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer.IsValid())
+    {
+        UE_LOG(LogSpacetimeDB, Error, TEXT("Could not create event capture '%s'"), *FilePath);
+        return false;
+    }
+
+    uint32 Magic = CaptureMagic;
+    uint32 Version = CaptureVersion;
+    *Writer << Magic << Version;
+
+    StartTime = FPlatformTime::Seconds();
+    NumRecorded = 0;
+    UE_LOG(LogSpacetimeDB, Log, TEXT("Recording inbound events to '%s'"), *FilePath);
+    return true;
+}
+
+void FSpacetimeDBEventRecorder::Close()
+{
+    if (!Writer.IsValid())
+    {
+        return;
+    }
+
+    Writer->Close();
+    Writer.Reset();
+    UE_LOG(LogSpacetimeDB, Log, TEXT("Event capture closed after %lld events"), NumRecorded);
+}
+
+void FSpacetimeDBEventRecorder::Record(const FSpacetimeDBInboundEvent& Event)
+{
+    double Time = FPlatformTime::Seconds() - StartTime;
+    uint8 Type = static_cast<uint8>(Event.Type);
+    uint64 Id = Event.Id;
+    uint64 SecondaryId = Event.SecondaryId;
+
+    // Saving only reads the values
+    *Writer << Time << Type << Id << SecondaryId;
+    *Writer << const_cast<FString&>(Event.Name);
+    *Writer << const_cast<FString&>(Event.Data);
+    *Writer << const_cast<TArray<uint8>&>(Event.Payload);
+    ++NumRecorded;
+}
+
+FSpacetimeDBEventReplayer::FSpacetimeDBEventReplayer(FEventSink InSink, bool bInAsFastAsPossible)
+    : Sink(MoveTemp(InSink))
+    , bAsFastAsPossible(bInAsFastAsPossible)
+{
+}
+
+FSpacetimeDBEventReplayer::~FSpacetimeDBEventReplayer()
+{
+    Cancel();
+}
+
+bool FSpacetimeDBEventReplayer::Start(const FString& FilePath)
+{
+    check(!Thread);
+
+    Reader.Reset(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader.IsValid())
+    {
+        UE_LOG(LogSpacetimeDB, Error, TEXT("Could not open event capture '%s'"), *FilePath);
+        return false;
+    }
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    *Reader << Magic << Version;
+    if (Reader->IsError() || Magic != CaptureMagic || Version != CaptureVersion)
+    {
+        UE_LOG(LogSpacetimeDB, Error, TEXT("'%s' is not an event capture of version %u"), *FilePath, CaptureVersion);
+        Reader.Reset();
+        return false;
+    }
+
+    Thread = FRunnableThread::Create(this, TEXT("SpacetimeDBEventReplay"));
+    if (!Thread)
+    {
+        Reader.Reset();
+        return false;
+    }
+
+    UE_LOG(LogSpacetimeDB, Log, TEXT("Replaying inbound events from '%s'%s"), *FilePath, bAsFastAsPossible ? TEXT(" as fast as possible") : TEXT(""));
+    return true;
+}
+
+void FSpacetimeDBEventReplayer::Cancel()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+    Reader.Reset();
+}
+
+uint32 FSpacetimeDBEventReplayer::Run()
+{
+    const double StartTime = FPlatformTime::Seconds();
+    FSpacetimeDBInboundEvent Event;
+
+    while (!bStopRequested && !Reader->AtEnd())
+    {
+        double Time = 0.0;
+        uint8 Type = 0;
+        *Reader << Time << Type << Event.Id << Event.SecondaryId;
+        *Reader << Event.Name << Event.Data << Event.Payload;
+
+        if (Reader->IsError() || Type > static_cast<uint8>(ESpacetimeDBInboundEventType::ClientRpcBinary))
+        {
+            UE_LOG(LogSpacetimeDB, Error, TEXT("Event capture is corrupt after %lld events; replay stopped"), NumReplayed.load());
+            break;
+        }
+        Event.Type = static_cast<ESpacetimeDBInboundEventType>(Type);
+
+        if (!bAsFastAsPossible)
+        {
+            for (double Wait = StartTime + Time - FPlatformTime::Seconds(); Wait > 0.0 && !bStopRequested; Wait = StartTime + Time - FPlatformTime::Seconds())
+            {
+                FPlatformProcess::SleepNoStats(static_cast<float>(FMath::Min(Wait, MaxReplaySleepSeconds)));
+            }
+        }
+
+        Sink(Event);
+        ++NumReplayed;
+    }
+
+    bFinished = true;
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBEventQueue.h"
+
+FSpacetimeDBEventQueue::FSpacetimeDBEventQueue(uint32 InCapacity)
+    : EnqueuePos(0)
+    , DequeuePos(0)
+    , HighWaterMark(0)
+{
+    const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2));
+    Mask = Capacity - 1;
+
+    Cells = MakeUnique<FCell[]>(Capacity);
+    for (uint32 Index = 0; Index < Capacity; ++Index)
+    {
+        Cells[Index].Sequence.store(Index, std::memory_order_relaxed);
+    }
+}
+
+bool FSpacetimeDBEventQueue::Enqueue(FSpacetimeDBInboundEvent& Event)
+{
+    return EnqueueWith([&Event](FSpacetimeDBInboundEvent& CellEvent)
+    {
+        CellEvent = MoveTemp(Event);
+    });
+}
+
+FSpacetimeDBEventQueue::FCell* FSpacetimeDBEventQueue::ClaimCell(uint64& OutPos)
+{
+    FCell* Cell = nullptr;
+    uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        Cell = &Cells[Pos & Mask];
+        const uint64 Sequence = Cell->Sequence.load(std::memory_order_acquire);
+        const int64 Diff = static_cast<int64>(Sequence) - static_cast<int64>(Pos);
+
+        if (Diff == 0)
+        {
+            // The cell is free for this position; claim it
+            if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (Diff < 0)
+        {
+            // The consumer hasn't released this cell yet: full
+            return nullptr;
+        }
+        else
+        {
+            // Another producer claimed it first
+            Pos = EnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    OutPos = Pos;
+    return Cell;
+}
+
+void FSpacetimeDBEventQueue::PublishCell(FCell& Cell, uint64 Pos)
+{
+    Cell.Sequence.store(Pos + 1, std::memory_order_release);
+
+    // Track the deepest the queue has been
+    const uint64 Depth = Pos + 1 - DequeuePos.load(std::memory_order_relaxed);
+    uint64 Observed = HighWaterMark.load(std::memory_order_relaxed);
+    while (Depth > Observed && !HighWaterMark.compare_exchange_weak(Observed, Depth, std::memory_order_relaxed))
+    {
+    }
+}
+
+bool FSpacetimeDBEventQueue::Dequeue(FSpacetimeDBInboundEvent& OutEvent)
+{
+    const uint64 Pos = DequeuePos.load(std::memory_order_relaxed);
+    FCell& Cell = Cells[Pos & Mask];
+    const uint64 Sequence = Cell.Sequence.load(std::memory_order_acquire);
+
+    if (static_cast<int64>(Sequence) - static_cast<int64>(Pos + 1) < 0)
+    {
+        // The producer for this position hasn't published yet
+        return false;
+    }
+
+    // Swapping rather than moving leaves the consumer's spent buffers in the cell for the next producer
+    Swap(OutEvent, Cell.Event);
+    TrimRetainedBuffers(Cell.Event);
+    DequeuePos.store(Pos + 1, std::memory_order_relaxed);
+
+    // Hand the cell back to producers for the next lap
+    Cell.Sequence.store(Pos + Mask + 1, std::memory_order_release);
+    return true;
+}
+
+void FSpacetimeDBEventQueue::TrimRetainedBuffers(FSpacetimeDBInboundEvent& Event)
+{
+    if (Event.Name.GetAllocatedSize() > MaxRetainedBufferBytes)
+    {
+        Event.Name.Empty();
+    }
+    if (Event.Data.GetAllocatedSize() > MaxRetainedBufferBytes)
+    {
+        Event.Data.Empty();
+    }
+    if (Event.Payload.GetAllocatedSize() > MaxRetainedBufferBytes)
+    {
+        Event.Payload.Empty();
+    }
+    if (Event.Decoded.Scalar.StringValue.GetAllocatedSize() > MaxRetainedBufferBytes)
+    {
+        Event.Decoded.Scalar.StringValue.Empty();
+    }
+}
+
+int32 FSpacetimeDBEventQueue::Num() const
+{
+    const uint64 Head = DequeuePos.load(std::memory_order_relaxed);
+    const uint64 Tail = EnqueuePos.load(std::memory_order_relaxed);
+    return Tail > Head ? static_cast<int32>(Tail - Head) : 0;
+}
@@ -0,0 +1,503 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBFrameArena.h"
+
+FSpacetimeDBFrameArena::FSpacetimeDBFrameArena(int32 InBlockSize)
+    : BlockSize(static_cast<SIZE_T>(FMath::Max(InBlockSize, 1024)))
+{
+}
+
+FSpacetimeDBFrameArena::~FSpacetimeDBFrameArena()
+{
+    FreeBlocks();
+}
+
+void* FSpacetimeDBFrameArena::Allocate(SIZE_T Size, SIZE_T Alignment)
+{
+    check(FMath::IsPowerOfTwo(Alignment));
+
+    for (;;)
+    {
+        if (Blocks.IsValidIndex(CurrentBlock))
+        {
+            FBlock& Block = Blocks[CurrentBlock];
+            const SIZE_T Aligned = Align(Offset, Alignment);
+            if (Aligned + Size <= Block.Size)
+            {
+                Offset = Aligned + Size;
+                BytesUsed += static_cast<int64>(Size);
+                HighWaterMark = FMath::Max(HighWaterMark, BytesUsed);
+                return Block.Data + Aligned;
+            }
+        }
+        AdvanceBlock(Size + Alignment);
+    }
+}
+
+FStringView FSpacetimeDBFrameArena::CopyString(FStringView Source)
+{
+    TCHAR* Chars = static_cast<TCHAR*>(Allocate((Source.Len() + 1) * sizeof(TCHAR), alignof(TCHAR)));
+    FMemory::Memcpy(Chars, Source.GetData(), Source.Len() * sizeof(TCHAR));
+    Chars[Source.Len()] = TEXT('\0');
+    return FStringView(Chars, Source.Len());
+}
+
+FStringView FSpacetimeDBFrameArena::ConvertUtf8(const UTF8CHAR* Source, int32 Length)
+{
+    if (!Source || Length <= 0)
+    {
+        return FStringView();
+    }
+
+    const int32 ConvertedLength = FPlatformString::ConvertedLength<TCHAR>(Source, Length);
+    TCHAR* Chars = static_cast<TCHAR*>(Allocate((ConvertedLength + 1) * sizeof(TCHAR), alignof(TCHAR)));
+    FPlatformString::Convert(Chars, ConvertedLength, Source, Length);
+    Chars[ConvertedLength] = TEXT('\0');
+    return FStringView(Chars, ConvertedLength);
+}
+
+void FSpacetimeDBFrameArena::Reset()
+{
+    // A frame that spilled into several blocks gets one block that fits all of it next time
+    if (Blocks.Num() > 1 && CurrentBlock > 0)
+    {
+        const SIZE_T Combined = static_cast<SIZE_T>(BytesReserved);
+        FreeBlocks();
+        BlockSize = FMath::Max(BlockSize, Combined);
+        AdvanceBlock(BlockSize);
+    }
+
+    CurrentBlock = 0;
+    Offset = 0;
+    BytesUsed = 0;
+}
+
+void FSpacetimeDBFrameArena::AdvanceBlock(SIZE_T MinSize)
+{
+    if (Blocks.IsValidIndex(CurrentBlock + 1) && Blocks[CurrentBlock + 1].Size >= MinSize)
+    {
+        ++CurrentBlock;
+        Offset = 0;
+        return;
+    }
+
+    FBlock Block;
+    Block.Size = FMath::Max(BlockSize, MinSize);
+    Block.Data = static_cast<uint8*>(FMemory::Malloc(Block.Size));
+    BytesReserved += static_cast<int64>(Block.Size);
+
+    // Keep the spare blocks after the new one so a later frame can still reach them
+    CurrentBlock = Blocks.IsEmpty() ? 0 : CurrentBlock + 1;
+    Blocks.Insert(Block, CurrentBlock);
+    Offset = 0;
+}
+
+void FSpacetimeDBFrameArena::FreeBlocks()
+{
+    for (FBlock& Block : Blocks)
+    {
+        FMemory::Free(Block.Data);
+    }
+    Blocks.Reset();
+    CurrentBlock = 0;
+    Offset = 0;
+    BytesReserved = 0;
+}
+
+namespace
+{
+    /** Nesting deeper than this is rejected rather than risking the stack */
+    constexpr int32 MaxJsonDepth = 64;
+
+    /** Recursive descent parser writing FSpacetimeDBArenaJsonValue nodes into an arena */
+    struct FArenaJsonParser
+    {
+        const TCHAR* Cursor;
+        const TCHAR* End;
+        FSpacetimeDBFrameArena& Arena;
+
+        void SkipWhitespace()
+        {
+            while (Cursor < End && (*Cursor == TEXT(' ') || *Cursor == TEXT('\t') || *Cursor == TEXT('\n') || *Cursor == TEXT('\r')))
+            {
+                ++Cursor;
+            }
+        }
+
+        bool Consume(const TCHAR* Literal)
+        {
+            const TCHAR* Scan = Cursor;
+            for (; *Literal; ++Literal, ++Scan)
+            {
+                if (Scan >= End || *Scan != *Literal)
+                {
+                    return false;
+                }
+            }
+            Cursor = Scan;
+            return true;
+        }
+
+        static int32 HexDigit(TCHAR Char)
+        {
+            if (Char >= TEXT('0') && Char <= TEXT('9')) return Char - TEXT('0');
+            if (Char >= TEXT('a') && Char <= TEXT('f')) return Char - TEXT('a') + 10;
+            if (Char >= TEXT('A') && Char <= TEXT('F')) return Char - TEXT('A') + 10;
+            return -1;
+        }
+
+        bool ReadHex4(uint32& OutCodeUnit)
+        {
+            if (End - Cursor < 4)
+            {
+                return false;
+            }
+            OutCodeUnit = 0;
+            for (int32 Index = 0; Index < 4; ++Index)
+            {
+                const int32 Digit = HexDigit(*Cursor++);
+                if (Digit < 0)
+                {
+                    return false;
+                }
+                OutCodeUnit = (OutCodeUnit << 4) | static_cast<uint32>(Digit);
+            }
+            return true;
+        }
+
+        /** Reads a string after its opening quote */
+        bool ParseString(FStringView& OutString)
+        {
+            // Without escapes the string is used in place
+            const TCHAR* Start = Cursor;
+            bool bHasEscapes = false;
+            while (Cursor < End && *Cursor != TEXT('"'))
+            {
+                if (*Cursor == TEXT('\\'))
+                {
+                    bHasEscapes = true;
+                    ++Cursor;
+                }
+                ++Cursor;
+            }
+            if (Cursor >= End)
+            {
+                return false;
+            }
+
+            const int32 RawLength = static_cast<int32>(Cursor - Start);
+            ++Cursor;
+            if (!bHasEscapes)
+            {
+                OutString = FStringView(Start, RawLength);
+                return true;
+            }
+
+            // Unescaping never makes a string longer
+            TCHAR* Chars = static_cast<TCHAR*>(Arena.Allocate((RawLength + 1) * sizeof(TCHAR), alignof(TCHAR)));
+            int32 Length = 0;
+            const TCHAR* Saved = Cursor;
+            Cursor = Start;
+            const TCHAR* StringEnd = Start + RawLength;
+            while (Cursor < StringEnd)
+            {
+                TCHAR Char = *Cursor++;
+                if (Char != TEXT('\\'))
+                {
+                    Chars[Length++] = Char;
+                    continue;
+                }
+
+                switch (*Cursor++)
+                {
+                case TEXT('"'): Chars[Length++] = TEXT('"'); break;
+                case TEXT('\\'): Chars[Length++] = TEXT('\\'); break;
+                case TEXT('/'): Chars[Length++] = TEXT('/'); break;
+                case TEXT('b'): Chars[Length++] = TEXT('\b'); break;
+                case TEXT('f'): Chars[Length++] = TEXT('\f'); break;
+                case TEXT('n'): Chars[Length++] = TEXT('\n'); break;
+                case TEXT('r'): Chars[Length++] = TEXT('\r'); break;
+                case TEXT('t'): Chars[Length++] = TEXT('\t'); break;
+                case TEXT('u'):
+                    {
+                        uint32 CodeUnit = 0;
+                        if (!ReadHex4(CodeUnit))
+                        {
+                            return false;
+                        }
+                        if constexpr (sizeof(TCHAR) == 4)
+                        {
+                            // Join surrogate pairs so wide strings hold real code points
+                            uint32 Low = 0;
+                            if (CodeUnit >= 0xD800 && CodeUnit < 0xDC00 && StringEnd - Cursor >= 6 &&
+                                Cursor[0] == TEXT('\\') && Cursor[1] == TEXT('u'))
+                            {
+                                Cursor += 2;
+                                if (!ReadHex4(Low) || Low < 0xDC00 || Low > 0xDFFF)
+                                {
+                                    return false;
+                                }
+                                CodeUnit = 0x10000 + ((CodeUnit - 0xD800) << 10) + (Low - 0xDC00);
+                            }
+                        }
+                        Chars[Length++] = static_cast<TCHAR>(CodeUnit);
+                    }
+                    break;
+                default:
+                    return false;
+                }
+            }
+            Chars[Length] = TEXT('\0');
+            Cursor = Saved;
+            OutString = FStringView(Chars, Length);
+            return true;
+        }
+
+        bool ParseNumber(FSpacetimeDBArenaJsonValue& OutValue)
+        {
+            const TCHAR* Start = Cursor;
+            while (Cursor < End && (FChar::IsDigit(*Cursor) || *Cursor == TEXT('-') || *Cursor == TEXT('+') ||
+                *Cursor == TEXT('.') || *Cursor == TEXT('e') || *Cursor == TEXT('E')))
+            {
+                ++Cursor;
+            }
+
+            const int32 Length = static_cast<int32>(Cursor - Start);
+            if (Length == 0)
+            {
+                return false;
+            }
+
+            OutValue.Type = ESpacetimeDBArenaJsonType::Number;
+            OutValue.StringValue = FStringView(Start, Length);
+
+            // Atod needs a terminator; literals are short enough for the stack
+            TCHAR Buffer[64];
+            if (Length < UE_ARRAY_COUNT(Buffer))
+            {
+                FMemory::Memcpy(Buffer, Start, Length * sizeof(TCHAR));
+                Buffer[Length] = TEXT('\0');
+                OutValue.NumberValue = FCString::Atod(Buffer);
+            }
+            else
+            {
+                OutValue.NumberValue = FCString::Atod(Arena.CopyString(OutValue.StringValue).GetData());
+            }
+            return true;
+        }
+
+        bool ParseValue(FSpacetimeDBArenaJsonValue& OutValue, int32 Depth)
+        {
+            SkipWhitespace();
+            if (Cursor >= End)
+            {
+                return false;
+            }
+
+            switch (*Cursor)
+            {
+            case TEXT('{'):
+                ++Cursor;
+                return ParseObject(OutValue, Depth + 1);
+            case TEXT('['):
+                ++Cursor;
+                return ParseArray(OutValue, Depth + 1);
+            case TEXT('"'):
+                ++Cursor;
+                OutValue.Type = ESpacetimeDBArenaJsonType::String;
+                return ParseString(OutValue.StringValue);
+            case TEXT('t'):
+                OutValue.Type = ESpacetimeDBArenaJsonType::Bool;
+                OutValue.BoolValue = true;
+                return Consume(TEXT("true"));
+            case TEXT('f'):
+                OutValue.Type = ESpacetimeDBArenaJsonType::Bool;
+                OutValue.BoolValue = false;
+                return Consume(TEXT("false"));
+            case TEXT('n'):
+                OutValue.Type = ESpacetimeDBArenaJsonType::Null;
+                return Consume(TEXT("null"));
+            default:
+                return ParseNumber(OutValue);
+            }
+        }
+
+        bool ParseArray(FSpacetimeDBArenaJsonValue& OutValue, int32 Depth)
+        {
+            if (Depth > MaxJsonDepth)
+            {
+                return false;
+            }
+
+            // Elements are gathered first so the arena copy is one contiguous run
+            TArray<FSpacetimeDBArenaJsonValue, TInlineAllocator<8>> Elements;
+            SkipWhitespace();
+            if (Cursor < End && *Cursor == TEXT(']'))
+            {
+                ++Cursor;
+            }
+            else
+            {
+                for (;;)
+                {
+                    if (!ParseValue(Elements.AddDefaulted_GetRef(), Depth))
+                    {
+                        return false;
+                    }
+                    SkipWhitespace();
+                    if (Cursor >= End)
+                    {
+                        return false;
+                    }
+                    if (*Cursor++ == TEXT(']'))
+                    {
+                        break;
+                    }
+                    if (Cursor[-1] != TEXT(','))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            OutValue.Type = ESpacetimeDBArenaJsonType::Array;
+            OutValue.NumChildren = Elements.Num();
+            FSpacetimeDBArenaJsonValue* Children = Arena.NewArray<FSpacetimeDBArenaJsonValue>(Elements.Num());
+            FMemory::Memcpy(Children, Elements.GetData(), Elements.Num() * sizeof(FSpacetimeDBArenaJsonValue));
+            OutValue.Children = Children;
+            return true;
+        }
+
+        bool ParseObject(FSpacetimeDBArenaJsonValue& OutValue, int32 Depth)
+        {
+            if (Depth > MaxJsonDepth)
+            {
+                return false;
+            }
+
+            TArray<FStringView, TInlineAllocator<8>> FieldKeys;
+            TArray<FSpacetimeDBArenaJsonValue, TInlineAllocator<8>> FieldValues;
+            SkipWhitespace();
+            if (Cursor < End && *Cursor == TEXT('}'))
+            {
+                ++Cursor;
+            }
+            else
+            {
+                for (;;)
+                {
+                    SkipWhitespace();
+                    if (Cursor >= End || *Cursor++ != TEXT('"') || !ParseString(FieldKeys.AddDefaulted_GetRef()))
+                    {
+                        return false;
+                    }
+                    SkipWhitespace();
+                    if (Cursor >= End || *Cursor++ != TEXT(':'))
+                    {
+                        return false;
+                    }
+                    if (!ParseValue(FieldValues.AddDefaulted_GetRef(), Depth))
+                    {
+                        return false;
+                    }
+                    SkipWhitespace();
+                    if (Cursor >= End)
+                    {
+                        return false;
+                    }
+                    if (*Cursor++ == TEXT('}'))
+                    {
+                        break;
+                    }
+                    if (Cursor[-1] != TEXT(','))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            OutValue.Type = ESpacetimeDBArenaJsonType::Object;
+            OutValue.NumChildren = FieldValues.Num();
+            FSpacetimeDBArenaJsonValue* Children = Arena.NewArray<FSpacetimeDBArenaJsonValue>(FieldValues.Num());
+            FMemory::Memcpy(Children, FieldValues.GetData(), FieldValues.Num() * sizeof(FSpacetimeDBArenaJsonValue));
+            FStringView* Keys = Arena.NewArray<FStringView>(FieldKeys.Num());
+            FMemory::Memcpy(Keys, FieldKeys.GetData(), FieldKeys.Num() * sizeof(FStringView));
+            OutValue.Children = Children;
+            OutValue.Keys = Keys;
+            return true;
+        }
+    };
+
+    /** Reads the leading decimal digits of a literal */
+    uint64 ParseDigits(FStringView Literal)
+    {
+        uint64 Value = 0;
+        for (const TCHAR Char : Literal)
+        {
+            if (!FChar::IsDigit(Char))
+            {
+                break;
+            }
+            Value = Value * 10 + static_cast<uint64>(Char - TEXT('0'));
+        }
+        return Value;
+    }
+}
+
+bool FSpacetimeDBArenaJsonValue::IsInteger() const
+{
+    if (Type != ESpacetimeDBArenaJsonType::Number || StringValue.IsEmpty())
+    {
+        return false;
+    }
+    for (const TCHAR Char : StringValue)
+    {
+        if (Char == TEXT('.') || Char == TEXT('e') || Char == TEXT('E'))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int64 FSpacetimeDBArenaJsonValue::GetInt64() const
+{
+    const bool bNegative = StringValue.StartsWith(TEXT('-'));
+    const uint64 Magnitude = ParseDigits(bNegative ? StringValue.RightChop(1) : StringValue);
+    return bNegative ? static_cast<int64>(0 - Magnitude) : static_cast<int64>(Magnitude);
+}
+
+uint64 FSpacetimeDBArenaJsonValue::GetUInt64() const
+{
+    return ParseDigits(StringValue);
+}
+
+const FSpacetimeDBArenaJsonValue* FSpacetimeDBArenaJsonValue::Find(FStringView Key) const
+{
+    if (Type != ESpacetimeDBArenaJsonType::Object)
+    {
+        return nullptr;
+    }
+    for (int32 Index = 0; Index < NumChildren; ++Index)
+    {
+        if (Keys[Index].Equals(Key, ESearchCase::CaseSensitive))
+        {
+            return &Children[Index];
+        }
+    }
+    return nullptr;
+}
+
+const FSpacetimeDBArenaJsonValue* FSpacetimeDBArenaJsonValue::Parse(FStringView Json, FSpacetimeDBFrameArena& Arena)
+{
+    FArenaJsonParser Parser{ Json.GetData(), Json.GetData() + Json.Len(), Arena };
+    FSpacetimeDBArenaJsonValue* Root = Arena.New<FSpacetimeDBArenaJsonValue>();
+    if (!Parser.ParseValue(*Root, 0))
+    {
+        return nullptr;
+    }
+
+    // Only whitespace may follow the document
+    Parser.SkipWhitespace();
+    return Parser.Cursor == Parser.End ? Root : nullptr;
+}
@@ -0,0 +1,92 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBGeneratedAccessors.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    /** Function-local so generated registrars can run before this module's globals are constructed */
+    struct FAccessorTables
+    {
+        FCriticalSection Lock;
+        TMap<FString, TConstArrayView<FSpacetimeDBGeneratedPropertyAccessor>> ByClassPath;
+    };
+
+    FAccessorTables& GetTables()
+    {
+        static FAccessorTables Tables;
+        return Tables;
+    }
+}
+
+void FSpacetimeDBGeneratedAccessors::RegisterClass(const TCHAR* ClassPath, TConstArrayView<FSpacetimeDBGeneratedPropertyAccessor> Accessors)
+{
+    FAccessorTables& Tables = GetTables();
+    FScopeLock Lock(&Tables.Lock);
+    Tables.ByClassPath.Add(ClassPath, Accessors);
+}
+
+void FSpacetimeDBGeneratedAccessors::UnregisterClass(const TCHAR* ClassPath)
+{
+    FAccessorTables& Tables = GetTables();
+    FScopeLock Lock(&Tables.Lock);
+    Tables.ByClassPath.Remove(ClassPath);
+}
+
+const FSpacetimeDBGeneratedPropertyAccessor* FSpacetimeDBGeneratedAccessors::FindAccessor(const FProperty* Property)
+{
+    const UClass* OwnerClass = Property ? Property->GetOwnerClass() : nullptr;
+    if (!OwnerClass || !OwnerClass->HasAnyClassFlags(CLASS_Native) || Property->GetArrayDim() != 1)
+    {
+        return nullptr;
+    }
+
+    const FSpacetimeDBGeneratedPropertyAccessor* Found = nullptr;
+    {
+        FAccessorTables& Tables = GetTables();
+        FScopeLock Lock(&Tables.Lock);
+        const TConstArrayView<FSpacetimeDBGeneratedPropertyAccessor>* Accessors = Tables.ByClassPath.Find(OwnerClass->GetPathName());
+        if (!Accessors)
+        {
+            return nullptr;
+        }
+
+        const FString PropertyName = Property->GetName();
+        for (const FSpacetimeDBGeneratedPropertyAccessor& Accessor : *Accessors)
+        {
+            if (PropertyName == Accessor.PropertyName)
+            {
+                Found = &Accessor;
+                break;
+            }
+        }
+    }
+
+    if (!Found)
+    {
+        return nullptr;
+    }
+
+    // Bitfield bools share a byte with their neighbours and can't be written as a bool
+    const FBoolProperty* BoolProp = CastField<FBoolProperty>(Property);
+    const bool bMatches = Found->TypeTag == FSpacetimeDBBinaryCodec::GetPropertyTypeTag(Property)
+        && Found->Offset == Property->GetOffset_ForInternal()
+        && Found->Size == Property->GetElementSize()
+        && (!BoolProp || BoolProp->IsNativeBool());
+
+    if (!bMatches)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBGeneratedAccessors: Generated accessor for %s.%s no longer matches its property; regenerate the accessors"),
+            *OwnerClass->GetName(), *Property->GetName());
+        return nullptr;
+    }
+    return Found;
+}
+
+int32 FSpacetimeDBGeneratedAccessors::GetNumClasses()
+{
+    FAccessorTables& Tables = GetTables();
+    FScopeLock Lock(&Tables.Lock);
+    return Tables.ByClassPath.Num();
+}
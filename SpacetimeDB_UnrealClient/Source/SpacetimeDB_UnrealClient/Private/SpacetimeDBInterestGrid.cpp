@@ -0,0 +1,85 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBInterestGrid.h"
+#include "SpacetimeDBSettings.h"
+
+bool FSpacetimeDBInterestGrid::Update(const FVector& ViewLocation, TArray<FString>& OutSubscribe, TArray<FString>& OutUnsubscribe)
+{
+    if (Cells.Num() == 0)
+    {
+        const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+        CellSize = FMath::Max(Settings->InterestCellSize, 1.0f);
+        Radius = FMath::Max(Settings->InterestRadiusCells, 0);
+        Hysteresis = FMath::Max(Settings->InterestHysteresisCells, 0);
+        Tables = Settings->InterestTables;
+        CellXColumn = Settings->InterestCellXColumn;
+        CellYColumn = Settings->InterestCellYColumn;
+    }
+    else if (GetCell(ViewLocation, CellSize) == ViewCell)
+    {
+        return false;
+    }
+
+    ViewCell = GetCell(ViewLocation, CellSize);
+    bool bChanged = false;
+
+    for (int32 DY = -Radius; DY <= Radius; ++DY)
+    {
+        for (int32 DX = -Radius; DX <= Radius; ++DX)
+        {
+            const FIntPoint Cell(ViewCell.X + DX, ViewCell.Y + DY);
+            bool bAlreadySubscribed = false;
+            Cells.Add(Cell, &bAlreadySubscribed);
+            if (!bAlreadySubscribed)
+            {
+                AppendCellQueries(Cell, OutSubscribe);
+                bChanged = true;
+            }
+        }
+    }
+
+    const int32 KeepDistance = Radius + Hysteresis;
+    for (auto It = Cells.CreateIterator(); It; ++It)
+    {
+        const FIntPoint Offset = *It - ViewCell;
+        if (FMath::Max(FMath::Abs(Offset.X), FMath::Abs(Offset.Y)) > KeepDistance)
+        {
+            AppendCellQueries(*It, OutUnsubscribe);
+            It.RemoveCurrent();
+            bChanged = true;
+        }
+    }
+
+    return bChanged;
+}
+
+void FSpacetimeDBInterestGrid::Reset(TArray<FString>* OutUnsubscribe)
+{
+    if (OutUnsubscribe)
+    {
+        for (const FIntPoint& Cell : Cells)
+        {
+            AppendCellQueries(Cell, *OutUnsubscribe);
+        }
+    }
+    Cells.Reset();
+}
+
+bool FSpacetimeDBInterestGrid::IsInInterest(const FVector& Location) const
+{
+    return Cells.Num() > 0 && Cells.Contains(GetCell(Location, CellSize));
+}
+
+FIntPoint FSpacetimeDBInterestGrid::GetCell(const FVector& Location, float CellSize)
+{
+    return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void FSpacetimeDBInterestGrid::AppendCellQueries(const FIntPoint& Cell, TArray<FString>& OutQueries) const
+{
+    for (const FString& Table : Tables)
+    {
+        OutQueries.Add(FString::Printf(TEXT("SELECT * FROM %s WHERE %s = %d AND %s = %d"),
+            *Table, *CellXColumn, Cell.X, *CellYColumn, Cell.Y));
+    }
+}
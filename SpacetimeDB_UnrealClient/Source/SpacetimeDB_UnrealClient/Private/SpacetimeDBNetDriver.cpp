@@ -3,6 +3,9 @@
 #include "SpacetimeDBNetDriver.h"
 #include "SpacetimeDBNetConnection.h"
 #include "SpacetimeDBClient.h"
+#include "SpacetimeDBSettings.h"
+#include "SpacetimeDBFFI.h"
+#include "SpacetimeDBStats.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "GameFramework/GameModeBase.h"
@@ -12,6 +15,9 @@
 #include "Serialization/JsonSerializer.h"
 #include "SpacetimeDBNetDriverPrivate.h"
 
+// Identifies the net driver's tables in the client's subscription manager
+static const FName NetDriverSubscriptionOwner(TEXT("NetDriver"));
+
 // FSpacetimeDBReplicationData structure for mapping between UE objects and SpacetimeDB data
 struct FSpacetimeDBReplicationData
 {
@@ -43,6 +49,8 @@ public:
         , Database("")
         , AuthToken("")
     {
+        // Room for a typical tick of replication traffic up front
+        OutgoingFrame.Reserve(16 * 1024);
     }
     
     // Connection state
@@ -54,8 +62,12 @@ public:
     // Replication data for actors
     TMap<FString, FSpacetimeDBReplicationData> ActorReplicationData;
     
-    // Buffer for outgoing packets to be processed in TickFlush
-    TArray<TPair<FString, TArray<uint8>>> OutgoingPackets;
+    // Framed outgoing packets for this tick, sent in one call from TickFlush.
+    // Reset keeps the allocation, so after warm-up LowLevelSend never allocates.
+    TArray<uint8> OutgoingFrame;
+    
+    // Number of packets framed into OutgoingFrame
+    uint32 OutgoingPacketCount = 0;
 };
 
 // Constructor
@@ -75,6 +87,7 @@ USpacetimeDBNetDriver::USpacetimeDBNetDriver(const FObjectInitializer& ObjectIni
     // Register for client events
     OnConnectedHandle = Client.OnConnected.AddUObject(this, &USpacetimeDBNetDriver::HandleConnected);
     OnDisconnectedHandle = Client.OnDisconnected.AddUObject(this, &USpacetimeDBNetDriver::HandleDisconnected);
+    OnReconnectFailedHandle = Client.OnReconnectFailed.AddUObject(this, &USpacetimeDBNetDriver::HandleReconnectFailed);
     OnIdentityReceivedHandle = Client.OnIdentityReceived.AddUObject(this, &USpacetimeDBNetDriver::HandleIdentityReceived);
     OnEventReceivedHandle = Client.OnEventReceived.AddUObject(this, &USpacetimeDBNetDriver::HandleEventReceived);
     OnErrorOccurredHandle = Client.OnErrorOccurred.AddUObject(this, &USpacetimeDBNetDriver::HandleErrorOccurred);
@@ -191,8 +204,8 @@ bool USpacetimeDBNetDriver::InitListen(FNetworkNotify* InNotify, FURL& LocalURL,
 void USpacetimeDBNetDriver::TickDispatch(float DeltaTime)
 {
     // Process incoming data from SpacetimeDB
-    // The SpacetimeDBClient handles this asynchronously via callbacks,
-    // so we don't need to do anything special here.
+    // The FFI callbacks only queue events; dispatch them here within the frame budget
+    Client.ProcessInboundEvents(USpacetimeDBSettings::Get()->InboundEventTimeBudgetMs / 1000.0);
     
     // Call parent implementation
     Super::TickDispatch(DeltaTime);
@@ -203,31 +216,35 @@ void USpacetimeDBNetDriver::TickFlush(float DeltaTime)
     // Call parent implementation first to gather outgoing packets
     Super::TickFlush(DeltaTime);
     
-    // Now process any outgoing packets that were queued in LowLevelSend
+    // Reducer calls queued this tick go out ahead of the packets
+    Client.FlushReducerCalls();
+    
+    // Now send every packet LowLevelSend framed this tick in a single FFI call
     FSpacetimeDBNetDriverPrivate* PrivateData = static_cast<FSpacetimeDBNetDriverPrivate*>(NetDriverPrivate);
     
-    if (PrivateData->OutgoingPackets.Num() > 0)
+    if (PrivateData->OutgoingPacketCount > 0)
     {
-        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBNetDriver: TickFlush processing %d outgoing packets"), PrivateData->OutgoingPackets.Num());
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBNetDriver: TickFlush sending %u outgoing packets (%d bytes)"),
+            PrivateData->OutgoingPacketCount, PrivateData->OutgoingFrame.Num());
         
-        // Process each outgoing packet
-        for (auto& Packet : PrivateData->OutgoingPackets)
+        if (!Client.IsConnected())
         {
-            const FString& ReducerName = Packet.Key;
-            const TArray<uint8>& Data = Packet.Value;
-            
-            // Convert binary data to Base64 for JSON compatibility
-            FString Base64Data = FBase64::Encode(Data.GetData(), Data.Num());
-            
-            // Create JSON for the reducer call
-            FString ArgsJson = FString::Printf(TEXT("{\"data\": \"%s\"}"), *Base64Data);
-            
-            // Call the reducer
-            Client.CallReducer(ReducerName, ArgsJson);
+            UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBNetDriver: Dropping %u outgoing packets - Not connected to SpacetimeDB"), PrivateData->OutgoingPacketCount);
+        }
+        else
+        {
+            Client.SelectConnection();
+            SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_SendNetworkPackets);
+            INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, PrivateData->OutgoingFrame.Num());
+            if (!send_network_packets(PrivateData->OutgoingFrame.GetData(), PrivateData->OutgoingFrame.Num(), PrivateData->OutgoingPacketCount))
+            {
+                UE_LOG(LogTemp, Error, TEXT("SpacetimeDBNetDriver: Failed to send %u outgoing packets"), PrivateData->OutgoingPacketCount);
+            }
         }
         
-        // Clear the queue
-        PrivateData->OutgoingPackets.Empty();
+        // Clear the frame, keeping its memory for the next tick
+        PrivateData->OutgoingFrame.Reset();
+        PrivateData->OutgoingPacketCount = 0;
     }
 }
 
@@ -241,34 +258,39 @@ void USpacetimeDBNetDriver::ProcessRemoteFunction(class AActor* Actor, class UFu
 
 void USpacetimeDBNetDriver::LowLevelSend(TSharedPtr<const FInternetAddr, ESPMode::ThreadSafe> Address, void* Data, int32 CountBits, FOutPacketTraits& Traits)
 {
-    // Assuming Address is not directly used in this SpacetimeDB implementation for sending,
-    // but logging it might still be useful.
-    FString AddressString = Address.IsValid() ? Address->ToString(true) : TEXT("InvalidAddress");
-    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBNetDriver: LowLevelSend to %s, %d bits"), *AddressString, CountBits);
+    // Address is not used for sending; SpacetimeDB routes packets by connection identity
+    if (UE_LOG_ACTIVE(LogTemp, Verbose))
+    {
+        FString AddressString = Address.IsValid() ? Address->ToString(true) : TEXT("InvalidAddress");
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBNetDriver: LowLevelSend to %s, %d bits"), *AddressString, CountBits);
+    }
     
-    // Get private implementation data correctly
     FSpacetimeDBNetDriverPrivate* PrivateData = this->NetDriverPrivate;
+    if (!PrivateData || CountBits <= 0)
+    {
+        return;
+    }
     
     // Convert bits to bytes (rounding up)
-    int32 NumBytes = (CountBits + 7) >> 3;
-    
-    // Get access to the binary data
-    uint8* ByteData = static_cast<uint8*>(Data);
-    
-    // Copy data to a new buffer
-    TArray<uint8> PacketData;
-    PacketData.Append(ByteData, NumBytes);
-    
-    // Queue for sending in TickFlush
-    // Here we're using "network_packet" as the reducer name
-    // In a real implementation, there might be different reducers for different packet types
-    PrivateData->OutgoingPackets.Add(TPair<FString, TArray<uint8>>(TEXT("network_packet"), PacketData));
+    const int32 NumBytes = (CountBits + 7) >> 3;
+    
+    // Frame the packet straight into the tick's send buffer: uint32 bit count, then the bytes
+    TArray<uint8>& Frame = PrivateData->OutgoingFrame;
+    const int32 FrameOffset = Frame.AddUninitialized(sizeof(uint32) + NumBytes);
+    const uint32 PacketBits = static_cast<uint32>(CountBits);
+    FMemory::Memcpy(Frame.GetData() + FrameOffset, &PacketBits, sizeof(uint32));
+    FMemory::Memcpy(Frame.GetData() + FrameOffset + sizeof(uint32), Data, NumBytes);
+    ++PrivateData->OutgoingPacketCount;
 }
 
 void USpacetimeDBNetDriver::Shutdown()
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBNetDriver: Shutdown"));
     
+    // Release our tables
+    Client.GetSubscriptions().SetQueries(NetDriverSubscriptionOwner, TArray<FString>());
+    SubscribedTables.Empty();
+    
     // Disconnect from SpacetimeDB
     Client.Disconnect();
     
@@ -285,6 +307,12 @@ void USpacetimeDBNetDriver::Shutdown()
         OnDisconnectedHandle.Reset();
     }
     
+    if (OnReconnectFailedHandle.IsValid())
+    {
+        Client.OnReconnectFailed.Remove(OnReconnectFailedHandle);
+        OnReconnectFailedHandle.Reset();
+    }
+    
     if (OnIdentityReceivedHandle.IsValid())
     {
         Client.OnIdentityReceived.Remove(OnIdentityReceivedHandle);
@@ -347,29 +375,53 @@ void USpacetimeDBNetDriver::HandleConnected()
     
     // Subscribe to relevant tables
     // For a real implementation, you'd subscribe to all tables needed for replication
+    SubscribedTables.Reset();
     SubscribedTables.Add(TEXT("actors"));
     SubscribedTables.Add(TEXT("network_packets"));
     
-    if (SubscribedTables.Num() > 0)
+    // Spatial tables are subscribed per cell by the subsystem's interest grid, on its own connection
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    if (Settings->bEnableInterestManagement)
     {
-        Client.SubscribeToTables(SubscribedTables);
+        SubscribedTables.RemoveAll([Settings](const FString& TableName)
+        {
+            return Settings->InterestTables.Contains(TableName);
+        });
     }
+    
+    // This is the driver's own connection, so these references are only counted against each other;
+    // the subsystem subscribes whatever it needs on its connection separately
+    Client.GetSubscriptions().SetQueries(NetDriverSubscriptionOwner, SubscribedTables);
 }
 
 void USpacetimeDBNetDriver::HandleDisconnected(const FString& Reason)
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBNetDriver: Disconnected from SpacetimeDB: %s"), *Reason);
     
-    // Clear subscriptions
-    SubscribedTables.Empty();
+    // Subscriptions stay held; the subscription manager re-subscribes them on reconnect
+    
+    // While the client retries, the connection stays open so the game keeps its world
+    if (Client.IsReconnecting())
+    {
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBNetDriver: Keeping the server connection open while reconnecting"));
+        return;
+    }
     
     // Notify the game code that we've been disconnected
     if (ServerConnection)
     {
         ServerConnection->SetConnectionState(EConnectionState::USOCK_Closed);
     }
+}
+
+void USpacetimeDBNetDriver::HandleReconnectFailed()
+{
+    UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBNetDriver: Could not reconnect to SpacetimeDB, closing the server connection"));
     
-    // TODO: Handle reconnection logic if desired
+    if (ServerConnection)
+    {
+        ServerConnection->SetConnectionState(EConnectionState::USOCK_Closed);
+    }
 }
 
 void USpacetimeDBNetDriver::HandleIdentityReceived(const FString& Identity)
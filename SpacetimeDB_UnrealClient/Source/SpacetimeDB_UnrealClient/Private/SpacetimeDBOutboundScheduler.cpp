@@ -0,0 +1,48 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBOutboundScheduler.h"
+
+void FSpacetimeDBOutboundScheduler::BeginFrame(float DeltaSeconds, float BytesPerSecond, float BurstSeconds)
+{
+    const double Refill = static_cast<double>(BytesPerSecond) * DeltaSeconds;
+    const double MaxSaved = FMath::Max(static_cast<double>(BytesPerSecond) * BurstSeconds, Refill);
+    BudgetBytes = FMath::Min(BudgetBytes + Refill, MaxSaved);
+}
+
+int32 FSpacetimeDBOutboundScheduler::Select(TArray<FSpacetimeDBOutboundCandidate>& Candidates, float DeltaSeconds, TSet<int64>& OutSelected)
+{
+    // A frame's own priority counts too, so an object seen for the first time isn't at zero
+    const float Step = FMath::Max(DeltaSeconds, UE_KINDA_SMALL_NUMBER);
+    for (FSpacetimeDBOutboundCandidate& Candidate : Candidates)
+    {
+        float& Accumulated = Accumulators.FindOrAdd(Candidate.ObjectId, 0.0f);
+        Accumulated += Candidate.Priority * Step;
+        Candidate.Priority = Accumulated;
+    }
+
+    Candidates.Sort([](const FSpacetimeDBOutboundCandidate& A, const FSpacetimeDBOutboundCandidate& B)
+    {
+        return A.Priority > B.Priority;
+    });
+
+    int32 NumHeldBack = 0;
+    for (const FSpacetimeDBOutboundCandidate& Candidate : Candidates)
+    {
+        if (BudgetBytes <= 0.0)
+        {
+            ++NumHeldBack;
+            continue;
+        }
+
+        OutSelected.Add(Candidate.ObjectId);
+        Accumulators.Remove(Candidate.ObjectId);
+        BudgetBytes -= Candidate.EstimatedBytes;
+    }
+    return NumHeldBack;
+}
+
+void FSpacetimeDBOutboundScheduler::Reset()
+{
+    Accumulators.Reset();
+    BudgetBytes = 0.0;
+}
@@ -6,6 +6,13 @@
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 
+/** Finds the subsystem of the game instance of the engine's current world */
+static USpacetimeDBSubsystem* FindSubsystem()
+{
+    UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(GEngine->GetWorld());
+    return GameInstance ? GameInstance->GetSubsystem<USpacetimeDBSubsystem>() : nullptr;
+}
+
 bool USpacetimeDBOwnershipHelper::HasOwnership(int64 ObjectId)
 {
     if (ObjectId <= 0)
@@ -14,95 +21,47 @@ bool USpacetimeDBOwnershipHelper::HasOwnership(int64 ObjectId)
     }
     
     // Get the subsystem
-    UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(GEngine->GetWorld());
-    if (!GameInstance)
-    {
-        return false;
-    }
-    
-    USpacetimeDBSubsystem* SpacetimeDB = GameInstance->GetSubsystem<USpacetimeDBSubsystem>();
+    USpacetimeDBSubsystem* SpacetimeDB = FindSubsystem();
     if (!SpacetimeDB)
     {
         return false;
     }
     
-    // Get the client ID
-    uint64 ClientId = SpacetimeDB->GetClient().GetClientID();
-    
-    // Get the owner ID for this object
-    int64 OwnerId = GetOwnerClientId(ObjectId);
-    
-    // Compare the client ID with the owner ID
-    return (OwnerId > 0) && (OwnerId == ClientId);
+    // Compare the client ID with the indexed owner ID
+    return SpacetimeDB->HasOwnership(ObjectId);
 }
 
 bool USpacetimeDBOwnershipHelper::HasAuthority(int64 ObjectId)
 {
-    UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(GEngine->GetWorld());
-    if (!GameInstance)
-    {
-        return false;
-    }
-
-    USpacetimeDBSubsystem* SpacetimeDB = GameInstance->GetSubsystem<USpacetimeDBSubsystem>();
+    USpacetimeDBSubsystem* SpacetimeDB = FindSubsystem();
     if (!SpacetimeDB || !SpacetimeDB->IsConnected())
     {
         return false;
     }
 
-    // Get the owner ID of the object
-    int64 OwnerClientId = GetOwnerClientId(ObjectId);
-    
     // SECURITY: Only allow clients to modify objects they explicitly own
     // Server-owned objects (owner_id == 0) should NOT be directly modifiable by clients
     // This prevents cheating by disallowing arbitrary modification of server-owned objects
     // Instead, clients should use validated RPCs to request changes to server-owned objects
-    return OwnerClientId == SpacetimeDB->GetClientId();
+    return SpacetimeDB->GetOwnerClientId(ObjectId) == SpacetimeDB->GetClientId();
 }
 
 int64 USpacetimeDBOwnershipHelper::GetOwnerClientId(int64 ObjectId)
 {
-    UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(GEngine->GetWorld());
-    if (!GameInstance)
-    {
-        return 0;
-    }
-
-    USpacetimeDBSubsystem* SpacetimeDB = GameInstance->GetSubsystem<USpacetimeDBSubsystem>();
+    USpacetimeDBSubsystem* SpacetimeDB = FindSubsystem();
     if (!SpacetimeDB)
     {
         return 0;
     }
 
-    // Get the object from the SpacetimeDB object map
-    UObject* Object = SpacetimeDB->FindObjectById(ObjectId);
-    if (!Object)
-    {
-        return 0;
-    }
-
-    // Try to get the owner client ID from the object's properties
-    FString OwnerIdJson = SpacetimeDB->GetPropertyJsonValue(ObjectId, TEXT("owner_id"));
-    if (OwnerIdJson.IsEmpty() || OwnerIdJson == TEXT("null"))
-    {
-        return 0; // No owner (server-owned)
-    }
-
-    // Parse the JSON string to get the owner ID
-    int64 OwnerClientId = FCString::Atoi64(*OwnerIdJson);
-    return OwnerClientId;
+    // The subsystem indexes both owner_client_id and owner_id as objects spawn and update
+    return SpacetimeDB->GetOwnerClientId(ObjectId);
 }
 
 bool USpacetimeDBOwnershipHelper::RequestSetOwner(int64 ObjectId, int64 NewOwnerClientId)
 {
     // Get the SpacetimeDB subsystem
-    UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(GEngine->GetWorld());
-    if (!GameInstance)
-    {
-        return false;
-    }
-    
-    USpacetimeDBSubsystem* SpacetimeDB = GameInstance->GetSubsystem<USpacetimeDBSubsystem>();
+    USpacetimeDBSubsystem* SpacetimeDB = FindSubsystem();
     if (!SpacetimeDB)
     {
         return false;
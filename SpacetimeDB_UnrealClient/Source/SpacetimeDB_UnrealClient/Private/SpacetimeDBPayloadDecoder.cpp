@@ -0,0 +1,133 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBPayloadDecoder.h"
+#include "SpacetimeDBFrameArena.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+
+namespace
+{
+    /** Scratch memory of the decoding thread; property values are small, so one block is plenty */
+    FSpacetimeDBFrameArena& GetDecodeArena()
+    {
+        thread_local FSpacetimeDBFrameArena Arena(4 * 1024);
+        return Arena;
+    }
+}
+
+bool FSpacetimeDBPayloadDecoder::DecodeScalar(const FString& Json, FSpacetimeDBDecodedScalar& OutScalar)
+{
+    OutScalar.Reset();
+
+    FSpacetimeDBFrameArena& Arena = GetDecodeArena();
+    const FSpacetimeDBArenaJsonValue* Value = FSpacetimeDBArenaJsonValue::Parse(Json, Arena);
+    if (Value && Value->IsScalar())
+    {
+        switch (Value->Type)
+        {
+        case ESpacetimeDBArenaJsonType::Null:
+            OutScalar.Type = ESpacetimeDBDecodedScalarType::Null;
+            break;
+
+        case ESpacetimeDBArenaJsonType::Bool:
+            OutScalar.Type = ESpacetimeDBDecodedScalarType::Bool;
+            OutScalar.BoolValue = Value->BoolValue;
+            break;
+
+        case ESpacetimeDBArenaJsonType::Number:
+            OutScalar.DoubleValue = Value->NumberValue;
+            if (Value->IsInteger())
+            {
+                OutScalar.Type = ESpacetimeDBDecodedScalarType::Integer;
+                OutScalar.IntValue = Value->GetInt64();
+                OutScalar.UIntValue = Value->GetUInt64();
+            }
+            else
+            {
+                OutScalar.Type = ESpacetimeDBDecodedScalarType::Double;
+            }
+            break;
+
+        case ESpacetimeDBArenaJsonType::String:
+            OutScalar.Type = ESpacetimeDBDecodedScalarType::String;
+            OutScalar.StringValue.AppendChars(Value->StringValue.GetData(), Value->StringValue.Len());
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    Arena.Reset();
+    return OutScalar.IsSet();
+}
+
+bool FSpacetimeDBPayloadDecoder::DecodeSpawn(const FString& DataJson, FSpacetimeDBDecodedPayload& OutPayload)
+{
+    OutPayload.Spawn = FSpacetimeDBSpawnSnapshot();
+    OutPayload.bHasSpawn = FSpacetimeDBSpawnDataReader::Peek(DataJson, OutPayload.Spawn);
+    return OutPayload.bHasSpawn;
+}
+
+bool FSpacetimeDBPayloadDecoder::ApplyScalar(const FSpacetimeDBDecodedScalar& Scalar, FProperty* Property, void* PropertyAddr)
+{
+    switch (Scalar.Type)
+    {
+    case ESpacetimeDBDecodedScalarType::Bool:
+        if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+        {
+            BoolProp->SetPropertyValue(PropertyAddr, Scalar.BoolValue);
+            return true;
+        }
+        break;
+
+    case ESpacetimeDBDecodedScalarType::Integer:
+    case ESpacetimeDBDecodedScalarType::Double:
+        if (FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
+        {
+            if (NumericProp->IsFloatingPoint())
+            {
+                NumericProp->SetFloatingPointPropertyValue(PropertyAddr, Scalar.DoubleValue);
+            }
+            else if (Scalar.Type == ESpacetimeDBDecodedScalarType::Double)
+            {
+                NumericProp->SetIntPropertyValue(PropertyAddr, static_cast<int64>(Scalar.DoubleValue));
+            }
+            else if (Property->IsA<FUInt64Property>())
+            {
+                NumericProp->SetIntPropertyValue(PropertyAddr, Scalar.UIntValue);
+            }
+            else
+            {
+                NumericProp->SetIntPropertyValue(PropertyAddr, Scalar.IntValue);
+            }
+            return true;
+        }
+        if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+        {
+            if (Scalar.Type == ESpacetimeDBDecodedScalarType::Integer)
+            {
+                EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(PropertyAddr, Scalar.IntValue);
+                return true;
+            }
+        }
+        break;
+
+    case ESpacetimeDBDecodedScalarType::String:
+        if (FStrProperty* StrProp = CastField<FStrProperty>(Property))
+        {
+            StrProp->SetPropertyValue(PropertyAddr, Scalar.StringValue);
+            return true;
+        }
+        if (FNameProperty* NameProp = CastField<FNameProperty>(Property))
+        {
+            NameProp->SetPropertyValue(PropertyAddr, FName(*Scalar.StringValue));
+            return true;
+        }
+        break;
+
+    default:
+        break;
+    }
+    return false;
+}
@@ -5,18 +5,10 @@
 #include "SpacetimeDBSubsystem.h"
 #include "Engine/World.h"
 #include "SpacetimeDBPropertyHelper.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
 #include "SpacetimeDB_PropertyValue.h"
-
-// Helper functions for vector operations 
-FORCEINLINE static float GetManhattanDistance(const FVector& A, const FVector& B)
-{
-	return FMath::Abs(A.X - B.X) + FMath::Abs(A.Y - B.Y) + FMath::Abs(A.Z - B.Z);
-}
-
-FORCEINLINE static float GetRotationError(const FQuat& A, const FQuat& B) 
-{
-	return FMath::RadiansToDegrees(FQuat::Error(A, B));
-}
+#include "SpacetimeDBPredictionManager.h"
+#include "SpacetimeDBStats.h"
 
 // Implementation of the One Euro Filter
 float USpacetimeDBPredictionComponent::FOneEuroFilter::Filter(float InValue, float InDeltaTime)
@@ -62,6 +54,9 @@ USpacetimeDBPredictionComponent::USpacetimeDBPredictionComponent()
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.TickGroup = TG_PrePhysics; // Process before physics to allow for prediction
 
+	// The history is a fixed ring buffer, so there is no per-frame cleanup to do
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
 	// Initialize default values
 	bHasAuthority = false;
 	CurrentSequence = 0;
@@ -82,6 +77,24 @@ void USpacetimeDBPredictionComponent::BeginPlay()
 		{
 			bHasAuthority = true;
 		}
+
+		// Resolve once instead of casting on every snapshot and server update
+		if (OwnerCharacter)
+		{
+			MovementComponent = OwnerCharacter->GetCharacterMovement();
+		}
+	}
+
+	// Allocate the history once; snapshots are written in place from now on
+	BuildTrackedPropertyLayout();
+
+	// Server updates for predicted actors are reconciled in one batch per frame
+	if (bHasAuthority)
+	{
+		if (USpacetimeDBPredictionManager* Manager = GetWorld()->GetSubsystem<USpacetimeDBPredictionManager>())
+		{
+			Manager->RegisterComponent(this);
+		}
 	}
 }
 
@@ -89,18 +102,18 @@ void USpacetimeDBPredictionComponent::TickComponent(float DeltaTime, ELevelTick
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	// Only perform prediction on locally controlled pawns
-	if (!bHasAuthority)
-	{
-		return;
-	}
-
-	// Clean up old history entries
-	CleanupHistory();
 }
 
 void USpacetimeDBPredictionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	if (UWorld* World = GetWorld())
+	{
+		if (USpacetimeDBPredictionManager* Manager = World->GetSubsystem<USpacetimeDBPredictionManager>())
+		{
+			Manager->UnregisterComponent(this);
+		}
+	}
+
 	// Clear history on end play
 	StateHistory.Empty();
 	
@@ -121,31 +134,37 @@ void USpacetimeDBPredictionComponent::TakeStateSnapshot()
 		return;
 	}
 
-	// Create a new snapshot
-	FStateSnapshot NewSnapshot;
-	NewSnapshot.Timestamp = Owner->GetWorld()->GetTimeSeconds();
-	NewSnapshot.Transform = Owner->GetActorTransform();
-	NewSnapshot.SequenceNumber = CurrentSequence++;
-
-	// Store velocity if this is a character
-	ACharacter* Character = Cast<ACharacter>(Owner);
-	if (Character)
+	if (StateHistory.Num() != MaxHistoryLength)
 	{
-		UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
-		if (MovementComp)
-		{
-			NewSnapshot.Velocity = MovementComp->Velocity;
-		}
+		ResetHistory();
 	}
 
-	// Copy the current input state
-	NewSnapshot.InputState = CurrentInputs;
+	// Overwrite the oldest slot in place
+	const int32 SequenceNumber = CurrentSequence++;
+	FStateSnapshot& NewSnapshot = StateHistory[SequenceNumber % MaxHistoryLength];
+	NewSnapshot.Timestamp = Owner->GetWorld()->GetTimeSeconds();
+	NewSnapshot.Transform = Owner->GetActorTransform();
+	NewSnapshot.Velocity = GetCurrentVelocity();
+	NewSnapshot.SequenceNumber = SequenceNumber;
+
+	// Copy the current input state; only reallocates when a new input was registered
+	NewSnapshot.InputState.Reset();
+	NewSnapshot.InputState.Append(CurrentInputs);
 
 	// Capture custom tracked properties
-	CaptureTrackedProperties(NewSnapshot.CustomState);
+	CaptureTrackedPropertyData(NewSnapshot);
+}
+
+const FStateSnapshot* USpacetimeDBPredictionComponent::FindSnapshot(int32 SequenceNumber) const
+{
+	if (SequenceNumber < 0 || StateHistory.Num() == 0)
+	{
+		return nullptr;
+	}
 
-	// Add to history
-	StateHistory.Add(NewSnapshot);
+	// A slot holds the requested sequence only until it is overwritten a lap later
+	const FStateSnapshot& Snapshot = StateHistory[SequenceNumber % StateHistory.Num()];
+	return Snapshot.SequenceNumber == SequenceNumber ? &Snapshot : nullptr;
 }
 
 void USpacetimeDBPredictionComponent::ApplyPredictedChanges()
@@ -157,6 +176,12 @@ void USpacetimeDBPredictionComponent::ApplyPredictedChanges()
 	// If you want to add game-specific prediction logic, add it here
 }
 
+FVector USpacetimeDBPredictionComponent::GetCurrentVelocity() const
+{
+	const UCharacterMovementComponent* MovementComp = MovementComponent.Get();
+	return MovementComp ? MovementComp->Velocity : FVector::ZeroVector;
+}
+
 void USpacetimeDBPredictionComponent::ProcessServerUpdate(const FTransform& ServerTransform, 
 	const FVector& ServerVelocity, int32 AckedSequence)
 {
@@ -166,93 +191,149 @@ void USpacetimeDBPredictionComponent::ProcessServerUpdate(const FTransform& Serv
 		return;
 	}
 
-	// Store the last acknowledged sequence
-	LastAcknowledgedSequence = AckedSequence;
+	AActor* Owner = GetOwner();
+	if (!Owner)
+	{
+		return;
+	}
+
+	// Check if the error exceeds thresholds
+	const FTransform& CurrentTransform = Owner->GetActorTransform();
+	float PositionError = USpacetimeDBPredictionManager::GetManhattanDistance(CurrentTransform.GetLocation(), ServerTransform.GetLocation());
+	float RotationError = USpacetimeDBPredictionManager::GetRotationError(CurrentTransform.GetRotation(), ServerTransform.GetRotation());
+	float VelocityError = USpacetimeDBPredictionManager::GetManhattanDistance(GetCurrentVelocity(), ServerVelocity);
 
-	// Find the snapshot that corresponds to this server update
-	int32 MatchingSnapshotIndex = -1;
-	for (int32 i = 0; i < StateHistory.Num(); ++i)
+	bool bNeedsCorrection = 
+		PositionError > PositionErrorThreshold ||
+		RotationError > RotationErrorThreshold ||
+		VelocityError > VelocityErrorThreshold;
+
+	ApplyServerReconciliation(ServerTransform, ServerVelocity, AckedSequence, bNeedsCorrection);
+}
+
+bool USpacetimeDBPredictionComponent::ApplyServerReconciliation(const FTransform& ServerTransform,
+	const FVector& ServerVelocity, int32 AckedSequence, bool bExceedsThreshold)
+{
+	if (!bHasAuthority)
 	{
-		if (StateHistory[i].SequenceNumber == AckedSequence)
-		{
-			MatchingSnapshotIndex = i;
-			break;
-		}
+		return false;
 	}
 
+	// Store the last acknowledged sequence
+	LastAcknowledgedSequence = AckedSequence;
+
 	// If we didn't find a matching snapshot, we can't reconcile
-	if (MatchingSnapshotIndex == -1)
+	if (!FindSnapshot(AckedSequence))
 	{
 		// If we got a server update for a sequence we don't have, just apply it directly
 		ApplySmoothCorrection(ServerTransform, ServerVelocity, 0.0f); // No smoothing, direct update
-		return;
+		return true;
 	}
 
-	AActor* Owner = GetOwner();
-	if (!Owner)
+	if (!bExceedsThreshold)
 	{
-		return;
+		return false;
 	}
 
-	// Get the current client state
-	FTransform CurrentTransform = Owner->GetActorTransform();
-	FVector CurrentVelocity = FVector::ZeroVector;
+	// Apply smooth correction
+	ApplySmoothCorrection(ServerTransform, ServerVelocity, SmoothingFactor);
 
-	// Get velocity if this is a character
-	ACharacter* Character = Cast<ACharacter>(Owner);
-	if (Character)
+	// Re-apply inputs since the matching snapshot
+	// For now, we'll just rely on Unreal's movement prediction to correct itself
+	// Acknowledged slots are simply overwritten as the sequence wraps around
+	return true;
+}
+
+void USpacetimeDBPredictionComponent::AddTrackedProperty(FName PropertyName)
+{
+	if (!TrackedProperties.Contains(PropertyName))
 	{
-		UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
-		if (MovementComp)
+		TrackedProperties.Add(PropertyName);
+
+		// Snapshots taken with the old layout can't be read with the new one
+		if (HasBegunPlay())
 		{
-			CurrentVelocity = MovementComp->Velocity;
+			BuildTrackedPropertyLayout();
 		}
 	}
+}
 
-	// Check if the error exceeds thresholds
-	float PositionError = GetManhattanDistance(CurrentTransform.GetLocation(), ServerTransform.GetLocation());
-	float RotationError = GetRotationError(CurrentTransform.GetRotation(), ServerTransform.GetRotation());
-	float VelocityError = GetManhattanDistance(CurrentVelocity, ServerVelocity);
-
-	bool bNeedsCorrection = 
-		PositionError > PositionErrorThreshold ||
-		RotationError > RotationErrorThreshold ||
-		VelocityError > VelocityErrorThreshold;
-
-	if (bNeedsCorrection)
+void USpacetimeDBPredictionComponent::RegisterInputValue(FName InputName, float Value)
+{
+	// Inputs are few, so a linear scan beats hashing
+	const int32 InputIndex = InputNames.Find(InputName);
+	if (InputIndex != INDEX_NONE)
 	{
-		// Apply smooth correction
-		ApplySmoothCorrection(ServerTransform, ServerVelocity, SmoothingFactor);
-		
-		// Re-apply inputs since the matching snapshot
-		// For now, we'll just rely on Unreal's movement prediction to correct itself
+		CurrentInputs[InputIndex] = Value;
+		return;
 	}
 
-	// Clean up history entries older than the acknowledged sequence
-	for (int32 i = StateHistory.Num() - 1; i >= 0; i--)
+	InputNames.Add(InputName);
+	CurrentInputs.Add(Value);
+}
+
+void USpacetimeDBPredictionComponent::BuildTrackedPropertyLayout()
+{
+	TrackedPropertyLayout.Reset();
+	TrackedPropertyDataSize = 0;
+
+	AActor* Owner = GetOwner();
+	if (Owner)
 	{
-		if (StateHistory[i].SequenceNumber <= AckedSequence)
+		for (const FName& PropName : TrackedProperties)
 		{
-			StateHistory.RemoveAt(0, i + 1);
-			break;
+			const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Owner->GetClass(), PropName);
+			if (!Descriptor)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBPredictionComponent: Tracked property '%s' not found on '%s'"), *PropName.ToString(), *Owner->GetName());
+				continue;
+			}
+
+			// Raw copies are only safe for values without constructors or owned memory
+			const FProperty* Property = Descriptor->Property;
+			if (!Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBPredictionComponent: Tracked property '%s' is not plain data and can't be snapshotted"), *PropName.ToString());
+				continue;
+			}
+
+			FTrackedPropertySlot& Slot = TrackedPropertyLayout.AddDefaulted_GetRef();
+			Slot.Property = Property;
+			Slot.Offset = Align(TrackedPropertyDataSize, Property->GetMinAlignment());
+			TrackedPropertyDataSize = Slot.Offset + Property->GetSize();
 		}
 	}
+
+	ResetHistory();
 }
 
-void USpacetimeDBPredictionComponent::AddTrackedProperty(FName PropertyName)
+void USpacetimeDBPredictionComponent::ResetHistory()
 {
-	if (!TrackedProperties.Contains(PropertyName))
+	StateHistory.Reset();
+	StateHistory.SetNum(MaxHistoryLength);
+	for (FStateSnapshot& Snapshot : StateHistory)
 	{
-		TrackedProperties.Add(PropertyName);
+		Snapshot.CustomState.SetNumZeroed(TrackedPropertyDataSize);
+		Snapshot.InputState.Reserve(InputNames.Num());
 	}
 }
 
-void USpacetimeDBPredictionComponent::RegisterInputValue(FName InputName, float Value)
+void USpacetimeDBPredictionComponent::CaptureTrackedPropertyData(FStateSnapshot& Snapshot) const
 {
-	CurrentInputs.Add(InputName, Value);
+	const AActor* Owner = GetOwner();
+	if (!Owner || Snapshot.CustomState.Num() != TrackedPropertyDataSize)
+	{
+		return;
+	}
+
+	uint8* Data = Snapshot.CustomState.GetData();
+	for (const FTrackedPropertySlot& Slot : TrackedPropertyLayout)
+	{
+		FMemory::Memcpy(Data + Slot.Offset, Slot.Property->ContainerPtrToValuePtr<void>(Owner), Slot.Property->GetSize());
+	}
 }
 
-void USpacetimeDBPredictionComponent::CaptureTrackedProperties(TMap<FName, FSpacetimeDBPropertyValue>& OutProperties)
+void USpacetimeDBPredictionComponent::CaptureTrackedProperties(TMap<FName, FSpacetimeDBCompactPropertyValue>& OutProperties)
 {
 	AActor* Owner = GetOwner();
 	if (!Owner)
@@ -266,9 +347,9 @@ void USpacetimeDBPredictionComponent::CaptureTrackedProperties(TMap<FName, FSpac
 		// Use FSpacetimeDBPropertyHelper (F instead of U)
 		FString PropertyValueJson = FSpacetimeDBPropertyHelper::GetPropertyValueByName(Owner, PropName.ToString());
 		
-		// Attempt to deserialize the JSON string into FSpacetimeDBPropertyValue
+		// Attempt to deserialize the JSON string into a property value
 		// This is a simplified approach; robust error handling and type checking would be needed here.
-		FSpacetimeDBPropertyValue PropValue;
+		FSpacetimeDBCompactPropertyValue PropValue;
 		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertyValueJson);
 		TSharedPtr<FJsonValue> JsonValue;
 
@@ -278,7 +359,7 @@ void USpacetimeDBPredictionComponent::CaptureTrackedProperties(TMap<FName, FSpac
 		{
             if (JsonValue->Type == EJson::String)
             {
-                PropValue.SetString(JsonValue->AsString());
+                PropValue.SetString(ESpacetimeDBPropertyType::String, JsonValue->AsString());
             }
             else if (JsonValue->Type == EJson::Number)
             {
@@ -291,13 +372,13 @@ void USpacetimeDBPredictionComponent::CaptureTrackedProperties(TMap<FName, FSpac
                 PropValue.SetBool(JsonValue->AsBool());
             }
             // Add more types as needed (Array, Object, Null)
-            // For complex types, FSpacetimeDBPropertyValue would need dedicated parsing logic
+            // For complex types, the property value would need dedicated parsing logic
 		}
-		OutProperties.Add(PropName, PropValue);
+		OutProperties.Add(PropName, MoveTemp(PropValue));
 	}
 }
 
-void USpacetimeDBPredictionComponent::ApplyTrackedProperties(const TMap<FName, FSpacetimeDBPropertyValue>& Properties)
+void USpacetimeDBPredictionComponent::ApplyTrackedProperties(const TMap<FName, FSpacetimeDBCompactPropertyValue>& Properties)
 {
 	AActor* Owner = GetOwner();
 	if (!Owner)
@@ -308,38 +389,38 @@ void USpacetimeDBPredictionComponent::ApplyTrackedProperties(const TMap<FName, F
 	for (const auto& Pair : Properties)
 	{
 		const FName& PropName = Pair.Key;
-		const FSpacetimeDBPropertyValue& Value = Pair.Value;
+		const FSpacetimeDBCompactPropertyValue& Value = Pair.Value;
 
-		// Convert FSpacetimeDBPropertyValue to a JSON string to use with SetPropertyValueByName
-		// This is a placeholder. A robust solution would serialize FSpacetimeDBPropertyValue correctly.
+		// Convert the property value to a JSON string to use with SetPropertyValueByName
+		// This is a placeholder. A robust solution would serialize the property value correctly.
 		FString ValueJsonString;
-        // TODO: Implement proper serialization of FSpacetimeDBPropertyValue to JSON string
+        // TODO: Implement proper serialization of property values to JSON strings
         // For now, let's try to handle a few common types.
         // This is a simplified conversion and might not cover all cases or complex types.
-        if (Value.Type == ESpacetimeDBPropertyType::String)
+        if (Value.GetType() == ESpacetimeDBPropertyType::String)
         {
             // Properly escape the string for JSON
-            TSharedPtr<FJsonValueString> JsonStringValue = MakeShareable(new FJsonValueString(Value.AsString()));
+            TSharedPtr<FJsonValueString> JsonStringValue = MakeShareable(new FJsonValueString(Value.GetString()));
             FJsonSerializer::Serialize(JsonStringValue.ToSharedRef(), TEXT(""), TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ValueJsonString), false);
         }
-        else if (Value.Type == ESpacetimeDBPropertyType::Int32)
+        else if (Value.GetType() == ESpacetimeDBPropertyType::Int32)
         {
-            ValueJsonString = FString::Printf(TEXT("%d"), Value.AsInt32());
+            ValueJsonString = FString::Printf(TEXT("%d"), Value.GetInt32());
         }
-        else if (Value.Type == ESpacetimeDBPropertyType::Int64)
+        else if (Value.GetType() == ESpacetimeDBPropertyType::Int64)
         {
-            ValueJsonString = FString::Printf(TEXT("%lld"), Value.AsInt64());
+            ValueJsonString = FString::Printf(TEXT("%lld"), Value.GetInt64());
         }
-        else if (Value.Type == ESpacetimeDBPropertyType::Float)
+        else if (Value.GetType() == ESpacetimeDBPropertyType::Float)
         {
             // Ensure proper float to string conversion for JSON
-            ValueJsonString = FString::Printf(TEXT("%f"), Value.AsFloat());
+            ValueJsonString = FString::Printf(TEXT("%f"), Value.GetFloat());
         }
-        else if (Value.Type == ESpacetimeDBPropertyType::Bool)
+        else if (Value.GetType() == ESpacetimeDBPropertyType::Bool)
         {
-            ValueJsonString = Value.AsBool() ? TEXT("true") : TEXT("false");
+            ValueJsonString = Value.GetBool() ? TEXT("true") : TEXT("false");
         }
-        else if (Value.Type == ESpacetimeDBPropertyType::None)
+        else if (Value.GetType() == ESpacetimeDBPropertyType::None)
         {
             ValueJsonString = TEXT("null");
         }
@@ -347,7 +428,7 @@ void USpacetimeDBPredictionComponent::ApplyTrackedProperties(const TMap<FName, F
         {
             // For USTRUCTs, UOBJECTs, Arrays, Maps, a more complex serialization is needed.
             // This might involve recursively calling a serialization function or using Unreal's built-in JSON utilities
-            // if FSpacetimeDBPropertyValue holds complex data.
+            // if the property value holds complex data.
             UE_LOG(LogTemp, Warning, TEXT("ApplyTrackedProperties: Property '%s' has a complex or unsupported type for simple JSON conversion. Value not applied."), *PropName.ToString());
             continue; // Skip this property if we can't easily convert it
         }
@@ -361,16 +442,6 @@ void USpacetimeDBPredictionComponent::ApplyTrackedProperties(const TMap<FName, F
 	}
 }
 
-void USpacetimeDBPredictionComponent::CleanupHistory()
-{
-	// Remove history entries beyond the maximum length
-	if (StateHistory.Num() > MaxHistoryLength)
-	{
-		int32 NumToRemove = StateHistory.Num() - MaxHistoryLength;
-		StateHistory.RemoveAt(0, NumToRemove);
-	}
-}
-
 void USpacetimeDBPredictionComponent::ApplySmoothCorrection(const FTransform& TargetTransform, 
 	const FVector& TargetVelocity, float BlendFactor)
 {
@@ -380,20 +451,18 @@ void USpacetimeDBPredictionComponent::ApplySmoothCorrection(const FTransform& Ta
 		return;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_PredictionCorrection);
+	INC_DWORD_STAT(STAT_SpacetimeDB_PredictionCorrections);
+
 	// Apply immediate correction if blend factor is 0
 	if (BlendFactor <= 0.0f)
 	{
 		Owner->SetActorTransform(TargetTransform);
 		
 		// Set velocity if this is a character
-		ACharacter* Character = Cast<ACharacter>(Owner);
-		if (Character)
+		if (UCharacterMovementComponent* MovementComp = MovementComponent.Get())
 		{
-			UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
-			if (MovementComp)
-			{
-				MovementComp->Velocity = TargetVelocity;
-			}
+			MovementComp->Velocity = TargetVelocity;
 		}
 		return;
 	}
@@ -436,30 +505,33 @@ void USpacetimeDBPredictionComponent::ApplySmoothCorrection(const FTransform& Ta
 	Owner->SetActorTransform(NewTransform);
 	
 	// Apply velocity change for characters
-	ACharacter* Character = Cast<ACharacter>(Owner);
-	if (Character)
+	if (UCharacterMovementComponent* MovementComp = MovementComponent.Get())
 	{
-		UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
-		if (MovementComp)
-		{
-			FVector CurrentVelocity = MovementComp->Velocity;
-			FVector NewVelocity = FMath::Lerp(TargetVelocity, CurrentVelocity, BlendFactor);
-			MovementComp->Velocity = NewVelocity;
-		}
+		FVector CurrentVelocity = MovementComp->Velocity;
+		FVector NewVelocity = FMath::Lerp(TargetVelocity, CurrentVelocity, BlendFactor);
+		MovementComp->Velocity = NewVelocity;
 	}
 }
 
 void USpacetimeDBPredictionComponent::GetTrackedProperties(TMap<FName, FSpacetimeDBPropertyValue>& OutProperties)
 {
-    // Capture all tracked properties
-    CaptureTrackedProperties(OutProperties);
+    // Capture all tracked properties, converting to the reflected struct for Blueprint
+    TMap<FName, FSpacetimeDBCompactPropertyValue> Captured;
+    CaptureTrackedProperties(Captured);
+    
+    OutProperties.Reset();
+    OutProperties.Reserve(Captured.Num());
+    for (const TPair<FName, FSpacetimeDBCompactPropertyValue>& Pair : Captured)
+    {
+        OutProperties.Add(Pair.Key, Pair.Value.ToPropertyValue());
+    }
 }
 
 void USpacetimeDBPredictionComponent::ApplyServerUpdate(const FString& PropertyName, const FSpacetimeDBPropertyValue& Value)
 {
     // Create a temporary map with just this property
-    TMap<FName, FSpacetimeDBPropertyValue> PropertyMap;
-    PropertyMap.Add(FName(*PropertyName), Value);
+    TMap<FName, FSpacetimeDBCompactPropertyValue> PropertyMap;
+    PropertyMap.Add(FName(*PropertyName), FSpacetimeDBCompactPropertyValue(Value));
     
     // Apply the property to our owner
     ApplyTrackedProperties(PropertyMap);
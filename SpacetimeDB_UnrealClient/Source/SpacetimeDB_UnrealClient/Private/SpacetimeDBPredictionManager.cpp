@@ -0,0 +1,218 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBPredictionManager.h"
+#include "SpacetimeDBPredictionComponent.h"
+#include "GameFramework/Actor.h"
+#include "Async/ParallelFor.h"
+
+/** Below this many updates the error pass runs inline; task dispatch would cost more than it saves */
+static constexpr int32 MinParallelReconcileBatch = 64;
+
+void USpacetimeDBPredictionManager::Deinitialize()
+{
+	Components.Reset();
+	ComponentKeys.Reset();
+	ComponentIndex.Reset();
+	PendingAckedSequences.Reset();
+	PendingServerTransforms.Reset();
+	PendingServerVelocities.Reset();
+	DeferredUnregisters.Reset();
+
+	Super::Deinitialize();
+}
+
+void USpacetimeDBPredictionManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ReconcilePendingUpdates();
+}
+
+TStatId USpacetimeDBPredictionManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpacetimeDBPredictionManager, STATGROUP_Tickables);
+}
+
+void USpacetimeDBPredictionManager::RegisterComponent(USpacetimeDBPredictionComponent* Component)
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	if (const int32* Index = ComponentIndex.Find(Component))
+	{
+		// Registered again after a removal that is still deferred; keep the slot
+		if (DeferredUnregisters.RemoveSingleSwap(Component, EAllowShrinking::No) > 0)
+		{
+			Components[*Index] = Component;
+		}
+		return;
+	}
+
+	ComponentIndex.Add(Component, Components.Num());
+	Components.Add(Component);
+	ComponentKeys.Add(Component);
+	PendingAckedSequences.Add(INDEX_NONE);
+	PendingServerTransforms.AddDefaulted();
+	PendingServerVelocities.AddZeroed();
+}
+
+void USpacetimeDBPredictionManager::UnregisterComponent(USpacetimeDBPredictionComponent* Component)
+{
+	if (bReconciling)
+	{
+		// Swapping now would move components under the batch being applied; clear the slot so
+		// the pass skips it and remove it afterwards
+		if (const int32* Index = ComponentIndex.Find(Component))
+		{
+			Components[*Index].Reset();
+			DeferredUnregisters.AddUnique(ComponentKeys[*Index]);
+		}
+		return;
+	}
+
+	RemoveComponent(Component);
+}
+
+void USpacetimeDBPredictionManager::RemoveComponent(TObjectKey<USpacetimeDBPredictionComponent> Key)
+{
+	int32 Index = INDEX_NONE;
+	if (!ComponentIndex.RemoveAndCopyValue(Key, Index))
+	{
+		return;
+	}
+
+	// Swap the last component into the hole so the arrays stay dense
+	const int32 LastIndex = Components.Num() - 1;
+	if (Index != LastIndex)
+	{
+		ComponentIndex.Add(ComponentKeys[LastIndex], Index);
+	}
+
+	Components.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ComponentKeys.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PendingAckedSequences.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PendingServerTransforms.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PendingServerVelocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+bool USpacetimeDBPredictionManager::QueueServerUpdate(USpacetimeDBPredictionComponent* Component, const FTransform& ServerTransform,
+	const FVector& ServerVelocity, int32 AckedSequence)
+{
+	const int32* Index = ComponentIndex.Find(Component);
+	if (!Index)
+	{
+		return false;
+	}
+
+	// Only the newest ack matters; an older one arriving late is already superseded
+	int32& PendingSequence = PendingAckedSequences[*Index];
+	if (PendingSequence == INDEX_NONE || AckedSequence >= PendingSequence)
+	{
+		PendingSequence = AckedSequence;
+		PendingServerTransforms[*Index] = ServerTransform;
+		PendingServerVelocities[*Index] = ServerVelocity;
+	}
+	return true;
+}
+
+void USpacetimeDBPredictionManager::ReconcilePendingUpdates()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Stats = FSpacetimeDBPredictionStats();
+	Stats.NumPredictedActors = Components.Num();
+
+	BatchComponents.Reset();
+	BatchClientLocations.Reset();
+	BatchClientRotations.Reset();
+	BatchClientVelocities.Reset();
+	BatchThresholds.Reset();
+
+	// Gather: one pass over the components with a queued update, copying what the error checks need
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		if (PendingAckedSequences[Index] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		USpacetimeDBPredictionComponent* Component = Components[Index].Get();
+		const AActor* Owner = Component ? Component->GetOwner() : nullptr;
+		if (!Owner)
+		{
+			PendingAckedSequences[Index] = INDEX_NONE;
+			continue;
+		}
+
+		const FTransform& ClientTransform = Owner->GetActorTransform();
+		BatchComponents.Add(Index);
+		BatchClientLocations.Add(ClientTransform.GetLocation());
+		BatchClientRotations.Add(ClientTransform.GetRotation());
+		BatchClientVelocities.Add(Component->GetCurrentVelocity());
+		BatchThresholds.Add(FVector3f(Component->PositionErrorThreshold, Component->RotationErrorThreshold, Component->VelocityErrorThreshold));
+	}
+
+	const int32 NumUpdates = BatchComponents.Num();
+	if (NumUpdates == 0)
+	{
+		return;
+	}
+
+	BatchPositionErrors.SetNumUninitialized(NumUpdates, EAllowShrinking::No);
+	BatchNeedsCorrection.SetNumUninitialized(NumUpdates, EAllowShrinking::No);
+
+	// Check: pure math over the gathered arrays, safe off the game thread
+	ParallelFor(NumUpdates, [this](int32 BatchIndex)
+	{
+		const int32 Index = BatchComponents[BatchIndex];
+		const FTransform& ServerTransform = PendingServerTransforms[Index];
+		const FVector3f& Thresholds = BatchThresholds[BatchIndex];
+
+		const float PositionError = GetManhattanDistance(BatchClientLocations[BatchIndex], ServerTransform.GetLocation());
+		const float RotationError = GetRotationError(BatchClientRotations[BatchIndex], ServerTransform.GetRotation());
+		const float VelocityError = GetManhattanDistance(BatchClientVelocities[BatchIndex], PendingServerVelocities[Index]);
+
+		BatchPositionErrors[BatchIndex] = PositionError;
+		BatchNeedsCorrection[BatchIndex] =
+			PositionError > Thresholds.X ||
+			RotationError > Thresholds.Y ||
+			VelocityError > Thresholds.Z;
+	}, NumUpdates < MinParallelReconcileBatch ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	// Apply: corrections move actors, so they happen back on the game thread
+	bReconciling = true;
+	float TotalPositionError = 0.0f;
+	for (int32 BatchIndex = 0; BatchIndex < NumUpdates; ++BatchIndex)
+	{
+		const int32 Index = BatchComponents[BatchIndex];
+		const int32 AckedSequence = PendingAckedSequences[Index];
+		PendingAckedSequences[Index] = INDEX_NONE;
+
+		TotalPositionError += BatchPositionErrors[BatchIndex];
+		Stats.MaxPositionError = FMath::Max(Stats.MaxPositionError, BatchPositionErrors[BatchIndex]);
+
+		if (USpacetimeDBPredictionComponent* Component = Components[Index].Get())
+		{
+			// Copied, since a component registering during the correction can grow the arrays
+			const FTransform ServerTransform = PendingServerTransforms[Index];
+			const FVector ServerVelocity = PendingServerVelocities[Index];
+			if (Component->ApplyServerReconciliation(ServerTransform, ServerVelocity, AckedSequence, BatchNeedsCorrection[BatchIndex] != 0))
+			{
+				++Stats.NumCorrections;
+			}
+		}
+	}
+	bReconciling = false;
+
+	for (const TObjectKey<USpacetimeDBPredictionComponent>& Key : DeferredUnregisters)
+	{
+		RemoveComponent(Key);
+	}
+	DeferredUnregisters.Reset();
+
+	Stats.NumServerUpdates = NumUpdates;
+	Stats.AveragePositionError = TotalPositionError / NumUpdates;
+	Stats.ReconcileTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
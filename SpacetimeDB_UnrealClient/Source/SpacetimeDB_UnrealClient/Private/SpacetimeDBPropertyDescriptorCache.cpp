@@ -0,0 +1,168 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBPropertyDescriptorCache.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UObjectGlobals.h"
+#include "Modules/ModuleManager.h"
+#include <atomic>
+
+namespace
+{
+    /** Guards GClassDescriptors; lookups take the read lock, building a class takes the write lock */
+    FRWLock GDescriptorLock;
+
+    /** Descriptors keyed by class; each entry also holds a weak pointer so a recycled class address is detected */
+    TMap<const UClass*, TUniquePtr<FSpacetimeDBClassDescriptor>> GClassDescriptors;
+
+    /** See GetGeneration */
+    std::atomic<uint32> GGeneration{0};
+
+    FDelegateHandle GReloadCompleteHandle;
+    FDelegateHandle GModulesChangedHandle;
+#if WITH_EDITOR
+    FDelegateHandle GObjectsReinstancedHandle;
+#endif
+}
+
+void FSpacetimeDBPropertyDescriptorCache::Startup()
+{
+    // Hot reload and Live Coding both report through ReloadCompleteDelegate
+    GReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+    {
+        Invalidate();
+    });
+
+    // A newly loaded game module may bring generated accessors for classes we already described
+    GModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([](FName, EModuleChangeReason Reason)
+    {
+        if (Reason == EModuleChangeReason::ModuleLoaded)
+        {
+            Invalidate();
+        }
+    });
+
+#if WITH_EDITOR
+    // Blueprint recompiles reinstance the class, which can change property layout
+    GObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const TMap<UObject*, UObject*>&)
+    {
+        Invalidate();
+    });
+#endif
+}
+
+void FSpacetimeDBPropertyDescriptorCache::Shutdown()
+{
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(GReloadCompleteHandle);
+    GReloadCompleteHandle.Reset();
+    FModuleManager::Get().OnModulesChanged().Remove(GModulesChangedHandle);
+    GModulesChangedHandle.Reset();
+
+#if WITH_EDITOR
+    FCoreUObjectDelegates::OnObjectsReinstanced.Remove(GObjectsReinstancedHandle);
+    GObjectsReinstancedHandle.Reset();
+#endif
+
+    Invalidate();
+}
+
+const FSpacetimeDBClassDescriptor* FSpacetimeDBPropertyDescriptorCache::GetClassDescriptor(UClass* Class)
+{
+    if (!Class)
+    {
+        return nullptr;
+    }
+
+    {
+        FReadScopeLock ReadLock(GDescriptorLock);
+        if (const TUniquePtr<FSpacetimeDBClassDescriptor>* Found = GClassDescriptors.Find(Class))
+        {
+            if ((*Found)->Class.Get() == Class)
+            {
+                return Found->Get();
+            }
+        }
+    }
+
+    FWriteScopeLock WriteLock(GDescriptorLock);
+
+    // Another thread may have built it while we waited for the write lock
+    TUniquePtr<FSpacetimeDBClassDescriptor>& Slot = GClassDescriptors.FindOrAdd(Class);
+    if (!Slot.IsValid() || Slot->Class.Get() != Class)
+    {
+        Slot = BuildClassDescriptor(Class);
+    }
+    return Slot.Get();
+}
+
+const FSpacetimeDBPropertyDescriptor* FSpacetimeDBPropertyDescriptorCache::FindProperty(UClass* Class, FName PropertyName)
+{
+    if (PropertyName.IsNone())
+    {
+        return nullptr;
+    }
+
+    const FSpacetimeDBClassDescriptor* ClassDescriptor = GetClassDescriptor(Class);
+    return ClassDescriptor ? ClassDescriptor->Find(PropertyName) : nullptr;
+}
+
+void FSpacetimeDBPropertyDescriptorCache::Invalidate()
+{
+    FWriteScopeLock WriteLock(GDescriptorLock);
+    if (GClassDescriptors.Num() > 0)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBPropertyDescriptorCache: Invalidating %d class descriptors"), GClassDescriptors.Num());
+    }
+    GClassDescriptors.Empty();
+    ++GGeneration;
+}
+
+uint32 FSpacetimeDBPropertyDescriptorCache::GetGeneration()
+{
+    return GGeneration.load();
+}
+
+TUniquePtr<FSpacetimeDBClassDescriptor> FSpacetimeDBPropertyDescriptorCache::BuildClassDescriptor(UClass* Class)
+{
+    TUniquePtr<FSpacetimeDBClassDescriptor> Descriptor = MakeUnique<FSpacetimeDBClassDescriptor>();
+    Descriptor->Class = Class;
+
+    for (TFieldIterator<FProperty> It(Class, EFieldIteratorFlags::IncludeSuper); It; ++It)
+    {
+        FProperty* Property = *It;
+        const FName PropertyName = Property->GetFName();
+        if (Descriptor->NameToIndex.Contains(PropertyName))
+        {
+            continue;
+        }
+
+        FSpacetimeDBPropertyDescriptor& PropertyDescriptor = Descriptor->Properties.AddDefaulted_GetRef();
+        PropertyDescriptor.Property = Property;
+        PropertyDescriptor.Name = PropertyName;
+        PropertyDescriptor.Offset = Property->GetOffset_ForInternal();
+        PropertyDescriptor.Index = Descriptor->Properties.Num() - 1;
+        PropertyDescriptor.TypeTag = FSpacetimeDBBinaryCodec::GetPropertyTypeTag(Property);
+        PropertyDescriptor.JsonDecode = FSpacetimeDBPropertyHelper::GetJsonDecoder(Property);
+        PropertyDescriptor.JsonEncode = FSpacetimeDBPropertyHelper::GetJsonEncoder(Property);
+
+        if (const FSpacetimeDBGeneratedPropertyAccessor* Accessor = FSpacetimeDBGeneratedAccessors::FindAccessor(Property))
+        {
+            PropertyDescriptor.BinaryEncode = Accessor->Encode;
+            PropertyDescriptor.BinaryDecode = Accessor->Decode;
+            ++Descriptor->NumGeneratedAccessors;
+        }
+
+        if (Property->HasAnyPropertyFlags(CPF_RepNotify) && Property->RepNotifyFunc != NAME_None)
+        {
+            PropertyDescriptor.RepNotifyFunc = Class->FindFunctionByName(Property->RepNotifyFunc);
+            PropertyDescriptor.RepNotifyParam = FSpacetimeDBPropertyHelper::FindRepNotifyParam(PropertyDescriptor.RepNotifyFunc);
+        }
+
+        Descriptor->NameToIndex.Add(PropertyName, PropertyDescriptor.Index);
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBPropertyDescriptorCache: Built %d property descriptors for class %s (%d generated)"),
+        Descriptor->Properties.Num(), *Class->GetName(), Descriptor->NumGeneratedAccessors);
+
+    return Descriptor;
+}
@@ -1,4 +1,7 @@
 #include "SpacetimeDBPropertyHelper.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
+#include "SpacetimeDBFrameArena.h"
+#include "SpacetimeDBStats.h"
 #include "Engine/Engine.h"
 #include "JsonObjectConverter.h"
 #include "UObject/UnrealType.h"
@@ -12,14 +15,20 @@ bool FSpacetimeDBPropertyHelper::ApplyJsonToProperty(UObject* Object, const FStr
         return false;
     }
 
-    FProperty* Property = Object->GetClass()->FindPropertyByName(FName(*PropertyName));
-    if (!Property)
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName);
+    if (!Descriptor)
     {
         UE_LOG(LogTemp, Error, TEXT("SpacetimeDB: Property not found: %s on object %s"), 
             *PropertyName, *Object->GetName());
         return false;
     }
 
+    if (!Descriptor->JsonDecode)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDB: Unsupported property type for %s"), *PropertyName);
+        return false;
+    }
+
     // Parse the JSON value
     TSharedPtr<FJsonValue> JsonValue;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ValueJson);
@@ -30,101 +39,350 @@ bool FSpacetimeDBPropertyHelper::ApplyJsonToProperty(UObject* Object, const FStr
         return false;
     }
 
-    // Get the address of the property in the object
-    void* PropertyAddress = Property->ContainerPtrToValuePtr<void>(Object);
-    bool bSuccess = false;
+    // Decode straight into the property using the cached decoder
+    void* PropertyAddress = Descriptor->GetValuePtr(Object);
+    bool bSuccess = Descriptor->JsonDecode(Descriptor->Property, PropertyAddress, JsonValue);
 
-    // Handle different property types
-    if (FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
+    // Fire RepNotify if available
+    if (bSuccess)
     {
-        bSuccess = DeserializeAndApplyNumericProperty(NumericProp, PropertyAddress, JsonValue);
+        InvokeRepNotify(Object, *Descriptor);
     }
-    else if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+
+    return bSuccess;
+}
+
+namespace
+{
+    /**
+     * Writes a scalar JSON value straight into a property.
+     * Mirrors the corresponding DeserializeAndApply* decoders.
+     *
+     * @return False if this property/value pair has no fast path
+     */
+    bool TryApplyArenaScalar(FProperty* Property, void* PropertyAddr, const FSpacetimeDBArenaJsonValue& Value)
+    {
+        switch (Value.Type)
+        {
+        case ESpacetimeDBArenaJsonType::Bool:
+            if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+            {
+                BoolProp->SetPropertyValue(PropertyAddr, Value.BoolValue);
+                return true;
+            }
+            break;
+
+        case ESpacetimeDBArenaJsonType::Number:
+            if (FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
+            {
+                if (NumericProp->IsFloatingPoint())
+                {
+                    NumericProp->SetFloatingPointPropertyValue(PropertyAddr, Value.NumberValue);
+                }
+                else if (!Value.IsInteger())
+                {
+                    NumericProp->SetIntPropertyValue(PropertyAddr, static_cast<int64>(Value.NumberValue));
+                }
+                else if (Property->IsA<FUInt64Property>())
+                {
+                    NumericProp->SetIntPropertyValue(PropertyAddr, Value.GetUInt64());
+                }
+                else
+                {
+                    NumericProp->SetIntPropertyValue(PropertyAddr, Value.GetInt64());
+                }
+                return true;
+            }
+            if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+            {
+                EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(PropertyAddr, Value.GetInt64());
+                return true;
+            }
+            break;
+
+        case ESpacetimeDBArenaJsonType::String:
+            if (FStrProperty* StrProp = CastField<FStrProperty>(Property))
+            {
+                FString& Target = *StrProp->GetPropertyValuePtr(PropertyAddr);
+                Target.Reset();
+                Target.AppendChars(Value.StringValue.GetData(), Value.StringValue.Len());
+                return true;
+            }
+            if (FNameProperty* NameProp = CastField<FNameProperty>(Property))
+            {
+                NameProp->SetPropertyValue(PropertyAddr, FName(Value.StringValue.Len(), Value.StringValue.GetData()));
+                return true;
+            }
+            break;
+
+        default:
+            break;
+        }
+        return false;
+    }
+}
+
+bool FSpacetimeDBPropertyHelper::ApplyJsonToProperty(UObject* Object, const FString& PropertyName, const FString& ValueJson, FSpacetimeDBFrameArena& Arena)
+{
+    if (!Object)
     {
-        bSuccess = DeserializeAndApplyBoolProperty(BoolProp, PropertyAddress, JsonValue);
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDB: Cannot apply property update to null object. Property: %s"), *PropertyName);
+        return false;
+    }
+
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName);
+    if (!Descriptor)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDB: Property not found: %s on object %s"), 
+            *PropertyName, *Object->GetName());
+        return false;
+    }
+
+    void* PropertyAddress = Descriptor->GetValuePtr(Object);
+    if (!DecodeJsonToProperty(*Descriptor, PropertyAddress, ValueJson, Arena))
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDB: Failed to apply JSON for property %s: %s"), 
+            *PropertyName, *ValueJson);
+        return false;
     }
-    else if (FStrProperty* StrProp = CastField<FStrProperty>(Property))
+
+    InvokeRepNotify(Object, *Descriptor);
+    return true;
+}
+
+bool FSpacetimeDBPropertyHelper::DecodeJsonToProperty(const FSpacetimeDBPropertyDescriptor& Descriptor, void* PropertyAddr, const FString& Json, FSpacetimeDBFrameArena& Arena)
+{
+    const FSpacetimeDBArenaJsonValue* Value = FSpacetimeDBArenaJsonValue::Parse(Json, Arena);
+    if (!Value)
     {
-        bSuccess = DeserializeAndApplyStrProperty(StrProp, PropertyAddress, JsonValue);
+        return false;
     }
-    else if (FTextProperty* TextProp = CastField<FTextProperty>(Property))
+
+    if (Value->IsScalar() && TryApplyArenaScalar(Descriptor.Property, PropertyAddr, *Value))
     {
-        bSuccess = DeserializeAndApplyTextProperty(TextProp, PropertyAddress, JsonValue);
+        return true;
     }
-    else if (FNameProperty* NameProp = CastField<FNameProperty>(Property))
+
+    // Structs, containers and other composite values go through the cached decoder
+    if (!Descriptor.JsonDecode)
     {
-        bSuccess = DeserializeAndApplyNameProperty(NameProp, PropertyAddress, JsonValue);
+        return false;
     }
-    else if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
+
+    TSharedPtr<FJsonValue> JsonValue;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+    return FJsonSerializer::Deserialize(Reader, JsonValue) && JsonValue.IsValid()
+        && Descriptor.JsonDecode(Descriptor.Property, PropertyAddr, JsonValue);
+}
+
+void FSpacetimeDBPropertyHelper::InvokeRepNotify(UObject* Object, FProperty* Property, void* PropertyAddress)
+{
+    if (!Object || !Property || !Property->HasAnyPropertyFlags(CPF_RepNotify))
     {
-        bSuccess = DeserializeAndApplyStructProperty(StructProp, PropertyAddress, JsonValue);
+        return;
     }
-    else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+
+    FName RepNotifyFuncName = Property->RepNotifyFunc;
+    if (RepNotifyFuncName == NAME_None)
     {
-        bSuccess = DeserializeAndApplyArrayProperty(ArrayProp, PropertyAddress, JsonValue);
+        return;
     }
-    else if (FMapProperty* MapProp = CastField<FMapProperty>(Property))
+
+    // Properties of the object itself have the function and parameter resolved already
+    if (PropertyAddress == Property->ContainerPtrToValuePtr<void>(Object))
     {
-        bSuccess = DeserializeAndApplyMapProperty(MapProp, PropertyAddress, JsonValue);
+        if (const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), Property->GetFName()))
+        {
+            InvokeRepNotify(Object, *Descriptor);
+            return;
+        }
     }
-    else if (FObjectProperty* ObjProp = CastField<FObjectProperty>(Property))
+
+    InvokeRepNotify(Object, Object->GetClass()->FindFunctionByName(RepNotifyFuncName), PropertyAddress);
+}
+
+void FSpacetimeDBPropertyHelper::InvokeRepNotify(UObject* Object, UFunction* RepNotifyFunc, const void* PropertyAddress)
+{
+    if (!Object || !RepNotifyFunc)
     {
-        bSuccess = DeserializeAndApplyObjectProperty(ObjProp, PropertyAddress, JsonValue);
+        return;
     }
-    else if (FSoftObjectProperty* SoftObjProp = CastField<FSoftObjectProperty>(Property))
+
+    CallRepNotify(Object, RepNotifyFunc, FindRepNotifyParam(RepNotifyFunc), PropertyAddress);
+}
+
+namespace
+{
+    /**
+     * Parameter buffers for RepNotify calls, one per nesting level since a notify may apply
+     * another property. Buffers only grow, so steady notifies never allocate.
+     */
+    struct FRepNotifyParmsPool
+    {
+        TIndirectArray<TArray<uint8, TAlignedHeapAllocator<16>>> Buffers;
+        int32 Depth = 0;
+    };
+
+    FRepNotifyParmsPool& GetRepNotifyParmsPool()
     {
-        bSuccess = DeserializeAndApplySoftObjectProperty(SoftObjProp, PropertyAddress, JsonValue);
+        thread_local FRepNotifyParmsPool Pool;
+        return Pool;
     }
-    else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+
+    /** Notifies deferred by the open FSpacetimeDBScopedRepNotifyBatch of this thread */
+    struct FRepNotifyBatchState
     {
-        bSuccess = DeserializeAndApplyEnumProperty(EnumProp, PropertyAddress, JsonValue);
+        struct FDeferredNotify
+        {
+            TWeakObjectPtr<UObject> Object;
+            const FSpacetimeDBPropertyDescriptor* Descriptor = nullptr;
+
+            /** Looks the descriptor up again if the cache was invalidated during the batch */
+            FName PropertyName;
+        };
+
+        int32 Depth = 0;
+
+        /** Descriptor cache generation when the outermost batch opened */
+        uint32 Generation = 0;
+
+        TArray<FDeferredNotify> Deferred;
+        TSet<TPair<const UObject*, const FSpacetimeDBPropertyDescriptor*>> DeferredKeys;
+    };
+
+    FRepNotifyBatchState& GetRepNotifyBatchState()
+    {
+        thread_local FRepNotifyBatchState State;
+        return State;
     }
-    else
+}
+
+void FSpacetimeDBPropertyHelper::InvokeRepNotify(UObject* Object, const FSpacetimeDBPropertyDescriptor& Descriptor)
+{
+    if (!Object || !Descriptor.RepNotifyFunc)
     {
-        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDB: Unsupported property type for %s"), *PropertyName);
-        return false;
+        return;
     }
 
-    // Fire RepNotify if available
-    if (bSuccess && Property->HasAnyPropertyFlags(CPF_RepNotify))
+    FRepNotifyBatchState& Batch = GetRepNotifyBatchState();
+    if (Batch.Depth > 0)
     {
-        FName RepNotifyFuncName = Property->RepNotifyFunc;
-        if (RepNotifyFuncName != NAME_None)
+        bool bAlreadyDeferred = false;
+        Batch.DeferredKeys.Add(TPair<const UObject*, const FSpacetimeDBPropertyDescriptor*>(Object, &Descriptor), &bAlreadyDeferred);
+        if (!bAlreadyDeferred)
         {
-            UFunction* RepNotifyFunc = Object->GetClass()->FindFunctionByName(RepNotifyFuncName);
-            if (RepNotifyFunc)
-            {
-                // Check if the RepNotify function takes a parameter
-                if (RepNotifyFunc->NumParms > 0)
-                {
-                    // Create a buffer for the parameter
-                    uint8* Buffer = (uint8*)FMemory::Malloc(RepNotifyFunc->ParmsSize);
-                    FMemory::Memzero(Buffer, RepNotifyFunc->ParmsSize);
-                    
-                    // Copy the property value to the parameter
-                    for (TFieldIterator<FProperty> It(RepNotifyFunc); It && It->HasAnyPropertyFlags(CPF_Parm) && !It->HasAnyPropertyFlags(CPF_ReturnParm); ++It)
-                    {
-                        void* Parm = It->ContainerPtrToValuePtr<void>(Buffer);
-                        It->CopyCompleteValue(Parm, PropertyAddress);
-                        break; // Only copy the first parameter
-                    }
-                    
-                    // Call the function
-                    Object->ProcessEvent(RepNotifyFunc, Buffer);
-                    
-                    // Clean up
-                    FMemory::Free(Buffer);
-                }
-                else
-                {
-                    // Call the function without parameters
-                    Object->ProcessEvent(RepNotifyFunc, nullptr);
-                }
-            }
+            Batch.Deferred.Add({ Object, &Descriptor, Descriptor.Name });
         }
+        return;
     }
 
-    return bSuccess;
+    CallRepNotify(Object, Descriptor.RepNotifyFunc, Descriptor.RepNotifyParam, Descriptor.GetValuePtr(Object));
+}
+
+FProperty* FSpacetimeDBPropertyHelper::FindRepNotifyParam(const UFunction* RepNotifyFunc)
+{
+    if (!RepNotifyFunc || RepNotifyFunc->NumParms == 0)
+    {
+        return nullptr;
+    }
+
+    // Only the first parameter is filled in
+    for (TFieldIterator<FProperty> It(RepNotifyFunc); It && It->HasAnyPropertyFlags(CPF_Parm) && !It->HasAnyPropertyFlags(CPF_ReturnParm); ++It)
+    {
+        return *It;
+    }
+    return nullptr;
+}
+
+void FSpacetimeDBPropertyHelper::CallRepNotify(UObject* Object, UFunction* RepNotifyFunc, const FProperty* Param, const void* PropertyAddress)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_RepNotify);
+    INC_DWORD_STAT(STAT_SpacetimeDB_RepNotifies);
+    
+    if (!Param)
+    {
+        // Call the function without parameters
+        Object->ProcessEvent(RepNotifyFunc, nullptr);
+        return;
+    }
+
+    FRepNotifyParmsPool& Pool = GetRepNotifyParmsPool();
+    if (Pool.Depth == Pool.Buffers.Num())
+    {
+        Pool.Buffers.Add(new TArray<uint8, TAlignedHeapAllocator<16>>());
+    }
+    TArray<uint8, TAlignedHeapAllocator<16>>& Buffer = Pool.Buffers[Pool.Depth++];
+    if (Buffer.Num() < RepNotifyFunc->ParmsSize)
+    {
+        Buffer.SetNumUninitialized(RepNotifyFunc->ParmsSize);
+    }
+    uint8* Parms = Buffer.GetData();
+    FMemory::Memzero(Parms, RepNotifyFunc->ParmsSize);
+
+    // Copy the property value to the parameter
+    void* ParamAddr = Param->ContainerPtrToValuePtr<void>(Parms);
+    Param->CopyCompleteValue(ParamAddr, PropertyAddress);
+
+    Object->ProcessEvent(RepNotifyFunc, Parms);
+
+    // Strings and containers copied into the parameter own memory of their own
+    Param->DestroyValue(ParamAddr);
+    --Pool.Depth;
+}
+
+FSpacetimeDBScopedRepNotifyBatch::FSpacetimeDBScopedRepNotifyBatch(bool bInEnabled)
+    : bEnabled(bInEnabled)
+{
+    if (bEnabled)
+    {
+        FRepNotifyBatchState& Batch = GetRepNotifyBatchState();
+        if (Batch.Depth++ == 0)
+        {
+            Batch.Generation = FSpacetimeDBPropertyDescriptorCache::GetGeneration();
+        }
+    }
+}
+
+FSpacetimeDBScopedRepNotifyBatch::~FSpacetimeDBScopedRepNotifyBatch()
+{
+    if (!bEnabled)
+    {
+        return;
+    }
+
+    FRepNotifyBatchState& Batch = GetRepNotifyBatchState();
+    if (--Batch.Depth > 0)
+    {
+        return;
+    }
+
+    // Notifies fired from here on run immediately, so another batch may reuse the state
+    TArray<FRepNotifyBatchState::FDeferredNotify> Deferred = MoveTemp(Batch.Deferred);
+    Batch.Deferred.Reset();
+    Batch.DeferredKeys.Reset();
+
+    const bool bDescriptorsStale = Batch.Generation != FSpacetimeDBPropertyDescriptorCache::GetGeneration();
+    for (const FRepNotifyBatchState::FDeferredNotify& Notify : Deferred)
+    {
+        UObject* Object = Notify.Object.Get();
+        if (!Object)
+        {
+            continue;
+        }
+
+        const FSpacetimeDBPropertyDescriptor* Descriptor = bDescriptorsStale
+            ? FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), Notify.PropertyName)
+            : Notify.Descriptor;
+        if (Descriptor)
+        {
+            FSpacetimeDBPropertyHelper::InvokeRepNotify(Object, *Descriptor);
+        }
+    }
+}
+
+bool FSpacetimeDBScopedRepNotifyBatch::IsActive()
+{
+    return GetRepNotifyBatchState().Depth > 0;
 }
 
 FString FSpacetimeDBPropertyHelper::SerializePropertyToJson(UObject* Object, const FString& PropertyName)
@@ -135,18 +393,21 @@ FString FSpacetimeDBPropertyHelper::SerializePropertyToJson(UObject* Object, con
     }
 
     // Find the property 
-    FProperty* Property = Object->GetClass()->FindPropertyByName(FName(*PropertyName));
-    if (!Property)
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName);
+    if (!Descriptor)
     {
         UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBPropertyHelper: Property %s not found in object %s"), *PropertyName, *Object->GetName());
         return FString();
     }
 
-    // Get the property's address
-    void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(Object);
+    if (!Descriptor->JsonEncode)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBPropertyHelper: Unsupported property type for serialization: %s"), *PropertyName);
+        return FString();
+    }
 
-    // Call the appropriate serialization function based on property type
-    TSharedPtr<FJsonValue> JsonValue = SerializePropertyToJsonValue(Property, PropertyAddr);
+    // Call the cached serialization function for this property type
+    TSharedPtr<FJsonValue> JsonValue = Descriptor->JsonEncode(Descriptor->Property, Descriptor->GetValuePtr(Object));
     if (!JsonValue.IsValid())
     {
         return FString();
@@ -859,169 +1120,150 @@ bool FSpacetimeDBPropertyHelper::ApplyJsonValueToProperty(UObject* Object, const
 
     // Find the property on the object
     UClass* ObjectClass = Object->GetClass();
-    FProperty* Property = FindFProperty<FProperty>(ObjectClass, *PropertyName);
-    if (!Property)
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(ObjectClass, PropertyName);
+    if (!Descriptor)
     {
         UE_LOG(LogTemp, Warning, TEXT("FSpacetimeDBPropertyHelper::ApplyJsonValueToProperty - Property '%s' not found on object of class '%s'"), 
             *PropertyName, *ObjectClass->GetName());
         return false;
     }
 
-    // Get the address of the property in the object
-    void* PropertyAddress = Property->ContainerPtrToValuePtr<void>(Object);
-    bool bSuccess = false;
+    if (!Descriptor->JsonDecode)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FSpacetimeDBPropertyHelper::ApplyJsonValueToProperty - Unsupported property type for property '%s'"), 
+            *PropertyName);
+        return false;
+    }
+
+    // Decode straight into the property using the cached decoder
+    void* PropertyAddress = Descriptor->GetValuePtr(Object);
+    bool bSuccess = Descriptor->JsonDecode(Descriptor->Property, PropertyAddress, JsonValue);
 
-    // Handle different property types - reuse existing helpers where possible
-    if (FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
+    // Fire RepNotify if available
+    if (bSuccess)
     {
-        bSuccess = DeserializeAndApplyNumericProperty(NumericProp, PropertyAddress, JsonValue);
+        InvokeRepNotify(Object, *Descriptor);
     }
-    else if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+
+    return bSuccess;
+}
+
+TSharedPtr<FJsonValue> FSpacetimeDBPropertyHelper::SerializePropertyToJsonValue(FProperty* Property, const void* PropertyAddr)
+{
+    if (!Property || !PropertyAddr)
     {
-        bSuccess = DeserializeAndApplyBoolProperty(BoolProp, PropertyAddress, JsonValue);
+        return nullptr;
     }
-    else if (FStrProperty* StrProp = CastField<FStrProperty>(Property))
+
+    FSpacetimeDBJsonEncodeFunc Encode = GetJsonEncoder(Property);
+    if (!Encode)
     {
-        bSuccess = DeserializeAndApplyStrProperty(StrProp, PropertyAddress, JsonValue);
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBPropertyHelper: Unsupported property type for serialization: %s"), *Property->GetName());
+        return nullptr;
     }
-    else if (FTextProperty* TextProp = CastField<FTextProperty>(Property))
+
+    return Encode(Property, PropertyAddr);
+}
+
+FSpacetimeDBJsonDecodeFunc FSpacetimeDBPropertyHelper::GetJsonDecoder(const FProperty* Property)
+{
+    // The order matters: it mirrors the CastField chain the helpers were originally dispatched with
+    if (Property->IsA<FNumericProperty>())
     {
-        bSuccess = DeserializeAndApplyTextProperty(TextProp, PropertyAddress, JsonValue);
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyNumericProperty(static_cast<FNumericProperty*>(Prop), Addr, Json); };
     }
-    else if (FNameProperty* NameProp = CastField<FNameProperty>(Property))
+    else if (Property->IsA<FBoolProperty>())
     {
-        bSuccess = DeserializeAndApplyNameProperty(NameProp, PropertyAddress, JsonValue);
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyBoolProperty(static_cast<FBoolProperty*>(Prop), Addr, Json); };
     }
-    else if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
+    else if (Property->IsA<FStrProperty>())
     {
-        bSuccess = DeserializeAndApplyStructProperty(StructProp, PropertyAddress, JsonValue);
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyStrProperty(static_cast<FStrProperty*>(Prop), Addr, Json); };
     }
-    else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+    else if (Property->IsA<FTextProperty>())
     {
-        bSuccess = DeserializeAndApplyArrayProperty(ArrayProp, PropertyAddress, JsonValue);
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyTextProperty(static_cast<FTextProperty*>(Prop), Addr, Json); };
     }
-    else if (FMapProperty* MapProp = CastField<FMapProperty>(Property))
+    else if (Property->IsA<FNameProperty>())
     {
-        bSuccess = DeserializeAndApplyMapProperty(MapProp, PropertyAddress, JsonValue);
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyNameProperty(static_cast<FNameProperty*>(Prop), Addr, Json); };
     }
-    else if (FObjectProperty* ObjProp = CastField<FObjectProperty>(Property))
+    else if (Property->IsA<FStructProperty>())
     {
-        bSuccess = DeserializeAndApplyObjectProperty(ObjProp, PropertyAddress, JsonValue);
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyStructProperty(static_cast<FStructProperty*>(Prop), Addr, Json); };
     }
-    else if (FSoftObjectProperty* SoftObjProp = CastField<FSoftObjectProperty>(Property))
+    else if (Property->IsA<FArrayProperty>())
     {
-        bSuccess = DeserializeAndApplySoftObjectProperty(SoftObjProp, PropertyAddress, JsonValue);
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyArrayProperty(static_cast<FArrayProperty*>(Prop), Addr, Json); };
     }
-    else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+    else if (Property->IsA<FMapProperty>())
     {
-        bSuccess = DeserializeAndApplyEnumProperty(EnumProp, PropertyAddress, JsonValue);
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyMapProperty(static_cast<FMapProperty*>(Prop), Addr, Json); };
     }
-    else
+    else if (Property->IsA<FObjectProperty>())
     {
-        UE_LOG(LogTemp, Warning, TEXT("FSpacetimeDBPropertyHelper::ApplyJsonValueToProperty - Unsupported property type for property '%s'"), 
-            *PropertyName);
-        return false;
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyObjectProperty(static_cast<FObjectProperty*>(Prop), Addr, Json); };
     }
-
-    // Fire RepNotify if available
-    if (bSuccess && Property->HasAnyPropertyFlags(CPF_RepNotify))
+    else if (Property->IsA<FSoftObjectProperty>())
     {
-        FName RepNotifyFuncName = Property->RepNotifyFunc;
-        if (RepNotifyFuncName != NAME_None)
-        {
-            UFunction* RepNotifyFunc = Object->GetClass()->FindFunctionByName(RepNotifyFuncName);
-            if (RepNotifyFunc)
-            {
-                // Check if the RepNotify function takes a parameter
-                if (RepNotifyFunc->NumParms > 0)
-                {
-                    // Create a buffer for the parameter
-                    uint8* Buffer = (uint8*)FMemory::Malloc(RepNotifyFunc->ParmsSize);
-                    FMemory::Memzero(Buffer, RepNotifyFunc->ParmsSize);
-                    
-                    // Copy the property value to the parameter
-                    for (TFieldIterator<FProperty> It(RepNotifyFunc); It && It->HasAnyPropertyFlags(CPF_Parm) && !It->HasAnyPropertyFlags(CPF_ReturnParm); ++It)
-                    {
-                        void* Parm = It->ContainerPtrToValuePtr<void>(Buffer);
-                        It->CopyCompleteValue(Parm, PropertyAddress);
-                        break; // Only copy the first parameter
-                    }
-                    
-                    // Call the function
-                    Object->ProcessEvent(RepNotifyFunc, Buffer);
-                    
-                    // Clean up
-                    FMemory::Free(Buffer);
-                }
-                else
-                {
-                    // Call the function without parameters
-                    Object->ProcessEvent(RepNotifyFunc, nullptr);
-                }
-            }
-        }
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplySoftObjectProperty(static_cast<FSoftObjectProperty*>(Prop), Addr, Json); };
+    }
+    else if (Property->IsA<FEnumProperty>())
+    {
+        return [](FProperty* Prop, void* Addr, const TSharedPtr<FJsonValue>& Json) { return DeserializeAndApplyEnumProperty(static_cast<FEnumProperty*>(Prop), Addr, Json); };
     }
 
-    return bSuccess;
+    return nullptr;
 }
 
-TSharedPtr<FJsonValue> FSpacetimeDBPropertyHelper::SerializePropertyToJsonValue(FProperty* Property, const void* PropertyAddr)
+FSpacetimeDBJsonEncodeFunc FSpacetimeDBPropertyHelper::GetJsonEncoder(const FProperty* Property)
 {
-    if (!Property || !PropertyAddr)
+    if (Property->IsA<FNumericProperty>())
     {
-        return nullptr;
+        return [](FProperty* Prop, const void* Addr) { return SerializeNumericProperty(static_cast<FNumericProperty*>(Prop), Addr); };
     }
-
-    // Handle different property types
-    if (FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
+    else if (Property->IsA<FBoolProperty>())
     {
-        return SerializeNumericProperty(NumericProp, PropertyAddr);
+        return [](FProperty* Prop, const void* Addr) { return SerializeBoolProperty(static_cast<FBoolProperty*>(Prop), Addr); };
     }
-    else if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+    else if (Property->IsA<FStrProperty>())
     {
-        return SerializeBoolProperty(BoolProp, PropertyAddr);
+        return [](FProperty* Prop, const void* Addr) { return SerializeStrProperty(static_cast<FStrProperty*>(Prop), Addr); };
     }
-    else if (FStrProperty* StrProp = CastField<FStrProperty>(Property))
+    else if (Property->IsA<FTextProperty>())
     {
-        return SerializeStrProperty(StrProp, PropertyAddr);
+        return [](FProperty* Prop, const void* Addr) { return SerializeTextProperty(static_cast<FTextProperty*>(Prop), Addr); };
     }
-    else if (FTextProperty* TextProp = CastField<FTextProperty>(Property))
+    else if (Property->IsA<FNameProperty>())
     {
-        return SerializeTextProperty(TextProp, PropertyAddr);
+        return [](FProperty* Prop, const void* Addr) { return SerializeNameProperty(static_cast<FNameProperty*>(Prop), Addr); };
     }
-    else if (FNameProperty* NameProp = CastField<FNameProperty>(Property))
+    else if (Property->IsA<FStructProperty>())
     {
-        return SerializeNameProperty(NameProp, PropertyAddr);
+        return [](FProperty* Prop, const void* Addr) { return SerializeStructProperty(static_cast<FStructProperty*>(Prop), Addr); };
     }
-    else if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
+    else if (Property->IsA<FArrayProperty>())
     {
-        return SerializeStructProperty(StructProp, PropertyAddr);
+        return [](FProperty* Prop, const void* Addr) { return SerializeArrayProperty(static_cast<FArrayProperty*>(Prop), Addr); };
     }
-    else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+    else if (Property->IsA<FMapProperty>())
     {
-        return SerializeArrayProperty(ArrayProp, PropertyAddr);
+        return [](FProperty* Prop, const void* Addr) { return SerializeMapProperty(static_cast<FMapProperty*>(Prop), Addr); };
     }
-    else if (FMapProperty* MapProp = CastField<FMapProperty>(Property))
+    else if (Property->IsA<FObjectProperty>())
     {
-        return SerializeMapProperty(MapProp, PropertyAddr);
+        return [](FProperty* Prop, const void* Addr) { return SerializeObjectProperty(static_cast<FObjectProperty*>(Prop), Addr); };
     }
-    else if (FObjectProperty* ObjProp = CastField<FObjectProperty>(Property))
+    else if (Property->IsA<FSoftObjectProperty>())
     {
-        return SerializeObjectProperty(ObjProp, PropertyAddr);
+        return [](FProperty* Prop, const void* Addr) { return SerializeSoftObjectProperty(static_cast<FSoftObjectProperty*>(Prop), Addr); };
     }
-    else if (FSoftObjectProperty* SoftObjProp = CastField<FSoftObjectProperty>(Property))
+    else if (Property->IsA<FEnumProperty>())
     {
-        return SerializeSoftObjectProperty(SoftObjProp, PropertyAddr);
-    }
-    else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
-    {
-        return SerializeEnumProperty(EnumProp, PropertyAddr);
-    }
-    else
-    {
-        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBPropertyHelper: Unsupported property type for serialization: %s"), *Property->GetName());
-        return nullptr;
+        return [](FProperty* Prop, const void* Addr) { return SerializeEnumProperty(static_cast<FEnumProperty*>(Prop), Addr); };
     }
+
+    return nullptr;
 }
 
 FString FSpacetimeDBPropertyHelper::GetPropertyValueByName(UObject* Object, const FString& PropertyName)
@@ -1032,20 +1274,17 @@ FString FSpacetimeDBPropertyHelper::GetPropertyValueByName(UObject* Object, cons
         return FString();
     }
 
-    // Find the property by name - using FindPropertyByName instead of FindField
-    FProperty* Property = Object->GetClass()->FindPropertyByName(FName(*PropertyName));
-    if (!Property)
+    // Find the property by name through the descriptor cache
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName);
+    if (!Descriptor)
     {
         UE_LOG(LogTemp, Warning, TEXT("GetPropertyValueByName: Property '%s' not found on object of class '%s'"), 
             *PropertyName, *Object->GetClass()->GetName());
         return FString();
     }
 
-    // Get the property address
-    void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(Object);
-
     // Serialize the property to JSON
-    TSharedPtr<FJsonValue> JsonValue = SerializePropertyToJsonValue(Property, PropertyAddr);
+    TSharedPtr<FJsonValue> JsonValue = Descriptor->JsonEncode ? Descriptor->JsonEncode(Descriptor->Property, Descriptor->GetValuePtr(Object)) : nullptr;
     if (!JsonValue.IsValid())
     {
         UE_LOG(LogTemp, Warning, TEXT("GetPropertyValueByName: Failed to serialize property '%s'"), *PropertyName);
@@ -0,0 +1,233 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBProxyStore.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    /** Kind byte of a property record */
+    enum class EProxyRecordKind : uint8
+    {
+        Json,
+        Binary
+    };
+
+    /** Reads the header of the record at the reader's offset and skips its value */
+    bool SkipRecord(FSpacetimeDBBinaryReader& Reader, FString& OutPropertyName)
+    {
+        Reader.ReadUInt8();
+        OutPropertyName = Reader.ReadString();
+        const uint32 ValueSize = Reader.ReadUInt32();
+        if (Reader.IsError() || ValueSize > static_cast<uint32>(Reader.Size - Reader.Offset))
+        {
+            return false;
+        }
+        Reader.Offset += static_cast<int32>(ValueSize);
+        return true;
+    }
+}
+
+FSpacetimeDBProxyEntity& FSpacetimeDBProxyStore::Add(int64 ObjectId)
+{
+    if (const int32* Index = ObjectIndex.Find(ObjectId))
+    {
+        FSpacetimeDBProxyEntity& Existing = Entities[*Index];
+        Existing = FSpacetimeDBProxyEntity();
+        Existing.ObjectId = ObjectId;
+        return Existing;
+    }
+
+    ObjectIndex.Add(ObjectId, Entities.Num());
+    FSpacetimeDBProxyEntity& Entity = Entities.AddDefaulted_GetRef();
+    Entity.ObjectId = ObjectId;
+    return Entity;
+}
+
+bool FSpacetimeDBProxyStore::Remove(int64 ObjectId, FSpacetimeDBProxyEntity* OutEntity)
+{
+    int32 Index = INDEX_NONE;
+    if (!ObjectIndex.RemoveAndCopyValue(ObjectId, Index))
+    {
+        return false;
+    }
+
+    if (OutEntity)
+    {
+        *OutEntity = MoveTemp(Entities[Index]);
+    }
+
+    Entities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    if (Index < Entities.Num())
+    {
+        ObjectIndex[Entities[Index].ObjectId] = Index;
+    }
+    return true;
+}
+
+FSpacetimeDBProxyEntity* FSpacetimeDBProxyStore::Find(int64 ObjectId)
+{
+    const int32* Index = ObjectIndex.Find(ObjectId);
+    return Index ? &Entities[*Index] : nullptr;
+}
+
+const FSpacetimeDBProxyEntity* FSpacetimeDBProxyStore::Find(int64 ObjectId) const
+{
+    const int32* Index = ObjectIndex.Find(ObjectId);
+    return Index ? &Entities[*Index] : nullptr;
+}
+
+void FSpacetimeDBProxyStore::Reset()
+{
+    Entities.Reset();
+    ObjectIndex.Reset();
+}
+
+void FSpacetimeDBProxyStore::StoreProperty(FSpacetimeDBProxyEntity& Proxy, const FString& PropertyName, const FString& ValueJson)
+{
+    DetachFromCache(Proxy);
+    RemoveRecords(Proxy, PropertyName);
+
+    FSpacetimeDBBinaryWriter Writer(Proxy.Properties);
+    Writer.WriteUInt8(static_cast<uint8>(EProxyRecordKind::Json));
+    Writer.WriteString(PropertyName);
+    Writer.WriteString(ValueJson);
+}
+
+void FSpacetimeDBProxyStore::StoreProperty(FSpacetimeDBProxyEntity& Proxy, const FString& PropertyName, const TArray<uint8>& Payload)
+{
+    DetachFromCache(Proxy);
+
+    // A delta edits the value in front of it, so that value has to stay
+    if (!FSpacetimeDBBinaryCodec::IsDelta(Payload.GetData(), Payload.Num()))
+    {
+        RemoveRecords(Proxy, PropertyName);
+    }
+
+    FSpacetimeDBBinaryWriter Writer(Proxy.Properties);
+    Writer.WriteUInt8(static_cast<uint8>(EProxyRecordKind::Binary));
+    Writer.WriteString(PropertyName);
+    Writer.WriteUInt32(static_cast<uint32>(Payload.Num()));
+    Writer.WriteBytes(Payload.GetData(), Payload.Num());
+}
+
+void FSpacetimeDBProxyStore::CaptureProperties(FSpacetimeDBProxyEntity& Proxy, const UObject* Object)
+{
+    const FSpacetimeDBClassDescriptor* ClassDescriptor = FSpacetimeDBPropertyDescriptorCache::GetClassDescriptor(Object->GetClass());
+    if (!ClassDescriptor)
+    {
+        return;
+    }
+
+    TArray<uint8> Encoded;
+    for (const FSpacetimeDBPropertyDescriptor& Descriptor : ClassDescriptor->Properties)
+    {
+        const FProperty* Property = Descriptor.Property;
+        if (!Property->HasAnyPropertyFlags(CPF_Net) || Property->HasAnyPropertyFlags(CPF_RepSkip)
+            || Descriptor.TypeTag == ESpacetimeDBPropertyType::None)
+        {
+            continue;
+        }
+
+        Encoded.Reset();
+        if (FSpacetimeDBBinaryCodec::EncodeProperty(Descriptor, Object, Encoded))
+        {
+            StoreProperty(Proxy, Descriptor.Name.ToString(), Encoded);
+        }
+    }
+}
+
+void FSpacetimeDBProxyStore::VisitProperties(const FSpacetimeDBProxyEntity& Proxy, FPropertyVisitor Visitor)
+{
+    const TConstArrayView<uint8> Records = Proxy.CacheFile ? Proxy.CachedProperties : TConstArrayView<uint8>(Proxy.Properties);
+    FSpacetimeDBBinaryReader Reader(Records.GetData(), Records.Num());
+    while (!Reader.IsAtEnd())
+    {
+        const EProxyRecordKind Kind = static_cast<EProxyRecordKind>(Reader.ReadUInt8());
+        FString PropertyName = Reader.ReadString();
+
+        FString ValueJson;
+        TArray<uint8> Payload;
+        if (Kind == EProxyRecordKind::Json)
+        {
+            ValueJson = Reader.ReadString();
+        }
+        else
+        {
+            const uint32 ValueSize = Reader.ReadUInt32();
+            if (!Reader.IsError() && ValueSize <= static_cast<uint32>(Reader.Size - Reader.Offset))
+            {
+                Payload.SetNumUninitialized(static_cast<int32>(ValueSize));
+                Reader.ReadBytes(Payload.GetData(), Payload.Num());
+            }
+            else
+            {
+                Reader.bError = true;
+            }
+        }
+
+        if (Reader.IsError())
+        {
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBProxyStore: Property records of proxy %lld are corrupt"), Proxy.ObjectId);
+            return;
+        }
+        Visitor(MoveTemp(PropertyName), MoveTemp(ValueJson), MoveTemp(Payload), Kind == EProxyRecordKind::Binary);
+    }
+}
+
+void FSpacetimeDBProxyStore::DetachFromCache(FSpacetimeDBProxyEntity& Proxy)
+{
+    if (!Proxy.CacheFile)
+    {
+        return;
+    }
+
+    FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Proxy.CachedDataJson.GetData()), Proxy.CachedDataJson.Num());
+    Proxy.DataJson = FString(Converted.Length(), Converted.Get());
+    Proxy.Properties = TArray<uint8>(Proxy.CachedProperties.GetData(), Proxy.CachedProperties.Num());
+
+    Proxy.CachedDataJson = TConstArrayView<uint8>();
+    Proxy.CachedProperties = TConstArrayView<uint8>();
+    Proxy.CacheFile.Reset();
+}
+
+void FSpacetimeDBProxyStore::DetachAllFromCache()
+{
+    for (FSpacetimeDBProxyEntity& Entity : Entities)
+    {
+        DetachFromCache(Entity);
+    }
+}
+
+void FSpacetimeDBProxyStore::RemoveRecords(FSpacetimeDBProxyEntity& Proxy, const FString& PropertyName)
+{
+    TArray<uint8>& Records = Proxy.Properties;
+    FSpacetimeDBBinaryReader Reader(Records.GetData(), Records.Num());
+    FString RecordName;
+
+    // Compact in place, moving the records that stay over the ones that go
+    int32 WriteOffset = 0;
+    while (!Reader.IsAtEnd())
+    {
+        const int32 RecordStart = Reader.GetOffset();
+        const bool bParsed = SkipRecord(Reader, RecordName);
+
+        // Keep whatever can't be parsed; VisitProperties reports it
+        const int32 RecordSize = bParsed ? Reader.GetOffset() - RecordStart : Records.Num() - RecordStart;
+        if (bParsed && RecordName == PropertyName)
+        {
+            continue;
+        }
+        if (WriteOffset != RecordStart)
+        {
+            FMemory::Memmove(Records.GetData() + WriteOffset, Records.GetData() + RecordStart, RecordSize);
+        }
+        WriteOffset += RecordSize;
+        if (!bParsed)
+        {
+            break;
+        }
+    }
+    Records.SetNum(WriteOffset, EAllowShrinking::No);
+}
@@ -8,20 +8,76 @@ USpacetimeDBSettings::USpacetimeDBSettings()
     DefaultHostname = TEXT("localhost:3000");
     DefaultDatabaseName = TEXT("spacetimedb-example");
     bAutoConnect = false;
+    bAutoReconnect = true;
     ReconnectionDelay = 2.0f;
+    MaxReconnectionDelay = 30.0f;
     MaxReconnectionAttempts = 3;
     
     // Default debugging settings
     bEnableDebugLogging = false;
+    bUseJsonPropertyEncoding = false;
     
     // Default networking settings
     bEnablePrediction = true;
+    InboundEventQueueCapacity = 65536;
+    InboundEventTimeBudgetMs = 4.0f;
+    InboundEventBackpressureTimeoutMs = 100.0f;
+    bCoalescePropertyUpdates = true;
+    bBatchRepNotifies = false;
+    bDecodePayloadsOffGameThread = true;
+    bBatchPropertyUpdates = true;
+    bUseInternedPropertyIds = true;
+    bSendPropertyDeltas = false;
+    bBatchReducerCalls = false;
+    MaxReducerBatchBytes = 256 * 1024;
+    OutboundBytesPerSecond = 0;
+    OutboundBurstSeconds = 0.1f;
+    OutboundPriorityDistance = 5000.0f;
+    OutboundViewPawnPriority = 4.0f;
+    UnreliableRpcMaxAge = 0.5f;
+    bAutoReplicateOwnedObjects = false;
+    AutoReplicationInterval = 0.1f;
+    AutoReplicationObjectsPerFrame = 256;
+    bTimeSliceObjectMaterialization = true;
+    ObjectMaterializationTimeBudgetMs = 4.0f;
+    bQuantizePredictedTransforms = true;
+    PredictionWorldCellSize = 65536.0f;
+    PredictionVelocityStep = 1.0f;
+    PredictionFullRecordInterval = 60;
+    
+    // Default interest management settings
+    bEnableInterestManagement = false;
+    InterestCellSize = 10000.0f;
+    InterestRadiusCells = 1;
+    InterestHysteresisCells = 1;
+    InterestTables.Add(TEXT("actors"));
+    InterestTables.Add(TEXT("object_instance"));
+    InterestCellXColumn = TEXT("cell_x");
+    InterestCellYColumn = TEXT("cell_y");
+    bEnableProxyEntities = false;
+    ProxyRelevanceDistance = 15000.0f;
+    ProxyRelevanceHysteresis = 2500.0f;
+    ProxyRelevanceInterval = 0.25f;
+    bEnableSnapshotCache = false;
     
     // Default table subscriptions
     bAutoSubscribeDefaultTables = true;
     DefaultTableSubscriptions.Add(TEXT("object_class"));
     DefaultTableSubscriptions.Add(TEXT("property_definition"));
     DefaultTableSubscriptions.Add(TEXT("object_instance"));
+    
+    FSpacetimeDBCachedTable& Objects = CachedTables.AddDefaulted_GetRef();
+    Objects.TableName = TEXT("object_instance");
+    Objects.Indexes.Add(TEXT("owner_id"));
+    
+    FSpacetimeDBCachedTable& Components = CachedTables.AddDefaulted_GetRef();
+    Components.TableName = TEXT("actor_component");
+    Components.Indexes.Add(TEXT("actor_id"));
+    
+    ErrorReportWindowSeconds = 1.0f;
+    MaxErrorReportsPerWindow = 5;
+    MaxErrorContextLength = 256;
+    bCollectTrafficStats = false;
 }
 
 const USpacetimeDBSettings* USpacetimeDBSettings::Get()
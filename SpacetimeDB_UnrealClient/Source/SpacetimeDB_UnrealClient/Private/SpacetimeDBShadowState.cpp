@@ -0,0 +1,335 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBShadowState.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    /** Whether a property can be shadowed by copying its bytes */
+    bool IsShadowedByBytes(const FProperty* Property)
+    {
+        if (!Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+        {
+            return false;
+        }
+
+        // Bitfield bools share their byte with their neighbours
+        const FBoolProperty* BoolProp = CastField<FBoolProperty>(Property);
+        return !BoolProp || BoolProp->IsNativeBool();
+    }
+}
+
+TSharedRef<const FSpacetimeDBShadowLayout> FSpacetimeDBShadowLayout::Build(UClass* Class)
+{
+    TSharedRef<FSpacetimeDBShadowLayout> Layout = MakeShared<FSpacetimeDBShadowLayout>();
+
+    const FSpacetimeDBClassDescriptor* ClassDescriptor = FSpacetimeDBPropertyDescriptorCache::GetClassDescriptor(Class);
+    if (!ClassDescriptor)
+    {
+        return Layout;
+    }
+
+    for (const FSpacetimeDBPropertyDescriptor& Descriptor : ClassDescriptor->Properties)
+    {
+        const FProperty* Property = Descriptor.Property;
+        if (!Property->HasAnyPropertyFlags(CPF_Net) || Property->HasAnyPropertyFlags(CPF_RepSkip))
+        {
+            continue;
+        }
+
+        // Only values the codec can send are worth watching
+        if (Descriptor.TypeTag == ESpacetimeDBPropertyType::None)
+        {
+            continue;
+        }
+
+        if (IsShadowedByBytes(Property))
+        {
+            FPodProperty& PodProperty = Layout->PodProperties.AddDefaulted_GetRef();
+            PodProperty.DescriptorIndex = Descriptor.Index;
+            PodProperty.ObjectOffset = Descriptor.Offset;
+            PodProperty.Size = Property->GetSize();
+        }
+        else
+        {
+            Layout->EncodedProperties.Add(Descriptor.Index);
+        }
+    }
+
+    // Pack in memory order so neighbours in the object stay neighbours in the shadow
+    Layout->PodProperties.Sort([](const FPodProperty& A, const FPodProperty& B)
+    {
+        return A.ObjectOffset < B.ObjectOffset;
+    });
+
+    for (int32 Index = 0; Index < Layout->PodProperties.Num(); ++Index)
+    {
+        FPodProperty& PodProperty = Layout->PodProperties[Index];
+        PodProperty.ShadowOffset = Layout->ShadowSize;
+        Layout->ShadowSize += PodProperty.Size;
+
+        FSpan* Span = Layout->Spans.Num() > 0 ? &Layout->Spans.Last() : nullptr;
+        if (Span && Span->ObjectOffset + Span->Size == PodProperty.ObjectOffset)
+        {
+            Span->Size += PodProperty.Size;
+            ++Span->NumProperties;
+        }
+        else
+        {
+            Span = &Layout->Spans.AddDefaulted_GetRef();
+            Span->ObjectOffset = PodProperty.ObjectOffset;
+            Span->ShadowOffset = PodProperty.ShadowOffset;
+            Span->Size = PodProperty.Size;
+            Span->FirstProperty = Index;
+            Span->NumProperties = 1;
+        }
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBShadowState: Layout for %s has %d byte-compared properties in %d spans (%d bytes) and %d encoded properties"),
+        *Class->GetName(), Layout->PodProperties.Num(), Layout->Spans.Num(), Layout->ShadowSize, Layout->EncodedProperties.Num());
+
+    return Layout;
+}
+
+bool FSpacetimeDBShadowState::Track(int64 ObjectId, UObject* Object)
+{
+    if (!Object)
+    {
+        return false;
+    }
+
+    if (DescriptorGeneration != FSpacetimeDBPropertyDescriptorCache::GetGeneration())
+    {
+        RefreshAfterInvalidation();
+    }
+
+    TSharedRef<const FSpacetimeDBShadowLayout> Layout = FindOrBuildLayout(Object->GetClass());
+    if (Layout->IsEmpty())
+    {
+        Untrack(ObjectId);
+        return false;
+    }
+
+    int32& Index = ObjectIndex.FindOrAdd(ObjectId, INDEX_NONE);
+    if (Index == INDEX_NONE)
+    {
+        Index = Objects.AddDefaulted();
+    }
+
+    FTrackedObject& Tracked = Objects[Index];
+    Tracked.ObjectId = ObjectId;
+    Tracked.Object = Object;
+    Tracked.Layout = Layout;
+    CaptureShadow(Tracked, Object);
+    return true;
+}
+
+void FSpacetimeDBShadowState::Untrack(int64 ObjectId)
+{
+    int32 Index = INDEX_NONE;
+    if (!ObjectIndex.RemoveAndCopyValue(ObjectId, Index))
+    {
+        return;
+    }
+
+    Objects.RemoveAtSwap(Index);
+    if (Index < Objects.Num())
+    {
+        ObjectIndex[Objects[Index].ObjectId] = Index;
+    }
+
+    if (Cursor > Objects.Num())
+    {
+        Cursor = 0;
+    }
+}
+
+void FSpacetimeDBShadowState::Reset()
+{
+    Objects.Reset();
+    ObjectIndex.Reset();
+    Layouts.Reset();
+    Cursor = 0;
+}
+
+void FSpacetimeDBShadowState::RecaptureProperty(int64 ObjectId, FName PropertyName)
+{
+    const int32* Index = ObjectIndex.Find(ObjectId);
+    if (!Index || PropertyName.IsNone() || DescriptorGeneration != FSpacetimeDBPropertyDescriptorCache::GetGeneration())
+    {
+        return;
+    }
+
+    FTrackedObject& Tracked = Objects[*Index];
+    const UObject* Object = Tracked.Object.Get();
+    const FSpacetimeDBClassDescriptor* ClassDescriptor = Object ? FSpacetimeDBPropertyDescriptorCache::GetClassDescriptor(Object->GetClass()) : nullptr;
+    const FSpacetimeDBPropertyDescriptor* Descriptor = ClassDescriptor ? ClassDescriptor->Find(PropertyName) : nullptr;
+    if (!Descriptor)
+    {
+        return;
+    }
+
+    // Layouts hold a handful of properties, so a scan beats keeping a lookup table per class
+    const FSpacetimeDBShadowLayout& Layout = *Tracked.Layout;
+    for (const FSpacetimeDBShadowLayout::FPodProperty& PodProperty : Layout.PodProperties)
+    {
+        if (PodProperty.DescriptorIndex == Descriptor->Index)
+        {
+            FMemory::Memcpy(Tracked.PodShadow.GetData() + PodProperty.ShadowOffset, reinterpret_cast<const uint8*>(Object) + PodProperty.ObjectOffset, PodProperty.Size);
+            return;
+        }
+    }
+
+    const int32 EncodedIndex = Layout.EncodedProperties.Find(Descriptor->Index);
+    if (EncodedIndex != INDEX_NONE)
+    {
+        Tracked.EncodedShadow[EncodedIndex].Reset();
+        FSpacetimeDBBinaryCodec::EncodeProperty(*Descriptor, Object, Tracked.EncodedShadow[EncodedIndex]);
+    }
+}
+
+int32 FSpacetimeDBShadowState::CollectChanges(double Now, double Interval, int32 MaxObjects, FOnPropertyChanged OnChanged)
+{
+    if (Objects.Num() == 0 || MaxObjects <= 0)
+    {
+        return 0;
+    }
+
+    if (DescriptorGeneration != FSpacetimeDBPropertyDescriptorCache::GetGeneration())
+    {
+        RefreshAfterInvalidation();
+    }
+
+    TArray<int64, TInlineAllocator<8>> StaleObjects;
+    int32 NumCompared = 0;
+
+    // One lap at most, starting where the previous call stopped
+    const int32 NumObjects = Objects.Num();
+    for (int32 Visited = 0; Visited < NumObjects && NumCompared < MaxObjects; ++Visited)
+    {
+        if (Cursor >= NumObjects)
+        {
+            Cursor = 0;
+        }
+        FTrackedObject& Tracked = Objects[Cursor++];
+
+        if (Now - Tracked.LastCompareTime < Interval)
+        {
+            continue;
+        }
+
+        UObject* Object = Tracked.Object.Get();
+        if (!Object)
+        {
+            StaleObjects.Add(Tracked.ObjectId);
+            continue;
+        }
+
+        Tracked.LastCompareTime = Now;
+        ++NumCompared;
+
+        const FSpacetimeDBShadowLayout& Layout = *Tracked.Layout;
+        const FSpacetimeDBClassDescriptor* ClassDescriptor = FSpacetimeDBPropertyDescriptorCache::GetClassDescriptor(Object->GetClass());
+        const uint8* ObjectBytes = reinterpret_cast<const uint8*>(Object);
+        uint8* ShadowBytes = Tracked.PodShadow.GetData();
+
+        for (const FSpacetimeDBShadowLayout::FSpan& Span : Layout.Spans)
+        {
+            // The common case: nothing in the span changed
+            if (FMemory::Memcmp(ObjectBytes + Span.ObjectOffset, ShadowBytes + Span.ShadowOffset, Span.Size) == 0)
+            {
+                continue;
+            }
+
+            for (int32 Index = Span.FirstProperty; Index < Span.FirstProperty + Span.NumProperties; ++Index)
+            {
+                const FSpacetimeDBShadowLayout::FPodProperty& PodProperty = Layout.PodProperties[Index];
+                if (FMemory::Memcmp(ObjectBytes + PodProperty.ObjectOffset, ShadowBytes + PodProperty.ShadowOffset, PodProperty.Size) != 0)
+                {
+                    OnChanged(Tracked.ObjectId, Object, ClassDescriptor->Properties[PodProperty.DescriptorIndex], nullptr, nullptr);
+                }
+            }
+
+            FMemory::Memcpy(ShadowBytes + Span.ShadowOffset, ObjectBytes + Span.ObjectOffset, Span.Size);
+        }
+
+        for (int32 Index = 0; Index < Layout.EncodedProperties.Num(); ++Index)
+        {
+            const FSpacetimeDBPropertyDescriptor& Descriptor = ClassDescriptor->Properties[Layout.EncodedProperties[Index]];
+
+            EncodeScratch.Reset();
+            FSpacetimeDBBinaryCodec::EncodeProperty(Descriptor, Object, EncodeScratch);
+
+            TArray<uint8>& Shadow = Tracked.EncodedShadow[Index];
+            if (Shadow.Num() != EncodeScratch.Num() || FMemory::Memcmp(Shadow.GetData(), EncodeScratch.GetData(), Shadow.Num()) != 0)
+            {
+                Swap(Shadow, EncodeScratch);
+                OnChanged(Tracked.ObjectId, Object, Descriptor, &EncodeScratch, &Shadow);
+            }
+        }
+    }
+
+    for (int64 ObjectId : StaleObjects)
+    {
+        Untrack(ObjectId);
+    }
+
+    return NumCompared;
+}
+
+TSharedRef<const FSpacetimeDBShadowLayout> FSpacetimeDBShadowState::FindOrBuildLayout(UClass* Class)
+{
+    if (const TSharedRef<const FSpacetimeDBShadowLayout>* Found = Layouts.Find(Class))
+    {
+        return *Found;
+    }
+    return Layouts.Add(Class, FSpacetimeDBShadowLayout::Build(Class));
+}
+
+void FSpacetimeDBShadowState::CaptureShadow(FTrackedObject& Tracked, const UObject* Object)
+{
+    const FSpacetimeDBShadowLayout& Layout = *Tracked.Layout;
+    const uint8* ObjectBytes = reinterpret_cast<const uint8*>(Object);
+
+    Tracked.PodShadow.SetNumUninitialized(Layout.ShadowSize);
+    for (const FSpacetimeDBShadowLayout::FSpan& Span : Layout.Spans)
+    {
+        FMemory::Memcpy(Tracked.PodShadow.GetData() + Span.ShadowOffset, ObjectBytes + Span.ObjectOffset, Span.Size);
+    }
+
+    const FSpacetimeDBClassDescriptor* ClassDescriptor = FSpacetimeDBPropertyDescriptorCache::GetClassDescriptor(Object->GetClass());
+    Tracked.EncodedShadow.SetNum(Layout.EncodedProperties.Num());
+    for (int32 Index = 0; Index < Layout.EncodedProperties.Num(); ++Index)
+    {
+        Tracked.EncodedShadow[Index].Reset();
+        FSpacetimeDBBinaryCodec::EncodeProperty(ClassDescriptor->Properties[Layout.EncodedProperties[Index]], Object, Tracked.EncodedShadow[Index]);
+    }
+}
+
+void FSpacetimeDBShadowState::RefreshAfterInvalidation()
+{
+    DescriptorGeneration = FSpacetimeDBPropertyDescriptorCache::GetGeneration();
+    Layouts.Reset();
+
+    // Offsets and descriptor indices may have moved; start over from the current values
+    for (int32 Index = Objects.Num() - 1; Index >= 0; --Index)
+    {
+        FTrackedObject& Tracked = Objects[Index];
+        UObject* Object = Tracked.Object.Get();
+        if (!Object)
+        {
+            Untrack(Tracked.ObjectId);
+            continue;
+        }
+
+        Tracked.Layout = FindOrBuildLayout(Object->GetClass());
+        if (Tracked.Layout->IsEmpty())
+        {
+            Untrack(Tracked.ObjectId);
+            continue;
+        }
+        CaptureShadow(Tracked, Object);
+    }
+}
@@ -0,0 +1,244 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBSnapshotCache.h"
+#include "SpacetimeDB_UnrealClient.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "SpacetimeDBSettings.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/SoftObjectPath.h"
+
+namespace
+{
+    /** "STDC" */
+    constexpr uint32 SnapshotCacheMagic = 0x43445453;
+    constexpr uint32 SnapshotCacheVersion = 1;
+
+    void WriteTransform(FSpacetimeDBBinaryWriter& Writer, const FTransform& Transform)
+    {
+        const FVector Location = Transform.GetLocation();
+        const FQuat Rotation = Transform.GetRotation();
+        const FVector Scale = Transform.GetScale3D();
+        Writer.WriteDouble(Location.X);
+        Writer.WriteDouble(Location.Y);
+        Writer.WriteDouble(Location.Z);
+        Writer.WriteDouble(Rotation.X);
+        Writer.WriteDouble(Rotation.Y);
+        Writer.WriteDouble(Rotation.Z);
+        Writer.WriteDouble(Rotation.W);
+        Writer.WriteDouble(Scale.X);
+        Writer.WriteDouble(Scale.Y);
+        Writer.WriteDouble(Scale.Z);
+    }
+
+    FTransform ReadTransform(FSpacetimeDBBinaryReader& Reader)
+    {
+        FVector Location;
+        FQuat Rotation;
+        FVector Scale;
+        Location.X = Reader.ReadDouble();
+        Location.Y = Reader.ReadDouble();
+        Location.Z = Reader.ReadDouble();
+        Rotation.X = Reader.ReadDouble();
+        Rotation.Y = Reader.ReadDouble();
+        Rotation.Z = Reader.ReadDouble();
+        Rotation.W = Reader.ReadDouble();
+        Scale.X = Reader.ReadDouble();
+        Scale.Y = Reader.ReadDouble();
+        Scale.Z = Reader.ReadDouble();
+        return FTransform(Rotation.GetNormalized(), Location, Scale);
+    }
+
+    /** Skips a run of bytes, returning it as a view into the reader's buffer */
+    TConstArrayView<uint8> ReadView(FSpacetimeDBBinaryReader& Reader, uint32 Length)
+    {
+        if (Reader.IsError() || Length > static_cast<uint32>(Reader.Size - Reader.Offset))
+        {
+            Reader.bError = true;
+            return TConstArrayView<uint8>();
+        }
+
+        const TConstArrayView<uint8> View(Reader.Data + Reader.Offset, static_cast<int32>(Length));
+        Reader.Offset += static_cast<int32>(Length);
+        return View;
+    }
+
+    /** Reads the records after the header; OutEntities is only complete when this returns true */
+    bool ReadEntities(FSpacetimeDBBinaryReader& Reader, const FString& FilePath, const TSharedRef<const FSpacetimeDBSnapshotCacheFile>& File,
+        TArray<FSpacetimeDBProxyEntity>& OutEntities)
+    {
+        const uint32 Magic = Reader.ReadUInt32();
+        const uint32 Version = Reader.ReadUInt32();
+        if (Reader.IsError() || Magic != SnapshotCacheMagic || Version != SnapshotCacheVersion)
+        {
+            UE_LOG(LogSpacetimeDB, Warning, TEXT("'%s' is not a snapshot cache of version %u"), *FilePath, SnapshotCacheVersion);
+            return false;
+        }
+
+        // Each record takes at least its fixed-size fields, which bounds a corrupt count
+        const uint32 NumEntities = Reader.ReadUInt32();
+        if (Reader.IsError() || NumEntities > static_cast<uint32>(Reader.Size - Reader.Offset))
+        {
+            UE_LOG(LogSpacetimeDB, Warning, TEXT("Snapshot cache '%s' is corrupt"), *FilePath);
+            return false;
+        }
+        OutEntities.Reserve(NumEntities);
+
+        // Most objects share a handful of classes, each resolved once; a miss is remembered as null
+        TMap<FString, UClass*> ClassesByPath;
+
+        int32 NumUnresolved = 0;
+        for (uint32 Index = 0; Index < NumEntities; ++Index)
+        {
+            FSpacetimeDBProxyEntity Entity;
+            Entity.ObjectId = Reader.ReadInt64();
+            const FString ClassPath = Reader.ReadString();
+            Entity.ClassName = Reader.ReadString();
+            Entity.Transform = ReadTransform(Reader);
+            Entity.OwnerClientId = Reader.ReadInt64();
+
+            // The bulky parts stay in the file until the proxy is edited or spawned
+            Entity.CachedDataJson = ReadView(Reader, Reader.ReadUInt32());
+            Entity.CachedProperties = ReadView(Reader, Reader.ReadUInt32());
+            if (Reader.IsError())
+            {
+                UE_LOG(LogSpacetimeDB, Warning, TEXT("Snapshot cache '%s' is corrupt"), *FilePath);
+                return false;
+            }
+            Entity.CacheFile = File;
+
+            // A class removed since the cache was written just leaves its objects to the server
+            UClass* const* CachedClass = ClassesByPath.Find(ClassPath);
+            Entity.ObjectClass = CachedClass ? *CachedClass : ClassesByPath.Add(ClassPath, FSoftClassPath(ClassPath).TryLoadClass<UObject>());
+            if (!Entity.ObjectClass.IsValid())
+            {
+                ++NumUnresolved;
+                continue;
+            }
+            OutEntities.Add(MoveTemp(Entity));
+        }
+
+        if (NumUnresolved > 0)
+        {
+            UE_LOG(LogSpacetimeDB, Verbose, TEXT("Left %d objects of unknown classes out of snapshot cache '%s'"), NumUnresolved, *FilePath);
+        }
+        return !Reader.IsError();
+    }
+}
+
+FSpacetimeDBSnapshotCacheFile::FSpacetimeDBSnapshotCacheFile() = default;
+
+FSpacetimeDBSnapshotCacheFile::~FSpacetimeDBSnapshotCacheFile() = default;
+
+FString FSpacetimeDBSnapshotCache::GetCachePath(const FString& Host, const FString& DatabaseName)
+{
+    const FString& Directory = USpacetimeDBSettings::Get()->SnapshotCacheDirectory;
+    const FString BaseDirectory = Directory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("SpacetimeDB") / TEXT("SnapshotCache") : Directory;
+    return BaseDirectory / FPaths::MakeValidFileName(Host + TEXT("_") + DatabaseName, TEXT('_')) + TEXT(".stdbcache");
+}
+
+bool FSpacetimeDBSnapshotCache::Save(const FString& FilePath, TConstArrayView<FSpacetimeDBProxyEntity> Entities)
+{
+    TArray<uint8> Bytes;
+    FSpacetimeDBBinaryWriter Writer(Bytes);
+    Writer.WriteUInt32(SnapshotCacheMagic);
+    Writer.WriteUInt32(SnapshotCacheVersion);
+
+    // Patched once the objects whose class is gone have been skipped
+    const int32 CountOffset = Bytes.Num();
+    Writer.WriteUInt32(0);
+
+    uint32 NumWritten = 0;
+    for (const FSpacetimeDBProxyEntity& Entity : Entities)
+    {
+        const UClass* ObjectClass = Entity.ObjectClass.Get();
+        if (!ObjectClass)
+        {
+            continue;
+        }
+
+        Writer.WriteInt64(Entity.ObjectId);
+        Writer.WriteString(ObjectClass->GetPathName());
+        Writer.WriteString(Entity.ClassName);
+        WriteTransform(Writer, Entity.Transform);
+        Writer.WriteInt64(Entity.OwnerClientId);
+
+        // A record still in a loaded cache is copied over as it is; it is UTF-8 already
+        if (Entity.CacheFile)
+        {
+            Writer.WriteUInt32(static_cast<uint32>(Entity.CachedDataJson.Num()));
+            Writer.WriteBytes(Entity.CachedDataJson.GetData(), Entity.CachedDataJson.Num());
+            Writer.WriteUInt32(static_cast<uint32>(Entity.CachedProperties.Num()));
+            Writer.WriteBytes(Entity.CachedProperties.GetData(), Entity.CachedProperties.Num());
+        }
+        else
+        {
+            Writer.WriteString(Entity.DataJson);
+            Writer.WriteUInt32(static_cast<uint32>(Entity.Properties.Num()));
+            Writer.WriteBytes(Entity.Properties.GetData(), Entity.Properties.Num());
+        }
+        ++NumWritten;
+    }
+    FMemory::Memcpy(Bytes.GetData() + CountOffset, &NumWritten, sizeof(NumWritten));
+
+    // Written beside the old file and moved over it, so a crash mid-write never leaves half a cache
+    const FString TempPath = FilePath + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*FilePath, *TempPath, true))
+    {
+        UE_LOG(LogSpacetimeDB, Error, TEXT("Could not write snapshot cache '%s'"), *FilePath);
+        IFileManager::Get().Delete(*TempPath, false, false, true);
+        return false;
+    }
+
+    UE_LOG(LogSpacetimeDB, Log, TEXT("Saved %u objects to snapshot cache '%s' (%d bytes)"), NumWritten, *FilePath, Bytes.Num());
+    return true;
+}
+
+bool FSpacetimeDBSnapshotCache::Load(const FString& FilePath, TArray<FSpacetimeDBProxyEntity>& OutEntities)
+{
+    OutEntities.Reset();
+
+    const TSharedRef<FSpacetimeDBSnapshotCacheFile> File = MakeShared<FSpacetimeDBSnapshotCacheFile>();
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    File->MappedFile.Reset(PlatformFile.OpenMapped(*FilePath));
+    File->MappedRegion.Reset(File->MappedFile.IsValid() ? File->MappedFile->MapRegion() : nullptr);
+
+    // Platforms without mapped files read the whole file instead
+    const uint8* Data = nullptr;
+    int64 Size = 0;
+    if (File->MappedRegion.IsValid())
+    {
+        Data = File->MappedRegion->GetMappedPtr();
+        Size = File->MappedRegion->GetMappedSize();
+    }
+    else
+    {
+        if (!PlatformFile.FileExists(*FilePath) || !FFileHelper::LoadFileToArray(File->FileBytes, *FilePath, FILEREAD_Silent))
+        {
+            return false;
+        }
+        Data = File->FileBytes.GetData();
+        Size = File->FileBytes.Num();
+    }
+
+    if (Size > MAX_int32)
+    {
+        UE_LOG(LogSpacetimeDB, Warning, TEXT("Snapshot cache '%s' is too large to load"), *FilePath);
+        return false;
+    }
+    File->Data = Data;
+    File->Size = static_cast<int32>(Size);
+
+    FSpacetimeDBBinaryReader Reader(Data, static_cast<int32>(Size));
+    if (!ReadEntities(Reader, FilePath, File, OutEntities))
+    {
+        OutEntities.Reset();
+        return false;
+    }
+
+    UE_LOG(LogSpacetimeDB, Log, TEXT("Loaded %d objects from snapshot cache '%s'"), OutEntities.Num(), *FilePath);
+    return true;
+}
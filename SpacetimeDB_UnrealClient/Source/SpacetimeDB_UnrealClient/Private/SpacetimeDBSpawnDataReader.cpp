@@ -0,0 +1,493 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBSpawnDataReader.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
+#include "SpacetimeDBPropertyHelper.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Misc/Optional.h"
+
+namespace
+{
+    typedef TJsonReader<TCHAR> FSpawnJsonReader;
+
+    /** Skips the value whose first token was just read */
+    bool SkipValue(FSpawnJsonReader& Reader, EJsonNotation Notation)
+    {
+        switch (Notation)
+        {
+        case EJsonNotation::ObjectStart:
+            return Reader.SkipObject();
+        case EJsonNotation::ArrayStart:
+            return Reader.SkipArray();
+        case EJsonNotation::Error:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    /** Builds an FJsonValue for the value whose first token was just read; the slow path for composite values */
+    TSharedPtr<FJsonValue> ReadJsonValue(FSpawnJsonReader& Reader, EJsonNotation Notation)
+    {
+        switch (Notation)
+        {
+        case EJsonNotation::String:
+            return MakeShared<FJsonValueString>(Reader.GetValueAsString());
+        case EJsonNotation::Number:
+            // Keep the literal so 64-bit integers survive the round trip
+            return MakeShared<FJsonValueNumberString>(Reader.GetValueAsNumberString());
+        case EJsonNotation::Boolean:
+            return MakeShared<FJsonValueBoolean>(Reader.GetValueAsBoolean());
+        case EJsonNotation::Null:
+            return MakeShared<FJsonValueNull>();
+        case EJsonNotation::ObjectStart:
+        {
+            TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+            EJsonNotation Child;
+            for (;;)
+            {
+                if (!Reader.ReadNext(Child))
+                {
+                    return nullptr;
+                }
+                if (Child == EJsonNotation::ObjectEnd)
+                {
+                    return MakeShared<FJsonValueObject>(Object);
+                }
+                const FString Key = Reader.GetIdentifier();
+                TSharedPtr<FJsonValue> Value = ReadJsonValue(Reader, Child);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                Object->SetField(Key, Value);
+            }
+        }
+        case EJsonNotation::ArrayStart:
+        {
+            TArray<TSharedPtr<FJsonValue>> Array;
+            EJsonNotation Child;
+            for (;;)
+            {
+                if (!Reader.ReadNext(Child))
+                {
+                    return nullptr;
+                }
+                if (Child == EJsonNotation::ArrayEnd)
+                {
+                    return MakeShared<FJsonValueArray>(Array);
+                }
+                TSharedPtr<FJsonValue> Value = ReadJsonValue(Reader, Child);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                Array.Add(Value);
+            }
+        }
+        default:
+            return nullptr;
+        }
+    }
+
+    /** Whether a JSON number literal is a plain integer that Atoi64 parses exactly */
+    bool IsPlainInteger(const FString& Literal)
+    {
+        for (const TCHAR Char : Literal)
+        {
+            if (Char == TEXT('.') || Char == TEXT('e') || Char == TEXT('E'))
+            {
+                return false;
+            }
+        }
+        return !Literal.IsEmpty();
+    }
+
+    /**
+     * Writes a scalar token straight into a property without building an FJsonValue.
+     * Mirrors the corresponding FSpacetimeDBPropertyHelper decoders.
+     *
+     * @return False if this property/token pair has no fast path; nothing is consumed in that case
+     */
+    bool TryApplyScalar(FProperty* Property, void* PropertyAddr, FSpawnJsonReader& Reader, EJsonNotation Notation)
+    {
+        switch (Notation)
+        {
+        case EJsonNotation::Boolean:
+            if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+            {
+                BoolProp->SetPropertyValue(PropertyAddr, Reader.GetValueAsBoolean());
+                return true;
+            }
+            break;
+
+        case EJsonNotation::Number:
+            if (FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
+            {
+                if (NumericProp->IsFloatingPoint())
+                {
+                    NumericProp->SetFloatingPointPropertyValue(PropertyAddr, Reader.GetValueAsNumber());
+                    return true;
+                }
+
+                // Unsigned 64-bit values may not fit Atoi64; let the helper decode them
+                const FString& Literal = Reader.GetValueAsNumberString();
+                if (!Property->IsA<FUInt64Property>() && IsPlainInteger(Literal))
+                {
+                    NumericProp->SetIntPropertyValue(PropertyAddr, FCString::Atoi64(*Literal));
+                    return true;
+                }
+            }
+            break;
+
+        case EJsonNotation::String:
+            if (FStrProperty* StrProp = CastField<FStrProperty>(Property))
+            {
+                StrProp->SetPropertyValue(PropertyAddr, Reader.GetValueAsString());
+                return true;
+            }
+            if (FNameProperty* NameProp = CastField<FNameProperty>(Property))
+            {
+                NameProp->SetPropertyValue(PropertyAddr, FName(*Reader.GetValueAsString()));
+                return true;
+            }
+            break;
+
+        default:
+            break;
+        }
+        return false;
+    }
+
+    /** Reads {"<X>": n, "<Y>": n, "<Z>": n} after its ObjectStart; missing components keep their current value */
+    bool ReadTriple(FSpawnJsonReader& Reader, const TCHAR* XKey, const TCHAR* YKey, const TCHAR* ZKey, double& X, double& Y, double& Z)
+    {
+        EJsonNotation Notation;
+        for (;;)
+        {
+            if (!Reader.ReadNext(Notation))
+            {
+                return false;
+            }
+            if (Notation == EJsonNotation::ObjectEnd)
+            {
+                return true;
+            }
+            if (Notation != EJsonNotation::Number)
+            {
+                if (!SkipValue(Reader, Notation))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            const FString& Key = Reader.GetIdentifier();
+            if (Key == XKey)
+            {
+                X = Reader.GetValueAsNumber();
+            }
+            else if (Key == YKey)
+            {
+                Y = Reader.GetValueAsNumber();
+            }
+            else if (Key == ZKey)
+            {
+                Z = Reader.GetValueAsNumber();
+            }
+        }
+    }
+
+    /** Reads the "transform" object after its ObjectStart */
+    bool ReadTransform(FSpawnJsonReader& Reader, FTransform& OutTransform)
+    {
+        EJsonNotation Notation;
+        for (;;)
+        {
+            if (!Reader.ReadNext(Notation))
+            {
+                return false;
+            }
+            if (Notation == EJsonNotation::ObjectEnd)
+            {
+                return true;
+            }
+
+            const FString Key = Reader.GetIdentifier();
+            if (Notation != EJsonNotation::ObjectStart)
+            {
+                if (!SkipValue(Reader, Notation))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            if (Key == TEXT("location"))
+            {
+                FVector Location = FVector::ZeroVector;
+                if (!ReadTriple(Reader, TEXT("x"), TEXT("y"), TEXT("z"), Location.X, Location.Y, Location.Z))
+                {
+                    return false;
+                }
+                OutTransform.SetLocation(Location);
+            }
+            else if (Key == TEXT("rotation"))
+            {
+                FRotator Rotation = FRotator::ZeroRotator;
+                if (!ReadTriple(Reader, TEXT("pitch"), TEXT("yaw"), TEXT("roll"), Rotation.Pitch, Rotation.Yaw, Rotation.Roll))
+                {
+                    return false;
+                }
+                OutTransform.SetRotation(Rotation.Quaternion());
+            }
+            else if (Key == TEXT("scale"))
+            {
+                FVector Scale = FVector::OneVector;
+                if (!ReadTriple(Reader, TEXT("x"), TEXT("y"), TEXT("z"), Scale.X, Scale.Y, Scale.Z))
+                {
+                    return false;
+                }
+                OutTransform.SetScale3D(Scale);
+            }
+            else if (!Reader.SkipObject())
+            {
+                return false;
+            }
+        }
+    }
+
+    /** Records the owner if this property token is "owner_client_id"; consumes nothing */
+    void ReadOwner(FSpawnJsonReader& Reader, EJsonNotation Notation, const FString& PropertyName, FSpacetimeDBSpawnSnapshot& OutSnapshot)
+    {
+        if (Notation == EJsonNotation::Number && PropertyName == TEXT("owner_client_id"))
+        {
+            OutSnapshot.OwnerClientId = FCString::Atoi64(*Reader.GetValueAsNumberString());
+        }
+    }
+
+    /** Reads the "properties" object after its ObjectStart, keeping only the owner */
+    bool PeekProperties(FSpawnJsonReader& Reader, FSpacetimeDBSpawnSnapshot& OutSnapshot)
+    {
+        EJsonNotation Notation;
+        for (;;)
+        {
+            if (!Reader.ReadNext(Notation))
+            {
+                return false;
+            }
+            if (Notation == EJsonNotation::ObjectEnd)
+            {
+                return true;
+            }
+
+            ReadOwner(Reader, Notation, Reader.GetIdentifier(), OutSnapshot);
+            if (!SkipValue(Reader, Notation))
+            {
+                return false;
+            }
+        }
+    }
+
+    /** A property value decoded on the side, starting as a copy of the current one so partial values keep the rest */
+    struct FScratchValue
+    {
+        FScratchValue(const FProperty* InProperty, const void* CurrentValue)
+            : Property(InProperty)
+            , Memory(FMemory::Malloc(InProperty->GetSize(), InProperty->GetMinAlignment()))
+        {
+            Property->InitializeValue(Memory);
+            Property->CopyCompleteValue(Memory, CurrentValue);
+        }
+
+        ~FScratchValue()
+        {
+            Property->DestroyValue(Memory);
+            FMemory::Free(Memory);
+        }
+
+        const FProperty* Property;
+        void* Memory;
+    };
+
+    /**
+     * Reads the "properties" object after its ObjectStart, writing each value into Target.
+     * With bOnlyChanged, values equal to the current ones are neither written nor notified.
+     */
+    bool ReadProperties(FSpawnJsonReader& Reader, UObject* Target, bool bFireRepNotify, bool bOnlyChanged, FSpacetimeDBSpawnSnapshot& OutSnapshot)
+    {
+        const FSpacetimeDBClassDescriptor* ClassDescriptor = FSpacetimeDBPropertyDescriptorCache::GetClassDescriptor(Target->GetClass());
+        TArray<const FSpacetimeDBPropertyDescriptor*, TInlineAllocator<16>> PendingNotifies;
+
+        EJsonNotation Notation;
+        for (;;)
+        {
+            if (!Reader.ReadNext(Notation))
+            {
+                return false;
+            }
+            if (Notation == EJsonNotation::ObjectEnd)
+            {
+                break;
+            }
+
+            // Copied: reading a composite value moves the reader's identifier on
+            const FString PropertyName = Reader.GetIdentifier();
+            ReadOwner(Reader, Notation, PropertyName, OutSnapshot);
+
+            const FSpacetimeDBPropertyDescriptor* Descriptor = ClassDescriptor ? ClassDescriptor->Find(FName(*PropertyName, FNAME_Find)) : nullptr;
+            if (!Descriptor)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSpawnDataReader: Property '%s' not found on object of class '%s'"),
+                    *PropertyName, *Target->GetClass()->GetName());
+                ++OutSnapshot.NumPropertiesFailed;
+                if (!SkipValue(Reader, Notation))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            void* PropertyAddr = Descriptor->GetValuePtr(Target);
+            TOptional<FScratchValue> Scratch;
+            if (bOnlyChanged)
+            {
+                Scratch.Emplace(Descriptor->Property, PropertyAddr);
+            }
+            void* WriteAddr = bOnlyChanged ? Scratch->Memory : PropertyAddr;
+            bool bApplied = TryApplyScalar(Descriptor->Property, WriteAddr, Reader, Notation);
+
+            if (!bApplied)
+            {
+                if (!Descriptor->JsonDecode)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSpawnDataReader: Unsupported property type for %s"), *PropertyName);
+                    ++OutSnapshot.NumPropertiesFailed;
+                    if (!SkipValue(Reader, Notation))
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+
+                TSharedPtr<FJsonValue> JsonValue = ReadJsonValue(Reader, Notation);
+                if (!JsonValue.IsValid())
+                {
+                    return false;
+                }
+                bApplied = Descriptor->JsonDecode(Descriptor->Property, WriteAddr, JsonValue);
+            }
+
+            if (bApplied && bOnlyChanged)
+            {
+                if (Descriptor->Property->Identical(WriteAddr, PropertyAddr))
+                {
+                    continue;
+                }
+                Descriptor->Property->CopyCompleteValue(PropertyAddr, WriteAddr);
+            }
+
+            if (bApplied)
+            {
+                ++OutSnapshot.NumPropertiesApplied;
+                if (bFireRepNotify && Descriptor->RepNotifyFunc)
+                {
+                    PendingNotifies.Add(Descriptor);
+                }
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSpawnDataReader: Failed to apply property '%s' to object of class '%s'"),
+                    *PropertyName, *Target->GetClass()->GetName());
+                ++OutSnapshot.NumPropertiesFailed;
+            }
+        }
+
+        // Notify only once the whole snapshot is in place
+        for (const FSpacetimeDBPropertyDescriptor* Descriptor : PendingNotifies)
+        {
+            FSpacetimeDBPropertyHelper::InvokeRepNotify(Target, *Descriptor);
+        }
+        return true;
+    }
+
+    /** Walks the top-level snapshot object; properties are only peeked at when Target is null */
+    bool ReadSnapshot(const FString& DataJson, UObject* Target, bool bFireRepNotify, bool bOnlyChanged, FSpacetimeDBSpawnSnapshot& OutSnapshot)
+    {
+        OutSnapshot = FSpacetimeDBSpawnSnapshot();
+
+        TSharedRef<FSpawnJsonReader> Reader = TJsonReaderFactory<TCHAR>::CreateFromView(DataJson);
+
+        EJsonNotation Notation;
+        if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+        {
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSpawnDataReader: Snapshot is not a JSON object: %s"), *DataJson);
+            return false;
+        }
+
+        for (;;)
+        {
+            if (!Reader->ReadNext(Notation))
+            {
+                break;
+            }
+            if (Notation == EJsonNotation::ObjectEnd)
+            {
+                return true;
+            }
+
+            const FString Key = Reader->GetIdentifier();
+            bool bOk = true;
+            if (Notation == EJsonNotation::ObjectStart && Key == TEXT("transform"))
+            {
+                OutSnapshot.bHasTransform = true;
+                bOk = ReadTransform(*Reader, OutSnapshot.Transform);
+            }
+            else if (Notation == EJsonNotation::ObjectStart && Key == TEXT("properties"))
+            {
+                bOk = Target ? ReadProperties(*Reader, Target, bFireRepNotify, bOnlyChanged, OutSnapshot) : PeekProperties(*Reader, OutSnapshot);
+            }
+            else
+            {
+                bOk = SkipValue(*Reader, Notation);
+            }
+
+            if (!bOk)
+            {
+                break;
+            }
+        }
+
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSpawnDataReader: Failed to parse snapshot JSON (%s): %s"), *Reader->GetErrorMessage(), *DataJson);
+        return false;
+    }
+}
+
+bool FSpacetimeDBSpawnDataReader::Read(const FString& DataJson, UObject* Target, bool bFireRepNotify, FSpacetimeDBSpawnSnapshot& OutSnapshot)
+{
+    if (!Target)
+    {
+        OutSnapshot = FSpacetimeDBSpawnSnapshot();
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSpawnDataReader: Cannot read snapshot into null object"));
+        return false;
+    }
+    return ReadSnapshot(DataJson, Target, bFireRepNotify, false, OutSnapshot);
+}
+
+bool FSpacetimeDBSpawnDataReader::Reconcile(const FString& DataJson, UObject* Target, FSpacetimeDBSpawnSnapshot& OutSnapshot)
+{
+    if (!Target)
+    {
+        OutSnapshot = FSpacetimeDBSpawnSnapshot();
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSpawnDataReader: Cannot reconcile snapshot with null object"));
+        return false;
+    }
+    return ReadSnapshot(DataJson, Target, true, true, OutSnapshot);
+}
+
+bool FSpacetimeDBSpawnDataReader::Peek(const FString& DataJson, FSpacetimeDBSpawnSnapshot& OutSnapshot)
+{
+    return ReadSnapshot(DataJson, nullptr, false, false, OutSnapshot);
+}
@@ -0,0 +1,69 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBStats.h"
+#include "UObject/Class.h"
+
+DEFINE_STAT(STAT_SpacetimeDB_FFICall);
+DEFINE_STAT(STAT_SpacetimeDB_ProcessInbound);
+DEFINE_STAT(STAT_SpacetimeDB_ApplyProperties);
+DEFINE_STAT(STAT_SpacetimeDB_Spawn);
+DEFINE_STAT(STAT_SpacetimeDB_RepNotify);
+DEFINE_STAT(STAT_SpacetimeDB_PredictionCorrection);
+DEFINE_STAT(STAT_SpacetimeDB_TransformConversion);
+
+DEFINE_STAT(STAT_SpacetimeDB_FFICallCount);
+DEFINE_STAT(STAT_SpacetimeDB_InboundQueueDepth);
+DEFINE_STAT(STAT_SpacetimeDB_InboundEvents);
+DEFINE_STAT(STAT_SpacetimeDB_BytesIn);
+DEFINE_STAT(STAT_SpacetimeDB_BytesOut);
+DEFINE_STAT(STAT_SpacetimeDB_PropertiesApplied);
+DEFINE_STAT(STAT_SpacetimeDB_ObjectsSpawned);
+DEFINE_STAT(STAT_SpacetimeDB_RepNotifies);
+DEFINE_STAT(STAT_SpacetimeDB_PredictionCorrections);
+DEFINE_STAT(STAT_SpacetimeDB_OutboundHeldBack);
+DEFINE_STAT(STAT_SpacetimeDB_UnreliableRpcsDropped);
+
+UE_TRACE_CHANNEL_DEFINE(SpacetimeDBChannel);
+
+FSpacetimeDBClassScope::FSpacetimeDBClassScope(const TCHAR* Prefix, const UClass* Class)
+#if STATS
+    : CycleCounter(Class ? GetStatId(Prefix, Class) : TStatId())
+#endif
+{
+#if CPUPROFILERTRACE_ENABLED
+    if (Class && UE_TRACE_CHANNELEXPR_IS_ENABLED(SpacetimeDBChannel) && UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel))
+    {
+        FCpuProfilerTrace::OutputBeginDynamicEvent(*FString::Printf(TEXT("%s %s"), Prefix, *Class->GetName()));
+        bTraceEvent = true;
+    }
+#endif
+}
+
+FSpacetimeDBClassScope::~FSpacetimeDBClassScope()
+{
+#if CPUPROFILERTRACE_ENABLED
+    if (bTraceEvent)
+    {
+        FCpuProfilerTrace::OutputEndEvent();
+    }
+#endif
+}
+
+#if STATS
+TStatId FSpacetimeDBClassScope::GetStatId(const TCHAR* Prefix, const UClass* Class)
+{
+    check(IsInGameThread());
+
+    // Keyed by name so a class reloaded at another address keeps its stat
+    static TMap<TPair<const TCHAR*, FName>, TStatId> StatIds;
+    const TPair<const TCHAR*, FName> Key(Prefix, Class->GetFName());
+    if (const TStatId* StatId = StatIds.Find(Key))
+    {
+        return *StatId;
+    }
+
+    const TStatId StatId = FDynamicStats::CreateStatId<FStatGroup_STATGROUP_SpacetimeDB>(FString::Printf(TEXT("%s %s"), Prefix, *Class->GetName()));
+    StatIds.Add(Key, StatId);
+    return StatId;
+}
+#endif
@@ -0,0 +1,192 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBSubscriptionManager.h"
+#include "SpacetimeDBClient.h"
+#include "SpacetimeDB_UnrealClient.h"
+
+FSpacetimeDBSubscriptionManager::FSpacetimeDBSubscriptionManager(FSpacetimeDBClient& InClient)
+    : Client(InClient)
+{
+}
+
+bool FSpacetimeDBSubscriptionManager::AddQueries(const TArray<FString>& InQueries)
+{
+    TArray<FString> Added;
+    for (const FString& Query : InQueries)
+    {
+        if (Query.IsEmpty())
+        {
+            continue;
+        }
+
+        FQueryState& State = Queries.FindOrAdd(Query);
+        if (++State.RefCount == 1)
+        {
+            Added.Add(Query);
+        }
+    }
+
+    if (Added.Num() == 0 || !Client.IsConnected())
+    {
+        // Already subscribed, or sent once the connection is up
+        return true;
+    }
+
+    return SendSubscribe(Added);
+}
+
+bool FSpacetimeDBSubscriptionManager::RemoveQueries(const TArray<FString>& InQueries)
+{
+    TArray<FString> Removed;
+    for (const FString& Query : InQueries)
+    {
+        FQueryState* State = Queries.Find(Query);
+        if (!State)
+        {
+            if (!Query.IsEmpty())
+            {
+                UE_LOG(LogSpacetimeDB, Warning, TEXT("SpacetimeDBSubscriptionManager: Releasing '%s', which holds no references"), *Query);
+            }
+            continue;
+        }
+
+        if (--State->RefCount <= 0)
+        {
+            if (State->bSent)
+            {
+                Removed.Add(Query);
+            }
+            Queries.Remove(Query);
+        }
+    }
+
+    if (Removed.Num() == 0 || !Client.IsConnected())
+    {
+        return true;
+    }
+
+    return Client.UnsubscribeFromTables(Removed);
+}
+
+bool FSpacetimeDBSubscriptionManager::SetQueries(FName Owner, const TArray<FString>& InQueries)
+{
+    TArray<FString> Wanted;
+    for (const FString& Query : InQueries)
+    {
+        Wanted.AddUnique(Query);
+    }
+
+    TArray<FString> Previous;
+    OwnerQueries.RemoveAndCopyValue(Owner, Previous);
+
+    TArray<FString> Added;
+    for (const FString& Query : Wanted)
+    {
+        if (!Previous.Contains(Query))
+        {
+            Added.Add(Query);
+        }
+    }
+
+    TArray<FString> Removed;
+    for (const FString& Query : Previous)
+    {
+        if (!Wanted.Contains(Query))
+        {
+            Removed.Add(Query);
+        }
+    }
+
+    if (Wanted.Num() > 0)
+    {
+        OwnerQueries.Add(Owner, MoveTemp(Wanted));
+    }
+
+    const bool bAdded = AddQueries(Added);
+    const bool bRemoved = RemoveQueries(Removed);
+    return bAdded && bRemoved;
+}
+
+int32 FSpacetimeDBSubscriptionManager::GetRefCount(const FString& Query) const
+{
+    const FQueryState* State = Queries.Find(Query);
+    return State ? State->RefCount : 0;
+}
+
+bool FSpacetimeDBSubscriptionManager::IsApplied(const FString& Query) const
+{
+    const FQueryState* State = Queries.Find(Query);
+    return State && State->bApplied;
+}
+
+bool FSpacetimeDBSubscriptionManager::AreAllApplied() const
+{
+    for (const TPair<FString, FQueryState>& Pair : Queries)
+    {
+        if (!Pair.Value.bApplied)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+TArray<FString> FSpacetimeDBSubscriptionManager::GetActiveQueries() const
+{
+    TArray<FString> Result;
+    Queries.GetKeys(Result);
+    return Result;
+}
+
+void FSpacetimeDBSubscriptionManager::HandleConnected()
+{
+    TArray<FString> Active;
+    for (TPair<FString, FQueryState>& Entry : Queries)
+    {
+        Entry.Value.bSent = false;
+        Entry.Value.bApplied = false;
+        Active.Add(Entry.Key);
+    }
+
+    if (Active.Num() > 0)
+    {
+        UE_LOG(LogSpacetimeDB, Log, TEXT("SpacetimeDBSubscriptionManager: Subscribing %d held queries on connect"), Active.Num());
+        SendSubscribe(Active);
+    }
+}
+
+void FSpacetimeDBSubscriptionManager::HandleDisconnected()
+{
+    for (TPair<FString, FQueryState>& Entry : Queries)
+    {
+        Entry.Value.bSent = false;
+        Entry.Value.bApplied = false;
+    }
+}
+
+void FSpacetimeDBSubscriptionManager::HandleApplied(const FString& Query)
+{
+    // Released before its rows arrived
+    FQueryState* State = Queries.Find(Query);
+    if (!State || !State->bSent)
+    {
+        return;
+    }
+
+    State->bApplied = true;
+    OnSubscriptionApplied.Broadcast(Query);
+}
+
+bool FSpacetimeDBSubscriptionManager::SendSubscribe(const TArray<FString>& Added)
+{
+    if (!Client.SubscribeToTables(Added))
+    {
+        return false;
+    }
+
+    for (const FString& Query : Added)
+    {
+        Queries.FindChecked(Query).bSent = true;
+    }
+    return true;
+}
@@ -4,6 +4,7 @@
 #include "Engine/Engine.h"
 #include "Async/Async.h"
 #include "SpacetimeDBFFI.h"
+#include "SpacetimeDBStats.h"
 #include "SpacetimeDBClient.h"
 #include "SpacetimeDB_PropertyValue.h"
 #include "Kismet/GameplayStatics.h"
@@ -12,23 +13,114 @@
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "SpacetimeDBPropertyHelper.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "SpacetimeDBSharedTypes.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
+#include "SpacetimeDBSpawnDataReader.h"
+#include "SpacetimeDBSnapshotCache.h"
+#include "SpacetimeDBPayloadDecoder.h"
+#include "SpacetimeDBClassRegistry.h"
+#include "SpacetimeDBSettings.h"
 #include "SpacetimeDB_JsonUtils.h"
 #include "SpacetimeDBPredictionComponent.h"
+#include "SpacetimeDBPredictionManager.h"
 #include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/GameInstance.h"
 
-#include "UObject/UObjectIterator.h"
+/** Heap order for queued object creations: lowest priority value first, then arrival order */
+struct FMaterializationOrder
+{
+    bool operator()(const FSpacetimeDBPendingMaterialization& A, const FSpacetimeDBPendingMaterialization& B) const
+    {
+        return A.Priority < B.Priority || (A.Priority == B.Priority && A.Sequence < B.Sequence);
+    }
+};
+
+/** Properties that hold the owning client ID; owner_id is the older name */
+static const FName OwnerClientIdPropertyName(TEXT("owner_client_id"));
+static const FName LegacyOwnerIdPropertyName(TEXT("owner_id"));
+
+/** Whether a property name is one of the owner properties */
+static bool IsOwnerProperty(const FString& PropertyName)
+{
+    return PropertyName == TEXT("owner_client_id") || PropertyName == TEXT("owner_id");
+}
+
+/** Parses a JSON owner property value; false if it isn't an integer */
+static bool ParseOwnerClientId(const FString& ValueJson, int64& OutOwnerClientId)
+{
+    return LexTryParseString(OutOwnerClientId, *ValueJson.TrimStartAndEnd());
+}
+
+/** Decodes a binary owner property value; false if it isn't an integer */
+static bool ParseOwnerClientId(const TArray<uint8>& Payload, int64& OutOwnerClientId)
+{
+    FSpacetimeDBCompactPropertyValue Value;
+    if (!FSpacetimeDBBinaryCodec::DecodePropertyValue(Payload.GetData(), Payload.Num(), Value))
+    {
+        return false;
+    }
+    
+    switch (Value.GetType())
+    {
+    case ESpacetimeDBPropertyType::Byte:   OutOwnerClientId = Value.GetByte(); return true;
+    case ESpacetimeDBPropertyType::Int32:  OutOwnerClientId = Value.GetInt32(); return true;
+    case ESpacetimeDBPropertyType::Int64:  OutOwnerClientId = Value.GetInt64(); return true;
+    case ESpacetimeDBPropertyType::UInt32: OutOwnerClientId = Value.GetUInt32(); return true;
+    case ESpacetimeDBPropertyType::UInt64: OutOwnerClientId = static_cast<int64>(Value.GetUInt64()); return true;
+    default: return false;
+    }
+}
 
-// Static map to store subsystem instances by world context
-static TMap<const UObject*, USpacetimeDBSubsystem*> GSubsystemInstances;
+/**
+ * Reads the owning client ID straight from an object's owner property.
+ *
+ * @return False if the class has no integer owner property
+ */
+static bool ReadOwnerProperty(const UObject* Object, int64& OutOwnerClientId)
+{
+    const FSpacetimeDBClassDescriptor* ClassDescriptor = FSpacetimeDBPropertyDescriptorCache::GetClassDescriptor(Object->GetClass());
+    if (!ClassDescriptor)
+    {
+        return false;
+    }
+    
+    const FSpacetimeDBPropertyDescriptor* Descriptor = ClassDescriptor->Find(OwnerClientIdPropertyName);
+    if (!Descriptor)
+    {
+        Descriptor = ClassDescriptor->Find(LegacyOwnerIdPropertyName);
+    }
+    
+    const FNumericProperty* NumericProp = Descriptor ? CastField<FNumericProperty>(Descriptor->Property) : nullptr;
+    if (!NumericProp || !NumericProp->IsInteger())
+    {
+        return false;
+    }
+    
+    OutOwnerClientId = NumericProp->GetSignedIntPropertyValue(Descriptor->GetValuePtr(Object));
+    return true;
+}
 
-// Add helper to find properties
-FProperty* FindPropertyByName(UClass* Class, FName PropertyName)
+/**
+ * Finds the settings entry for the most derived listed class in Class's hierarchy. Entries are
+ * matched by path, since a listed class that isn't loaded yet has no pointer to compare and the
+ * callers cache a miss.
+ */
+template <typename KeyType, typename ValueType>
+static const ValueType* FindClassSetting(const TMap<TSoftClassPtr<KeyType>, ValueType>& ClassSettings, const UClass* Class)
 {
-    for (TFieldIterator<FProperty> It(Class); It; ++It)
+    for (const UClass* Current = Class; Current && ClassSettings.Num() > 0; Current = Current->GetSuperClass())
     {
-        if (It->GetFName() == PropertyName)
+        const FSoftObjectPath CurrentPath(Current);
+        for (const TPair<TSoftClassPtr<KeyType>, ValueType>& Entry : ClassSettings)
         {
-            return *It;
+            if (Entry.Key.ToSoftObjectPath() == CurrentPath)
+            {
+                return &Entry.Value;
+            }
         }
     }
     return nullptr;
@@ -56,29 +148,42 @@ void USpacetimeDBSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Initializing"));
     
-    // Store reference to this instance by GetWorld()
-    GSubsystemInstances.Add(GetGameInstance(), this);
+    // Objects and component events of the client's connection are this subsystem's
+    Client.SetOwner(this);
     
     // Register for client events
     OnConnectedHandle = Client.OnConnected.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleConnected);
     OnDisconnectedHandle = Client.OnDisconnected.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleDisconnected);
+    OnReconnectingHandle = Client.OnReconnecting.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleReconnecting);
+    OnReconnectFailedHandle = Client.OnReconnectFailed.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleReconnectFailed);
     OnIdentityReceivedHandle = Client.OnIdentityReceived.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleIdentityReceived);
     OnEventReceivedHandle = Client.OnEventReceived.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleEventReceived);
     OnErrorOccurredHandle = Client.OnErrorOccurred.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleErrorOccurred);
     
     // Register for object system events
     OnPropertyUpdatedHandle = Client.OnPropertyUpdated.AddUObject(this, &USpacetimeDBSubsystem::InternalHandlePropertyUpdated);
+    OnPropertyUpdatedBinaryHandle = Client.OnPropertyUpdatedBinary.AddUObject(this, &USpacetimeDBSubsystem::InternalHandlePropertyUpdatedBinary);
+    OnPropertyUpdatedBinaryByIdHandle = Client.OnPropertyUpdatedBinaryById.AddUObject(this, &USpacetimeDBSubsystem::InternalHandlePropertyUpdatedBinaryById);
+    OnClientRpcBinaryHandle = Client.OnClientRpcBinary.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleClientRpcBinary);
     OnObjectCreatedHandle = Client.OnObjectCreated.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleObjectCreated);
+    OnObjectCreatedByClassIdHandle = Client.OnObjectCreatedByClassId.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleObjectCreatedByClassId);
     OnObjectDestroyedHandle = Client.OnObjectDestroyed.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleObjectDestroyed);
     OnObjectIdRemappedHandle = Client.OnObjectIdRemapped.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleObjectIdRemapped);
+    OnSubscriptionAppliedHandle = Client.GetSubscriptions().OnSubscriptionApplied.AddUObject(this, &USpacetimeDBSubsystem::InternalHandleSubscriptionApplied);
+    
+    for (const FSpacetimeDBCachedTable& Table : USpacetimeDBSettings::Get()->CachedTables)
+    {
+        TableCache.DeclareTable(Table.TableName, Table.PrimaryKey, Table.Indexes);
+    }
 }
 
 void USpacetimeDBSubsystem::Deinitialize()
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Deinitializing"));
     
-    // Remove this instance from the global map
-    GSubsystemInstances.Remove(GetGameInstance());
+    // Nothing may feed the client or write the capture past this point
+    Client.StopReplay();
+    Client.StopRecording();
     
     // Disconnect if still connected
     if (IsConnected())
@@ -86,6 +191,38 @@ void USpacetimeDBSubsystem::Deinitialize()
         Disconnect();
     }
     
+    // Anything still staged belongs to objects that are about to go away
+    PendingPropertyUpdates.Reset();
+    PendingPropertyUpdateIndex.Reset();
+    DirtyPropertyUpdates.Reset();
+    DirtyPropertyUpdateIndex.Reset();
+    LastPropertyFlushTime.Reset();
+    LastPropertyResyncRequest.Reset();
+    PendingPredictedTransforms.Reset();
+    PendingPredictedTransformIndex.Reset();
+    SentPredictedTransforms.Reset();
+    PendingUnreliableRpcs.Reset();
+    PendingUnreliableRpcIndex.Reset();
+    OutboundScheduler.Reset();
+    OutboundReleasedObjects.Reset();
+    TransformTargets.Reset();
+    InterestGrid.Reset();
+    AutoReplication.Reset();
+    
+    // Parked actors belong to the world and are destroyed with it
+    ActorPool.Reset();
+    
+    // Queued creations and proxies will never spawn
+    Proxies.Reset();
+    PendingMaterializations.Reset();
+    PendingMaterializationSequence.Reset();
+    MaterializationPropertyUpdates.Reset();
+    MaterializationPropertyUpdateIndex.Reset();
+    UnconfirmedObjects.Reset();
+    bReconcilingObjects = false;
+    bHasConnectedBefore = false;
+    bLoadedSnapshotCache = false;
+    
     // Unregister from client events
     if (OnConnectedHandle.IsValid())
     {
@@ -99,6 +236,18 @@ void USpacetimeDBSubsystem::Deinitialize()
         OnDisconnectedHandle.Reset();
     }
     
+    if (OnReconnectingHandle.IsValid())
+    {
+        Client.OnReconnecting.Remove(OnReconnectingHandle);
+        OnReconnectingHandle.Reset();
+    }
+    
+    if (OnReconnectFailedHandle.IsValid())
+    {
+        Client.OnReconnectFailed.Remove(OnReconnectFailedHandle);
+        OnReconnectFailedHandle.Reset();
+    }
+    
     if (OnIdentityReceivedHandle.IsValid())
     {
         Client.OnIdentityReceived.Remove(OnIdentityReceivedHandle);
@@ -124,12 +273,36 @@ void USpacetimeDBSubsystem::Deinitialize()
         OnPropertyUpdatedHandle.Reset();
     }
     
+    if (OnPropertyUpdatedBinaryHandle.IsValid())
+    {
+        Client.OnPropertyUpdatedBinary.Remove(OnPropertyUpdatedBinaryHandle);
+        OnPropertyUpdatedBinaryHandle.Reset();
+    }
+    
+    if (OnPropertyUpdatedBinaryByIdHandle.IsValid())
+    {
+        Client.OnPropertyUpdatedBinaryById.Remove(OnPropertyUpdatedBinaryByIdHandle);
+        OnPropertyUpdatedBinaryByIdHandle.Reset();
+    }
+    
+    if (OnClientRpcBinaryHandle.IsValid())
+    {
+        Client.OnClientRpcBinary.Remove(OnClientRpcBinaryHandle);
+        OnClientRpcBinaryHandle.Reset();
+    }
+    
     if (OnObjectCreatedHandle.IsValid())
     {
         Client.OnObjectCreated.Remove(OnObjectCreatedHandle);
         OnObjectCreatedHandle.Reset();
     }
     
+    if (OnObjectCreatedByClassIdHandle.IsValid())
+    {
+        Client.OnObjectCreatedByClassId.Remove(OnObjectCreatedByClassIdHandle);
+        OnObjectCreatedByClassIdHandle.Reset();
+    }
+    
     if (OnObjectDestroyedHandle.IsValid())
     {
         Client.OnObjectDestroyed.Remove(OnObjectDestroyedHandle);
@@ -142,26 +315,259 @@ void USpacetimeDBSubsystem::Deinitialize()
         OnObjectIdRemappedHandle.Reset();
     }
     
+    if (OnSubscriptionAppliedHandle.IsValid())
+    {
+        Client.GetSubscriptions().OnSubscriptionApplied.Remove(OnSubscriptionAppliedHandle);
+        OnSubscriptionAppliedHandle.Reset();
+    }
+    
+    Client.SetOwner(nullptr);
+    
     Super::Deinitialize();
 }
 
+void USpacetimeDBSubsystem::Tick(float DeltaTime)
+{
+    {
+        // Everything applied until the end of this scope notifies together
+        FSpacetimeDBScopedRepNotifyBatch NotifyBatch(USpacetimeDBSettings::Get()->bBatchRepNotifies);
+        
+        // Dispatch the events the FFI callbacks queued since last frame, within the frame budget
+        const double TimeBudgetSeconds = USpacetimeDBSettings::Get()->InboundEventTimeBudgetMs / 1000.0;
+        Client.ProcessInboundEvents(TimeBudgetSeconds);
+        
+        // Follow the local pawn with the cell subscriptions before anything new spawns
+        UpdateInterest();
+        
+        // Swap actors and proxies that crossed the relevance range
+        UpdateProxyRelevance();
+        
+        // Spawn the next slice of queued server objects
+        MaterializePendingObjects(USpacetimeDBSettings::Get()->ObjectMaterializationTimeBudgetMs / 1000.0);
+        
+        // Apply the property values that arrived during this drain as one batch
+        FlushPendingPropertyUpdates();
+        
+        // The materialization slice and the flush decode into the arena after the drain released it
+        Client.GetFrameArena().Reset();
+    }
+    
+    // Stage the replicated properties that changed on auto-replicated objects
+    UpdateAutoReplication();
+    
+    // Pick the objects whose unreliable traffic fits in this frame's uplink budget
+    ScheduleOutboundTraffic(DeltaTime);
+    
+    // Send the properties gameplay code changed this frame
+    FlushDirtyPropertyUpdates();
+    
+    // Send this frame's predicted transforms as one message
+    FlushPredictedTransforms();
+    
+    // Send the unreliable RPCs called this frame
+    FlushUnreliableRpcs();
+    
+    // Submit the reducer calls queued this frame, in call order
+    Client.FlushReducerCalls();
+}
+
+TStatId USpacetimeDBSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USpacetimeDBSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType USpacetimeDBSubsystem::GetTickableTickType() const
+{
+    // The class default object must never tick
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+FSpacetimeDBEventQueueStats USpacetimeDBSubsystem::GetInboundQueueStats() const
+{
+    FSpacetimeDBEventQueueStats Stats = Client.GetInboundQueueStats();
+    Stats.TotalCoalescedPropertyUpdates = TotalCoalescedPropertyUpdates;
+    return Stats;
+}
+
+TArray<FSpacetimeDBTrafficStats> USpacetimeDBSubsystem::GetTrafficStats() const
+{
+    TArray<FSpacetimeDBTrafficStats> Stats;
+    Client.GetTrafficStats(Stats);
+    return Stats;
+}
+
+bool USpacetimeDBSubsystem::StartEventRecording(const FString& FilePath)
+{
+    return Client.StartRecording(FilePath);
+}
+
+void USpacetimeDBSubsystem::StopEventRecording()
+{
+    Client.StopRecording();
+}
+
+bool USpacetimeDBSubsystem::StartEventReplay(const FString& FilePath, bool bAsFastAsPossible)
+{
+    return Client.StartReplay(FilePath, bAsFastAsPossible);
+}
+
+void USpacetimeDBSubsystem::StopEventReplay()
+{
+    Client.StopReplay();
+}
+
+FSpacetimeDBReplayStats USpacetimeDBSubsystem::GetEventReplayStats() const
+{
+    return Client.GetReplayStats();
+}
+
+TArray<FSpacetimeDBErrorCounter> USpacetimeDBSubsystem::GetErrorCounters() const
+{
+    TArray<FSpacetimeDBErrorCounter> Counters;
+    FSpacetimeDBErrorHandler::GetErrorCounters(Counters);
+    return Counters;
+}
+
+int32 USpacetimeDBSubsystem::GetPendingMaterializationCount() const
+{
+    return PendingMaterializationSequence.Num();
+}
+
+void USpacetimeDBSubsystem::SetMaterializationPriority(const FSpacetimeDBMaterializationPriority& InPriority)
+{
+    MaterializationPriority = InPriority;
+    
+    // Re-prioritize what is already queued
+    if (PendingMaterializations.Num() > 0)
+    {
+        const APawn* ViewPawn = GetLocalPawn();
+        for (FSpacetimeDBPendingMaterialization& Entry : PendingMaterializations)
+        {
+            Entry.Priority = GetMaterializationPriority(Entry, ViewPawn);
+        }
+        PendingMaterializations.Heapify(FMaterializationOrder());
+        MaterializationViewPawn = ViewPawn;
+    }
+}
+
 bool USpacetimeDBSubsystem::Connect(const FString& Host, const FString& DatabaseName, const FString& AuthToken)
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Connect(%s, %s, %s)"), *Host, *DatabaseName, AuthToken.IsEmpty() ? TEXT("<empty>") : TEXT("<token>"));
-    return Client.Connect(Host, DatabaseName, AuthToken);
+    if (!Client.Connect(Host, DatabaseName, AuthToken))
+    {
+        return false;
+    }
+    
+    // The connection completes on a later frame, so the cached world is in place before any row arrives
+    SnapshotCachePath = USpacetimeDBSettings::Get()->bEnableSnapshotCache ? FSpacetimeDBSnapshotCache::GetCachePath(Host, DatabaseName) : FString();
+    LoadSnapshotCache();
+    return true;
 }
 
 bool USpacetimeDBSubsystem::Disconnect()
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Disconnect()"));
+    
+    if (IsConnected())
+    {
+        SaveSnapshotCache();
+    }
     return Client.Disconnect();
 }
 
+bool USpacetimeDBSubsystem::SaveSnapshotCache()
+{
+    if (SnapshotCachePath.IsEmpty() || !IsConnected())
+    {
+        return false;
+    }
+    
+    // The file about to be replaced can't stay mapped under the proxies loaded from it
+    Proxies.DetachAllFromCache();
+    
+    // Everything in the proxy layout: proxies as they are, spawned objects captured like a demotion, queued creations by their snapshot
+    TArray<FSpacetimeDBProxyEntity> Entities(Proxies.GetEntities());
+    for (const TPair<int64, UObject*>& Pair : ObjectRegistry)
+    {
+        UObject* Object = Pair.Value;
+        if (!IsValid(Object) || Object->IsA<UActorComponent>())
+        {
+            continue;
+        }
+        
+        FSpacetimeDBProxyEntity& Entity = Entities.AddDefaulted_GetRef();
+        Entity.ObjectId = Pair.Key;
+        Entity.ObjectClass = Object->GetClass();
+        Entity.OwnerClientId = GetOwnerClientId(Pair.Key);
+        if (const AActor* Actor = Cast<AActor>(Object))
+        {
+            Entity.Transform = Actor->GetActorTransform();
+        }
+        FSpacetimeDBProxyStore::CaptureProperties(Entity, Object);
+    }
+    for (const FSpacetimeDBPendingMaterialization& Pending : PendingMaterializations)
+    {
+        FSpacetimeDBProxyEntity& Entity = Entities.AddDefaulted_GetRef();
+        Entity.ObjectId = Pending.ObjectId;
+        Entity.ObjectClass = Pending.ObjectClass;
+        Entity.ClassName = Pending.ClassName;
+        Entity.Transform = Pending.Snapshot.Transform;
+        Entity.OwnerClientId = Pending.Snapshot.OwnerClientId;
+        Entity.DataJson = Pending.DataJson;
+    }
+    
+    // A world already torn down would only wipe the cache of the last one
+    if (Entities.Num() == 0)
+    {
+        return false;
+    }
+    return FSpacetimeDBSnapshotCache::Save(SnapshotCachePath, Entities);
+}
+
+void USpacetimeDBSubsystem::LoadSnapshotCache()
+{
+    // Only for a fresh join; objects already here are reconciled on connect instead
+    if (SnapshotCachePath.IsEmpty() || ObjectRegistry.Num() > 0 || Proxies.Num() > 0 || PendingMaterializations.Num() > 0)
+    {
+        return;
+    }
+    
+    TArray<FSpacetimeDBProxyEntity> Entities;
+    if (!FSpacetimeDBSnapshotCache::Load(SnapshotCachePath, Entities))
+    {
+        return;
+    }
+    
+    // The cached objects wait for the first connection's rows to confirm them
+    bLoadedSnapshotCache = Entities.Num() > 0;
+    
+    // Proxies spawn as they come into relevance, or all of them on the next tick when proxies are off
+    for (FSpacetimeDBProxyEntity& Entity : Entities)
+    {
+        const int64 ObjectId = Entity.ObjectId;
+        const bool bIsActor = Entity.ObjectClass->IsChildOf(AActor::StaticClass());
+        Proxies.Add(ObjectId) = MoveTemp(Entity);
+        
+        // Without a transform there is nothing to measure relevance by
+        if (!bIsActor)
+        {
+            PromoteProxy(ObjectId);
+        }
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Loaded %d objects from the snapshot cache, %d of them as proxies"), Entities.Num(), Proxies.Num());
+}
+
 bool USpacetimeDBSubsystem::IsConnected() const
 {
     return Client.IsConnected();
 }
 
+bool USpacetimeDBSubsystem::IsReconnecting() const
+{
+    return Client.IsReconnecting();
+}
+
 int64 USpacetimeDBSubsystem::GetSpacetimeDBClientID() const
 {
     if (!IsConnected())
@@ -207,7 +613,18 @@ bool USpacetimeDBSubsystem::SubscribeToTables(const TArray<FString>& TableNames)
         UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SubscribeToTables() called with empty list"));
     }
     
-    return Client.SubscribeToTables(TableNames);
+    return Client.GetSubscriptions().AddQueries(TableNames);
+}
+
+bool USpacetimeDBSubsystem::UnsubscribeFromTables(const TArray<FString>& TableNames)
+{
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: UnsubscribeFromTables(%s)"), *FString::Join(TableNames, TEXT(", ")));
+    return Client.GetSubscriptions().RemoveQueries(TableNames);
+}
+
+bool USpacetimeDBSubsystem::IsSubscriptionApplied(const FString& Query) const
+{
+    return Client.GetSubscriptions().IsApplied(Query);
 }
 
 FString USpacetimeDBSubsystem::GetClientIdentity() const
@@ -220,6 +637,50 @@ FString USpacetimeDBSubsystem::GetClientIdentity() const
 void USpacetimeDBSubsystem::InternalHandleConnected()
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Connected event received"));
+    
+    // A new connection has no previous transforms for the quantized records to be relative to
+    SentPredictedTransforms.Reset();
+    
+    // The server only routes typed RPCs to the IDs this connection announced
+    Client.SelectConnection();
+    for (const TPair<uint32, FString>& Function : TypedClientRpcNames)
+    {
+        register_client_function_id(Function.Key, TCHAR_TO_UTF8(*Function.Value));
+    }
+    
+    // Objects from the last connection or the snapshot cache stay until the subscribed rows confirm or drop them,
+    // whether the queries are resubscribed or only requested once connected. Components are left alone; they come
+    // and go with their own events. On a first connection without a cache everything here arrived on it already.
+    const bool bKeptObjects = bHasConnectedBefore || bLoadedSnapshotCache;
+    bHasConnectedBefore = true;
+    bLoadedSnapshotCache = false;
+    
+    UnconfirmedObjects.Reset();
+    if (bKeptObjects)
+    {
+        for (const TPair<int64, UObject*>& Pair : ObjectRegistry)
+        {
+            if (IsValid(Pair.Value) && !Pair.Value->IsA<UActorComponent>())
+            {
+                UnconfirmedObjects.Add(Pair.Key);
+            }
+        }
+        for (const FSpacetimeDBProxyEntity& Proxy : Proxies.GetEntities())
+        {
+            UnconfirmedObjects.Add(Proxy.ObjectId);
+        }
+        for (const TPair<int64, uint64>& Pending : PendingMaterializationSequence)
+        {
+            UnconfirmedObjects.Add(Pending.Key);
+        }
+    }
+    bReconcilingObjects = UnconfirmedObjects.Num() > 0;
+    
+    if (bReconcilingObjects)
+    {
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Reconciling %d objects kept from the last connection"), UnconfirmedObjects.Num());
+    }
+    
     OnConnected.Broadcast();
     
     // Optional: Display a notification in game if desired
@@ -232,6 +693,10 @@ void USpacetimeDBSubsystem::InternalHandleConnected()
 void USpacetimeDBSubsystem::InternalHandleDisconnected(const FString& Reason)
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Disconnected event received: %s"), *Reason);
+    
+    // The rows come back with the subscriptions on reconnect
+    TableCache.ClearRows();
+    
     OnDisconnected.Broadcast(Reason);
     
     // Optional: Display a notification in game if desired
@@ -241,15 +706,57 @@ void USpacetimeDBSubsystem::InternalHandleDisconnected(const FString& Reason)
     }
 }
 
+void USpacetimeDBSubsystem::InternalHandleReconnecting(int32 Attempt, float DelaySeconds)
+{
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Reconnecting in %.1fs (attempt %d)"), DelaySeconds, Attempt);
+    OnReconnecting.Broadcast(Attempt, DelaySeconds);
+}
+
+void USpacetimeDBSubsystem::InternalHandleReconnectFailed()
+{
+    UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Could not reconnect to SpacetimeDB"));
+    OnReconnectFailed.Broadcast();
+}
+
 void USpacetimeDBSubsystem::InternalHandleIdentityReceived(const FString& Identity)
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Identity received: %s"), *Identity);
     OnIdentityReceived.Broadcast(Identity);
 }
 
+void USpacetimeDBSubsystem::InternalHandleSubscriptionApplied(const FString& Query)
+{
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Subscription applied: %s"), *Query);
+    
+    // Every resubscribed row has arrived, so whatever wasn't in them is gone on the server
+    if (bReconcilingObjects && Client.GetSubscriptions().AreAllApplied())
+    {
+        FinishReconciliation();
+    }
+    
+    OnSubscriptionApplied.Broadcast(Query);
+}
+
 void USpacetimeDBSubsystem::InternalHandleEventReceived(const FString& TableName, const FString& EventData)
 {
     UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Event received for table %s: %s"), *TableName, *EventData);
+    
+    // Class rows extend the class ID table used to resolve spawns
+    if (TableName == TEXT("object_class"))
+    {
+        TSharedPtr<FJsonObject> Row;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(EventData);
+        int32 ClassId = 0;
+        FString ClassPath;
+        if (FJsonSerializer::Deserialize(Reader, Row) && Row.IsValid()
+            && Row->TryGetNumberField(TEXT("class_id"), ClassId) && Row->TryGetStringField(TEXT("class_path"), ClassPath))
+        {
+            FSpacetimeDBClassRegistry::RegisterClassId(ClassId, ClassPath);
+        }
+    }
+    
+    TableCache.ApplyEvent(TableName, EventData);
+    
     OnEventReceived.Broadcast(TableName, EventData);
 }
 
@@ -275,28 +782,72 @@ void USpacetimeDBSubsystem::HandlePropertyUpdated(uint64 ObjectId, const FString
 
 void USpacetimeDBSubsystem::InternalHandlePropertyUpdated(uint64 ObjectId, const FString& PropertyName, const FString& ValueJson)
 {
-    // Delegate to the main property update handler
-    InternalOnPropertyUpdated(static_cast<int64>(ObjectId), PropertyName, ValueJson);
+    // The value may already have been parsed on the network thread
+    const FSpacetimeDBDecodedPayload* Decoded = Client.GetDispatchingPayload();
+    const FSpacetimeDBDecodedScalar* Scalar = (Decoded && Decoded->Scalar.IsSet()) ? &Decoded->Scalar : nullptr;
+    
+    // Proxies keep the value until they are promoted
+    if (StoreProxyProperty(static_cast<int64>(ObjectId), PropertyName, ValueJson))
+    {
+        return;
+    }
+    
+    // Objects still waiting to spawn get their updates once they exist
+    if (PendingMaterializationSequence.Contains(static_cast<int64>(ObjectId)))
+    {
+        FSpacetimeDBPendingPropertyUpdate Update;
+        Update.PropertyName = PropertyName;
+        Update.ValueJson = ValueJson;
+        if (Scalar)
+        {
+            Update.Scalar = *Scalar;
+        }
+        BufferMaterializationPropertyUpdate(static_cast<int64>(ObjectId), Update);
+        return;
+    }
+    
+    if (!USpacetimeDBSettings::Get()->bCoalescePropertyUpdates)
+    {
+        // Delegate to the main property update handler
+        InternalOnPropertyUpdated(static_cast<int64>(ObjectId), PropertyName, ValueJson, Scalar);
+        return;
+    }
+    
+    FSpacetimeDBPendingPropertyUpdate Update;
+    Update.PropertyName = PropertyName;
+    Update.ValueJson = ValueJson;
+    if (Scalar)
+    {
+        Update.Scalar = *Scalar;
+    }
+    QueuePropertyUpdate(static_cast<int64>(ObjectId), MoveTemp(Update));
 }
 
 void USpacetimeDBSubsystem::HandleObjectCreated(uint64 ObjectId, const FString& ClassName, const FString& DataJson)
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Object created event - ID: %llu, Class: %s"), ObjectId, *ClassName);
     
-    // Create the object
-    UObject* NewObject = SpawnObjectFromServer(ObjectId, ClassName, DataJson);
-    
-    if (NewObject)
+    UClass* ObjectClass = FSpacetimeDBClassRegistry::FindClassByName(ClassName);
+    if (!ObjectClass)
     {
-        // Broadcast the object created event
-        OnObjectCreated.Broadcast(ObjectId, ClassName, DataJson);
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Could not find class '%s'"), *ClassName);
+        return;
     }
+    
+    // Create the object once its turn comes
+    QueueMaterialization(static_cast<int64>(ObjectId), ObjectClass, ClassName, DataJson);
 }
 
 void USpacetimeDBSubsystem::HandleObjectDestroyed(uint64 ObjectId)
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Object destroyed event - ID: %llu"), ObjectId);
     
+    // An object that never spawned, or is only a proxy now, was never announced either
+    if (CancelMaterialization(static_cast<int64>(ObjectId)) || Proxies.Remove(static_cast<int64>(ObjectId)))
+    {
+        return;
+    }
+    
     // Broadcast the object destroyed event before actually destroying it
     OnObjectDestroyed.Broadcast(ObjectId);
     
@@ -314,7 +865,7 @@ void USpacetimeDBSubsystem::HandleObjectIdRemapped(uint64 TempId, uint64 ServerI
     // TODO: Implement ID remapping in the object registry
 }
 
-void USpacetimeDBSubsystem::InternalOnPropertyUpdated(int64 ObjectId, const FString& PropertyName, const FString& ValueJson)
+void USpacetimeDBSubsystem::InternalOnPropertyUpdated(int64 ObjectId, const FString& PropertyName, const FString& ValueJson, const FSpacetimeDBDecodedScalar* Scalar)
 {
     // Use Verbose log level since this could be high frequency
     UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Property updated - Object %llu, Property %s"), ObjectId, *PropertyName);
@@ -329,19 +880,159 @@ void USpacetimeDBSubsystem::InternalOnPropertyUpdated(int64 ObjectId, const FStr
     UpdateInfo.PropertyName = PropertyName;
     UpdateInfo.RawJsonValue = ValueJson;
     
-    // Parse the JSON value into a proper FSpacetimeDBPropertyValue
-    // This would use the existing PropertyValue parsing system
-    UpdateInfo.PropertyValue = FSpacetimeDBPropertyValue::FromJsonString(ValueJson);
+    // Only listeners need the decoded value, so skip the DOM parse when there are none
+    if (OnPropertyUpdated.IsBound())
+    {
+        UpdateInfo.PropertyValue = FSpacetimeDBPropertyValue::FromJsonString(ValueJson);
+    }
     
     if (Object)
     {
-        // Apply the property to the object using our property helper
-        bool bSuccess = FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Object, PropertyName, ValueJson);
+        SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_ApplyProperties);
+        FSpacetimeDBClassScope ClassScope(TEXT("Apply"), Object->GetClass());
+        INC_DWORD_STAT(STAT_SpacetimeDB_PropertiesApplied);
+        bool bSuccess = false;
         
-        if (bSuccess)
+        // A value decoded on the network thread only needs writing
+        if (Scalar && Scalar->IsSet())
         {
-            UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Successfully applied property %s to object %s (ID: %llu)"), 
-                *PropertyName, *Object->GetName(), ObjectId);
+            if (const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName))
+            {
+                void* PropertyAddr = Descriptor->GetValuePtr(Object);
+                if (FSpacetimeDBPayloadDecoder::ApplyScalar(*Scalar, Descriptor->Property, PropertyAddr))
+                {
+                    FSpacetimeDBPropertyHelper::InvokeRepNotify(Object, *Descriptor);
+                    bSuccess = true;
+                }
+            }
+        }
+        
+        // Apply the property to the object using our property helper
+        if (!bSuccess)
+        {
+            bSuccess = FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Object, PropertyName, ValueJson, Client.GetFrameArena());
+        }
+        
+        if (bSuccess)
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Successfully applied property %s to object %s (ID: %llu)"), 
+                *PropertyName, *Object->GetName(), ObjectId);
+            
+            if (IsOwnerProperty(PropertyName))
+            {
+                RefreshIndexedOwner(ObjectId, Object);
+            }
+            
+            // Server values must not be sent back as local changes
+            AutoReplication.RecaptureProperty(ObjectId, PropertyName);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to apply property %s to object %s (ID: %llu)"), 
+                *PropertyName, *Object->GetName(), ObjectId);
+        }
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Cannot apply property %s - Object with ID %llu not found"), *PropertyName, ObjectId);
+    }
+    
+    // Broadcast the update whether we successfully applied it or not
+    OnPropertyUpdated.Broadcast(UpdateInfo);
+}
+
+void USpacetimeDBSubsystem::InternalHandlePropertyUpdatedBinary(uint64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload)
+{
+    HandleBinaryPropertyUpdate(ObjectId, PropertyName, NAME_None, Payload);
+}
+
+void USpacetimeDBSubsystem::InternalHandlePropertyUpdatedBinaryById(uint64 ObjectId, uint32 PropertyId, const TArray<uint8>& Payload)
+{
+    const FSpacetimeDBInternedProperty* Property = Client.FindInternedProperty(PropertyId);
+    if (!Property)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Dropping update of object %llu - property ID %u was never interned"), ObjectId, PropertyId);
+        return;
+    }
+    
+    HandleBinaryPropertyUpdate(ObjectId, Property->WireName, Property->Name, Payload);
+}
+
+void USpacetimeDBSubsystem::HandleBinaryPropertyUpdate(uint64 ObjectId, const FString& PropertyName, FName ResolvedName, const TArray<uint8>& Payload)
+{
+    // Proxies keep the value until they are promoted
+    if (StoreProxyProperty(static_cast<int64>(ObjectId), PropertyName, Payload))
+    {
+        return;
+    }
+    
+    const bool bQueued = PendingMaterializationSequence.Contains(static_cast<int64>(ObjectId));
+    if (!bQueued && !USpacetimeDBSettings::Get()->bCoalescePropertyUpdates)
+    {
+        InternalOnPropertyUpdatedBinary(static_cast<int64>(ObjectId), PropertyName, Payload, ResolvedName);
+        return;
+    }
+    
+    FSpacetimeDBPendingPropertyUpdate Update;
+    Update.PropertyName = PropertyName;
+    Update.ResolvedName = ResolvedName;
+    Update.Payload = Payload;
+    Update.bBinary = true;
+    
+    // Objects still waiting to spawn get their updates once they exist
+    if (bQueued)
+    {
+        BufferMaterializationPropertyUpdate(static_cast<int64>(ObjectId), Update);
+        return;
+    }
+    QueuePropertyUpdate(static_cast<int64>(ObjectId), MoveTemp(Update));
+}
+
+void USpacetimeDBSubsystem::InternalOnPropertyUpdatedBinary(int64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload, FName ResolvedName)
+{
+    // Use Verbose log level since this could be high frequency
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Property updated (binary) - Object %llu, Property %s"), ObjectId, *PropertyName);
+    
+    // Find the object in our registry
+    UObject* Object = FindObjectById(ObjectId);
+    
+    // Prepare update info to broadcast; RawJsonValue stays empty for binary updates
+    FSpacetimeDBPropertyUpdateInfo UpdateInfo;
+    UpdateInfo.ObjectId = ObjectId;
+    UpdateInfo.Object = Object;
+    UpdateInfo.PropertyName = PropertyName;
+    if (OnPropertyUpdated.IsBound())
+    {
+        FSpacetimeDBBinaryCodec::DecodePropertyValue(Payload.GetData(), Payload.Num(), UpdateInfo.PropertyValue);
+    }
+    
+    if (Object)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_ApplyProperties);
+        FSpacetimeDBClassScope ClassScope(TEXT("Apply"), Object->GetClass());
+        INC_DWORD_STAT(STAT_SpacetimeDB_PropertiesApplied);
+        
+        const FSpacetimeDBPropertyDescriptor* Descriptor = ResolvedName.IsNone()
+            ? FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName)
+            : FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), ResolvedName);
+        
+        // Decode straight into the property's memory
+        const bool bSuccess = Descriptor && ApplyBinaryPropertyPayload(ObjectId, Object, *Descriptor, Payload.GetData(), Payload.Num());
+        
+        if (bSuccess)
+        {
+            FSpacetimeDBPropertyHelper::InvokeRepNotify(Object, *Descriptor);
+            
+            UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Successfully applied property %s to object %s (ID: %llu)"), 
+                *PropertyName, *Object->GetName(), ObjectId);
+            
+            if (IsOwnerProperty(PropertyName))
+            {
+                RefreshIndexedOwner(ObjectId, Object);
+            }
+            
+            // Server values must not be sent back as local changes
+            AutoReplication.RecaptureProperty(ObjectId, Descriptor->Name);
         }
         else
         {
@@ -358,6 +1049,198 @@ void USpacetimeDBSubsystem::InternalOnPropertyUpdated(int64 ObjectId, const FStr
     OnPropertyUpdated.Broadcast(UpdateInfo);
 }
 
+/**
+ * Stages a property value for an object, replacing any older staged value of the same property.
+ * A binary delta can't replace the value it was computed against, so it is queued behind it
+ * instead. The property keeps the position it was first staged at, so apply/notify/send order
+ * is stable.
+ *
+ * @return True if an older value was replaced
+ */
+static bool StagePendingPropertyUpdate(TArray<FSpacetimeDBPendingObjectUpdates>& Objects, TMap<int64, int32>& ObjectIndexMap,
+    int64 ObjectId, FSpacetimeDBPendingPropertyUpdate&& Update)
+{
+    int32& ObjectIndex = ObjectIndexMap.FindOrAdd(ObjectId, INDEX_NONE);
+    if (ObjectIndex == INDEX_NONE)
+    {
+        ObjectIndex = Objects.AddDefaulted();
+        Objects[ObjectIndex].ObjectId = ObjectId;
+    }
+    
+    FSpacetimeDBPendingObjectUpdates& ObjectUpdates = Objects[ObjectIndex];
+    if (const int32* PropertyIndex = ObjectUpdates.PropertyIndex.Find(Update.PropertyName))
+    {
+        FSpacetimeDBPendingPropertyUpdate& Staged = ObjectUpdates.Properties[*PropertyIndex];
+        if (Update.bBinary && FSpacetimeDBBinaryCodec::IsDelta(Update.Payload.GetData(), Update.Payload.Num()))
+        {
+            Staged.Deltas.Add(MoveTemp(Update.Payload));
+            return false;
+        }
+        
+        // Last write wins
+        Staged = MoveTemp(Update);
+        return true;
+    }
+    
+    ObjectUpdates.PropertyIndex.Add(Update.PropertyName, ObjectUpdates.Properties.Num());
+    ObjectUpdates.Properties.Add(MoveTemp(Update));
+    return false;
+}
+
+/** Removes everything staged for an object, leaving its slot so other objects keep their indices */
+static void DropPendingPropertyUpdates(TArray<FSpacetimeDBPendingObjectUpdates>& Objects, TMap<int64, int32>& ObjectIndexMap, int64 ObjectId)
+{
+    if (const int32* ObjectIndex = ObjectIndexMap.Find(ObjectId))
+    {
+        Objects[*ObjectIndex].Properties.Reset();
+        Objects[*ObjectIndex].PropertyIndex.Reset();
+        ObjectIndexMap.Remove(ObjectId);
+    }
+}
+
+void USpacetimeDBSubsystem::QueuePropertyUpdate(int64 ObjectId, FSpacetimeDBPendingPropertyUpdate&& Update)
+{
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Property update staged - Object %lld, Property %s"), ObjectId, *Update.PropertyName);
+    
+    if (StagePendingPropertyUpdate(PendingPropertyUpdates, PendingPropertyUpdateIndex, ObjectId, MoveTemp(Update)))
+    {
+        ++TotalCoalescedPropertyUpdates;
+    }
+}
+
+void USpacetimeDBSubsystem::FlushPendingPropertyUpdates()
+{
+    if (PendingPropertyUpdates.Num() == 0)
+    {
+        return;
+    }
+    
+    // Take the batch so updates queued by RepNotify or delegate handlers land in the next window
+    TArray<FSpacetimeDBPendingObjectUpdates> Batch = MoveTemp(PendingPropertyUpdates);
+    PendingPropertyUpdates.Reset();
+    PendingPropertyUpdateIndex.Reset();
+    
+    for (FSpacetimeDBPendingObjectUpdates& ObjectUpdates : Batch)
+    {
+        if (ObjectUpdates.Properties.Num() == 0)
+        {
+            continue;
+        }
+        
+        UObject* Object = FindObjectById(ObjectUpdates.ObjectId);
+        
+        SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_ApplyProperties);
+        FSpacetimeDBClassScope ClassScope(TEXT("Apply"), Object ? Object->GetClass() : nullptr);
+        INC_DWORD_STAT_BY(STAT_SpacetimeDB_PropertiesApplied, ObjectUpdates.Properties.Num());
+        
+        TArray<FSpacetimeDBPropertyUpdateInfo, TInlineAllocator<16>> UpdateInfos;
+        TArray<const FSpacetimeDBPropertyDescriptor*, TInlineAllocator<16>> PendingNotifies;
+        UpdateInfos.Reserve(ObjectUpdates.Properties.Num());
+        
+        // First pass: write every value without notifying anyone
+        for (FSpacetimeDBPendingPropertyUpdate& Update : ObjectUpdates.Properties)
+        {
+            FSpacetimeDBPropertyUpdateInfo& UpdateInfo = UpdateInfos.AddDefaulted_GetRef();
+            UpdateInfo.ObjectId = ObjectUpdates.ObjectId;
+            UpdateInfo.Object = Object;
+            UpdateInfo.PropertyName = Update.PropertyName;
+            
+            if (Update.bBinary)
+            {
+                // The reflected value is only built for listeners, like the parsed JSON below
+                if (OnPropertyUpdated.IsBound())
+                {
+                    FSpacetimeDBBinaryCodec::DecodePropertyValue(Update.Payload.GetData(), Update.Payload.Num(), UpdateInfo.PropertyValue);
+                }
+            }
+            else
+            {
+                if (OnPropertyUpdated.IsBound())
+                {
+                    UpdateInfo.PropertyValue = FSpacetimeDBPropertyValue::FromJsonString(Update.ValueJson);
+                }
+                UpdateInfo.RawJsonValue = MoveTemp(Update.ValueJson);
+            }
+            
+            if (!Object)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Cannot apply property %s - Object with ID %lld not found"),
+                    *Update.PropertyName, ObjectUpdates.ObjectId);
+                continue;
+            }
+            
+            const FSpacetimeDBPropertyDescriptor* Descriptor = Update.ResolvedName.IsNone()
+                ? FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), Update.PropertyName)
+                : FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), Update.ResolvedName);
+            bool bSuccess = false;
+            
+            if (Descriptor)
+            {
+                void* PropertyAddr = Descriptor->GetValuePtr(Object);
+                if (Update.bBinary)
+                {
+                    bSuccess = ApplyBinaryPropertyPayload(ObjectUpdates.ObjectId, Object, *Descriptor, Update.Payload.GetData(), Update.Payload.Num());
+                }
+                else
+                {
+                    bSuccess = Update.Scalar.IsSet() && FSpacetimeDBPayloadDecoder::ApplyScalar(Update.Scalar, Descriptor->Property, PropertyAddr);
+                    if (!bSuccess)
+                    {
+                        bSuccess = FSpacetimeDBPropertyHelper::DecodeJsonToProperty(*Descriptor, PropertyAddr, UpdateInfo.RawJsonValue, Client.GetFrameArena());
+                    }
+                }
+                
+                // Deltas only make sense on top of the value they followed
+                for (int32 DeltaIndex = 0; bSuccess && DeltaIndex < Update.Deltas.Num(); ++DeltaIndex)
+                {
+                    const TArray<uint8>& Delta = Update.Deltas[DeltaIndex];
+                    bSuccess = ApplyBinaryPropertyPayload(ObjectUpdates.ObjectId, Object, *Descriptor, Delta.GetData(), Delta.Num());
+                }
+            }
+            
+            if (bSuccess)
+            {
+                UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Successfully applied property %s to object %s (ID: %lld)"),
+                    *Update.PropertyName, *Object->GetName(), ObjectUpdates.ObjectId);
+                
+                if (Descriptor->RepNotifyFunc)
+                {
+                    PendingNotifies.Add(Descriptor);
+                }
+                
+                if (IsOwnerProperty(Update.PropertyName))
+                {
+                    RefreshIndexedOwner(ObjectUpdates.ObjectId, Object);
+                }
+                
+                // Server values must not be sent back as local changes
+                AutoReplication.RecaptureProperty(ObjectUpdates.ObjectId, Descriptor->Name);
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to apply property %s to object %s (ID: %lld)"),
+                    *Update.PropertyName, *Object->GetName(), ObjectUpdates.ObjectId);
+            }
+        }
+        
+        // Second pass: every value is in place, so notifies never observe a half-applied update
+        for (const FSpacetimeDBPropertyDescriptor* Descriptor : PendingNotifies)
+        {
+            if (!IsValid(Object))
+            {
+                break;
+            }
+            FSpacetimeDBPropertyHelper::InvokeRepNotify(Object, *Descriptor);
+        }
+        
+        // Broadcast the updates whether we successfully applied them or not
+        for (const FSpacetimeDBPropertyUpdateInfo& UpdateInfo : UpdateInfos)
+        {
+            OnPropertyUpdated.Broadcast(UpdateInfo);
+        }
+    }
+}
+
 // FFI callback handlers for property updates
 void OnPropertyUpdatedCallback(uint64 object_id, const char* property_name_cstr, const char* value_json_cstr)
 {
@@ -525,7 +1408,20 @@ TArray<UObject*> USpacetimeDBSubsystem::GetAllObjects() const
 
 UObject* USpacetimeDBSubsystem::SpawnObjectFromServer(int64 ObjectId, const FString& ClassName, const FString& DataJson)
 {
-    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: SpawnObjectFromServer - ID: %lld, Class: %s"), ObjectId, *ClassName);
+    // Resolve through the registry so repeated and unknown names skip the object hash
+    UClass* ObjectClass = FSpacetimeDBClassRegistry::FindClassByName(ClassName);
+    if (!ObjectClass)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Could not find class '%s'"), *ClassName);
+        return nullptr;
+    }
+    
+    return SpawnObjectFromServer(ObjectId, ObjectClass, DataJson);
+}
+
+UObject* USpacetimeDBSubsystem::SpawnObjectFromServer(int64 ObjectId, UClass* ObjectClass, const FString& DataJson)
+{
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: SpawnObjectFromServer - ID: %lld, Class: %s"), ObjectId, *ObjectClass->GetName());
     
     // First check if this object is already registered (could be a remap)
     if (UObject* ExistingObject = FindObjectById(ObjectId))
@@ -534,93 +1430,15 @@ UObject* USpacetimeDBSubsystem::SpawnObjectFromServer(int64 ObjectId, const FStr
         return ExistingObject;
     }
     
-    // Parse JSON data
-    TSharedPtr<FJsonObject> ObjectDataJson;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DataJson);
-    if (!FJsonSerializer::Deserialize(Reader, ObjectDataJson))
-    {
-        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to parse object data JSON: %s"), *DataJson);
-        return nullptr;
-    }
-    
-    // Determine if this is an actor or a plain UObject
-    bool bIsActor = false;
-    FTransform SpawnTransform = FTransform::Identity;
-    
-    // Extract transform if available (for actors)
-    TSharedPtr<FJsonObject> TransformObj = ObjectDataJson->GetObjectField(TEXT("transform"));
-    if (TransformObj.IsValid())
-    {
-        bIsActor = true;
-        
-        // Extract location
-        TSharedPtr<FJsonObject> LocationObj = TransformObj->GetObjectField(TEXT("location"));
-        if (LocationObj.IsValid())
-        {
-            FVector Location;
-            Location.X = LocationObj->GetNumberField(TEXT("x"));
-            Location.Y = LocationObj->GetNumberField(TEXT("y"));
-            Location.Z = LocationObj->GetNumberField(TEXT("z"));
-            SpawnTransform.SetLocation(Location);
-        }
-        
-        // Extract rotation
-        TSharedPtr<FJsonObject> RotationObj = TransformObj->GetObjectField(TEXT("rotation"));
-        if (RotationObj.IsValid())
-        {
-            FRotator Rotation;
-            Rotation.Pitch = RotationObj->GetNumberField(TEXT("pitch"));
-            Rotation.Yaw = RotationObj->GetNumberField(TEXT("yaw"));
-            Rotation.Roll = RotationObj->GetNumberField(TEXT("roll"));
-            SpawnTransform.SetRotation(Rotation.Quaternion());
-        }
-        
-        // Extract scale
-        TSharedPtr<FJsonObject> ScaleObj = TransformObj->GetObjectField(TEXT("scale"));
-        if (ScaleObj.IsValid())
-        {
-            FVector Scale;
-            Scale.X = ScaleObj->GetNumberField(TEXT("x"));
-            Scale.Y = ScaleObj->GetNumberField(TEXT("y"));
-            Scale.Z = ScaleObj->GetNumberField(TEXT("z"));
-            SpawnTransform.SetScale3D(Scale);
-        }
-    }
+    SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_Spawn);
+    FSpacetimeDBClassScope ClassScope(TEXT("Spawn"), ObjectClass);
+    INC_DWORD_STAT(STAT_SpacetimeDB_ObjectsSpawned);
     
     UObject* SpawnedObject = nullptr;
     
-    // Find the class by name
-    UClass* ObjectClass = nullptr;
-    
-    // Try to find the class by its path directly
-    ObjectClass = FindObject<UClass>(nullptr, *ClassName);
-    
-    // If not found, try with potential package prefixes
-    if (!ObjectClass)
-    {
-        // Try with a U prefix if not found
-        if (!ClassName.StartsWith(TEXT("U")) && !ClassName.StartsWith(TEXT("A")))
-        {
-            FString PrefixedClassName = FString::Printf(TEXT("U%s"), *ClassName);
-            ObjectClass = FindObject<UClass>(nullptr, *PrefixedClassName);
-            
-            // Also try with A prefix for actors
-            if (!ObjectClass)
-            {
-                PrefixedClassName = FString::Printf(TEXT("A%s"), *ClassName);
-                ObjectClass = FindObject<UClass>(nullptr, *PrefixedClassName);
-            }
-        }
-        
-        if (!ObjectClass)
-        {
-            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Could not find class '%s'"), *ClassName);
-            return nullptr;
-        }
-    }
-    
     // Check if this is an actor class
-    bIsActor = ObjectClass->IsChildOf(AActor::StaticClass());
+    const bool bIsActor = ObjectClass->IsChildOf(AActor::StaticClass());
+    FSpacetimeDBSpawnSnapshot Snapshot;
     
     if (bIsActor)
     {
@@ -632,59 +1450,32 @@ UObject* USpacetimeDBSubsystem::SpawnObjectFromServer(int64 ObjectId, const FStr
             return nullptr;
         }
         
-        // Use deferred spawning to allow setting properties before the actor initializes
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-        SpawnParams.bDeferConstruction = true;  // Important for setting properties before BeginPlay
+        // Reuse a parked actor of this class when the class is pooled
+        if (AActor* PooledActor = AcquirePooledActor(ObjectClass, World, DataJson))
+        {
+            RegisterSpawnedObject(ObjectId, PooledActor);
+            return PooledActor;
+        }
         
-        AActor* SpawnedActor = World->SpawnActorDeferred<AActor>(ObjectClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        // Use deferred spawning to allow setting properties before the actor initializes.
+        // The real transform is only known once the snapshot is read, and is applied by FinishSpawning.
+        AActor* SpawnedActor = World->SpawnActorDeferred<AActor>(ObjectClass, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
         if (!SpawnedActor)
         {
-            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to spawn actor of class '%s'"), *ClassName);
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to spawn actor of class '%s'"), *ObjectClass->GetName());
             return nullptr;
         }
         
-        // Apply initial properties from JSON if provided
-        TSharedPtr<FJsonObject> PropertiesObj = ObjectDataJson->GetObjectField(TEXT("properties"));
-        if (PropertiesObj.IsValid())
+        // Stream the initial properties straight into the actor; RepNotifies are not fired before BeginPlay
+        if (!FSpacetimeDBSpawnDataReader::Read(DataJson, SpawnedActor, false, Snapshot))
         {
-            // Apply each property from JSON to the actor
-            for (const auto& Pair : PropertiesObj->Values)
-            {
-                const FString& PropertyName = Pair.Key;
-                const TSharedPtr<FJsonValue>& JsonValue = Pair.Value;
-                
-                // Find the property on the actor
-                FProperty* Property = FindPropertyByName(SpawnedActor->GetClass(), FName(*PropertyName));
-                if (!Property)
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Property '%s' not found on actor of class '%s'"), *PropertyName, *ClassName);
-                    continue;
-                }
-                
-                // Set the property value based on its type
-                if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
-                {
-                    BoolProperty->SetPropertyValue_InContainer(SpawnedActor, JsonValue->AsBool());
-                }
-                else if (FIntProperty* IntProperty = CastField<FIntProperty>(Property))
-                {
-                    IntProperty->SetPropertyValue_InContainer(SpawnedActor, (int32)JsonValue->AsNumber());
-                }
-                else if (FFloatProperty* FloatProperty = CastField<FFloatProperty>(Property))
-                {
-                    FloatProperty->SetPropertyValue_InContainer(SpawnedActor, JsonValue->AsNumber());
-                }
-                else if (FStrProperty* StrProperty = CastField<FStrProperty>(Property))
-                {
-                    StrProperty->SetPropertyValue_InContainer(SpawnedActor, JsonValue->AsString());
-                }
-                // Additional property types can be handled here
-            }
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to parse object data JSON for object %lld"), ObjectId);
+            SpawnedActor->Destroy();
+            return nullptr;
         }
         
         // Finalize actor spawning
-        UGameplayStatics::FinishSpawningActor(SpawnedActor, SpawnTransform);
+        UGameplayStatics::FinishSpawningActor(SpawnedActor, Snapshot.Transform);
         
         SpawnedObject = SpawnedActor;
     }
@@ -694,68 +1485,277 @@ UObject* USpacetimeDBSubsystem::SpawnObjectFromServer(int64 ObjectId, const FStr
         SpawnedObject = NewObject<UObject>(GetTransientPackage(), ObjectClass);
         if (!SpawnedObject)
         {
-            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to create UObject of class '%s'"), *ClassName);
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to create UObject of class '%s'"), *ObjectClass->GetName());
             return nullptr;
         }
         
-        // Apply initial properties from JSON if provided
-        TSharedPtr<FJsonObject> PropertiesObj = ObjectDataJson->GetObjectField(TEXT("properties"));
-        if (PropertiesObj.IsValid())
+        // Apply initial properties the same way as for actors
+        if (!FSpacetimeDBSpawnDataReader::Read(DataJson, SpawnedObject, false, Snapshot))
         {
-            // TODO: Apply properties to the UObject
-            // Similar to the actor code above, but for UObject
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to parse object data JSON for object %lld"), ObjectId);
+            SpawnedObject->MarkAsGarbage();
+            return nullptr;
         }
     }
     
     // Register the object in our registry
     if (SpawnedObject)
     {
-        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Successfully spawned/created object of class '%s' with ID %lld"), *ClassName, ObjectId);
-        
-        // Add to registry
-        ObjectRegistry.Add(ObjectId, SpawnedObject);
-        ObjectToIdMap.Add(SpawnedObject, ObjectId);
-        
-        // Add a destroy delegate to clean up registry when the object is destroyed
-        if (AActor* Actor = Cast<AActor>(SpawnedObject))
-        {
-            Actor->OnDestroyed.AddDynamic(this, &USpacetimeDBSubsystem::OnActorDestroyed);
-        }
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Successfully spawned/created object of class '%s' with ID %lld"), *ObjectClass->GetName(), ObjectId);
+        RegisterSpawnedObject(ObjectId, SpawnedObject);
     }
     
     return SpawnedObject;
 }
 
-void USpacetimeDBSubsystem::DestroyObjectFromServer(int64 ObjectId)
+void USpacetimeDBSubsystem::RegisterSpawnedObject(int64 ObjectId, UObject* Object)
 {
-    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: DestroyObjectFromServer - ID: %lld"), ObjectId);
+    // Add to registry
+    ObjectRegistry.Add(ObjectId, Object);
+    ObjectToIdMap.Add(Object, ObjectId);
     
-    // Find the object in our registry
-    UObject* Object = FindObjectById(ObjectId);
-    if (!Object)
+    // The snapshot has been applied, so the owner property holds the spawn-time owner
+    RefreshIndexedOwner(ObjectId, Object);
+    
+    // Add a destroy delegate to clean up registry when the object is destroyed; pooled actors are already bound
+    if (AActor* Actor = Cast<AActor>(Object))
     {
-        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Object with ID %lld not found in registry, can't destroy"), ObjectId);
-        return;
+        Actor->OnDestroyed.AddUniqueDynamic(this, &USpacetimeDBSubsystem::OnActorDestroyed);
     }
-    
-    // Remove from registry first
+}
+
+void USpacetimeDBSubsystem::UnregisterObject(int64 ObjectId, UObject* Object)
+{
     ObjectRegistry.Remove(ObjectId);
     ObjectToIdMap.Remove(Object);
+    RemoveIndexedOwner(ObjectId);
+    TransformTargets.Remove(ObjectId);
+    AutoReplication.Untrack(ObjectId);
+    OutboundScheduler.Forget(ObjectId);
     
-    // Destroy the object
-    if (AActor* Actor = Cast<AActor>(Object))
+    // Keyed by object and property, so the object's entries are found by a scan; the map only holds stale properties
+    for (auto It = LastPropertyResyncRequest.CreateIterator(); It; ++It)
     {
-        // It's an actor, use the proper destroy method
-        Actor->Destroy();
+        if (It.Key().Key == ObjectId)
+        {
+            It.RemoveCurrent();
+        }
     }
-    else
+}
+
+void USpacetimeDBSubsystem::RefreshIndexedOwner(int64 ObjectId, const UObject* Object)
+{
+    int64 OwnerClientId = 0;
+    if (!ReadOwnerProperty(Object, OwnerClientId))
     {
-        // It's a regular UObject, mark it for destruction
-        // Object->MarkPendingKill() is deprecated in UE5.5
-        Object->MarkAsGarbage();
+        RemoveIndexedOwner(ObjectId);
+        return;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Successfully removed object with ID %lld from registry"), ObjectId);
+    int64& IndexedOwner = OwnerIndex.FindOrAdd(ObjectId, INDEX_NONE);
+    if (IndexedOwner == OwnerClientId)
+    {
+        return;
+    }
+    
+    if (IndexedOwner != INDEX_NONE)
+    {
+        if (TSet<int64>* PreviousOwned = ObjectsByOwner.Find(IndexedOwner))
+        {
+            PreviousOwned->Remove(ObjectId);
+            if (PreviousOwned->Num() == 0)
+            {
+                ObjectsByOwner.Remove(IndexedOwner);
+            }
+        }
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Object %lld is now owned by client %lld"), ObjectId, OwnerClientId);
+    
+    IndexedOwner = OwnerClientId;
+    ObjectsByOwner.FindOrAdd(OwnerClientId).Add(ObjectId);
+    
+    // Owned objects replicate automatically for as long as this client owns them
+    if (USpacetimeDBSettings::Get()->bAutoReplicateOwnedObjects)
+    {
+        SetAutoReplicationEnabled(ObjectId, OwnerClientId == static_cast<int64>(GetClientId()));
+    }
+}
+
+void USpacetimeDBSubsystem::RemoveIndexedOwner(int64 ObjectId)
+{
+    int64 OwnerClientId = 0;
+    if (!OwnerIndex.RemoveAndCopyValue(ObjectId, OwnerClientId))
+    {
+        return;
+    }
+    
+    if (TSet<int64>* Owned = ObjectsByOwner.Find(OwnerClientId))
+    {
+        Owned->Remove(ObjectId);
+        if (Owned->Num() == 0)
+        {
+            ObjectsByOwner.Remove(OwnerClientId);
+        }
+    }
+}
+
+int32 USpacetimeDBSubsystem::GetActorPoolSize(UClass* Class)
+{
+    if (const int32* Cached = ActorPoolSizeCache.Find(Class))
+    {
+        return *Cached;
+    }
+    
+    const int32* PoolSize = FindClassSetting(USpacetimeDBSettings::Get()->ActorPoolSizes, Class);
+    const int32 Size = PoolSize ? FMath::Max(*PoolSize, 0) : 0;
+    
+    ActorPoolSizeCache.Add(Class, Size);
+    return Size;
+}
+
+bool USpacetimeDBSubsystem::ReleaseActorToPool(AActor* Actor)
+{
+    UClass* Class = Actor->GetClass();
+    const int32 PoolSize = GetActorPoolSize(Class);
+    if (PoolSize <= 0)
+    {
+        return false;
+    }
+    
+    TArray<TWeakObjectPtr<AActor>>& Parked = ActorPool.FindOrAdd(Class);
+    
+    // Forget actors that were destroyed while parked (level unload, gameplay code)
+    Parked.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Entry) { return !Entry.IsValid(); });
+    if (Parked.Num() >= PoolSize)
+    {
+        return false;
+    }
+    
+    // Park: invisible, no collision, no ticking, components deactivated
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+    Actor->ForEachComponent(false, [](UActorComponent* Component)
+    {
+        Component->Deactivate();
+    });
+    
+    Parked.Add(Actor);
+    
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Parked actor %s in pool (%d/%d)"), *Actor->GetName(), Parked.Num(), PoolSize);
+    return true;
+}
+
+AActor* USpacetimeDBSubsystem::AcquirePooledActor(UClass* Class, UWorld* World, const FString& DataJson)
+{
+    TArray<TWeakObjectPtr<AActor>>* Parked = ActorPool.Find(Class);
+    if (!Parked)
+    {
+        return nullptr;
+    }
+    
+    while (Parked->Num() > 0)
+    {
+        AActor* Actor = Parked->Pop(EAllowShrinking::No).Get();
+        if (!IsValid(Actor) || Actor->GetWorld() != World)
+        {
+            continue;
+        }
+        
+        // Server state from the previous life must not leak into this one
+        const AActor* Defaults = Class->GetDefaultObject<AActor>();
+        if (const FSpacetimeDBClassDescriptor* ClassDescriptor = FSpacetimeDBPropertyDescriptorCache::GetClassDescriptor(Class))
+        {
+            for (const FSpacetimeDBPropertyDescriptor& Descriptor : ClassDescriptor->Properties)
+            {
+                if (Descriptor.Property->HasAnyPropertyFlags(CPF_Net))
+                {
+                    Descriptor.Property->CopyCompleteValue(Descriptor.GetValuePtr(Actor), Descriptor.GetValuePtr(Defaults));
+                }
+            }
+        }
+        
+        // Same for the replicated state of its components, from the templates they were created from.
+        // Other component state is left as gameplay last set it.
+        Actor->ForEachComponent(false, [](UActorComponent* Component)
+        {
+            const UObject* Archetype = Component->GetArchetype();
+            for (TFieldIterator<FProperty> It(Component->GetClass()); It; ++It)
+            {
+                if (It->HasAnyPropertyFlags(CPF_Net))
+                {
+                    It->CopyCompleteValue_InContainer(Component, Archetype);
+                }
+            }
+        });
+        
+        // The actor has already begun play, so its RepNotifies fire like for any other update
+        FSpacetimeDBSpawnSnapshot Snapshot;
+        if (!FSpacetimeDBSpawnDataReader::Read(DataJson, Actor, true, Snapshot))
+        {
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to parse object data JSON for pooled actor %s"), *Actor->GetName());
+            Actor->Destroy();
+            return nullptr;
+        }
+        
+        // Unpark
+        Actor->SetActorTransform(Snapshot.Transform, false, nullptr, ETeleportType::ResetPhysics);
+        Actor->ForEachComponent(false, [](UActorComponent* Component)
+        {
+            if (Component->bAutoActivate)
+            {
+                Component->Activate(true);
+            }
+        });
+        Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+        Actor->SetActorEnableCollision(Defaults->GetActorEnableCollision());
+        Actor->SetActorHiddenInGame(Defaults->IsHidden());
+        
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Reused pooled actor %s"), *Actor->GetName());
+        return Actor;
+    }
+    return nullptr;
+}
+
+void USpacetimeDBSubsystem::DestroyObjectFromServer(int64 ObjectId)
+{
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: DestroyObjectFromServer - ID: %lld"), ObjectId);
+    
+    // Find the object in our registry
+    UObject* Object = FindObjectById(ObjectId);
+    if (!Object)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Object with ID %lld not found in registry, can't destroy"), ObjectId);
+        return;
+    }
+    
+    // Remove from registry first
+    UnregisterObject(ObjectId, Object);
+    
+    // Drop values staged for it this frame in either direction
+    DropPendingPropertyUpdates(PendingPropertyUpdates, PendingPropertyUpdateIndex, ObjectId);
+    DropPendingPropertyUpdates(DirtyPropertyUpdates, DirtyPropertyUpdateIndex, ObjectId);
+    LastPropertyFlushTime.Remove(ObjectId);
+    
+    // Destroy the object
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        // Pooled classes are parked for the next spawn instead of destroyed
+        if (!ReleaseActorToPool(Actor))
+        {
+            // It's an actor, use the proper destroy method
+            Actor->Destroy();
+        }
+    }
+    else
+    {
+        // It's a regular UObject, mark it for destruction
+        // Object->MarkPendingKill() is deprecated in UE5.5
+        Object->MarkAsGarbage();
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Successfully removed object with ID %lld from registry"), ObjectId);
 }
 
 // Event handler for when an actor is destroyed outside of our control
@@ -770,8 +1770,7 @@ void USpacetimeDBSubsystem::OnActorDestroyed(AActor* DestroyedActor)
     if (ObjectId != 0)
     {
         UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Actor %s was destroyed, removing from registry (ID: %lld)"), *DestroyedActor->GetName(), ObjectId);
-        ObjectRegistry.Remove(ObjectId);
-        ObjectToIdMap.Remove(DestroyedActor);
+        UnregisterObject(ObjectId, DestroyedActor);
     }
 }
 
@@ -781,152 +1780,1520 @@ void USpacetimeDBSubsystem::InternalHandleObjectCreated(uint64 ObjectId, const F
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Object created event - ID: %llu, Class: %s"), ObjectId, *ClassName);
     
-    // Create the object
-    UObject* NewObject = SpawnObjectFromServer(ObjectId, ClassName, DataJson);
-    
-    if (NewObject)
+    UClass* ObjectClass = FSpacetimeDBClassRegistry::FindClassByName(ClassName);
+    if (!ObjectClass)
     {
-        // Broadcast the object created event
-        OnObjectCreated.Broadcast(ObjectId, ClassName, DataJson);
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Could not find class '%s'"), *ClassName);
+        return;
     }
+    
+    // Create the object once its turn comes
+    const FSpacetimeDBDecodedPayload* Decoded = Client.GetDispatchingPayload();
+    QueueMaterialization(static_cast<int64>(ObjectId), ObjectClass, ClassName, DataJson,
+        (Decoded && Decoded->bHasSpawn) ? &Decoded->Spawn : nullptr);
 }
 
-void USpacetimeDBSubsystem::InternalHandleObjectDestroyed(uint64 ObjectId)
+void USpacetimeDBSubsystem::InternalHandleObjectCreatedByClassId(uint64 ObjectId, uint32 ClassId, const FString& DataJson)
 {
-    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Object destroyed event - ID: %llu"), ObjectId);
-    
-    // Broadcast the object destroyed event before actually destroying it
-    OnObjectDestroyed.Broadcast(ObjectId);
+    UClass* ObjectClass = FSpacetimeDBClassRegistry::FindClassById(static_cast<int32>(ClassId));
+    if (!ObjectClass)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Could not find class for class ID %u (object %llu)"), ClassId, ObjectId);
+        return;
+    }
     
-    // Destroy the object
-    DestroyObjectFromServer(ObjectId);
+    // Create the object once its turn comes
+    const FSpacetimeDBDecodedPayload* Decoded = Client.GetDispatchingPayload();
+    QueueMaterialization(static_cast<int64>(ObjectId), ObjectClass, FString(), DataJson,
+        (Decoded && Decoded->bHasSpawn) ? &Decoded->Spawn : nullptr);
 }
 
-void USpacetimeDBSubsystem::InternalHandleObjectIdRemapped(uint64 TempId, uint64 ServerId)
+void USpacetimeDBSubsystem::QueueMaterialization(int64 ObjectId, UClass* ObjectClass, const FString& ClassName, const FString& DataJson, const FSpacetimeDBSpawnSnapshot* Snapshot)
 {
-    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Object ID remapped - Temp ID: %llu, Server ID: %llu"), TempId, ServerId);
+    FSpacetimeDBPendingMaterialization Entry;
+    Entry.ObjectId = ObjectId;
+    Entry.ObjectClass = ObjectClass;
+    Entry.ClassName = ClassName;
+    Entry.DataJson = DataJson;
+    Entry.Sequence = NextMaterializationSequence++;
+    
+    // The server still has the object, so it survives the reconciliation either way
+    UnconfirmedObjects.Remove(ObjectId);
+    
+    // An object kept across a reconnect is updated in place instead of respawned
+    if (ReconcileExistingObject(ObjectId, ObjectClass, DataJson))
+    {
+        return;
+    }
     
-    // Broadcast the object ID remapped event
-    OnObjectIdRemapped.Broadcast(TempId, ServerId);
+    // A newer snapshot supersedes a queued one or a proxy, along with the updates kept for it
+    CancelMaterialization(ObjectId);
+    Proxies.Remove(ObjectId);
     
-    // TODO: Implement ID remapping in the object registry
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    if (!Settings->bTimeSliceObjectMaterialization && !Settings->bEnableProxyEntities)
+    {
+        MaterializeObject(Entry);
+        return;
+    }
+    
+    // Only the transform and owner are needed to prioritize; the full read happens at spawn time
+    if (Snapshot)
+    {
+        Entry.Snapshot = *Snapshot;
+    }
+    else
+    {
+        FSpacetimeDBSpawnDataReader::Peek(DataJson, Entry.Snapshot);
+    }
+    
+    if (ShouldStartAsProxy(Entry))
+    {
+        FSpacetimeDBProxyEntity& Proxy = Proxies.Add(ObjectId);
+        Proxy.ObjectClass = Entry.ObjectClass;
+        Proxy.ClassName = MoveTemp(Entry.ClassName);
+        Proxy.Transform = Entry.Snapshot.Transform;
+        Proxy.OwnerClientId = Entry.Snapshot.OwnerClientId;
+        Proxy.DataJson = MoveTemp(Entry.DataJson);
+        
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Keeping object %lld as a proxy"), ObjectId);
+        return;
+    }
+    
+    EnqueueMaterialization(MoveTemp(Entry));
 }
 
-// Add methods for setting properties
-
-bool USpacetimeDBSubsystem::SetPropertyValueFromJson(int64 ObjectId, const FString& PropertyName, const FString& ValueJson, bool bReplicateToServer)
+bool USpacetimeDBSubsystem::ReconcileExistingObject(int64 ObjectId, UClass* ObjectClass, const FString& DataJson)
 {
-    if (!IsConnected())
+    UObject* Existing = FindObjectById(ObjectId);
+    if (!Existing || Existing->IsA<UActorComponent>())
     {
-        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SetPropertyValueFromJson - Not connected to SpacetimeDB"));
         return false;
     }
     
-    // SECURITY: Check if client has authority to modify this object
-    if (bReplicateToServer && !HasAuthority(ObjectId))
+    // The ID was reused for something else while we were away
+    if (ObjectClass && Existing->GetClass() != ObjectClass)
     {
-        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SetPropertyValueFromJson - Client does not have authority to modify object %lld"), ObjectId);
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Object %lld changed class from '%s' to '%s', respawning it"),
+            ObjectId, *Existing->GetClass()->GetName(), *ObjectClass->GetName());
+        OnObjectDestroyed.Broadcast(ObjectId);
+        DestroyObjectFromServer(ObjectId);
         return false;
     }
     
-    // Find the object in our registry
-    UObject* Object = FindObjectById(ObjectId);
-    if (!Object)
+    SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_ApplyProperties);
+    FSpacetimeDBClassScope ClassScope(TEXT("Reconcile"), Existing->GetClass());
+    
+    FSpacetimeDBSpawnSnapshot Snapshot;
+    if (!FSpacetimeDBSpawnDataReader::Reconcile(DataJson, Existing, Snapshot))
     {
-        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SetPropertyValueFromJson - Object with ID %lld not found"), ObjectId);
-        return false;
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to parse object data JSON for object %lld"), ObjectId);
+        return true;
     }
     
-    // Try to apply the property to the object
-    bool bSuccess = FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Object, PropertyName, ValueJson);
+    // The owner may have changed meanwhile, and decides who drives the transform
+    RefreshIndexedOwner(ObjectId, Existing);
     
-    // If successful and we need to replicate to server, send the update
-    if (bSuccess && bReplicateToServer)
+    // Objects this client owns keep their locally predicted transform
+    AActor* Actor = Cast<AActor>(Existing);
+    if (Actor && Snapshot.bHasTransform && !HasOwnership(ObjectId) && !Actor->GetActorTransform().Equals(Snapshot.Transform))
     {
-        SendPropertyUpdateToServer(ObjectId, PropertyName, ValueJson);
+        Actor->SetActorTransform(Snapshot.Transform, false, nullptr, ETeleportType::ResetPhysics);
     }
     
-    return bSuccess;
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Reconciled object %lld, %d properties changed"), ObjectId, Snapshot.NumPropertiesApplied);
+    return true;
 }
 
-bool USpacetimeDBSubsystem::SetPropertyValue(int64 ObjectId, const FString& PropertyName, UObject* Object, bool bReplicateToServer)
+void USpacetimeDBSubsystem::FinishReconciliation()
 {
-    if (!Object)
+    bReconcilingObjects = false;
+    
+    const TArray<int64> Stale = UnconfirmedObjects.Array();
+    UnconfirmedObjects.Reset();
+    
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Reconnect reconciled, despawning %d objects the server no longer has"), Stale.Num());
+    for (const int64 ObjectId : Stale)
     {
-        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Cannot set property value with null object. Property: %s"), *PropertyName);
-        return false;
+        InternalHandleObjectDestroyed(static_cast<uint64>(ObjectId));
     }
+}
 
-    // Serialize the property value to JSON
-    FString ValueJson = FSpacetimeDBPropertyHelper::SerializePropertyToJson(Object, PropertyName);
-    if (ValueJson.IsEmpty())
+void USpacetimeDBSubsystem::EnqueueMaterialization(FSpacetimeDBPendingMaterialization&& Entry)
+{
+    if (!USpacetimeDBSettings::Get()->bTimeSliceObjectMaterialization)
     {
-        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to serialize property %s on object %s"), 
-            *PropertyName, *Object->GetName());
-        return false;
+        MaterializeObject(Entry);
+        return;
+    }
+    
+    Entry.Priority = GetMaterializationPriority(Entry, MaterializationViewPawn.Get());
+    
+    PendingMaterializationSequence.Add(Entry.ObjectId, Entry.Sequence);
+    PendingMaterializations.HeapPush(MoveTemp(Entry), FMaterializationOrder());
+}
+
+void USpacetimeDBSubsystem::MaterializePendingObjects(double TimeBudgetSeconds)
+{
+    if (PendingMaterializations.Num() == 0)
+    {
+        return;
+    }
+    
+    // A new (or first) local pawn invalidates every distance-based priority
+    const APawn* ViewPawn = GetLocalPawn();
+    if (ViewPawn != MaterializationViewPawn.Get())
+    {
+        MaterializationViewPawn = ViewPawn;
+        for (FSpacetimeDBPendingMaterialization& Entry : PendingMaterializations)
+        {
+            Entry.Priority = GetMaterializationPriority(Entry, ViewPawn);
+        }
+        PendingMaterializations.Heapify(FMaterializationOrder());
+    }
+    
+    const double StartTime = FPlatformTime::Seconds();
+    int32 NumSpawned = 0;
+    
+    while (PendingMaterializations.Num() > 0)
+    {
+        FSpacetimeDBPendingMaterialization Entry;
+        PendingMaterializations.HeapPop(Entry, FMaterializationOrder(), EAllowShrinking::No);
+        
+        // Superseded or cancelled
+        const uint64* LiveSequence = PendingMaterializationSequence.Find(Entry.ObjectId);
+        if (!LiveSequence || *LiveSequence != Entry.Sequence)
+        {
+            continue;
+        }
+        
+        MaterializeObject(Entry);
+        ++NumSpawned;
+        
+        if (FPlatformTime::Seconds() - StartTime >= TimeBudgetSeconds)
+        {
+            break;
+        }
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Materialized %d objects, %d still queued"), NumSpawned, PendingMaterializationSequence.Num());
+    
+    if (PendingMaterializationSequence.Num() == 0)
+    {
+        // Nothing can be buffered for objects that aren't queued, so drop the emptied slots
+        PendingMaterializations.Reset();
+        MaterializationPropertyUpdates.Reset();
+        MaterializationPropertyUpdateIndex.Reset();
     }
+}
 
-    // Apply locally first if Object isn't the target (it's a different object with the same property)
-    UObject* TargetObject = FindObjectById(ObjectId);
-    if (TargetObject && TargetObject != Object)
+void USpacetimeDBSubsystem::MaterializeObject(FSpacetimeDBPendingMaterialization& Entry)
+{
+    PendingMaterializationSequence.Remove(Entry.ObjectId);
+    
+    // Take whatever arrived for the object while it waited
+    FSpacetimeDBPendingObjectUpdates BufferedUpdates;
+    if (const int32* BufferIndex = MaterializationPropertyUpdateIndex.Find(Entry.ObjectId))
     {
-        bool bLocalSuccess = FSpacetimeDBPropertyHelper::ApplyJsonToProperty(TargetObject, PropertyName, ValueJson);
-        if (!bLocalSuccess)
+        BufferedUpdates = MoveTemp(MaterializationPropertyUpdates[*BufferIndex]);
+        DropPendingPropertyUpdates(MaterializationPropertyUpdates, MaterializationPropertyUpdateIndex, Entry.ObjectId);
+    }
+    
+    UClass* ObjectClass = Entry.ObjectClass.Get();
+    if (!ObjectClass)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Class of queued object %lld was unloaded before it could spawn"), Entry.ObjectId);
+        return;
+    }
+    
+    // Create the object
+    UObject* NewObject = SpawnObjectFromServer(Entry.ObjectId, ObjectClass, Entry.DataJson);
+    if (!NewObject)
+    {
+        return;
+    }
+    
+    // A promoted proxy has moved since its snapshot was taken
+    if (Entry.bSnapshotTransformIsNewer)
+    {
+        if (AActor* Actor = Cast<AActor>(NewObject))
+        {
+            Actor->SetActorTransform(Entry.Snapshot.Transform, false, nullptr, ETeleportType::ResetPhysics);
+        }
+    }
+    
+    // Broadcast the object created event; only pay for the class name when someone is listening
+    if (!Entry.ClassName.IsEmpty())
+    {
+        OnObjectCreated.Broadcast(Entry.ObjectId, Entry.ClassName, Entry.DataJson);
+    }
+    else if (OnObjectCreated.IsBound())
+    {
+        OnObjectCreated.Broadcast(Entry.ObjectId, ObjectClass->GetName(), Entry.DataJson);
+    }
+    
+    // Newer than the snapshot, so they're applied on top of it
+    const bool bCoalesce = USpacetimeDBSettings::Get()->bCoalescePropertyUpdates;
+    for (FSpacetimeDBPendingPropertyUpdate& Update : BufferedUpdates.Properties)
+    {
+        if (bCoalesce)
+        {
+            QueuePropertyUpdate(Entry.ObjectId, MoveTemp(Update));
+        }
+        else
+        {
+            if (Update.bBinary)
+            {
+                InternalOnPropertyUpdatedBinary(Entry.ObjectId, Update.PropertyName, Update.Payload, Update.ResolvedName);
+            }
+            else
+            {
+                InternalOnPropertyUpdated(Entry.ObjectId, Update.PropertyName, Update.ValueJson, &Update.Scalar);
+            }
+            for (const TArray<uint8>& Delta : Update.Deltas)
+            {
+                InternalOnPropertyUpdatedBinary(Entry.ObjectId, Update.PropertyName, Delta, Update.ResolvedName);
+            }
+        }
+    }
+}
+
+bool USpacetimeDBSubsystem::MaterializeObjectNow(int64 ObjectId)
+{
+    const uint64* LiveSequence = PendingMaterializationSequence.Find(ObjectId);
+    if (!LiveSequence)
+    {
+        return false;
+    }
+    
+    const int32 HeapIndex = PendingMaterializations.IndexOfByPredicate([ObjectId, Sequence = *LiveSequence](const FSpacetimeDBPendingMaterialization& Entry)
+    {
+        return Entry.ObjectId == ObjectId && Entry.Sequence == Sequence;
+    });
+    if (HeapIndex == INDEX_NONE)
+    {
+        return false;
+    }
+    
+    FSpacetimeDBPendingMaterialization Entry = MoveTemp(PendingMaterializations[HeapIndex]);
+    PendingMaterializations.HeapRemoveAt(HeapIndex, FMaterializationOrder(), EAllowShrinking::No);
+    MaterializeObject(Entry);
+    return true;
+}
+
+void USpacetimeDBSubsystem::UpdateInterest()
+{
+    if (!USpacetimeDBSettings::Get()->bEnableInterestManagement)
+    {
+        // Turned off at runtime: release the cell queries
+        ReleaseInterest();
+        return;
+    }
+    
+    // The subscription manager keeps the cells across reconnects
+    const APawn* ViewPawn = GetLocalPawn();
+    if (!IsConnected() || !ViewPawn)
+    {
+        return;
+    }
+    
+    TArray<FString> Subscribe;
+    TArray<FString> Unsubscribe;
+    if (!InterestGrid.Update(ViewPawn->GetActorLocation(), Subscribe, Unsubscribe))
+    {
+        return;
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Interest moved - %d queries added, %d released, %d cells active"),
+        Subscribe.Num(), Unsubscribe.Num(), InterestGrid.GetNumCells());
+    
+    // Other systems may hold the same cells; the subscription manager only sends what nobody else has
+    Client.GetSubscriptions().AddQueries(Subscribe);
+    if (Unsubscribe.Num() > 0)
+    {
+        Client.GetSubscriptions().RemoveQueries(Unsubscribe);
+        ReleaseObjectsOutOfInterest();
+    }
+}
+
+void USpacetimeDBSubsystem::ReleaseInterest()
+{
+    if (InterestGrid.IsActive())
+    {
+        TArray<FString> Queries;
+        InterestGrid.Reset(&Queries);
+        Client.GetSubscriptions().RemoveQueries(Queries);
+    }
+}
+
+void USpacetimeDBSubsystem::ReleaseObjectsOutOfInterest()
+{
+    const int64 LocalClientId = static_cast<int64>(Client.GetClientID());
+    
+    // The local client's own objects stay regardless of where they are
+    auto IsReleasable = [this, LocalClientId](int64 ObjectId, const FVector& Location)
+    {
+        return !InterestGrid.IsInInterest(Location) && (LocalClientId == 0 || GetOwnerClientId(ObjectId) != LocalClientId);
+    };
+    
+    TArray<int64> Released;
+    for (const TPair<int64, UObject*>& Entry : ObjectRegistry)
+    {
+        const AActor* Actor = Cast<AActor>(Entry.Value);
+        if (Actor && Actor->GetRootComponent() && IsReleasable(Entry.Key, Actor->GetActorLocation()))
+        {
+            Released.Add(Entry.Key);
+        }
+    }
+    
+    for (const int64 ObjectId : Released)
+    {
+        OnObjectDestroyed.Broadcast(ObjectId);
+        DestroyObjectFromServer(ObjectId);
+    }
+    
+    TArray<int64> Cancelled;
+    for (const FSpacetimeDBPendingMaterialization& Entry : PendingMaterializations)
+    {
+        const uint64* Sequence = PendingMaterializationSequence.Find(Entry.ObjectId);
+        if (Sequence && *Sequence == Entry.Sequence && Entry.Snapshot.bHasTransform
+            && Entry.Snapshot.OwnerClientId != LocalClientId
+            && !InterestGrid.IsInInterest(Entry.Snapshot.Transform.GetLocation()))
+        {
+            Cancelled.Add(Entry.ObjectId);
+        }
+    }
+    
+    for (const int64 ObjectId : Cancelled)
+    {
+        CancelMaterialization(ObjectId);
+    }
+    
+    // The server stops updating proxies outside the cells as well
+    TArray<int64> Forgotten;
+    for (const FSpacetimeDBProxyEntity& Proxy : Proxies.GetEntities())
+    {
+        if ((LocalClientId == 0 || Proxy.OwnerClientId != LocalClientId) && !InterestGrid.IsInInterest(Proxy.Transform.GetLocation()))
+        {
+            Forgotten.Add(Proxy.ObjectId);
+        }
+    }
+    
+    for (const int64 ObjectId : Forgotten)
+    {
+        Proxies.Remove(ObjectId);
+    }
+    
+    if (Released.Num() > 0 || Cancelled.Num() > 0 || Forgotten.Num() > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Released %d objects, %d queued creations and %d proxies outside the interest area"),
+            Released.Num(), Cancelled.Num(), Forgotten.Num());
+    }
+}
+
+bool USpacetimeDBSubsystem::CancelMaterialization(int64 ObjectId)
+{
+    // The heap entry stays behind and is skipped when popped
+    if (PendingMaterializationSequence.Remove(ObjectId) == 0)
+    {
+        return false;
+    }
+    
+    DropPendingPropertyUpdates(MaterializationPropertyUpdates, MaterializationPropertyUpdateIndex, ObjectId);
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Cancelled queued creation of object %lld"), ObjectId);
+    return true;
+}
+
+bool USpacetimeDBSubsystem::BufferMaterializationPropertyUpdate(int64 ObjectId, FSpacetimeDBPendingPropertyUpdate& Update)
+{
+    if (!PendingMaterializationSequence.Contains(ObjectId))
+    {
+        return false;
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Buffering property %s for queued object %lld"), *Update.PropertyName, ObjectId);
+    
+    if (StagePendingPropertyUpdate(MaterializationPropertyUpdates, MaterializationPropertyUpdateIndex, ObjectId, MoveTemp(Update)))
+    {
+        ++TotalCoalescedPropertyUpdates;
+    }
+    return true;
+}
+
+float USpacetimeDBSubsystem::GetMaterializationPriority(const FSpacetimeDBPendingMaterialization& Entry, const APawn* ViewPawn) const
+{
+    if (MaterializationPriority.IsBound())
+    {
+        return MaterializationPriority.Execute(Entry.ObjectId, Entry.ObjectClass.Get(), Entry.Snapshot, ViewPawn);
+    }
+    
+    // Objects this client owns come before everything else
+    const uint64 MyClientId = GetClientId();
+    if (MyClientId != 0 && Entry.Snapshot.OwnerClientId == static_cast<int64>(MyClientId))
+    {
+        return -1.0f;
+    }
+    
+    // Then nearest first; without a pawn (or a transform) everything keeps arrival order
+    if (!ViewPawn || !Entry.Snapshot.bHasTransform)
+    {
+        return 0.0f;
+    }
+    return static_cast<float>(FVector::DistSquared(ViewPawn->GetActorLocation(), Entry.Snapshot.Transform.GetLocation()));
+}
+
+const APawn* USpacetimeDBSubsystem::GetLocalPawn() const
+{
+    const UGameInstance* GameInstance = GetGameInstance();
+    const APlayerController* PlayerController = GameInstance ? GameInstance->GetFirstLocalPlayerController() : nullptr;
+    return PlayerController ? PlayerController->GetPawn() : nullptr;
+}
+
+bool USpacetimeDBSubsystem::GetRelevanceOrigin(FVector& OutLocation) const
+{
+    const UGameInstance* GameInstance = GetGameInstance();
+    const APlayerController* PlayerController = GameInstance ? GameInstance->GetFirstLocalPlayerController() : nullptr;
+    if (!PlayerController)
+    {
+        return false;
+    }
+    
+    if (const APawn* Pawn = PlayerController->GetPawn())
+    {
+        OutLocation = Pawn->GetActorLocation();
+        return true;
+    }
+    
+    // Spectating or not spawned yet: the camera stands in for the pawn
+    FRotator ViewRotation;
+    PlayerController->GetPlayerViewPoint(OutLocation, ViewRotation);
+    return true;
+}
+
+bool USpacetimeDBSubsystem::ShouldStartAsProxy(const FSpacetimeDBPendingMaterialization& Entry) const
+{
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    if (!Settings->bEnableProxyEntities || !Entry.Snapshot.bHasTransform || ObjectRegistry.Contains(Entry.ObjectId))
+    {
+        return false;
+    }
+    
+    // Only actors have a place to be relevant from, and this client's own objects always spawn
+    const UClass* ObjectClass = Entry.ObjectClass.Get();
+    const uint64 MyClientId = GetClientId();
+    if (!ObjectClass || !ObjectClass->IsChildOf(AActor::StaticClass())
+        || (MyClientId != 0 && Entry.Snapshot.OwnerClientId == static_cast<int64>(MyClientId)))
+    {
+        return false;
+    }
+    
+    FVector Origin;
+    return GetRelevanceOrigin(Origin)
+        && FVector::DistSquared(Origin, Entry.Snapshot.Transform.GetLocation()) > FMath::Square(static_cast<double>(Settings->ProxyRelevanceDistance));
+}
+
+void USpacetimeDBSubsystem::UpdateProxyRelevance()
+{
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    if (!Settings->bEnableProxyEntities)
+    {
+        // Turned off at runtime: every proxy becomes an actor again
+        while (Proxies.Num() > 0)
+        {
+            PromoteProxy(Proxies.GetEntities().Last().ObjectId);
+        }
+        return;
+    }
+    
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastProxyRelevanceCheck < Settings->ProxyRelevanceInterval)
+    {
+        return;
+    }
+    LastProxyRelevanceCheck = Now;
+    
+    FVector Origin;
+    if (!GetRelevanceOrigin(Origin))
+    {
+        return;
+    }
+    
+    const int64 LocalClientId = static_cast<int64>(Client.GetClientID());
+    const double PromoteDistanceSquared = FMath::Square(static_cast<double>(Settings->ProxyRelevanceDistance));
+    const double DemoteDistanceSquared = FMath::Square(static_cast<double>(Settings->ProxyRelevanceDistance + Settings->ProxyRelevanceHysteresis));
+    
+    // Proxies that came into range, or that turned out to be this client's
+    TArray<int64> Promoted;
+    for (const FSpacetimeDBProxyEntity& Proxy : Proxies.GetEntities())
+    {
+        if ((LocalClientId != 0 && Proxy.OwnerClientId == LocalClientId)
+            || FVector::DistSquared(Origin, Proxy.Transform.GetLocation()) <= PromoteDistanceSquared)
+        {
+            Promoted.Add(Proxy.ObjectId);
+        }
+    }
+    
+    for (const int64 ObjectId : Promoted)
+    {
+        PromoteProxy(ObjectId);
+    }
+    
+    // Actors beyond the hysteresis band; the pawn, this client's objects and anything it sends changes for stay
+    const APawn* ViewPawn = GetLocalPawn();
+    TArray<TPair<int64, AActor*>> Demoted;
+    for (const TPair<int64, UObject*>& Entry : ObjectRegistry)
+    {
+        AActor* Actor = Cast<AActor>(Entry.Value);
+        if (!IsValid(Actor) || Actor == ViewPawn || !Actor->GetRootComponent()
+            || (LocalClientId != 0 && GetOwnerClientId(Entry.Key) == LocalClientId)
+            || AutoReplication.IsTracked(Entry.Key) || PendingMaterializationSequence.Contains(Entry.Key))
+        {
+            continue;
+        }
+        
+        if (FVector::DistSquared(Origin, Actor->GetActorLocation()) > DemoteDistanceSquared)
+        {
+            Demoted.Emplace(Entry.Key, Actor);
+        }
+    }
+    
+    for (const TPair<int64, AActor*>& Entry : Demoted)
+    {
+        DemoteToProxy(Entry.Key, Entry.Value);
+    }
+    
+    if (Promoted.Num() > 0 || Demoted.Num() > 0)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Promoted %d proxies and demoted %d actors, %d proxies kept"),
+            Promoted.Num(), Demoted.Num(), Proxies.Num());
+    }
+}
+
+bool USpacetimeDBSubsystem::PromoteProxy(int64 ObjectId)
+{
+    FSpacetimeDBProxyEntity Proxy;
+    if (!Proxies.Remove(ObjectId, &Proxy))
+    {
+        return false;
+    }
+    FSpacetimeDBProxyStore::DetachFromCache(Proxy);
+    
+    // The recorded values are newer than the snapshot, so they are buffered for the spawn like any other early update
+    FSpacetimeDBProxyStore::VisitProperties(Proxy, [this, ObjectId](FString&& PropertyName, FString&& ValueJson, TArray<uint8>&& Payload, bool bBinary)
+    {
+        FSpacetimeDBPendingPropertyUpdate Update;
+        Update.PropertyName = MoveTemp(PropertyName);
+        Update.ValueJson = MoveTemp(ValueJson);
+        Update.Payload = MoveTemp(Payload);
+        Update.bBinary = bBinary;
+        StagePendingPropertyUpdate(MaterializationPropertyUpdates, MaterializationPropertyUpdateIndex, ObjectId, MoveTemp(Update));
+    });
+    
+    FSpacetimeDBPendingMaterialization Entry;
+    Entry.ObjectId = ObjectId;
+    Entry.ObjectClass = Proxy.ObjectClass;
+    Entry.ClassName = MoveTemp(Proxy.ClassName);
+    
+    // Demoted actors have no snapshot; all of their values are in the records
+    Entry.DataJson = Proxy.DataJson.IsEmpty() ? FString(TEXT("{}")) : MoveTemp(Proxy.DataJson);
+    Entry.Snapshot.bHasTransform = true;
+    Entry.Snapshot.Transform = Proxy.Transform;
+    Entry.Snapshot.OwnerClientId = Proxy.OwnerClientId;
+    Entry.bSnapshotTransformIsNewer = true;
+    Entry.Sequence = NextMaterializationSequence++;
+    
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Promoting proxy %lld"), ObjectId);
+    EnqueueMaterialization(MoveTemp(Entry));
+    return true;
+}
+
+void USpacetimeDBSubsystem::DemoteToProxy(int64 ObjectId, AActor* Actor)
+{
+    FSpacetimeDBProxyEntity& Proxy = Proxies.Add(ObjectId);
+    Proxy.ObjectClass = Actor->GetClass();
+    Proxy.Transform = Actor->GetActorTransform();
+    Proxy.OwnerClientId = GetOwnerClientId(ObjectId);
+    FSpacetimeDBProxyStore::CaptureProperties(Proxy, Actor);
+    
+    // Values that arrived this frame but weren't applied yet are newer than the captured ones
+    if (const int32* StagedIndex = PendingPropertyUpdateIndex.Find(ObjectId))
+    {
+        for (const FSpacetimeDBPendingPropertyUpdate& Update : PendingPropertyUpdates[*StagedIndex].Properties)
+        {
+            if (Update.bBinary)
+            {
+                FSpacetimeDBProxyStore::StoreProperty(Proxy, Update.PropertyName, Update.Payload);
+            }
+            else
+            {
+                FSpacetimeDBProxyStore::StoreProperty(Proxy, Update.PropertyName, Update.ValueJson);
+            }
+            for (const TArray<uint8>& Delta : Update.Deltas)
+            {
+                FSpacetimeDBProxyStore::StoreProperty(Proxy, Update.PropertyName, Delta);
+            }
+        }
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Demoting actor %s (ID: %lld) to a proxy"), *Actor->GetName(), ObjectId);
+    
+    // Listeners see the actor go away; it is announced again when it is promoted
+    OnObjectDestroyed.Broadcast(ObjectId);
+    DestroyObjectFromServer(ObjectId);
+}
+
+bool USpacetimeDBSubsystem::StoreProxyProperty(int64 ObjectId, const FString& PropertyName, const FString& ValueJson)
+{
+    FSpacetimeDBProxyEntity* Proxy = Proxies.Find(ObjectId);
+    if (!Proxy)
+    {
+        return false;
+    }
+    
+    FSpacetimeDBProxyStore::StoreProperty(*Proxy, PropertyName, ValueJson);
+    
+    int64 OwnerClientId = 0;
+    if (IsOwnerProperty(PropertyName) && ParseOwnerClientId(ValueJson, OwnerClientId))
+    {
+        OnProxyOwnerChanged(ObjectId, *Proxy, OwnerClientId);
+    }
+    return true;
+}
+
+bool USpacetimeDBSubsystem::StoreProxyProperty(int64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload)
+{
+    FSpacetimeDBProxyEntity* Proxy = Proxies.Find(ObjectId);
+    if (!Proxy)
+    {
+        return false;
+    }
+    
+    FSpacetimeDBProxyStore::StoreProperty(*Proxy, PropertyName, Payload);
+    
+    int64 OwnerClientId = 0;
+    if (IsOwnerProperty(PropertyName) && ParseOwnerClientId(Payload, OwnerClientId))
+    {
+        OnProxyOwnerChanged(ObjectId, *Proxy, OwnerClientId);
+    }
+    return true;
+}
+
+void USpacetimeDBSubsystem::OnProxyOwnerChanged(int64 ObjectId, FSpacetimeDBProxyEntity& Proxy, int64 OwnerClientId)
+{
+    Proxy.OwnerClientId = OwnerClientId;
+    
+    // This client always gets the actors it owns; proxies owned by others stay proxies
+    const uint64 MyClientId = GetClientId();
+    if (MyClientId != 0 && OwnerClientId == static_cast<int64>(MyClientId))
+    {
+        PromoteProxy(ObjectId);
+    }
+}
+
+bool USpacetimeDBSubsystem::GetProxyTransform(int64 ObjectId, FTransform& OutTransform) const
+{
+    const FSpacetimeDBProxyEntity* Proxy = Proxies.Find(ObjectId);
+    if (!Proxy)
+    {
+        return false;
+    }
+    OutTransform = Proxy->Transform;
+    return true;
+}
+
+void USpacetimeDBSubsystem::InternalHandleObjectDestroyed(uint64 ObjectId)
+{
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Object destroyed event - ID: %llu"), ObjectId);
+    
+    UnconfirmedObjects.Remove(static_cast<int64>(ObjectId));
+    
+    // An object that never spawned, or is only a proxy now, was never announced either
+    if (CancelMaterialization(static_cast<int64>(ObjectId)) || Proxies.Remove(static_cast<int64>(ObjectId)))
+    {
+        return;
+    }
+    
+    // Broadcast the object destroyed event before actually destroying it
+    OnObjectDestroyed.Broadcast(ObjectId);
+    
+    // Destroy the object
+    DestroyObjectFromServer(ObjectId);
+}
+
+void USpacetimeDBSubsystem::InternalHandleObjectIdRemapped(uint64 TempId, uint64 ServerId)
+{
+    UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Object ID remapped - Temp ID: %llu, Server ID: %llu"), TempId, ServerId);
+    
+    // Broadcast the object ID remapped event
+    OnObjectIdRemapped.Broadcast(TempId, ServerId);
+    
+    // TODO: Implement ID remapping in the object registry
+}
+
+// Add methods for setting properties
+
+bool USpacetimeDBSubsystem::SetPropertyValueFromJson(int64 ObjectId, const FString& PropertyName, const FString& ValueJson, bool bReplicateToServer)
+{
+    if (!IsConnected())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SetPropertyValueFromJson - Not connected to SpacetimeDB"));
+        return false;
+    }
+    
+    // SECURITY: Check if client has authority to modify this object
+    if (bReplicateToServer && !HasAuthority(ObjectId))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SetPropertyValueFromJson - Client does not have authority to modify object %lld"), ObjectId);
+        return false;
+    }
+    
+    // Find the object in our registry
+    UObject* Object = FindObjectById(ObjectId);
+    if (!Object)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SetPropertyValueFromJson - Object with ID %lld not found"), ObjectId);
+        return false;
+    }
+    
+    // Try to apply the property to the object
+    bool bSuccess = FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Object, PropertyName, ValueJson);
+    
+    // If successful and we need to replicate to server, send the update
+    if (bSuccess && bReplicateToServer)
+    {
+        SendPropertyUpdateToServer(ObjectId, PropertyName, ValueJson);
+    }
+    
+    return bSuccess;
+}
+
+bool USpacetimeDBSubsystem::SetPropertyValue(int64 ObjectId, const FString& PropertyName, UObject* Object, bool bReplicateToServer)
+{
+    if (!Object)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Cannot set property value with null object. Property: %s"), *PropertyName);
+        return false;
+    }
+
+    UObject* TargetObject = FindObjectById(ObjectId);
+
+    if (!USpacetimeDBSettings::Get()->bUseJsonPropertyEncoding)
+    {
+        // Encode straight from the source object's memory
+        TArray<uint8> Payload;
+        if (!FSpacetimeDBBinaryCodec::SerializePropertyToBinary(Object, PropertyName, Payload))
+        {
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to serialize property %s on object %s"), 
+                *PropertyName, *Object->GetName());
+            return false;
+        }
+
+        if (TargetObject && TargetObject != Object)
+        {
+            if (!FSpacetimeDBBinaryCodec::ApplyBinaryToProperty(TargetObject, PropertyName, Payload.GetData(), Payload.Num()))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Failed to apply property %s locally to target object %s"), 
+                    *PropertyName, *TargetObject->GetName());
+                // Continue anyway to try server update
+            }
+        }
+
+        return bReplicateToServer ? SendPropertyBinaryUpdateToServer(ObjectId, PropertyName, Payload) : true;
+    }
+
+    // Serialize the property value to JSON
+    FString ValueJson = FSpacetimeDBPropertyHelper::SerializePropertyToJson(Object, PropertyName);
+    if (ValueJson.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to serialize property %s on object %s"), 
+            *PropertyName, *Object->GetName());
+        return false;
+    }
+
+    // Apply locally first if Object isn't the target (it's a different object with the same property)
+    if (TargetObject && TargetObject != Object)
+    {
+        bool bLocalSuccess = FSpacetimeDBPropertyHelper::ApplyJsonToProperty(TargetObject, PropertyName, ValueJson);
+        if (!bLocalSuccess)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Failed to apply property %s locally to target object %s"), 
+                *PropertyName, *TargetObject->GetName());
+            // Continue anyway to try server update
+        }
+    }
+
+    // If we should replicate to the server, send the update
+    if (bReplicateToServer)
+    {
+        return SendPropertyUpdateToServer(ObjectId, PropertyName, ValueJson);
+    }
+
+    return true;
+}
+
+bool USpacetimeDBSubsystem::SetAutoReplicationEnabled(int64 ObjectId, bool bEnabled)
+{
+    if (!bEnabled)
+    {
+        AutoReplication.Untrack(ObjectId);
+        return true;
+    }
+    
+    if (AutoReplication.IsTracked(ObjectId))
+    {
+        return true;
+    }
+    
+    UObject* Object = FindObjectById(ObjectId);
+    if (!Object)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SetAutoReplicationEnabled - Object with ID %lld not found"), ObjectId);
+        return false;
+    }
+    
+    // The shadow starts from the current values; only changes from here on are sent
+    if (!AutoReplication.Track(ObjectId, Object))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Object %s (ID: %lld) has no replicated properties to auto-replicate"), *Object->GetName(), ObjectId);
+        return false;
+    }
+    return true;
+}
+
+void USpacetimeDBSubsystem::UpdateAutoReplication()
+{
+    if (AutoReplication.Num() == 0 || !IsConnected())
+    {
+        return;
+    }
+    
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    AutoReplication.CollectChanges(FPlatformTime::Seconds(), Settings->AutoReplicationInterval, Settings->AutoReplicationObjectsPerFrame,
+        [this](int64 ObjectId, UObject* Object, const FSpacetimeDBPropertyDescriptor& Descriptor,
+            const TArray<uint8>* PreviousEncoding, const TArray<uint8>* CurrentEncoding)
+        {
+            ReplicateChangedProperty(ObjectId, Object, Descriptor, PreviousEncoding, CurrentEncoding);
+        });
+}
+
+void USpacetimeDBSubsystem::ReplicateChangedProperty(int64 ObjectId, UObject* Object, const FSpacetimeDBPropertyDescriptor& Descriptor,
+    const TArray<uint8>* PreviousEncoding, const TArray<uint8>* CurrentEncoding)
+{
+    // Objects this client lost authority over keep their shadow current but send nothing
+    if (!HasAuthority(ObjectId))
+    {
+        return;
+    }
+    
+    const FString PropertyName = Descriptor.Name.ToString();
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Auto-replicating changed property %s of object %lld"), *PropertyName, ObjectId);
+    
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    if (!Settings->bUseJsonPropertyEncoding)
+    {
+        if (PreviousEncoding && CurrentEncoding)
+        {
+            // The server holds the previous encoding unless a full value for it is still waiting to be sent
+            if (Settings->bSendPropertyDeltas && FSpacetimeDBBinaryCodec::SupportsDelta(Descriptor.Property) && !IsPropertyDirty(ObjectId, PropertyName))
+            {
+                TArray<uint8> Delta;
+                if (FSpacetimeDBBinaryCodec::EncodeDelta(Descriptor.Property, PreviousEncoding->GetData(), PreviousEncoding->Num(), Descriptor.GetValuePtr(Object), Delta)
+                    && Delta.Num() < CurrentEncoding->Num())
+                {
+                    SendPropertyBinaryUpdateToServer(ObjectId, PropertyName, Delta);
+                    return;
+                }
+            }
+            
+            // The shadow state already encoded the current value
+            SendPropertyBinaryUpdateToServer(ObjectId, PropertyName, *CurrentEncoding);
+            return;
+        }
+        
+        TArray<uint8> Payload;
+        if (FSpacetimeDBBinaryCodec::EncodeProperty(Descriptor, Object, Payload))
+        {
+            SendPropertyBinaryUpdateToServer(ObjectId, PropertyName, Payload);
+            return;
+        }
+    }
+    
+    const FString ValueJson = FSpacetimeDBPropertyHelper::SerializePropertyToJson(Object, PropertyName);
+    if (!ValueJson.IsEmpty())
+    {
+        SendPropertyUpdateToServer(ObjectId, PropertyName, ValueJson);
+    }
+}
+
+bool USpacetimeDBSubsystem::IsPropertyDirty(int64 ObjectId, const FString& PropertyName) const
+{
+    const int32* ObjectIndex = DirtyPropertyUpdateIndex.Find(ObjectId);
+    return ObjectIndex && DirtyPropertyUpdates[*ObjectIndex].PropertyIndex.Contains(PropertyName);
+}
+
+bool USpacetimeDBSubsystem::ApplyBinaryPropertyPayload(int64 ObjectId, UObject* Object, const FSpacetimeDBPropertyDescriptor& Descriptor, const uint8* Data, int32 Size)
+{
+    if (!FSpacetimeDBBinaryCodec::IsDelta(Data, Size))
+    {
+        return FSpacetimeDBBinaryCodec::DecodeProperty(Descriptor, Object, Data, Size);
+    }
+    
+    const ESpacetimeDBDeltaResult Result = FSpacetimeDBBinaryCodec::ApplyDelta(Descriptor, Object, Data, Size);
+    if (Result == ESpacetimeDBDeltaResult::Applied)
+    {
+        return true;
+    }
+    
+    // The local value is no longer the one the delta was made against; only a full value fixes that
+    UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: %s delta for property %s of object %lld, requesting the full value"),
+        Result == ESpacetimeDBDeltaResult::BaseMismatch ? TEXT("Stale") : TEXT("Malformed"), *Descriptor.Name.ToString(), ObjectId);
+    RequestPropertyResync(ObjectId, Descriptor.Name);
+    return false;
+}
+
+void USpacetimeDBSubsystem::RequestPropertyResync(int64 ObjectId, FName PropertyName)
+{
+    if (!IsConnected())
+    {
+        return;
+    }
+    
+    // A burst of deltas on a stale base would otherwise ask once per delta
+    const double Now = FPlatformTime::Seconds();
+    double& LastRequest = LastPropertyResyncRequest.FindOrAdd(TPair<int64, FName>(ObjectId, PropertyName), -DBL_MAX);
+    if (Now - LastRequest < 1.0)
+    {
+        return;
+    }
+    LastRequest = Now;
+    
+    Client.SelectConnection();
+    SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_RequestPropertyResync);
+    request_property_resync(static_cast<uint64>(ObjectId), TCHAR_TO_UTF8(*PropertyName.ToString()));
+}
+
+bool USpacetimeDBSubsystem::SendPropertyUpdateToServer(int64 ObjectId, const FString& PropertyName, const FString& ValueJson)
+{
+    if (!IsConnected())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SendPropertyUpdateToServer - Not connected to SpacetimeDB"));
+        return false;
+    }
+    
+    // SECURITY: Check if client has authority to modify this object
+    if (!HasAuthority(ObjectId))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SendPropertyUpdateToServer - Client does not have authority to modify object %lld"), ObjectId);
+        return false;
+    }
+    
+    // Prefer the binary encoding when the value has already been applied to a registered object
+    if (!USpacetimeDBSettings::Get()->bUseJsonPropertyEncoding)
+    {
+        TArray<uint8> Payload;
+        UObject* Object = FindObjectById(ObjectId);
+        if (Object && FSpacetimeDBBinaryCodec::SerializePropertyToBinary(Object, PropertyName, Payload))
+        {
+            return SendPropertyBinaryUpdateToServer(ObjectId, PropertyName, Payload);
+        }
+    }
+    
+    if (USpacetimeDBSettings::Get()->bBatchPropertyUpdates)
+    {
+        FSpacetimeDBPendingPropertyUpdate Update;
+        Update.PropertyName = PropertyName;
+        Update.ValueJson = ValueJson;
+        MarkPropertyDirty(ObjectId, MoveTemp(Update));
+        return true;
+    }
+    
+    // Call the FFI function
+    Client.SelectConnection();
+    SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_SetProperty);
+    INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, PropertyName.Len() + ValueJson.Len());
+    stdb::ffi::set_property(ObjectId, TCHAR_TO_UTF8(*PropertyName), TCHAR_TO_UTF8(*ValueJson), true);
+    return true;
+}
+
+bool USpacetimeDBSubsystem::SendPropertyBinaryUpdateToServer(int64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload)
+{
+    if (!IsConnected())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SendPropertyBinaryUpdateToServer - Not connected to SpacetimeDB"));
+        return false;
+    }
+    
+    // SECURITY: Check if client has authority to modify this object
+    if (!HasAuthority(ObjectId))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SendPropertyBinaryUpdateToServer - Client does not have authority to modify object %lld"), ObjectId);
+        return false;
+    }
+    
+    if (USpacetimeDBSettings::Get()->bBatchPropertyUpdates)
+    {
+        FSpacetimeDBPendingPropertyUpdate Update;
+        Update.PropertyName = PropertyName;
+        Update.Payload = Payload;
+        Update.bBinary = true;
+        MarkPropertyDirty(ObjectId, MoveTemp(Update));
+        return true;
+    }
+    
+    // Call the FFI function
+    Client.SelectConnection();
+    SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_SetPropertyBinary);
+    INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, PropertyName.Len() + Payload.Num());
+    return set_property_binary(static_cast<uint64>(ObjectId), TCHAR_TO_UTF8(*PropertyName), Payload.GetData(), Payload.Num(), true);
+}
+
+void USpacetimeDBSubsystem::MarkPropertyDirty(int64 ObjectId, FSpacetimeDBPendingPropertyUpdate&& Update)
+{
+    UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Property marked dirty - Object %lld, Property %s"), ObjectId, *Update.PropertyName);
+    
+    StagePendingPropertyUpdate(DirtyPropertyUpdates, DirtyPropertyUpdateIndex, ObjectId, MoveTemp(Update));
+}
+
+void USpacetimeDBSubsystem::FlushDirtyPropertyUpdates()
+{
+    if (DirtyPropertyUpdates.Num() == 0)
+    {
+        return;
+    }
+    
+    if (!IsConnected())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Dropping dirty properties of %d objects - Not connected to SpacetimeDB"), DirtyPropertyUpdates.Num());
+        DirtyPropertyUpdates.Reset();
+        DirtyPropertyUpdateIndex.Reset();
+        return;
+    }
+    
+    TArray<FSpacetimeDBPendingObjectUpdates> Batch = MoveTemp(DirtyPropertyUpdates);
+    DirtyPropertyUpdates.Reset();
+    DirtyPropertyUpdateIndex.Reset();
+    
+    const double Now = FPlatformTime::Seconds();
+    
+    // Interned IDs replace names for every property the server has announced
+    const bool bUsePropertyIds = USpacetimeDBSettings::Get()->bUseInternedPropertyIds;
+    
+    // Object count is patched in once we know how many objects made it into this frame
+    PropertyBatchBuffer.Reset();
+    FSpacetimeDBBinaryWriter Writer(PropertyBatchBuffer);
+    Writer.WriteUInt32(0);
+    uint32 ObjectCount = 0;
+    
+    for (FSpacetimeDBPendingObjectUpdates& ObjectUpdates : Batch)
+    {
+        if (ObjectUpdates.Properties.Num() == 0)
+        {
+            continue;
+        }
+        
+        const int64 ObjectId = ObjectUpdates.ObjectId;
+        UObject* Object = FindObjectById(ObjectId);
+        
+        // Over this frame's uplink budget; the values keep merging until the object's turn comes
+        if (!IsOutboundReleased(ObjectId))
+        {
+            for (FSpacetimeDBPendingPropertyUpdate& Update : ObjectUpdates.Properties)
+            {
+                StagePendingPropertyUpdate(DirtyPropertyUpdates, DirtyPropertyUpdateIndex, ObjectId, MoveTemp(Update));
+            }
+            continue;
+        }
+        
+        // Respect the class flush rate; rate-limited objects stay dirty and keep accumulating
+        const double FlushInterval = Object ? GetPropertyFlushInterval(Object->GetClass()) : 0.0;
+        if (FlushInterval > 0.0)
+        {
+            const double* LastFlush = LastPropertyFlushTime.Find(ObjectId);
+            if (LastFlush && Now - *LastFlush < FlushInterval)
+            {
+                for (FSpacetimeDBPendingPropertyUpdate& Update : ObjectUpdates.Properties)
+                {
+                    StagePendingPropertyUpdate(DirtyPropertyUpdates, DirtyPropertyUpdateIndex, ObjectId, MoveTemp(Update));
+                }
+                continue;
+            }
+            LastPropertyFlushTime.Add(ObjectId, Now);
+        }
+        
+        // SECURITY: Authority may have changed since the property was marked dirty
+        if (!HasAuthority(ObjectId))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: FlushDirtyPropertyUpdates - Client no longer has authority to modify object %lld"), ObjectId);
+            continue;
+        }
+        
+        uint32 BinaryCount = 0;
+        for (const FSpacetimeDBPendingPropertyUpdate& Update : ObjectUpdates.Properties)
+        {
+            if (Update.bBinary)
+            {
+                ++BinaryCount;
+            }
+            else
+            {
+                // JSON values have no batched form
+                Client.SelectConnection();
+                SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_SetProperty);
+                INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, Update.PropertyName.Len() + Update.ValueJson.Len());
+                stdb::ffi::set_property(ObjectId, TCHAR_TO_UTF8(*Update.PropertyName), TCHAR_TO_UTF8(*Update.ValueJson), true);
+            }
+        }
+        
+        if (BinaryCount == 0)
+        {
+            continue;
+        }
+        
+        Writer.WriteUInt64(static_cast<uint64>(ObjectId));
+        Writer.WriteUInt32(BinaryCount);
+        for (const FSpacetimeDBPendingPropertyUpdate& Update : ObjectUpdates.Properties)
+        {
+            if (Update.bBinary)
+            {
+                if (bUsePropertyIds)
+                {
+                    const uint32 PropertyId = Client.FindInternedPropertyId(Update.PropertyName);
+                    Writer.WriteVarUInt64(PropertyId);
+                    if (PropertyId == 0)
+                    {
+                        Writer.WriteString(Update.PropertyName);
+                    }
+                }
+                else
+                {
+                    Writer.WriteString(Update.PropertyName);
+                }
+                Writer.WriteBytes(Update.Payload.GetData(), Update.Payload.Num());
+            }
+        }
+        ++ObjectCount;
+    }
+    
+    if (ObjectCount == 0)
+    {
+        return;
+    }
+    
+    FMemory::Memcpy(PropertyBatchBuffer.GetData(), &ObjectCount, sizeof(ObjectCount));
+    
+    Client.SelectConnection();
+    SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_SetPropertiesBinary);
+    INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, PropertyBatchBuffer.Num());
+    const bool bSent = bUsePropertyIds
+        ? set_properties_binary_by_id(PropertyBatchBuffer.GetData(), PropertyBatchBuffer.Num(), true)
+        : set_properties_binary(PropertyBatchBuffer.GetData(), PropertyBatchBuffer.Num(), true);
+    if (!bSent)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to send batched property updates for %u objects (%d bytes)"),
+            ObjectCount, PropertyBatchBuffer.Num());
+    }
+}
+
+double USpacetimeDBSubsystem::GetPropertyFlushInterval(UClass* Class)
+{
+    if (const double* Cached = PropertyFlushIntervalCache.Find(Class))
+    {
+        return *Cached;
+    }
+    
+    // The most derived listed class wins
+    const float* FlushRate = FindClassSetting(USpacetimeDBSettings::Get()->PropertyFlushRateByClass, Class);
+    const double Interval = (FlushRate && *FlushRate > 0.0f) ? 1.0 / *FlushRate : 0.0;
+    
+    PropertyFlushIntervalCache.Add(Class, Interval);
+    return Interval;
+}
+
+void USpacetimeDBSubsystem::ScheduleOutboundTraffic(float DeltaTime)
+{
+    OutboundReleasedObjects.Reset();
+    
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    bOutboundBudgetActive = Settings->OutboundBytesPerSecond > 0 && IsConnected();
+    if (!bOutboundBudgetActive)
+    {
+        return;
+    }
+    OutboundScheduler.BeginFrame(DeltaTime, static_cast<float>(Settings->OutboundBytesPerSecond), Settings->OutboundBurstSeconds);
+    
+    // One candidate per object, costed by everything it has waiting
+    TArray<FSpacetimeDBOutboundCandidate> Candidates;
+    TMap<int64, int32> CandidateIndex;
+    auto AddCost = [&Candidates, &CandidateIndex](int64 ObjectId, int32 Bytes)
+    {
+        int32& Index = CandidateIndex.FindOrAdd(ObjectId, INDEX_NONE);
+        if (Index == INDEX_NONE)
+        {
+            Index = Candidates.AddDefaulted();
+            Candidates[Index].ObjectId = ObjectId;
+        }
+        Candidates[Index].EstimatedBytes += Bytes;
+    };
+    
+    const double Now = FPlatformTime::Seconds();
+    for (const FSpacetimeDBPendingObjectUpdates& ObjectUpdates : DirtyPropertyUpdates)
+    {
+        if (ObjectUpdates.Properties.Num() == 0)
+        {
+            continue;
+        }
+        
+        // Objects waiting for their class flush rate wouldn't send this frame anyway
+        const UObject* Object = FindObjectById(ObjectUpdates.ObjectId);
+        const double FlushInterval = Object ? GetPropertyFlushInterval(Object->GetClass()) : 0.0;
+        const double* LastFlush = LastPropertyFlushTime.Find(ObjectUpdates.ObjectId);
+        if (FlushInterval > 0.0 && LastFlush && Now - *LastFlush < FlushInterval)
+        {
+            continue;
+        }
+        
+        int32 Bytes = 0;
+        for (const FSpacetimeDBPendingPropertyUpdate& Update : ObjectUpdates.Properties)
+        {
+            Bytes += Update.PropertyName.Len() + (Update.bBinary ? Update.Payload.Num() : Update.ValueJson.Len());
+            for (const TArray<uint8>& Delta : Update.Deltas)
+            {
+                Bytes += Delta.Num();
+            }
+        }
+        AddCost(ObjectUpdates.ObjectId, Bytes);
+    }
+    
+    // A quantized record without its optional fields; cells, velocities and scales only go out when they change
+    constexpr int32 EstimatedTransformBytes = 24;
+    for (const FPredictedTransformData& Transform : PendingPredictedTransforms)
+    {
+        AddCost(Transform.ObjectID.Value, EstimatedTransformBytes);
+    }
+    
+    for (const FSpacetimeDBPendingUnreliableRpc& Call : PendingUnreliableRpcs)
+    {
+        AddCost(Call.ObjectId, Call.FunctionName.Len() + Call.ParamsJson.Len());
+    }
+    
+    if (Candidates.Num() == 0)
+    {
+        return;
+    }
+    
+    FVector Origin;
+    const bool bHasOrigin = GetRelevanceOrigin(Origin);
+    const APawn* ViewPawn = GetLocalPawn();
+    for (FSpacetimeDBOutboundCandidate& Candidate : Candidates)
+    {
+        Candidate.Priority = GetOutboundPriority(Candidate.ObjectId, bHasOrigin ? &Origin : nullptr, ViewPawn);
+    }
+    
+    const int32 NumHeldBack = OutboundScheduler.Select(Candidates, DeltaTime, OutboundReleasedObjects);
+    INC_DWORD_STAT_BY(STAT_SpacetimeDB_OutboundHeldBack, NumHeldBack);
+}
+
+float USpacetimeDBSubsystem::GetOutboundPriority(int64 ObjectId, const FVector* Origin, const APawn* ViewPawn)
+{
+    UObject* Object = FindObjectById(ObjectId);
+    if (!Object)
+    {
+        return 1.0f;
+    }
+    
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    UClass* Class = Object->GetClass();
+    float Priority = 1.0f;
+    if (const float* Cached = OutboundPriorityCache.Find(Class))
+    {
+        Priority = *Cached;
+    }
+    else
+    {
+        // The most derived listed class wins; a zero priority would never accumulate enough to send
+        if (const float* ClassPriority = FindClassSetting(Settings->OutboundPriorityByClass, Class))
+        {
+            Priority = FMath::Max(*ClassPriority, 0.01f);
+        }
+        OutboundPriorityCache.Add(Class, Priority);
+    }
+    
+    const AActor* Actor = Cast<AActor>(Object);
+    if (!Actor)
+    {
+        return Priority;
+    }
+    
+    if (Actor == ViewPawn)
+    {
+        Priority *= Settings->OutboundViewPawnPriority;
+    }
+    if (Origin)
+    {
+        const double Distance = FVector::Dist(*Origin, Actor->GetActorLocation());
+        Priority /= static_cast<float>(1.0 + Distance / Settings->OutboundPriorityDistance);
+    }
+    return Priority;
+}
+
+// RPC System Implementation
+
+bool USpacetimeDBSubsystem::CallServerFunction(int64 ObjectId, const FString& FunctionName, const TArray<FStdbRpcArg>& Args)
+{
+    if (!IsConnected())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: CallServerFunction - Not connected to SpacetimeDB"));
+        return false;
+    }
+    
+    // Convert arguments to JSON
+    FString ArgsJson = SerializeRpcArguments(Args);
+    
+    // Create the RPC call JSON
+    FString RpcJson = FString::Printf(TEXT("{\"object_id\":%lld,\"function\":\"%s\",\"args\":%s}"), 
+        ObjectId, *FunctionName, *ArgsJson);
+    
+    // Call the reducer using helper
+    return CallReducerHelper(TEXT("call_function"), RpcJson);
+}
+
+bool USpacetimeDBSubsystem::CallServerFunctionUnreliable(int64 ObjectId, const FString& FunctionName, const TArray<FStdbRpcArg>& Args)
+{
+    if (!IsConnected())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: CallServerFunctionUnreliable - Not connected to SpacetimeDB"));
+        return false;
+    }
+    
+    FSpacetimeDBPendingUnreliableRpc Call;
+    Call.ObjectId = ObjectId;
+    Call.FunctionName = FunctionName;
+    Call.ParamsJson = SerializeRpcArguments(Args);
+    Call.QueuedTime = FPlatformTime::Seconds();
+    
+    // A newer call makes the unsent one obsolete; it keeps its place in the call order
+    const TPair<int64, FString> Key(ObjectId, FunctionName);
+    if (const int32* Index = PendingUnreliableRpcIndex.Find(Key))
+    {
+        PendingUnreliableRpcs[*Index] = MoveTemp(Call);
+        return true;
+    }
+    
+    PendingUnreliableRpcIndex.Add(Key, PendingUnreliableRpcs.Add(MoveTemp(Call)));
+    return true;
+}
+
+void USpacetimeDBSubsystem::FlushUnreliableRpcs()
+{
+    if (PendingUnreliableRpcs.Num() == 0)
+    {
+        return;
+    }
+    
+    if (!IsConnected())
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Dropping %d unreliable RPCs - Not connected to SpacetimeDB"), PendingUnreliableRpcs.Num());
+        PendingUnreliableRpcs.Reset();
+        PendingUnreliableRpcIndex.Reset();
+        return;
+    }
+    
+    TArray<FSpacetimeDBPendingUnreliableRpc> Calls = MoveTemp(PendingUnreliableRpcs);
+    PendingUnreliableRpcs.Reset();
+    PendingUnreliableRpcIndex.Reset();
+    
+    const double Now = FPlatformTime::Seconds();
+    const double MaxAge = USpacetimeDBSettings::Get()->UnreliableRpcMaxAge;
+    int32 NumDropped = 0;
+    
+    for (FSpacetimeDBPendingUnreliableRpc& Call : Calls)
+    {
+        // Held back calls wait for a later frame, unless they have gone stale
+        if (!IsOutboundReleased(Call.ObjectId))
         {
-            UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Failed to apply property %s locally to target object %s"), 
-                *PropertyName, *TargetObject->GetName());
-            // Continue anyway to try server update
+            if (Now - Call.QueuedTime > MaxAge)
+            {
+                ++NumDropped;
+                continue;
+            }
+            PendingUnreliableRpcIndex.Add(TPair<int64, FString>(Call.ObjectId, Call.FunctionName), PendingUnreliableRpcs.Num());
+            PendingUnreliableRpcs.Add(MoveTemp(Call));
+            continue;
         }
+        
+        Client.SelectConnection();
+        SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_DispatchUnreliableRpc);
+        INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, Call.FunctionName.Len() + Call.ParamsJson.Len());
+        stdb::ffi::dispatch_unreliable_rpc(static_cast<uint64>(Call.ObjectId), TCHAR_TO_UTF8(*Call.FunctionName), TCHAR_TO_UTF8(*Call.ParamsJson));
     }
-
-    // If we should replicate to the server, send the update
-    if (bReplicateToServer)
+    
+    if (NumDropped > 0)
     {
-        return SendPropertyUpdateToServer(ObjectId, PropertyName, ValueJson);
+        INC_DWORD_STAT_BY(STAT_SpacetimeDB_UnreliableRpcsDropped, NumDropped);
+        UE_LOG(LogTemp, Verbose, TEXT("SpacetimeDBSubsystem: Dropped %d unreliable RPCs that waited longer than %.2fs"), NumDropped, MaxAge);
     }
-
-    return true;
 }
 
-bool USpacetimeDBSubsystem::SendPropertyUpdateToServer(int64 ObjectId, const FString& PropertyName, const FString& ValueJson)
+bool USpacetimeDBSubsystem::SendTypedServerRpc(int64 ObjectId, uint32 FunctionId, const TArray<uint8>& Args)
 {
     if (!IsConnected())
     {
-        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SendPropertyUpdateToServer - Not connected to SpacetimeDB"));
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: CallServerFunctionTyped - Not connected to SpacetimeDB"));
         return false;
     }
     
-    // SECURITY: Check if client has authority to modify this object
-    if (!HasAuthority(ObjectId))
+    Client.SelectConnection();
+    SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_CallServerFunctionBinary);
+    INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, Args.Num());
+    return call_server_function_binary(static_cast<uint64>(ObjectId), FunctionId, Args.GetData(), Args.Num());
+}
+
+bool USpacetimeDBSubsystem::RegisterTypedClientFunction(const FString& FunctionName, uint32 FunctionId, FTypedClientRpcHandler Handler)
+{
+    // Two names hashing to one ID couldn't be told apart on the wire
+    if (const FString* Existing = TypedClientRpcNames.Find(FunctionId))
     {
-        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: SendPropertyUpdateToServer - Client does not have authority to modify object %lld"), ObjectId);
-        return false;
+        if (*Existing != FunctionName)
+        {
+            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Typed RPC %s has the same function ID (%u) as %s; rename one of them"),
+                *FunctionName, FunctionId, **Existing);
+            return false;
+        }
     }
     
-    // Call the FFI function
-    stdb::ffi::set_property(ObjectId, TCHAR_TO_UTF8(*PropertyName), TCHAR_TO_UTF8(*ValueJson), true);
-    return true;
+    TypedClientRpcHandlers.Add(FunctionId, MoveTemp(Handler));
+    TypedClientRpcNames.Add(FunctionId, FunctionName);
+    
+    // Registered before connecting, it's announced once the connection is up
+    if (!IsConnected())
+    {
+        return true;
+    }
+    
+    Client.SelectConnection();
+    const bool bSuccess = register_client_function_id(FunctionId, TCHAR_TO_UTF8(*FunctionName));
+    if (!bSuccess)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to register typed client function %s with FFI"), *FunctionName);
+    }
+    return bSuccess;
 }
 
-// RPC System Implementation
-
-bool USpacetimeDBSubsystem::CallServerFunction(int64 ObjectId, const FString& FunctionName, const TArray<FStdbRpcArg>& Args)
+void USpacetimeDBSubsystem::InternalHandleClientRpcBinary(uint64 ObjectId, uint32 FunctionId, const TArray<uint8>& Args)
 {
-    if (!IsConnected())
+    const FTypedClientRpcHandler* Handler = TypedClientRpcHandlers.Find(FunctionId);
+    if (!Handler)
     {
-        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: CallServerFunction - Not connected to SpacetimeDB"));
-        return false;
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: No handler registered for typed RPC function ID %u"), FunctionId);
+        return;
     }
     
-    // Convert arguments to JSON
-    FString ArgsJson = SerializeRpcArguments(Args);
-    
-    // Create the RPC call JSON
-    FString RpcJson = FString::Printf(TEXT("{\"object_id\":%lld,\"function\":\"%s\",\"args\":%s}"), 
-        ObjectId, *FunctionName, *ArgsJson);
-    
-    // Call the reducer using helper
-    return CallReducerHelper(TEXT("call_function"), RpcJson);
+    FSpacetimeDBBinaryReader Reader(Args.GetData(), Args.Num());
+    if (!(*Handler)(static_cast<int64>(ObjectId), Reader))
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Arguments of typed RPC %s (%d bytes) don't match its signature"),
+            *TypedClientRpcNames.FindRef(FunctionId), Args.Num());
+    }
 }
 
 bool USpacetimeDBSubsystem::RegisterClientFunctionWithFFI(const FString& FunctionName)
@@ -943,7 +3310,8 @@ bool USpacetimeDBSubsystem::RegisterClientFunctionWithFFI(const FString& Functio
         return false;
     }
     
-    // Register the static callback function with the FFI
+    // Register the static callback function with the FFI; it is called with the client as context
+    Client.SelectConnection();
     bool bSuccess = stdb::ffi::register_client_function(
         TCHAR_TO_UTF8(*FunctionName), 
         reinterpret_cast<uintptr_t>(&USpacetimeDBSubsystem::HandleClientRpcFromFFI)
@@ -963,31 +3331,14 @@ bool USpacetimeDBSubsystem::RegisterClientFunctionWithFFI(const FString& Functio
     return bSuccess;
 }
 
-bool USpacetimeDBSubsystem::HandleClientRpcFromFFI(uint64 ObjectId, const char* ArgsJson)
+bool USpacetimeDBSubsystem::HandleClientRpcFromFFI(uintptr_t Context, uint64 ObjectId, const char* ArgsJson)
 {
-    // This is a static function called from FFI, so we need to find the appropriate subsystem instance
-    UGameInstance* GameInstance = nullptr;
-    
-    // Find all game instances
-    for (TObjectIterator<UGameInstance> It; It; ++It)
-    {
-        GameInstance = *It;
-        if (GameInstance && IsValid(GameInstance) && GameInstance->GetWorld() && GameInstance->GetWorld()->IsGameWorld())
-        {
-            break;
-        }
-    }
-    
-    if (!GameInstance)
-    {
-        UE_LOG(LogTemp, Error, TEXT("HandleClientRpcFromFFI: Failed to find valid game instance"));
-        return false;
-    }
-    
-    USpacetimeDBSubsystem* Subsystem = GSubsystemInstances.FindRef(GameInstance);
+    // This is a static function called from FFI; the context names the client, and so the subsystem, it is for
+    const FSpacetimeDBClient* RpcClient = FSpacetimeDBClient::FromCallbackContext(Context);
+    USpacetimeDBSubsystem* Subsystem = RpcClient ? RpcClient->GetOwner() : nullptr;
     if (!Subsystem)
     {
-        UE_LOG(LogTemp, Error, TEXT("HandleClientRpcFromFFI: Failed to find SpacetimeDBSubsystem for game instance"));
+        UE_LOG(LogTemp, Error, TEXT("HandleClientRpcFromFFI: The connection has no SpacetimeDBSubsystem"));
         return false;
     }
     
@@ -1009,38 +3360,29 @@ bool USpacetimeDBSubsystem::HandleClientRpcFromFFI(uint64 ObjectId, const char*
         return false;
     }
     
-    // Extract the arguments if present
-    TSharedPtr<FJsonObject> ArgsObj;
-    TSharedPtr<FJsonValue> ArgsValue;
-    if (JsonObject->Values.Contains(TEXT("args")) && JsonObject->Values[TEXT("args")]->Type == EJson::Object)
-    {
-        ArgsObj = JsonObject->Values[TEXT("args")]->AsObject();
-    }
-    else
+    // Decode the arguments here, off the game thread; only the handler call is left for it
+    TArray<FStdbRpcArg> Args;
+    const TSharedPtr<FJsonObject>* ArgsObj = nullptr;
+    if (JsonObject->TryGetObjectField(TEXT("args"), ArgsObj))
     {
-        ArgsObj = MakeShared<FJsonObject>();
+        Args = ParseRpcArguments(**ArgsObj);
     }
     
     // Hand off to the appropriate subsystem instance on the game thread
-    AsyncTask(ENamedThreads::GameThread, [Subsystem, ObjectId, FunctionName, ArgsObj]() {
-        Subsystem->HandleClientRpc(ObjectId, FunctionName, ArgsObj);
+    AsyncTask(ENamedThreads::GameThread, [WeakSubsystem = TWeakObjectPtr<USpacetimeDBSubsystem>(Subsystem), ObjectId, FunctionName, Args = MoveTemp(Args)]() {
+        if (USpacetimeDBSubsystem* Subsystem = WeakSubsystem.Get())
+        {
+            Subsystem->HandleClientRpc(ObjectId, FunctionName, Args);
+        }
     });
     
     return true;
 }
 
-void USpacetimeDBSubsystem::HandleClientRpc(uint64 ObjectId, const FString& FunctionName, TSharedPtr<FJsonObject> ArgsObj)
+void USpacetimeDBSubsystem::HandleClientRpc(uint64 ObjectId, const FString& FunctionName, const TArray<FStdbRpcArg>& Args)
 {
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: Received client RPC %s for object %llu"), *FunctionName, ObjectId);
     
-    // Serialize the arguments to a JSON string for ParseRpcArguments
-    FString ArgsJson;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ArgsJson);
-    FJsonSerializer::Serialize(ArgsObj.ToSharedRef(), Writer);
-    
-    // Parse the arguments into a more usable format
-    TArray<FStdbRpcArg> Args = ParseRpcArguments(ArgsJson);
-    
     // Find the registered handler for this function
     if (ClientRpcHandlers.Contains(FunctionName))
     {
@@ -1070,8 +3412,16 @@ TArray<FStdbRpcArg> USpacetimeDBSubsystem::ParseRpcArguments(const FString& Args
         return Args;
     }
     
+    return ParseRpcArguments(*JsonObject);
+}
+
+TArray<FStdbRpcArg> USpacetimeDBSubsystem::ParseRpcArguments(const FJsonObject& ArgsObject)
+{
+    TArray<FStdbRpcArg> Args;
+    Args.Reserve(ArgsObject.Values.Num());
+    
     // Extract each field as an argument
-    for (auto& Pair : JsonObject->Values)
+    for (const auto& Pair : ArgsObject.Values)
     {
         FStdbRpcArg Arg;
         Arg.Name = Pair.Key;
@@ -1208,6 +3558,7 @@ FString USpacetimeDBSubsystem::GetPropertyJsonValue(int64 ObjectId, const FStrin
     
     // Call the FFI function to get the property value
     // Convert the return type properly
+    Client.SelectConnection();
     std::unique_ptr<std::string> result = stdb::ffi::get_property(ObjectId, TCHAR_TO_UTF8(*PropertyName));
     if (result) {
         return UTF8_TO_TCHAR(result->c_str());
@@ -1231,26 +3582,55 @@ FSpacetimeDBPropertyValue USpacetimeDBSubsystem::GetPropertyValue(int64 ObjectId
 
 bool USpacetimeDBSubsystem::RegisterPredictionObject(const FObjectID& ObjectID)
 {
+	Client.SelectConnection();
 	return register_prediction_object(ObjectID.Value);
 }
 
 bool USpacetimeDBSubsystem::UnregisterPredictionObject(const FObjectID& ObjectID)
 {
+	SentPredictedTransforms.Remove(ObjectID.Value);
+	if (const int32* PendingIndex = PendingPredictedTransformIndex.Find(ObjectID.Value))
+	{
+		PendingPredictedTransforms[*PendingIndex].ObjectID.Value = 0;
+		PendingPredictedTransformIndex.Remove(ObjectID.Value);
+	}
+	Client.SelectConnection();
 	return unregister_prediction_object(ObjectID.Value);
 }
 
 int32 USpacetimeDBSubsystem::GetNextPredictionSequence(const FObjectID& ObjectID)
 {
+	Client.SelectConnection();
 	return (int32)get_next_prediction_sequence(ObjectID.Value);
 }
 
 bool USpacetimeDBSubsystem::SendPredictedTransform(const FPredictedTransformData& TransformData)
 {
+	// Queue for the end-of-frame batch; a newer prediction for the same object replaces the unsent one
+	if (USpacetimeDBSettings::Get()->bQuantizePredictedTransforms)
+	{
+		if (const int32* PendingIndex = PendingPredictedTransformIndex.Find(TransformData.ObjectID.Value))
+		{
+			FPredictedTransformData& Pending = PendingPredictedTransforms[*PendingIndex];
+			if ((uint32)TransformData.SequenceNumber >= (uint32)Pending.SequenceNumber)
+			{
+				Pending = TransformData;
+			}
+		}
+		else
+		{
+			PendingPredictedTransformIndex.Add(TransformData.ObjectID.Value, PendingPredictedTransforms.Add(TransformData));
+		}
+		return true;
+	}
+	
 	// Extract the transform components
 	FVector Location = TransformData.Transform.GetLocation();
 	FQuat Rotation = TransformData.Transform.GetRotation();
 	FVector Scale = TransformData.Transform.GetScale3D();
 	
+	Client.SelectConnection();
+	SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_SendPredictedTransform);
 	return send_predicted_transform(
 		TransformData.ObjectID.Value,
 		(SequenceNumber)TransformData.SequenceNumber,
@@ -1262,32 +3642,288 @@ bool USpacetimeDBSubsystem::SendPredictedTransform(const FPredictedTransformData
 	);
 }
 
+bool USpacetimeDBSubsystem::SendPredictedTransforms(const TArray<FPredictedTransformData>& Transforms)
+{
+	if (Transforms.Num() == 0)
+	{
+		return true;
+	}
+	
+	const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+	const double CellSize = Settings->PredictionWorldCellSize;
+	const double VelocityStep = Settings->PredictionVelocityStep;
+	const uint32 FullRecordInterval = (uint32)FMath::Max(Settings->PredictionFullRecordInterval, 0);
+	
+	PredictedTransformBuffer.Reset();
+	FSpacetimeDBBinaryWriter Writer(PredictedTransformBuffer);
+	Writer.WriteFloat(Settings->PredictionWorldCellSize);
+	Writer.WriteFloat(Settings->PredictionVelocityStep);
+	
+	// Rotations and scales are narrowed for the whole batch in one pass, each rotation renormalized in
+	// the single precision it is packed from. Locations are quantized from the double values instead,
+	// since the cell offset needs the precision a float copy loses far from the origin.
+	TArray<FTransform, TInlineAllocator<16>> Poses;
+	Poses.Reserve(Transforms.Num());
+	for (const FPredictedTransformData& TransformData : Transforms)
+	{
+		Poses.Add(TransformData.Transform);
+	}
+	TArray<stdb::shared::Transform, TInlineAllocator<16>> NarrowPoses;
+	NarrowPoses.SetNumUninitialized(Poses.Num());
+	FSpacetimeDBTypeConversions::ToStdbTransforms(Poses, NarrowPoses);
+	
+	// Records are only committed as the new baseline once the server has them
+	TArray<FSpacetimeDBQuantizedTransform, TInlineAllocator<16>> Sent;
+	Sent.Reserve(Transforms.Num());
+	
+	// Index in Sent of each object's latest record, the baseline of a later record for it in this batch
+	TMap<uint64, int32> BatchRecords;
+	
+	for (int32 Index = 0; Index < Transforms.Num(); ++Index)
+	{
+		const FPredictedTransformData& TransformData = Transforms[Index];
+		if (TransformData.ObjectID.Value == 0)
+		{
+			continue;
+		}
+		
+		const stdb::shared::Transform& NarrowPose = NarrowPoses[Index];
+		FSpacetimeDBQuantizedTransform Record;
+		Record.ObjectId = TransformData.ObjectID.Value;
+		Record.Sequence = (uint32)TransformData.SequenceNumber;
+		Record.Rotation = FSpacetimeDBTypeConversions::PackQuatSmallestThree(
+			FQuat(NarrowPose.rotation.x, NarrowPose.rotation.y, NarrowPose.rotation.z, NarrowPose.rotation.w));
+		Record.Scale = FVector3f(NarrowPose.scale.x, NarrowPose.scale.y, NarrowPose.scale.z);
+		FSpacetimeDBTypeConversions::QuantizeLocation(TransformData.Transform.GetLocation(), CellSize, Record.Cell, Record.CellOffset);
+		FSpacetimeDBTypeConversions::QuantizeVelocity(TransformData.bHasVelocity ? TransformData.Velocity : FVector::ZeroVector, VelocityStep, Record.Velocity);
+		
+		// The baseline advances when a record is sent, not when the server confirms it, so crossing an
+		// interval boundary sends every field again in case the receiver missed a change
+		const int32* BatchIndex = BatchRecords.Find(Record.ObjectId);
+		const FSpacetimeDBQuantizedTransform* Previous = BatchIndex ? &Sent[*BatchIndex] : SentPredictedTransforms.Find(TransformData.ObjectID.Value);
+		if (Previous && FullRecordInterval > 0 && Record.Sequence / FullRecordInterval != Previous->Sequence / FullRecordInterval)
+		{
+			Previous = nullptr;
+		}
+		if (!Previous || Previous->Cell != Record.Cell)
+		{
+			Record.Flags |= ESpacetimeDBQuantizedTransformFlags::HasCell;
+		}
+		if (!Previous || FMemory::Memcmp(Previous->Velocity, Record.Velocity, sizeof(Record.Velocity)) != 0)
+		{
+			Record.Flags |= ESpacetimeDBQuantizedTransformFlags::HasVelocity;
+		}
+		if (!Previous || !Previous->Scale.Equals(Record.Scale, UE_KINDA_SMALL_NUMBER))
+		{
+			Record.Flags |= ESpacetimeDBQuantizedTransformFlags::HasScale;
+		}
+		else
+		{
+			// Keep the baseline the server has rather than drifting below the tolerance
+			Record.Scale = Previous->Scale;
+		}
+		
+		FSpacetimeDBTypeConversions::WriteQuantizedTransform(Writer, Record);
+		BatchRecords.Add(Record.ObjectId, Sent.Add(Record));
+	}
+	
+	if (Sent.Num() == 0)
+	{
+		return true;
+	}
+	
+	Client.SelectConnection();
+	SPACETIMEDB_SCOPE_FFI_CALL(SpacetimeDB_SendPredictedTransforms);
+	INC_DWORD_STAT_BY(STAT_SpacetimeDB_BytesOut, PredictedTransformBuffer.Num());
+	if (!send_predicted_transforms_quantized(PredictedTransformBuffer.GetData(), PredictedTransformBuffer.Num(), (uint32)Sent.Num()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to send %d predicted transforms (%d bytes)"),
+			Sent.Num(), PredictedTransformBuffer.Num());
+		return false;
+	}
+	
+	for (const FSpacetimeDBQuantizedTransform& Record : Sent)
+	{
+		SentPredictedTransforms.Add((int64)Record.ObjectId, Record);
+	}
+	return true;
+}
+
+void USpacetimeDBSubsystem::FlushPredictedTransforms()
+{
+	if (PendingPredictedTransforms.Num() == 0)
+	{
+		return;
+	}
+	
+	if (IsConnected() && bOutboundBudgetActive)
+	{
+		// Held back transforms stay queued; a newer prediction replaces them as usual
+		TArray<FPredictedTransformData> Released;
+		TArray<FPredictedTransformData> HeldBack;
+		for (const FPredictedTransformData& TransformData : PendingPredictedTransforms)
+		{
+			(IsOutboundReleased(TransformData.ObjectID.Value) ? Released : HeldBack).Add(TransformData);
+		}
+		SendPredictedTransforms(Released);
+		
+		PendingPredictedTransforms = MoveTemp(HeldBack);
+		PendingPredictedTransformIndex.Reset();
+		for (int32 Index = 0; Index < PendingPredictedTransforms.Num(); ++Index)
+		{
+			PendingPredictedTransformIndex.Add(PendingPredictedTransforms[Index].ObjectID.Value, Index);
+		}
+		return;
+	}
+	
+	if (IsConnected())
+	{
+		SendPredictedTransforms(PendingPredictedTransforms);
+	}
+	
+	PendingPredictedTransforms.Reset();
+	PendingPredictedTransformIndex.Reset();
+}
+
 int32 USpacetimeDBSubsystem::GetLastAckedSequence(const FObjectID& ObjectID)
 {
+	Client.SelectConnection();
 	return (int32)get_last_acked_sequence(ObjectID.Value);
 }
 
 void USpacetimeDBSubsystem::ProcessServerTransformUpdate(const FObjectID& ObjectID, const FTransform& Transform, 
 	const FVector& Velocity, int32 AckedSequence)
 {
-	// Look up the object in our object map
-	if (UObject* Object = FindObjectById(ObjectID.Value))
+	FSpacetimeDBServerTransformUpdate Update;
+	Update.ObjectID = ObjectID;
+	Update.Transform = Transform;
+	Update.Velocity = Velocity;
+	Update.AckedSequence = AckedSequence;
+	ApplyServerTransformBatch(MakeArrayView(&Update, 1));
+}
+
+void USpacetimeDBSubsystem::ApplyServerTransforms(const TArray<FSpacetimeDBServerTransformUpdate>& Updates)
+{
+	ApplyServerTransformBatch(Updates);
+}
+
+void USpacetimeDBSubsystem::ApplyServerTransformBatch(TConstArrayView<FObjectID> ObjectIDs, TConstArrayView<stdb::shared::Transform> Transforms,
+	TConstArrayView<stdb::shared::Vector3> Velocities, TConstArrayView<int32> AckedSequences)
+{
+	check(Transforms.Num() == ObjectIDs.Num() && Velocities.Num() == ObjectIDs.Num() && AckedSequences.Num() == ObjectIDs.Num());
+	
+	// Widened in one pass, with the rotations renormalized in the precision the server rounded them in
+	TArray<FTransform, TInlineAllocator<16>> WidePoses;
+	WidePoses.SetNumUninitialized(Transforms.Num());
+	FSpacetimeDBTypeConversions::FromStdbTransforms(Transforms, WidePoses);
+	
+	TArray<FSpacetimeDBServerTransformUpdate, TInlineAllocator<16>> Updates;
+	Updates.SetNum(ObjectIDs.Num());
+	for (int32 Index = 0; Index < ObjectIDs.Num(); ++Index)
+	{
+		FSpacetimeDBServerTransformUpdate& Update = Updates[Index];
+		Update.ObjectID = ObjectIDs[Index];
+		Update.Transform = WidePoses[Index];
+		Update.Velocity = FSpacetimeDBTypeConversions::FromStdbVector3(Velocities[Index]);
+		Update.AckedSequence = AckedSequences[Index];
+	}
+	ApplyServerTransformBatch(Updates);
+}
+
+void USpacetimeDBSubsystem::ApplyServerTransformBatch(TConstArrayView<FSpacetimeDBServerTransformUpdate> Updates)
+{
+	if (Updates.Num() == 0)
+	{
+		return;
+	}
+	
+	// Keep only the newest update per object so each actor moves once
+	TransformBatchIndex.Reset();
+	for (int32 Index = 0; Index < Updates.Num(); ++Index)
+	{
+		int32& Newest = TransformBatchIndex.FindOrAdd(Updates[Index].ObjectID.Value, Index);
+		if ((uint32)Updates[Index].AckedSequence >= (uint32)Updates[Newest].AckedSequence)
+		{
+			Newest = Index;
+		}
+	}
+	
+	// Direct moves open a deferred scope on their root so overlaps are resolved once, when the batch ends.
+	// Reserved up front: scopes register their address with the component and must never be relocated.
+	TArray<FScopedMovementUpdate> DeferredMoves;
+	DeferredMoves.Reserve(TransformBatchIndex.Num());
+	
+	UWorld* ManagerWorld = nullptr;
+	USpacetimeDBPredictionManager* Manager = nullptr;
+	
+	for (int32 Index = 0; Index < Updates.Num(); ++Index)
 	{
-		if (AActor* Actor = Cast<AActor>(Object))
+		const FSpacetimeDBServerTransformUpdate& Update = Updates[Index];
+		if (TransformBatchIndex.FindChecked(Update.ObjectID.Value) != Index)
+		{
+			continue;
+		}
+		
+		const FSpacetimeDBTransformTarget* Target = ResolveTransformTarget(Update.ObjectID.Value);
+		if (!Target)
 		{
-			// Look for prediction component
-			if (USpacetimeDBPredictionComponent* PredComp = Actor->FindComponentByClass<USpacetimeDBPredictionComponent>())
+			// Proxies only need to know where they are
+			if (FSpacetimeDBProxyEntity* Proxy = Proxies.Find(Update.ObjectID.Value))
 			{
-				// Let the prediction component handle this
-				PredComp->ProcessServerUpdate(Transform, Velocity, AckedSequence);
+				Proxy->Transform = Update.Transform;
 			}
-			else 
+			continue;
+		}
+		
+		AActor* Actor = Target->Actor.Get();
+		if (USpacetimeDBPredictionComponent* PredComp = Target->PredictionComponent.Get())
+		{
+			// Registered components are reconciled in the world's batched pass; others handle it right away
+			UWorld* World = Actor->GetWorld();
+			if (World != ManagerWorld)
+			{
+				ManagerWorld = World;
+				Manager = World ? World->GetSubsystem<USpacetimeDBPredictionManager>() : nullptr;
+			}
+			if (!Manager || !Manager->QueueServerUpdate(PredComp, Update.Transform, Update.Velocity, Update.AckedSequence))
 			{
-				// No prediction component, just set the transform directly
-				Actor->SetActorTransform(Transform);
+				// Let the prediction component handle this
+				PredComp->ProcessServerUpdate(Update.Transform, Update.Velocity, Update.AckedSequence);
 			}
 		}
+		else if (USceneComponent* Root = Actor->GetRootComponent())
+		{
+			// No prediction component, just set the transform directly
+			DeferredMoves.Emplace(Root, EScopedUpdate::DeferredUpdates);
+			Actor->SetActorTransform(Update.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+	
+	// Closing the scopes applies the deferred overlap updates
+	DeferredMoves.Reset();
+}
+
+const FSpacetimeDBTransformTarget* USpacetimeDBSubsystem::ResolveTransformTarget(int64 ObjectId)
+{
+	if (const FSpacetimeDBTransformTarget* Cached = TransformTargets.Find(ObjectId))
+	{
+		if (Cached->Actor.IsValid())
+		{
+			return Cached;
+		}
+		TransformTargets.Remove(ObjectId);
+	}
+	
+	AActor* Actor = Cast<AActor>(FindObjectById(ObjectId));
+	if (!Actor)
+	{
+		return nullptr;
 	}
+	
+	FSpacetimeDBTransformTarget& Target = TransformTargets.Add(ObjectId);
+	Target.Actor = Actor;
+	Target.PredictionComponent = Actor->FindComponentByClass<USpacetimeDBPredictionComponent>();
+	return &Target;
 }
 
 bool USpacetimeDBSubsystem::HasAuthority(int64 ObjectId) const
@@ -1305,37 +3941,9 @@ bool USpacetimeDBSubsystem::HasAuthority(int64 ObjectId) const
 
 int64 USpacetimeDBSubsystem::GetOwnerClientId(int64 ObjectId) const
 {
-    // Implementation of GetOwnerClientId - check the object properties for owner information
-    // Find the object by ID
-    UObject* Object = FindObjectById(ObjectId);
-    if (!Object)
-    {
-        return 0; // Not found or not owned
-    }
-    
-    // Check for the owner client ID property
-    FString OwnerIdJson = GetPropertyJsonValue(ObjectId, TEXT("owner_client_id"));
-    if (OwnerIdJson.IsEmpty())
-    {
-        return 0; // No owner property found
-    }
-    
-    // Parse the owner client ID
-    int64 OwnerId = 0;
-    
-    // Direct parsing from JSON to avoid dependency on helper
-    TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(OwnerIdJson);
-    if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-    {
-        double NumericValue = 0.0;
-        if (JsonObject->TryGetNumberField(TEXT("value"), NumericValue))
-        {
-            OwnerId = static_cast<int64>(NumericValue);
-        }
-    }
-    
-    return OwnerId;
+    // Maintained from spawn snapshots and owner property updates
+    const int64* OwnerClientId = OwnerIndex.Find(ObjectId);
+    return OwnerClientId ? *OwnerClientId : 0; // Not found or not owned
 }
 
 bool USpacetimeDBSubsystem::HasOwnership(int64 ObjectId) const
@@ -1347,6 +3955,17 @@ bool USpacetimeDBSubsystem::HasOwnership(int64 ObjectId) const
     return (OwnerId == ClientId && ClientId != 0);
 }
 
+TArray<int64> USpacetimeDBSubsystem::GetObjectsOwnedBy(int64 OwnerClientId) const
+{
+    const TSet<int64>* Owned = ObjectsByOwner.Find(OwnerClientId);
+    return Owned ? Owned->Array() : TArray<int64>();
+}
+
+const TSet<int64>* USpacetimeDBSubsystem::FindObjectsOwnedBy(int64 OwnerClientId) const
+{
+    return ObjectsByOwner.Find(OwnerClientId);
+}
+
 bool USpacetimeDBSubsystem::RequestSetOwner(int64 ObjectId, int64 NewOwnerClientId)
 {
     if (!IsConnected())
@@ -1372,6 +3991,12 @@ UActorComponent* USpacetimeDBSubsystem::HandleComponentAdded(int64 ActorId, int6
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: HandleComponentAdded - Actor: %lld, Component: %lld, Class: %s"), 
         ActorId, ComponentId, *ComponentClassName);
     
+    // An actor still waiting in the materialization queue spawns now so the component has an owner
+    MaterializeObjectNow(ActorId);
+    
+    // The actor may have gained a prediction component
+    TransformTargets.Remove(ActorId);
+    
     // First check if the actor exists
     AActor* OwnerActor = Cast<AActor>(FindObjectById(ActorId));
     if (!OwnerActor)
@@ -1387,31 +4012,12 @@ UActorComponent* USpacetimeDBSubsystem::HandleComponentAdded(int64 ActorId, int6
         return ExistingComponent;
     }
     
-    // Parse JSON data for component properties
-    TSharedPtr<FJsonObject> ComponentDataJson;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DataJson);
-    if (!FJsonSerializer::Deserialize(Reader, ComponentDataJson))
-    {
-        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to parse component data JSON: %s"), *DataJson);
-        return nullptr;
-    }
-    
-    // Find the component class by name - use the proper approach in UE5.5
-    UClass* ComponentClass = FindObject<UClass>(nullptr, *ComponentClassName);
+    // Find the component class by name, through the registry's lookup cache
+    UClass* ComponentClass = FSpacetimeDBClassRegistry::FindClassByName(ComponentClassName);
     if (!ComponentClass)
     {
-        // Try with a U prefix if not found
-        if (!ComponentClassName.StartsWith(TEXT("U")))
-        {
-            FString PrefixedClassName = FString::Printf(TEXT("U%s"), *ComponentClassName);
-            ComponentClass = FindObject<UClass>(nullptr, *PrefixedClassName);
-        }
-        
-        if (!ComponentClass)
-        {
-            UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Could not find component class '%s'"), *ComponentClassName);
-            return nullptr;
-        }
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Could not find component class '%s'"), *ComponentClassName);
+        return nullptr;
     }
     
     // Verify it's actually a UActorComponent class
@@ -1432,23 +4038,19 @@ UActorComponent* USpacetimeDBSubsystem::HandleComponentAdded(int64 ActorId, int6
     // Register the component with the actor
     NewComponent->RegisterComponent();
     
-    // Apply initial properties from JSON if provided
-    TSharedPtr<FJsonObject> PropertiesObj = ComponentDataJson->GetObjectField(TEXT("properties"));
-    if (PropertiesObj.IsValid())
+    // Stream the initial properties into the component, then fire its RepNotifies once
+    FSpacetimeDBSpawnSnapshot Snapshot;
+    if (!FSpacetimeDBSpawnDataReader::Read(DataJson, NewComponent, true, Snapshot))
     {
-        // Apply each property from JSON to the component
-        for (const auto& Pair : PropertiesObj->Values)
-        {
-            const FString& PropertyName = Pair.Key;
-            const TSharedPtr<FJsonValue>& JsonValue = Pair.Value;
-            
-            // Apply property using our property helper
-            bool bSuccess = FSpacetimeDBPropertyHelper::ApplyJsonValueToProperty(NewComponent, PropertyName, JsonValue);
-            if (!bSuccess)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Failed to apply property '%s' to component"), *PropertyName);
-            }
-        }
+        UE_LOG(LogTemp, Error, TEXT("SpacetimeDBSubsystem: Failed to parse component data JSON: %s"), *DataJson);
+        NewComponent->DestroyComponent();
+        return nullptr;
+    }
+    
+    if (Snapshot.NumPropertiesFailed > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBSubsystem: Failed to apply %d properties to component '%s'"), 
+            Snapshot.NumPropertiesFailed, *ComponentClassName);
     }
     
     // Register the component in our registry
@@ -1469,6 +4071,9 @@ bool USpacetimeDBSubsystem::HandleComponentRemoved(int64 ActorId, int64 Componen
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDBSubsystem: HandleComponentRemoved - Actor: %lld, Component: %lld"), 
         ActorId, ComponentId);
     
+    // The actor may have lost its prediction component
+    TransformTargets.Remove(ActorId);
+    
     // Find the actor and component
     AActor* OwnerActor = Cast<AActor>(FindObjectById(ActorId));
     UActorComponent* Component = Cast<UActorComponent>(FindObjectById(ComponentId));
@@ -1510,6 +4115,35 @@ bool USpacetimeDBSubsystem::HandleComponentRemoved(int64 ActorId, int64 Componen
     return true;
 }
 
+bool USpacetimeDBSubsystem::FindCachedRow(const FString& TableName, const FString& PrimaryKey, FString& OutRowJson) const
+{
+    TSharedPtr<FJsonObject> Row = TableCache.FindRow(TableName, PrimaryKey);
+    if (!Row.IsValid())
+    {
+        return false;
+    }
+    
+    OutRowJson.Reset();
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutRowJson);
+    return FJsonSerializer::Serialize(Row.ToSharedRef(), Writer);
+}
+
+TArray<FString> USpacetimeDBSubsystem::QueryCachedRows(const FString& TableName, const FString& Column, const FString& Value) const
+{
+    TArray<TSharedPtr<FJsonObject>> Rows;
+    TableCache.FindRows(TableName, Column, Value, Rows);
+    
+    TArray<FString> Result;
+    Result.Reserve(Rows.Num());
+    for (const TSharedPtr<FJsonObject>& Row : Rows)
+    {
+        FString& RowJson = Result.AddDefaulted_GetRef();
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RowJson);
+        FJsonSerializer::Serialize(Row.ToSharedRef(), Writer);
+    }
+    return Result;
+}
+
 UActorComponent* USpacetimeDBSubsystem::GetComponentById(int64 ComponentId) const
 {
     UObject* Object = FindObjectById(ComponentId);
@@ -1535,17 +4169,28 @@ TArray<int64> USpacetimeDBSubsystem::GetComponentIdsForActor(int64 ActorId) cons
         return Result;
     }
     
-    // Since CallReducerSync isn't available, we need to implement an alternative approach
-    // For now, use CallReducer with a callback to handle the result
-    
-    // Create JSON args for the reducer call
-    FString ArgsJson = FString::Printf(TEXT("{\"actor_id\":%lld}"), ActorId);
+    static const FString ComponentTable(TEXT("actor_component"));
+    if (!TableCache.IsCached(ComponentTable) || !IsSubscriptionApplied(ComponentTable))
+    {
+        // Until the subscription's initial rows arrive the cached table is incomplete, so an
+        // empty lookup would be indistinguishable from an actor without components. Ask the
+        // server instead; the answer arrives as events
+        CallReducerHelper(TEXT("get_components"), FString::Printf(TEXT("{\"actor_id\":%lld}"), ActorId));
+        return Result;
+    }
     
-    // Call the reducer - we'll need to handle the response elsewhere
-    CallReducerHelper(TEXT("get_components"), ArgsJson);
+    TArray<TSharedPtr<FJsonObject>> Rows;
+    TableCache.FindRows(ComponentTable, TEXT("actor_id"), FString::Printf(TEXT("%lld"), ActorId), Rows);
     
-    // For now, we can return any components we already know about from our local registry
-    // This would need to be enhanced with a proper callback system
+    Result.Reserve(Rows.Num());
+    for (const TSharedPtr<FJsonObject>& Row : Rows)
+    {
+        int64 ComponentId = 0;
+        if (Row->TryGetNumberField(TEXT("id"), ComponentId))
+        {
+            Result.Add(ComponentId);
+        }
+    }
     
     return Result;
 }
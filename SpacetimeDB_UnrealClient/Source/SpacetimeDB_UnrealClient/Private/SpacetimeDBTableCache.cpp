@@ -0,0 +1,215 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBTableCache.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+void FSpacetimeDBTableCache::DeclareTable(const FString& TableName, const FString& PrimaryKey, const TArray<FString>& IndexedColumns)
+{
+    if (TableName.IsEmpty() || PrimaryKey.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBTableCache: Ignoring table declaration without a name or primary key"));
+        return;
+    }
+
+    FTable& Table = Tables.FindOrAdd(TableName);
+    Table.PrimaryKey = PrimaryKey;
+    Table.Rows.Reset();
+    Table.Indexes.Reset();
+    for (const FString& Column : IndexedColumns)
+    {
+        if (!Column.IsEmpty() && Column != PrimaryKey)
+        {
+            Table.Indexes.AddDefaulted_GetRef().Column = Column;
+        }
+    }
+}
+
+bool FSpacetimeDBTableCache::ApplyEvent(const FString& TableName, const FString& EventData)
+{
+    if (!Tables.Contains(TableName))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Event;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(EventData);
+    if (!FJsonSerializer::Deserialize(Reader, Event) || !Event.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBTableCache: Could not parse event for table %s"), *TableName);
+        return false;
+    }
+
+    // Either an {"op", "row"} envelope or the row itself
+    FString Op;
+    const TSharedPtr<FJsonObject>* Row = nullptr;
+    if (Event->TryGetStringField(TEXT("op"), Op) && Event->TryGetObjectField(TEXT("row"), Row))
+    {
+        return ApplyRow(TableName, *Row, Op == TEXT("delete"));
+    }
+    return ApplyRow(TableName, Event, false);
+}
+
+bool FSpacetimeDBTableCache::ApplyRow(const FString& TableName, const TSharedPtr<FJsonObject>& Row, bool bDelete)
+{
+    FTable* Table = Tables.Find(TableName);
+    if (!Table || !Row.IsValid())
+    {
+        return false;
+    }
+
+    const FString Key = KeyFromJsonValue(Row->TryGetField(Table->PrimaryKey));
+    if (Key.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SpacetimeDBTableCache: Row for table %s has no '%s' key"), *TableName, *Table->PrimaryKey);
+        return false;
+    }
+
+    if (const TSharedPtr<FJsonObject>* Existing = Table->Rows.Find(Key))
+    {
+        RemoveFromIndexes(*Table, Key, **Existing);
+        if (bDelete)
+        {
+            Table->Rows.Remove(Key);
+            return true;
+        }
+    }
+    else if (bDelete)
+    {
+        return true;
+    }
+
+    AddToIndexes(*Table, Key, *Row);
+    Table->Rows.Add(Key, Row);
+    return true;
+}
+
+TSharedPtr<FJsonObject> FSpacetimeDBTableCache::FindRow(const FString& TableName, const FString& PrimaryKey) const
+{
+    const FTable* Table = Tables.Find(TableName);
+    const TSharedPtr<FJsonObject>* Row = Table ? Table->Rows.Find(PrimaryKey) : nullptr;
+    return Row ? *Row : nullptr;
+}
+
+int32 FSpacetimeDBTableCache::FindRows(const FString& TableName, const FString& Column, const FString& Value, TArray<TSharedPtr<FJsonObject>>& OutRows) const
+{
+    const FTable* Table = Tables.Find(TableName);
+    if (!Table)
+    {
+        return 0;
+    }
+
+    const int32 NumBefore = OutRows.Num();
+
+    if (Column == Table->PrimaryKey)
+    {
+        if (const TSharedPtr<FJsonObject>* Row = Table->Rows.Find(Value))
+        {
+            OutRows.Add(*Row);
+        }
+        return OutRows.Num() - NumBefore;
+    }
+
+    for (const FIndex& Index : Table->Indexes)
+    {
+        if (Index.Column == Column)
+        {
+            if (const TSet<FString>* Keys = Index.KeysByValue.Find(Value))
+            {
+                OutRows.Reserve(NumBefore + Keys->Num());
+                for (const FString& Key : *Keys)
+                {
+                    OutRows.Add(Table->Rows.FindChecked(Key));
+                }
+            }
+            return OutRows.Num() - NumBefore;
+        }
+    }
+
+    // Not indexed
+    for (const TPair<FString, TSharedPtr<FJsonObject>>& Entry : Table->Rows)
+    {
+        if (KeyFromJsonValue(Entry.Value->TryGetField(Column)) == Value)
+        {
+            OutRows.Add(Entry.Value);
+        }
+    }
+    return OutRows.Num() - NumBefore;
+}
+
+int32 FSpacetimeDBTableCache::Num(const FString& TableName) const
+{
+    const FTable* Table = Tables.Find(TableName);
+    return Table ? Table->Rows.Num() : 0;
+}
+
+void FSpacetimeDBTableCache::ClearRows()
+{
+    for (TPair<FString, FTable>& Entry : Tables)
+    {
+        Entry.Value.Rows.Reset();
+        for (FIndex& Index : Entry.Value.Indexes)
+        {
+            Index.KeysByValue.Reset();
+        }
+    }
+}
+
+FString FSpacetimeDBTableCache::KeyFromJsonValue(const TSharedPtr<FJsonValue>& Value)
+{
+    if (!Value.IsValid())
+    {
+        return FString();
+    }
+
+    switch (Value->Type)
+    {
+    case EJson::String:
+        return Value->AsString();
+
+    case EJson::Number:
+        {
+            const double Number = Value->AsNumber();
+            const double Integral = FMath::RoundToDouble(Number);
+            if (Integral == Number && FMath::Abs(Number) < 9007199254740992.0)
+            {
+                return FString::Printf(TEXT("%lld"), static_cast<int64>(Integral));
+            }
+            return FString::SanitizeFloat(Number);
+        }
+
+    case EJson::Boolean:
+        return Value->AsBool() ? TEXT("true") : TEXT("false");
+
+    default:
+        return FString();
+    }
+}
+
+void FSpacetimeDBTableCache::AddToIndexes(FTable& Table, const FString& Key, const FJsonObject& Row)
+{
+    for (FIndex& Index : Table.Indexes)
+    {
+        const FString Value = KeyFromJsonValue(Row.TryGetField(Index.Column));
+        if (!Value.IsEmpty())
+        {
+            Index.KeysByValue.FindOrAdd(Value).Add(Key);
+        }
+    }
+}
+
+void FSpacetimeDBTableCache::RemoveFromIndexes(FTable& Table, const FString& Key, const FJsonObject& Row)
+{
+    for (FIndex& Index : Table.Indexes)
+    {
+        const FString Value = KeyFromJsonValue(Row.TryGetField(Index.Column));
+        if (TSet<FString>* Keys = Index.KeysByValue.Find(Value))
+        {
+            Keys->Remove(Key);
+            if (Keys->Num() == 0)
+            {
+                Index.KeysByValue.Remove(Value);
+            }
+        }
+    }
+}
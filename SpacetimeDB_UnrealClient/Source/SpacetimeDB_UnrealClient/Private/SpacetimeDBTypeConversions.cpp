@@ -4,6 +4,9 @@
 #include "SpacetimeDBTypeConversions.h"
 #include "ffi.h" // Include the FFI header generated from Rust
 #include "SpacetimeDBSharedTypes.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "SpacetimeDBStats.h"
+#include "Math/VectorRegister.h"
 
 // If the structure is not available, provide a stub implementation
 #ifndef SPACETIMEDB_SHARED_TYPES_INCLUDED
@@ -83,6 +86,52 @@ FTransform FSpacetimeDBTypeConversions::FromStdbTransform(const stdb::shared::Tr
     );
 }
 
+void FSpacetimeDBTypeConversions::ToStdbTransforms(TConstArrayView<FTransform> Transforms, TArrayView<stdb::shared::Transform> OutTransforms)
+{
+    check(Transforms.Num() == OutTransforms.Num());
+    SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_TransformConversion);
+
+    const VectorRegister4Float IdentityRotation = GlobalVectorConstants::Float0001;
+    for (int32 Index = 0; Index < Transforms.Num(); ++Index)
+    {
+        const FTransform& Transform = Transforms[Index];
+        stdb::shared::Transform& Out = OutTransforms[Index];
+
+        const FVector Location = Transform.GetLocation();
+        const FQuat Rotation = Transform.GetRotation();
+        const FVector Scale = Transform.GetScale3D();
+
+        // Narrowing can leave the rotation just off unit length, which the server would have to fix
+        const VectorRegister4Float NarrowRotation = MakeVectorRegisterFloatFromDouble(VectorLoad(&Rotation.X));
+        VectorStore(VectorNormalizeSafe(NarrowRotation, IdentityRotation), &Out.rotation.x);
+        VectorStoreFloat3(MakeVectorRegisterFloatFromDouble(VectorLoadFloat3(&Location.X)), &Out.location.x);
+        VectorStoreFloat3(MakeVectorRegisterFloatFromDouble(VectorLoadFloat3(&Scale.X)), &Out.scale.x);
+    }
+}
+
+void FSpacetimeDBTypeConversions::FromStdbTransforms(TConstArrayView<stdb::shared::Transform> Transforms, TArrayView<FTransform> OutTransforms)
+{
+    check(Transforms.Num() == OutTransforms.Num());
+    SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_TransformConversion);
+
+    const VectorRegister4Float IdentityRotation = GlobalVectorConstants::Float0001;
+    FVector Location;
+    FQuat Rotation;
+    FVector Scale;
+    for (int32 Index = 0; Index < Transforms.Num(); ++Index)
+    {
+        const stdb::shared::Transform& Transform = Transforms[Index];
+
+        // Renormalized in single precision, where the server's rounding happened
+        const VectorRegister4Float NarrowRotation = VectorNormalizeSafe(VectorLoad(&Transform.rotation.x), IdentityRotation);
+        VectorStore(MakeVectorRegisterDouble(NarrowRotation), &Rotation.X);
+        VectorStoreFloat3(MakeVectorRegisterDouble(VectorLoadFloat3(&Transform.location.x)), &Location.X);
+        VectorStoreFloat3(MakeVectorRegisterDouble(VectorLoadFloat3(&Transform.scale.x)), &Scale.X);
+
+        OutTransforms[Index].SetComponents(Rotation, Location, Scale);
+    }
+}
+
 // Color conversions
 stdb::shared::Color FSpacetimeDBTypeConversions::ToStdbColor(const FColor& Color)
 {
@@ -114,4 +163,185 @@ FLinearColor FSpacetimeDBTypeConversions::ToLinearColor(const stdb::shared::Colo
         static_cast<float>(Color.b) / 255.0f,
         static_cast<float>(Color.a) / 255.0f
     );
-} 
\ No newline at end of file
+}
+
+// Quantized transform encoding
+namespace
+{
+    /** Largest magnitude any of the three smallest components of a unit quaternion can have */
+    constexpr double SmallestThreeRange = UE_INV_SQRT_2;
+    constexpr int32 SmallestThreeMax = (1 << 10) - 1;
+
+    /** Fixed-point steps per cell edge */
+    constexpr double CellOffsetSteps = 65536.0;
+}
+
+uint32 FSpacetimeDBTypeConversions::PackQuatSmallestThree(const FQuat& Quat)
+{
+    const FQuat Normalized = Quat.GetNormalized();
+    const double Components[4] = { Normalized.X, Normalized.Y, Normalized.Z, Normalized.W };
+
+    int32 Largest = 0;
+    for (int32 Index = 1; Index < 4; ++Index)
+    {
+        if (FMath::Abs(Components[Index]) > FMath::Abs(Components[Largest]))
+        {
+            Largest = Index;
+        }
+    }
+
+    // q and -q are the same rotation; flip so the dropped component is positive
+    const double Sign = Components[Largest] < 0.0 ? -1.0 : 1.0;
+
+    uint32 Packed = static_cast<uint32>(Largest) << 30;
+    int32 Shift = 20;
+    for (int32 Index = 0; Index < 4; ++Index)
+    {
+        if (Index == Largest)
+        {
+            continue;
+        }
+
+        const double Normalized01 = (Components[Index] * Sign / SmallestThreeRange) * 0.5 + 0.5;
+        const int32 Quantized = FMath::Clamp(FMath::RoundToInt32(Normalized01 * SmallestThreeMax), 0, SmallestThreeMax);
+        Packed |= static_cast<uint32>(Quantized) << Shift;
+        Shift -= 10;
+    }
+    return Packed;
+}
+
+FQuat FSpacetimeDBTypeConversions::UnpackQuatSmallestThree(uint32 Packed)
+{
+    const int32 Largest = static_cast<int32>(Packed >> 30);
+
+    double Components[4];
+    double SumSquares = 0.0;
+    int32 Shift = 20;
+    for (int32 Index = 0; Index < 4; ++Index)
+    {
+        if (Index == Largest)
+        {
+            continue;
+        }
+
+        const int32 Quantized = static_cast<int32>((Packed >> Shift) & SmallestThreeMax);
+        Components[Index] = (static_cast<double>(Quantized) / SmallestThreeMax * 2.0 - 1.0) * SmallestThreeRange;
+        SumSquares += Components[Index] * Components[Index];
+        Shift -= 10;
+    }
+    Components[Largest] = FMath::Sqrt(FMath::Max(0.0, 1.0 - SumSquares));
+
+    FQuat Result(Components[0], Components[1], Components[2], Components[3]);
+    Result.Normalize();
+    return Result;
+}
+
+void FSpacetimeDBTypeConversions::QuantizeLocation(const FVector& Location, double CellSize, FIntVector& OutCell, uint16 OutOffset[3])
+{
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const double InCells = Location[Axis] / CellSize;
+        int32 Cell = FMath::FloorToInt32(InCells);
+        int32 Offset = FMath::RoundToInt32((InCells - Cell) * CellOffsetSteps);
+
+        // Rounding up to the far edge belongs to the next cell
+        if (Offset >= static_cast<int32>(CellOffsetSteps))
+        {
+            ++Cell;
+            Offset = 0;
+        }
+
+        OutCell[Axis] = Cell;
+        OutOffset[Axis] = static_cast<uint16>(Offset);
+    }
+}
+
+FVector FSpacetimeDBTypeConversions::DequantizeLocation(const FIntVector& Cell, const uint16 Offset[3], double CellSize)
+{
+    return FVector(
+        (Cell.X + Offset[0] / CellOffsetSteps) * CellSize,
+        (Cell.Y + Offset[1] / CellOffsetSteps) * CellSize,
+        (Cell.Z + Offset[2] / CellOffsetSteps) * CellSize
+    );
+}
+
+void FSpacetimeDBTypeConversions::QuantizeVelocity(const FVector& Velocity, double Step, int16 OutVelocity[3])
+{
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        OutVelocity[Axis] = static_cast<int16>(FMath::Clamp<int32>(FMath::RoundToInt32(Velocity[Axis] / Step), MIN_int16, MAX_int16));
+    }
+}
+
+FVector FSpacetimeDBTypeConversions::DequantizeVelocity(const int16 Velocity[3], double Step)
+{
+    return FVector(Velocity[0] * Step, Velocity[1] * Step, Velocity[2] * Step);
+}
+
+void FSpacetimeDBTypeConversions::WriteQuantizedTransform(FSpacetimeDBBinaryWriter& Writer, const FSpacetimeDBQuantizedTransform& Transform)
+{
+    Writer.WriteVarUInt64(Transform.ObjectId);
+    Writer.WriteVarUInt64(Transform.Sequence);
+    Writer.WriteUInt8(static_cast<uint8>(Transform.Flags));
+
+    if (EnumHasAnyFlags(Transform.Flags, ESpacetimeDBQuantizedTransformFlags::HasCell))
+    {
+        Writer.WriteInt32(Transform.Cell.X);
+        Writer.WriteInt32(Transform.Cell.Y);
+        Writer.WriteInt32(Transform.Cell.Z);
+    }
+
+    Writer.WriteUInt16(Transform.CellOffset[0]);
+    Writer.WriteUInt16(Transform.CellOffset[1]);
+    Writer.WriteUInt16(Transform.CellOffset[2]);
+    Writer.WriteUInt32(Transform.Rotation);
+
+    if (EnumHasAnyFlags(Transform.Flags, ESpacetimeDBQuantizedTransformFlags::HasVelocity))
+    {
+        Writer.WriteInt16(Transform.Velocity[0]);
+        Writer.WriteInt16(Transform.Velocity[1]);
+        Writer.WriteInt16(Transform.Velocity[2]);
+    }
+
+    if (EnumHasAnyFlags(Transform.Flags, ESpacetimeDBQuantizedTransformFlags::HasScale))
+    {
+        Writer.WriteFloat(Transform.Scale.X);
+        Writer.WriteFloat(Transform.Scale.Y);
+        Writer.WriteFloat(Transform.Scale.Z);
+    }
+}
+
+bool FSpacetimeDBTypeConversions::ReadQuantizedTransform(FSpacetimeDBBinaryReader& Reader, FSpacetimeDBQuantizedTransform& InOutTransform)
+{
+    InOutTransform.ObjectId = Reader.ReadVarUInt64();
+    InOutTransform.Sequence = static_cast<uint32>(Reader.ReadVarUInt64());
+    InOutTransform.Flags = static_cast<ESpacetimeDBQuantizedTransformFlags>(Reader.ReadUInt8());
+
+    if (EnumHasAnyFlags(InOutTransform.Flags, ESpacetimeDBQuantizedTransformFlags::HasCell))
+    {
+        InOutTransform.Cell.X = Reader.ReadInt32();
+        InOutTransform.Cell.Y = Reader.ReadInt32();
+        InOutTransform.Cell.Z = Reader.ReadInt32();
+    }
+
+    InOutTransform.CellOffset[0] = Reader.ReadUInt16();
+    InOutTransform.CellOffset[1] = Reader.ReadUInt16();
+    InOutTransform.CellOffset[2] = Reader.ReadUInt16();
+    InOutTransform.Rotation = Reader.ReadUInt32();
+
+    if (EnumHasAnyFlags(InOutTransform.Flags, ESpacetimeDBQuantizedTransformFlags::HasVelocity))
+    {
+        InOutTransform.Velocity[0] = Reader.ReadInt16();
+        InOutTransform.Velocity[1] = Reader.ReadInt16();
+        InOutTransform.Velocity[2] = Reader.ReadInt16();
+    }
+
+    if (EnumHasAnyFlags(InOutTransform.Flags, ESpacetimeDBQuantizedTransformFlags::HasScale))
+    {
+        InOutTransform.Scale.X = Reader.ReadFloat();
+        InOutTransform.Scale.Y = Reader.ReadFloat();
+        InOutTransform.Scale.Z = Reader.ReadFloat();
+    }
+
+    return !Reader.IsError();
+}
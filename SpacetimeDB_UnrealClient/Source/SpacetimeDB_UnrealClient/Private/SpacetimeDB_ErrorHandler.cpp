@@ -2,6 +2,109 @@
 
 #include "SpacetimeDB_ErrorHandler.h"
 #include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/PlatformTime.h"
+#include "SpacetimeDBSettings.h"
+#include "Engine/Engine.h"
+
+namespace
+{
+    /** Rate limit state and totals of one error code */
+    struct FErrorCodeState
+    {
+        FString Category;
+        int64 TotalCount = 0;
+        int64 SuppressedCount = 0;
+        
+        double WindowStart = 0.0;
+        int32 WindowCount = 0;
+        int32 WindowSuppressed = 0;
+    };
+    
+    FCriticalSection ErrorStateLock;
+    TMap<int32, FErrorCodeState> ErrorStates;
+    
+    /** Logs the summary of a window with unreported errors and starts a new one; ErrorStateLock must be held */
+    void CloseWindow(int32 Code, FErrorCodeState& State, double Now)
+    {
+        if (State.WindowSuppressed > 0)
+        {
+            UE_LOG(LogSpacetimeDB, Warning, TEXT("[%s] Error %d x%d in last %.1fs (%d not logged)"),
+                *State.Category, Code, State.WindowCount, Now - State.WindowStart, State.WindowSuppressed);
+        }
+        State.WindowStart = Now;
+        State.WindowCount = 0;
+        State.WindowSuppressed = 0;
+    }
+}
+
+bool FSpacetimeDBErrorHandler::ShouldReport(int32 Code, ESpacetimeDBErrorSeverity Severity, const TCHAR* Category)
+{
+    const USpacetimeDBSettings* Settings = USpacetimeDBSettings::Get();
+    const double Now = FPlatformTime::Seconds();
+    
+    FScopeLock Lock(&ErrorStateLock);
+    FErrorCodeState& State = ErrorStates.FindOrAdd(Code);
+    if (State.TotalCount == 0)
+    {
+        State.Category = Category;
+        State.WindowStart = Now;
+    }
+    ++State.TotalCount;
+    
+    if (Now - State.WindowStart >= Settings->ErrorReportWindowSeconds)
+    {
+        CloseWindow(Code, State, Now);
+    }
+    ++State.WindowCount;
+    
+    if (Severity >= ESpacetimeDBErrorSeverity::Critical || Settings->MaxErrorReportsPerWindow <= 0
+        || State.WindowCount <= Settings->MaxErrorReportsPerWindow)
+    {
+        return true;
+    }
+    
+    ++State.SuppressedCount;
+    ++State.WindowSuppressed;
+    return false;
+}
+
+void FSpacetimeDBErrorHandler::FlushErrorSummaries()
+{
+    const double Window = USpacetimeDBSettings::Get()->ErrorReportWindowSeconds;
+    const double Now = FPlatformTime::Seconds();
+    
+    FScopeLock Lock(&ErrorStateLock);
+    for (TPair<int32, FErrorCodeState>& Pair : ErrorStates)
+    {
+        // Windows without suppressed errors can wait for the next occurrence to roll over
+        if (Pair.Value.WindowSuppressed > 0 && Now - Pair.Value.WindowStart >= Window)
+        {
+            CloseWindow(Pair.Key, Pair.Value, Now);
+        }
+    }
+}
+
+void FSpacetimeDBErrorHandler::GetErrorCounters(TArray<FSpacetimeDBErrorCounter>& OutCounters)
+{
+    FScopeLock Lock(&ErrorStateLock);
+    OutCounters.Reset(ErrorStates.Num());
+    for (const TPair<int32, FErrorCodeState>& Pair : ErrorStates)
+    {
+        FSpacetimeDBErrorCounter& Counter = OutCounters.AddDefaulted_GetRef();
+        Counter.Code = Pair.Key;
+        Counter.Category = Pair.Value.Category;
+        Counter.TotalCount = Pair.Value.TotalCount;
+        Counter.SuppressedCount = Pair.Value.SuppressedCount;
+    }
+    OutCounters.Sort([](const FSpacetimeDBErrorCounter& A, const FSpacetimeDBErrorCounter& B) { return A.Code < B.Code; });
+}
+
+void FSpacetimeDBErrorHandler::ResetErrorCounters()
+{
+    FScopeLock Lock(&ErrorStateLock);
+    ErrorStates.Reset();
+}
 
 FSpacetimeDBErrorInfo FSpacetimeDBErrorHandler::LogError(
     const FString& Message,
@@ -14,74 +117,93 @@ FSpacetimeDBErrorInfo FSpacetimeDBErrorHandler::LogError(
     // Create error info
     FSpacetimeDBErrorInfo ErrorInfo(Message, Severity, Category, Code, Context, bAutoRecovered);
     
-    // Determine log level based on severity
-    ELogVerbosity::Type LogVerbosity;
-    FString SeverityString;
+    if (ShouldReport(Code, Severity, *Category))
+    {
+        WriteLog(ErrorInfo);
+    }
     
-    switch (Severity)
+    return ErrorInfo;
+}
+
+void FSpacetimeDBErrorHandler::WriteLog(FSpacetimeDBErrorInfo& ErrorInfo)
+{
+    const int32 MaxContextLength = USpacetimeDBSettings::Get()->MaxErrorContextLength;
+    if (ErrorInfo.Context.Len() > MaxContextLength)
+    {
+        ErrorInfo.Context.LeftInline(MaxContextLength);
+        ErrorInfo.Context += TEXT("...");
+    }
+    
+    const TCHAR* SeverityString;
+    switch (ErrorInfo.Severity)
     {
         case ESpacetimeDBErrorSeverity::Info:
-            LogVerbosity = ELogVerbosity::Log;
             SeverityString = TEXT("INFO");
             break;
         case ESpacetimeDBErrorSeverity::Warning:
-            LogVerbosity = ELogVerbosity::Warning;
             SeverityString = TEXT("WARNING");
             break;
         case ESpacetimeDBErrorSeverity::Error:
-            LogVerbosity = ELogVerbosity::Error;
             SeverityString = TEXT("ERROR");
             break;
         case ESpacetimeDBErrorSeverity::Critical:
-            LogVerbosity = ELogVerbosity::Error;
             SeverityString = TEXT("CRITICAL");
             break;
         case ESpacetimeDBErrorSeverity::Fatal:
-            LogVerbosity = ELogVerbosity::Fatal;
             SeverityString = TEXT("FATAL");
             break;
         default:
-            LogVerbosity = ELogVerbosity::Error;
             SeverityString = TEXT("UNKNOWN");
             break;
     }
     
     // Format log message
-    FString LogMessage = FString::Printf(TEXT("[%s] %s"), *Category, *Message);
+    FString LogMessage = FString::Printf(TEXT("[%s] %s"), *ErrorInfo.Category, *ErrorInfo.Message);
     
     // Add code if available
-    if (Code != 0)
+    if (ErrorInfo.Code != 0)
     {
-        LogMessage += FString::Printf(TEXT(" (Code: %d)"), Code);
+        LogMessage += FString::Printf(TEXT(" (Code: %d)"), ErrorInfo.Code);
     }
     
     // Add context if available
-    if (!Context.IsEmpty())
+    if (!ErrorInfo.Context.IsEmpty())
     {
-        LogMessage += FString::Printf(TEXT(" - Context: %s"), *Context);
+        LogMessage += FString::Printf(TEXT(" - Context: %s"), *ErrorInfo.Context);
     }
     
     // Add auto-recovery information if applicable
-    if (bAutoRecovered)
+    if (ErrorInfo.bAutoRecovered)
     {
         LogMessage += TEXT(" [Auto-recovered]");
     }
     
-    // Log with appropriate verbosity
-    UE_LOG(LogSpacetimeDB, Log, TEXT("%s: %s"), *SeverityString, *LogMessage);
+    UE_LOG(LogSpacetimeDB, Log, TEXT("%s: %s"), SeverityString, *LogMessage);
     
     // For critical and fatal errors, also print to screen if possible
-    if (Severity >= ESpacetimeDBErrorSeverity::Critical && GEngine)
+    if (ErrorInfo.Severity >= ESpacetimeDBErrorSeverity::Critical && GEngine)
     {
         // Determine color based on severity
-        FColor MessageColor = (Severity == ESpacetimeDBErrorSeverity::Critical) ? FColor::Red : FColor::Purple;
+        FColor MessageColor = (ErrorInfo.Severity == ESpacetimeDBErrorSeverity::Critical) ? FColor::Red : FColor::Purple;
         
         // Display on screen
         GEngine->AddOnScreenDebugMessage(-1, 10.0f, MessageColor, 
-            FString::Printf(TEXT("SpacetimeDB %s: %s"), *SeverityString, *Message));
+            FString::Printf(TEXT("SpacetimeDB %s: %s"), SeverityString, *ErrorInfo.Message));
+    }
+}
+
+bool FSpacetimeDBErrorHandler::ReportFFIError(FSpacetimeDBErrorInfo& OutInfo, const FString& FunctionName, const FString& ErrorMessage)
+{
+    // The code and severity decide the rate limit, so the message is parsed either way
+    FSpacetimeDBErrorInfo Parsed;
+    ParseFFIErrorMessage(ErrorMessage, Parsed);
+    if (!ShouldReport(Parsed.Code, Parsed.Severity, *Parsed.Category))
+    {
+        return false;
     }
     
-    return ErrorInfo;
+    OutInfo = HandleFFIError(FunctionName, ErrorMessage, false);
+    return true;
 }
 
 FSpacetimeDBErrorInfo FSpacetimeDBErrorHandler::HandleFFIError(
@@ -1,6 +1,7 @@
 #include "SpacetimeDB_PropertyValue.h"
 #include "SpacetimeDB_JsonUtils.h"
 #include "SpacetimeDBSubsystem.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
 #include "JsonObjectConverter.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonWriter.h"
@@ -404,6 +405,223 @@ FSpacetimeDBPropertyValue FSpacetimeDBPropertyValue::FromJsonString(const FStrin
     return Result;
 }
 
+FSpacetimeDBCompactPropertyValue& FSpacetimeDBCompactPropertyValue::operator=(const FSpacetimeDBCompactPropertyValue& Other)
+{
+    if (this != &Other)
+    {
+        Reset();
+        CopyFrom(Other);
+    }
+    return *this;
+}
+
+FSpacetimeDBCompactPropertyValue& FSpacetimeDBCompactPropertyValue::operator=(FSpacetimeDBCompactPropertyValue&& Other)
+{
+    if (this != &Other)
+    {
+        Reset();
+        MoveFrom(Other);
+    }
+    return *this;
+}
+
+void FSpacetimeDBCompactPropertyValue::Reset()
+{
+    if (Storage == EStorage::String)
+    {
+        reinterpret_cast<FString*>(Inline)->~FString();
+    }
+    else if (Storage == EStorage::Transform)
+    {
+        delete *reinterpret_cast<FTransform**>(Inline);
+    }
+    Type = ESpacetimeDBPropertyType::None;
+    Storage = EStorage::Empty;
+}
+
+void FSpacetimeDBCompactPropertyValue::CopyFrom(const FSpacetimeDBCompactPropertyValue& Other)
+{
+    switch (Other.Storage)
+    {
+    case EStorage::String:
+        new (Inline) FString(Other.GetString());
+        break;
+    case EStorage::Transform:
+        *reinterpret_cast<FTransform**>(Inline) = new FTransform(Other.GetTransform());
+        break;
+    case EStorage::Pod:
+        FMemory::Memcpy(Inline, Other.Inline, sizeof(Inline));
+        break;
+    default:
+        break;
+    }
+    Type = Other.Type;
+    Storage = Other.Storage;
+}
+
+void FSpacetimeDBCompactPropertyValue::MoveFrom(FSpacetimeDBCompactPropertyValue& Other)
+{
+    if (Other.Storage == EStorage::String)
+    {
+        new (Inline) FString(MoveTemp(*reinterpret_cast<FString*>(Other.Inline)));
+    }
+    else
+    {
+        // Pods and the transform pointer move as plain bytes
+        FMemory::Memcpy(Inline, Other.Inline, sizeof(Inline));
+    }
+    Type = Other.Type;
+    Storage = Other.Storage;
+
+    // The transform now belongs to this value
+    if (Other.Storage == EStorage::Transform)
+    {
+        Other.Storage = EStorage::Empty;
+    }
+    Other.Reset();
+}
+
+void FSpacetimeDBCompactPropertyValue::SetTransform(const FTransform& Value)
+{
+    if (Storage == EStorage::Transform)
+    {
+        **reinterpret_cast<FTransform**>(Inline) = Value;
+    }
+    else
+    {
+        Reset();
+        *reinterpret_cast<FTransform**>(Inline) = new FTransform(Value);
+        Storage = EStorage::Transform;
+    }
+    Type = ESpacetimeDBPropertyType::Transform;
+}
+
+void FSpacetimeDBCompactPropertyValue::SetString(ESpacetimeDBPropertyType InType, FString&& Value)
+{
+    if (Storage == EStorage::String)
+    {
+        *reinterpret_cast<FString*>(Inline) = MoveTemp(Value);
+    }
+    else
+    {
+        Reset();
+        new (Inline) FString(MoveTemp(Value));
+        Storage = EStorage::String;
+    }
+    Type = InType;
+}
+
+FQuat FSpacetimeDBCompactPropertyValue::GetQuat() const
+{
+    const FPackedQuat Packed = GetPod<FPackedQuat>(ESpacetimeDBPropertyType::Quat);
+    return FQuat(Packed.X, Packed.Y, Packed.Z, Packed.W);
+}
+
+const FTransform& FSpacetimeDBCompactPropertyValue::GetTransform() const
+{
+    check(Storage == EStorage::Transform);
+    return **reinterpret_cast<FTransform* const*>(Inline);
+}
+
+FSpacetimeDBPropertyValue FSpacetimeDBCompactPropertyValue::ToPropertyValue() const
+{
+    FSpacetimeDBPropertyValue Value;
+    ToPropertyValue(Value);
+    return Value;
+}
+
+void FSpacetimeDBCompactPropertyValue::ToPropertyValue(FSpacetimeDBPropertyValue& OutValue) const
+{
+    OutValue = FSpacetimeDBPropertyValue();
+    OutValue.Type = Type;
+
+    if (Storage == EStorage::String)
+    {
+        // Containers and custom structs keep their JSON apart from the plain strings
+        const bool bJson = Type == ESpacetimeDBPropertyType::Array || Type == ESpacetimeDBPropertyType::Map
+            || Type == ESpacetimeDBPropertyType::Set || Type == ESpacetimeDBPropertyType::Custom;
+        (bJson ? OutValue.JsonValue : OutValue.StringValue) = GetString();
+        return;
+    }
+    if (Storage == EStorage::Transform)
+    {
+        OutValue.TransformValue = GetTransform();
+        return;
+    }
+    if (Storage != EStorage::Pod)
+    {
+        return;
+    }
+
+    switch (Type)
+    {
+    case ESpacetimeDBPropertyType::Bool: OutValue.BoolValue = GetBool(); break;
+    case ESpacetimeDBPropertyType::Byte: OutValue.ByteValue = GetByte(); break;
+    case ESpacetimeDBPropertyType::Int32: OutValue.Int32Value = GetInt32(); break;
+    case ESpacetimeDBPropertyType::Int64: OutValue.Int64Value = GetInt64(); break;
+    case ESpacetimeDBPropertyType::UInt32: OutValue.UInt32Value = GetUInt32(); break;
+    case ESpacetimeDBPropertyType::UInt64: OutValue.UInt64Value = GetUInt64(); break;
+    case ESpacetimeDBPropertyType::Float: OutValue.FloatValue = GetFloat(); break;
+    case ESpacetimeDBPropertyType::Double: OutValue.DoubleValue = GetDouble(); break;
+    case ESpacetimeDBPropertyType::Vector: OutValue.VectorValue = GetVector(); break;
+    case ESpacetimeDBPropertyType::Rotator: OutValue.RotatorValue = GetRotator(); break;
+    case ESpacetimeDBPropertyType::Quat: OutValue.QuatValue = GetQuat(); break;
+    case ESpacetimeDBPropertyType::Color: OutValue.ColorValue = GetColor(); break;
+    case ESpacetimeDBPropertyType::ObjectReference: OutValue.ObjectReferenceValue = GetObjectReference(); break;
+    default: break;
+    }
+}
+
+void FSpacetimeDBCompactPropertyValue::FromPropertyValue(const FSpacetimeDBPropertyValue& Value)
+{
+    switch (Value.Type)
+    {
+    case ESpacetimeDBPropertyType::Bool: SetBool(Value.BoolValue); break;
+    case ESpacetimeDBPropertyType::Byte: SetByte(Value.ByteValue); break;
+    case ESpacetimeDBPropertyType::Int32: SetInt32(Value.Int32Value); break;
+    case ESpacetimeDBPropertyType::Int64: SetInt64(Value.Int64Value); break;
+    case ESpacetimeDBPropertyType::UInt32: SetUInt32(Value.UInt32Value); break;
+    case ESpacetimeDBPropertyType::UInt64: SetUInt64(Value.UInt64Value); break;
+    case ESpacetimeDBPropertyType::Float: SetFloat(Value.FloatValue); break;
+    case ESpacetimeDBPropertyType::Double: SetDouble(Value.DoubleValue); break;
+    case ESpacetimeDBPropertyType::Vector: SetVector(Value.VectorValue); break;
+    case ESpacetimeDBPropertyType::Rotator: SetRotator(Value.RotatorValue); break;
+    case ESpacetimeDBPropertyType::Quat: SetQuat(Value.QuatValue); break;
+    case ESpacetimeDBPropertyType::Transform: SetTransform(Value.TransformValue); break;
+    case ESpacetimeDBPropertyType::Color: SetColor(Value.ColorValue); break;
+
+    case ESpacetimeDBPropertyType::String:
+    case ESpacetimeDBPropertyType::Name:
+    case ESpacetimeDBPropertyType::Text:
+    case ESpacetimeDBPropertyType::ClassReference:
+        SetString(Value.Type, Value.StringValue);
+        break;
+
+    case ESpacetimeDBPropertyType::ObjectReference:
+        // Decoded binary references carry a path instead of an ID
+        if (!Value.StringValue.IsEmpty())
+        {
+            SetString(Value.Type, Value.StringValue);
+        }
+        else
+        {
+            SetObjectReference(Value.ObjectReferenceValue.Value);
+        }
+        break;
+
+    case ESpacetimeDBPropertyType::Array:
+    case ESpacetimeDBPropertyType::Map:
+    case ESpacetimeDBPropertyType::Set:
+    case ESpacetimeDBPropertyType::Custom:
+        SetString(Value.Type, Value.JsonValue);
+        break;
+
+    default:
+        SetTypeOnly(Value.Type);
+        break;
+    }
+}
+
 // Apply a property value to a UObject property
 bool USpacetimeDBPropertyHandler::ApplyPropertyToObject(UObject* Object, const FString& PropertyName, const FSpacetimeDBPropertyValue& PropValue)
 {
@@ -414,16 +632,17 @@ bool USpacetimeDBPropertyHandler::ApplyPropertyToObject(UObject* Object, const F
     }
     
     // Find the property in the object
-    FProperty* Property = Object->GetClass()->FindPropertyByName(FName(*PropertyName));
-    if (!Property)
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName);
+    if (!Descriptor)
     {
         UE_LOG(LogTemp, Error, TEXT("ApplyPropertyToObject: Property '%s' not found in object of class '%s'"), 
             *PropertyName, *Object->GetClass()->GetName());
         return false;
     }
+    FProperty* Property = Descriptor->Property;
     
     // Get a pointer to the property memory in the object
-    void* PropertyPtr = Property->ContainerPtrToValuePtr<void>(Object);
+    void* PropertyPtr = Descriptor->GetValuePtr(Object);
     
     // Apply the property value to the property
     return ApplyPropertyValueToProperty(Property, PropertyPtr, PropValue);
@@ -439,16 +658,17 @@ bool USpacetimeDBPropertyHandler::ExtractPropertyFromObject(UObject* Object, con
     }
     
     // Find the property in the object
-    FProperty* Property = Object->GetClass()->FindPropertyByName(FName(*PropertyName));
-    if (!Property)
+    const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(Object->GetClass(), PropertyName);
+    if (!Descriptor)
     {
         UE_LOG(LogTemp, Error, TEXT("ExtractPropertyFromObject: Property '%s' not found in object of class '%s'"), 
             *PropertyName, *Object->GetClass()->GetName());
         return false;
     }
+    FProperty* Property = Descriptor->Property;
     
     // Get a pointer to the property memory in the object
-    const void* PropertyPtr = Property->ContainerPtrToValuePtr<void>(Object);
+    const void* PropertyPtr = Descriptor->GetValuePtr(Object);
     
     // Extract the property value from the property
     return ExtractPropertyValueFromProperty(Property, PropertyPtr, OutPropValue);
@@ -5,6 +5,8 @@
 #include "SpacetimeDBNetDriver.h"
 #include "SpacetimeDBNetConnection.h"
 #include "SpacetimeDBSubsystem.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
+#include "SpacetimeDBClassRegistry.h"
 #include "Net/UnrealNetwork.h"
 #include "Misc/CoreDelegates.h"
 #include "Misc/Paths.h"
@@ -21,6 +23,12 @@ void FSpacetimeDB_UnrealClientModule::StartupModule()
     // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDB Unreal Client module starting up"));
     
+    // Property descriptors are built lazily; hook reloads so stale layouts are dropped
+    FSpacetimeDBPropertyDescriptorCache::Startup();
+    
+    // Core class IDs are known up front; project classes arrive with the object_class table
+    FSpacetimeDBClassRegistry::Startup();
+    
     // Register the SpacetimeDB NetDriver
     if (!GEngine->NetDriverDefinitions.ContainsByPredicate([](const FNetDriverDefinition& Def) {
         return Def.DefName == FName(TEXT("SpacetimeDB"));
@@ -65,6 +73,9 @@ void FSpacetimeDB_UnrealClientModule::ShutdownModule()
     // For modules that support dynamic reloading, we call this function before unloading the module.
     UE_LOG(LogTemp, Log, TEXT("SpacetimeDB Unreal Client module shutting down"));
     
+    FSpacetimeDBPropertyDescriptorCache::Shutdown();
+    FSpacetimeDBClassRegistry::Shutdown();
+    
     // Unregister NetDriver
     if (GEngine)
     {
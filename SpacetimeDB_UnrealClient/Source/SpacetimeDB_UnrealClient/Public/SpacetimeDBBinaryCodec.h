@@ -0,0 +1,262 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "SpacetimeDB_PropertyValue.h"
+
+struct FSpacetimeDBPropertyDescriptor;
+
+/**
+ * Little-endian byte writer used by the binary property wire format.
+ * Appends to a caller-owned buffer so the same buffer can be reused across updates.
+ */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBBinaryWriter
+{
+    explicit FSpacetimeDBBinaryWriter(TArray<uint8>& InBytes) : Bytes(InBytes) {}
+
+    void WriteBytes(const void* Data, int32 Num);
+    void WriteUInt8(uint8 Value) { Bytes.Add(Value); }
+    void WriteUInt16(uint16 Value) { WriteBytes(&Value, sizeof(Value)); }
+    void WriteInt16(int16 Value) { WriteBytes(&Value, sizeof(Value)); }
+    void WriteUInt32(uint32 Value) { WriteBytes(&Value, sizeof(Value)); }
+    void WriteInt32(int32 Value) { WriteBytes(&Value, sizeof(Value)); }
+    void WriteInt64(int64 Value) { WriteBytes(&Value, sizeof(Value)); }
+    void WriteUInt64(uint64 Value) { WriteBytes(&Value, sizeof(Value)); }
+    void WriteFloat(float Value) { WriteBytes(&Value, sizeof(Value)); }
+    void WriteDouble(double Value) { WriteBytes(&Value, sizeof(Value)); }
+
+    /** Writes a uint32 byte length followed by the UTF-8 bytes of the string (no terminator) */
+    void WriteString(const FString& Value);
+
+    /** Writes an unsigned LEB128 varint: 7 bits per byte, low bits first, high bit set on all but the last byte */
+    void WriteVarUInt64(uint64 Value);
+
+    TArray<uint8>& Bytes;
+};
+
+/**
+ * Bounds-checked little-endian byte reader for the binary property wire format.
+ * Once a read runs past the end of the buffer the reader is flagged as failed and all
+ * further reads return zeroed values.
+ */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBBinaryReader
+{
+    FSpacetimeDBBinaryReader(const uint8* InData, int32 InSize) : Data(InData), Size(InSize) {}
+
+    bool ReadBytes(void* Out, int32 Num);
+    uint8 ReadUInt8() { uint8 Value = 0; ReadBytes(&Value, sizeof(Value)); return Value; }
+    uint16 ReadUInt16() { uint16 Value = 0; ReadBytes(&Value, sizeof(Value)); return Value; }
+    int16 ReadInt16() { int16 Value = 0; ReadBytes(&Value, sizeof(Value)); return Value; }
+    uint32 ReadUInt32() { uint32 Value = 0; ReadBytes(&Value, sizeof(Value)); return Value; }
+    int32 ReadInt32() { int32 Value = 0; ReadBytes(&Value, sizeof(Value)); return Value; }
+    int64 ReadInt64() { int64 Value = 0; ReadBytes(&Value, sizeof(Value)); return Value; }
+    uint64 ReadUInt64() { uint64 Value = 0; ReadBytes(&Value, sizeof(Value)); return Value; }
+    float ReadFloat() { float Value = 0.0f; ReadBytes(&Value, sizeof(Value)); return Value; }
+    double ReadDouble() { double Value = 0.0; ReadBytes(&Value, sizeof(Value)); return Value; }
+
+    /** Reads a string written by FSpacetimeDBBinaryWriter::WriteString */
+    FString ReadString();
+
+    /** Reads a varint written by FSpacetimeDBBinaryWriter::WriteVarUInt64 */
+    uint64 ReadVarUInt64();
+
+    bool IsError() const { return bError; }
+    bool IsAtEnd() const { return Offset >= Size; }
+    int32 GetOffset() const { return Offset; }
+
+    const uint8* Data = nullptr;
+    int32 Size = 0;
+    int32 Offset = 0;
+    bool bError = false;
+};
+
+/** Result of FSpacetimeDBBinaryCodec::ApplyDelta */
+enum class ESpacetimeDBDeltaResult : uint8
+{
+    Applied,
+
+    /** The current value isn't the one the delta was computed against; nothing was written */
+    BaseMismatch,
+
+    /** The delta doesn't fit the property; the value may be partially edited */
+    Malformed
+};
+
+/**
+ * Compact tagged binary encoding for replicated property values.
+ *
+ * Every encoded value starts with a one byte ESpacetimeDBPropertyType tag followed by the
+ * payload for that tag. Scalars are stored at their native width, strings as a length
+ * prefixed UTF-8 run, math structs as packed 32-bit floats (matching stdb::shared types),
+ * and containers as an element tag plus a count followed by untagged element payloads.
+ * Any other struct is written as Custom: a field count followed by each field tagged.
+ *
+ * Values are encoded from and decoded straight into FProperty memory, so no intermediate
+ * JSON or FSpacetimeDBPropertyValue is built on the hot path.
+ *
+ * Custom structs, arrays and maps can also be sent as a delta against a previous value. A delta
+ * sets DeltaTagFlag on the tag and is followed by a CRC32 checksum of the value it was computed
+ * against, in which map and set entries are combined without regard to their order, then by the edits: changed struct fields by index, or update, insert and
+ * remove operations on array indices and map keys. A receiver whose current value doesn't match
+ * the checksum rejects the delta and needs the full value again.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBBinaryCodec
+{
+public:
+    /**
+     * Gets the wire type tag used for a property.
+     *
+     * @param Property The property to classify
+     * @return The tag, or ESpacetimeDBPropertyType::None if the property type is unsupported
+     */
+    static ESpacetimeDBPropertyType GetPropertyTypeTag(const FProperty* Property);
+
+    /**
+     * Encodes a property value (tag + payload), appending to OutBytes.
+     *
+     * @param Property The property describing the value
+     * @param PropertyAddr Pointer to the property's memory
+     * @param OutBytes Buffer the encoded value is appended to
+     * @return True if the value was encoded
+     */
+    static bool EncodeProperty(const FProperty* Property, const void* PropertyAddr, TArray<uint8>& OutBytes);
+
+    /**
+     * Decodes a tagged value straight into property memory.
+     *
+     * @param Property The property describing the destination
+     * @param PropertyAddr Pointer to the property's memory
+     * @param Data The encoded bytes
+     * @param Size Number of encoded bytes
+     * @return True if the whole buffer was decoded into the property
+     */
+    static bool DecodeProperty(const FProperty* Property, void* PropertyAddr, const uint8* Data, int32 Size);
+
+    /**
+     * Encodes a described property of an object, using its generated accessor if it has one.
+     *
+     * @param Descriptor The property descriptor
+     * @param Object An object of the described class
+     * @param OutBytes Buffer the encoded value is appended to
+     * @return True if the value was encoded
+     */
+    static bool EncodeProperty(const FSpacetimeDBPropertyDescriptor& Descriptor, const UObject* Object, TArray<uint8>& OutBytes);
+
+    /**
+     * Decodes a tagged value into a described property of an object, using its generated
+     * accessor if it has one and the tag is the property's own.
+     *
+     * @param Descriptor The property descriptor
+     * @param Object An object of the described class
+     * @param Data The encoded bytes
+     * @param Size Number of encoded bytes
+     * @return True if the whole buffer was decoded into the property
+     */
+    static bool DecodeProperty(const FSpacetimeDBPropertyDescriptor& Descriptor, UObject* Object, const uint8* Data, int32 Size);
+
+    /**
+     * Encodes a named property of an object.
+     *
+     * @param Object The object that contains the property
+     * @param PropertyName The name of the property to encode
+     * @param OutBytes Buffer the encoded value is written to (reset first)
+     * @return True if the property was found and encoded
+     */
+    static bool SerializePropertyToBinary(UObject* Object, const FString& PropertyName, TArray<uint8>& OutBytes);
+
+    /**
+     * Applies an encoded value to a named property of an object and fires its RepNotify.
+     *
+     * @param Object The object that contains the property
+     * @param PropertyName The name of the property to modify
+     * @param Data The encoded bytes
+     * @param Size Number of encoded bytes
+     * @return True if the property was successfully applied
+     */
+    static bool ApplyBinaryToProperty(UObject* Object, const FString& PropertyName, const uint8* Data, int32 Size);
+
+    /**
+     * Applies an encoded value to a property already resolved to an FName, e.g. from an interned
+     * property ID, skipping the string to name conversion.
+     *
+     * @param Object The object that contains the property
+     * @param PropertyName The name of the property to modify
+     * @param Data The encoded bytes
+     * @param Size Number of encoded bytes
+     * @return True if the property was successfully applied
+     */
+    static bool ApplyBinaryToProperty(UObject* Object, FName PropertyName, const uint8* Data, int32 Size);
+
+    /**
+     * Decodes the scalar and math struct tags into an FSpacetimeDBPropertyValue for event listeners.
+     * Containers and custom structs only report their Type; their payload is not expanded.
+     *
+     * @param Data The encoded bytes
+     * @param Size Number of encoded bytes
+     * @param OutValue The decoded value
+     * @return True if the tag was recognised
+     */
+    static bool DecodePropertyValue(const uint8* Data, int32 Size, FSpacetimeDBPropertyValue& OutValue);
+
+    /** Same as above into the compact value, which native code should prefer */
+    static bool DecodePropertyValue(const uint8* Data, int32 Size, FSpacetimeDBCompactPropertyValue& OutValue);
+
+    /** Set on the tag byte of a delta; full values never carry it */
+    static constexpr uint8 DeltaTagFlag = 0x80;
+
+    /** Whether encoded bytes hold a delta rather than a full value */
+    static bool IsDelta(const uint8* Data, int32 Size) { return Data && Size > 0 && (Data[0] & DeltaTagFlag) != 0; }
+
+    /** Whether a property can be sent as a delta: custom structs, arrays and maps */
+    static bool SupportsDelta(const FProperty* Property);
+
+    /**
+     * Encodes the difference between a previously encoded value and a property's current value.
+     *
+     * @param Property The property
+     * @param BaseData Full encoding of the value the receiver is assumed to hold
+     * @param BaseSize Number of bytes in BaseData
+     * @param PropertyAddr The property's current value
+     * @param OutBytes Buffer the delta is appended to
+     * @return False if the property doesn't support deltas or the base can't be decoded
+     */
+    static bool EncodeDelta(const FProperty* Property, const uint8* BaseData, int32 BaseSize, const void* PropertyAddr, TArray<uint8>& OutBytes);
+
+    /**
+     * Applies a delta in place to a described property of an object. Does not fire the RepNotify.
+     *
+     * @param Descriptor The property descriptor
+     * @param Object An object of the described class
+     * @param Data The delta bytes
+     * @param Size Number of delta bytes
+     * @return Whether the delta was applied, or why not
+     */
+    static ESpacetimeDBDeltaResult ApplyDelta(const FSpacetimeDBPropertyDescriptor& Descriptor, UObject* Object, const uint8* Data, int32 Size);
+
+private:
+    /** Writes the untagged payload for a property */
+    static bool WritePayload(const FProperty* Property, const void* PropertyAddr, FSpacetimeDBBinaryWriter& Writer);
+
+    /** Reads an untagged payload written with the given tag into a property */
+    static bool ReadPayload(const FProperty* Property, void* PropertyAddr, ESpacetimeDBPropertyType Tag, FSpacetimeDBBinaryReader& Reader);
+
+    /** Writes the edits that turn the value at BaseAddr into the value at PropertyAddr */
+    static bool WriteDeltaPayload(const FProperty* Property, const void* BaseAddr, const void* PropertyAddr, FSpacetimeDBBinaryWriter& Writer);
+
+    /**
+     * Computes the base checksum carried by a delta. Map and set entries are summed rather than
+     * chained, so two equal containers match whatever order their elements were added in.
+     *
+     * @param Scratch Buffer the scalar payloads are encoded into
+     * @return False if the value holds an unsupported type
+     */
+    static bool ComputeChecksum(const FProperty* Property, const void* PropertyAddr, TArray<uint8>& Scratch, uint32& OutChecksum);
+
+    /** Reads edits written by WriteDeltaPayload and applies them to a property */
+    static bool ReadDeltaPayload(const FProperty* Property, void* PropertyAddr, FSpacetimeDBBinaryReader& Reader);
+
+    /** Decodes into a resolved property and fires its RepNotify */
+    static bool ApplyBinaryToDescriptor(const FSpacetimeDBPropertyDescriptor& Descriptor, UObject* Object, const uint8* Data, int32 Size);
+};
@@ -0,0 +1,75 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** A class ID reserved for a core engine class */
+struct FSpacetimeDBCoreClassId
+{
+    /** Full class path, e.g. /Script/Engine.Actor */
+    const TCHAR* ClassPath;
+
+    /** The ID the server uses for it */
+    int32 ClassId;
+};
+
+/**
+ * Resolves the classes the server spawns objects and components from.
+ *
+ * Server class IDs index straight into an array built at startup from the core class table
+ * and extended as object_class rows arrive, so spawning by ID costs no string work at all.
+ * Lookups by name are cached too, including misses, so an unknown class name only pays
+ * for the global object-hash probes once. Misses are forgotten when new classes can appear
+ * (asset loads, hot reload, Live Coding).
+ *
+ * Game thread only.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBClassRegistry
+{
+public:
+    /** Class IDs below this index resolve with an array lookup; larger IDs fall back to a map */
+    static constexpr int32 MaxDirectClassId = 1 << 16;
+
+    /** Seeds the core class IDs and registers the invalidation hooks. Called from module startup. */
+    static void Startup();
+
+    /** Unregisters the hooks and clears every table. Called from module shutdown. */
+    static void Shutdown();
+
+    /**
+     * The core engine classes and their fixed IDs (1-99).
+     * USpacetimeDBCodeGenerator exports this same table to the server module.
+     */
+    static TConstArrayView<FSpacetimeDBCoreClassId> GetCoreClassIds();
+
+    /**
+     * Associates a server class ID with a class path.
+     *
+     * @param ClassId The server class ID
+     * @param ClassPath Full class path; resolved now if loaded, otherwise on first use
+     */
+    static void RegisterClassId(int32 ClassId, const FString& ClassPath);
+
+    /**
+     * Finds the class for a server class ID.
+     *
+     * @param ClassId The server class ID
+     * @return The class, or null if the ID is unknown or its class is not loaded
+     */
+    static UClass* FindClassById(int32 ClassId);
+
+    /**
+     * Finds a class by path or short name, also trying the U and A prefixes.
+     *
+     * @param ClassName Full class path or short class name
+     * @return The class, or null if no such class is loaded
+     */
+    static UClass* FindClassByName(const FString& ClassName);
+
+    /** Forgets every cached miss so the next lookup probes again */
+    static void ClearUnknownClasses();
+
+private:
+    static UClass* ResolveClassByName(const FString& ClassName);
+};
@@ -5,7 +5,25 @@
 #include "CoreMinimal.h"
 #include "Containers/UnrealString.h"
 #include "Containers/Array.h"
+#include "HAL/ThreadSafeCounter64.h"
 #include "SpacetimeDB_ErrorHandler.h"
+#include "SpacetimeDB_Types.h"
+#include "SpacetimeDBEventQueue.h"
+#include "SpacetimeDBFrameArena.h"
+#include "SpacetimeDBSubscriptionManager.h"
+#include "SpacetimeDBEventCapture.h"
+
+class USpacetimeDBSubsystem;
+
+/** A property name the server interned for the current connection */
+struct FSpacetimeDBInternedProperty
+{
+    /** The name as sent on the wire */
+    FString WireName;
+
+    /** The same name, resolved once so receive paths never construct it */
+    FName Name;
+};
 
 // Forward declarations for SpacetimeDB FFI types
 namespace stdb {
@@ -22,6 +40,9 @@ namespace stdb {
  * This class provides a clean C++ interface for interacting with the SpacetimeDB
  * Rust client library via FFI. It handles connection management, reducer calls,
  * subscriptions, and event handling.
+ * 
+ * Each client owns a connection handle of its own, so any number of clients can be connected
+ * at once, e.g. a bot swarm in one process or a server talking to several databases.
  */
 class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBClient
 {
@@ -32,6 +53,12 @@ public:
     /** Delegate for handling SpacetimeDB disconnection events */
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnDisconnected, const FString& /* Reason */);
     
+    /** Delegate for when a dropped connection will be retried after a delay */
+    DECLARE_MULTICAST_DELEGATE_TwoParams(FOnReconnecting, int32 /* Attempt */, float /* DelaySeconds */);
+    
+    /** Delegate for when every reconnection attempt has failed */
+    DECLARE_MULTICAST_DELEGATE(FOnReconnectFailed);
+    
     /** Delegate for handling SpacetimeDB identity received events */
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnIdentityReceived, const FString& /* Identity */);
     
@@ -44,9 +71,21 @@ public:
     /** Delegate for when a property is updated on an object */
     DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnPropertyUpdated, uint64 /* ObjectId */, const FString& /* PropertyName */, const FString& /* ValueJson */);
     
+    /** Delegate for when a property is updated on an object using the binary wire format (see FSpacetimeDBBinaryCodec) */
+    DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnPropertyUpdatedBinary, uint64 /* ObjectId */, const FString& /* PropertyName */, const TArray<uint8>& /* Payload */);
+    
+    /** Delegate for when a property is updated using the binary wire format and an interned property ID (see FindInternedProperty) */
+    DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnPropertyUpdatedBinaryById, uint64 /* ObjectId */, uint32 /* PropertyId */, const TArray<uint8>& /* Payload */);
+    
+    /** Delegate for when the server calls a typed client RPC (see SpacetimeDBTypedRpc) */
+    DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnClientRpcBinary, uint64 /* ObjectId */, uint32 /* FunctionId */, const TArray<uint8>& /* Args */);
+    
     /** Delegate for when an object is created */
     DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnObjectCreated, uint64 /* ObjectId */, const FString& /* ClassName */, const FString& /* DataJson */);
     
+    /** Delegate for when an object is created, identified by server class ID (see FSpacetimeDBClassRegistry) */
+    DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnObjectCreatedByClassId, uint64 /* ObjectId */, uint32 /* ClassId */, const FString& /* DataJson */);
+    
     /** Delegate for when an object is destroyed */
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnObjectDestroyed, uint64 /* ObjectId */);
     
@@ -68,6 +107,10 @@ public:
     /** Destructor - ensures client is disconnected */
     ~FSpacetimeDBClient();
     
+    /** The FFI callbacks hold the address of the client */
+    FSpacetimeDBClient(const FSpacetimeDBClient&) = delete;
+    FSpacetimeDBClient& operator=(const FSpacetimeDBClient&) = delete;
+    
     /**
      * Connects to a SpacetimeDB instance.
      * 
@@ -79,12 +122,24 @@ public:
     bool Connect(const FString& Host, const FString& DatabaseName, const FString& AuthToken = TEXT(""));
     
     /**
-     * Disconnects from the SpacetimeDB instance.
+     * Disconnects from the SpacetimeDB instance. Also stops retrying a dropped connection.
      * 
      * @return True if disconnection was successful, false if not connected
      */
     bool Disconnect();
     
+    /**
+     * Whether a dropped connection is being retried. With bAutoReconnect, a connection that closes
+     * without Disconnect being called is opened again with exponential backoff, up to MaxReconnectionAttempts.
+     * Already true while OnDisconnected is broadcast for the drop.
+     * 
+     * @return True between the drop and the next successful connect or the last failed attempt
+     */
+    bool IsReconnecting() const { return ReconnectAttempt > 0; }
+    
+    /** Stops retrying a dropped connection */
+    void CancelReconnect();
+    
     /**
      * Checks if the client is currently connected.
      * 
@@ -94,21 +149,53 @@ public:
     
     /**
      * Calls a reducer function on the SpacetimeDB instance.
+     * With bBatchReducerCalls set, calls made on the game thread are queued and submitted in order by
+     * FlushReducerCalls; failures found then are reported through OnErrorOccurred.
      * 
      * @param ReducerName The name of the reducer to call
      * @param ArgsJson A JSON string with the arguments for the reducer
-     * @return True if the call was initiated successfully, false otherwise
+     * @return True if the call was initiated (or queued) successfully, false otherwise
      */
     bool CallReducer(const FString& ReducerName, const FString& ArgsJson);
     
+    /**
+     * Submits every queued reducer call in one FFI call. Called at the end of each frame.
+     */
+    void FlushReducerCalls();
+    
+    /**
+     * Gets the number of reducer calls waiting for the next flush.
+     * 
+     * @return The number of queued calls
+     */
+    int32 GetNumQueuedReducerCalls() const { return QueuedReducerNames.Num(); }
+    
     /**
      * Subscribes to one or more tables in the SpacetimeDB instance.
+     * This sends the subscription as is; go through GetSubscriptions() to share subscriptions
+     * with the other systems using this client.
      * 
      * @param TableNames Array of table names to subscribe to
      * @return True if the subscription was initiated successfully, false otherwise
      */
     bool SubscribeToTables(const TArray<FString>& TableNames);
     
+    /**
+     * Unsubscribes from tables or queries previously passed to SubscribeToTables.
+     * 
+     * @param TableNames Array of table names or queries to unsubscribe from
+     * @return True if the unsubscription was initiated successfully, false otherwise
+     */
+    bool UnsubscribeFromTables(const TArray<FString>& TableNames);
+    
+    /**
+     * Gets the reference-counted subscription set of this client.
+     * 
+     * @return The subscription manager
+     */
+    FSpacetimeDBSubscriptionManager& GetSubscriptions() { return Subscriptions; }
+    const FSpacetimeDBSubscriptionManager& GetSubscriptions() const { return Subscriptions; }
+    
     /**
      * Gets the client's identity as a hex string.
      * 
@@ -123,12 +210,141 @@ public:
      */
     uint64 GetClientID() const;
     
+    /**
+     * Makes this client's connection the one FFI calls on the calling thread act on. The client
+     * does this itself; code calling the FFI directly does it first. Cheap when already current.
+     */
+    void SelectConnection() const;
+    
+    /**
+     * Gets the FFI handle of this client's connection.
+     * 
+     * @return The handle, or 0 before the first Connect
+     */
+    uint64 GetConnectionHandle() const { return ConnectionHandle; }
+    
+    /**
+     * Sets the subsystem that spawns this client's objects and handles its component events.
+     * 
+     * @param InOwner The owning subsystem, or null
+     */
+    void SetOwner(USpacetimeDBSubsystem* InOwner) { Owner = InOwner; }
+    USpacetimeDBSubsystem* GetOwner() const { return Owner; }
+    
+    /**
+     * Gets the client an FFI callback or handler was called for.
+     * 
+     * @param Context The callback context the connection was created with
+     * @return The client, or null if the context isn't one of a live client
+     */
+    static FSpacetimeDBClient* FromCallbackContext(uintptr_t Context);
+    
+    /**
+     * Processes events queued by the FFI callbacks, broadcasting the delegates below.
+     * Must be called on the game thread, normally once per frame.
+     * 
+     * @param TimeBudgetSeconds Processing stops once this much time has been spent; remaining events wait for the next call
+     * @return The number of events processed
+     */
+    int32 ProcessInboundEvents(double TimeBudgetSeconds);
+    
+    /**
+     * Gets depth, drop and backpressure statistics for the inbound event queue.
+     * 
+     * @return The current statistics
+     */
+    FSpacetimeDBEventQueueStats GetInboundQueueStats() const;
+    
+    /**
+     * Gets the bytes received per table and sent per reducer since the client was created. Traffic
+     * is only counted while IsCollectingTrafficStats is true.
+     * 
+     * @param OutStats Receives one entry per table, then one per reducer
+     */
+    void GetTrafficStats(TArray<FSpacetimeDBTrafficStats>& OutStats) const;
+    
+    /**
+     * Starts writing every dispatched inbound event to a capture file, for StartReplay.
+     * 
+     * @param FilePath Relative paths are under Saved/SpacetimeDB
+     * @return False if the file couldn't be created
+     */
+    bool StartRecording(const FString& FilePath);
+    
+    /** Finishes the capture started by StartRecording */
+    void StopRecording();
+    
+    bool IsRecording() const { return Recorder.IsOpen(); }
+    
+    /**
+     * Feeds a capture back through the FFI callbacks from a background thread, as if a server
+     * were sending it. Only possible while disconnected.
+     * 
+     * @param FilePath Relative paths are under Saved/SpacetimeDB
+     * @param bAsFastAsPossible Ignore the recorded timing; the inbound queue's backpressure paces the replay
+     * @return False if connected, already replaying, or the file is not a capture
+     */
+    bool StartReplay(const FString& FilePath, bool bAsFastAsPossible);
+    
+    /** Stops a replay; events already queued are still processed */
+    void StopReplay();
+    
+    bool IsReplaying() const { return Replayer.IsValid(); }
+    
+    /** Gets the progress of the running replay, or the report of the last one */
+    FSpacetimeDBReplayStats GetReplayStats() const { return ReplayStats; }
+    
+    /**
+     * Scratch memory for decoding the events of one drain. Everything allocated from it
+     * during ProcessInboundEvents is released when the drain ends. Code that uses it after
+     * the drain, like the subsystem's property flush, resets it once done. Game thread only.
+     * 
+     * @return The arena
+     */
+    FSpacetimeDBFrameArena& GetFrameArena() { return FrameArena; }
+    
+    /**
+     * The payload decoded on the network thread for the event whose delegates are being broadcast.
+     * 
+     * @return The decoded payload, or null outside ProcessInboundEvents or when nothing was decoded
+     */
+    const FSpacetimeDBDecodedPayload* GetDispatchingPayload() const { return DispatchingPayload; }
+    
+    /**
+     * Finds a property name the server interned for this connection.
+     * 
+     * @param PropertyId The interned ID
+     * @return The name, or null if the server hasn't announced the ID
+     */
+    const FSpacetimeDBInternedProperty* FindInternedProperty(uint32 PropertyId) const
+    {
+        return InternedProperties.IsValidIndex(PropertyId) && !InternedProperties[PropertyId].Name.IsNone() ? &InternedProperties[PropertyId] : nullptr;
+    }
+    
+    /**
+     * Finds the interned ID of a property name.
+     * 
+     * @param PropertyName The property name
+     * @return The ID, or 0 if the name hasn't been interned
+     */
+    uint32 FindInternedPropertyId(const FString& PropertyName) const
+    {
+        const uint32* Id = InternedPropertyIds.Find(PropertyName);
+        return Id ? *Id : 0;
+    }
+    
     /** Delegate that is broadcast when the connection is established */
     FOnConnected OnConnected;
     
     /** Delegate that is broadcast when the connection is closed */
     FOnDisconnected OnDisconnected;
     
+    /** Delegate that is broadcast when a reconnection attempt is scheduled */
+    FOnReconnecting OnReconnecting;
+    
+    /** Delegate that is broadcast when the reconnection attempts are used up */
+    FOnReconnectFailed OnReconnectFailed;
+    
     /** Delegate that is broadcast when the client identity is received */
     FOnIdentityReceived OnIdentityReceived;
     
@@ -141,9 +357,21 @@ public:
     /** Delegate that is broadcast when a property is updated on an object */
     FOnPropertyUpdated OnPropertyUpdated;
     
+    /** Delegate that is broadcast when a binary encoded property update is received */
+    FOnPropertyUpdatedBinary OnPropertyUpdatedBinary;
+    
+    /** Delegate that is broadcast when a binary encoded update of an interned property is received */
+    FOnPropertyUpdatedBinaryById OnPropertyUpdatedBinaryById;
+    
+    /** Delegate that is broadcast when the server calls a typed client RPC */
+    FOnClientRpcBinary OnClientRpcBinary;
+    
     /** Delegate that is broadcast when an object is created */
     FOnObjectCreated OnObjectCreated;
     
+    /** Delegate that is broadcast when an object is created by server class ID */
+    FOnObjectCreatedByClassId OnObjectCreatedByClassId;
+    
     /** Delegate that is broadcast when an object is destroyed */
     FOnObjectDestroyed OnObjectDestroyed;
     
@@ -151,23 +379,150 @@ public:
     FOnObjectIdRemapped OnObjectIdRemapped;
     
 private:
-    // FFI callback functions
-    static void OnConnectedCallback();
-    static void OnDisconnectedCallback(const char* Reason);
-    static void OnIdentityReceivedCallback(const char* Identity);
-    static void OnEventReceivedCallback(const char* EventData, const char* TableName);
-    static void OnErrorOccurredCallback(const char* ErrorMessage);
+    /**
+     * Pushes an event from an FFI callback onto the inbound queue of the callback's client, waiting
+     * briefly when it is full. Fill writes the event straight into a queue cell (see FSpacetimeDBEventQueue::EnqueueWith).
+     */
+    template<typename FillFunc>
+    static void PushInboundEvent(uintptr_t Context, FillFunc&& Fill);
+    
+    /** Whether the callbacks of a client should parse payloads before queueing them */
+    static bool ShouldDecodePayloads(uintptr_t Context)
+    {
+        const FSpacetimeDBClient* Client = FromCallbackContext(Context);
+        return Client && Client->bDecodePayloadsOffGameThread;
+    }
+    
+    /** Creates the inbound queue if needed and reads its settings; the queue survives reconnects */
+    void InitializeInboundQueue();
+    
+    /** Pushes a replayed event through the FFI callback it was captured from */
+    void ReplayInboundEvent(const FSpacetimeDBInboundEvent& Event);
+    
+    /** Updates the replay's frame times and finishes it once every event is processed */
+    void TickReplay();
+    
+    /** Schedules the next attempt to restore a dropped connection, or gives up after the last one */
+    void ScheduleReconnect();
+    
+    /** Makes a scheduled reconnection attempt once its delay is over */
+    void TickReconnect();
+    
+    /** Broadcasts OnErrorOccurred on the game thread; only for errors the error handler reported */
+    void BroadcastError(const FSpacetimeDBErrorInfo& ErrorInfo);
+    
+    /** Broadcasts a dequeued event on the game thread */
+    void DispatchInboundEvent(FSpacetimeDBInboundEvent& Event);
+    
+    // FFI callback functions; Context is the client the connection was created for
+    static void OnConnectedCallback(uintptr_t Context);
+    static void OnDisconnectedCallback(uintptr_t Context, const char* Reason);
+    static void OnIdentityReceivedCallback(uintptr_t Context, const char* Identity);
+    static void OnEventReceivedCallback(uintptr_t Context, const char* EventData, const char* TableName);
+    static void OnErrorOccurredCallback(uintptr_t Context, const char* ErrorMessage);
     
     // New FFI callback functions for object management
-    static void OnPropertyUpdatedCallback(uint64 ObjectId, const char* PropertyName, const char* ValueJson);
-    static void OnObjectCreatedCallback(uint64 ObjectId, const char* ClassName, const char* DataJson);
-    static void OnObjectDestroyedCallback(uint64 ObjectId);
-    static void OnObjectIdRemappedCallback(uint64 TempId, uint64 ServerId);
+    static void OnPropertyUpdatedCallback(uintptr_t Context, uint64 ObjectId, const char* PropertyName, const char* ValueJson);
+    static void OnPropertyUpdatedBinaryCallback(uintptr_t Context, uint64 ObjectId, const char* PropertyName, const uint8* Data, size_t DataLen);
+    static void OnObjectCreatedCallback(uintptr_t Context, uint64 ObjectId, const char* ClassName, const char* DataJson);
+    static void OnObjectDestroyedCallback(uintptr_t Context, uint64 ObjectId);
+    static void OnObjectIdRemappedCallback(uintptr_t Context, uint64 TempId, uint64 ServerId);
     
     // FFI callback functions for component management
-    static void OnComponentAddedCallback(uint64 ActorId, uint64 ComponentId, const char* ComponentClassName, const char* DataJson);
-    static void OnComponentRemovedCallback(uint64 ActorId, uint64 ComponentId);
+    static void OnObjectCreatedByClassIdCallback(uintptr_t Context, uint64 ObjectId, uint32 ClassId, const char* DataJson);
+    static void OnComponentAddedCallback(uintptr_t Context, uint64 ActorId, uint64 ComponentId, const char* ComponentClassName, const char* DataJson);
+    static void OnComponentRemovedCallback(uintptr_t Context, uint64 ActorId, uint64 ComponentId);
+    static void OnSubscriptionAppliedCallback(uintptr_t Context, const char* Query);
+    static void OnPropertyNameRegisteredCallback(uintptr_t Context, uint32 PropertyId, const char* PropertyName);
+    static void OnPropertyUpdatedBinaryByIdCallback(uintptr_t Context, uint64 ObjectId, uint32 PropertyId, const uint8* Data, size_t DataLen);
+    static void OnClientRpcBinaryCallback(uintptr_t Context, uint64 ObjectId, uint32 FunctionId, const uint8* Data, size_t DataLen);
+    
+    /** Records an interned property name; IDs are only valid for the current connection */
+    void RegisterInternedProperty(uint32 PropertyId, const FString& PropertyName);
+    
+    /** Whether traffic is counted: while stats are collected, the SpacetimeDB trace channel is on or the setting asks for it */
+    static bool IsCollectingTrafficStats();
+    
+    /** Adds one message to the traffic of a table or reducer if traffic is counted; thread safe */
+    void RecordTraffic(const FString& Name, bool bOutbound, int32 Bytes);
+    
+    /** Sends one reducer call straight through the FFI */
+    bool CallReducerNow(const FString& ReducerName, const FString& ArgsJson);
+    
+    /** Reducer calls waiting for FlushReducerCalls, encoded for call_reducers_batched */
+    TArray<uint8> ReducerBatchBuffer;
+    
+    /** Name of each queued call, in order, for error reports */
+    TArray<FString> QueuedReducerNames;
+    
+    /** Interned property names, indexed by ID */
+    TArray<FSpacetimeDBInternedProperty> InternedProperties;
+    
+    /** Interned property IDs by name, for outgoing updates */
+    TMap<FString, uint32> InternedPropertyIds;
+    
+    /** Subscriptions shared by every system using this client */
+    FSpacetimeDBSubscriptionManager Subscriptions;
+    
+    /** Events captured on the network thread, waiting for the game thread */
+    TUniquePtr<FSpacetimeDBEventQueue> InboundEvents;
+    
+    /** Receives each dequeued event; keeps its buffers so they cycle back into the queue */
+    FSpacetimeDBInboundEvent DrainEvent;
+    
+    /** Per-drain scratch memory, see GetFrameArena */
+    FSpacetimeDBFrameArena FrameArena;
+    
+    /** See GetDispatchingPayload */
+    const FSpacetimeDBDecodedPayload* DispatchingPayload = nullptr;
+    
+    /** Whether the FFI callbacks decode payloads before queueing them; fixed per connection */
+    bool bDecodePayloadsOffGameThread = true;
+    
+    /** How long a producer waits for space before dropping an event */
+    double BackpressureTimeoutSeconds = 0.1;
+    
+    /** Inbound queue statistics */
+    FThreadSafeCounter64 TotalEnqueuedEvents;
+    FThreadSafeCounter64 TotalBackpressureWaits;
+    FThreadSafeCounter64 TotalDroppedEvents;
+    int32 LastDrainCount = 0;
+    float LastDrainTimeMs = 0.0f;
+    
+    /** Capture of dispatched events, see StartRecording */
+    FSpacetimeDBEventRecorder Recorder;
+    
+    /** The running replay, see StartReplay */
+    TUniquePtr<FSpacetimeDBEventReplayer> Replayer;
+    FSpacetimeDBReplayStats ReplayStats;
+    double ReplayStartTime = 0.0;
+    double ReplayFrameTimeSum = 0.0;
+    
+    /** Traffic by table and by reducer name; reducers can be called from any thread */
+    mutable FCriticalSection TrafficLock;
+    TMap<FString, FSpacetimeDBTrafficStats> InboundTraffic;
+    TMap<FString, FSpacetimeDBTrafficStats> OutboundTraffic;
+    
+    /** This client's FFI connection; created by the first Connect and kept across reconnects */
+    uint64 ConnectionHandle = 0;
+    
+    /** See SetOwner */
+    USpacetimeDBSubsystem* Owner = nullptr;
+    
+    /** Where the last Connect went, for reconnecting */
+    FString LastHost;
+    FString LastDatabaseName;
+    FString LastAuthToken;
+    
+    /** Whether the application closed the connection, so a drop is not retried */
+    bool bDisconnectRequested = false;
+    
+    /** Set while TickReconnect calls Connect, which then keeps the attempt count */
+    bool bInReconnectAttempt = false;
+    
+    /** Reconnection attempts since the drop; 0 when not reconnecting */
+    int32 ReconnectAttempt = 0;
     
-    // Singleton instance pointer for callbacks
-    static FSpacetimeDBClient* Instance;
+    /** When the next attempt is due, in FPlatformTime::Seconds; 0 when none is scheduled */
+    double NextReconnectTime = 0.0;
 }; 
\ No newline at end of file
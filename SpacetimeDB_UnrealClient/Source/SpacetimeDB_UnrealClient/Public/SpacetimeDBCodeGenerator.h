@@ -14,9 +14,18 @@
  * This generator creates class definitions, component mappings, and property registrations
  * based on the current project's class hierarchy.
  * 
+ * Project class IDs are hashed from the class path, so they don't depend on which classes
+ * happen to be loaded or in what order. A manifest stored with the project pins the IDs that
+ * needed collision resolution and fingerprints each class's layout; outputs are only
+ * regenerated when an input fingerprint changes, and only rewritten when their content does.
+ * The manifest also pins the numeric ID of every replicated property name; the server module
+ * interns names under these IDs so property updates don't carry the name on the wire.
+ * 
  * Usage:
  * - Call GenerateRustClassRegistry from the editor to create a new class_registry.rs file
  * - This file will be imported by the SpacetimeDB server module to register UE classes
+ * - Call GenerateCppPropertyAccessors to create a .cpp for the game module that gives
+ *   native classes typed binary accessors for their replicated properties
  */
 UCLASS(Config=Editor)
 class SPACETIMEDB_UNREALCLIENT_API USpacetimeDBCodeGenerator : public UEditorSubsystem
@@ -48,6 +57,16 @@ public:
     UFUNCTION(BlueprintCallable, Category="SpacetimeDB")
     bool GenerateRustComponentMappings(const FString& OutputPath);
 
+    /**
+     * Generate a C++ file with typed binary accessors for the public replicated properties of the
+     * project's native classes. The file includes the classes' headers and takes member offsets with
+     * STRUCT_OFFSET, so it stays correct in every build configuration.
+     * @param OutputPath Path where the generated .cpp should be saved; it must be compiled into a game module
+     * @return True if generation was successful
+     */
+    UFUNCTION(BlueprintCallable, Category="SpacetimeDB")
+    bool GenerateCppPropertyAccessors(const FString& OutputPath);
+
 private:
     /** Collects all UClass objects that should be registered with SpacetimeDB */
     void GetAllRelevantClasses(TArray<UClass*>& OutClasses);
@@ -58,15 +77,61 @@ private:
     /** Generates Rust code for registering class properties */
     FString GeneratePropertyRegistrations(UClass* Class, int32 ClassId);
 
+    /** Generates the accessor table for a native class, or an empty string if it has no supported properties */
+    FString GeneratePropertyAccessors(UClass* Class);
+
     /** Determines component requirements for a given actor class */
     void GetDefaultComponentsForClass(UClass* Class, TMap<FString, FString>& OutComponents);
 
-    /** Generates a unique class ID for a UClass */
+    /** Gets the stable class ID for a UClass, assigning one from the hash of its path on first use */
     int32 GenerateClassId(UClass* Class);
 
+    /** Gets the stable wire ID for a property name, assigning the next unused one on first use */
+    int32 GeneratePropertyId(const FString& PropertyName);
+
+    /** The path a class is registered and hashed under */
+    static FString GetClassPath(const UClass* Class);
+
+    /** Hashes everything the generated outputs read from a class, and records it in the manifest */
+    FString ComputeClassFingerprint(UClass* Class);
+
+    /** Combines the inputs of one output file with the generator version */
+    FString ComputeOutputFingerprint(const FString& Inputs) const;
+
+    /** Whether an output file exists and was generated from the same inputs */
+    bool IsOutputUpToDate(const FString& OutputPath, const FString& Fingerprint) const;
+
+    /** Writes an output file if its content changed and records its fingerprint */
+    bool SaveOutput(const TArray<FString>& Lines, const FString& OutputPath, const FString& Fingerprint);
+
+    /** Absolute path of the class ID manifest */
+    FString GetManifestFilePath() const;
+
+    void LoadManifest();
+    void SaveManifest();
+
+    /** Class ID manifest, relative to the project directory. Keep it under source control so IDs never move. */
+    UPROPERTY(Config)
+    FString ClassIdManifestPath;
+
     /** Map of class path names to assigned IDs */
     TMap<FString, int32> ClassIdMap;
 
-    /** Next available class ID */
-    int32 NextClassId;
+    /** Assigned IDs to class path names, for collision checks */
+    TMap<int32, FString> ClassPathById;
+
+    /** Property names to wire IDs; entries are never removed so IDs are never reused */
+    TMap<FString, int32> PropertyIdMap;
+
+    /** Highest property ID assigned so far */
+    int32 MaxPropertyId;
+
+    /** Layout fingerprint per class path */
+    TMap<FString, FString> ClassFingerprints;
+
+    /** Input fingerprint per generated file (absolute path) */
+    TMap<FString, FString> OutputFingerprints;
+
+    /** Whether the manifest has changes that haven't been saved */
+    bool bManifestDirty;
 }; 
\ No newline at end of file
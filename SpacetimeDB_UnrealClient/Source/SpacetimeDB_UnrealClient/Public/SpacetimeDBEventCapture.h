@@ -0,0 +1,98 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Templates/Function.h"
+#include "SpacetimeDBEventQueue.h"
+#include <atomic>
+
+class FArchive;
+class FRunnableThread;
+
+/**
+ * Writes inbound events to a capture file as the game thread dispatches them.
+ *
+ * The file starts with a magic number and a format version, followed by one record per event:
+ * the seconds since recording started, the event type, both IDs, the name, the data and the
+ * binary payload. Events are captured in dispatch order, so a replay delivers the same
+ * sequence the game saw, grouped into frames the way it was received.
+ *
+ * Game thread only.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBEventRecorder
+{
+public:
+    ~FSpacetimeDBEventRecorder();
+
+    /**
+     * Starts a capture, closing any open one.
+     *
+     * @param FilePath Where to write the capture; an existing file is replaced
+     * @return False if the file couldn't be created
+     */
+    bool Open(const FString& FilePath);
+
+    /** Finishes the capture and closes the file */
+    void Close();
+
+    bool IsOpen() const { return Writer.IsValid(); }
+
+    /** Appends an event to the capture */
+    void Record(const FSpacetimeDBInboundEvent& Event);
+
+    /** Events written since Open */
+    int64 GetNumRecorded() const { return NumRecorded; }
+
+private:
+    TUniquePtr<FArchive> Writer;
+    double StartTime = 0.0;
+    int64 NumRecorded = 0;
+};
+
+/**
+ * Reads a capture file on a thread of its own and hands each event to a sink, standing in for
+ * the network thread. Events are delivered at their recorded times or as fast as the sink
+ * accepts them.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBEventReplayer : public FRunnable
+{
+public:
+    /** Receives each event on the replay thread; may block, which slows the replay down */
+    using FEventSink = TFunction<void(const FSpacetimeDBInboundEvent&)>;
+
+    FSpacetimeDBEventReplayer(FEventSink InSink, bool bInAsFastAsPossible);
+    virtual ~FSpacetimeDBEventReplayer() override;
+
+    /**
+     * Opens a capture and starts delivering its events.
+     *
+     * @return False if the file is missing or not a capture
+     */
+    bool Start(const FString& FilePath);
+
+    /** Stops the replay and waits for the thread to exit */
+    void Cancel();
+
+    /** Whether every event has been delivered, or the replay stopped early */
+    bool IsFinished() const { return bFinished; }
+
+    /** Events delivered so far */
+    int64 GetNumReplayed() const { return NumReplayed; }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+private:
+    FEventSink Sink;
+    bool bAsFastAsPossible = false;
+
+    TUniquePtr<FArchive> Reader;
+    FRunnableThread* Thread = nullptr;
+
+    std::atomic<bool> bStopRequested{ false };
+    std::atomic<bool> bFinished{ false };
+    std::atomic<int64> NumReplayed{ 0 };
+};
@@ -0,0 +1,153 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpacetimeDBPayloadDecoder.h"
+#include <atomic>
+
+/** Kinds of events delivered by the FFI callbacks */
+enum class ESpacetimeDBInboundEventType : uint8
+{
+    Connected,
+    Disconnected,
+    IdentityReceived,
+    EventReceived,
+    ErrorOccurred,
+    PropertyUpdated,
+    PropertyUpdatedBinary,
+    ObjectCreated,
+    ObjectCreatedByClassId,
+    ObjectDestroyed,
+    ObjectIdRemapped,
+    ComponentAdded,
+    ComponentRemoved,
+    SubscriptionApplied,
+    PropertyNameRegistered,
+    PropertyUpdatedBinaryById,
+    ClientRpcBinary
+};
+
+/**
+ * A single event record captured on the network thread.
+ * Field meaning depends on Type; unused fields are left empty.
+ */
+struct FSpacetimeDBInboundEvent
+{
+    ESpacetimeDBInboundEventType Type = ESpacetimeDBInboundEventType::Connected;
+
+    /** Object/actor ID, or the temporary ID for remaps */
+    uint64 Id = 0;
+
+    /** Component ID, the server ID for remaps, the server class ID for creation by class ID, an interned property ID or a typed RPC function ID */
+    uint64 SecondaryId = 0;
+
+    /** Property, class or table name; subscription query; disconnect reason; identity */
+    FString Name;
+
+    /** JSON payload, table event data or error message */
+    FString Data;
+
+    /** Binary property payload or typed RPC arguments */
+    TArray<uint8> Payload;
+
+    /** Payload parsed on the network thread; unset when off-thread decoding is disabled */
+    FSpacetimeDBDecodedPayload Decoded;
+};
+
+/**
+ * Bounded lock-free multi-producer / single-consumer ring buffer of inbound events.
+ *
+ * FFI callbacks (any thread) enqueue into pre-allocated cells, and the game thread drains
+ * the queue once per frame. Each cell carries a sequence number (Vyukov's bounded queue),
+ * so producers only contend on a single atomic increment and the consumer never locks.
+ *
+ * Cells keep the string and payload buffers of the events that passed through them:
+ * EnqueueWith fills a cell in place and Dequeue swaps the consumer's spent buffers back in,
+ * so once every cell has seen a message of typical size, neither side touches the heap.
+ * A buffer larger than MaxRetainedBufferBytes is freed instead of kept, so a burst of
+ * large messages doesn't pin that much memory in every cell for good.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBEventQueue
+{
+public:
+    /**
+     * @param InCapacity Number of cells; rounded up to a power of two
+     */
+    explicit FSpacetimeDBEventQueue(uint32 InCapacity);
+
+    FSpacetimeDBEventQueue(const FSpacetimeDBEventQueue&) = delete;
+    FSpacetimeDBEventQueue& operator=(const FSpacetimeDBEventQueue&) = delete;
+
+    /**
+     * Adds an event. Safe to call from any thread.
+     *
+     * @param Event The event to add; moved from only on success
+     * @return False if the queue is full
+     */
+    bool Enqueue(FSpacetimeDBInboundEvent& Event);
+
+    /**
+     * Adds an event by filling a cell in place, reusing the buffers it already holds.
+     * Safe to call from any thread.
+     *
+     * @param Fill Called with the cell's event; must set every field, resetting unused ones
+     * @return False if the queue is full; Fill is not called in that case
+     */
+    template<typename FillFunc>
+    bool EnqueueWith(FillFunc&& Fill)
+    {
+        uint64 Pos = 0;
+        FCell* Cell = ClaimCell(Pos);
+        if (!Cell)
+        {
+            return false;
+        }
+        Fill(Cell->Event);
+        PublishCell(*Cell, Pos);
+        return true;
+    }
+
+    /**
+     * Removes the oldest event. Must only be called from the consumer thread.
+     *
+     * @param OutEvent Receives the event; its previous buffers go back to the cell for reuse
+     * @return False if the queue is empty
+     */
+    bool Dequeue(FSpacetimeDBInboundEvent& OutEvent);
+
+    /** Approximate number of queued events */
+    int32 Num() const;
+
+    /** Total number of cells */
+    int32 GetCapacity() const { return static_cast<int32>(Mask + 1); }
+
+    /** Buffers handed back to a cell above this many bytes are freed rather than reused */
+    static constexpr SIZE_T MaxRetainedBufferBytes = 64 * 1024;
+
+    /** Largest depth observed by a producer since construction */
+    int32 GetHighWaterMark() const { return static_cast<int32>(HighWaterMark.load(std::memory_order_relaxed)); }
+
+private:
+    struct FCell
+    {
+        std::atomic<uint64> Sequence;
+        FSpacetimeDBInboundEvent Event;
+    };
+
+    /** Reserves the next free cell; null if the queue is full */
+    FCell* ClaimCell(uint64& OutPos);
+
+    /** Hands a filled cell to the consumer */
+    void PublishCell(FCell& Cell, uint64 Pos);
+
+    /** Frees the buffers of a spent event that are too large to keep in a cell */
+    static void TrimRetainedBuffers(FSpacetimeDBInboundEvent& Event);
+
+    TUniquePtr<FCell[]> Cells;
+    uint64 Mask = 0;
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> DequeuePos;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> HighWaterMark;
+};
@@ -33,6 +33,9 @@ inline FString FromCxxString(const rust::String& InString)
     return FString(UTF8_TO_TCHAR(InString.data()));
 }
 
+/** Interface version of the functions declared here and in ffi.h; get_ffi_abi_version must return it */
+#define SPACETIMEDB_FFI_ABI_VERSION 1
+
 // Forward declarations for FFI types
 typedef uint64_t ObjectId;
 typedef uint32_t SequenceNumber;
@@ -63,4 +66,112 @@ extern "C" {
         bool has_velocity
     );
     SequenceNumber get_last_acked_sequence(ObjectId object_id);
+
+    // Binary property wire format (see FSpacetimeDBBinaryCodec)
+    bool set_property_binary(
+        ObjectId object_id,
+        const char* property_name,
+        const uint8_t* data,
+        size_t data_len,
+        bool replicate
+    );
+    // Asks the server to send the full value of a property again, e.g. after a delta whose base
+    // checksum didn't match the local value (see FSpacetimeDBBinaryCodec::ApplyDelta).
+    bool request_property_resync(
+        ObjectId object_id,
+        const char* property_name
+    );
+    // Registers void(uint64_t object_id, const char* property_name, const uint8_t* data, size_t data_len).
+    // When set, property updates are delivered through it instead of the JSON on_property_updated callback.
+    bool set_binary_property_callback(uintptr_t on_property_updated_binary);
+    // Registers void(uint64_t object_id, uint32_t class_id, const char* data_json).
+    // When set, object creation is reported with the server class ID instead of the class path.
+    bool set_object_created_by_class_id_callback(uintptr_t on_object_created_by_class_id);
+    // Sends many property updates in one message. Layout (little endian):
+    //   uint32 object_count, then per object: uint64 object_id, uint32 property_count,
+    //   then per property: uint32 name_len, UTF-8 name, tagged value (FSpacetimeDBBinaryCodec).
+    bool set_properties_binary(
+        const uint8_t* data,
+        size_t data_len,
+        bool replicate
+    );
+
+    // Sends a tick's worth of NetDriver packets to the network_packet reducer in one call.
+    // Each packet is framed as uint32 bit count followed by its (bit count + 7) / 8 bytes.
+    bool send_network_packets(
+        const uint8_t* data,
+        size_t data_len,
+        uint32_t packet_count
+    );
+
+    // Submits queued reducer calls in order. Layout (little endian), per call:
+    //   uint32 name_len, UTF-8 reducer name, uint32 args_len, UTF-8 JSON arguments.
+    // Returns how many calls, from the start, were accepted; the rest failed.
+    uint32_t call_reducers_batched(
+        const uint8_t* data,
+        size_t data_len,
+        uint32_t call_count
+    );
+
+    // Registers void(uint32_t property_id, const char* property_name). The server interns each
+    // property name once per connection and announces it before the first update using the ID.
+    bool set_property_name_callback(uintptr_t on_property_name_registered);
+    // Registers void(uint64_t object_id, uint32_t property_id, const uint8_t* data, size_t data_len).
+    // When set, binary updates of interned properties are delivered through it instead of by name.
+    bool set_binary_property_by_id_callback(uintptr_t on_property_updated_binary_by_id);
+    // Same layout as set_properties_binary, except each property starts with a varint (LEB128)
+    // property_id instead of its name; an ID of 0 is followed by uint32 name_len and the UTF-8 name.
+    bool set_properties_binary_by_id(
+        const uint8_t* data,
+        size_t data_len,
+        bool replicate
+    );
+
+    // Registers void(const char* query). Called once per query passed to subscribe_to_tables,
+    // after the rows it matched when it was subscribed have been delivered.
+    bool set_subscription_applied_callback(uintptr_t on_subscription_applied);
+
+    // Sends a frame's predicted transforms in one call. Layout (little endian):
+    //   float cell_size, float velocity_step, then transform_count records written by
+    //   FSpacetimeDBTypeConversions::WriteQuantizedTransform. Cell, velocity and scale are only
+    //   present when flagged; otherwise the object's previously sent value still applies.
+    bool send_predicted_transforms_quantized(
+        const uint8_t* data,
+        size_t data_len,
+        uint32_t transform_count
+    );
+
+    // Typed RPCs (see SpacetimeDBTypedRpc). A function is identified by the 32-bit FNV-1a hash of
+    // its ASCII name; data holds the untagged argument payloads back to back in declaration order.
+    bool call_server_function_binary(
+        ObjectId object_id,
+        uint32_t function_id,
+        const uint8_t* data,
+        size_t data_len
+    );
+    // Tells the server this client handles a typed RPC, so calls to it are sent by ID.
+    bool register_client_function_id(
+        uint32_t function_id,
+        const char* function_name
+    );
+    // Registers void(uint64_t object_id, uint32_t function_id, const uint8_t* data, size_t data_len),
+    // through which calls of registered typed client RPCs are delivered.
+    bool set_client_rpc_binary_callback(uintptr_t on_client_rpc_binary);
+
+    // Connection handles. Every function in this header and in ffi.h acts on the calling thread's
+    // current connection, so one process can hold many connections sharing the library's worker
+    // threads. Callbacks and handlers registered while a connection is current belong to it and
+    // are called with its callback_context as an extra first argument.
+    // Returns 0 if the connection couldn't be created.
+    uint64_t create_connection(uintptr_t callback_context);
+    // Closes the connection if it is open and returns once none of its callbacks is running.
+    void destroy_connection(uint64_t connection);
+    // Makes a connection current on the calling thread. With 0, or an unknown handle, nothing is
+    // current: calls fail and is_client_connected returns false.
+    bool select_connection(uint64_t connection);
+
+    // The SPACETIMEDB_FFI_ABI_VERSION the library was built against. Bumped with every change to a
+    // signature or to the meaning of an argument, so a stale library is refused at connect time
+    // instead of misreading calls and callback contexts.
+    uint32_t get_ffi_abi_version();
 } 
\ No newline at end of file
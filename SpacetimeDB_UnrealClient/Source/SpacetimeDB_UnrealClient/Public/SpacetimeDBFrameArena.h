@@ -0,0 +1,158 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * Linear allocator for data that only lives until the end of an inbound event drain.
+ *
+ * Allocation is a pointer bump inside a block; nothing is freed individually. Reset() forgets
+ * every allocation but keeps the memory, and folds the blocks a busy frame needed into one
+ * block of the combined size, so a steady workload settles on a single block and stops
+ * touching the general heap altogether.
+ *
+ * Only trivially destructible types can live in the arena. Not thread-safe: each arena
+ * belongs to one thread.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBFrameArena
+{
+public:
+    /**
+     * @param InBlockSize Size of the first block; later blocks grow to fit large requests
+     */
+    explicit FSpacetimeDBFrameArena(int32 InBlockSize = 64 * 1024);
+    ~FSpacetimeDBFrameArena();
+
+    FSpacetimeDBFrameArena(const FSpacetimeDBFrameArena&) = delete;
+    FSpacetimeDBFrameArena& operator=(const FSpacetimeDBFrameArena&) = delete;
+
+    /**
+     * Allocates uninitialized memory that stays valid until the next Reset.
+     *
+     * @param Size Number of bytes
+     * @param Alignment Power of two alignment
+     * @return The memory; never null
+     */
+    void* Allocate(SIZE_T Size, SIZE_T Alignment = alignof(std::max_align_t));
+
+    /** Constructs a T in the arena */
+    template<typename T, typename... ArgTypes>
+    T* New(ArgTypes&&... Args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+        return new (Allocate(sizeof(T), alignof(T))) T(Forward<ArgTypes>(Args)...);
+    }
+
+    /** Allocates an array of default-constructed Ts in the arena */
+    template<typename T>
+    T* NewArray(int32 Num)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+        T* Items = static_cast<T*>(Allocate(sizeof(T) * FMath::Max(Num, 1), alignof(T)));
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            new (Items + Index) T();
+        }
+        return Items;
+    }
+
+    /** Copies a string into the arena; the view is null-terminated */
+    FStringView CopyString(FStringView Source);
+
+    /** Converts UTF-8 into a null-terminated TCHAR string in the arena */
+    FStringView ConvertUtf8(const UTF8CHAR* Source, int32 Length);
+
+    /** Forgets every allocation; pointers handed out before are invalid afterwards */
+    void Reset();
+
+    /** Bytes handed out since the last Reset */
+    int64 GetBytesUsed() const { return BytesUsed; }
+
+    /** Most bytes handed out between two Resets */
+    int64 GetHighWaterMark() const { return HighWaterMark; }
+
+    /** Bytes held by the arena's blocks */
+    int64 GetBytesReserved() const { return BytesReserved; }
+
+private:
+    struct FBlock
+    {
+        uint8* Data = nullptr;
+        SIZE_T Size = 0;
+    };
+
+    /** Moves to the next block, allocating one that fits MinSize if there is none */
+    void AdvanceBlock(SIZE_T MinSize);
+
+    void FreeBlocks();
+
+    TArray<FBlock, TInlineAllocator<4>> Blocks;
+    int32 CurrentBlock = 0;
+    SIZE_T Offset = 0;
+
+    SIZE_T BlockSize;
+    int64 BytesUsed = 0;
+    int64 HighWaterMark = 0;
+    int64 BytesReserved = 0;
+};
+
+/** Kinds of FSpacetimeDBArenaJsonValue */
+enum class ESpacetimeDBArenaJsonType : uint8
+{
+    Null,
+    Bool,
+    Number,
+    String,
+    Array,
+    Object
+};
+
+/**
+ * A JSON value whose nodes, keys and unescaped strings all live in an FSpacetimeDBFrameArena.
+ * Strings without escapes are views into the parsed source, so the source must outlive it too.
+ */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBArenaJsonValue
+{
+    ESpacetimeDBArenaJsonType Type = ESpacetimeDBArenaJsonType::Null;
+
+    bool BoolValue = false;
+
+    /** Parsed value of a number */
+    double NumberValue = 0.0;
+
+    /** String contents, or the literal of a number */
+    FStringView StringValue;
+
+    /** Array elements or object values */
+    const FSpacetimeDBArenaJsonValue* Children = nullptr;
+
+    /** Object keys, parallel to Children */
+    const FStringView* Keys = nullptr;
+
+    /** Number of Children */
+    int32 NumChildren = 0;
+
+    bool IsScalar() const { return Type != ESpacetimeDBArenaJsonType::Array && Type != ESpacetimeDBArenaJsonType::Object; }
+
+    /** Whether a number is a plain integer literal, i.e. without fraction or exponent */
+    bool IsInteger() const;
+
+    /** The value of an integer literal, exact over the full int64/uint64 range */
+    int64 GetInt64() const;
+    uint64 GetUInt64() const;
+
+    /** Finds an object field; null if this isn't an object or has no such key */
+    const FSpacetimeDBArenaJsonValue* Find(FStringView Key) const;
+
+    /**
+     * Parses a complete JSON document into the arena.
+     *
+     * @param Json The document; must stay alive as long as the result
+     * @param Arena Receives every node
+     * @return The root value, or null if the document is malformed
+     */
+    static const FSpacetimeDBArenaJsonValue* Parse(FStringView Json, FSpacetimeDBFrameArena& Arena);
+};
@@ -0,0 +1,232 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpacetimeDB_PropertyValue.h"
+#include "SpacetimeDBBinaryCodec.h"
+
+/** Writes the payload (no tag) of one property of Object */
+using FSpacetimeDBBinaryEncodeFunc = void (*)(const UObject* Object, FSpacetimeDBBinaryWriter& Writer);
+
+/** Reads a payload (tag already consumed, and equal to the accessor's tag) into one property of Object */
+using FSpacetimeDBBinaryDecodeFunc = void (*)(UObject* Object, FSpacetimeDBBinaryReader& Reader);
+
+/** Wire tag of a C++ type the generated accessors support; unsupported types do not compile */
+template <typename T>
+struct TSpacetimeDBAccessorTypeTag;
+
+#define SPACETIMEDB_ACCESSOR_TYPE_TAG(Type, Tag) \
+    template <> struct TSpacetimeDBAccessorTypeTag<Type> { static constexpr ESpacetimeDBPropertyType Value = ESpacetimeDBPropertyType::Tag; };
+
+SPACETIMEDB_ACCESSOR_TYPE_TAG(bool, Bool)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(uint8, Byte)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(int32, Int32)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(int64, Int64)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(uint32, UInt32)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(uint64, UInt64)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(float, Float)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(double, Double)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(FString, String)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(FName, Name)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(FVector, Vector)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(FRotator, Rotator)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(FQuat, Quat)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(FTransform, Transform)
+SPACETIMEDB_ACCESSOR_TYPE_TAG(FColor, Color)
+
+#undef SPACETIMEDB_ACCESSOR_TYPE_TAG
+
+/**
+ * Payload readers and writers for the accessor types, byte for byte identical to
+ * FSpacetimeDBBinaryCodec's reflection path.
+ */
+namespace SpacetimeDBAccessors
+{
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, bool Value) { Writer.WriteUInt8(Value ? 1 : 0); }
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, uint8 Value) { Writer.WriteUInt8(Value); }
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, int32 Value) { Writer.WriteInt32(Value); }
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, int64 Value) { Writer.WriteInt64(Value); }
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, uint32 Value) { Writer.WriteUInt32(Value); }
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, uint64 Value) { Writer.WriteUInt64(Value); }
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, float Value) { Writer.WriteFloat(Value); }
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, double Value) { Writer.WriteDouble(Value); }
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, const FString& Value) { Writer.WriteString(Value); }
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, const FName& Value) { Writer.WriteString(Value.ToString()); }
+
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, const FVector& Value)
+    {
+        const float Packed[3] = { static_cast<float>(Value.X), static_cast<float>(Value.Y), static_cast<float>(Value.Z) };
+        Writer.WriteBytes(Packed, sizeof(Packed));
+    }
+
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, const FRotator& Value)
+    {
+        const float Packed[3] = { static_cast<float>(Value.Pitch), static_cast<float>(Value.Yaw), static_cast<float>(Value.Roll) };
+        Writer.WriteBytes(Packed, sizeof(Packed));
+    }
+
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, const FQuat& Value)
+    {
+        const float Packed[4] = { static_cast<float>(Value.X), static_cast<float>(Value.Y), static_cast<float>(Value.Z), static_cast<float>(Value.W) };
+        Writer.WriteBytes(Packed, sizeof(Packed));
+    }
+
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, const FTransform& Value)
+    {
+        const FVector Location = Value.GetLocation();
+        const FQuat Rotation = Value.GetRotation();
+        const FVector Scale = Value.GetScale3D();
+        WriteValue(Writer, Location);
+        WriteValue(Writer, Rotation);
+        WriteValue(Writer, Scale);
+    }
+
+    FORCEINLINE void WriteValue(FSpacetimeDBBinaryWriter& Writer, const FColor& Value)
+    {
+        // FColor is stored BGRA in memory; the wire order is RGBA
+        const uint8 Packed[4] = { Value.R, Value.G, Value.B, Value.A };
+        Writer.WriteBytes(Packed, sizeof(Packed));
+    }
+
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, bool& Value) { Value = Reader.ReadUInt8() != 0; }
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, uint8& Value) { Value = Reader.ReadUInt8(); }
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, int32& Value) { Value = Reader.ReadInt32(); }
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, int64& Value) { Value = Reader.ReadInt64(); }
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, uint32& Value) { Value = Reader.ReadUInt32(); }
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, uint64& Value) { Value = Reader.ReadUInt64(); }
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, float& Value) { Value = Reader.ReadFloat(); }
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, double& Value) { Value = Reader.ReadDouble(); }
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, FString& Value) { Value = Reader.ReadString(); }
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, FName& Value) { Value = FName(*Reader.ReadString()); }
+
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, FVector& Value)
+    {
+        float Packed[3];
+        Reader.ReadBytes(Packed, sizeof(Packed));
+        Value = FVector(Packed[0], Packed[1], Packed[2]);
+    }
+
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, FRotator& Value)
+    {
+        float Packed[3];
+        Reader.ReadBytes(Packed, sizeof(Packed));
+        Value = FRotator(Packed[0], Packed[1], Packed[2]);
+    }
+
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, FQuat& Value)
+    {
+        float Packed[4];
+        Reader.ReadBytes(Packed, sizeof(Packed));
+        Value = FQuat(Packed[0], Packed[1], Packed[2], Packed[3]);
+    }
+
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, FTransform& Value)
+    {
+        FVector Location, Scale;
+        FQuat Rotation;
+        ReadValue(Reader, Location);
+        ReadValue(Reader, Rotation);
+        ReadValue(Reader, Scale);
+        Value = FTransform(Rotation, Location, Scale);
+    }
+
+    FORCEINLINE void ReadValue(FSpacetimeDBBinaryReader& Reader, FColor& Value)
+    {
+        uint8 Packed[4];
+        Reader.ReadBytes(Packed, sizeof(Packed));
+        Value = FColor(Packed[0], Packed[1], Packed[2], Packed[3]);
+    }
+
+    /** Encodes the T at a fixed byte offset inside Object */
+    template <typename T, int32 Offset>
+    void Encode(const UObject* Object, FSpacetimeDBBinaryWriter& Writer)
+    {
+        WriteValue(Writer, *reinterpret_cast<const T*>(reinterpret_cast<const uint8*>(Object) + Offset));
+    }
+
+    /** Decodes into the T at a fixed byte offset inside Object */
+    template <typename T, int32 Offset>
+    void Decode(UObject* Object, FSpacetimeDBBinaryReader& Reader)
+    {
+        ReadValue(Reader, *reinterpret_cast<T*>(reinterpret_cast<uint8*>(Object) + Offset));
+    }
+}
+
+/** One generated property accessor */
+struct FSpacetimeDBGeneratedPropertyAccessor
+{
+    /** The property name */
+    const TCHAR* PropertyName;
+
+    /** Wire tag of the property's C++ type */
+    ESpacetimeDBPropertyType TypeTag;
+
+    /** Byte offset of the member in the build the table was compiled into */
+    int32 Offset;
+
+    /** sizeof the property's C++ type */
+    int32 Size;
+
+    FSpacetimeDBBinaryEncodeFunc Encode;
+    FSpacetimeDBBinaryDecodeFunc Decode;
+};
+
+/** Declares an accessor entry for a property of C++ type Type at byte offset Offset, e.g. STRUCT_OFFSET(AMyActor, Health) */
+#define SPACETIMEDB_PROPERTY_ACCESSOR(PropertyName, Type, Offset) \
+    { PropertyName, TSpacetimeDBAccessorTypeTag<Type>::Value, Offset, static_cast<int32>(sizeof(Type)), \
+      &SpacetimeDBAccessors::Encode<Type, Offset>, &SpacetimeDBAccessors::Decode<Type, Offset> }
+
+/**
+ * Registry of the property accessors emitted by USpacetimeDBCodeGenerator::GenerateCppPropertyAccessors.
+ *
+ * Each generated class table lists the class's own public replicated properties (not inherited
+ * ones) with a typed encoder and decoder compiled against the member's STRUCT_OFFSET. When
+ * FSpacetimeDBPropertyDescriptorCache builds a class it picks up the accessor of each property
+ * whose tag, offset and size still match the reflected property, so the binary update paths
+ * skip FProperty dispatch entirely. Anything unmatched, including every Blueprint-only class,
+ * stays on the reflection codec; a stale generated file only costs the fast path.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBGeneratedAccessors
+{
+public:
+    /**
+     * Registers the accessor table of a class. Called by the generated registrars at static init.
+     *
+     * @param ClassPath Full class path, e.g. /Script/MyGame.MyActor
+     * @param Accessors The class's accessors; must outlive the registration
+     */
+    static void RegisterClass(const TCHAR* ClassPath, TConstArrayView<FSpacetimeDBGeneratedPropertyAccessor> Accessors);
+
+    /** Removes a class table, e.g. when the module that registered it unloads */
+    static void UnregisterClass(const TCHAR* ClassPath);
+
+    /**
+     * Finds the generated accessor for a property, checking it against the reflected layout.
+     *
+     * @param Property The reflected property
+     * @return The accessor, or null if none is registered or it no longer matches the property
+     */
+    static const FSpacetimeDBGeneratedPropertyAccessor* FindAccessor(const FProperty* Property);
+
+    /** Number of registered class tables */
+    static int32 GetNumClasses();
+};
+
+/** Registers a generated accessor table for the lifetime of the module that defines it */
+struct FSpacetimeDBGeneratedAccessorRegistrar
+{
+    template <int32 N>
+    FSpacetimeDBGeneratedAccessorRegistrar(const TCHAR* InClassPath, const FSpacetimeDBGeneratedPropertyAccessor (&Accessors)[N])
+        : ClassPath(InClassPath)
+    {
+        FSpacetimeDBGeneratedAccessors::RegisterClass(ClassPath, MakeArrayView(Accessors));
+    }
+
+    ~FSpacetimeDBGeneratedAccessorRegistrar()
+    {
+        FSpacetimeDBGeneratedAccessors::UnregisterClass(ClassPath);
+    }
+
+    const TCHAR* ClassPath;
+};
@@ -0,0 +1,70 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Grid-based interest set that turns a view location into spatially filtered subscriptions.
+ *
+ * The world is divided into square cells on the X/Y plane. Every cell within the interest
+ * radius of the view cell is subscribed with one filtered query per interest table; a
+ * subscribed cell is only released once it is more than radius + hysteresis cells away, so
+ * moving back and forth across a cell border doesn't churn subscriptions.
+ *
+ * The grid settings are captured when the first cell is subscribed and kept until Reset, so
+ * the queries released are always exactly the ones that were subscribed.
+ *
+ * Game thread only.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBInterestGrid
+{
+public:
+    /**
+     * Moves the view, subscribing the cells that came into range and releasing those beyond the hysteresis band.
+     * Does nothing while the view stays in the same cell.
+     *
+     * @param ViewLocation The local view location
+     * @param OutSubscribe Receives the queries to subscribe to
+     * @param OutUnsubscribe Receives the queries to unsubscribe from
+     * @return True if any cell was added or released
+     */
+    bool Update(const FVector& ViewLocation, TArray<FString>& OutSubscribe, TArray<FString>& OutUnsubscribe);
+
+    /**
+     * Forgets every cell.
+     *
+     * @param OutUnsubscribe If set, receives the queries of every cell that was subscribed
+     */
+    void Reset(TArray<FString>* OutUnsubscribe = nullptr);
+
+    /** Whether a location falls in a subscribed cell */
+    bool IsInInterest(const FVector& Location) const;
+
+    /** Whether any cell is subscribed */
+    bool IsActive() const { return Cells.Num() > 0; }
+
+    /** Number of subscribed cells */
+    int32 GetNumCells() const { return Cells.Num(); }
+
+    /** The cell containing a location */
+    static FIntPoint GetCell(const FVector& Location, float CellSize);
+
+private:
+    /** Appends the query of every interest table for a cell */
+    void AppendCellQueries(const FIntPoint& Cell, TArray<FString>& OutQueries) const;
+
+    /** Subscribed cells */
+    TSet<FIntPoint> Cells;
+
+    /** The cell the view was in at the last update */
+    FIntPoint ViewCell = FIntPoint::ZeroValue;
+
+    /** Settings captured when the first cell was subscribed */
+    float CellSize = 0.0f;
+    int32 Radius = 0;
+    int32 Hysteresis = 0;
+    TArray<FString> Tables;
+    FString CellXColumn;
+    FString CellYColumn;
+};
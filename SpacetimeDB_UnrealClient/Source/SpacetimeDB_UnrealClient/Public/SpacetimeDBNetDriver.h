@@ -17,6 +17,12 @@ class FSpacetimeDBNetDriverPrivate;
  * 
  * This NetDriver implements Unreal Engine's networking APIs to use SpacetimeDB
  * as the backend for replicating actors and RPCs.
+ *
+ * The driver opens its own connection to the database, separate from the one of
+ * USpacetimeDBSubsystem, even when both point at the same host. The two connections
+ * have their own identity, subscriptions and reducer queue: the driver's table
+ * subscriptions are reference counted only against its own client and do not keep
+ * the subsystem's rows alive, or the other way round.
  */
 UCLASS(transient, config=Engine)
 class SPACETIMEDB_UNREALCLIENT_API USpacetimeDBNetDriver : public UNetDriver
@@ -40,7 +46,7 @@ public:
     //~ End UNetDriver Interface
 
 private:
-    /** The SpacetimeDB client instance used for network communication */
+    /** The driver's own connection for network packets and its tables; not the subsystem's */
     FSpacetimeDBClient Client;
     
     /** Private implementation data */
@@ -55,6 +61,7 @@ private:
     /** Handles for client events */
     FDelegateHandle OnConnectedHandle;
     FDelegateHandle OnDisconnectedHandle;
+    FDelegateHandle OnReconnectFailedHandle;
     FDelegateHandle OnIdentityReceivedHandle;
     FDelegateHandle OnEventReceivedHandle;
     FDelegateHandle OnErrorOccurredHandle;
@@ -65,6 +72,7 @@ private:
     // Internal methods
     void HandleConnected();
     void HandleDisconnected(const FString& Reason);
+    void HandleReconnectFailed();
     void HandleIdentityReceived(const FString& Identity);
     void HandleEventReceived(const FString& TableName, const FString& EventData);
     void HandleErrorOccurred(const FSpacetimeDBErrorInfo& ErrorInfo);
@@ -0,0 +1,74 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** An object with unreliable traffic waiting to go out this frame */
+struct FSpacetimeDBOutboundCandidate
+{
+    /** The object the traffic belongs to */
+    int64 ObjectId = 0;
+
+    /** How much the object matters right now, e.g. from its distance and owner */
+    float Priority = 1.0f;
+
+    /** Bytes its pending traffic is expected to take on the wire */
+    int32 EstimatedBytes = 0;
+};
+
+/**
+ * Byte budget and per-object priority accumulators for the unreliable outbound traffic of one
+ * connection: predicted transforms, property changes and unreliable RPCs.
+ *
+ * The budget refills at a fixed rate and can save up to a short burst. Each frame the objects
+ * with pending traffic add their priority, scaled by the frame time, to an accumulator and are
+ * sent highest accumulator first until the budget is spent. A sent object starts over from
+ * zero; one that is held back keeps its accumulator, so it rises each frame it waits and is
+ * never starved for good. The last object sent may overdraw the budget, which the next frames
+ * pay back, so an object larger than a frame's budget still goes out.
+ *
+ * Reliable traffic, such as reducer calls, doesn't go through here.
+ *
+ * Game thread only.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBOutboundScheduler
+{
+public:
+    /**
+     * Refills the budget for a frame.
+     *
+     * @param DeltaSeconds Time since the last frame
+     * @param BytesPerSecond The uplink budget
+     * @param BurstSeconds How many seconds of budget unused frames may save up
+     */
+    void BeginFrame(float DeltaSeconds, float BytesPerSecond, float BurstSeconds);
+
+    /**
+     * Picks the objects whose traffic goes out this frame and accumulates the priority of the rest.
+     *
+     * @param Candidates Every object with pending traffic; reordered by accumulated priority
+     * @param DeltaSeconds Time since the last frame
+     * @param OutSelected Receives the objects to send
+     * @return Number of objects held back
+     */
+    int32 Select(TArray<FSpacetimeDBOutboundCandidate>& Candidates, float DeltaSeconds, TSet<int64>& OutSelected);
+
+    /** Charges traffic sent outside of Select, e.g. by objects that always go out */
+    void Consume(int32 Bytes) { BudgetBytes -= Bytes; }
+
+    /** Drops the accumulator of an object that went away */
+    void Forget(int64 ObjectId) { Accumulators.Remove(ObjectId); }
+
+    /** Drops every accumulator and the saved budget */
+    void Reset();
+
+    /** Budget left for this frame; negative while paying back an overdraw */
+    double GetBudgetBytes() const { return BudgetBytes; }
+
+private:
+    /** Priority accumulated by objects waiting to send */
+    TMap<int64, float> Accumulators;
+
+    double BudgetBytes = 0.0;
+};
@@ -0,0 +1,106 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpacetimeDBSpawnDataReader.h"
+
+/** Kinds of FSpacetimeDBDecodedScalar */
+enum class ESpacetimeDBDecodedScalarType : uint8
+{
+    /** Not decoded; the game thread parses the JSON itself */
+    None,
+    Null,
+    Bool,
+    Integer,
+    Double,
+    String
+};
+
+/** A scalar JSON property value, parsed before it reaches the game thread */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBDecodedScalar
+{
+    ESpacetimeDBDecodedScalarType Type = ESpacetimeDBDecodedScalarType::None;
+
+    bool BoolValue = false;
+
+    /** Integer literals, exact over the full int64 range */
+    int64 IntValue = 0;
+
+    /** Integer literals read as unsigned, for uint64 properties */
+    uint64 UIntValue = 0;
+
+    /** Numbers as doubles; also set for integer literals */
+    double DoubleValue = 0.0;
+
+    /** Unescaped string contents */
+    FString StringValue;
+
+    bool IsSet() const { return Type != ESpacetimeDBDecodedScalarType::None; }
+
+    /** Marks the value as not decoded, keeping the string's allocation */
+    void Reset()
+    {
+        Type = ESpacetimeDBDecodedScalarType::None;
+        StringValue.Reset();
+    }
+};
+
+/** Everything decoded off the game thread for one inbound event */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBDecodedPayload
+{
+    /** Value of a JSON property update, when it is a scalar */
+    FSpacetimeDBDecodedScalar Scalar;
+
+    /** Transform and owner of an object-creation snapshot */
+    FSpacetimeDBSpawnSnapshot Spawn;
+
+    /** Whether Spawn was filled in */
+    bool bHasSpawn = false;
+
+    void Reset()
+    {
+        Scalar.Reset();
+        Spawn = FSpacetimeDBSpawnSnapshot();
+        bHasSpawn = false;
+    }
+};
+
+/**
+ * Engine-independent decoding of inbound payloads.
+ *
+ * The Decode* functions touch no UObject and can run on any thread; the FFI callbacks use
+ * them so the game thread only performs the final writes into object memory with Apply*.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBPayloadDecoder
+{
+public:
+    /**
+     * Parses a JSON property value if it is a scalar. Any thread.
+     *
+     * @param Json The property value
+     * @param OutScalar Receives the value; left unset for objects, arrays and malformed JSON
+     * @return True if a scalar was decoded
+     */
+    static bool DecodeScalar(const FString& Json, FSpacetimeDBDecodedScalar& OutScalar);
+
+    /**
+     * Reads the transform and owner of an object-creation snapshot. Any thread.
+     *
+     * @param DataJson The snapshot JSON
+     * @param OutPayload Receives the snapshot in Spawn
+     * @return False if the JSON is malformed
+     */
+    static bool DecodeSpawn(const FString& DataJson, FSpacetimeDBDecodedPayload& OutPayload);
+
+    /**
+     * Writes a decoded scalar into a property's memory. Game thread.
+     * Mirrors the corresponding FSpacetimeDBPropertyHelper decoders.
+     *
+     * @param Scalar The decoded value
+     * @param Property The property to write
+     * @param PropertyAddr The property's memory
+     * @return False if this property/value pair has no direct write; nothing is written then
+     */
+    static bool ApplyScalar(const FSpacetimeDBDecodedScalar& Scalar, FProperty* Property, void* PropertyAddr);
+};
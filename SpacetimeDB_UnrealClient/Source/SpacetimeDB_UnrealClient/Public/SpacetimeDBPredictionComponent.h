@@ -6,6 +6,8 @@
 #include "SpacetimeDB_PropertyValue.h"
 #include "SpacetimeDBPredictionComponent.generated.h"
 
+class UCharacterMovementComponent;
+
 /**
  * Structure to store the pre-update state for reconciliation
  */
@@ -26,17 +28,17 @@ struct FStateSnapshot
 	UPROPERTY()
 	FVector Velocity = FVector::ZeroVector;
 
-	/** Custom state data (can be extended by game code) */
+	/** Raw values of the tracked properties, laid out as described by the component's tracked property layout */
 	UPROPERTY()
-	TMap<FName, FSpacetimeDBPropertyValue> CustomState;
+	TArray<uint8> CustomState;
 
-	/** The input state that led to this snapshot */
+	/** The input state that led to this snapshot, one value per registered input name */
 	UPROPERTY()
-	TMap<FName, float> InputState;
+	TArray<float> InputState;
 
-	/** The sequence number of this snapshot - used to match with server acks */
+	/** The sequence number of this snapshot - used to match with server acks; INDEX_NONE for an empty slot */
 	UPROPERTY()
-	int32 SequenceNumber = 0;
+	int32 SequenceNumber = INDEX_NONE;
 };
 
 /**
@@ -99,6 +101,17 @@ public:
 	UFUNCTION(BlueprintPure, Category = "SpacetimeDB|Prediction")
 	int32 GetCurrentSequence() const { return CurrentSequence; }
 
+	/**
+	 * Get the owner's movement velocity, or zero if it has no character movement
+	 */
+	FVector GetCurrentVelocity() const;
+
+	/**
+	 * Find the snapshot taken for a sequence number
+	 * @return The snapshot, or null if it was never taken or has been overwritten
+	 */
+	const FStateSnapshot* FindSnapshot(int32 SequenceNumber) const;
+
 	/**
 	 * Retrieve the current values of all tracked properties
 	 */
@@ -112,7 +125,20 @@ public:
 	void ApplyServerUpdate(const FString& PropertyName, const FSpacetimeDBPropertyValue& PropValue);
 
 private:
-	/** History of state snapshots for reconciliation */
+	/** Runs the batched error checks and hands the results back through ApplyServerReconciliation */
+	friend class USpacetimeDBPredictionManager;
+
+	/** Where a tracked property's value lives in FStateSnapshot::CustomState */
+	struct FTrackedPropertySlot
+	{
+		/** The property on the owner */
+		const FProperty* Property = nullptr;
+
+		/** Byte offset in the snapshot's CustomState */
+		int32 Offset = 0;
+	};
+
+	/** Ring buffer of state snapshots for reconciliation, indexed by SequenceNumber % MaxHistoryLength */
 	UPROPERTY()
 	TArray<FStateSnapshot> StateHistory;
 
@@ -128,9 +154,19 @@ private:
 	UPROPERTY()
 	int32 CurrentSequence = 0;
 
-	/** Current input state */
+	/** Names of the registered inputs; a snapshot's InputState follows this order */
+	UPROPERTY()
+	TArray<FName> InputNames;
+
+	/** Current input state, one value per entry of InputNames */
 	UPROPERTY()
-	TMap<FName, float> CurrentInputs;
+	TArray<float> CurrentInputs;
+
+	/** Layout of the tracked properties in a snapshot, built from TrackedProperties */
+	TArray<FTrackedPropertySlot> TrackedPropertyLayout;
+
+	/** Total size in bytes of a snapshot's CustomState */
+	int32 TrackedPropertyDataSize = 0;
 
 	/** Last acknowledged sequence from server */
 	UPROPERTY()
@@ -156,14 +192,30 @@ private:
 	UPROPERTY()
 	bool bHasAuthority = false;
 
+	/** The owner's character movement, resolved once at BeginPlay */
+	TWeakObjectPtr<UCharacterMovementComponent> MovementComponent;
+
+	/**
+	 * Act on an already error-checked server update
+	 * @param bExceedsThreshold Whether the client state is further from the server state than a threshold allows
+	 * @return True if a correction was applied
+	 */
+	bool ApplyServerReconciliation(const FTransform& ServerTransform, const FVector& ServerVelocity, int32 AckedSequence, bool bExceedsThreshold);
+
 	/** Get property values for the tracked properties */
-	void CaptureTrackedProperties(TMap<FName, FSpacetimeDBPropertyValue>& OutProperties);
+	void CaptureTrackedProperties(TMap<FName, FSpacetimeDBCompactPropertyValue>& OutProperties);
 
 	/** Apply tracked properties from a snapshot */
-	void ApplyTrackedProperties(const TMap<FName, FSpacetimeDBPropertyValue>& Properties);
+	void ApplyTrackedProperties(const TMap<FName, FSpacetimeDBCompactPropertyValue>& Properties);
+
+	/** Resolve TrackedProperties against the owner's class and size every history slot for it */
+	void BuildTrackedPropertyLayout();
+
+	/** Allocate MaxHistoryLength empty history slots */
+	void ResetHistory();
 
-	/** Clean up old history entries */
-	void CleanupHistory();
+	/** Copy the tracked property values into a snapshot's preallocated CustomState */
+	void CaptureTrackedPropertyData(FStateSnapshot& Snapshot) const;
 
 	/** Handles smooth correction of errors */
 	void ApplySmoothCorrection(const FTransform& TargetTransform, const FVector& TargetVelocity, float BlendFactor);
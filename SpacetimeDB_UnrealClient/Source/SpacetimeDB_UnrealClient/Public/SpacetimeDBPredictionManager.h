@@ -0,0 +1,117 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SpacetimeDB_Types.h"
+#include "SpacetimeDBPredictionManager.generated.h"
+
+class USpacetimeDBPredictionComponent;
+
+/**
+ * World-level owner of the reconciliation pass for every locally predicted actor.
+ *
+ * Authoritative prediction components register here at BeginPlay. Server transform updates
+ * are queued per component (the newest ack wins) and reconciled once per frame. Client
+ * transforms and velocities are gathered into contiguous arrays in one game thread pass,
+ * the error checks run as a ParallelFor over those arrays, and the corrections that pass a
+ * threshold are applied back on the game thread.
+ */
+UCLASS()
+class SPACETIMEDB_UNREALCLIENT_API USpacetimeDBPredictionManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// End UTickableWorldSubsystem
+
+	/**
+	 * Add a component to the batched reconciliation pass
+	 * @param Component An authoritative prediction component
+	 */
+	void RegisterComponent(USpacetimeDBPredictionComponent* Component);
+
+	/**
+	 * Remove a component; any update still queued for it is dropped. During a reconciliation
+	 * pass the removal is deferred until the pass has applied its corrections.
+	 * @param Component The component to remove
+	 */
+	void UnregisterComponent(USpacetimeDBPredictionComponent* Component);
+
+	/**
+	 * Queue an authoritative state for the next reconciliation pass
+	 * @return False if the component isn't registered and must be reconciled directly
+	 */
+	bool QueueServerUpdate(USpacetimeDBPredictionComponent* Component, const FTransform& ServerTransform, const FVector& ServerVelocity, int32 AckedSequence);
+
+	/**
+	 * Get the statistics of the most recent reconciliation pass
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Stats")
+	FSpacetimeDBPredictionStats GetPredictionStats() const { return Stats; }
+
+	/** Sum of per-axis differences, the position and velocity error metric */
+	static FORCEINLINE float GetManhattanDistance(const FVector& A, const FVector& B)
+	{
+		return FMath::Abs(A.X - B.X) + FMath::Abs(A.Y - B.Y) + FMath::Abs(A.Z - B.Z);
+	}
+
+	/** Angle between two rotations in degrees */
+	static FORCEINLINE float GetRotationError(const FQuat& A, const FQuat& B)
+	{
+		return FMath::RadiansToDegrees(FQuat::Error(A, B));
+	}
+
+private:
+	/** Registered components; every per-component array below is indexed the same way */
+	TArray<TWeakObjectPtr<USpacetimeDBPredictionComponent>> Components;
+
+	/** Key each component was registered under, so a swap can re-index a component that is already gone */
+	TArray<TObjectKey<USpacetimeDBPredictionComponent>> ComponentKeys;
+
+	/** Component to its index in Components */
+	TMap<TObjectKey<USpacetimeDBPredictionComponent>, int32> ComponentIndex;
+
+	/** Newest queued ack per component; INDEX_NONE when nothing is queued */
+	TArray<int32> PendingAckedSequences;
+
+	/** Newest queued server state per component */
+	TArray<FTransform> PendingServerTransforms;
+	TArray<FVector> PendingServerVelocities;
+
+	/** This frame's batch: component index of each queued update */
+	TArray<int32> BatchComponents;
+
+	/** This frame's batch: captured client state */
+	TArray<FVector> BatchClientLocations;
+	TArray<FQuat> BatchClientRotations;
+	TArray<FVector> BatchClientVelocities;
+
+	/** This frame's batch: thresholds copied from each component */
+	TArray<FVector3f> BatchThresholds;
+
+	/** This frame's batch: results of the parallel error pass */
+	TArray<float> BatchPositionErrors;
+	TArray<uint8> BatchNeedsCorrection;
+
+	/** Statistics of the most recent pass */
+	FSpacetimeDBPredictionStats Stats;
+
+	/** Set while corrections are applied; a correction can destroy an actor and unregister its component */
+	bool bReconciling = false;
+
+	/** Components unregistered during the pass, removed once it is done so the batch indices stay valid */
+	TArray<TObjectKey<USpacetimeDBPredictionComponent>> DeferredUnregisters;
+
+	/** Gather, check and correct every queued server update */
+	void ReconcilePendingUpdates();
+
+	/** Remove a component's slot from every per-component array */
+	void RemoveComponent(TObjectKey<USpacetimeDBPredictionComponent> Key);
+};
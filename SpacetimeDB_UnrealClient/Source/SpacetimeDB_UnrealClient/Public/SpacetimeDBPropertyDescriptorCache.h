@@ -0,0 +1,137 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "SpacetimeDB_PropertyValue.h"
+#include "SpacetimeDBPropertyHelper.h"
+#include "SpacetimeDBGeneratedAccessors.h"
+
+/**
+ * Precomputed dispatch information for a single property of a class.
+ * Everything the update paths need is resolved once, so applying a value is a hash
+ * lookup plus an indirect call instead of a FindPropertyByName and CastField chain.
+ */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBPropertyDescriptor
+{
+    /** The reflected property */
+    FProperty* Property = nullptr;
+
+    /** The property name, as sent on the wire */
+    FName Name;
+
+    /** Byte offset of the property inside its owning object */
+    int32 Offset = 0;
+
+    /** Index of this descriptor in its class descriptor; stable until the class is invalidated */
+    int32 Index = INDEX_NONE;
+
+    /** Wire type tag used by FSpacetimeDBBinaryCodec */
+    ESpacetimeDBPropertyType TypeTag = ESpacetimeDBPropertyType::None;
+
+    /** JSON decoder for this property type, or null if JSON is unsupported */
+    FSpacetimeDBJsonDecodeFunc JsonDecode = nullptr;
+
+    /** JSON encoder for this property type, or null if JSON is unsupported */
+    FSpacetimeDBJsonEncodeFunc JsonEncode = nullptr;
+
+    /** Generated typed binary encoder, or null to encode through reflection */
+    FSpacetimeDBBinaryEncodeFunc BinaryEncode = nullptr;
+
+    /** Generated typed binary decoder for values tagged TypeTag, or null to decode through reflection */
+    FSpacetimeDBBinaryDecodeFunc BinaryDecode = nullptr;
+
+    /** RepNotify function to call after the property is applied, if any */
+    UFunction* RepNotifyFunc = nullptr;
+
+    /** Parameter of RepNotifyFunc that receives the value, or null if the notify takes none */
+    FProperty* RepNotifyParam = nullptr;
+
+    /** Gets the property's memory inside an object of the described class */
+    FORCEINLINE void* GetValuePtr(UObject* Object) const
+    {
+        return reinterpret_cast<uint8*>(Object) + Offset;
+    }
+
+    /** Gets the property's memory inside an object of the described class */
+    FORCEINLINE const void* GetValuePtr(const UObject* Object) const
+    {
+        return reinterpret_cast<const uint8*>(Object) + Offset;
+    }
+};
+
+/**
+ * All property descriptors of a class, including inherited properties.
+ */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBClassDescriptor
+{
+    /** The class these descriptors were built from */
+    TWeakObjectPtr<UClass> Class;
+
+    /** Descriptors in reflection order */
+    TArray<FSpacetimeDBPropertyDescriptor> Properties;
+
+    /** Property name to index in Properties */
+    TMap<FName, int32> NameToIndex;
+
+    /** Number of properties that use generated accessors instead of reflection */
+    int32 NumGeneratedAccessors = 0;
+
+    /** Finds a descriptor by property name */
+    const FSpacetimeDBPropertyDescriptor* Find(FName PropertyName) const
+    {
+        const int32* Index = NameToIndex.Find(PropertyName);
+        return Index ? &Properties[*Index] : nullptr;
+    }
+};
+
+/**
+ * Process-wide cache of per-UClass property descriptors.
+ *
+ * Descriptors are built lazily the first time a class is seen and kept until the class
+ * layout may have changed: hot reload, Live Coding patches and Blueprint reinstancing all
+ * flush the whole cache, as does loading a module, which may register generated accessors. Returned pointers are therefore only valid until the next
+ * invalidation and should not be stored across frames.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBPropertyDescriptorCache
+{
+public:
+    /** Registers the reload/reinstance hooks. Called from module startup. */
+    static void Startup();
+
+    /** Unregisters the hooks and frees all descriptors. Called from module shutdown. */
+    static void Shutdown();
+
+    /**
+     * Gets the descriptors for a class, building them on first use.
+     *
+     * @param Class The class to describe
+     * @return The class descriptor, or null if Class is null
+     */
+    static const FSpacetimeDBClassDescriptor* GetClassDescriptor(UClass* Class);
+
+    /**
+     * Finds the descriptor for a named property.
+     *
+     * @param Class The class that owns the property
+     * @param PropertyName The property name
+     * @return The descriptor, or null if the class has no such property
+     */
+    static const FSpacetimeDBPropertyDescriptor* FindProperty(UClass* Class, FName PropertyName);
+
+    /** Convenience overload taking the wire name of the property */
+    static const FSpacetimeDBPropertyDescriptor* FindProperty(UClass* Class, const FString& PropertyName)
+    {
+        return FindProperty(Class, FName(*PropertyName, FNAME_Find));
+    }
+
+    /** Drops every cached descriptor; they are rebuilt on next use */
+    static void Invalidate();
+
+    /** Incremented by every Invalidate, so holders of descriptor indices can tell theirs went stale */
+    static uint32 GetGeneration();
+
+private:
+    static TUniquePtr<FSpacetimeDBClassDescriptor> BuildClassDescriptor(UClass* Class);
+};
@@ -8,6 +8,15 @@
 #include "UObject/TextProperty.h"
 #include "UObject/UnrealType.h"
 
+/** Decodes a JSON value into the memory of a property */
+typedef bool (*FSpacetimeDBJsonDecodeFunc)(FProperty* Property, void* PropertyAddr, const TSharedPtr<FJsonValue>& JsonValue);
+
+/** Encodes the memory of a property as a JSON value */
+typedef TSharedPtr<FJsonValue> (*FSpacetimeDBJsonEncodeFunc)(FProperty* Property, const void* PropertyAddr);
+
+struct FSpacetimeDBPropertyDescriptor;
+class FSpacetimeDBFrameArena;
+
 /**
  * Utility class for handling property serialization and deserialization
  * between SpacetimeDB and Unreal Engine objects.
@@ -35,6 +44,30 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Properties")
     static bool ApplyJsonToProperty(UObject* Object, const FString& PropertyName, const FString& Json);
 
+    /**
+     * Applies a JSON string to a property, parsing it into a frame arena instead of an FJsonValue tree.
+     * 
+     * @param Object The object that contains the property
+     * @param PropertyName The name of the property to modify
+     * @param Json The JSON string to apply
+     * @param Arena Scratch memory for the parsed value
+     * @return True if the property was successfully applied
+     */
+    static bool ApplyJsonToProperty(UObject* Object, const FString& PropertyName, const FString& Json, FSpacetimeDBFrameArena& Arena);
+
+    /**
+     * Decodes a JSON string into a property's memory without firing its RepNotify.
+     * Scalars are written straight from the arena; composite values fall back to the
+     * property's cached FJsonValue decoder.
+     * 
+     * @param Descriptor The property to decode into
+     * @param PropertyAddr The property's memory
+     * @param Json The JSON string
+     * @param Arena Scratch memory for the parsed value
+     * @return True if the value was decoded
+     */
+    static bool DecodeJsonToProperty(const FSpacetimeDBPropertyDescriptor& Descriptor, void* PropertyAddr, const FString& Json, FSpacetimeDBFrameArena& Arena);
+
     /**
      * Applies a JSON value to a property on an object.
      * 
@@ -46,6 +79,58 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Properties")
     static bool ApplyJsonValueToProperty(UObject* Object, const FString& PropertyName, const TSharedPtr<FJsonValue>& JsonValue);
     
+    /**
+     * Calls the RepNotify function of a property, if it has one.
+     * 
+     * @param Object The object that contains the property
+     * @param Property The property that was updated
+     * @param PropertyAddress Pointer to the property's memory, passed as the notify parameter when taken
+     */
+    static void InvokeRepNotify(UObject* Object, FProperty* Property, void* PropertyAddress);
+
+    /**
+     * Calls an already resolved RepNotify function.
+     * 
+     * @param Object The object that contains the property
+     * @param RepNotifyFunc The notify function, may be null
+     * @param PropertyAddress Pointer to the property's memory, passed as the notify parameter when taken
+     */
+    static void InvokeRepNotify(UObject* Object, UFunction* RepNotifyFunc, const void* PropertyAddress);
+
+    /**
+     * Calls the RepNotify of a described property with its cached parameter, passing the
+     * property's current value. Inside an FSpacetimeDBScopedRepNotifyBatch the call is
+     * deferred until the batch ends.
+     * 
+     * @param Object An object of the described class
+     * @param Descriptor The property that was updated
+     */
+    static void InvokeRepNotify(UObject* Object, const FSpacetimeDBPropertyDescriptor& Descriptor);
+
+    /**
+     * Finds the parameter of a RepNotify function that receives the property's value.
+     * 
+     * @param RepNotifyFunc The notify function, may be null
+     * @return The first parameter, or null if the function takes none
+     */
+    static FProperty* FindRepNotifyParam(const UFunction* RepNotifyFunc);
+
+    /**
+     * Resolves the JSON decoder for a property type. Used to build the property descriptor cache.
+     * 
+     * @param Property The property to resolve
+     * @return The decoder, or null if the property type is unsupported
+     */
+    static FSpacetimeDBJsonDecodeFunc GetJsonDecoder(const FProperty* Property);
+
+    /**
+     * Resolves the JSON encoder for a property type. Used to build the property descriptor cache.
+     * 
+     * @param Property The property to resolve
+     * @return The encoder, or null if the property type is unsupported
+     */
+    static FSpacetimeDBJsonEncodeFunc GetJsonEncoder(const FProperty* Property);
+    
     /**
      * Gets a property value as JSON from a UObject.
      * 
@@ -66,6 +151,9 @@ public:
     static bool SetPropertyValueByName(UObject* Object, const FString& PropertyName, const FString& JsonValue);
 
 private:
+    /** Calls a notify function, copying the value into a pooled parameter buffer when it takes one */
+    static void CallRepNotify(UObject* Object, UFunction* RepNotifyFunc, const FProperty* Param, const void* PropertyAddress);
+
     /**
      * Serializes a property to a JSON value.
      * 
@@ -100,4 +188,28 @@ private:
     static TSharedPtr<FJsonValue> SerializeObjectProperty(FObjectProperty* ObjProp, const void* PropAddr);
     static TSharedPtr<FJsonValue> SerializeSoftObjectProperty(FSoftObjectProperty* SoftObjProp, const void* PropAddr);
     static TSharedPtr<FJsonValue> SerializeEnumProperty(FEnumProperty* EnumProp, const void* PropAddr);
-}; 
\ No newline at end of file
+};
+
+/**
+ * Defers the RepNotifies fired through FSpacetimeDBPropertyHelper on this thread until the
+ * outermost batch ends, so notifies run together after every value of a drain is written.
+ * Each property of an object is notified once, in the order it was first notified.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBScopedRepNotifyBatch
+{
+public:
+    /**
+     * @param bInEnabled Whether to open a batch; a disabled batch does nothing
+     */
+    explicit FSpacetimeDBScopedRepNotifyBatch(bool bInEnabled = true);
+    ~FSpacetimeDBScopedRepNotifyBatch();
+
+    FSpacetimeDBScopedRepNotifyBatch(const FSpacetimeDBScopedRepNotifyBatch&) = delete;
+    FSpacetimeDBScopedRepNotifyBatch& operator=(const FSpacetimeDBScopedRepNotifyBatch&) = delete;
+
+    /** Whether a batch is open on this thread */
+    static bool IsActive();
+
+private:
+    bool bEnabled;
+};
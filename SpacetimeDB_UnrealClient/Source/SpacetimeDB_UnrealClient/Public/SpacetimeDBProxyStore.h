@@ -0,0 +1,121 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+class FSpacetimeDBSnapshotCacheFile;
+
+/**
+ * A server actor kept as a data record while it is outside the relevance range.
+ *
+ * Holds what it takes to spawn the actor later: its class, its latest transform and the
+ * property values received since the creation snapshot, packed into one byte blob.
+ */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBProxyEntity
+{
+    /** The server object ID */
+    int64 ObjectId = 0;
+
+    /** The class the actor spawns as */
+    TWeakObjectPtr<UClass> ObjectClass;
+
+    /** The class name the server announced; empty for creations by class ID and demoted actors */
+    FString ClassName;
+
+    /** Latest known transform, kept current by server transform updates */
+    FTransform Transform = FTransform::Identity;
+
+    /** Owner client ID from the creation snapshot, kept current by owner property updates */
+    int64 OwnerClientId = 0;
+
+    /** Creation snapshot; empty for demoted actors, whose values are all in Properties */
+    FString DataJson;
+
+    /** Property records newer than DataJson, see FSpacetimeDBProxyStore::StoreProperty */
+    TArray<uint8> Properties;
+
+    /**
+     * The loaded snapshot cache file the record of a cached proxy still lives in. While set,
+     * CachedDataJson and CachedProperties stand in for DataJson and Properties; see
+     * FSpacetimeDBProxyStore::DetachFromCache.
+     */
+    TSharedPtr<const FSpacetimeDBSnapshotCacheFile> CacheFile;
+
+    /** UTF-8 creation snapshot inside CacheFile */
+    TConstArrayView<uint8> CachedDataJson;
+
+    /** Property records inside CacheFile */
+    TConstArrayView<uint8> CachedProperties;
+};
+
+/**
+ * Proxy entities by object ID.
+ *
+ * Property records are packed back to back as a kind byte, the wire property name and the
+ * value: the JSON text or the FSpacetimeDBBinaryCodec encoding. A full value replaces every
+ * older record of its property and a binary delta is appended behind them, so replaying the
+ * records in order yields the current value.
+ *
+ * Game thread only.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBProxyStore
+{
+public:
+    /** Receives the wire property name, the JSON value (empty for binary records), the binary payload, and whether the record is binary */
+    using FPropertyVisitor = TFunctionRef<void(FString&&, FString&&, TArray<uint8>&&, bool)>;
+
+    /** Adds a proxy, replacing any existing one for the same object */
+    FSpacetimeDBProxyEntity& Add(int64 ObjectId);
+
+    /**
+     * Removes a proxy.
+     *
+     * @param ObjectId The object ID
+     * @param OutEntity If set, receives the removed proxy
+     * @return False if the object isn't a proxy
+     */
+    bool Remove(int64 ObjectId, FSpacetimeDBProxyEntity* OutEntity = nullptr);
+
+    FSpacetimeDBProxyEntity* Find(int64 ObjectId);
+    const FSpacetimeDBProxyEntity* Find(int64 ObjectId) const;
+    bool Contains(int64 ObjectId) const { return ObjectIndex.Contains(ObjectId); }
+
+    /** Number of proxies */
+    int32 Num() const { return Entities.Num(); }
+
+    /** Every proxy, in no particular order */
+    TConstArrayView<FSpacetimeDBProxyEntity> GetEntities() const { return Entities; }
+
+    /** Forgets every proxy */
+    void Reset();
+
+    /** Records a JSON property value, replacing the older records of the property */
+    static void StoreProperty(FSpacetimeDBProxyEntity& Proxy, const FString& PropertyName, const FString& ValueJson);
+
+    /** Records a binary property value; a delta is kept behind the records it applies to */
+    static void StoreProperty(FSpacetimeDBProxyEntity& Proxy, const FString& PropertyName, const TArray<uint8>& Payload);
+
+    /** Records the current value of every replicated property of an object */
+    static void CaptureProperties(FSpacetimeDBProxyEntity& Proxy, const UObject* Object);
+
+    /** Calls Visitor for every property record, oldest first */
+    static void VisitProperties(const FSpacetimeDBProxyEntity& Proxy, FPropertyVisitor Visitor);
+
+    /** Copies the record of a proxy loaded from the snapshot cache out of the file, before it is edited or spawned */
+    static void DetachFromCache(FSpacetimeDBProxyEntity& Proxy);
+
+    /** Detaches every proxy from the snapshot cache, so the file can be replaced */
+    void DetachAllFromCache();
+
+private:
+    /** Drops every record of a property */
+    static void RemoveRecords(FSpacetimeDBProxyEntity& Proxy, const FString& PropertyName);
+
+    /** Proxies; removal swaps the last one into the hole */
+    TArray<FSpacetimeDBProxyEntity> Entities;
+
+    /** Maps object IDs to their index in Entities */
+    TMap<int64, int32> ObjectIndex;
+};
@@ -4,8 +4,29 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "UObject/SoftObjectPtr.h"
+#include "GameFramework/Actor.h"
 #include "SpacetimeDBSettings.generated.h"
 
+/** A table whose rows are kept locally for synchronous queries */
+USTRUCT()
+struct FSpacetimeDBCachedTable
+{
+    GENERATED_BODY()
+
+    /** Name of the table */
+    UPROPERTY(EditAnywhere, Category = "Tables")
+    FString TableName;
+
+    /** Column that identifies a row */
+    UPROPERTY(EditAnywhere, Category = "Tables")
+    FString PrimaryKey = TEXT("id");
+
+    /** Columns to index for lookups by value */
+    UPROPERTY(EditAnywhere, Category = "Tables")
+    TArray<FString> Indexes;
+};
+
 /**
  * Settings class for the SpacetimeDB Unreal Client plugin.
  * Provides configuration options for the plugin behavior.
@@ -30,14 +51,32 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Debugging")
     bool bEnableDebugLogging;
     
+    /**
+     * Send and receive property updates as JSON instead of the compact binary encoding.
+     * Slower and larger on the wire, but readable when inspecting traffic.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Debugging")
+    bool bUseJsonPropertyEncoding;
+    
     /** Whether to auto-connect on game start */
     UPROPERTY(config, EditAnywhere, Category = "Connection")
     bool bAutoConnect;
     
-    /** Time in seconds to wait before attempting reconnection */
+    /**
+     * Reconnect automatically when the connection drops without Disconnect being called.
+     * Spawned objects are kept and reconciled against the state the server sends again.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Connection")
+    bool bAutoReconnect;
+    
+    /** Time in seconds to wait before the first reconnection attempt; doubles with each further attempt */
     UPROPERTY(config, EditAnywhere, Category = "Connection", meta = (ClampMin = "0.5", ClampMax = "60.0"))
     float ReconnectionDelay;
     
+    /** Longest wait between two reconnection attempts, in seconds */
+    UPROPERTY(config, EditAnywhere, Category = "Connection", meta = (ClampMin = "0.5", ClampMax = "300.0"))
+    float MaxReconnectionDelay;
+    
     /** Maximum number of reconnection attempts before giving up */
     UPROPERTY(config, EditAnywhere, Category = "Connection", meta = (ClampMin = "0", ClampMax = "10"))
     int32 MaxReconnectionAttempts;
@@ -46,6 +85,181 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Networking")
     bool bEnablePrediction;
     
+    /** Number of FFI events that can wait for the game thread before producers are held back */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "1024", ClampMax = "1048576"))
+    int32 InboundEventQueueCapacity;
+    
+    /** Time per frame, in milliseconds, spent dispatching queued FFI events */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "0.1", ClampMax = "33.0"))
+    float InboundEventTimeBudgetMs;
+    
+    /** How long, in milliseconds, the network thread waits for queue space before dropping an event */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
+    float InboundEventBackpressureTimeoutMs;
+    
+    /** Whether property updates received in one frame are merged, so each property is applied and notified once */
+    UPROPERTY(config, EditAnywhere, Category = "Networking")
+    bool bCoalescePropertyUpdates;
+    
+    /** Whether RepNotifies of the properties applied in a frame are held back and fired together once every value is written */
+    UPROPERTY(config, EditAnywhere, Category = "Networking")
+    bool bBatchRepNotifies;
+    
+    /** Whether scalar property values and spawn transforms are parsed on the network thread, leaving only the writes to the game thread */
+    UPROPERTY(config, EditAnywhere, Category = "Networking")
+    bool bDecodePayloadsOffGameThread;
+    
+    /** Whether outgoing property updates are collected during the frame and sent as one batched message */
+    UPROPERTY(config, EditAnywhere, Category = "Networking")
+    bool bBatchPropertyUpdates;
+    
+    /** Whether binary property updates refer to properties by the numeric IDs the server interns, instead of by name */
+    UPROPERTY(config, EditAnywhere, Category = "Networking")
+    bool bUseInternedPropertyIds;
+    
+    /** Whether changed structs, arrays and maps of auto-replicated objects are sent as deltas when that is smaller; needs a server module that applies deltas */
+    UPROPERTY(config, EditAnywhere, Category = "Networking")
+    bool bSendPropertyDeltas;
+    
+    /** Whether reducer calls made on the game thread are queued and submitted in one batched call at the end of the frame */
+    UPROPERTY(config, EditAnywhere, Category = "Networking")
+    bool bBatchReducerCalls;
+    
+    /** Size in bytes a reducer batch may reach before it is submitted early; larger single calls are sent on their own */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "1024", ClampMax = "16777216", EditCondition = "bBatchReducerCalls"))
+    int32 MaxReducerBatchBytes;
+    
+    /** Maximum property flushes per second for objects of a class and its subclasses; unlisted classes flush every frame */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (EditCondition = "bBatchPropertyUpdates"))
+    TMap<TSoftClassPtr<UObject>, float> PropertyFlushRateByClass;
+    
+    /**
+     * Uplink budget for unreliable traffic (predicted transforms, property changes and unreliable RPCs), in bytes per
+     * second. When it is spent, the objects that matter least wait for a later frame, their values merging meanwhile.
+     * Reducer calls are never held back. 0 sends everything as soon as it is produced.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "0"))
+    int32 OutboundBytesPerSecond;
+    
+    /** Seconds of budget quiet frames may save up for a burst */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "0.0", ClampMax = "2.0", EditCondition = "OutboundBytesPerSecond > 0"))
+    float OutboundBurstSeconds;
+    
+    /** Distance from the local view at which an object's send priority has halved */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "1.0", EditCondition = "OutboundBytesPerSecond > 0"))
+    float OutboundPriorityDistance;
+    
+    /** Send priority of the local pawn relative to other objects */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "0.01", EditCondition = "OutboundBytesPerSecond > 0"))
+    float OutboundViewPawnPriority;
+    
+    /** Send priority of objects of a class and its subclasses; unlisted classes have 1 */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (EditCondition = "OutboundBytesPerSecond > 0"))
+    TMap<TSoftClassPtr<UObject>, float> OutboundPriorityByClass;
+    
+    /** Seconds an unreliable RPC may wait for budget before it is dropped */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "0.0", ClampMax = "10.0"))
+    float UnreliableRpcMaxAge;
+    
+    /** Whether objects this client has authority over send their changed replicated properties without SetPropertyValue calls */
+    UPROPERTY(config, EditAnywhere, Category = "Networking")
+    bool bAutoReplicateOwnedObjects;
+    
+    /** Minimum time, in seconds, between two change checks of the same auto-replicated object */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "0.0", ClampMax = "10.0"))
+    float AutoReplicationInterval;
+    
+    /** Most auto-replicated objects checked for changes per frame; the rest wait for the following frames */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "1", ClampMax = "65536"))
+    int32 AutoReplicationObjectsPerFrame;
+    
+    /** Whether server-created objects are queued and spawned over several frames instead of all at once */
+    UPROPERTY(config, EditAnywhere, Category = "Networking")
+    bool bTimeSliceObjectMaterialization;
+    
+    /** Time per frame, in milliseconds, spent spawning queued server-created objects; at least one spawns per frame */
+    UPROPERTY(config, EditAnywhere, Category = "Networking", meta = (ClampMin = "0.1", ClampMax = "33.0", EditCondition = "bTimeSliceObjectMaterialization"))
+    float ObjectMaterializationTimeBudgetMs;
+    
+    /** Whether predicted transforms are quantized and sent as one batch per frame instead of one full-precision call each */
+    UPROPERTY(config, EditAnywhere, Category = "Prediction")
+    bool bQuantizePredictedTransforms;
+    
+    /** Edge length of the world cells predicted locations are sent relative to; the location resolution is this / 65536 */
+    UPROPERTY(config, EditAnywhere, Category = "Prediction", meta = (ClampMin = "256.0", ClampMax = "1048576.0", EditCondition = "bQuantizePredictedTransforms"))
+    float PredictionWorldCellSize;
+    
+    /** Resolution of quantized predicted velocities, in units per second; the largest sendable speed is 32767 steps */
+    UPROPERTY(config, EditAnywhere, Category = "Prediction", meta = (ClampMin = "0.01", ClampMax = "100.0", EditCondition = "bQuantizePredictedTransforms"))
+    float PredictionVelocityStep;
+    
+    /**
+     * Every this many sequence numbers an object's quantized record carries its cell, velocity and scale
+     * even if they haven't changed, so a receiver that missed a record catches up; 0 only sends them on change
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Prediction", meta = (ClampMin = "0", ClampMax = "3600", EditCondition = "bQuantizePredictedTransforms"))
+    int32 PredictionFullRecordInterval;
+    
+    /** Number of server-destroyed actors kept for reuse per class (and its subclasses); unlisted classes are not pooled */
+    UPROPERTY(config, EditAnywhere, Category = "Pooling", meta = (ClampMin = "0", ClampMax = "4096"))
+    TMap<TSoftClassPtr<AActor>, int32> ActorPoolSizes;
+    
+    /** Whether spatial tables are subscribed per grid cell around the local pawn instead of as whole tables */
+    UPROPERTY(config, EditAnywhere, Category = "Interest")
+    bool bEnableInterestManagement;
+    
+    /** Edge length of an interest cell in world units */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (ClampMin = "100.0", EditCondition = "bEnableInterestManagement"))
+    float InterestCellSize;
+    
+    /** Cells subscribed in each direction around the view cell (1 = 3x3, 2 = 5x5) */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (ClampMin = "0", ClampMax = "16", EditCondition = "bEnableInterestManagement"))
+    int32 InterestRadiusCells;
+    
+    /** Extra cells a subscribed cell may fall behind before it is released */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (ClampMin = "0", ClampMax = "8", EditCondition = "bEnableInterestManagement"))
+    int32 InterestHysteresisCells;
+    
+    /** Tables subscribed per cell; these are left out of whole-table subscriptions while interest management is on */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (EditCondition = "bEnableInterestManagement"))
+    TArray<FString> InterestTables;
+    
+    /** Column holding a row's cell X index in every interest table */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (EditCondition = "bEnableInterestManagement"))
+    FString InterestCellXColumn;
+    
+    /** Column holding a row's cell Y index in every interest table */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (EditCondition = "bEnableInterestManagement"))
+    FString InterestCellYColumn;
+    
+    /** Whether server actors further than ProxyRelevanceDistance from the local pawn are kept as data records instead of being spawned */
+    UPROPERTY(config, EditAnywhere, Category = "Interest")
+    bool bEnableProxyEntities;
+    
+    /** Distance from the local pawn within which proxies are promoted to actors */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (ClampMin = "0.0", EditCondition = "bEnableProxyEntities"))
+    float ProxyRelevanceDistance;
+    
+    /** Extra distance an actor may move beyond ProxyRelevanceDistance before it is demoted back to a proxy */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (ClampMin = "0.0", EditCondition = "bEnableProxyEntities"))
+    float ProxyRelevanceHysteresis;
+    
+    /** Seconds between two relevance checks of the proxies and the actors that could become one */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (ClampMin = "0.0", EditCondition = "bEnableProxyEntities"))
+    float ProxyRelevanceInterval;
+    
+    /**
+     * Whether the server objects of a database are saved to disk on disconnect and loaded as proxies on the next
+     * connect, so a large world shows up before the server's rows have arrived. The server's rows then confirm,
+     * update or remove what was loaded.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Interest")
+    bool bEnableSnapshotCache;
+    
+    /** Directory the snapshot cache files are kept in, one per host and database; empty uses Saved/SpacetimeDB/SnapshotCache */
+    UPROPERTY(config, EditAnywhere, Category = "Interest", meta = (EditCondition = "bEnableSnapshotCache"))
+    FString SnapshotCacheDirectory;
+    
     /** Whether to automatically subscribe to default tables on connect */
     UPROPERTY(config, EditAnywhere, Category = "Tables")
     bool bAutoSubscribeDefaultTables;
@@ -54,6 +268,26 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Tables")
     TArray<FString> DefaultTableSubscriptions;
     
+    /** Tables whose rows are cached from table events so they can be queried without a server round-trip */
+    UPROPERTY(config, EditAnywhere, Category = "Tables")
+    TArray<FSpacetimeDBCachedTable> CachedTables;
+    
+    /** Length, in seconds, of the window each error code is rate limited over */
+    UPROPERTY(config, EditAnywhere, Category = "Diagnostics", meta = (ClampMin = "0.1", ClampMax = "60.0"))
+    float ErrorReportWindowSeconds;
+    
+    /** Occurrences of one error code logged and broadcast per window; the rest are only counted and summarized (0 = no limit) */
+    UPROPERTY(config, EditAnywhere, Category = "Diagnostics", meta = (ClampMin = "0", ClampMax = "1000"))
+    int32 MaxErrorReportsPerWindow;
+    
+    /** Longest error context kept, in characters; longer ones, such as large reducer arguments, are cut */
+    UPROPERTY(config, EditAnywhere, Category = "Diagnostics", meta = (ClampMin = "16", ClampMax = "65536"))
+    int32 MaxErrorContextLength;
+    
+    /** Whether bytes per table and reducer are always counted; otherwise only while stats are collected or the SpacetimeDB trace channel is on */
+    UPROPERTY(config, EditAnywhere, Category = "Diagnostics")
+    bool bCollectTrafficStats;
+    
     /** Get the settings object. */
     static const USpacetimeDBSettings* Get();
     
@@ -0,0 +1,177 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Templates/Function.h"
+
+struct FSpacetimeDBPropertyDescriptor;
+
+/**
+ * Where the replicated properties of a class are kept in the shadow copy of its objects.
+ *
+ * Plain-old-data properties are copied into a packed byte buffer, and properties that sit back
+ * to back in the object share one span, so an unchanged object costs a memcmp per span. The
+ * remaining properties (strings, containers, bitfield bools, structs with constructors) are
+ * shadowed by their binary encoding and compared the same way.
+ */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBShadowLayout
+{
+    struct FPodProperty
+    {
+        /** Index of the property in its class descriptor */
+        int32 DescriptorIndex = INDEX_NONE;
+
+        /** Byte offset inside the object */
+        int32 ObjectOffset = 0;
+
+        /** Byte offset inside the packed shadow buffer */
+        int32 ShadowOffset = 0;
+
+        /** Size of the value, static array elements included */
+        int32 Size = 0;
+    };
+
+    /** A run of plain-old-data properties that are contiguous in the object */
+    struct FSpan
+    {
+        int32 ObjectOffset = 0;
+        int32 ShadowOffset = 0;
+        int32 Size = 0;
+
+        /** First property of the span in PodProperties */
+        int32 FirstProperty = 0;
+        int32 NumProperties = 0;
+    };
+
+    /** Plain-old-data properties in object memory order */
+    TArray<FPodProperty> PodProperties;
+
+    /** PodProperties merged into contiguous runs */
+    TArray<FSpan> Spans;
+
+    /** Descriptor indices of properties shadowed by their encoding */
+    TArray<int32> EncodedProperties;
+
+    /** Size of the packed shadow buffer */
+    int32 ShadowSize = 0;
+
+    bool IsEmpty() const { return PodProperties.Num() == 0 && EncodedProperties.Num() == 0; }
+
+    /** Builds the layout of a class from its replicated properties (CPF_Net without CPF_RepSkip) */
+    static TSharedRef<const FSpacetimeDBShadowLayout> Build(UClass* Class);
+};
+
+/**
+ * Change detection for objects whose replicated properties are sent automatically.
+ *
+ * Each tracked object keeps a shadow copy of the values last sent to or received from the
+ * server. CollectChanges compares a bounded number of objects against their shadows, round
+ * robin, and reports only the properties that differ, so a large number of tracked objects
+ * is spread over several frames instead of all being diffed every tick.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBShadowState
+{
+public:
+    /**
+     * Receives the object ID, the object and the descriptor of a property that changed. Properties
+     * shadowed by their encoding also pass the previous and the current encoding; both are null
+     * for byte-compared properties.
+     */
+    using FOnPropertyChanged = TFunctionRef<void(int64, UObject*, const FSpacetimeDBPropertyDescriptor&, const TArray<uint8>*, const TArray<uint8>*)>;
+
+    /**
+     * Starts tracking an object, taking its current values as the shadow.
+     *
+     * @param ObjectId The SpacetimeDB object ID
+     * @param Object The object
+     * @return False if the object's class has no replicated properties
+     */
+    bool Track(int64 ObjectId, UObject* Object);
+
+    /** Stops tracking an object; does nothing if it isn't tracked */
+    void Untrack(int64 ObjectId);
+
+    bool IsTracked(int64 ObjectId) const { return ObjectIndex.Contains(ObjectId); }
+
+    /** Number of tracked objects */
+    int32 Num() const { return Objects.Num(); }
+
+    /** Stops tracking every object */
+    void Reset();
+
+    /**
+     * Takes a property's current value as its shadow, so a value that came from the server is
+     * not reported back as a local change.
+     *
+     * @param ObjectId The SpacetimeDB object ID; nothing happens if it isn't tracked
+     * @param PropertyName The property that was written
+     */
+    void RecaptureProperty(int64 ObjectId, FName PropertyName);
+
+    /** Convenience overload taking the wire name of the property */
+    void RecaptureProperty(int64 ObjectId, const FString& PropertyName)
+    {
+        if (IsTracked(ObjectId))
+        {
+            RecaptureProperty(ObjectId, FName(*PropertyName, FNAME_Find));
+        }
+    }
+
+    /**
+     * Compares the objects that are due against their shadows and updates the shadows.
+     * Objects that were garbage collected stop being tracked.
+     *
+     * @param Now Current time in seconds
+     * @param Interval Minimum seconds between two comparisons of the same object
+     * @param MaxObjects Most objects to compare in this call
+     * @param OnChanged Called for every property that differs from its shadow
+     * @return Number of objects compared
+     */
+    int32 CollectChanges(double Now, double Interval, int32 MaxObjects, FOnPropertyChanged OnChanged);
+
+private:
+    struct FTrackedObject
+    {
+        int64 ObjectId = 0;
+        TWeakObjectPtr<UObject> Object;
+        TSharedPtr<const FSpacetimeDBShadowLayout> Layout;
+
+        /** Packed plain-old-data values, see FSpacetimeDBShadowLayout */
+        TArray<uint8> PodShadow;
+
+        /** Encoded values, parallel to Layout->EncodedProperties */
+        TArray<TArray<uint8>> EncodedShadow;
+
+        /** When the object was last compared */
+        double LastCompareTime = 0.0;
+    };
+
+    /** Gets the layout of a class, building it on first use */
+    TSharedRef<const FSpacetimeDBShadowLayout> FindOrBuildLayout(UClass* Class);
+
+    /** Copies an object's current values into its shadow */
+    void CaptureShadow(FTrackedObject& Tracked, const UObject* Object);
+
+    /** Drops the layouts and recaptures every shadow once the property descriptors were rebuilt */
+    void RefreshAfterInvalidation();
+
+    /** Tracked objects; the order is the round robin order */
+    TArray<FTrackedObject> Objects;
+
+    /** Maps object IDs to their index in Objects */
+    TMap<int64, int32> ObjectIndex;
+
+    /** Layout per class */
+    TMap<TObjectKey<UClass>, TSharedRef<const FSpacetimeDBShadowLayout>> Layouts;
+
+    /** Descriptor cache generation the layouts were built against */
+    uint32 DescriptorGeneration = 0;
+
+    /** Index in Objects where the next CollectChanges starts */
+    int32 Cursor = 0;
+
+    /** Reused encoding buffer */
+    TArray<uint8> EncodeScratch;
+};
@@ -0,0 +1,75 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpacetimeDBProxyStore.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * A loaded snapshot cache file. The proxies loaded from it point into its bytes instead of
+ * copying their records, and keep it mapped until the last of them is detached.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBSnapshotCacheFile
+{
+public:
+    FSpacetimeDBSnapshotCacheFile();
+    ~FSpacetimeDBSnapshotCacheFile();
+
+    /** The file's contents */
+    TConstArrayView<uint8> GetBytes() const { return TConstArrayView<uint8>(Data, Size); }
+
+private:
+    friend class FSpacetimeDBSnapshotCache;
+
+    // The region has to go before the file handle, hence the declaration order
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    /** The contents on platforms without mapped files */
+    TArray<uint8> FileBytes;
+
+    const uint8* Data = nullptr;
+    int32 Size = 0;
+};
+
+/**
+ * On-disk copy of the server objects of one database, so the next join can show the world
+ * before the server's rows have arrived.
+ *
+ * The file starts with a magic number and a format version, followed by one record per object
+ * in the proxy layout: the object ID, its class, transform and owner, the creation snapshot and
+ * the property records. Loading maps the file into memory where the platform supports it.
+ * What is loaded is only a first guess; the subsystem reconciles it against what the server
+ * sends once connected.
+ *
+ * Game thread only.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBSnapshotCache
+{
+public:
+    /** Path of the cache file of a database, under SnapshotCacheDirectory */
+    static FString GetCachePath(const FString& Host, const FString& DatabaseName);
+
+    /**
+     * Writes objects to a cache file, replacing any previous one.
+     *
+     * @param FilePath Where to write
+     * @param Entities The objects, in the proxy layout
+     * @return False if the file couldn't be written; the previous file is kept then
+     */
+    static bool Save(const FString& FilePath, TConstArrayView<FSpacetimeDBProxyEntity> Entities);
+
+    /**
+     * Reads a cache file written by Save. Objects whose class can't be loaded are left out.
+     * The objects' creation snapshots and property records stay in the file, which is kept
+     * loaded through their CacheFile until they are detached.
+     *
+     * @param FilePath The cache file
+     * @param OutEntities Receives the objects
+     * @return False if the file is missing, of another format version or corrupt
+     */
+    static bool Load(const FString& FilePath, TArray<FSpacetimeDBProxyEntity>& OutEntities);
+};
@@ -0,0 +1,73 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What FSpacetimeDBSpawnDataReader extracted from a snapshot besides the properties themselves */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBSpawnSnapshot
+{
+    /** Whether the snapshot contained a "transform" object */
+    bool bHasTransform = false;
+
+    /** Spawn transform; identity when the snapshot has none */
+    FTransform Transform = FTransform::Identity;
+
+    /** Value of the "owner_client_id" property; 0 when the snapshot has none */
+    int64 OwnerClientId = 0;
+
+    /** Number of properties written into the target */
+    int32 NumPropertiesApplied = 0;
+
+    /** Number of properties that were unknown or could not be decoded */
+    int32 NumPropertiesFailed = 0;
+};
+
+/**
+ * Streaming decoder for object-creation snapshots of the form
+ * {"transform": {"location": {...}, "rotation": {...}, "scale": {...}}, "properties": {...}}.
+ *
+ * The JSON is walked token by token instead of being parsed into an FJsonObject DOM. Scalar
+ * properties are written straight into the target's memory through the class descriptor cache;
+ * only structs, containers and other composite values materialize a small FJsonValue subtree
+ * for the cached decoder, so every type FSpacetimeDBPropertyHelper supports is supported here.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBSpawnDataReader
+{
+public:
+    /**
+     * Streams a snapshot into an object.
+     *
+     * The transform is only returned, never applied, so the caller can hand it to
+     * FinishSpawning on a deferred-spawn actor after the properties are in place.
+     *
+     * @param DataJson The snapshot JSON
+     * @param Target The object to write properties into
+     * @param bFireRepNotify Whether to call RepNotify functions once all properties are applied
+     * @param OutSnapshot Receives the transform and property counts
+     * @return False if the JSON is malformed; properties read before the error stay applied
+     */
+    static bool Read(const FString& DataJson, UObject* Target, bool bFireRepNotify, FSpacetimeDBSpawnSnapshot& OutSnapshot);
+
+    /**
+     * Streams a snapshot into an object that already exists, e.g. one kept across a reconnect.
+     * Only properties whose value differs are written, and only their RepNotifies are called.
+     *
+     * @param DataJson The snapshot JSON
+     * @param Target The object to update
+     * @param OutSnapshot Receives the transform; NumPropertiesApplied counts the changed properties
+     * @return False if the JSON is malformed; properties read before the error stay applied
+     */
+    static bool Reconcile(const FString& DataJson, UObject* Target, FSpacetimeDBSpawnSnapshot& OutSnapshot);
+
+    /**
+     * Extracts the transform and owner of a snapshot without an object to write into.
+     * Every other property is skipped token by token, so this is cheap enough to run for
+     * each creation event before deciding when to spawn it.
+     *
+     * @param DataJson The snapshot JSON
+     * @param OutSnapshot Receives the transform and owner; the property counts stay 0
+     * @return False if the JSON is malformed
+     */
+    static bool Peek(const FString& DataJson, FSpacetimeDBSpawnSnapshot& OutSnapshot);
+};
@@ -0,0 +1,78 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Stats and trace events of the SpacetimeDB client.
+ *
+ * "stat SpacetimeDB" shows where a frame went: FFI calls, the inbound drain, property applies,
+ * spawns, RepNotifies and prediction corrections, with per-frame counters next to them. In
+ * Unreal Insights the same work shows up as CPU events on the SpacetimeDB channel
+ * (-trace=cpu,SpacetimeDB); the counters travel with the stats channel.
+ */
+DECLARE_STATS_GROUP(TEXT("SpacetimeDB"), STATGROUP_SpacetimeDB, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FFI Calls"), STAT_SpacetimeDB_FFICall, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Process Inbound Events"), STAT_SpacetimeDB_ProcessInbound, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Properties"), STAT_SpacetimeDB_ApplyProperties, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Objects"), STAT_SpacetimeDB_Spawn, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RepNotify"), STAT_SpacetimeDB_RepNotify, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Prediction Corrections"), STAT_SpacetimeDB_PredictionCorrection, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Transform Conversions"), STAT_SpacetimeDB_TransformConversion, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("FFI Call Count"), STAT_SpacetimeDB_FFICallCount, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Inbound Queue Depth"), STAT_SpacetimeDB_InboundQueueDepth, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Inbound Events"), STAT_SpacetimeDB_InboundEvents, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes In"), STAT_SpacetimeDB_BytesIn, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Out"), STAT_SpacetimeDB_BytesOut, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Properties Applied"), STAT_SpacetimeDB_PropertiesApplied, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Objects Spawned"), STAT_SpacetimeDB_ObjectsSpawned, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RepNotifies"), STAT_SpacetimeDB_RepNotifies, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Prediction Corrections"), STAT_SpacetimeDB_PredictionCorrections, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Outbound Objects Held Back"), STAT_SpacetimeDB_OutboundHeldBack, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Unreliable RPCs Dropped"), STAT_SpacetimeDB_UnreliableRpcsDropped, STATGROUP_SpacetimeDB, SPACETIMEDB_UNREALCLIENT_API);
+
+UE_TRACE_CHANNEL_EXTERN(SpacetimeDBChannel, SPACETIMEDB_UNREALCLIENT_API);
+
+/** Counts an FFI call and times the rest of the enclosing scope; Name is an identifier naming the trace event */
+#define SPACETIMEDB_SCOPE_FFI_CALL(Name) \
+    SCOPE_CYCLE_COUNTER(STAT_SpacetimeDB_FFICall); \
+    INC_DWORD_STAT(STAT_SpacetimeDB_FFICallCount); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, SpacetimeDBChannel)
+
+/**
+ * Times work on one object under a stat and a trace event named after its class, nested in
+ * whatever the caller is already timing. Only pays for the class name while the SpacetimeDB
+ * trace channel is on.
+ *
+ * Game thread only.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBClassScope
+{
+public:
+    /**
+     * @param Prefix Names the kind of work, e.g. TEXT("Apply")
+     * @param Class Class of the object worked on; may be null
+     */
+    FSpacetimeDBClassScope(const TCHAR* Prefix, const UClass* Class);
+    ~FSpacetimeDBClassScope();
+
+    FSpacetimeDBClassScope(const FSpacetimeDBClassScope&) = delete;
+    FSpacetimeDBClassScope& operator=(const FSpacetimeDBClassScope&) = delete;
+
+private:
+#if STATS
+    /** Stat of the prefix and class, created the first time they are seen */
+    static TStatId GetStatId(const TCHAR* Prefix, const UClass* Class);
+
+    FScopeCycleCounter CycleCounter;
+#endif
+
+    /** Whether a trace event was begun and needs ending */
+    bool bTraceEvent = false;
+};
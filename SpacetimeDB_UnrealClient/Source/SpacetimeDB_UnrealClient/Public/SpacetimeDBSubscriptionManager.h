@@ -0,0 +1,102 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSpacetimeDBClient;
+
+/**
+ * Reference-counted set of the subscription queries (table names or SQL) a client holds.
+ *
+ * A query is sent to the server when its count goes from 0 to 1 and unsubscribed when it
+ * drops back to 0, so systems with overlapping table sets share one subscription and one
+ * initial-state download. Each request is diffed against the active set and only the
+ * additions and removals are sent, in one call each.
+ *
+ * Queries requested while disconnected are held and sent on connect, and the whole active
+ * set is subscribed again after a reconnect.
+ *
+ * Game thread only.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBSubscriptionManager
+{
+public:
+    /** Broadcast once the initial rows of a subscribed query have arrived */
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnSubscriptionApplied, const FString& /* Query */);
+
+    explicit FSpacetimeDBSubscriptionManager(FSpacetimeDBClient& InClient);
+
+    /**
+     * Takes a reference on each query, subscribing the ones nobody held yet.
+     *
+     * @param InQueries Table names or queries; each occurrence is one reference
+     * @return False if the subscription of the new queries could not be sent
+     */
+    bool AddQueries(const TArray<FString>& InQueries);
+
+    /**
+     * Releases a reference on each query, unsubscribing the ones nobody holds any more.
+     *
+     * @param InQueries Table names or queries previously passed to AddQueries
+     * @return False if the unsubscription could not be sent
+     */
+    bool RemoveQueries(const TArray<FString>& InQueries);
+
+    /**
+     * Replaces everything one owner holds with a new set, adding and releasing only the difference.
+     *
+     * @param Owner Identifies the calling system
+     * @param InQueries The full set the owner wants; empty releases all of it
+     * @return False if an addition or removal could not be sent
+     */
+    bool SetQueries(FName Owner, const TArray<FString>& InQueries);
+
+    /** Number of references held on a query */
+    int32 GetRefCount(const FString& Query) const;
+
+    /** Whether a query's initial rows have arrived on the current connection */
+    bool IsApplied(const FString& Query) const;
+
+    /** Whether every active query's initial rows have arrived on the current connection */
+    bool AreAllApplied() const;
+
+    /** Every query with at least one reference */
+    TArray<FString> GetActiveQueries() const;
+
+    /** Subscribes the whole active set on a new connection */
+    void HandleConnected();
+
+    /** Marks every query as needing to be subscribed again */
+    void HandleDisconnected();
+
+    /** Records that a query's initial rows arrived and broadcasts OnSubscriptionApplied */
+    void HandleApplied(const FString& Query);
+
+    /** Broadcast once the initial rows of a subscribed query have arrived */
+    FOnSubscriptionApplied OnSubscriptionApplied;
+
+private:
+    struct FQueryState
+    {
+        /** References held by AddQueries callers */
+        int32 RefCount = 0;
+
+        /** Whether the query was subscribed on the current connection */
+        bool bSent = false;
+
+        /** Whether its initial rows have arrived */
+        bool bApplied = false;
+    };
+
+    /** Subscribes queries and marks them sent */
+    bool SendSubscribe(const TArray<FString>& Added);
+
+    FSpacetimeDBClient& Client;
+
+    /** State of every query with at least one reference */
+    TMap<FString, FQueryState> Queries;
+
+    /** The set each SetQueries owner holds */
+    TMap<FName, TArray<FString>> OwnerQueries;
+};
@@ -4,13 +4,27 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
 #include "SpacetimeDBClient.h"
 #include "SpacetimeDB_Types.h"
 #include "SpacetimeDB_PropertyValue.h"
 #include "SpacetimeDBFFI.h"
 #include "SpacetimeDB_ErrorHandler.h"
+#include "SpacetimeDBSpawnDataReader.h"
+#include "SpacetimeDBPayloadDecoder.h"
+#include "SpacetimeDBTypeConversions.h"
+#include "SpacetimeDBInterestGrid.h"
+#include "SpacetimeDBTableCache.h"
+#include "SpacetimeDBShadowState.h"
+#include "SpacetimeDBProxyStore.h"
+#include "SpacetimeDBOutboundScheduler.h"
+#include "SpacetimeDBTypedRpc.h"
 #include "SpacetimeDBSubsystem.generated.h"
 
+class APawn;
+class USpacetimeDBPredictionComponent;
+
 
 // Property update info structure
 USTRUCT()
@@ -123,6 +137,31 @@ struct FPredictedTransformData
 	bool bHasVelocity = false;
 };
 
+/**
+ * An authoritative transform from the server, with the last predicted sequence it acknowledges
+ */
+USTRUCT(BlueprintType)
+struct FSpacetimeDBServerTransformUpdate
+{
+	GENERATED_BODY()
+
+	/** The object ID */
+	UPROPERTY(BlueprintReadWrite, Category = "SpacetimeDB|Prediction")
+	FObjectID ObjectID;
+
+	/** The server transform */
+	UPROPERTY(BlueprintReadWrite, Category = "SpacetimeDB|Prediction")
+	FTransform Transform;
+
+	/** The server velocity */
+	UPROPERTY(BlueprintReadWrite, Category = "SpacetimeDB|Prediction")
+	FVector Velocity = FVector::ZeroVector;
+
+	/** The last predicted sequence the server has applied */
+	UPROPERTY(BlueprintReadWrite, Category = "SpacetimeDB|Prediction")
+	int32 AckedSequence = 0;
+};
+
 /** Delegate for client RPC events */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnClientRpcReceived, int64, ObjectId, const TArray<FStdbRpcArg>&, Args);
 
@@ -144,12 +183,21 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnConnectedDynamic);
 /** Delegate for disconnection events with reason */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDisconnectedDynamic, const FString&, Reason);
 
+/** Delegate for when a dropped connection will be retried after a delay */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnReconnectingDynamic, int32, Attempt, float, DelaySeconds);
+
+/** Delegate for when every reconnection attempt has failed */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnReconnectFailedDynamic);
+
 /** Delegate for when client identity is received */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnIdentityReceivedDynamic, const FString&, Identity);
 
 /** Delegate for when table events are received */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEventReceivedDynamic, const FString&, TableName, const FString&, EventData);
 
+/** Delegate for when the initial rows of a subscribed table or query have arrived */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSubscriptionAppliedDynamic, const FString&, Query);
+
 /** Delegate for when objects are created */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnObjectCreatedDynamic, int64, ObjectId, const FString&, ClassName, const FString&, InitialDataJson);
 
@@ -162,6 +210,99 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnObjectIdRemappedDynamic, int64,
 /** Delegate for when properties are updated */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSpacetimeDBPropertyUpdated, const FSpacetimeDBPropertyUpdateInfo&, UpdateInfo);
 
+/** A property value waiting to be applied locally or sent to the server */
+struct FSpacetimeDBPendingPropertyUpdate
+{
+    /** The property name, as sent on the wire */
+    FString PropertyName;
+
+    /** The property name already resolved from an interned ID; None when only PropertyName is known */
+    FName ResolvedName;
+
+    /** JSON value; empty for binary updates */
+    FString ValueJson;
+
+    /** ValueJson already decoded on the network thread, when it is a scalar */
+    FSpacetimeDBDecodedScalar Scalar;
+
+    /** Value encoded with FSpacetimeDBBinaryCodec; empty for JSON updates */
+    TArray<uint8> Payload;
+
+    /** Whether Payload holds the value instead of ValueJson */
+    bool bBinary = false;
+
+    /** Binary deltas that arrived after the value above, applied on top of it in order */
+    TArray<TArray<uint8>> Deltas;
+};
+
+/** All pending property values for one object, in the order each property was first staged */
+struct FSpacetimeDBPendingObjectUpdates
+{
+    /** The object the values belong to */
+    int64 ObjectId = 0;
+
+    /** The latest value of each property */
+    TArray<FSpacetimeDBPendingPropertyUpdate> Properties;
+
+    /** Property name to index in Properties */
+    TMap<FString, int32> PropertyIndex;
+};
+
+/** An unreliable RPC waiting for the end-of-frame flush */
+struct FSpacetimeDBPendingUnreliableRpc
+{
+    int64 ObjectId = 0;
+    FString FunctionName;
+    FString ParamsJson;
+
+    /** When the call was made, or last merged with a newer one */
+    double QueuedTime = 0.0;
+};
+
+/** An object creation waiting for its turn to spawn */
+struct FSpacetimeDBPendingMaterialization
+{
+    /** The server object ID */
+    int64 ObjectId = 0;
+
+    /** The resolved class to spawn */
+    TWeakObjectPtr<UClass> ObjectClass;
+
+    /** The class name the server announced; empty for creations by class ID */
+    FString ClassName;
+
+    /** The creation snapshot */
+    FString DataJson;
+
+    /** Transform and owner peeked from the snapshot, for prioritization */
+    FSpacetimeDBSpawnSnapshot Snapshot;
+
+    /** Spawn order key; lower spawns sooner */
+    float Priority = 0.0f;
+
+    /** Arrival order, which breaks priority ties and identifies superseded entries */
+    uint64 Sequence = 0;
+
+    /** Whether Snapshot.Transform is newer than the transform in DataJson, as for promoted proxies */
+    bool bSnapshotTransformIsNewer = false;
+};
+
+/** What a server transform update for an object is applied to, resolved once per object */
+struct FSpacetimeDBTransformTarget
+{
+    /** The actor the object ID maps to */
+    TWeakObjectPtr<AActor> Actor;
+
+    /** Its prediction component, if it had one when resolved */
+    TWeakObjectPtr<USpacetimeDBPredictionComponent> PredictionComponent;
+};
+
+/**
+ * Computes the spawn priority of a queued object creation; lower values spawn sooner.
+ * Receives the object ID, its class, the peeked snapshot and the local pawn (may be null).
+ */
+DECLARE_DELEGATE_RetVal_FourParams(float, FSpacetimeDBMaterializationPriority, int64, UClass*, const FSpacetimeDBSpawnSnapshot&, const APawn*);
+
 /**
  * @class USpacetimeDBSubsystem
  * @brief Game Instance Subsystem for managing SpacetimeDB connections.
@@ -170,7 +311,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSpacetimeDBPropertyUpdated, const
  * It provides easy access to SpacetimeDB functionality and handles connection management.
  */
 UCLASS()
-class SPACETIMEDB_UNREALCLIENT_API USpacetimeDBSubsystem : public UGameInstanceSubsystem
+class SPACETIMEDB_UNREALCLIENT_API USpacetimeDBSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
     GENERATED_BODY()
 
@@ -180,6 +321,156 @@ public:
     virtual void Deinitialize() override;
     // End USubsystem
 
+    // Begin FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickableWhenPaused() const override { return true; }
+    // End FTickableGameObject
+
+    /**
+     * Gets statistics for the queue of events waiting to be processed on the game thread.
+     * 
+     * @return Queue depth, drop and backpressure counters
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Stats")
+    FSpacetimeDBEventQueueStats GetInboundQueueStats() const;
+    
+    /**
+     * Gets how often each error code has occurred, including occurrences the rate limit kept
+     * out of the log and OnErrorOccurred.
+     * 
+     * @return One counter per error code seen, in code order
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Stats")
+    TArray<FSpacetimeDBErrorCounter> GetErrorCounters() const;
+    
+    /**
+     * Gets the bytes received per table and sent per reducer. Only counted while stats are collected,
+     * the SpacetimeDB trace channel is on or bCollectTrafficStats is set.
+     * 
+     * @return One entry per table, then one per reducer
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Stats")
+    TArray<FSpacetimeDBTrafficStats> GetTrafficStats() const;
+    
+    /**
+     * Starts writing every inbound server event to a capture file, to be replayed later as a
+     * repeatable load test.
+     * 
+     * @param FilePath Relative paths are under Saved/SpacetimeDB
+     * @return False if the file couldn't be created
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Capture")
+    bool StartEventRecording(const FString& FilePath);
+    
+    /** Finishes the capture started by StartEventRecording */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Capture")
+    void StopEventRecording();
+    
+    /**
+     * Replays a capture as if a server were sending it. Only possible while disconnected.
+     * 
+     * @param FilePath Relative paths are under Saved/SpacetimeDB
+     * @param bAsFastAsPossible Ignore the recorded timing and deliver events as fast as they are processed
+     * @return False if connected, already replaying, or the file is not a capture
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Capture")
+    bool StartEventReplay(const FString& FilePath, bool bAsFastAsPossible = false);
+    
+    /** Stops the running replay */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Capture")
+    void StopEventReplay();
+    
+    /**
+     * Gets the progress of the running replay, or the frame-time report of the last one.
+     * 
+     * @return Events replayed, frame count and frame times
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Capture")
+    FSpacetimeDBReplayStats GetEventReplayStats() const;
+
+    /**
+     * Gets the number of server-created objects still waiting to be spawned.
+     * 
+     * @return The number of queued object creations
+     */
+    UFUNCTION(BlueprintPure, Category = "SpacetimeDB|Objects")
+    int32 GetPendingMaterializationCount() const;
+
+    /**
+     * Get the number of grid cells currently subscribed by interest management.
+     * 
+     * @return The number of subscribed cells; 0 while interest management is off
+     */
+    UFUNCTION(BlueprintPure, Category = "SpacetimeDB|Objects")
+    int32 GetInterestCellCount() const { return InterestGrid.GetNumCells(); }
+
+    /**
+     * Get the number of server actors currently kept as proxies (see bEnableProxyEntities).
+     * 
+     * @return The number of proxies
+     */
+    UFUNCTION(BlueprintPure, Category = "SpacetimeDB|Objects")
+    int32 GetProxyCount() const { return Proxies.Num(); }
+
+    /**
+     * Checks whether a server actor is kept as a proxy. Proxies receive updates but have no actor
+     * until they come within ProxyRelevanceDistance, so FindObjectById returns null for them.
+     * 
+     * @param ObjectId The SpacetimeDB object ID
+     * @return True if the object is a proxy
+     */
+    UFUNCTION(BlueprintPure, Category = "SpacetimeDB|Objects")
+    bool IsProxy(int64 ObjectId) const { return Proxies.Contains(ObjectId); }
+
+    /**
+     * Gets the latest transform of a proxy, e.g. to show distant objects on a map.
+     * 
+     * @param ObjectId The SpacetimeDB object ID
+     * @param OutTransform Receives the transform
+     * @return False if the object isn't a proxy
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Objects")
+    bool GetProxyTransform(int64 ObjectId, FTransform& OutTransform) const;
+
+    /** Get the proxies, e.g. to draw them without actors */
+    const FSpacetimeDBProxyStore& GetProxies() const { return Proxies; }
+
+    /** Get the local copy of the tables listed in the CachedTables setting */
+    const FSpacetimeDBTableCache& GetTableCache() const { return TableCache; }
+
+    /**
+     * Find a cached row by primary key.
+     * 
+     * @param TableName The cached table
+     * @param PrimaryKey The row's primary key value
+     * @param OutRowJson Receives the row as JSON
+     * @return True if the row is cached
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Tables")
+    bool FindCachedRow(const FString& TableName, const FString& PrimaryKey, FString& OutRowJson) const;
+
+    /**
+     * Find the cached rows whose column has a value, using the column's index if it has one.
+     * 
+     * @param TableName The cached table
+     * @param Column The column to match
+     * @param Value The value to match; integers are written without a decimal point
+     * @return The matching rows as JSON
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Tables")
+    TArray<FString> QueryCachedRows(const FString& TableName, const FString& Column, const FString& Value) const;
+
+    /**
+     * Sets the function that orders queued object creations.
+     * The default spawns objects owned by this client first, then the rest nearest the local pawn first.
+     * Priorities are computed when a creation is queued and again whenever the local pawn changes.
+     * 
+     * @param InPriority The priority function; unbound restores the default
+     */
+    void SetMaterializationPriority(const FSpacetimeDBMaterializationPriority& InPriority);
+
     /**
      * Gets the SpacetimeDB client ID (identity).
      * 
@@ -214,6 +505,24 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
     bool IsConnected() const;
     
+    /**
+     * Checks if a dropped connection is being retried. Objects spawned from the server stay in
+     * the world meanwhile and are brought up to date, not respawned, once the connection is back.
+     * 
+     * @return True from the drop until the next successful connect or the last failed attempt
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    bool IsReconnecting() const;
+    
+    /**
+     * Saves the server objects to the snapshot cache of the connected database, for the next
+     * join to load. Disconnect already does this; call it to keep the cache current in between.
+     * 
+     * @return False if the snapshot cache is disabled, nothing is connected or the file couldn't be written
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    bool SaveSnapshotCache();
+    
     /**
      * Gets the SpacetimeDB client ID.
      * 
@@ -234,13 +543,33 @@ public:
     
     /**
      * Subscribes to one or more tables in the SpacetimeDB instance.
+     * Subscriptions are reference counted: tables another caller already subscribed to are not requested again,
+     * and each call should be balanced by UnsubscribeFromTables.
      * 
-     * @param TableNames Array of table names to subscribe to
+     * @param TableNames Array of table names or queries to subscribe to
      * @return True if the subscription was initiated successfully, false otherwise
      */
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
     bool SubscribeToTables(const TArray<FString>& TableNames);
     
+    /**
+     * Releases tables subscribed with SubscribeToTables; each is unsubscribed once no caller holds it.
+     * 
+     * @param TableNames Array of table names or queries to release
+     * @return True if the unsubscription was initiated successfully, false otherwise
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    bool UnsubscribeFromTables(const TArray<FString>& TableNames);
+    
+    /**
+     * Checks whether the initial rows of a subscribed table or query have arrived.
+     * 
+     * @param Query The table name or query
+     * @return True once OnSubscriptionApplied has fired for it on the current connection
+     */
+    UFUNCTION(BlueprintPure, Category = "SpacetimeDB")
+    bool IsSubscriptionApplied(const FString& Query) const;
+    
     /**
      * Gets the client's identity as a hex string.
      * 
@@ -273,6 +602,14 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "SpacetimeDB|Events")
     FOnDisconnectedDynamic OnDisconnected;
     
+    /** Event that fires when a reconnection attempt is scheduled after the connection dropped */
+    UPROPERTY(BlueprintAssignable, Category = "SpacetimeDB|Events")
+    FOnReconnectingDynamic OnReconnecting;
+    
+    /** Event that fires when the reconnection attempts are used up */
+    UPROPERTY(BlueprintAssignable, Category = "SpacetimeDB|Events")
+    FOnReconnectFailedDynamic OnReconnectFailed;
+    
     /** Event that fires when the client identity is received */
     UPROPERTY(BlueprintAssignable, Category = "SpacetimeDB|Events")
     FOnIdentityReceivedDynamic OnIdentityReceived;
@@ -281,6 +618,10 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "SpacetimeDB|Events")
     FOnEventReceivedDynamic OnEventReceived;
     
+    /** Event that fires when the initial rows of a subscribed table or query have arrived */
+    UPROPERTY(BlueprintAssignable, Category = "SpacetimeDB|Events")
+    FOnSubscriptionAppliedDynamic OnSubscriptionApplied;
+    
     /** Event that fires when an error occurs */
     UPROPERTY(BlueprintAssignable, Category = "SpacetimeDB|Events")
     FOnSpacetimeDBErrorOccurred OnErrorOccurred;
@@ -395,6 +736,28 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Properties")
     bool SetPropertyValue(int64 ObjectId, const FString& PropertyName, UObject* Object, bool bReplicateToServer = true);
     
+    /**
+     * Turns automatic replication on or off for an object.
+     * While it is on, the object's replicated properties are checked for changes every
+     * AutoReplicationInterval seconds and the changed ones are sent without SetPropertyValue calls.
+     * With bAutoReplicateOwnedObjects set, ownership changes turn it on and off as well.
+     * 
+     * @param ObjectId The SpacetimeDB object ID
+     * @param bEnabled Whether changes should be sent automatically
+     * @return False if the object isn't registered or has no replicated properties
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Properties")
+    bool SetAutoReplicationEnabled(int64 ObjectId, bool bEnabled);
+    
+    /**
+     * Checks whether an object's property changes are sent automatically.
+     * 
+     * @param ObjectId The SpacetimeDB object ID
+     * @return True if automatic replication is on for the object
+     */
+    UFUNCTION(BlueprintPure, Category = "SpacetimeDB|Properties")
+    bool IsAutoReplicationEnabled(int64 ObjectId) const { return AutoReplication.IsTracked(ObjectId); }
+    
     //============================
     // RPC Management
     //============================
@@ -421,6 +784,20 @@ public:
     UFUNCTION()
     bool CallServerFunction(int64 ObjectId, const FString& FunctionName, const TArray<FStdbRpcArg>& Args);
     
+    /**
+     * Calls a server function on an object without delivery guarantees, for frequent calls where only
+     * the latest one matters. The call goes out at the end of the frame, within OutboundBytesPerSecond;
+     * while it waits, a newer call of the same function on the same object replaces it, and one that
+     * waited longer than UnreliableRpcMaxAge is dropped.
+     * 
+     * @param ObjectId The ID of the object on which to call the function
+     * @param FunctionName The name of the function to call
+     * @param Args The arguments to pass to the function
+     * @return True if the call was queued
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|RPC")
+    bool CallServerFunctionUnreliable(int64 ObjectId, const FString& FunctionName, const TArray<FStdbRpcArg>& Args);
+    
     /**
      * Registers a client function that can be called by the server.
      * 
@@ -449,6 +826,49 @@ public:
         return RegisterClientFunctionWithFFI(FunctionName);
     }
     
+    /**
+     * Registers a client function with a typed signature that the server calls by function ID.
+     * The arguments are decoded straight from the binary payload into the parameters, so calls
+     * neither parse JSON nor look arguments up by name (see SpacetimeDBTypedRpc).
+     * 
+     * @param FunctionName The name of the function to register; its ID is MakeFunctionId(FunctionName)
+     * @param Object The object that will handle the function
+     * @param FunctionPtr The function to call, taking the object ID followed by the RPC arguments
+     * @return True if registration was successful
+     */
+    template<class UserClass, typename... ArgTypes>
+    bool RegisterRPCHandler(const FString& FunctionName, UserClass* Object, void(UserClass::*FunctionPtr)(int64, ArgTypes...))
+    {
+        if (!Object || FunctionName.IsEmpty())
+        {
+            return false;
+        }
+        
+        auto Handler = [Object, FunctionPtr](int64 ObjectId, FSpacetimeDBBinaryReader& Reader) {
+            return SpacetimeDBTypedRpc::ReadArgsAndCall<ArgTypes...>(Reader, FunctionPtr, Object, ObjectId);
+        };
+        
+        return RegisterTypedClientFunction(FunctionName, SpacetimeDBTypedRpc::MakeFunctionId(*FunctionName), Handler);
+    }
+    
+    /**
+     * Calls a server function with typed arguments, marshalled straight into a reused binary
+     * buffer, so steady calls allocate nothing (see SpacetimeDBTypedRpc).
+     * 
+     * @param ObjectId The ID of the object on which to call the function
+     * @param FunctionId The function, from SpacetimeDBTypedRpc::MakeFunctionId
+     * @param Args The arguments, in the order the server function declares them
+     * @return True if the call was sent
+     */
+    template<typename... ArgTypes>
+    bool CallServerFunctionTyped(int64 ObjectId, uint32 FunctionId, const ArgTypes&... Args)
+    {
+        TypedRpcBuffer.Reset();
+        FSpacetimeDBBinaryWriter Writer(TypedRpcBuffer);
+        SpacetimeDBTypedRpc::WriteArgs(Writer, Args...);
+        return SendTypedServerRpc(ObjectId, FunctionId, TypedRpcBuffer);
+    }
+    
     /** Register an object for client-side prediction */
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Prediction")
     bool RegisterPredictionObject(const FObjectID& ObjectID);
@@ -465,6 +885,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Prediction")
     bool SendPredictedTransform(const FPredictedTransformData& TransformData);
 
+    /**
+     * Send several predicted transform updates to the server in one quantized message.
+     * Cell, velocity and scale are left out of each record while they match what was last sent for that object.
+     *
+     * @param Transforms The updates to send
+     * @return True if the batch was sent
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Prediction")
+    bool SendPredictedTransforms(const TArray<FPredictedTransformData>& Transforms);
+
     /** Get the last acknowledged sequence number for an object */
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Prediction")
     int32 GetLastAckedSequence(const FObjectID& ObjectID);
@@ -473,6 +903,27 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Prediction")
     void ProcessServerTransformUpdate(const FObjectID& ObjectID, const FTransform& Transform, const FVector& Velocity, int32 AckedSequence);
 
+    /**
+     * Apply a network tick's worth of server transform updates.
+     * Predicted actors are handed to their prediction component; the rest are moved directly with
+     * overlap updates deferred until the whole batch is placed. Only the newest update per object is applied.
+     *
+     * @param Updates The updates to apply
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Prediction")
+    void ApplyServerTransforms(const TArray<FSpacetimeDBServerTransformUpdate>& Updates);
+
+    /** Non-Blueprint form of ApplyServerTransforms for callers that already hold the updates contiguously */
+    void ApplyServerTransformBatch(TConstArrayView<FSpacetimeDBServerTransformUpdate> Updates);
+
+    /**
+     * Same as above for server transforms still in their single precision wire form, e.g. decoded from
+     * table rows. They are widened with FSpacetimeDBTypeConversions::FromStdbTransforms in one pass.
+     * Every view must be as long as ObjectIDs.
+     */
+    void ApplyServerTransformBatch(TConstArrayView<FObjectID> ObjectIDs, TConstArrayView<stdb::shared::Transform> Transforms,
+        TConstArrayView<stdb::shared::Vector3> Velocities, TConstArrayView<int32> AckedSequences);
+
     //============================
     // Component Replication
     //============================
@@ -511,6 +962,10 @@ public:
     /**
      * Gets all components for an actor by its SpacetimeDB object ID.
      * 
+     * Reads the cached actor_component table once its subscription has been applied.
+     * Before that it calls the get_components reducer and returns an empty array; the
+     * components then arrive as object events.
+     * 
      * @param ActorId The SpacetimeDB object ID of the actor
      * @return Array of component IDs attached to the actor
      */
@@ -581,11 +1036,73 @@ public:
     void HandleObjectIdRemapped(uint64 TempId, uint64 ServerId);
     
     /** Handler for property updated events - this is a method that's called for blueprint event broadcast */
-    void InternalOnPropertyUpdated(int64 ObjectId, const FString& PropertyName, const FString& ValueJson);
+    void InternalOnPropertyUpdated(int64 ObjectId, const FString& PropertyName, const FString& ValueJson, const FSpacetimeDBDecodedScalar* Scalar = nullptr);
 
     /** Handler for property updated events from the client - will be called by the FFI layer */
     void InternalHandlePropertyUpdated(uint64 ObjectId, const FString& PropertyName, const FString& ValueJson);
 
+    /** Handler for binary encoded property updates from the client (see FSpacetimeDBBinaryCodec) */
+    void InternalHandlePropertyUpdatedBinary(uint64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload);
+
+    /** Handler for binary encoded updates of properties the server refers to by interned ID */
+    void InternalHandlePropertyUpdatedBinaryById(uint64 ObjectId, uint32 PropertyId, const TArray<uint8>& Payload);
+
+    /** Handler for calls of typed client RPCs */
+    void InternalHandleClientRpcBinary(uint64 ObjectId, uint32 FunctionId, const TArray<uint8>& Args);
+
+    /** Applies, queues or buffers a binary property update; ResolvedName skips the name lookup when known */
+    void HandleBinaryPropertyUpdate(uint64 ObjectId, const FString& PropertyName, FName ResolvedName, const TArray<uint8>& Payload);
+
+    /**
+     * Applies every property update staged since the last flush.
+     * Each object's values are written first, then each changed property's RepNotify fires once
+     * and OnPropertyUpdated is broadcast once per property. Called at the end of every drain.
+     */
+    void FlushPendingPropertyUpdates();
+
+    /**
+     * Spawns queued object creations in priority order until the time budget is spent.
+     * At least one object spawns per call so the queue always drains. Called every frame after the event drain.
+     * 
+     * @param TimeBudgetSeconds Time to spend spawning
+     */
+    void MaterializePendingObjects(double TimeBudgetSeconds);
+
+// Ownership queries, also used by USpacetimeDBOwnershipHelper
+public:
+    /**
+     * Gets the owner client ID of an object.
+     * 
+     * @param ObjectId The object ID to check
+     * @return The owner client ID, or 0 if not found or not owned
+     */
+    int64 GetOwnerClientId(int64 ObjectId) const;
+
+    /**
+     * Checks if the client has ownership of an object.
+     * 
+     * @param ObjectId The object ID to check
+     * @return True if the client owns the object, false otherwise
+     */
+    bool HasOwnership(int64 ObjectId) const;
+
+    /**
+     * Gets the IDs of every object owned by a client.
+     * 
+     * @param OwnerClientId The owner client ID
+     * @return The owned object IDs, in no particular order
+     */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB|Ownership")
+    TArray<int64> GetObjectsOwnedBy(int64 OwnerClientId) const;
+
+    /**
+     * Gets the objects owned by a client without copying them.
+     * 
+     * @param OwnerClientId The owner client ID
+     * @return The owned object IDs, or null if the client owns nothing
+     */
+    const TSet<int64>* FindObjectsOwnedBy(int64 OwnerClientId) const;
+
 protected:
     /** The SpacetimeDB client instance used for network communication */
     FSpacetimeDBClient Client;
@@ -593,13 +1110,20 @@ protected:
     /** Delegate handles for client events */
     FDelegateHandle OnConnectedHandle;
     FDelegateHandle OnDisconnectedHandle;
+    FDelegateHandle OnReconnectingHandle;
+    FDelegateHandle OnReconnectFailedHandle;
     FDelegateHandle OnIdentityReceivedHandle;
     FDelegateHandle OnEventReceivedHandle;
     FDelegateHandle OnErrorOccurredHandle;
     FDelegateHandle OnPropertyUpdatedHandle;
+    FDelegateHandle OnPropertyUpdatedBinaryHandle;
+    FDelegateHandle OnPropertyUpdatedBinaryByIdHandle;
+    FDelegateHandle OnClientRpcBinaryHandle;
     FDelegateHandle OnObjectCreatedHandle;
+    FDelegateHandle OnObjectCreatedByClassIdHandle;
     FDelegateHandle OnObjectDestroyedHandle;
     FDelegateHandle OnObjectIdRemappedHandle;
+    FDelegateHandle OnSubscriptionAppliedHandle;
 
     
 private:
@@ -612,9 +1136,273 @@ private:
     // Reverse lookup - Maps UObjects to their SpacetimeDB IDs
     TMap<UObject*, int64> ObjectToIdMap;
     
+    // Property updates staged during the current drain, in object arrival order
+    TArray<FSpacetimeDBPendingObjectUpdates> PendingPropertyUpdates;
+    
+    // Maps object IDs to their index in PendingPropertyUpdates
+    TMap<int64, int32> PendingPropertyUpdateIndex;
+    
+    // Number of staged updates replaced by a newer value before they were applied
+    int64 TotalCoalescedPropertyUpdates = 0;
+    
+    // Stage a property update, replacing any older value for the same property
+    void QueuePropertyUpdate(int64 ObjectId, FSpacetimeDBPendingPropertyUpdate&& Update);
+    
+    // Outgoing property updates waiting for the end-of-frame flush, in object order
+    TArray<FSpacetimeDBPendingObjectUpdates> DirtyPropertyUpdates;
+    
+    // Maps object IDs to their index in DirtyPropertyUpdates
+    TMap<int64, int32> DirtyPropertyUpdateIndex;
+    
+    // When each object's dirty properties were last sent, for per-class flush rates
+    TMap<int64, double> LastPropertyFlushTime;
+    
+    // Resolved flush interval in seconds per class; 0 means every frame
+    TMap<TObjectKey<UClass>, double> PropertyFlushIntervalCache;
+    
+    // Reused buffer for the batched set_properties_binary message
+    TArray<uint8> PropertyBatchBuffer;
+    
+    // Predicted transforms queued by SendPredictedTransform for the end-of-frame batch, one per object
+    TArray<FPredictedTransformData> PendingPredictedTransforms;
+    
+    // Maps object IDs to their index in PendingPredictedTransforms
+    TMap<int64, int32> PendingPredictedTransformIndex;
+    
+    // The last quantized transform the server received per object; flagged-out fields are relative to it
+    TMap<int64, FSpacetimeDBQuantizedTransform> SentPredictedTransforms;
+    
+    // Reused buffer for the batched send_predicted_transforms_quantized message
+    TArray<uint8> PredictedTransformBuffer;
+    
+    // Send the predicted transforms queued this frame
+    void FlushPredictedTransforms();
+    
+    // Stage an outgoing property update, replacing any unsent value for the same property
+    void MarkPropertyDirty(int64 ObjectId, FSpacetimeDBPendingPropertyUpdate&& Update);
+    
+    // Send every dirty property whose class flush interval has elapsed
+    void FlushDirtyPropertyUpdates();
+    
+    // Get the minimum time between property flushes for objects of a class
+    double GetPropertyFlushInterval(UClass* Class);
+    
+    // Unreliable RPCs waiting for the end-of-frame flush, in call order
+    TArray<FSpacetimeDBPendingUnreliableRpc> PendingUnreliableRpcs;
+    
+    // Maps an object and function to its call in PendingUnreliableRpcs
+    TMap<TPair<int64, FString>, int32> PendingUnreliableRpcIndex;
+    
+    // Send the unreliable RPCs whose objects have budget, and drop the ones that waited too long
+    void FlushUnreliableRpcs();
+    
+    // Byte budget and priority accumulators of the unreliable outbound traffic
+    FSpacetimeDBOutboundScheduler OutboundScheduler;
+    
+    // Whether this frame's unreliable traffic is limited to OutboundReleasedObjects
+    bool bOutboundBudgetActive = false;
+    
+    // Objects whose unreliable traffic goes out this frame
+    TSet<int64> OutboundReleasedObjects;
+    
+    // Resolved send priority per class
+    TMap<TObjectKey<UClass>, float> OutboundPriorityCache;
+    
+    // Decide which objects' unreliable traffic fits in this frame's budget
+    void ScheduleOutboundTraffic(float DeltaTime);
+    
+    // Send priority of an object from its class, whether it is the local pawn and its distance to Origin, if any
+    float GetOutboundPriority(int64 ObjectId, const FVector* Origin, const APawn* ViewPawn);
+    
+    // Whether an object's unreliable traffic may go out this frame
+    bool IsOutboundReleased(int64 ObjectId) const { return !bOutboundBudgetActive || OutboundReleasedObjects.Contains(ObjectId); }
+    
+    // Shadow copies of the auto-replicated objects, see SetAutoReplicationEnabled
+    FSpacetimeDBShadowState AutoReplication;
+    
+    // Check this frame's share of the auto-replicated objects and stage their changed properties
+    void UpdateAutoReplication();
+    
+    // Send the current value of a property the shadow state found changed, as a delta against the previous encoding when that is smaller
+    void ReplicateChangedProperty(int64 ObjectId, UObject* Object, const FSpacetimeDBPropertyDescriptor& Descriptor,
+        const TArray<uint8>* PreviousEncoding, const TArray<uint8>* CurrentEncoding);
+    
+    // Whether an outgoing value for a property is waiting for the flush
+    bool IsPropertyDirty(int64 ObjectId, const FString& PropertyName) const;
+    
+    // Decode a full binary value or a delta into a property without notifying; a delta that doesn't fit asks for a resync
+    bool ApplyBinaryPropertyPayload(int64 ObjectId, UObject* Object, const FSpacetimeDBPropertyDescriptor& Descriptor, const uint8* Data, int32 Size);
+    
+    // Ask the server for the full value of a property, at most once per second per property
+    void RequestPropertyResync(int64 ObjectId, FName PropertyName);
+    
+    // When a resync was last requested per object and property
+    TMap<TPair<int64, FName>, double> LastPropertyResyncRequest;
+    
+    // Apply a binary property update immediately (used when coalescing is disabled)
+    void InternalOnPropertyUpdatedBinary(int64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload, FName ResolvedName = NAME_None);
+    
     // Internal method to spawn an object based on a server notification
     UObject* SpawnObjectFromServer(int64 ObjectId, const FString& ClassName, const FString& DataJson);
     
+    // Spawn an object of an already resolved class
+    UObject* SpawnObjectFromServer(int64 ObjectId, UClass* ObjectClass, const FString& DataJson);
+    
+    // Add a server object to the registry and hook its destruction
+    void RegisterSpawnedObject(int64 ObjectId, UObject* Object);
+    
+    // Remove a server object from the registry and the owner index
+    void UnregisterObject(int64 ObjectId, UObject* Object);
+    
+    // Actor and prediction component per object that has received a server transform
+    TMap<int64, FSpacetimeDBTransformTarget> TransformTargets;
+    
+    // Index of the newest update per object in the batch being applied
+    TMap<int64, int32> TransformBatchIndex;
+    
+    // Find or resolve what server transforms for an object are applied to; null if it isn't an actor
+    const FSpacetimeDBTransformTarget* ResolveTransformTarget(int64 ObjectId);
+    
+    // Owner client ID per object; objects without an owner property are absent
+    TMap<int64, int64> OwnerIndex;
+    
+    // Object IDs per owner client ID
+    TMap<int64, TSet<int64>> ObjectsByOwner;
+    
+    // Re-read an object's owner property into the owner index
+    void RefreshIndexedOwner(int64 ObjectId, const UObject* Object);
+    
+    // Forget an object in the owner index
+    void RemoveIndexedOwner(int64 ObjectId);
+    
+    // Object creations waiting to spawn, as a heap ordered by priority
+    TArray<FSpacetimeDBPendingMaterialization> PendingMaterializations;
+    
+    // Sequence of the live queued creation per object; heap entries with another sequence are stale
+    TMap<int64, uint64> PendingMaterializationSequence;
+    
+    // Next creation sequence number
+    uint64 NextMaterializationSequence = 0;
+    
+    // The local pawn the queued priorities were computed against
+    TWeakObjectPtr<const APawn> MaterializationViewPawn;
+    
+    // User-supplied priority function; the default ordering is used when unbound
+    FSpacetimeDBMaterializationPriority MaterializationPriority;
+    
+    // Property updates received for objects that are queued but not spawned yet
+    TArray<FSpacetimeDBPendingObjectUpdates> MaterializationPropertyUpdates;
+    
+    // Maps object IDs to their index in MaterializationPropertyUpdates
+    TMap<int64, int32> MaterializationPropertyUpdateIndex;
+    
+    // Queue a server object creation, spawn it right away when time slicing is disabled, or keep it as a proxy when it is out of relevance;
+    // Snapshot is the spawn data already decoded off the game thread, if any
+    void QueueMaterialization(int64 ObjectId, UClass* ObjectClass, const FString& ClassName, const FString& DataJson, const FSpacetimeDBSpawnSnapshot* Snapshot = nullptr);
+    
+    // Queue a prepared creation by priority, or spawn it right away when time slicing is disabled
+    void EnqueueMaterialization(FSpacetimeDBPendingMaterialization&& Entry);
+    
+    // Spawn a dequeued creation, broadcast OnObjectCreated and apply the property updates buffered for it
+    void MaterializeObject(FSpacetimeDBPendingMaterialization& Entry);
+    
+    // Spawn a queued object right away, ahead of its turn; returns false if it isn't queued
+    bool MaterializeObjectNow(int64 ObjectId);
+    
+    // Forget a queued creation and its buffered updates; returns false if it isn't queued
+    bool CancelMaterialization(int64 ObjectId);
+    
+    // Bring an object that already exists up to date with a creation snapshot; returns false if it has to be spawned
+    bool ReconcileExistingObject(int64 ObjectId, UClass* ObjectClass, const FString& DataJson);
+    
+    // Despawn the objects kept from the last connection that the resubscribed rows did not confirm
+    void FinishReconciliation();
+    
+    // Whether objects kept across a reconnect are waiting for the resubscribed rows
+    bool bReconcilingObjects = false;
+    
+    // Objects, proxies and queued creations from the last connection not yet seen on this one
+    TSet<int64> UnconfirmedObjects;
+    
+    // Whether a connection was made before, so objects still here on connect were kept from it
+    bool bHasConnectedBefore = false;
+    
+    // Whether the snapshot cache was loaded since the last connection
+    bool bLoadedSnapshotCache = false;
+    
+    // Buffer a property update if its object is queued; returns false if it isn't
+    bool BufferMaterializationPropertyUpdate(int64 ObjectId, FSpacetimeDBPendingPropertyUpdate& Update);
+    
+    // Compute the spawn priority of a queued creation
+    float GetMaterializationPriority(const FSpacetimeDBPendingMaterialization& Entry, const APawn* ViewPawn) const;
+    
+    // Get the pawn of the first local player, if any
+    const APawn* GetLocalPawn() const;
+    
+    // Cells of the interest tables subscribed around the local pawn
+    FSpacetimeDBInterestGrid InterestGrid;
+    
+    // Rows of the cached tables, indexed for local queries
+    FSpacetimeDBTableCache TableCache;
+    
+    // Move the interest grid with the local pawn, swapping cell subscriptions as needed
+    void UpdateInterest();
+    
+    // Forget every interest cell and release its subscription references
+    void ReleaseInterest();
+    
+    // Despawn (or pool) objects outside every subscribed cell and drop their queued creations and proxies
+    void ReleaseObjectsOutOfInterest();
+    
+    // Server actors kept as data records while out of relevance
+    FSpacetimeDBProxyStore Proxies;
+    
+    // Snapshot cache file of the database connected to; empty while the cache is off
+    FString SnapshotCachePath;
+    
+    // Load the snapshot cache of the database about to be joined as proxies, when nothing is spawned yet
+    void LoadSnapshotCache();
+    
+    // When proxies and actors were last checked against the relevance range
+    double LastProxyRelevanceCheck = 0.0;
+    
+    // Get the location relevance is measured from: the local pawn, or the local view without one
+    bool GetRelevanceOrigin(FVector& OutLocation) const;
+    
+    // Promote the proxies that came into relevance and demote the actors that left it
+    void UpdateProxyRelevance();
+    
+    // Whether a creation should start as a proxy instead of spawning
+    bool ShouldStartAsProxy(const FSpacetimeDBPendingMaterialization& Entry) const;
+    
+    // Queue a proxy's creation with the values recorded for it; returns false if it isn't a proxy
+    bool PromoteProxy(int64 ObjectId);
+    
+    // Record an actor's replicated state as a proxy, then despawn (or pool) it
+    void DemoteToProxy(int64 ObjectId, AActor* Actor);
+    
+    // Record a property update for a proxy; returns false if the object isn't one
+    bool StoreProxyProperty(int64 ObjectId, const FString& PropertyName, const FString& ValueJson);
+    bool StoreProxyProperty(int64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload);
+    
+    // Record a proxy's new owner and promote it if that is this client
+    void OnProxyOwnerChanged(int64 ObjectId, FSpacetimeDBProxyEntity& Proxy, int64 OwnerClientId);
+    
+    // Server-destroyed actors parked for reuse, per class
+    TMap<TObjectKey<UClass>, TArray<TWeakObjectPtr<AActor>>> ActorPool;
+    
+    // Resolved pool capacity per class; 0 means not pooled
+    TMap<TObjectKey<UClass>, int32> ActorPoolSizeCache;
+    
+    // Get how many actors of a class may be parked
+    int32 GetActorPoolSize(UClass* Class);
+    
+    // Park an actor instead of destroying it; returns false if its class is not pooled or the pool is full
+    bool ReleaseActorToPool(AActor* Actor);
+    
+    // Take a parked actor of Class, reset its and its components' replicated state to the defaults and reinitialize it from the snapshot
+    AActor* AcquirePooledActor(UClass* Class, UWorld* World, const FString& DataJson);
+    
     // Internal method to destroy an object based on a server notification
     void DestroyObjectFromServer(int64 ObjectId);
     
@@ -627,14 +1415,35 @@ private:
     // Register a client function with FFI
     bool RegisterClientFunctionWithFFI(const FString& FunctionName);
     
-    // Static callback function for client RPCs (called from FFI)
-    static bool HandleClientRpcFromFFI(uint64 ObjectId, const char* ArgsJson);
+    // Typed client RPC handler; decodes the arguments and calls the function, false if they don't fit its signature
+    typedef TFunction<bool(int64, FSpacetimeDBBinaryReader&)> FTypedClientRpcHandler;
+    
+    // Typed client RPC handlers by function ID
+    TMap<uint32, FTypedClientRpcHandler> TypedClientRpcHandlers;
     
-    // Handle client RPC on the game thread
-    void HandleClientRpc(uint64 ObjectId, const FString& FunctionName, TSharedPtr<FJsonObject> ArgsObj);
+    // Names of the typed client RPCs by function ID, announced to the server on every connect
+    TMap<uint32, FString> TypedClientRpcNames;
+    
+    // Argument buffer reused by CallServerFunctionTyped
+    TArray<uint8> TypedRpcBuffer;
+    
+    // Store a typed client RPC handler and announce its ID to the server
+    bool RegisterTypedClientFunction(const FString& FunctionName, uint32 FunctionId, FTypedClientRpcHandler Handler);
+    
+    // Send encoded typed RPC arguments through the FFI
+    bool SendTypedServerRpc(int64 ObjectId, uint32 FunctionId, const TArray<uint8>& Args);
+    
+    // Static callback function for client RPCs (called from FFI); Context is the client of the connection
+    static bool HandleClientRpcFromFFI(uintptr_t Context, uint64 ObjectId, const char* ArgsJson);
+    
+    // Handle client RPC on the game thread; the arguments were already parsed on the network thread
+    void HandleClientRpc(uint64 ObjectId, const FString& FunctionName, const TArray<FStdbRpcArg>& Args);
     
     // Parse JSON arguments into an array of FStdbRpcArg
-    TArray<FStdbRpcArg> ParseRpcArguments(const FString& ArgsJson);
+    static TArray<FStdbRpcArg> ParseRpcArguments(const FString& ArgsJson);
+    
+    // Convert the fields of an arguments object into FStdbRpcArg values; safe on any thread
+    static TArray<FStdbRpcArg> ParseRpcArguments(const FJsonObject& ArgsObject);
     
     // Convert array of FStdbRpcArg to JSON string
     FString SerializeRpcArguments(const TArray<FStdbRpcArg>& Args);
@@ -645,18 +1454,30 @@ private:
     /** Handle disconnection event */
     void InternalHandleDisconnected(const FString& Reason);
     
+    /** Handle a reconnection attempt being scheduled */
+    void InternalHandleReconnecting(int32 Attempt, float DelaySeconds);
+    
+    /** Handle the reconnection attempts being used up */
+    void InternalHandleReconnectFailed();
+    
     /** Handle identity received event */
     void InternalHandleIdentityReceived(const FString& Identity);
     
     /** Handle table event received */
     void InternalHandleEventReceived(const FString& TableName, const FString& EventData);
     
+    /** Handle a subscription's initial rows arriving */
+    void InternalHandleSubscriptionApplied(const FString& Query);
+    
     /** Handle errors from SpacetimeDB */
     void InternalHandleErrorOccurred(const FSpacetimeDBErrorInfo& ErrorInfo);
     
     /** Handle object created event */
     void InternalHandleObjectCreated(uint64 ObjectId, const FString& ClassName, const FString& DataJson);
     
+    /** Handle object created event that identifies the class by server class ID */
+    void InternalHandleObjectCreatedByClassId(uint64 ObjectId, uint32 ClassId, const FString& DataJson);
+    
     /** Handle object destroyed event */
     void InternalHandleObjectDestroyed(uint64 ObjectId);
     
@@ -695,22 +1516,6 @@ private:
      */
     bool HasAuthority(int64 ObjectId) const;
 
-    /**
-     * Gets the owner client ID of an object.
-     * 
-     * @param ObjectId The object ID to check
-     * @return The owner client ID, or 0 if not found or not owned
-     */
-    int64 GetOwnerClientId(int64 ObjectId) const;
-
-    /**
-     * Checks if the client has ownership of an object.
-     * 
-     * @param ObjectId The object ID to check
-     * @return True if the client owns the object, false otherwise
-     */
-    bool HasOwnership(int64 ObjectId) const;
-
     /**
      * Requests the server to change the owner of an object.
      * 
@@ -739,6 +1544,16 @@ private:
      */
     bool SendPropertyUpdateToServer(int64 ObjectId, const FString& PropertyName, const FString& ValueJson);
 
+    /**
+     * Sends a binary encoded property update to the server.
+     * 
+     * @param ObjectId The object ID
+     * @param PropertyName The property name
+     * @param Payload The value encoded with FSpacetimeDBBinaryCodec
+     * @return True if the update was sent successfully
+     */
+    bool SendPropertyBinaryUpdateToServer(int64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload);
+
     /**
      * Helper method to call a reducer with const-correctness.
      * 
@@ -0,0 +1,103 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * In-memory copy of the rows of subscribed tables, with declared indexes for local queries.
+ *
+ * Each declared table keeps its rows by primary key and one index per declared secondary
+ * column, so lookups by key or by an indexed column are hash lookups instead of server
+ * round-trips. Rows are fed from table events: a bare row object is an insert or update,
+ * and {"op": "delete", "row": {...}} removes the row (any other op is an upsert).
+ *
+ * Column values are compared by their string form: integral numbers as plain integers,
+ * other numbers as FString::SanitizeFloat, booleans as true/false.
+ *
+ * Game thread only.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBTableCache
+{
+public:
+    /**
+     * Starts caching a table.
+     *
+     * @param TableName The table name as it appears in table events
+     * @param PrimaryKey The column that identifies a row
+     * @param IndexedColumns Secondary columns to index for FindRows
+     */
+    void DeclareTable(const FString& TableName, const FString& PrimaryKey, const TArray<FString>& IndexedColumns);
+
+    /** Whether a table is declared */
+    bool IsCached(const FString& TableName) const { return Tables.Contains(TableName); }
+
+    /**
+     * Applies a table event to the cache.
+     *
+     * @param TableName The table the event is for
+     * @param EventData The event JSON
+     * @return True if the table is cached and the event was applied
+     */
+    bool ApplyEvent(const FString& TableName, const FString& EventData);
+
+    /**
+     * Inserts, replaces or removes one row.
+     *
+     * @param TableName The table the row belongs to
+     * @param Row The row; must contain the primary key column
+     * @param bDelete Whether to remove the row instead
+     * @return True if the table is cached and the row has a primary key
+     */
+    bool ApplyRow(const FString& TableName, const TSharedPtr<FJsonObject>& Row, bool bDelete);
+
+    /**
+     * Finds a row by primary key.
+     *
+     * @return The row, or null if it is not cached
+     */
+    TSharedPtr<FJsonObject> FindRow(const FString& TableName, const FString& PrimaryKey) const;
+
+    /**
+     * Finds the rows whose column has a value. Indexed columns are a hash lookup; others scan the table.
+     *
+     * @param TableName The table to search
+     * @param Column The column to match
+     * @param Value The value, in the string form described above
+     * @param OutRows Receives the matching rows
+     * @return The number of rows found
+     */
+    int32 FindRows(const FString& TableName, const FString& Column, const FString& Value, TArray<TSharedPtr<FJsonObject>>& OutRows) const;
+
+    /** Number of rows cached for a table */
+    int32 Num(const FString& TableName) const;
+
+    /** Drops every cached row, keeping the declarations */
+    void ClearRows();
+
+    /** The string form a column value is indexed and compared by */
+    static FString KeyFromJsonValue(const TSharedPtr<FJsonValue>& Value);
+
+private:
+    struct FIndex
+    {
+        /** The indexed column */
+        FString Column;
+
+        /** Primary keys of the rows per column value */
+        TMap<FString, TSet<FString>> KeysByValue;
+    };
+
+    struct FTable
+    {
+        FString PrimaryKey;
+        TMap<FString, TSharedPtr<FJsonObject>> Rows;
+        TArray<FIndex> Indexes;
+    };
+
+    static void AddToIndexes(FTable& Table, const FString& Key, const FJsonObject& Row);
+    static void RemoveFromIndexes(FTable& Table, const FString& Key, const FJsonObject& Row);
+
+    TMap<FString, FTable> Tables;
+};
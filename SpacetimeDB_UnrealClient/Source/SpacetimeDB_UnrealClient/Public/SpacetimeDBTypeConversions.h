@@ -17,6 +17,53 @@ namespace shared {
 }
 }
 
+struct FSpacetimeDBBinaryWriter;
+struct FSpacetimeDBBinaryReader;
+
+/** Which optional fields a quantized transform record carries */
+enum class ESpacetimeDBQuantizedTransformFlags : uint8
+{
+    None = 0,
+
+    /** The world cell changed since the object's previous record (always set on the first one) */
+    HasCell = 1 << 0,
+
+    /** The quantized velocity changed */
+    HasVelocity = 1 << 1,
+
+    /** The scale changed */
+    HasScale = 1 << 2,
+};
+ENUM_CLASS_FLAGS(ESpacetimeDBQuantizedTransformFlags);
+
+/**
+ * A predicted transform in its quantized wire form.
+ *
+ * The location is a world cell index plus a 16-bit fixed-point offset inside that cell, the
+ * rotation is smallest-three packed into 32 bits and the velocity is a 16-bit multiple of a
+ * fixed step. Fields whose flag is clear are unchanged since the object's previous record.
+ */
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBQuantizedTransform
+{
+    uint64 ObjectId = 0;
+    uint32 Sequence = 0;
+    ESpacetimeDBQuantizedTransformFlags Flags = ESpacetimeDBQuantizedTransformFlags::None;
+
+    /** World cell index per axis */
+    FIntVector Cell = FIntVector::ZeroValue;
+
+    /** Location inside the cell, in 1/65536ths of the cell size */
+    uint16 CellOffset[3] = { 0, 0, 0 };
+
+    /** Smallest-three packed rotation */
+    uint32 Rotation = 0;
+
+    /** Velocity in multiples of the velocity step */
+    int16 Velocity[3] = { 0, 0, 0 };
+
+    FVector3f Scale = FVector3f::OneVector;
+};
+
 /**
  * Utility functions for converting between SpacetimeDB and Unreal Engine types.
  * Since the SpacetimeDB SharedModule types are designed to match Unreal's types,
@@ -68,6 +115,25 @@ public:
      */
     static FTransform FromStdbTransform(const stdb::shared::Transform& Transform);
 
+    /**
+     * Converts Unreal FTransforms to SpacetimeDB Transforms in bulk. Each component is narrowed to
+     * float in vector registers and rotations are renormalized after narrowing, so a rotation that
+     * is unit length in double precision stays unit length in single precision.
+     *
+     * @param Transforms The transforms to convert
+     * @param OutTransforms Receives the converted transforms; must be as long as Transforms
+     */
+    static void ToStdbTransforms(TConstArrayView<FTransform> Transforms, TArrayView<stdb::shared::Transform> OutTransforms);
+
+    /**
+     * Converts SpacetimeDB Transforms to Unreal FTransforms in bulk, renormalizing each rotation
+     * before it is widened. A zero rotation becomes the identity.
+     *
+     * @param Transforms The transforms to convert
+     * @param OutTransforms Receives the converted transforms; must be as long as Transforms
+     */
+    static void FromStdbTransforms(TConstArrayView<stdb::shared::Transform> Transforms, TArrayView<FTransform> OutTransforms);
+
     /**
      * Converts an Unreal FColor to a SpacetimeDB Color
      */
@@ -87,4 +153,58 @@ public:
      * Converts a SpacetimeDB Color to an Unreal FLinearColor
      */
     static FLinearColor ToLinearColor(const stdb::shared::Color& Color);
-}; 
\ No newline at end of file
+
+    /**
+     * Packs a rotation with smallest-three compression: the two high bits hold the index of the
+     * largest component, which is dropped and rebuilt from the unit length, and the other three
+     * are stored in 10 bits each over [-1/sqrt(2), 1/sqrt(2)].
+     */
+    static uint32 PackQuatSmallestThree(const FQuat& Quat);
+
+    /**
+     * Unpacks a rotation written by PackQuatSmallestThree
+     */
+    static FQuat UnpackQuatSmallestThree(uint32 Packed);
+
+    /**
+     * Splits a location into a world cell index and a fixed-point offset inside the cell
+     *
+     * @param Location The world location
+     * @param CellSize Cell edge length; the offset resolution is CellSize / 65536
+     * @param OutCell Receives the cell index
+     * @param OutOffset Receives the offset per axis
+     */
+    static void QuantizeLocation(const FVector& Location, double CellSize, FIntVector& OutCell, uint16 OutOffset[3]);
+
+    /**
+     * Rebuilds a location from a cell index and offset written by QuantizeLocation
+     */
+    static FVector DequantizeLocation(const FIntVector& Cell, const uint16 Offset[3], double CellSize);
+
+    /**
+     * Quantizes a velocity to 16-bit multiples of Step, clamping each axis to the int16 range
+     */
+    static void QuantizeVelocity(const FVector& Velocity, double Step, int16 OutVelocity[3]);
+
+    /**
+     * Rebuilds a velocity written by QuantizeVelocity
+     */
+    static FVector DequantizeVelocity(const int16 Velocity[3], double Step);
+
+    /**
+     * Appends one quantized transform record: varint object ID, varint sequence, a flags byte,
+     * then the cell (3 x int32) if flagged, the cell offset (3 x uint16), the rotation (uint32),
+     * the velocity (3 x int16) if flagged and the scale (3 x float) if flagged.
+     */
+    static void WriteQuantizedTransform(FSpacetimeDBBinaryWriter& Writer, const FSpacetimeDBQuantizedTransform& Transform);
+
+    /**
+     * Reads a record written by WriteQuantizedTransform. Fields whose flag is clear are left
+     * untouched, so decoding each object's records into the same struct keeps its full state.
+     *
+     * @param Reader The reader positioned at the record
+     * @param InOutTransform Receives the record
+     * @return False if the buffer ended inside the record
+     */
+    static bool ReadQuantizedTransform(FSpacetimeDBBinaryReader& Reader, FSpacetimeDBQuantizedTransform& InOutTransform);
+};
@@ -0,0 +1,87 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Tuple.h"
+#include "SpacetimeDBGeneratedAccessors.h"
+#include <type_traits>
+
+/**
+ * Compile-time marshalling for RPCs with typed C++ signatures.
+ *
+ * A typed RPC is identified by a numeric function ID and carries its arguments as their untagged
+ * payloads (the SpacetimeDBAccessors encoding), back to back in declaration order. Both ends know
+ * the signature, so no names, tags or JSON cross the wire, and encoding writes straight into a
+ * reused buffer. Enums travel as their underlying integer.
+ */
+namespace SpacetimeDBTypedRpc
+{
+    /**
+     * Function ID of an RPC: 32-bit FNV-1a over the characters of its name, which must be ASCII.
+     * Usable at compile time, e.g. constexpr uint32 FireId = MakeFunctionId(TEXT("fire_weapon")).
+     * Never 0, which the wire reserves.
+     */
+    constexpr uint32 MakeFunctionId(const TCHAR* FunctionName)
+    {
+        uint32 Hash = 2166136261u;
+        for (const TCHAR* Char = FunctionName; *Char; ++Char)
+        {
+            Hash = (Hash ^ static_cast<uint8>(*Char)) * 16777619u;
+        }
+        return Hash != 0 ? Hash : 1;
+    }
+
+    template <typename T>
+    FORCEINLINE void WriteArg(FSpacetimeDBBinaryWriter& Writer, const T& Value)
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            SpacetimeDBAccessors::WriteValue(Writer, static_cast<std::underlying_type_t<T>>(Value));
+        }
+        else
+        {
+            SpacetimeDBAccessors::WriteValue(Writer, Value);
+        }
+    }
+
+    template <typename T>
+    FORCEINLINE void ReadArg(FSpacetimeDBBinaryReader& Reader, T& Value)
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            std::underlying_type_t<T> Underlying{};
+            SpacetimeDBAccessors::ReadValue(Reader, Underlying);
+            Value = static_cast<T>(Underlying);
+        }
+        else
+        {
+            SpacetimeDBAccessors::ReadValue(Reader, Value);
+        }
+    }
+
+    /** Appends the arguments of a call to Writer */
+    template <typename... ArgTypes>
+    FORCEINLINE void WriteArgs(FSpacetimeDBBinaryWriter& Writer, const ArgTypes&... Args)
+    {
+        (WriteArg(Writer, Args), ...);
+    }
+
+    /**
+     * Decodes the arguments of a call and passes them to Func after the leading arguments.
+     *
+     * @return False, without calling Func, if the payload doesn't hold exactly these argument types
+     */
+    template <typename... ArgTypes, typename FuncType, typename... LeadingTypes>
+    bool ReadArgsAndCall(FSpacetimeDBBinaryReader& Reader, FuncType&& Func, LeadingTypes&&... Leading)
+    {
+        TTuple<std::decay_t<ArgTypes>...> Args;
+        VisitTupleElements([&Reader](auto& Arg) { ReadArg(Reader, Arg); }, Args);
+        if (Reader.IsError() || !Reader.IsAtEnd())
+        {
+            return false;
+        }
+        Args.ApplyAfter(Forward<FuncType>(Func), Forward<LeadingTypes>(Leading)...);
+        return true;
+    }
+}
@@ -83,14 +83,134 @@ struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBErrorInfo
     }
 };
 
+/**
+ * Error codes reported by the client. A code stands for one failure, so occurrences of it are
+ * counted and rate limited together.
+ */
+namespace SpacetimeDBErrorCodes
+{
+    constexpr int32 EmptyHost = 1001;
+    constexpr int32 EmptyDatabaseName = 1002;
+    constexpr int32 AlreadyConnected = 1003;
+    constexpr int32 ConnectFailed = 1004;
+    constexpr int32 LibraryVersionMismatch = 1005;
+    constexpr int32 DisconnectFailed = 1010;
+    constexpr int32 ReducerNotConnected = 2001;
+    constexpr int32 EmptyReducerName = 2002;
+    constexpr int32 ReducerCallFailed = 2003;
+    constexpr int32 SubscribeNotConnected = 3001;
+    constexpr int32 NoTablesToSubscribe = 3002;
+    constexpr int32 SubscribeFailed = 3003;
+    constexpr int32 UnsubscribeFailed = 3004;
+}
+
+/**
+ * How often one error code has occurred since startup or the last ResetErrorCounters
+ */
+USTRUCT(BlueprintType)
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBErrorCounter
+{
+    GENERATED_BODY()
+    
+    /** Error code (0 for errors without one) */
+    UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Error")
+    int32 Code = 0;
+    
+    /** Category of the first occurrence */
+    UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Error")
+    FString Category;
+    
+    /** Every occurrence, reported or not */
+    UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Error")
+    int64 TotalCount = 0;
+    
+    /** Occurrences over the rate limit, which were neither logged nor broadcast */
+    UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Error")
+    int64 SuppressedCount = 0;
+};
+
 /**
  * Static utility class for handling and logging SpacetimeDB errors
+ *
+ * Every error is counted by code. Past MaxErrorReportsPerWindow occurrences of a code within
+ * ErrorReportWindowSeconds, further ones are only counted, and the window closes with one
+ * summary line instead. Thread safe.
  */
 class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBErrorHandler
 {
 public:
     /**
-     * Logs an error and returns an error info struct
+     * Counts an error and, unless its code is over the rate limit, logs it. Nothing is
+     * formatted for an error that isn't reported.
+     * 
+     * @param OutInfo Receives the error info if the error is reported
+     * @param Message Error message
+     * @param Severity Error severity; Critical and above are never rate limited
+     * @param Category Error category
+     * @param Code Error code
+     * @param BuildContext Returns the additional context; only called if the error is reported
+     * @return True if the error was reported and OutInfo should be passed on to delegates
+     */
+    template <typename ContextFuncType>
+    static bool ReportError(
+        FSpacetimeDBErrorInfo& OutInfo,
+        const TCHAR* Message,
+        ESpacetimeDBErrorSeverity Severity,
+        const TCHAR* Category,
+        int32 Code,
+        ContextFuncType&& BuildContext)
+    {
+        if (!ShouldReport(Code, Severity, Category))
+        {
+            return false;
+        }
+        OutInfo = FSpacetimeDBErrorInfo(Message, Severity, Category, Code, BuildContext());
+        WriteLog(OutInfo);
+        return true;
+    }
+    
+    /** ReportError for an error without context */
+    static bool ReportError(
+        FSpacetimeDBErrorInfo& OutInfo,
+        const TCHAR* Message,
+        ESpacetimeDBErrorSeverity Severity,
+        const TCHAR* Category,
+        int32 Code)
+    {
+        return ReportError(OutInfo, Message, Severity, Category, Code, [] { return FString(); });
+    }
+    
+    /**
+     * Counts an error from an FFI callback and, unless its code is over the rate limit, logs it
+     * like HandleFFIError.
+     * 
+     * @param OutInfo Receives the error info if the error is reported
+     * @param FunctionName Name of the FFI function that was called
+     * @param ErrorMessage Error message from the FFI call
+     * @return True if the error was reported and OutInfo should be passed on to delegates
+     */
+    static bool ReportFFIError(FSpacetimeDBErrorInfo& OutInfo, const FString& FunctionName, const FString& ErrorMessage);
+    
+    /**
+     * Counts an error and decides whether it is reported.
+     * 
+     * @return False if the error's code is over the rate limit
+     */
+    static bool ShouldReport(int32 Code, ESpacetimeDBErrorSeverity Severity, const TCHAR* Category);
+    
+    /** Logs the summary of every window that has ended with errors left unreported; called once per frame */
+    static void FlushErrorSummaries();
+    
+    /** Copies the counter of every error code seen, in code order */
+    static void GetErrorCounters(TArray<FSpacetimeDBErrorCounter>& OutCounters);
+    
+    /** Forgets every counter and rate limit window */
+    static void ResetErrorCounters();
+    
+    /**
+     * Logs an error and returns an error info struct.
+     * The error is counted and rate limited like ReportError, but the caller has already paid for
+     * the formatting.
      * 
      * @param Message Error message
      * @param Severity Error severity
@@ -131,4 +251,8 @@ public:
      * @return True if parsing was successful
      */
     static bool ParseFFIErrorMessage(const FString& ErrorMessage, FSpacetimeDBErrorInfo& OutInfo);
+    
+private:
+    /** Cuts the context to MaxErrorContextLength and logs the error */
+    static void WriteLog(FSpacetimeDBErrorInfo& ErrorInfo);
 }; 
\ No newline at end of file
@@ -255,6 +255,129 @@ struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBPropertyValue
     static FSpacetimeDBPropertyValue FromJsonString(const FString& JsonString);
 };
 
+/**
+ * Native counterpart of FSpacetimeDBPropertyValue that stores only the active alternative.
+ *
+ * Scalars, math structs, colors, object IDs and strings (names, text, paths, and the JSON of
+ * containers and custom structs) share one 32 byte inline buffer; only a transform, which does
+ * not fit, is kept on the heap. An instance is 40 bytes where the reflected struct carries every
+ * alternative at once, so native code stores and copies this type and builds the reflected
+ * struct through ToPropertyValue only where Blueprint or UPROPERTY code needs it.
+ */
+class SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBCompactPropertyValue
+{
+public:
+    FSpacetimeDBCompactPropertyValue() = default;
+    explicit FSpacetimeDBCompactPropertyValue(const FSpacetimeDBPropertyValue& Value) { FromPropertyValue(Value); }
+
+    FSpacetimeDBCompactPropertyValue(const FSpacetimeDBCompactPropertyValue& Other) { CopyFrom(Other); }
+    FSpacetimeDBCompactPropertyValue(FSpacetimeDBCompactPropertyValue&& Other) { MoveFrom(Other); }
+    FSpacetimeDBCompactPropertyValue& operator=(const FSpacetimeDBCompactPropertyValue& Other);
+    FSpacetimeDBCompactPropertyValue& operator=(FSpacetimeDBCompactPropertyValue&& Other);
+    ~FSpacetimeDBCompactPropertyValue() { Reset(); }
+
+    ESpacetimeDBPropertyType GetType() const { return Type; }
+    bool IsSet() const { return Type != ESpacetimeDBPropertyType::None; }
+
+    /** Whether the value is held as a string, see SetString */
+    bool HasString() const { return Storage == EStorage::String; }
+
+    /** Clears the value back to None, freeing anything it owned */
+    void Reset();
+
+    void SetBool(bool Value) { SetPod(ESpacetimeDBPropertyType::Bool, Value); }
+    void SetByte(uint8 Value) { SetPod(ESpacetimeDBPropertyType::Byte, Value); }
+    void SetInt32(int32 Value) { SetPod(ESpacetimeDBPropertyType::Int32, Value); }
+    void SetInt64(int64 Value) { SetPod(ESpacetimeDBPropertyType::Int64, Value); }
+    void SetUInt32(uint32 Value) { SetPod(ESpacetimeDBPropertyType::UInt32, Value); }
+    void SetUInt64(uint64 Value) { SetPod(ESpacetimeDBPropertyType::UInt64, Value); }
+    void SetFloat(float Value) { SetPod(ESpacetimeDBPropertyType::Float, Value); }
+    void SetDouble(double Value) { SetPod(ESpacetimeDBPropertyType::Double, Value); }
+    void SetVector(const FVector& Value) { SetPod(ESpacetimeDBPropertyType::Vector, Value); }
+    void SetRotator(const FRotator& Value) { SetPod(ESpacetimeDBPropertyType::Rotator, Value); }
+    void SetQuat(const FQuat& Value) { SetPod(ESpacetimeDBPropertyType::Quat, FPackedQuat{ Value.X, Value.Y, Value.Z, Value.W }); }
+    void SetColor(const FColor& Value) { SetPod(ESpacetimeDBPropertyType::Color, Value); }
+    void SetObjectReference(int64 ObjectId) { SetPod(ESpacetimeDBPropertyType::ObjectReference, ObjectId); }
+    void SetTransform(const FTransform& Value);
+
+    /**
+     * Sets a value held as a string: String, Name, Text and ClassReference, an ObjectReference sent
+     * as a path, or the JSON of an Array, Map, Set or Custom value.
+     */
+    void SetString(ESpacetimeDBPropertyType InType, FString&& Value);
+    void SetString(ESpacetimeDBPropertyType InType, const FString& Value) { SetString(InType, FString(Value)); }
+
+    /** Sets just the type, for values whose payload isn't expanded */
+    void SetTypeOnly(ESpacetimeDBPropertyType InType) { Reset(); Type = InType; }
+
+    bool GetBool() const { return GetPod<bool>(ESpacetimeDBPropertyType::Bool); }
+    uint8 GetByte() const { return GetPod<uint8>(ESpacetimeDBPropertyType::Byte); }
+    int32 GetInt32() const { return GetPod<int32>(ESpacetimeDBPropertyType::Int32); }
+    int64 GetInt64() const { return GetPod<int64>(ESpacetimeDBPropertyType::Int64); }
+    uint32 GetUInt32() const { return GetPod<uint32>(ESpacetimeDBPropertyType::UInt32); }
+    uint64 GetUInt64() const { return GetPod<uint64>(ESpacetimeDBPropertyType::UInt64); }
+    float GetFloat() const { return GetPod<float>(ESpacetimeDBPropertyType::Float); }
+    double GetDouble() const { return GetPod<double>(ESpacetimeDBPropertyType::Double); }
+    FVector GetVector() const { return GetPod<FVector>(ESpacetimeDBPropertyType::Vector); }
+    FRotator GetRotator() const { return GetPod<FRotator>(ESpacetimeDBPropertyType::Rotator); }
+    FColor GetColor() const { return GetPod<FColor>(ESpacetimeDBPropertyType::Color); }
+    int64 GetObjectReference() const { return GetPod<int64>(ESpacetimeDBPropertyType::ObjectReference); }
+    FQuat GetQuat() const;
+    const FTransform& GetTransform() const;
+
+    /** The string of a value set through SetString */
+    const FString& GetString() const { check(Storage == EStorage::String); return *reinterpret_cast<const FString*>(Inline); }
+
+    /** Builds the reflected struct */
+    FSpacetimeDBPropertyValue ToPropertyValue() const;
+    void ToPropertyValue(FSpacetimeDBPropertyValue& OutValue) const;
+
+    /** Takes the active alternative of the reflected struct */
+    void FromPropertyValue(const FSpacetimeDBPropertyValue& Value);
+
+private:
+    /** What Inline holds, which for object references isn't implied by the type */
+    enum class EStorage : uint8
+    {
+        Empty,
+        Pod,
+        String,
+
+        /** Inline holds an owning FTransform pointer */
+        Transform
+    };
+
+    /** FQuat is 16 byte aligned; the inline buffer only guarantees 8 */
+    struct FPackedQuat
+    {
+        double X, Y, Z, W;
+    };
+
+    template <typename T>
+    void SetPod(ESpacetimeDBPropertyType InType, const T& Value)
+    {
+        static_assert(sizeof(T) <= sizeof(Inline) && alignof(T) <= 8 && TIsTriviallyDestructible<T>::Value, "Doesn't fit the inline buffer");
+        Reset();
+        new (Inline) T(Value);
+        Type = InType;
+        Storage = EStorage::Pod;
+    }
+
+    template <typename T>
+    T GetPod(ESpacetimeDBPropertyType InType) const
+    {
+        check(Type == InType && Storage == EStorage::Pod);
+        return *reinterpret_cast<const T*>(Inline);
+    }
+
+    void CopyFrom(const FSpacetimeDBCompactPropertyValue& Other);
+    void MoveFrom(FSpacetimeDBCompactPropertyValue& Other);
+
+    alignas(8) uint8 Inline[32];
+    ESpacetimeDBPropertyType Type = ESpacetimeDBPropertyType::None;
+    EStorage Storage = EStorage::Empty;
+};
+
 /**
  * Helper class for applying property values to UObjects
  */
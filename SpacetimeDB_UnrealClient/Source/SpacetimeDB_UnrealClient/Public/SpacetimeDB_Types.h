@@ -168,4 +168,148 @@ struct SPACETIMEDB_UNREALCLIENT_API FObjectID : public FSpacetimeDBObjectID
 
 	FObjectID() : FSpacetimeDBObjectID() {}
 	FObjectID(int64 InValue) : FSpacetimeDBObjectID(InValue) {}
+};
+
+/**
+ * Statistics for the inbound FFI event queue
+ */
+USTRUCT(BlueprintType)
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBEventQueueStats
+{
+	GENERATED_BODY()
+
+	/** Events currently waiting to be processed */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int32 QueueDepth = 0;
+
+	/** Maximum number of events the queue can hold */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int32 Capacity = 0;
+
+	/** Deepest the queue has been since the connection was created */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int32 HighWaterMark = 0;
+
+	/** Total events accepted into the queue */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int64 TotalEnqueued = 0;
+
+	/** Times a producer had to wait for the game thread to free space */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int64 TotalBackpressureWaits = 0;
+
+	/** Events discarded because the queue stayed full past the backpressure timeout */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int64 TotalDropped = 0;
+
+	/** Events processed by the most recent drain */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int32 LastDrainCount = 0;
+
+	/** Time spent in the most recent drain, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	float LastDrainTimeMs = 0.0f;
+
+	/** Most frame arena memory a single drain has used, in bytes */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int64 FrameArenaHighWaterMark = 0;
+
+	/** Memory held by the frame arena between drains, in bytes */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int64 FrameArenaReserved = 0;
+
+	/** Property updates superseded by a newer value in the same frame and never applied */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int64 TotalCoalescedPropertyUpdates = 0;
+};
+
+/**
+ * Traffic exchanged with the server under one table or reducer name
+ */
+USTRUCT(BlueprintType)
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBTrafficStats
+{
+	GENERATED_BODY()
+
+	/** Table name of inbound table events, reducer name of outbound calls */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	FString Name;
+
+	/** Whether this is reducer traffic to the server rather than table traffic from it */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	bool bOutbound = false;
+
+	/** Events received or calls made */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int64 Messages = 0;
+
+	/** Payload bytes: row JSON in, reducer name and arguments out */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int64 Bytes = 0;
+};
+
+/**
+ * Progress and frame times of an event capture replay
+ */
+USTRUCT(BlueprintType)
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBReplayStats
+{
+	GENERATED_BODY()
+
+	/** Whether a replay is running; stays false after it finishes, with the other fields describing it */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	bool bReplaying = false;
+
+	/** Events handed to the client so far */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int64 EventsReplayed = 0;
+
+	/** Frames since the replay started */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int32 Frames = 0;
+
+	/** Wall-clock time since the replay started, in seconds */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	float DurationSeconds = 0.0f;
+
+	/** Mean frame time during the replay, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	float AverageFrameMs = 0.0f;
+
+	/** Longest frame during the replay, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	float MaxFrameMs = 0.0f;
+};
+
+/**
+ * Per-frame statistics of the prediction manager's reconciliation pass
+ */
+USTRUCT(BlueprintType)
+struct SPACETIMEDB_UNREALCLIENT_API FSpacetimeDBPredictionStats
+{
+	GENERATED_BODY()
+
+	/** Prediction components registered with the manager */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int32 NumPredictedActors = 0;
+
+	/** Server updates reconciled this frame */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int32 NumServerUpdates = 0;
+
+	/** Updates whose error exceeded a threshold and were corrected */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	int32 NumCorrections = 0;
+
+	/** Mean position error over this frame's server updates (cm) */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	float AveragePositionError = 0.0f;
+
+	/** Largest position error among this frame's server updates (cm) */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	float MaxPositionError = 0.0f;
+
+	/** Time spent in the reconciliation pass, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB|Stats")
+	float ReconcileTimeMs = 0.0f;
 };
\ No newline at end of file
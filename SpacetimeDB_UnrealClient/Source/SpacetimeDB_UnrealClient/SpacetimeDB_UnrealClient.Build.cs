@@ -0,0 +1,55 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+using System;
+using System.IO;
+using UnrealBuildTool;
+
+public class SpacetimeDB_UnrealClient : ModuleRules
+{
+    public SpacetimeDB_UnrealClient(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(new string[]
+        {
+            "Core",
+            "CoreUObject",
+            "Engine",
+            "Json"
+        });
+
+        PrivateDependencyModuleNames.AddRange(new string[]
+        {
+            "NetCore",
+            "TraceLog"
+        });
+
+        // ffi.h is generated by cxx when the client library is built, and public headers include it
+        string ClientModuleDir = Path.Combine(PluginDirectory, "ClientModule");
+        PublicIncludePaths.Add(Path.Combine(ClientModuleDir, "target", "cxxbridge"));
+
+        // With SPACETIMEDB_MOCK_FFI=1 in the environment the test module's Private/Mock provides the
+        // library's symbols instead, and the two must not both be linked. Same condition as in the
+        // test module's rules, which only mocks monolithic targets.
+        bool bUseMockFFI = Environment.GetEnvironmentVariable("SPACETIMEDB_MOCK_FFI") == "1"
+            && Target.LinkType == TargetLinkType.Monolithic;
+        if (bUseMockFFI)
+        {
+            return;
+        }
+
+        // cargo build --release in ClientModule produces the static library
+        string LibraryDir = Path.Combine(ClientModuleDir, "target", "release");
+        if (Target.Platform == UnrealTargetPlatform.Win64)
+        {
+            PublicAdditionalLibraries.Add(Path.Combine(LibraryDir, "stdb_client.lib"));
+
+            // Needed by the Rust standard library and tokio
+            PublicSystemLibraries.AddRange(new string[] { "ws2_32.lib", "userenv.lib", "bcrypt.lib", "ntdll.lib", "advapi32.lib" });
+        }
+        else
+        {
+            PublicAdditionalLibraries.Add(Path.Combine(LibraryDir, "libstdb_client.a"));
+        }
+    }
+}
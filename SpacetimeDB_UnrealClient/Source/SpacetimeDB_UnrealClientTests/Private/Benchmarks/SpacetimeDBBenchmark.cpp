@@ -0,0 +1,269 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Benchmarks/SpacetimeDBBenchmark.h"
+#include "Dom/JsonObject.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include <atomic>
+
+namespace
+{
+    /** Sentinel for "no thread is being counted" */
+    constexpr uint32 NoThread = MAX_uint32;
+
+    /**
+     * Forwards to the allocator it replaces and counts the allocations of one thread.
+     * It is installed on the first run and never removed, since memory it handed out
+     * may be freed at any time afterwards.
+     */
+    class FCountingMalloc final : public FMalloc
+    {
+    public:
+        explicit FCountingMalloc(FMalloc* InInner)
+            : Inner(InInner)
+        {
+        }
+
+        void Begin()
+        {
+            NumAllocations = 0;
+            CountedThreadId.store(FPlatformTLS::GetCurrentThreadId(), std::memory_order_release);
+        }
+
+        uint64 End()
+        {
+            CountedThreadId.store(NoThread, std::memory_order_release);
+            return NumAllocations;
+        }
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            Record();
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            Record();
+            return Inner->TryMalloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count != 0)
+            {
+                Record();
+            }
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count != 0)
+            {
+                Record();
+            }
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override
+        {
+            Inner->Free(Original);
+        }
+
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+        {
+            return Inner->QuantizeSize(Count, Alignment);
+        }
+
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+        {
+            return Inner->GetAllocationSize(Original, SizeOut);
+        }
+
+        virtual void Trim(bool bTrimThreadCaches) override
+        {
+            Inner->Trim(bTrimThreadCaches);
+        }
+
+        virtual void SetupTLSCachesOnCurrentThread() override
+        {
+            Inner->SetupTLSCachesOnCurrentThread();
+        }
+
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+        {
+            Inner->ClearAndDisableTLSCachesOnCurrentThread();
+        }
+
+        virtual void InitializeStatsMetadata() override
+        {
+            Inner->InitializeStatsMetadata();
+        }
+
+        virtual bool ValidateHeap() override
+        {
+            return Inner->ValidateHeap();
+        }
+
+        virtual bool IsInternallyThreadSafe() const override
+        {
+            return Inner->IsInternallyThreadSafe();
+        }
+
+        virtual const TCHAR* GetDescriptiveName() override
+        {
+            return Inner->GetDescriptiveName();
+        }
+
+    private:
+        void Record()
+        {
+            // Only the counted thread writes the count, so it needs no atomics of its own
+            if (CountedThreadId.load(std::memory_order_acquire) == FPlatformTLS::GetCurrentThreadId())
+            {
+                ++NumAllocations;
+            }
+        }
+
+        FMalloc* Inner;
+        std::atomic<uint32> CountedThreadId{ NoThread };
+        uint64 NumAllocations = 0;
+    };
+
+    FCountingMalloc& GetCountingMalloc()
+    {
+        static FCountingMalloc* Counter = nullptr;
+        if (!Counter)
+        {
+            Counter = new FCountingMalloc(GMalloc);
+            GMalloc = Counter;
+        }
+        return *Counter;
+    }
+
+    FString GetBaselinePath()
+    {
+        const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("SpacetimeDB_UnrealClient"));
+        const FString BaseDir = Plugin.IsValid() ? Plugin->GetBaseDir() : FPaths::ProjectPluginsDir() / TEXT("SpacetimeDB_UnrealClient");
+        return BaseDir / TEXT("Source/SpacetimeDB_UnrealClientTests/Baselines/BenchmarkBaselines.json");
+    }
+
+    /** Returns the "Benchmarks" object of the baseline file, or an empty one */
+    TSharedRef<FJsonObject> LoadBaselines(TSharedPtr<FJsonObject>& OutRoot)
+    {
+        FString Json;
+        if (FFileHelper::LoadFileToString(Json, *GetBaselinePath()))
+        {
+            FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), OutRoot);
+        }
+        if (!OutRoot.IsValid())
+        {
+            OutRoot = MakeShared<FJsonObject>();
+        }
+
+        const TSharedPtr<FJsonObject>* Benchmarks = nullptr;
+        if (OutRoot->TryGetObjectField(TEXT("Benchmarks"), Benchmarks) && Benchmarks->IsValid())
+        {
+            return Benchmarks->ToSharedRef();
+        }
+
+        TSharedRef<FJsonObject> Empty = MakeShared<FJsonObject>();
+        OutRoot->SetObjectField(TEXT("Benchmarks"), Empty);
+        return Empty;
+    }
+
+    bool SaveBaseline(const FSpacetimeDBBenchmarkResult& Result)
+    {
+        TSharedPtr<FJsonObject> Root;
+        TSharedRef<FJsonObject> Benchmarks = LoadBaselines(Root);
+
+        TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetNumberField(TEXT("NsPerOp"), Result.NanosecondsPerOp);
+        Entry->SetNumberField(TEXT("AllocsPerOp"), Result.AllocationsPerOp);
+        Benchmarks->SetObjectField(Result.Name, Entry);
+
+        FString Json;
+        FJsonSerializer::Serialize(Root.ToSharedRef(), TJsonWriterFactory<>::Create(&Json));
+        return FFileHelper::SaveStringToFile(Json, *GetBaselinePath());
+    }
+}
+
+FSpacetimeDBBenchmarkResult FSpacetimeDBBenchmark::Run(const FString& Name, int32 Iterations, TFunctionRef<void()> Operation)
+{
+    FSpacetimeDBBenchmarkResult Result;
+    Result.Name = Name;
+    Result.Iterations = FMath::Max(Iterations, 1);
+
+    // Warm caches, pools and reusable buffers so the measurement sees the steady state
+    const int32 WarmupIterations = FMath::Max(Result.Iterations / 10, 1);
+    for (int32 Index = 0; Index < WarmupIterations; ++Index)
+    {
+        Operation();
+    }
+
+    FCountingMalloc& Counter = GetCountingMalloc();
+    Counter.Begin();
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    for (int32 Index = 0; Index < Result.Iterations; ++Index)
+    {
+        Operation();
+    }
+    const uint64 ElapsedCycles = FPlatformTime::Cycles64() - StartCycles;
+    const uint64 NumAllocations = Counter.End();
+
+    Result.NanosecondsPerOp = FPlatformTime::ToSeconds64(ElapsedCycles) * 1.0e9 / Result.Iterations;
+    Result.AllocationsPerOp = static_cast<double>(NumAllocations) / Result.Iterations;
+    return Result;
+}
+
+bool FSpacetimeDBBenchmark::Check(FAutomationTestBase& Test, const FSpacetimeDBBenchmarkResult& Result)
+{
+    Test.AddInfo(FString::Printf(TEXT("%s: %.1f ns/op, %.2f allocations/op over %d iterations"),
+        *Result.Name, Result.NanosecondsPerOp, Result.AllocationsPerOp, Result.Iterations));
+
+    if (FParse::Param(FCommandLine::Get(), TEXT("SpacetimeDBUpdateBaselines")))
+    {
+        if (!SaveBaseline(Result))
+        {
+            Test.AddWarning(FString::Printf(TEXT("Could not write the baseline of %s to %s"), *Result.Name, *GetBaselinePath()));
+        }
+        return true;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<FJsonObject> Benchmarks = LoadBaselines(Root);
+    const TSharedPtr<FJsonObject>* Baseline = nullptr;
+    if (!Benchmarks->TryGetObjectField(Result.Name, Baseline) || !Baseline->IsValid())
+    {
+        Test.AddWarning(FString::Printf(TEXT("%s has no baseline; run with -SpacetimeDBUpdateBaselines to record one"), *Result.Name));
+        return true;
+    }
+
+    double BaselineNs = 0.0;
+    double BaselineAllocs = 0.0;
+    (*Baseline)->TryGetNumberField(TEXT("NsPerOp"), BaselineNs);
+    (*Baseline)->TryGetNumberField(TEXT("AllocsPerOp"), BaselineAllocs);
+
+    if (BaselineNs > 0.0 && Result.NanosecondsPerOp > BaselineNs * TimeTolerance)
+    {
+        Test.AddWarning(FString::Printf(TEXT("%s took %.1f ns/op, over %.1fx its baseline of %.1f ns/op"),
+            *Result.Name, Result.NanosecondsPerOp, TimeTolerance, BaselineNs));
+    }
+
+    if (Result.AllocationsPerOp > BaselineAllocs + AllocationTolerance)
+    {
+        Test.AddError(FString::Printf(TEXT("%s made %.2f allocations/op, more than its baseline of %.2f"),
+            *Result.Name, Result.AllocationsPerOp, BaselineAllocs));
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+class FAutomationTestBase;
+
+/** Cost of one benchmarked operation */
+struct FSpacetimeDBBenchmarkResult
+{
+    FString Name;
+    int32 Iterations = 0;
+    double NanosecondsPerOp = 0.0;
+
+    /** Heap allocations made by the benchmark thread, reallocations included */
+    double AllocationsPerOp = 0.0;
+};
+
+/**
+ * Times an operation and counts its heap allocations, and compares the result with the
+ * baseline stored for it in Baselines/BenchmarkBaselines.json.
+ *
+ * An operation that allocates more than its baseline fails the test; one that is more than
+ * TimeTolerance times slower only warns, since timings depend on the machine. Run the
+ * benchmarks with -SpacetimeDBUpdateBaselines to record the current results as the new
+ * baselines; a benchmark without a baseline reports its numbers and warns.
+ */
+class FSpacetimeDBBenchmark
+{
+public:
+    /**
+     * Runs an operation a tenth as many times to warm up, then measures it.
+     *
+     * @param Name Baseline key, e.g. "BinaryCodec.EncodeProperty"
+     * @param Iterations Number of measured calls
+     * @param Operation The operation
+     */
+    static FSpacetimeDBBenchmarkResult Run(const FString& Name, int32 Iterations, TFunctionRef<void()> Operation);
+
+    /**
+     * Reports a result on a test and checks it against its baseline.
+     *
+     * @return False if the result allocates more than the baseline
+     */
+    static bool Check(FAutomationTestBase& Test, const FSpacetimeDBBenchmarkResult& Result);
+
+    /** How many times slower than the baseline a result may be before it warns */
+    static constexpr double TimeTolerance = 1.5;
+
+    /** Allocations per operation a result may exceed the baseline by, for amortized container growth */
+    static constexpr double AllocationTolerance = 0.05;
+};
@@ -0,0 +1,266 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Benchmarks/SpacetimeDBBenchmark.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/Character.h"
+#include "Mock/SpacetimeDBMockFFI.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "SpacetimeDBEventQueue.h"
+#include "SpacetimeDBPredictionComponent.h"
+#include "SpacetimeDBPredictionManager.h"
+#include "SpacetimeDBPropertyHelper.h"
+#include "SpacetimeDBSharedTypes.h"
+#include "SpacetimeDBSpawnDataReader.h"
+#include "SpacetimeDBSubsystem.h"
+#include "SpacetimeDBTestTypes.h"
+#include "SpacetimeDBTestWorld.h"
+#include "SpacetimeDBTypeConversions.h"
+#include "SpacetimeDB_JsonUtils.h"
+#include "SpacetimeDB_PropertyValue.h"
+
+namespace
+{
+    constexpr int32 FastIterations = 10000;
+    constexpr int32 SlowIterations = 500;
+
+    /** Predicted characters reconciled per manager tick */
+    constexpr int32 NumPredictedCharacters = 64;
+
+    /** Transforms converted per batch conversion call */
+    constexpr int32 NumBatchTransforms = 1000;
+
+    TArray<FTransform> MakeBatchTransforms()
+    {
+        TArray<FTransform> Transforms;
+        Transforms.Reserve(NumBatchTransforms);
+        for (int32 Index = 0; Index < NumBatchTransforms; ++Index)
+        {
+            // Far from the origin, where narrowing to float actually rounds
+            Transforms.Emplace(FRotator(Index * 0.37, Index * 1.1, 0.0), FVector(1.0e6 + Index * 13.0, -2.0e6, Index * 0.5), FVector(1.0, 1.0, 1.0 + Index * 0.001));
+        }
+        return Transforms;
+    }
+}
+
+BEGIN_DEFINE_SPEC(FSpacetimeDBBenchmarksSpec, "SpacetimeDB.Benchmarks", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+    USpacetimeDBTestObject* Source = nullptr;
+    USpacetimeDBTestObject* Target = nullptr;
+
+    void Measure(const FString& Name, int32 Iterations, TFunctionRef<void()> Operation)
+    {
+        FSpacetimeDBBenchmark::Check(*this, FSpacetimeDBBenchmark::Run(Name, Iterations, Operation));
+    }
+END_DEFINE_SPEC(FSpacetimeDBBenchmarksSpec)
+
+void FSpacetimeDBBenchmarksSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Source = NewObject<USpacetimeDBTestObject>();
+        Source->FillWithSampleValues();
+        Target = NewObject<USpacetimeDBTestObject>();
+    });
+
+    Describe("BinaryCodec", [this]()
+    {
+        It("EncodeProperty", [this]()
+        {
+            const FProperty* Property = SpacetimeDBTests::FindTestProperty(TEXT("StructArray"));
+            const void* Addr = Property->ContainerPtrToValuePtr<void>(Source);
+            TArray<uint8> Bytes;
+            Measure(TEXT("BinaryCodec.EncodeProperty.StructArray"), FastIterations, [&]()
+            {
+                Bytes.Reset();
+                FSpacetimeDBBinaryCodec::EncodeProperty(Property, Addr, Bytes);
+            });
+        });
+
+        It("DecodeProperty", [this]()
+        {
+            const FProperty* Property = SpacetimeDBTests::FindTestProperty(TEXT("TransformValue"));
+            TArray<uint8> Bytes;
+            FSpacetimeDBBinaryCodec::EncodeProperty(Property, Property->ContainerPtrToValuePtr<void>(Source), Bytes);
+            void* Addr = Property->ContainerPtrToValuePtr<void>(Target);
+            Measure(TEXT("BinaryCodec.DecodeProperty.TransformValue"), FastIterations, [&]()
+            {
+                FSpacetimeDBBinaryCodec::DecodeProperty(Property, Addr, Bytes.GetData(), Bytes.Num());
+            });
+        });
+    });
+
+    Describe("PropertyHelper", [this]()
+    {
+        It("SerializePropertyToJson", [this]()
+        {
+            Measure(TEXT("PropertyHelper.SerializePropertyToJson.StructValue"), FastIterations, [&]()
+            {
+                FSpacetimeDBPropertyHelper::SerializePropertyToJson(Source, TEXT("StructValue"));
+            });
+        });
+
+        It("ApplyJsonToProperty", [this]()
+        {
+            const FString Json = FSpacetimeDBPropertyHelper::SerializePropertyToJson(Source, TEXT("StructValue"));
+            Measure(TEXT("PropertyHelper.ApplyJsonToProperty.StructValue"), FastIterations, [&]()
+            {
+                FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Target, TEXT("StructValue"), Json);
+            });
+        });
+    });
+
+    Describe("PropertyValue", [this]()
+    {
+        It("JsonRoundTrip", [this]()
+        {
+            const FSpacetimeDBPropertyValue Value(Source->TransformValue);
+            Measure(TEXT("PropertyValue.JsonRoundTrip.Transform"), FastIterations, [&]()
+            {
+                FSpacetimeDBPropertyValue::FromJsonString(Value.ToJsonString());
+            });
+        });
+    });
+
+    Describe("JsonUtils", [this]()
+    {
+        It("StructRoundTrip", [this]()
+        {
+            UScriptStruct* Struct = FSpacetimeDBTestStruct::StaticStruct();
+            Measure(TEXT("JsonUtils.StructRoundTrip"), FastIterations, [&]()
+            {
+                USpacetimeDBJsonUtils::DeserializeJsonToStruct(Struct, &Target->StructValue,
+                    USpacetimeDBJsonUtils::SerializeStructToJson(Struct, &Source->StructValue));
+            });
+        });
+    });
+
+    Describe("SpawnDataReader", [this]()
+    {
+        It("Read", [this]()
+        {
+            const FTransform Transform(FRotator(0.0, 90.0, 0.0), FVector(100.0, -200.0, 50.0));
+            const FString Json = SpacetimeDBTests::MakeSnapshotJson(Source, SpacetimeDBTests::GetTestPropertyNames(), &Transform);
+            FSpacetimeDBSpawnSnapshot Snapshot;
+            Measure(TEXT("SpawnDataReader.Read"), SlowIterations, [&]()
+            {
+                FSpacetimeDBSpawnDataReader::Read(Json, Target, false, Snapshot);
+            });
+        });
+    });
+
+    Describe("EventQueue", [this]()
+    {
+        It("EnqueueDequeue", [this]()
+        {
+            FSpacetimeDBEventQueue Queue(1024);
+            FSpacetimeDBInboundEvent Event;
+            Event.Type = ESpacetimeDBInboundEventType::ObjectDestroyed;
+            Measure(TEXT("EventQueue.EnqueueDequeue"), FastIterations, [&]()
+            {
+                Queue.Enqueue(Event);
+                Queue.Dequeue(Event);
+            });
+        });
+    });
+
+    Describe("TypeConversions", [this]()
+    {
+        It("ToStdbTransforms", [this]()
+        {
+            const TArray<FTransform> Transforms = MakeBatchTransforms();
+            TArray<stdb::shared::Transform> Narrow;
+            Narrow.SetNumUninitialized(Transforms.Num());
+            Measure(FString::Printf(TEXT("TypeConversions.ToStdbTransforms.%d"), NumBatchTransforms), SlowIterations, [&]()
+            {
+                FSpacetimeDBTypeConversions::ToStdbTransforms(Transforms, Narrow);
+            });
+        });
+
+        It("FromStdbTransforms", [this]()
+        {
+            const TArray<FTransform> Transforms = MakeBatchTransforms();
+            TArray<stdb::shared::Transform> Narrow;
+            Narrow.SetNumUninitialized(Transforms.Num());
+            FSpacetimeDBTypeConversions::ToStdbTransforms(Transforms, Narrow);
+            TArray<FTransform> Wide;
+            Wide.SetNum(Transforms.Num());
+            Measure(FString::Printf(TEXT("TypeConversions.FromStdbTransforms.%d"), NumBatchTransforms), SlowIterations, [&]()
+            {
+                FSpacetimeDBTypeConversions::FromStdbTransforms(Narrow, Wide);
+            });
+        });
+    });
+
+    Describe("Prediction", [this]()
+    {
+        It("Reconcile", [this]()
+        {
+            FSpacetimeDBTestWorld TestWorld;
+            TestWorld.Create();
+            USpacetimeDBPredictionManager* Manager = TestWorld.World->GetSubsystem<USpacetimeDBPredictionManager>();
+
+            TArray<USpacetimeDBPredictionComponent*> Components;
+            for (int32 Index = 0; Index < NumPredictedCharacters; ++Index)
+            {
+                ACharacter* Character = TestWorld.SpawnLocalCharacter(FTransform(FVector(0.0, Index * 500.0, 0.0)));
+                USpacetimeDBPredictionComponent* Component = NewObject<USpacetimeDBPredictionComponent>(Character);
+                Component->RegisterComponent();
+                Components.Add(Component);
+            }
+
+            // One op is a manager tick reconciling a correction for every character
+            Measure(FString::Printf(TEXT("Prediction.Reconcile.%d"), NumPredictedCharacters), SlowIterations, [&]()
+            {
+                for (USpacetimeDBPredictionComponent* Component : Components)
+                {
+                    Component->TakeStateSnapshot();
+                    const AActor* Owner = Component->GetOwner();
+                    const FTransform Server(Owner->GetActorRotation(), Owner->GetActorLocation() + FVector(100.0, 0.0, 0.0));
+                    Manager->QueueServerUpdate(Component, Server, FVector::ZeroVector, Component->GetCurrentSequence() - 1);
+                }
+                Manager->Tick(1.0f / 60.0f);
+            });
+
+            TestWorld.Destroy();
+        });
+    });
+
+#if SPACETIMEDB_MOCK_FFI
+    Describe("Subsystem", [this]()
+    {
+        It("SpawnObjectFromServer", [this]()
+        {
+            FSpacetimeDBMockFFI::Reset();
+            FSpacetimeDBTestWorld TestWorld;
+            TestWorld.Create(true);
+            USpacetimeDBSubsystem* Subsystem = TestWorld.GameInstance->GetSubsystem<USpacetimeDBSubsystem>();
+            Subsystem->Connect(TEXT("localhost:3000"), TEXT("test_db"));
+            Subsystem->Tick(1.0f / 60.0f);
+
+            const uint64 Handle = Subsystem->GetClient().GetConnectionHandle();
+            const FString Json = SpacetimeDBTests::MakeSnapshotJson(Source, SpacetimeDBTests::GetTestPropertyNames());
+            uint64 NextObjectId = 1;
+
+            // One op spawns an object in one frame and destroys it in the next
+            Measure(TEXT("Subsystem.SpawnObjectFromServer"), SlowIterations, [&]()
+            {
+                const uint64 ObjectId = NextObjectId++;
+                FSpacetimeDBMockFFI::SimulateObjectCreated(Handle, ObjectId, TEXT("/Script/SpacetimeDB_UnrealClientTests.SpacetimeDBTestObject"), Json);
+                Subsystem->Tick(1.0f / 60.0f);
+                FSpacetimeDBMockFFI::SimulateObjectDestroyed(Handle, ObjectId);
+                Subsystem->Tick(1.0f / 60.0f);
+            });
+
+            Subsystem->Disconnect();
+            TestWorld.Destroy();
+            FSpacetimeDBMockFFI::Reset();
+        });
+    });
+#endif // SPACETIMEDB_MOCK_FFI
+
+    AfterEach([this]()
+    {
+        Source = nullptr;
+        Target = nullptr;
+    });
+}
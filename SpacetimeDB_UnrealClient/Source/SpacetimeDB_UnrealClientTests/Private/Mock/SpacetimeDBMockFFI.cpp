@@ -0,0 +1,497 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Mock/SpacetimeDBMockFFI.h"
+
+#if SPACETIMEDB_MOCK_FFI
+
+#include "SpacetimeDBFFI.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "Misc/ScopeLock.h"
+#include <cstring>
+
+namespace
+{
+    FCriticalSection GMockLock;
+    TMap<uint64, FSpacetimeDBMockConnection> GConnections;
+    uint64 GNextHandle = 1;
+    uint64 GNextObjectId = 1;
+
+    /** The library keeps one current connection per thread */
+    thread_local uint64 GCurrentHandle = 0;
+
+    FSpacetimeDBMockConnection* Current()
+    {
+        return GConnections.Find(GCurrentHandle);
+    }
+
+    FString ToFString(const std::string& Value)
+    {
+        return FString(UTF8_TO_TCHAR(Value.c_str()));
+    }
+
+    std::unique_ptr<std::string> MakeStdString(const char* Value)
+    {
+        return std::make_unique<std::string>(Value);
+    }
+
+    /** Copies a connection's callback and context out of the lock, so the callback may call back into the mock */
+    template<typename FuncType>
+    bool GetCallback(uint64 Handle, uintptr_t FSpacetimeDBMockConnection::* Member, FuncType*& OutFunc, uintptr_t& OutContext)
+    {
+        FScopeLock Lock(&GMockLock);
+        const FSpacetimeDBMockConnection* Connection = GConnections.Find(Handle);
+        if (!Connection || Connection->*Member == 0)
+        {
+            return false;
+        }
+        OutFunc = reinterpret_cast<FuncType*>(Connection->*Member);
+        OutContext = Connection->CallbackContext;
+        return true;
+    }
+}
+
+bool FSpacetimeDBMockFFI::bDeferConnected = false;
+uint64 FSpacetimeDBMockFFI::ClientId = 1;
+uint32 FSpacetimeDBMockFFI::FFIAbiVersion = SPACETIMEDB_FFI_ABI_VERSION;
+
+void FSpacetimeDBMockFFI::Reset()
+{
+    FScopeLock Lock(&GMockLock);
+    GConnections.Reset();
+    GCurrentHandle = 0;
+    bDeferConnected = false;
+    ClientId = 1;
+    FFIAbiVersion = SPACETIMEDB_FFI_ABI_VERSION;
+}
+
+FSpacetimeDBMockConnection* FSpacetimeDBMockFFI::FindConnection(uint64 Handle)
+{
+    FScopeLock Lock(&GMockLock);
+    return GConnections.Find(Handle);
+}
+
+FSpacetimeDBMockConnection* FSpacetimeDBMockFFI::GetCurrentConnection()
+{
+    FScopeLock Lock(&GMockLock);
+    return Current();
+}
+
+void FSpacetimeDBMockFFI::SimulateConnected(uint64 Handle)
+{
+    void (*Func)(uintptr_t) = nullptr;
+    uintptr_t Context = 0;
+    {
+        FScopeLock Lock(&GMockLock);
+        if (FSpacetimeDBMockConnection* Connection = GConnections.Find(Handle))
+        {
+            Connection->bConnected = true;
+        }
+    }
+    if (GetCallback(Handle, &FSpacetimeDBMockConnection::OnConnected, Func, Context))
+    {
+        Func(Context);
+    }
+}
+
+void FSpacetimeDBMockFFI::SimulateDisconnected(uint64 Handle, const FString& Reason)
+{
+    void (*Func)(uintptr_t, const char*) = nullptr;
+    uintptr_t Context = 0;
+    {
+        FScopeLock Lock(&GMockLock);
+        if (FSpacetimeDBMockConnection* Connection = GConnections.Find(Handle))
+        {
+            Connection->bConnected = false;
+            Connection->SubscribedQueries.Reset();
+        }
+    }
+    if (GetCallback(Handle, &FSpacetimeDBMockConnection::OnDisconnected, Func, Context))
+    {
+        Func(Context, TCHAR_TO_UTF8(*Reason));
+    }
+}
+
+void FSpacetimeDBMockFFI::SimulateObjectCreated(uint64 Handle, uint64 ObjectId, const FString& ClassName, const FString& DataJson)
+{
+    void (*Func)(uintptr_t, uint64, const char*, const char*) = nullptr;
+    uintptr_t Context = 0;
+    if (GetCallback(Handle, &FSpacetimeDBMockConnection::OnObjectCreated, Func, Context))
+    {
+        Func(Context, ObjectId, TCHAR_TO_UTF8(*ClassName), TCHAR_TO_UTF8(*DataJson));
+    }
+}
+
+void FSpacetimeDBMockFFI::SimulateObjectDestroyed(uint64 Handle, uint64 ObjectId)
+{
+    void (*Func)(uintptr_t, uint64) = nullptr;
+    uintptr_t Context = 0;
+    if (GetCallback(Handle, &FSpacetimeDBMockConnection::OnObjectDestroyed, Func, Context))
+    {
+        Func(Context, ObjectId);
+    }
+}
+
+void FSpacetimeDBMockFFI::SimulatePropertyUpdated(uint64 Handle, uint64 ObjectId, const FString& PropertyName, const FString& ValueJson)
+{
+    void (*Func)(uintptr_t, uint64, const char*, const char*) = nullptr;
+    uintptr_t Context = 0;
+    if (GetCallback(Handle, &FSpacetimeDBMockConnection::OnPropertyUpdated, Func, Context))
+    {
+        Func(Context, ObjectId, TCHAR_TO_UTF8(*PropertyName), TCHAR_TO_UTF8(*ValueJson));
+    }
+}
+
+void FSpacetimeDBMockFFI::SimulatePropertyUpdatedBinary(uint64 Handle, uint64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload)
+{
+    void (*Func)(uintptr_t, uint64, const char*, const uint8*, size_t) = nullptr;
+    uintptr_t Context = 0;
+    if (GetCallback(Handle, &FSpacetimeDBMockConnection::OnPropertyUpdatedBinary, Func, Context))
+    {
+        Func(Context, ObjectId, TCHAR_TO_UTF8(*PropertyName), Payload.GetData(), Payload.Num());
+    }
+}
+
+void FSpacetimeDBMockFFI::SimulateSubscriptionApplied(uint64 Handle, const FString& Query)
+{
+    void (*Func)(uintptr_t, const char*) = nullptr;
+    uintptr_t Context = 0;
+    if (GetCallback(Handle, &FSpacetimeDBMockConnection::OnSubscriptionApplied, Func, Context))
+    {
+        Func(Context, TCHAR_TO_UTF8(*Query));
+    }
+}
+
+// rust::String normally comes from the cxx runtime inside stdb_client. Here it owns a
+// NUL-terminated copy: repr holds the buffer, the length and the capacity.
+namespace rust
+{
+inline namespace cxxbridge1
+{
+    namespace
+    {
+        void AssignRepr(std::array<std::uintptr_t, 3>& Repr, const char* Data, std::size_t Len)
+        {
+            char* Buffer = static_cast<char*>(FMemory::Malloc(Len + 1));
+            if (Len > 0)
+            {
+                FMemory::Memcpy(Buffer, Data, Len);
+            }
+            Buffer[Len] = '\0';
+            Repr = { reinterpret_cast<std::uintptr_t>(Buffer), Len, Len + 1 };
+        }
+
+        void FreeRepr(std::array<std::uintptr_t, 3>& Repr)
+        {
+            FMemory::Free(reinterpret_cast<void*>(Repr[0]));
+            Repr = { 0, 0, 0 };
+        }
+    }
+
+    String::String() noexcept { repr = { 0, 0, 0 }; }
+    String::String(const String& Other) noexcept { AssignRepr(repr, Other.data(), Other.size()); }
+    String::String(String&& Other) noexcept : repr(Other.repr) { Other.repr = { 0, 0, 0 }; }
+    String::~String() noexcept { FreeRepr(repr); }
+    String::String(const std::string& Value) { AssignRepr(repr, Value.data(), Value.size()); }
+    String::String(const char* Value) { AssignRepr(repr, Value, std::strlen(Value)); }
+    String::String(const char* Value, std::size_t Len) { AssignRepr(repr, Value, Len); }
+
+    String& String::operator=(const String& Other) & noexcept
+    {
+        if (this != &Other)
+        {
+            FreeRepr(repr);
+            AssignRepr(repr, Other.data(), Other.size());
+        }
+        return *this;
+    }
+
+    String& String::operator=(String&& Other) & noexcept
+    {
+        if (this != &Other)
+        {
+            FreeRepr(repr);
+            repr = Other.repr;
+            Other.repr = { 0, 0, 0 };
+        }
+        return *this;
+    }
+
+    const char* String::data() const noexcept { return repr[0] ? reinterpret_cast<const char*>(repr[0]) : ""; }
+    std::size_t String::size() const noexcept { return repr[1]; }
+    std::size_t String::length() const noexcept { return repr[1]; }
+    bool String::empty() const noexcept { return repr[1] == 0; }
+}
+}
+
+namespace stdb
+{
+namespace ffi
+{
+    bool create_class(::std::string const&, ::std::string const&) noexcept { return true; }
+    bool add_property(::std::string const&, ::std::string const&, ::std::string const&, bool, ::stdb::ffi::ReplicationCondition, bool, ::std::uint32_t) noexcept { return true; }
+    ::std::unique_ptr<::std::string> get_property_definition(::std::string const&, ::std::string const&) noexcept { return MakeStdString("{}"); }
+    ::std::unique_ptr<::std::string> get_property_names_for_class(::std::string const&) noexcept { return MakeStdString("[]"); }
+    ::std::unique_ptr<::std::string> get_registered_class_names() noexcept { return MakeStdString("[]"); }
+    ::std::unique_ptr<::std::string> export_property_definitions_as_json() noexcept { return MakeStdString("{}"); }
+    bool import_property_definitions_from_json(::std::string const&) noexcept { return true; }
+
+    ::std::uint64_t register_object(::std::string const&, ::std::string const&) noexcept
+    {
+        FScopeLock Lock(&GMockLock);
+        return GNextObjectId++;
+    }
+
+    ::std::unique_ptr<::std::string> get_object_class(::std::uint64_t) noexcept { return MakeStdString(""); }
+
+    bool set_property(::std::uint64_t object_id, ::std::string const& property_name, ::std::string const&, bool) noexcept
+    {
+        FScopeLock Lock(&GMockLock);
+        FSpacetimeDBMockConnection* Connection = Current();
+        if (!Connection || !Connection->bConnected)
+        {
+            return false;
+        }
+        Connection->PropertyUpdates.Emplace(object_id, ToFString(property_name));
+        return true;
+    }
+
+    ::std::unique_ptr<::std::string> get_property(::std::uint64_t, ::std::string const&) noexcept { return MakeStdString("null"); }
+
+    bool dispatch_unreliable_rpc(::std::uint64_t, ::std::string const&, ::std::string const&) noexcept { return is_client_connected(); }
+    bool call_server_function(::std::uint64_t, ::std::string const&, ::std::string const&) noexcept { return is_client_connected(); }
+    bool register_client_function(::std::string const&, ::std::size_t) noexcept { return true; }
+
+    bool connect_to_server(::stdb::ffi::ConnectionConfig config, ::stdb::ffi::EventCallbackPointers callbacks) noexcept
+    {
+        uint64 Handle = 0;
+        {
+            FScopeLock Lock(&GMockLock);
+            FSpacetimeDBMockConnection* Connection = Current();
+            if (!Connection)
+            {
+                return false;
+            }
+            Connection->Host = UTF8_TO_TCHAR(config.host.data());
+            Connection->DatabaseName = UTF8_TO_TCHAR(config.db_name.data());
+            Connection->OnConnected = callbacks.on_connected;
+            Connection->OnDisconnected = callbacks.on_disconnected;
+            Connection->OnPropertyUpdated = callbacks.on_property_updated;
+            Connection->OnObjectCreated = callbacks.on_object_created;
+            Connection->OnObjectDestroyed = callbacks.on_object_destroyed;
+            Handle = Connection->Handle;
+        }
+
+        // The library reports the connection from its own thread once the handshake is done
+        if (!FSpacetimeDBMockFFI::bDeferConnected)
+        {
+            FSpacetimeDBMockFFI::SimulateConnected(Handle);
+        }
+        return true;
+    }
+
+    bool disconnect_from_server() noexcept
+    {
+        uint64 Handle = 0;
+        {
+            FScopeLock Lock(&GMockLock);
+            FSpacetimeDBMockConnection* Connection = Current();
+            if (!Connection)
+            {
+                return false;
+            }
+            Handle = Connection->Handle;
+        }
+        FSpacetimeDBMockFFI::SimulateDisconnected(Handle, TEXT("Disconnected by client"));
+        return true;
+    }
+
+    bool is_connected() noexcept { return is_client_connected(); }
+    ::rust::String get_client_identity() noexcept { return ::rust::String("mock-identity"); }
+    ::std::uint64_t get_client_id() noexcept { return FSpacetimeDBMockFFI::ClientId; }
+
+    bool call_reducer(::std::string const& reducer_name, ::std::string const& args_json) noexcept
+    {
+        FScopeLock Lock(&GMockLock);
+        FSpacetimeDBMockConnection* Connection = Current();
+        if (!Connection || !Connection->bConnected)
+        {
+            return false;
+        }
+        Connection->ReducerCalls.Emplace(ToFString(reducer_name), ToFString(args_json));
+        return true;
+    }
+
+    bool subscribe_to_tables(::std::vector<::std::string> const& table_names) noexcept
+    {
+        FScopeLock Lock(&GMockLock);
+        FSpacetimeDBMockConnection* Connection = Current();
+        if (!Connection || !Connection->bConnected)
+        {
+            return false;
+        }
+        for (const ::std::string& Query : table_names)
+        {
+            Connection->SubscribedQueries.AddUnique(ToFString(Query));
+        }
+        return true;
+    }
+
+    bool unsubscribe_from_tables(::std::vector<::std::string> const& table_names) noexcept
+    {
+        FScopeLock Lock(&GMockLock);
+        FSpacetimeDBMockConnection* Connection = Current();
+        if (!Connection || !Connection->bConnected)
+        {
+            return false;
+        }
+        for (const ::std::string& Query : table_names)
+        {
+            Connection->SubscribedQueries.Remove(ToFString(Query));
+        }
+        return true;
+    }
+
+    bool is_client_connected() noexcept
+    {
+        FScopeLock Lock(&GMockLock);
+        const FSpacetimeDBMockConnection* Connection = Current();
+        return Connection && Connection->bConnected;
+    }
+}
+}
+
+extern "C"
+{
+    bool register_prediction_object(ObjectId) { return true; }
+    bool unregister_prediction_object(ObjectId) { return true; }
+    SequenceNumber get_next_prediction_sequence(ObjectId) { return 0; }
+
+    bool send_predicted_transform(ObjectId, SequenceNumber, float, float, float, float, float, float, float, float, float, float, float, float, float, bool)
+    {
+        return stdb::ffi::is_client_connected();
+    }
+
+    SequenceNumber get_last_acked_sequence(ObjectId) { return 0; }
+
+    bool set_property_binary(ObjectId object_id, const char* property_name, const uint8_t*, size_t, bool)
+    {
+        FScopeLock Lock(&GMockLock);
+        FSpacetimeDBMockConnection* Connection = Current();
+        if (!Connection || !Connection->bConnected)
+        {
+            return false;
+        }
+        Connection->PropertyUpdates.Emplace(object_id, UTF8_TO_TCHAR(property_name));
+        return true;
+    }
+
+    bool request_property_resync(ObjectId, const char*) { return stdb::ffi::is_client_connected(); }
+
+    bool set_binary_property_callback(uintptr_t on_property_updated_binary)
+    {
+        FScopeLock Lock(&GMockLock);
+        FSpacetimeDBMockConnection* Connection = Current();
+        if (!Connection)
+        {
+            return false;
+        }
+        Connection->OnPropertyUpdatedBinary = on_property_updated_binary;
+        return true;
+    }
+
+    bool set_object_created_by_class_id_callback(uintptr_t) { return true; }
+    bool set_properties_binary(const uint8_t*, size_t, bool) { return stdb::ffi::is_client_connected(); }
+    bool send_network_packets(const uint8_t*, size_t, uint32_t) { return stdb::ffi::is_client_connected(); }
+
+    uint32_t call_reducers_batched(const uint8_t* data, size_t data_len, uint32_t call_count)
+    {
+        FScopeLock Lock(&GMockLock);
+        FSpacetimeDBMockConnection* Connection = Current();
+        if (!Connection || !Connection->bConnected)
+        {
+            return 0;
+        }
+
+        // Same framing as FSpacetimeDBBinaryWriter::WriteString for both fields
+        FSpacetimeDBBinaryReader Reader(data, static_cast<int32>(data_len));
+        uint32_t Accepted = 0;
+        for (; Accepted < call_count; ++Accepted)
+        {
+            FString Name = Reader.ReadString();
+            FString Args = Reader.ReadString();
+            if (Reader.IsError())
+            {
+                break;
+            }
+            Connection->ReducerCalls.Emplace(MoveTemp(Name), MoveTemp(Args));
+        }
+        ++Connection->NumReducerBatches;
+        return Accepted;
+    }
+
+    bool set_property_name_callback(uintptr_t) { return true; }
+    bool set_binary_property_by_id_callback(uintptr_t) { return true; }
+    bool set_properties_binary_by_id(const uint8_t*, size_t, bool) { return stdb::ffi::is_client_connected(); }
+
+    bool set_subscription_applied_callback(uintptr_t on_subscription_applied)
+    {
+        FScopeLock Lock(&GMockLock);
+        FSpacetimeDBMockConnection* Connection = Current();
+        if (!Connection)
+        {
+            return false;
+        }
+        Connection->OnSubscriptionApplied = on_subscription_applied;
+        return true;
+    }
+
+    bool send_predicted_transforms_quantized(const uint8_t* data, size_t data_len, uint32_t)
+    {
+        FScopeLock Lock(&GMockLock);
+        FSpacetimeDBMockConnection* Connection = Current();
+        if (!Connection || !Connection->bConnected)
+        {
+            return false;
+        }
+        Connection->PredictedTransformBatches.Emplace(data, static_cast<int32>(data_len));
+        return true;
+    }
+
+    bool call_server_function_binary(ObjectId, uint32_t, const uint8_t*, size_t) { return stdb::ffi::is_client_connected(); }
+    bool register_client_function_id(uint32_t, const char*) { return true; }
+    bool set_client_rpc_binary_callback(uintptr_t) { return true; }
+
+    uint64_t create_connection(uintptr_t callback_context)
+    {
+        FScopeLock Lock(&GMockLock);
+        const uint64 Handle = GNextHandle++;
+        FSpacetimeDBMockConnection& Connection = GConnections.Add(Handle);
+        Connection.Handle = Handle;
+        Connection.CallbackContext = callback_context;
+        return Handle;
+    }
+
+    void destroy_connection(uint64_t connection)
+    {
+        FScopeLock Lock(&GMockLock);
+        GConnections.Remove(connection);
+        if (GCurrentHandle == connection)
+        {
+            GCurrentHandle = 0;
+        }
+    }
+
+    bool select_connection(uint64_t connection)
+    {
+        FScopeLock Lock(&GMockLock);
+        GCurrentHandle = GConnections.Contains(connection) ? connection : 0;
+        return GCurrentHandle != 0;
+    }
+
+    uint32_t get_ffi_abi_version()
+    {
+        return FSpacetimeDBMockFFI::FFIAbiVersion;
+    }
+}
+
+#endif // SPACETIMEDB_MOCK_FFI
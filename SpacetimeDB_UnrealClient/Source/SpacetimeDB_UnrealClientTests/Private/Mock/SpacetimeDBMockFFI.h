@@ -0,0 +1,85 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if SPACETIMEDB_MOCK_FFI
+
+/** What the mock client library knows about one connection handle */
+struct FSpacetimeDBMockConnection
+{
+    uint64 Handle = 0;
+
+    /** The FSpacetimeDBClient the callbacks are called for */
+    uintptr_t CallbackContext = 0;
+
+    bool bConnected = false;
+    FString Host;
+    FString DatabaseName;
+
+    /** Callbacks registered by connect_to_server and the set_*_callback functions; 0 when unset */
+    uintptr_t OnConnected = 0;
+    uintptr_t OnDisconnected = 0;
+    uintptr_t OnPropertyUpdated = 0;
+    uintptr_t OnObjectCreated = 0;
+    uintptr_t OnObjectDestroyed = 0;
+    uintptr_t OnPropertyUpdatedBinary = 0;
+    uintptr_t OnSubscriptionApplied = 0;
+
+    /** Every reducer call, single or batched, as name and JSON arguments in submission order */
+    TArray<TPair<FString, FString>> ReducerCalls;
+
+    /** Number of call_reducers_batched messages */
+    int32 NumReducerBatches = 0;
+
+    /** Queries currently subscribed */
+    TArray<FString> SubscribedQueries;
+
+    /** Properties sent with set_property, as object ID and property name */
+    TArray<TPair<uint64, FString>> PropertyUpdates;
+
+    /** Payloads of send_predicted_transforms_quantized */
+    TArray<TArray<uint8>> PredictedTransformBatches;
+};
+
+/**
+ * Stand-in for the stdb_client library, so the client and subsystem can be driven without a
+ * server. The FFI functions record what they are called with on the thread's current
+ * connection, and the Simulate functions call the registered callbacks the way the library's
+ * network thread would. Connecting succeeds at once and reports on_connected unless
+ * bDeferConnected is set.
+ *
+ * Only compiled with SPACETIMEDB_MOCK_FFI; see SpacetimeDB_UnrealClientTests.Build.cs.
+ */
+class FSpacetimeDBMockFFI
+{
+public:
+    /** Drops every connection and restores the defaults */
+    static void Reset();
+
+    /** The connection of a handle; null if it was destroyed or never created */
+    static FSpacetimeDBMockConnection* FindConnection(uint64 Handle);
+
+    /** The connection selected on the calling thread */
+    static FSpacetimeDBMockConnection* GetCurrentConnection();
+
+    static void SimulateConnected(uint64 Handle);
+    static void SimulateDisconnected(uint64 Handle, const FString& Reason);
+    static void SimulateObjectCreated(uint64 Handle, uint64 ObjectId, const FString& ClassName, const FString& DataJson);
+    static void SimulateObjectDestroyed(uint64 Handle, uint64 ObjectId);
+    static void SimulatePropertyUpdated(uint64 Handle, uint64 ObjectId, const FString& PropertyName, const FString& ValueJson);
+    static void SimulatePropertyUpdatedBinary(uint64 Handle, uint64 ObjectId, const FString& PropertyName, const TArray<uint8>& Payload);
+    static void SimulateSubscriptionApplied(uint64 Handle, const FString& Query);
+
+    /** Whether connect_to_server leaves on_connected to SimulateConnected */
+    static bool bDeferConnected;
+
+    /** Value returned by get_client_id */
+    static uint64 ClientId;
+
+    /** Value returned by get_ffi_abi_version; SPACETIMEDB_FFI_ABI_VERSION after Reset */
+    static uint32 FFIAbiVersion;
+};
+
+#endif // SPACETIMEDB_MOCK_FFI
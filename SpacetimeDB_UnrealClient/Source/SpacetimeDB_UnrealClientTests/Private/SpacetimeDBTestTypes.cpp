@@ -0,0 +1,131 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBTestTypes.h"
+#include "Net/UnrealNetwork.h"
+#include "SpacetimeDBPropertyHelper.h"
+
+void USpacetimeDBTestObject::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+    DOREPLIFETIME(USpacetimeDBTestObject, Health);
+}
+
+void USpacetimeDBTestObject::FillWithSampleValues()
+{
+    bFlag = true;
+    ByteValue = 200;
+    IntValue = -123456;
+    Int64Value = 1234567890123LL;
+    FloatValue = 3.5f;
+    DoubleValue = -2.25;
+    StringValue = TEXT("Hello \"SpacetimeDB\" \u00e9");
+    NameValue = TEXT("SampleName");
+    TextValue = FText::FromString(TEXT("Sample text"));
+    EnumValue = ESpacetimeDBTestEnum::Third;
+
+    // Values that survive the 32-bit floats of the math struct encodings exactly
+    VectorValue = FVector(1.5, -2.0, 300.25);
+    RotatorValue = FRotator(10.0, 20.0, 30.0);
+    QuatValue = FQuat(0.0, 0.0, 0.6, 0.8);
+    TransformValue = FTransform(FQuat(0.0, 0.6, 0.0, 0.8), FVector(4.0, 5.0, 6.0), FVector(2.0, 2.0, 2.0));
+    ColorValue = FColor(10, 20, 30, 255);
+
+    StructValue.Count = 7;
+    StructValue.Label = TEXT("Struct");
+    StructValue.Offset = FVector(0.5, 0.25, 0.125);
+
+    IntArray = { 1, 2, 3, 5, 8 };
+
+    FSpacetimeDBTestStruct& First = StructArray.AddDefaulted_GetRef();
+    First.Count = 1;
+    First.Label = TEXT("A");
+    FSpacetimeDBTestStruct& Second = StructArray.AddDefaulted_GetRef();
+    Second.Count = 2;
+    Second.Label = TEXT("B");
+
+    StringToIntMap.Add(TEXT("One"), 1);
+    StringToIntMap.Add(TEXT("Two"), 2);
+    StringToIntMap.Add(TEXT("Three"), 3);
+
+    IntSet = { 10, 20, 30 };
+    Health = 42;
+}
+
+namespace SpacetimeDBTests
+{
+    TConstArrayView<const TCHAR*> GetTestPropertyNames()
+    {
+        static const TCHAR* const Names[] =
+        {
+            TEXT("bFlag"),
+            TEXT("ByteValue"),
+            TEXT("IntValue"),
+            TEXT("Int64Value"),
+            TEXT("FloatValue"),
+            TEXT("DoubleValue"),
+            TEXT("StringValue"),
+            TEXT("NameValue"),
+            TEXT("TextValue"),
+            TEXT("EnumValue"),
+            TEXT("VectorValue"),
+            TEXT("RotatorValue"),
+            TEXT("QuatValue"),
+            TEXT("TransformValue"),
+            TEXT("ColorValue"),
+            TEXT("StructValue"),
+            TEXT("IntArray"),
+            TEXT("StructArray"),
+            TEXT("StringToIntMap"),
+            TEXT("Health"),
+        };
+        return MakeArrayView(Names);
+    }
+
+    FProperty* FindTestProperty(const TCHAR* PropertyName)
+    {
+        return USpacetimeDBTestObject::StaticClass()->FindPropertyByName(PropertyName);
+    }
+
+    bool IsPropertyIdentical(const TCHAR* PropertyName, const UObject* A, const UObject* B)
+    {
+        const FProperty* Property = FindTestProperty(PropertyName);
+        if (!Property)
+        {
+            return false;
+        }
+
+        // Texts decoded from a string carry no localization history, so only their strings can match
+        if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+        {
+            return TextProperty->GetPropertyValue_InContainer(A).ToString() == TextProperty->GetPropertyValue_InContainer(B).ToString();
+        }
+        return Property->Identical(Property->ContainerPtrToValuePtr<void>(A), Property->ContainerPtrToValuePtr<void>(B));
+    }
+
+    FString MakeSnapshotJson(UObject* Source, TConstArrayView<const TCHAR*> PropertyNames, const FTransform* Transform)
+    {
+        FString Json = TEXT("{");
+        if (Transform)
+        {
+            const FVector Location = Transform->GetLocation();
+            const FRotator Rotation = Transform->Rotator();
+            const FVector Scale = Transform->GetScale3D();
+            Json += FString::Printf(TEXT("\"transform\":{\"location\":{\"x\":%.17g,\"y\":%.17g,\"z\":%.17g},")
+                TEXT("\"rotation\":{\"pitch\":%.17g,\"yaw\":%.17g,\"roll\":%.17g},")
+                TEXT("\"scale\":{\"x\":%.17g,\"y\":%.17g,\"z\":%.17g}},"),
+                Location.X, Location.Y, Location.Z, Rotation.Pitch, Rotation.Yaw, Rotation.Roll, Scale.X, Scale.Y, Scale.Z);
+        }
+
+        Json += TEXT("\"properties\":{");
+        for (int32 Index = 0; Index < PropertyNames.Num(); ++Index)
+        {
+            if (Index > 0)
+            {
+                Json += TEXT(",");
+            }
+            Json += FString::Printf(TEXT("\"%s\":%s"), PropertyNames[Index], *FSpacetimeDBPropertyHelper::SerializePropertyToJson(Source, PropertyNames[Index]));
+        }
+        Json += TEXT("}}");
+        return Json;
+    }
+}
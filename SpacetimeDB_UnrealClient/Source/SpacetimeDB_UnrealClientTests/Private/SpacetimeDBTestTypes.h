@@ -0,0 +1,134 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "SpacetimeDBTestTypes.generated.h"
+
+UENUM()
+enum class ESpacetimeDBTestEnum : uint8
+{
+    First,
+    Second,
+    Third
+};
+
+/** A custom struct, encoded field by field */
+USTRUCT()
+struct FSpacetimeDBTestStruct
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    int32 Count = 0;
+
+    UPROPERTY()
+    FString Label;
+
+    UPROPERTY()
+    FVector Offset = FVector::ZeroVector;
+};
+
+/** One property of every type the client replicates, for round trips through each encoding */
+UCLASS()
+class USpacetimeDBTestObject : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    bool bFlag = false;
+
+    UPROPERTY()
+    uint8 ByteValue = 0;
+
+    UPROPERTY()
+    int32 IntValue = 0;
+
+    UPROPERTY()
+    int64 Int64Value = 0;
+
+    UPROPERTY()
+    float FloatValue = 0.0f;
+
+    UPROPERTY()
+    double DoubleValue = 0.0;
+
+    UPROPERTY()
+    FString StringValue;
+
+    UPROPERTY()
+    FName NameValue;
+
+    UPROPERTY()
+    FText TextValue;
+
+    UPROPERTY()
+    ESpacetimeDBTestEnum EnumValue = ESpacetimeDBTestEnum::First;
+
+    UPROPERTY()
+    FVector VectorValue = FVector::ZeroVector;
+
+    UPROPERTY()
+    FRotator RotatorValue = FRotator::ZeroRotator;
+
+    UPROPERTY()
+    FQuat QuatValue = FQuat::Identity;
+
+    UPROPERTY()
+    FTransform TransformValue = FTransform::Identity;
+
+    UPROPERTY()
+    FColor ColorValue = FColor::Black;
+
+    UPROPERTY()
+    FSpacetimeDBTestStruct StructValue;
+
+    UPROPERTY()
+    TArray<int32> IntArray;
+
+    UPROPERTY()
+    TArray<FSpacetimeDBTestStruct> StructArray;
+
+    UPROPERTY()
+    TMap<FString, int32> StringToIntMap;
+
+    UPROPERTY()
+    TSet<int32> IntSet;
+
+    UPROPERTY(ReplicatedUsing = OnRep_Health)
+    int32 Health = 100;
+
+    /** Number of OnRep_Health calls */
+    int32 NumHealthNotifies = 0;
+
+    UFUNCTION()
+    void OnRep_Health() { ++NumHealthNotifies; }
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    /** Gives every property a value different from its default */
+    void FillWithSampleValues();
+};
+
+namespace SpacetimeDBTests
+{
+    /** Names of the USpacetimeDBTestObject properties every encoding supports; IntSet is binary only */
+    TConstArrayView<const TCHAR*> GetTestPropertyNames();
+
+    /** Finds a property of USpacetimeDBTestObject by name */
+    FProperty* FindTestProperty(const TCHAR* PropertyName);
+
+    /** Whether a property holds the same value on two objects */
+    bool IsPropertyIdentical(const TCHAR* PropertyName, const UObject* A, const UObject* B);
+
+    /**
+     * Builds an object-creation snapshot the way the server sends it.
+     *
+     * @param Source The object whose properties are written
+     * @param PropertyNames The properties to include
+     * @param Transform The spawn transform; the snapshot has none if null
+     */
+    FString MakeSnapshotJson(UObject* Source, TConstArrayView<const TCHAR*> PropertyNames, const FTransform* Transform = nullptr);
+}
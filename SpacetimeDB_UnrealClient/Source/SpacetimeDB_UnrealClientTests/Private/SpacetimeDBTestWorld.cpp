@@ -0,0 +1,73 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "SpacetimeDBTestWorld.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+
+void FSpacetimeDBTestWorld::Create(bool bWithGameInstance)
+{
+    check(GEngine && !World);
+
+    if (bWithGameInstance)
+    {
+        // Kept alive across garbage collections between latent steps until Destroy
+        GameInstance = NewObject<UGameInstance>(GEngine);
+        GameInstance->AddToRoot();
+        GameInstance->InitializeStandalone();
+        World = GameInstance->GetWorld();
+    }
+    else
+    {
+        World = UWorld::CreateWorld(EWorldType::Game, false);
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+    }
+
+    // There is no game mode to start play, so begin it the way the world settings would
+    World->InitializeActorsForPlay(FURL());
+    World->GetWorldSettings()->NotifyBeginPlay();
+}
+
+void FSpacetimeDBTestWorld::Destroy()
+{
+    if (GameInstance)
+    {
+        GameInstance->Shutdown();
+    }
+
+    if (World)
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+
+    if (GameInstance)
+    {
+        GameInstance->RemoveFromRoot();
+    }
+
+    World = nullptr;
+    GameInstance = nullptr;
+    PlayerController = nullptr;
+}
+
+ACharacter* FSpacetimeDBTestWorld::SpawnLocalCharacter(const FTransform& Transform)
+{
+    check(World);
+
+    // A standalone world has no remote connections, so every player controller is local
+    if (!PlayerController)
+    {
+        PlayerController = World->SpawnActor<APlayerController>();
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    ACharacter* Character = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), Transform, SpawnParams);
+    PlayerController->Possess(Character);
+    return Character;
+}
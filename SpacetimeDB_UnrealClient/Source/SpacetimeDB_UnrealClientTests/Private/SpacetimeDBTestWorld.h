@@ -0,0 +1,34 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ACharacter;
+class APlayerController;
+class UGameInstance;
+class UWorld;
+
+/**
+ * A standalone game world for specs that need actors, world subsystems or a game instance.
+ * Create it in BeforeEach and destroy it in AfterEach; nothing outlives Destroy.
+ */
+struct FSpacetimeDBTestWorld
+{
+    /**
+     * Creates a game world that has begun play.
+     *
+     * @param bWithGameInstance Whether to create it through a standalone game instance, for the game instance subsystems
+     */
+    void Create(bool bWithGameInstance = false);
+
+    /** Shuts the game instance down and destroys the world */
+    void Destroy();
+
+    /** Spawns a character possessed by a local player controller, so it is locally controlled */
+    ACharacter* SpawnLocalCharacter(const FTransform& Transform);
+
+    UWorld* World = nullptr;
+    UGameInstance* GameInstance = nullptr;
+    APlayerController* PlayerController = nullptr;
+};
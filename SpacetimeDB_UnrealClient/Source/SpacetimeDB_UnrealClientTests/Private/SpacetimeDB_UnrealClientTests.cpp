@@ -0,0 +1,6 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+// Automation specs and benchmarks for the SpacetimeDB_UnrealClient module; nothing to start up
+IMPLEMENT_MODULE(FDefaultModuleImpl, SpacetimeDB_UnrealClientTests)
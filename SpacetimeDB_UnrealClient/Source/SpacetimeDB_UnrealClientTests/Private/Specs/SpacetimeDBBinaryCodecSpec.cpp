@@ -0,0 +1,177 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "SpacetimeDBPropertyDescriptorCache.h"
+#include "SpacetimeDBTestTypes.h"
+
+BEGIN_DEFINE_SPEC(FSpacetimeDBBinaryCodecSpec, "SpacetimeDB.BinaryCodec", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    USpacetimeDBTestObject* Source = nullptr;
+    USpacetimeDBTestObject* Target = nullptr;
+
+    /** Encodes a property of Source */
+    TArray<uint8> Encode(const TCHAR* PropertyName) const
+    {
+        const FProperty* Property = SpacetimeDBTests::FindTestProperty(PropertyName);
+        TArray<uint8> Bytes;
+        FSpacetimeDBBinaryCodec::EncodeProperty(Property, Property->ContainerPtrToValuePtr<void>(Source), Bytes);
+        return Bytes;
+    }
+
+    /** Encodes the change of a Source property since Base, then applies it to Target */
+    ESpacetimeDBDeltaResult SendDelta(const TCHAR* PropertyName, const TArray<uint8>& Base)
+    {
+        const FProperty* Property = SpacetimeDBTests::FindTestProperty(PropertyName);
+        TArray<uint8> Delta;
+        if (!FSpacetimeDBBinaryCodec::EncodeDelta(Property, Base.GetData(), Base.Num(), Property->ContainerPtrToValuePtr<void>(Source), Delta))
+        {
+            AddError(FString::Printf(TEXT("EncodeDelta failed for %s"), PropertyName));
+            return ESpacetimeDBDeltaResult::Malformed;
+        }
+        TestTrue(TEXT("Encoded as a delta"), FSpacetimeDBBinaryCodec::IsDelta(Delta.GetData(), Delta.Num()));
+
+        const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(USpacetimeDBTestObject::StaticClass(), FName(PropertyName));
+        return FSpacetimeDBBinaryCodec::ApplyDelta(*Descriptor, Target, Delta.GetData(), Delta.Num());
+    }
+END_DEFINE_SPEC(FSpacetimeDBBinaryCodecSpec)
+
+void FSpacetimeDBBinaryCodecSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Source = NewObject<USpacetimeDBTestObject>();
+        Source->FillWithSampleValues();
+        Target = NewObject<USpacetimeDBTestObject>();
+    });
+
+    Describe("EncodeProperty", [this]()
+    {
+        It("should decode every supported type to the value it encoded", [this]()
+        {
+            TArray<const TCHAR*> Names(SpacetimeDBTests::GetTestPropertyNames());
+            Names.Add(TEXT("IntSet"));
+
+            for (const TCHAR* Name : Names)
+            {
+                const TArray<uint8> Bytes = Encode(Name);
+                TestTrue(FString::Printf(TEXT("%s encoded"), Name), Bytes.Num() > 0);
+
+                const FProperty* Property = SpacetimeDBTests::FindTestProperty(Name);
+                TestTrue(FString::Printf(TEXT("%s decoded"), Name),
+                    FSpacetimeDBBinaryCodec::DecodeProperty(Property, Property->ContainerPtrToValuePtr<void>(Target), Bytes.GetData(), Bytes.Num()));
+                TestTrue(FString::Printf(TEXT("%s round trips"), Name), SpacetimeDBTests::IsPropertyIdentical(Name, Source, Target));
+            }
+        });
+
+        It("should tag every value with its property type", [this]()
+        {
+            const TArray<uint8> Bytes = Encode(TEXT("IntValue"));
+            TestEqual(TEXT("Tag"), Bytes[0], static_cast<uint8>(FSpacetimeDBBinaryCodec::GetPropertyTypeTag(SpacetimeDBTests::FindTestProperty(TEXT("IntValue")))));
+            TestEqual(TEXT("Size"), Bytes.Num(), 1 + static_cast<int32>(sizeof(int32)));
+        });
+
+        It("should reject truncated payloads", [this]()
+        {
+            TArray<uint8> Bytes = Encode(TEXT("StringValue"));
+            Bytes.SetNum(Bytes.Num() - 1);
+
+            const FProperty* Property = SpacetimeDBTests::FindTestProperty(TEXT("StringValue"));
+            TestFalse(TEXT("Decoded"), FSpacetimeDBBinaryCodec::DecodeProperty(Property, Property->ContainerPtrToValuePtr<void>(Target), Bytes.GetData(), Bytes.Num()));
+        });
+    });
+
+    Describe("EncodeDelta", [this]()
+    {
+        BeforeEach([this]()
+        {
+            Target->FillWithSampleValues();
+        });
+
+        It("should only support structs, arrays and maps", [this]()
+        {
+            TestTrue(TEXT("Struct"), FSpacetimeDBBinaryCodec::SupportsDelta(SpacetimeDBTests::FindTestProperty(TEXT("StructValue"))));
+            TestTrue(TEXT("Array"), FSpacetimeDBBinaryCodec::SupportsDelta(SpacetimeDBTests::FindTestProperty(TEXT("IntArray"))));
+            TestTrue(TEXT("Map"), FSpacetimeDBBinaryCodec::SupportsDelta(SpacetimeDBTests::FindTestProperty(TEXT("StringToIntMap"))));
+            TestFalse(TEXT("Scalar"), FSpacetimeDBBinaryCodec::SupportsDelta(SpacetimeDBTests::FindTestProperty(TEXT("IntValue"))));
+            TestFalse(TEXT("String"), FSpacetimeDBBinaryCodec::SupportsDelta(SpacetimeDBTests::FindTestProperty(TEXT("StringValue"))));
+        });
+
+        It("should apply changed struct fields", [this]()
+        {
+            const TArray<uint8> Base = Encode(TEXT("StructValue"));
+            Source->StructValue.Count = 99;
+            Source->StructValue.Label = TEXT("Changed");
+
+            TestTrue(TEXT("Result"), SendDelta(TEXT("StructValue"), Base) == ESpacetimeDBDeltaResult::Applied);
+            TestTrue(TEXT("Struct matches"), SpacetimeDBTests::IsPropertyIdentical(TEXT("StructValue"), Source, Target));
+        });
+
+        It("should apply updated, inserted and removed array elements", [this]()
+        {
+            const TArray<uint8> Base = Encode(TEXT("IntArray"));
+            Source->IntArray = { 1, 2, 4, 5, 8, 13, 21 };
+
+            TestTrue(TEXT("Grown"), SendDelta(TEXT("IntArray"), Base) == ESpacetimeDBDeltaResult::Applied);
+            TestEqual(TEXT("Grown array"), Target->IntArray, Source->IntArray);
+
+            const TArray<uint8> GrownBase = Encode(TEXT("IntArray"));
+            Source->IntArray = { 1, 2 };
+
+            TestTrue(TEXT("Shrunk"), SendDelta(TEXT("IntArray"), GrownBase) == ESpacetimeDBDeltaResult::Applied);
+            TestEqual(TEXT("Shrunk array"), Target->IntArray, Source->IntArray);
+        });
+
+        It("should apply updated, inserted and removed map pairs", [this]()
+        {
+            const TArray<uint8> Base = Encode(TEXT("StringToIntMap"));
+            Source->StringToIntMap.Remove(TEXT("One"));
+            Source->StringToIntMap.Add(TEXT("Two"), 22);
+            Source->StringToIntMap.Add(TEXT("Four"), 4);
+
+            TestTrue(TEXT("Result"), SendDelta(TEXT("StringToIntMap"), Base) == ESpacetimeDBDeltaResult::Applied);
+            TestTrue(TEXT("Map matches"), SpacetimeDBTests::IsPropertyIdentical(TEXT("StringToIntMap"), Source, Target));
+        });
+
+        It("should apply a map delta to an equal map built in another order", [this]()
+        {
+            const TArray<uint8> Base = Encode(TEXT("StringToIntMap"));
+            Target->StringToIntMap.Empty();
+            Target->StringToIntMap.Add(TEXT("Three"), 3);
+            Target->StringToIntMap.Add(TEXT("Two"), 2);
+            Target->StringToIntMap.Add(TEXT("One"), 1);
+            Source->StringToIntMap.Add(TEXT("Two"), 22);
+
+            TestTrue(TEXT("Result"), SendDelta(TEXT("StringToIntMap"), Base) == ESpacetimeDBDeltaResult::Applied);
+            TestTrue(TEXT("Map matches"), SpacetimeDBTests::IsPropertyIdentical(TEXT("StringToIntMap"), Source, Target));
+        });
+
+        It("should leave a value that isn't the delta's base untouched", [this]()
+        {
+            const TArray<uint8> Base = Encode(TEXT("IntArray"));
+            Source->IntArray.Add(34);
+            Target->IntArray = { 7 };
+
+            TestTrue(TEXT("Result"), SendDelta(TEXT("IntArray"), Base) == ESpacetimeDBDeltaResult::BaseMismatch);
+            TestEqual(TEXT("Target array"), Target->IntArray, TArray<int32>({ 7 }));
+        });
+
+        It("should reject a delta for another property type", [this]()
+        {
+            const TArray<uint8> Base = Encode(TEXT("IntArray"));
+            Source->IntArray.Add(34);
+
+            const FProperty* Property = SpacetimeDBTests::FindTestProperty(TEXT("IntArray"));
+            TArray<uint8> Delta;
+            FSpacetimeDBBinaryCodec::EncodeDelta(Property, Base.GetData(), Base.Num(), Property->ContainerPtrToValuePtr<void>(Source), Delta);
+
+            const FSpacetimeDBPropertyDescriptor* Descriptor = FSpacetimeDBPropertyDescriptorCache::FindProperty(USpacetimeDBTestObject::StaticClass(), TEXT("StringToIntMap"));
+            TestTrue(TEXT("Result"), FSpacetimeDBBinaryCodec::ApplyDelta(*Descriptor, Target, Delta.GetData(), Delta.Num()) == ESpacetimeDBDeltaResult::Malformed);
+        });
+    });
+
+    AfterEach([this]()
+    {
+        Source = nullptr;
+        Target = nullptr;
+    });
+}
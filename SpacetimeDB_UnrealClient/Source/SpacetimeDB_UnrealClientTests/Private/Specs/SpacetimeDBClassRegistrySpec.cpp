@@ -0,0 +1,86 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "SpacetimeDBClassRegistry.h"
+#include "SpacetimeDBTestTypes.h"
+
+namespace
+{
+    const TCHAR* const TestObjectPath = TEXT("/Script/SpacetimeDB_UnrealClientTests.SpacetimeDBTestObject");
+
+    /** Project class IDs the specs register; the registry has no way to forget them, so they sit far from real ones */
+    constexpr int32 DirectTestClassId = 65000;
+    constexpr int32 SparseTestClassId = 1 << 24;
+}
+
+BEGIN_DEFINE_SPEC(FSpacetimeDBClassRegistrySpec, "SpacetimeDB.ClassRegistry", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FSpacetimeDBClassRegistrySpec)
+
+void FSpacetimeDBClassRegistrySpec::Define()
+{
+    Describe("FindClassById", [this]()
+    {
+        It("should resolve every core class ID", [this]()
+        {
+            for (const FSpacetimeDBCoreClassId& Core : FSpacetimeDBClassRegistry::GetCoreClassIds())
+            {
+                const UClass* Class = FSpacetimeDBClassRegistry::FindClassById(Core.ClassId);
+                TestNotNull(FString::Printf(TEXT("Class %d"), Core.ClassId), Class);
+                if (Class)
+                {
+                    TestEqual(FString::Printf(TEXT("Path of class %d"), Core.ClassId), Class->GetPathName(), FString(Core.ClassPath));
+                }
+            }
+        });
+
+        It("should resolve IDs below and above the direct range", [this]()
+        {
+            FSpacetimeDBClassRegistry::RegisterClassId(DirectTestClassId, TestObjectPath);
+            FSpacetimeDBClassRegistry::RegisterClassId(SparseTestClassId, TestObjectPath);
+
+            TestEqual(TEXT("Direct ID"), FSpacetimeDBClassRegistry::FindClassById(DirectTestClassId), USpacetimeDBTestObject::StaticClass());
+            TestEqual(TEXT("Sparse ID"), FSpacetimeDBClassRegistry::FindClassById(SparseTestClassId), USpacetimeDBTestObject::StaticClass());
+        });
+
+        It("should return null for unregistered IDs", [this]()
+        {
+            TestNull(TEXT("Unused direct ID"), FSpacetimeDBClassRegistry::FindClassById(DirectTestClassId + 1));
+            TestNull(TEXT("Unused sparse ID"), FSpacetimeDBClassRegistry::FindClassById(SparseTestClassId + 1));
+            TestNull(TEXT("Negative ID"), FSpacetimeDBClassRegistry::FindClassById(-1));
+        });
+
+        It("should ignore invalid registrations", [this]()
+        {
+            AddExpectedError(TEXT("Ignoring invalid class registration"), EAutomationExpectedErrorFlags::Contains, 2);
+            FSpacetimeDBClassRegistry::RegisterClassId(0, TestObjectPath);
+            FSpacetimeDBClassRegistry::RegisterClassId(DirectTestClassId + 2, FString());
+
+            TestNull(TEXT("Empty path"), FSpacetimeDBClassRegistry::FindClassById(DirectTestClassId + 2));
+        });
+    });
+
+    Describe("FindClassByName", [this]()
+    {
+        It("should resolve a class path", [this]()
+        {
+            TestEqual(TEXT("Test object"), FSpacetimeDBClassRegistry::FindClassByName(TestObjectPath), USpacetimeDBTestObject::StaticClass());
+            TestEqual(TEXT("Cached"), FSpacetimeDBClassRegistry::FindClassByName(TestObjectPath), USpacetimeDBTestObject::StaticClass());
+        });
+
+        It("should keep returning null for an unknown class until the misses are cleared", [this]()
+        {
+            const FString Unknown = TEXT("/Script/SpacetimeDB_UnrealClientTests.NoSuchClass");
+            TestNull(TEXT("First lookup"), FSpacetimeDBClassRegistry::FindClassByName(Unknown));
+            TestNull(TEXT("Cached miss"), FSpacetimeDBClassRegistry::FindClassByName(Unknown));
+
+            FSpacetimeDBClassRegistry::ClearUnknownClasses();
+            TestNull(TEXT("Probed again"), FSpacetimeDBClassRegistry::FindClassByName(Unknown));
+            TestEqual(TEXT("Known classes survive"), FSpacetimeDBClassRegistry::FindClassByName(TestObjectPath), USpacetimeDBTestObject::StaticClass());
+        });
+
+        It("should return null for an empty name", [this]()
+        {
+            TestNull(TEXT("Empty"), FSpacetimeDBClassRegistry::FindClassByName(FString()));
+        });
+    });
+}
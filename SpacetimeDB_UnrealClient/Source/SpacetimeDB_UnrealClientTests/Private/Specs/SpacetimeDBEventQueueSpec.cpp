@@ -0,0 +1,178 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Async/Async.h"
+#include "SpacetimeDBEventQueue.h"
+
+namespace
+{
+    bool EnqueueId(FSpacetimeDBEventQueue& Queue, uint64 Id, uint64 Producer = 0)
+    {
+        FSpacetimeDBInboundEvent Event;
+        Event.Type = ESpacetimeDBInboundEventType::ObjectDestroyed;
+        Event.Id = Id;
+        Event.SecondaryId = Producer;
+        return Queue.Enqueue(Event);
+    }
+}
+
+BEGIN_DEFINE_SPEC(FSpacetimeDBEventQueueSpec, "SpacetimeDB.EventQueue", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FSpacetimeDBEventQueueSpec)
+
+void FSpacetimeDBEventQueueSpec::Define()
+{
+    It("should round the capacity up to a power of two", [this]()
+    {
+        FSpacetimeDBEventQueue Queue(100);
+        TestEqual(TEXT("Capacity"), Queue.GetCapacity(), 128);
+    });
+
+    It("should dequeue events in the order they were enqueued", [this]()
+    {
+        FSpacetimeDBEventQueue Queue(8);
+        for (uint64 Id = 1; Id <= 5; ++Id)
+        {
+            TestTrue(TEXT("Enqueued"), EnqueueId(Queue, Id));
+        }
+        TestEqual(TEXT("Num"), Queue.Num(), 5);
+
+        FSpacetimeDBInboundEvent Event;
+        for (uint64 Id = 1; Id <= 5; ++Id)
+        {
+            TestTrue(TEXT("Dequeued"), Queue.Dequeue(Event));
+            TestEqual(TEXT("Id"), Event.Id, Id);
+        }
+        TestFalse(TEXT("Empty"), Queue.Dequeue(Event));
+    });
+
+    It("should refuse events once full and accept them again after a dequeue", [this]()
+    {
+        FSpacetimeDBEventQueue Queue(4);
+        for (uint64 Id = 0; Id < 4; ++Id)
+        {
+            TestTrue(TEXT("Enqueued"), EnqueueId(Queue, Id));
+        }
+        TestFalse(TEXT("Full"), EnqueueId(Queue, 4));
+        TestEqual(TEXT("High water mark"), Queue.GetHighWaterMark(), 4);
+
+        FSpacetimeDBInboundEvent Event;
+        TestTrue(TEXT("Dequeued"), Queue.Dequeue(Event));
+        TestTrue(TEXT("Enqueued after dequeue"), EnqueueId(Queue, 4));
+    });
+
+    It("should keep the order across many laps of the ring", [this]()
+    {
+        FSpacetimeDBEventQueue Queue(4);
+        FSpacetimeDBInboundEvent Event;
+        uint64 Next = 0;
+        for (uint64 Id = 0; Id < 1000; ++Id)
+        {
+            EnqueueId(Queue, Id);
+            if (Id % 3 == 2)
+            {
+                while (Queue.Dequeue(Event))
+                {
+                    TestEqual(TEXT("Id"), Event.Id, Next++);
+                }
+            }
+        }
+        while (Queue.Dequeue(Event))
+        {
+            TestEqual(TEXT("Id"), Event.Id, Next++);
+        }
+        TestEqual(TEXT("Dequeued"), Next, static_cast<uint64>(1000));
+    });
+
+    It("should fill cells in place with EnqueueWith", [this]()
+    {
+        FSpacetimeDBEventQueue Queue(4);
+        TestTrue(TEXT("Enqueued"), Queue.EnqueueWith([](FSpacetimeDBInboundEvent& Event)
+        {
+            Event.Type = ESpacetimeDBInboundEventType::PropertyUpdated;
+            Event.Id = 7;
+            Event.SecondaryId = 0;
+            Event.Name = TEXT("Health");
+            Event.Data = TEXT("42");
+            Event.Payload.Reset();
+        }));
+
+        FSpacetimeDBInboundEvent Event;
+        TestTrue(TEXT("Dequeued"), Queue.Dequeue(Event));
+        TestTrue(TEXT("Type"), Event.Type == ESpacetimeDBInboundEventType::PropertyUpdated);
+        TestEqual(TEXT("Name"), Event.Name, FString(TEXT("Health")));
+        TestEqual(TEXT("Data"), Event.Data, FString(TEXT("42")));
+    });
+
+    It("should not keep oversized buffers in its cells", [this]()
+    {
+        FSpacetimeDBEventQueue Queue(2);
+        FSpacetimeDBInboundEvent Event;
+        Event.Payload.SetNumZeroed(static_cast<int32>(FSpacetimeDBEventQueue::MaxRetainedBufferBytes) * 2);
+        TestTrue(TEXT("Large enqueued"), Queue.Enqueue(Event));
+        TestTrue(TEXT("Large dequeued"), Queue.Dequeue(Event));
+
+        // Dequeuing the next event hands the large buffer back to a cell
+        TestTrue(TEXT("Small enqueued"), EnqueueId(Queue, 1));
+        TestTrue(TEXT("Small dequeued"), Queue.Dequeue(Event));
+
+        // Two more laps visit both cells
+        for (uint64 Id = 2; Id < 4; ++Id)
+        {
+            SIZE_T Retained = 0;
+            TestTrue(TEXT("Enqueued"), Queue.EnqueueWith([&Retained, Id](FSpacetimeDBInboundEvent& CellEvent)
+            {
+                Retained = CellEvent.Payload.GetAllocatedSize();
+                CellEvent.Type = ESpacetimeDBInboundEventType::ObjectDestroyed;
+                CellEvent.Id = Id;
+            }));
+            TestTrue(TEXT("Retained buffer within the cap"), Retained <= FSpacetimeDBEventQueue::MaxRetainedBufferBytes);
+            TestTrue(TEXT("Dequeued"), Queue.Dequeue(Event));
+        }
+    });
+
+    It("should deliver every event of concurrent producers in each producer's order", [this]()
+    {
+        constexpr int32 NumProducers = 4;
+        constexpr uint64 EventsPerProducer = 20000;
+        FSpacetimeDBEventQueue Queue(1024);
+
+        TArray<TFuture<void>> Producers;
+        for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+        {
+            Producers.Add(Async(EAsyncExecution::Thread, [&Queue, Producer]()
+            {
+                for (uint64 Id = 0; Id < EventsPerProducer; ++Id)
+                {
+                    while (!EnqueueId(Queue, Id, Producer))
+                    {
+                        FPlatformProcess::YieldThread();
+                    }
+                }
+            }));
+        }
+
+        // Consume on this thread meanwhile so the producers never stay blocked on a full queue
+        uint64 NextId[NumProducers] = {};
+        uint64 Received = 0;
+        bool bInOrder = true;
+        FSpacetimeDBInboundEvent Event;
+        while (Received < NumProducers * EventsPerProducer)
+        {
+            if (!Queue.Dequeue(Event))
+            {
+                FPlatformProcess::YieldThread();
+                continue;
+            }
+            bInOrder &= Event.Id == NextId[Event.SecondaryId]++;
+            ++Received;
+        }
+
+        for (TFuture<void>& Producer : Producers)
+        {
+            Producer.Wait();
+        }
+
+        TestTrue(TEXT("Each producer's events arrived in order"), bInOrder);
+        TestFalse(TEXT("Nothing left over"), Queue.Dequeue(Event));
+    });
+}
@@ -0,0 +1,124 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "SpacetimeDBOutboundScheduler.h"
+
+namespace
+{
+    constexpr float FrameSeconds = 0.1f;
+
+    FSpacetimeDBOutboundCandidate MakeCandidate(int64 ObjectId, float Priority, int32 EstimatedBytes)
+    {
+        FSpacetimeDBOutboundCandidate Candidate;
+        Candidate.ObjectId = ObjectId;
+        Candidate.Priority = Priority;
+        Candidate.EstimatedBytes = EstimatedBytes;
+        return Candidate;
+    }
+}
+
+BEGIN_DEFINE_SPEC(FSpacetimeDBOutboundSchedulerSpec, "SpacetimeDB.OutboundScheduler", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    FSpacetimeDBOutboundScheduler Scheduler;
+END_DEFINE_SPEC(FSpacetimeDBOutboundSchedulerSpec)
+
+void FSpacetimeDBOutboundSchedulerSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Scheduler.Reset();
+    });
+
+    Describe("BeginFrame", [this]()
+    {
+        It("should refill the budget by the frame's share of the rate", [this]()
+        {
+            Scheduler.BeginFrame(FrameSeconds, 1000.0f, 1.0f);
+            TestEqual(TEXT("Budget"), Scheduler.GetBudgetBytes(), 100.0, 0.01);
+        });
+
+        It("should save up at most the burst", [this]()
+        {
+            for (int32 Frame = 0; Frame < 100; ++Frame)
+            {
+                Scheduler.BeginFrame(FrameSeconds, 1000.0f, 0.5f);
+            }
+            TestEqual(TEXT("Budget"), Scheduler.GetBudgetBytes(), 500.0, 0.01);
+        });
+
+        It("should pay back an overdraw before sending again", [this]()
+        {
+            Scheduler.BeginFrame(FrameSeconds, 1000.0f, 1.0f);
+            Scheduler.Consume(250);
+            Scheduler.BeginFrame(FrameSeconds, 1000.0f, 1.0f);
+            TestEqual(TEXT("Budget"), Scheduler.GetBudgetBytes(), -50.0, 0.01);
+        });
+    });
+
+    Describe("Select", [this]()
+    {
+        It("should send everything that fits the budget", [this]()
+        {
+            Scheduler.BeginFrame(FrameSeconds, 10000.0f, 1.0f);
+            TArray<FSpacetimeDBOutboundCandidate> Candidates = { MakeCandidate(1, 1.0f, 100), MakeCandidate(2, 1.0f, 100) };
+            TSet<int64> Selected;
+
+            TestEqual(TEXT("Held back"), Scheduler.Select(Candidates, FrameSeconds, Selected), 0);
+            TestEqual(TEXT("Selected"), Selected.Num(), 2);
+        });
+
+        It("should send the highest priority first when the budget runs out", [this]()
+        {
+            Scheduler.BeginFrame(FrameSeconds, 1000.0f, 1.0f);
+            TArray<FSpacetimeDBOutboundCandidate> Candidates = { MakeCandidate(1, 1.0f, 80), MakeCandidate(2, 5.0f, 80), MakeCandidate(3, 2.0f, 80) };
+            TSet<int64> Selected;
+
+            TestEqual(TEXT("Held back"), Scheduler.Select(Candidates, FrameSeconds, Selected), 1);
+            TestTrue(TEXT("Highest sent"), Selected.Contains(2));
+            TestTrue(TEXT("Second sent by overdrawing"), Selected.Contains(3));
+            TestFalse(TEXT("Lowest held back"), Selected.Contains(1));
+        });
+
+        It("should send an object larger than a frame's budget", [this]()
+        {
+            Scheduler.BeginFrame(FrameSeconds, 1000.0f, 1.0f);
+            TArray<FSpacetimeDBOutboundCandidate> Candidates = { MakeCandidate(1, 1.0f, 5000) };
+            TSet<int64> Selected;
+
+            Scheduler.Select(Candidates, FrameSeconds, Selected);
+            TestTrue(TEXT("Sent"), Selected.Contains(1));
+            TestTrue(TEXT("Overdrawn"), Scheduler.GetBudgetBytes() < 0.0);
+        });
+
+        It("should eventually send a low priority object held back by busier ones", [this]()
+        {
+            int32 FramesWaited = 0;
+            bool bLowSent = false;
+            while (!bLowSent && FramesWaited < 100)
+            {
+                // Only room for one object per frame
+                Scheduler.BeginFrame(FrameSeconds, 10.0f, 1.0f);
+                TArray<FSpacetimeDBOutboundCandidate> Candidates = { MakeCandidate(1, 10.0f, 1), MakeCandidate(2, 10.0f, 1), MakeCandidate(3, 1.0f, 1) };
+                TSet<int64> Selected;
+                Scheduler.Select(Candidates, FrameSeconds, Selected);
+
+                bLowSent = Selected.Contains(3);
+                ++FramesWaited;
+            }
+            TestTrue(TEXT("Low priority object sent"), bLowSent);
+        });
+
+        It("should start a forgotten object over from zero", [this]()
+        {
+            Scheduler.BeginFrame(FrameSeconds, 0.0f, 1.0f);
+            TArray<FSpacetimeDBOutboundCandidate> Candidates = { MakeCandidate(1, 100.0f, 1) };
+            TSet<int64> Selected;
+            Scheduler.Select(Candidates, FrameSeconds, Selected);
+            TestFalse(TEXT("No budget"), Selected.Contains(1));
+
+            Scheduler.Forget(1);
+            Candidates = { MakeCandidate(1, 1.0f, 1) };
+            Scheduler.Select(Candidates, FrameSeconds, Selected);
+            TestEqual(TEXT("Accumulated priority"), Candidates[0].Priority, FrameSeconds, 0.0001f);
+        });
+    });
+}
@@ -0,0 +1,189 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "SpacetimeDBPredictionComponent.h"
+#include "SpacetimeDBPredictionManager.h"
+#include "SpacetimeDBTestWorld.h"
+
+namespace
+{
+    /** Further than the default 5 unit position threshold */
+    const FVector FarOffset(200.0, 0.0, 0.0);
+
+    /** Within the default position threshold */
+    const FVector NearOffset(1.0, 0.0, 0.0);
+}
+
+BEGIN_DEFINE_SPEC(FSpacetimeDBPredictionSpec, "SpacetimeDB.Prediction", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    FSpacetimeDBTestWorld TestWorld;
+    ACharacter* Character = nullptr;
+    USpacetimeDBPredictionComponent* Component = nullptr;
+    USpacetimeDBPredictionManager* Manager = nullptr;
+
+    USpacetimeDBPredictionComponent* AddPredictionComponent(ACharacter* Owner)
+    {
+        // The owner has begun play, so registering begins play for the component too
+        USpacetimeDBPredictionComponent* NewComponent = NewObject<USpacetimeDBPredictionComponent>(Owner);
+        NewComponent->RegisterComponent();
+        return NewComponent;
+    }
+
+    FTransform ServerTransform(const FVector& Offset) const
+    {
+        return FTransform(Character->GetActorRotation(), Character->GetActorLocation() + Offset);
+    }
+END_DEFINE_SPEC(FSpacetimeDBPredictionSpec)
+
+void FSpacetimeDBPredictionSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        TestWorld.Create();
+        Character = TestWorld.SpawnLocalCharacter(FTransform::Identity);
+        Component = AddPredictionComponent(Character);
+        Manager = TestWorld.World->GetSubsystem<USpacetimeDBPredictionManager>();
+
+        TestTrue(TEXT("Character is locally controlled"), Character->IsLocallyControlled());
+        TestNotNull(TEXT("Prediction manager"), Manager);
+    });
+
+    Describe("ProcessServerUpdate", [this]()
+    {
+        It("should snap to the server for a sequence it has no snapshot of", [this]()
+        {
+            const FTransform Server = ServerTransform(FarOffset);
+            Component->ProcessServerUpdate(Server, FVector::ZeroVector, 50);
+
+            TestTrue(TEXT("Snapped"), Character->GetActorLocation().Equals(Server.GetLocation(), 0.01));
+        });
+
+        It("should leave the actor alone when the error is within the thresholds", [this]()
+        {
+            Component->TakeStateSnapshot();
+            const FVector Before = Character->GetActorLocation();
+
+            Component->ProcessServerUpdate(ServerTransform(NearOffset), FVector::ZeroVector, 0);
+
+            TestTrue(TEXT("Unchanged"), Character->GetActorLocation().Equals(Before));
+        });
+
+        It("should correct towards the server when the error exceeds the thresholds", [this]()
+        {
+            Component->TakeStateSnapshot();
+            const FVector Target = ServerTransform(FarOffset).GetLocation();
+            const double ErrorBefore = FVector::Dist(Character->GetActorLocation(), Target);
+
+            Component->ProcessServerUpdate(FTransform(Target), FVector::ZeroVector, 0);
+
+            TestTrue(TEXT("Closer to the server"), FVector::Dist(Character->GetActorLocation(), Target) < ErrorBefore);
+        });
+
+        It("should keep a snapshot for each sequence until the history wraps", [this]()
+        {
+            for (int32 Index = 0; Index < 10; ++Index)
+            {
+                Component->TakeStateSnapshot();
+            }
+            TestEqual(TEXT("Sequence"), Component->GetCurrentSequence(), 10);
+            TestNotNull(TEXT("Newest"), Component->FindSnapshot(9));
+            TestNotNull(TEXT("Oldest"), Component->FindSnapshot(0));
+            TestNull(TEXT("Future"), Component->FindSnapshot(10));
+        });
+    });
+
+    Describe("USpacetimeDBPredictionManager", [this]()
+    {
+        It("should reconcile queued updates on its next tick", [this]()
+        {
+            Component->TakeStateSnapshot();
+            const FTransform Server = ServerTransform(FarOffset);
+            const FVector Before = Character->GetActorLocation();
+
+            TestTrue(TEXT("Queued"), Manager->QueueServerUpdate(Component, Server, FVector::ZeroVector, 0));
+            TestTrue(TEXT("Not applied before the tick"), Character->GetActorLocation().Equals(Before));
+
+            Manager->Tick(1.0f / 60.0f);
+
+            const FSpacetimeDBPredictionStats Stats = Manager->GetPredictionStats();
+            TestEqual(TEXT("Server updates"), Stats.NumServerUpdates, 1);
+            TestEqual(TEXT("Corrections"), Stats.NumCorrections, 1);
+            TestTrue(TEXT("Corrected"), FVector::Dist(Character->GetActorLocation(), Server.GetLocation()) < FVector::Dist(Before, Server.GetLocation()));
+        });
+
+        It("should only apply the newest of several queued updates", [this]()
+        {
+            Component->TakeStateSnapshot();
+            Component->TakeStateSnapshot();
+            const FTransform Near = ServerTransform(NearOffset);
+
+            Manager->QueueServerUpdate(Component, Near, FVector::ZeroVector, 1);
+            Manager->QueueServerUpdate(Component, ServerTransform(FarOffset), FVector::ZeroVector, 0);
+            Manager->Tick(1.0f / 60.0f);
+
+            TestEqual(TEXT("Corrections"), Manager->GetPredictionStats().NumCorrections, 0);
+        });
+
+        It("should keep reconciling the remaining components after one is removed", [this]()
+        {
+            ACharacter* Second = TestWorld.SpawnLocalCharacter(FTransform(FVector(0.0, 500.0, 0.0)));
+            USpacetimeDBPredictionComponent* SecondComponent = AddPredictionComponent(Second);
+            ACharacter* Third = TestWorld.SpawnLocalCharacter(FTransform(FVector(0.0, 1000.0, 0.0)));
+            USpacetimeDBPredictionComponent* ThirdComponent = AddPredictionComponent(Third);
+
+            // Ends play, which unregisters it and moves the last component into its slot
+            Component->DestroyComponent();
+            TestFalse(TEXT("Removed component"), Manager->QueueServerUpdate(Component, FTransform::Identity, FVector::ZeroVector, 0));
+
+            ThirdComponent->TakeStateSnapshot();
+            const FVector Target = Third->GetActorLocation() + FarOffset;
+            TestTrue(TEXT("Moved component"), Manager->QueueServerUpdate(ThirdComponent, FTransform(Target), FVector::ZeroVector, 0));
+            TestTrue(TEXT("Untouched component"), Manager->QueueServerUpdate(SecondComponent, Second->GetActorTransform(), FVector::ZeroVector, 99));
+
+            Manager->Tick(1.0f / 60.0f);
+
+            TestEqual(TEXT("Predicted actors"), Manager->GetPredictionStats().NumPredictedActors, 2);
+            TestEqual(TEXT("Server updates"), Manager->GetPredictionStats().NumServerUpdates, 2);
+            TestTrue(TEXT("Moved component corrected"), FVector::Dist(Third->GetActorLocation(), Target) < FarOffset.Size());
+        });
+
+        It("should finish the pass when a correction removes another component", [this]()
+        {
+            ACharacter* Second = TestWorld.SpawnLocalCharacter(FTransform(FVector(0.0, 500.0, 0.0)));
+            USpacetimeDBPredictionComponent* SecondComponent = AddPredictionComponent(Second);
+            ACharacter* Third = TestWorld.SpawnLocalCharacter(FTransform(FVector(0.0, 1000.0, 0.0)));
+            USpacetimeDBPredictionComponent* ThirdComponent = AddPredictionComponent(Third);
+
+            // Correcting the first actor removes the second mid-pass, as if the move had destroyed it
+            Character->GetRootComponent()->TransformUpdated.AddLambda([SecondComponent](USceneComponent*, EUpdateTransformFlags, ETeleportType)
+            {
+                if (IsValid(SecondComponent))
+                {
+                    SecondComponent->DestroyComponent();
+                }
+            });
+
+            Component->TakeStateSnapshot();
+            ThirdComponent->TakeStateSnapshot();
+            const FVector Target = Third->GetActorLocation() + FarOffset;
+            Manager->QueueServerUpdate(Component, ServerTransform(FarOffset), FVector::ZeroVector, 0);
+            Manager->QueueServerUpdate(ThirdComponent, FTransform(Target), FVector::ZeroVector, 0);
+
+            Manager->Tick(1.0f / 60.0f);
+
+            TestEqual(TEXT("Corrections"), Manager->GetPredictionStats().NumCorrections, 2);
+            TestTrue(TEXT("Third component corrected"), FVector::Dist(Third->GetActorLocation(), Target) < FarOffset.Size());
+            TestFalse(TEXT("Removed after the pass"), Manager->QueueServerUpdate(SecondComponent, FTransform::Identity, FVector::ZeroVector, 0));
+            TestTrue(TEXT("Third still registered"), Manager->QueueServerUpdate(ThirdComponent, FTransform(Target), FVector::ZeroVector, 1));
+        });
+    });
+
+    AfterEach([this]()
+    {
+        Character = nullptr;
+        Component = nullptr;
+        Manager = nullptr;
+        TestWorld.Destroy();
+    });
+}
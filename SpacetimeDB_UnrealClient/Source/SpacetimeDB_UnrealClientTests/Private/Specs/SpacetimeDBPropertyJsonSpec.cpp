@@ -0,0 +1,199 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "SpacetimeDBPropertyHelper.h"
+#include "SpacetimeDB_JsonUtils.h"
+#include "SpacetimeDB_PropertyValue.h"
+#include "SpacetimeDBTestTypes.h"
+
+BEGIN_DEFINE_SPEC(FSpacetimeDBPropertyJsonSpec, "SpacetimeDB.PropertyJson", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    USpacetimeDBTestObject* Source = nullptr;
+    USpacetimeDBTestObject* Target = nullptr;
+
+    /** Converts a value to JSON and back */
+    FSpacetimeDBPropertyValue RoundTrip(const FSpacetimeDBPropertyValue& Value)
+    {
+        const FSpacetimeDBPropertyValue Result = FSpacetimeDBPropertyValue::FromJsonString(Value.ToJsonString());
+        TestTrue(TEXT("Type survives"), Result.Type == Value.Type);
+        return Result;
+    }
+
+    template<typename PropertyType>
+    PropertyType* FindTypedProperty(const TCHAR* Name)
+    {
+        return CastField<PropertyType>(SpacetimeDBTests::FindTestProperty(Name));
+    }
+END_DEFINE_SPEC(FSpacetimeDBPropertyJsonSpec)
+
+void FSpacetimeDBPropertyJsonSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Source = NewObject<USpacetimeDBTestObject>();
+        Source->FillWithSampleValues();
+        Target = NewObject<USpacetimeDBTestObject>();
+    });
+
+    Describe("FSpacetimeDBPropertyHelper", [this]()
+    {
+        It("should apply the JSON it serializes for every supported type", [this]()
+        {
+            for (const TCHAR* Name : SpacetimeDBTests::GetTestPropertyNames())
+            {
+                const FString Json = FSpacetimeDBPropertyHelper::SerializePropertyToJson(Source, Name);
+                TestFalse(FString::Printf(TEXT("%s serialized"), Name), Json.IsEmpty());
+                TestTrue(FString::Printf(TEXT("%s applied"), Name), FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Target, Name, Json));
+                TestTrue(FString::Printf(TEXT("%s round trips"), Name), SpacetimeDBTests::IsPropertyIdentical(Name, Source, Target));
+            }
+        });
+
+        It("should call the RepNotify of a property it applies", [this]()
+        {
+            TestTrue(TEXT("Applied"), FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Target, TEXT("Health"), TEXT("7")));
+            TestEqual(TEXT("Health"), Target->Health, 7);
+            TestEqual(TEXT("Notifies"), Target->NumHealthNotifies, 1);
+        });
+
+        It("should write enums by name", [this]()
+        {
+            TestTrue(TEXT("Applied"), FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Target, TEXT("EnumValue"), TEXT("\"Second\"")));
+            TestTrue(TEXT("Enum"), Target->EnumValue == ESpacetimeDBTestEnum::Second);
+        });
+
+        It("should fail for unknown properties and invalid JSON", [this]()
+        {
+            AddExpectedError(TEXT("Property not found: NoSuchProperty"), EAutomationExpectedErrorFlags::Contains, 1);
+            AddExpectedError(TEXT("Failed to parse JSON for property IntArray"), EAutomationExpectedErrorFlags::Contains, 1);
+            TestFalse(TEXT("Unknown property"), FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Target, TEXT("NoSuchProperty"), TEXT("1")));
+            TestFalse(TEXT("Invalid JSON"), FSpacetimeDBPropertyHelper::ApplyJsonToProperty(Target, TEXT("IntArray"), TEXT("[1, 2")));
+        });
+    });
+
+    Describe("FSpacetimeDBPropertyValue", [this]()
+    {
+        It("should round trip scalars through JSON", [this]()
+        {
+            TestEqual(TEXT("Bool"), RoundTrip(FSpacetimeDBPropertyValue(true)).BoolValue, true);
+            TestEqual(TEXT("Byte"), RoundTrip(FSpacetimeDBPropertyValue(static_cast<uint8>(200))).ByteValue, static_cast<uint8>(200));
+            TestEqual(TEXT("Int32"), RoundTrip(FSpacetimeDBPropertyValue(static_cast<int32>(-123456))).Int32Value, -123456);
+            TestEqual(TEXT("Int64"), RoundTrip(FSpacetimeDBPropertyValue(static_cast<int64>(1234567890123LL))).Int64Value, static_cast<int64>(1234567890123LL));
+            TestEqual(TEXT("UInt32"), RoundTrip(FSpacetimeDBPropertyValue(static_cast<uint32>(4000000000u))).UInt32Value, static_cast<uint32>(4000000000u));
+            TestEqual(TEXT("Float"), RoundTrip(FSpacetimeDBPropertyValue(3.5f)).FloatValue, 3.5f);
+            TestEqual(TEXT("Double"), RoundTrip(FSpacetimeDBPropertyValue(-2.25)).DoubleValue, -2.25);
+        });
+
+        It("should round trip strings, names and text through JSON", [this]()
+        {
+            const FString Text = TEXT("Hello \"SpacetimeDB\" \u00e9");
+            TestEqual(TEXT("String"), RoundTrip(FSpacetimeDBPropertyValue(Text)).StringValue, Text);
+            TestEqual(TEXT("Name"), RoundTrip(FSpacetimeDBPropertyValue::MakeName(TEXT("SampleName"))).StringValue, FString(TEXT("SampleName")));
+            TestEqual(TEXT("Text"), RoundTrip(FSpacetimeDBPropertyValue::MakeText(Text)).StringValue, Text);
+        });
+
+        It("should round trip math structs and colors through JSON", [this]()
+        {
+            TestEqual(TEXT("Vector"), RoundTrip(FSpacetimeDBPropertyValue(Source->VectorValue)).VectorValue, Source->VectorValue);
+            TestEqual(TEXT("Rotator"), RoundTrip(FSpacetimeDBPropertyValue(Source->RotatorValue)).RotatorValue, Source->RotatorValue);
+            TestTrue(TEXT("Quat"), RoundTrip(FSpacetimeDBPropertyValue(Source->QuatValue)).QuatValue.Equals(Source->QuatValue));
+            TestTrue(TEXT("Transform"), RoundTrip(FSpacetimeDBPropertyValue(Source->TransformValue)).TransformValue.Equals(Source->TransformValue));
+            TestEqual(TEXT("Color"), RoundTrip(FSpacetimeDBPropertyValue(Source->ColorValue)).ColorValue, Source->ColorValue);
+        });
+
+        It("should keep the JSON of containers", [this]()
+        {
+            const FString ArrayJson = TEXT("[1,2,3]");
+            TestEqual(TEXT("Array"), RoundTrip(FSpacetimeDBPropertyValue::MakeArrayJson(ArrayJson)).JsonValue, ArrayJson);
+        });
+
+        It("should apply to and extract from object properties", [this]()
+        {
+            TestTrue(TEXT("Applied"), USpacetimeDBPropertyHandler::ApplyPropertyToObject(Target, TEXT("IntValue"), FSpacetimeDBPropertyValue(static_cast<int32>(31))));
+            TestEqual(TEXT("IntValue"), Target->IntValue, 31);
+
+            FSpacetimeDBPropertyValue Extracted;
+            TestTrue(TEXT("Extracted"), USpacetimeDBPropertyHandler::ExtractPropertyFromObject(Source, TEXT("VectorValue"), Extracted));
+            TestTrue(TEXT("Type"), Extracted.Type == ESpacetimeDBPropertyType::Vector);
+            TestEqual(TEXT("Vector"), Extracted.VectorValue, Source->VectorValue);
+        });
+
+        It("should report an invalid type as None", [this]()
+        {
+            AddExpectedError(TEXT("PropertyValue"), EAutomationExpectedErrorFlags::Contains, 0);
+            TestTrue(TEXT("No type"), FSpacetimeDBPropertyValue::FromJsonString(TEXT("{\"type\":\"NotAType\"}")).Type == ESpacetimeDBPropertyType::None);
+            TestTrue(TEXT("Not JSON"), FSpacetimeDBPropertyValue::FromJsonString(TEXT("nope")).Type == ESpacetimeDBPropertyType::None);
+        });
+    });
+
+    Describe("USpacetimeDBJsonUtils", [this]()
+    {
+        It("should round trip structs", [this]()
+        {
+            const FString Json = USpacetimeDBJsonUtils::SerializeStructToJson(FSpacetimeDBTestStruct::StaticStruct(), &Source->StructValue);
+            TestTrue(TEXT("Deserialized"), USpacetimeDBJsonUtils::DeserializeJsonToStruct(FSpacetimeDBTestStruct::StaticStruct(), &Target->StructValue, Json));
+            TestTrue(TEXT("Struct"), SpacetimeDBTests::IsPropertyIdentical(TEXT("StructValue"), Source, Target));
+        });
+
+        It("should round trip arrays", [this]()
+        {
+            for (const TCHAR* Name : { TEXT("IntArray"), TEXT("StructArray") })
+            {
+                FArrayProperty* Property = FindTypedProperty<FArrayProperty>(Name);
+                const FString Json = USpacetimeDBJsonUtils::SerializeArrayToJson(Property, Property->ContainerPtrToValuePtr<void>(Source));
+                TestTrue(FString::Printf(TEXT("%s deserialized"), Name), USpacetimeDBJsonUtils::DeserializeJsonToArray(Property, Property->ContainerPtrToValuePtr<void>(Target), Json));
+                TestTrue(FString::Printf(TEXT("%s round trips"), Name), SpacetimeDBTests::IsPropertyIdentical(Name, Source, Target));
+            }
+        });
+
+        It("should round trip maps", [this]()
+        {
+            FMapProperty* Property = FindTypedProperty<FMapProperty>(TEXT("StringToIntMap"));
+            const FString Json = USpacetimeDBJsonUtils::SerializeMapToJson(Property, Property->ContainerPtrToValuePtr<void>(Source));
+            TestTrue(TEXT("Deserialized"), USpacetimeDBJsonUtils::DeserializeJsonToMap(Property, Property->ContainerPtrToValuePtr<void>(Target), Json));
+            TestTrue(TEXT("Map"), SpacetimeDBTests::IsPropertyIdentical(TEXT("StringToIntMap"), Source, Target));
+        });
+
+        It("should round trip sets", [this]()
+        {
+            FSetProperty* Property = FindTypedProperty<FSetProperty>(TEXT("IntSet"));
+            const FString Json = USpacetimeDBJsonUtils::SerializeSetToJson(Property, Property->ContainerPtrToValuePtr<void>(Source));
+            TestTrue(TEXT("Deserialized"), USpacetimeDBJsonUtils::DeserializeJsonToSet(Property, Property->ContainerPtrToValuePtr<void>(Target), Json));
+            TestTrue(TEXT("Set"), SpacetimeDBTests::IsPropertyIdentical(TEXT("IntSet"), Source, Target));
+        });
+
+        It("should round trip vectors, rotators and transforms", [this]()
+        {
+            FVector Vector;
+            TestTrue(TEXT("Vector"), USpacetimeDBJsonUtils::JsonToVector(USpacetimeDBJsonUtils::VectorToJson(Source->VectorValue), Vector));
+            TestEqual(TEXT("Vector value"), Vector, Source->VectorValue);
+
+            FRotator Rotator;
+            TestTrue(TEXT("Rotator"), USpacetimeDBJsonUtils::JsonToRotator(USpacetimeDBJsonUtils::RotatorToJson(Source->RotatorValue), Rotator));
+            TestEqual(TEXT("Rotator value"), Rotator, Source->RotatorValue);
+
+            FTransform Transform;
+            TestTrue(TEXT("Transform"), USpacetimeDBJsonUtils::JsonToTransform(USpacetimeDBJsonUtils::TransformToJson(Source->TransformValue), Transform));
+            TestTrue(TEXT("Transform value"), Transform.Equals(Source->TransformValue, 0.001));
+        });
+
+        It("should round trip RPC arguments", [this]()
+        {
+            TArray<TSharedPtr<FJsonValue>> Args;
+            Args.Add(MakeShared<FJsonValueNumber>(5));
+            Args.Add(MakeShared<FJsonValueString>(TEXT("five")));
+
+            TArray<TSharedPtr<FJsonValue>> Parsed;
+            TestTrue(TEXT("Deserialized"), USpacetimeDBJsonUtils::DeserializeJsonToRpcArgs(USpacetimeDBJsonUtils::SerializeRpcArgsToJson(Args), Parsed));
+            if (TestEqual(TEXT("Count"), Parsed.Num(), 2))
+            {
+                TestEqual(TEXT("Number"), Parsed[0]->AsNumber(), 5.0);
+                TestEqual(TEXT("String"), Parsed[1]->AsString(), FString(TEXT("five")));
+            }
+        });
+    });
+
+    AfterEach([this]()
+    {
+        Source = nullptr;
+        Target = nullptr;
+    });
+}
@@ -0,0 +1,139 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "SpacetimeDBPropertyHelper.h"
+#include "SpacetimeDBSpawnDataReader.h"
+#include "SpacetimeDBTestTypes.h"
+
+BEGIN_DEFINE_SPEC(FSpacetimeDBSpawnDataReaderSpec, "SpacetimeDB.SpawnDataReader", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    USpacetimeDBTestObject* Source = nullptr;
+    USpacetimeDBTestObject* Target = nullptr;
+    FTransform SpawnTransform;
+END_DEFINE_SPEC(FSpacetimeDBSpawnDataReaderSpec)
+
+void FSpacetimeDBSpawnDataReaderSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Source = NewObject<USpacetimeDBTestObject>();
+        Source->FillWithSampleValues();
+        Target = NewObject<USpacetimeDBTestObject>();
+        SpawnTransform = FTransform(FRotator(0.0, 90.0, 0.0), FVector(100.0, -200.0, 50.0), FVector(1.0, 2.0, 1.0));
+    });
+
+    Describe("Read", [this]()
+    {
+        It("should write every property of the snapshot into the target", [this]()
+        {
+            const TConstArrayView<const TCHAR*> Names = SpacetimeDBTests::GetTestPropertyNames();
+            FSpacetimeDBSpawnSnapshot Snapshot;
+            TestTrue(TEXT("Read"), FSpacetimeDBSpawnDataReader::Read(SpacetimeDBTests::MakeSnapshotJson(Source, Names), Target, false, Snapshot));
+
+            TestEqual(TEXT("Applied"), Snapshot.NumPropertiesApplied, Names.Num());
+            TestEqual(TEXT("Failed"), Snapshot.NumPropertiesFailed, 0);
+            for (const TCHAR* Name : Names)
+            {
+                TestTrue(FString::Printf(TEXT("%s matches"), Name), SpacetimeDBTests::IsPropertyIdentical(Name, Source, Target));
+            }
+        });
+
+        It("should return the transform without applying anything for it", [this]()
+        {
+            FSpacetimeDBSpawnSnapshot Snapshot;
+            TestTrue(TEXT("Read"), FSpacetimeDBSpawnDataReader::Read(SpacetimeDBTests::MakeSnapshotJson(Source, {}, &SpawnTransform), Target, false, Snapshot));
+
+            TestTrue(TEXT("Has transform"), Snapshot.bHasTransform);
+            TestTrue(TEXT("Transform"), Snapshot.Transform.Equals(SpawnTransform, 0.001));
+        });
+
+        It("should call RepNotifies only when asked to", [this]()
+        {
+            const FString Json = SpacetimeDBTests::MakeSnapshotJson(Source, { TEXT("Health") });
+            FSpacetimeDBSpawnSnapshot Snapshot;
+
+            FSpacetimeDBSpawnDataReader::Read(Json, Target, false, Snapshot);
+            TestEqual(TEXT("Notifies without"), Target->NumHealthNotifies, 0);
+
+            FSpacetimeDBSpawnDataReader::Read(Json, Target, true, Snapshot);
+            TestEqual(TEXT("Notifies with"), Target->NumHealthNotifies, 1);
+        });
+
+        It("should count unknown properties as failed and keep reading", [this]()
+        {
+            AddExpectedError(TEXT("Property 'NoSuchProperty' not found"), EAutomationExpectedErrorFlags::Contains, 1);
+            FSpacetimeDBSpawnSnapshot Snapshot;
+            TestTrue(TEXT("Read"), FSpacetimeDBSpawnDataReader::Read(TEXT("{\"properties\":{\"NoSuchProperty\":1,\"IntValue\":5}}"), Target, false, Snapshot));
+
+            TestEqual(TEXT("Applied"), Snapshot.NumPropertiesApplied, 1);
+            TestEqual(TEXT("Failed"), Snapshot.NumPropertiesFailed, 1);
+            TestEqual(TEXT("IntValue"), Target->IntValue, 5);
+        });
+
+        It("should reject malformed JSON", [this]()
+        {
+            AddExpectedError(TEXT("Failed to parse snapshot JSON"), EAutomationExpectedErrorFlags::Contains, 1);
+            FSpacetimeDBSpawnSnapshot Snapshot;
+            TestFalse(TEXT("Read"), FSpacetimeDBSpawnDataReader::Read(TEXT("{\"properties\":{\"IntValue\":"), Target, false, Snapshot));
+        });
+    });
+
+    Describe("Reconcile", [this]()
+    {
+        BeforeEach([this]()
+        {
+            Target->FillWithSampleValues();
+        });
+
+        It("should only write and notify the properties that changed", [this]()
+        {
+            Source->IntValue = 77;
+            Source->Health = 10;
+
+            FSpacetimeDBSpawnSnapshot Snapshot;
+            TestTrue(TEXT("Reconciled"), FSpacetimeDBSpawnDataReader::Reconcile(SpacetimeDBTests::MakeSnapshotJson(Source, SpacetimeDBTests::GetTestPropertyNames()), Target, Snapshot));
+
+            TestEqual(TEXT("Changed properties"), Snapshot.NumPropertiesApplied, 2);
+            TestEqual(TEXT("IntValue"), Target->IntValue, 77);
+            TestEqual(TEXT("Health"), Target->Health, 10);
+            TestEqual(TEXT("Health notifies"), Target->NumHealthNotifies, 1);
+        });
+
+        It("should not notify a property that kept its value", [this]()
+        {
+            FSpacetimeDBSpawnSnapshot Snapshot;
+            TestTrue(TEXT("Reconciled"), FSpacetimeDBSpawnDataReader::Reconcile(SpacetimeDBTests::MakeSnapshotJson(Source, { TEXT("Health") }), Target, Snapshot));
+
+            TestEqual(TEXT("Changed properties"), Snapshot.NumPropertiesApplied, 0);
+            TestEqual(TEXT("Health notifies"), Target->NumHealthNotifies, 0);
+        });
+    });
+
+    Describe("Peek", [this]()
+    {
+        It("should extract the transform and owner and skip everything else", [this]()
+        {
+            const FString Json = FString::Printf(TEXT("{\"properties\":{\"StructArray\":%s,\"owner_client_id\":42}}"),
+                *FSpacetimeDBPropertyHelper::SerializePropertyToJson(Source, TEXT("StructArray")));
+
+            FSpacetimeDBSpawnSnapshot Snapshot;
+            TestTrue(TEXT("Peeked"), FSpacetimeDBSpawnDataReader::Peek(Json, Snapshot));
+            TestEqual(TEXT("Owner"), Snapshot.OwnerClientId, static_cast<int64>(42));
+            TestFalse(TEXT("No transform"), Snapshot.bHasTransform);
+            TestEqual(TEXT("Applied"), Snapshot.NumPropertiesApplied, 0);
+        });
+
+        It("should find a transform", [this]()
+        {
+            FSpacetimeDBSpawnSnapshot Snapshot;
+            TestTrue(TEXT("Peeked"), FSpacetimeDBSpawnDataReader::Peek(SpacetimeDBTests::MakeSnapshotJson(Source, SpacetimeDBTests::GetTestPropertyNames(), &SpawnTransform), Snapshot));
+            TestTrue(TEXT("Has transform"), Snapshot.bHasTransform);
+            TestTrue(TEXT("Transform"), Snapshot.Transform.Equals(SpawnTransform, 0.001));
+        });
+    });
+
+    AfterEach([this]()
+    {
+        Source = nullptr;
+        Target = nullptr;
+    });
+}
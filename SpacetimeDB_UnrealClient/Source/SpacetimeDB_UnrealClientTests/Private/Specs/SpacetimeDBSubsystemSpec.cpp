@@ -0,0 +1,361 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Mock/SpacetimeDBMockFFI.h"
+
+#if SPACETIMEDB_MOCK_FFI
+
+#include "Engine/GameInstance.h"
+#include "SpacetimeDBBinaryCodec.h"
+#include "SpacetimeDBFFI.h"
+#include "SpacetimeDBSettings.h"
+#include "SpacetimeDBSubsystem.h"
+#include "SpacetimeDBTestTypes.h"
+#include "SpacetimeDBTestWorld.h"
+#include "SpacetimeDBTypeConversions.h"
+
+namespace
+{
+    const TCHAR* const TestObjectPath = TEXT("/Script/SpacetimeDB_UnrealClientTests.SpacetimeDBTestObject");
+    constexpr uint64 TestObjectId = 1001;
+    constexpr float FrameSeconds = 1.0f / 60.0f;
+}
+
+BEGIN_DEFINE_SPEC(FSpacetimeDBSubsystemSpec, "SpacetimeDB.Subsystem", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    FSpacetimeDBTestWorld TestWorld;
+    USpacetimeDBSubsystem* Subsystem = nullptr;
+    USpacetimeDBTestObject* Source = nullptr;
+
+    uint64 GetHandle() const
+    {
+        return Subsystem->GetClient().GetConnectionHandle();
+    }
+
+    /** Sends the creation of an object with Source's values and runs the frame that spawns it */
+    USpacetimeDBTestObject* CreateFromServer(uint64 ObjectId)
+    {
+        FSpacetimeDBMockFFI::SimulateObjectCreated(GetHandle(), ObjectId, TestObjectPath,
+            SpacetimeDBTests::MakeSnapshotJson(Source, SpacetimeDBTests::GetTestPropertyNames()));
+        Subsystem->Tick(FrameSeconds);
+        return Cast<USpacetimeDBTestObject>(Subsystem->FindObjectById(static_cast<int64>(ObjectId)));
+    }
+END_DEFINE_SPEC(FSpacetimeDBSubsystemSpec)
+
+void FSpacetimeDBSubsystemSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        FSpacetimeDBMockFFI::Reset();
+        TestWorld.Create(true);
+        Subsystem = TestWorld.GameInstance->GetSubsystem<USpacetimeDBSubsystem>();
+
+        Source = NewObject<USpacetimeDBTestObject>();
+        Source->FillWithSampleValues();
+
+        TestTrue(TEXT("Connect"), Subsystem->Connect(TEXT("localhost:3000"), TEXT("test_db")));
+        Subsystem->Tick(FrameSeconds);
+    });
+
+    Describe("Connect", [this]()
+    {
+        It("should connect through the client library", [this]()
+        {
+            const FSpacetimeDBMockConnection* Connection = FSpacetimeDBMockFFI::FindConnection(GetHandle());
+            if (TestNotNull(TEXT("Connection"), Connection))
+            {
+                TestEqual(TEXT("Host"), Connection->Host, FString(TEXT("localhost:3000")));
+                TestEqual(TEXT("Database"), Connection->DatabaseName, FString(TEXT("test_db")));
+            }
+            TestTrue(TEXT("Connected"), Subsystem->IsConnected());
+        });
+
+        It("should report the connection only once the library does", [this]()
+        {
+            Subsystem->Disconnect();
+            Subsystem->Tick(FrameSeconds);
+            FSpacetimeDBMockFFI::bDeferConnected = true;
+
+            TestTrue(TEXT("Connect"), Subsystem->Connect(TEXT("localhost:3000"), TEXT("test_db")));
+            Subsystem->Tick(FrameSeconds);
+            TestFalse(TEXT("Not connected yet"), Subsystem->IsConnected());
+
+            FSpacetimeDBMockFFI::SimulateConnected(GetHandle());
+            Subsystem->Tick(FrameSeconds);
+            TestTrue(TEXT("Connected"), Subsystem->IsConnected());
+        });
+
+        It("should refuse a client library built against other headers", [this]()
+        {
+            Subsystem->Disconnect();
+            Subsystem->Tick(FrameSeconds);
+            FSpacetimeDBMockFFI::FFIAbiVersion = SPACETIMEDB_FFI_ABI_VERSION + 1;
+
+            AddExpectedError(TEXT("doesn't match this plugin"), EAutomationExpectedErrorFlags::Contains, 0);
+            TestFalse(TEXT("Connect"), Subsystem->Connect(TEXT("localhost:3000"), TEXT("test_db")));
+            Subsystem->Tick(FrameSeconds);
+            TestFalse(TEXT("Connected"), Subsystem->IsConnected());
+        });
+
+        It("should only resolve callback contexts of live clients", [this]()
+        {
+            FSpacetimeDBClient& Client = Subsystem->GetClient();
+            TestTrue(TEXT("Live client"), FSpacetimeDBClient::FromCallbackContext(reinterpret_cast<uintptr_t>(&Client)) == &Client);
+            TestNull(TEXT("Unknown context"), FSpacetimeDBClient::FromCallbackContext(reinterpret_cast<uintptr_t>(this)));
+
+            TUniquePtr<FSpacetimeDBClient> Gone = MakeUnique<FSpacetimeDBClient>();
+            const uintptr_t GoneContext = reinterpret_cast<uintptr_t>(Gone.Get());
+            Gone.Reset();
+            TestNull(TEXT("Destroyed client"), FSpacetimeDBClient::FromCallbackContext(GoneContext));
+        });
+    });
+
+    Describe("SpawnObjectFromServer", [this]()
+    {
+        It("should spawn an object with the values of its snapshot", [this]()
+        {
+            USpacetimeDBTestObject* Object = CreateFromServer(TestObjectId);
+            if (TestNotNull(TEXT("Spawned"), Object))
+            {
+                for (const TCHAR* Name : SpacetimeDBTests::GetTestPropertyNames())
+                {
+                    TestTrue(FString::Printf(TEXT("%s matches"), Name), SpacetimeDBTests::IsPropertyIdentical(Name, Source, Object));
+                }
+                TestEqual(TEXT("Object ID"), Subsystem->GetObjectId(Object), static_cast<int64>(TestObjectId));
+            }
+        });
+
+        It("should not spawn an object of an unknown class", [this]()
+        {
+            AddExpectedError(TEXT("Could not find class"), EAutomationExpectedErrorFlags::Contains, 1);
+            FSpacetimeDBMockFFI::SimulateObjectCreated(GetHandle(), TestObjectId, TEXT("/Script/SpacetimeDB_UnrealClientTests.NoSuchClass"), TEXT("{}"));
+            Subsystem->Tick(FrameSeconds);
+            TestNull(TEXT("Spawned"), Subsystem->FindObjectById(TestObjectId));
+        });
+
+        It("should update an object created again in place", [this]()
+        {
+            USpacetimeDBTestObject* Object = CreateFromServer(TestObjectId);
+            Source->IntValue = 4242;
+            Source->Health = 1;
+
+            TestEqual(TEXT("Same object"), CreateFromServer(TestObjectId), Object);
+            if (Object)
+            {
+                TestEqual(TEXT("IntValue"), Object->IntValue, 4242);
+                TestEqual(TEXT("Health"), Object->Health, 1);
+            }
+        });
+
+        It("should forget an object the server destroys", [this]()
+        {
+            TestNotNull(TEXT("Spawned"), CreateFromServer(TestObjectId));
+
+            FSpacetimeDBMockFFI::SimulateObjectDestroyed(GetHandle(), TestObjectId);
+            Subsystem->Tick(FrameSeconds);
+            TestNull(TEXT("Destroyed"), Subsystem->FindObjectById(TestObjectId));
+        });
+    });
+
+    Describe("Property updates", [this]()
+    {
+        It("should apply binary property updates and call their RepNotify", [this]()
+        {
+            USpacetimeDBTestObject* Object = CreateFromServer(TestObjectId);
+            if (!TestNotNull(TEXT("Spawned"), Object))
+            {
+                return;
+            }
+            const int32 NotifiesBefore = Object->NumHealthNotifies;
+
+            Source->Health = 5;
+            TArray<uint8> Payload;
+            FSpacetimeDBBinaryCodec::SerializePropertyToBinary(Source, TEXT("Health"), Payload);
+            FSpacetimeDBMockFFI::SimulatePropertyUpdatedBinary(GetHandle(), TestObjectId, TEXT("Health"), Payload);
+            Subsystem->Tick(FrameSeconds);
+
+            TestEqual(TEXT("Health"), Object->Health, 5);
+            TestEqual(TEXT("Notifies"), Object->NumHealthNotifies, NotifiesBefore + 1);
+        });
+
+        It("should apply JSON property updates", [this]()
+        {
+            USpacetimeDBTestObject* Object = CreateFromServer(TestObjectId);
+            FSpacetimeDBMockFFI::SimulatePropertyUpdated(GetHandle(), TestObjectId, TEXT("StringValue"), TEXT("\"Updated\""));
+            Subsystem->Tick(FrameSeconds);
+
+            if (TestNotNull(TEXT("Spawned"), Object))
+            {
+                TestEqual(TEXT("StringValue"), Object->StringValue, FString(TEXT("Updated")));
+            }
+        });
+    });
+
+    Describe("Reconciliation", [this]()
+    {
+        It("should despawn kept objects the resubscribed rows no longer contain", [this]()
+        {
+            TestNotNull(TEXT("Spawned"), CreateFromServer(TestObjectId));
+
+            FSpacetimeDBMockFFI::SimulateDisconnected(GetHandle(), TEXT("Connection lost"));
+            Subsystem->Tick(FrameSeconds);
+            FSpacetimeDBMockFFI::SimulateConnected(GetHandle());
+            Subsystem->Tick(FrameSeconds);
+            TestNotNull(TEXT("Kept until the rows arrive"), Subsystem->FindObjectById(TestObjectId));
+
+            FSpacetimeDBMockFFI::SimulateSubscriptionApplied(GetHandle(), TEXT("object"));
+            Subsystem->Tick(FrameSeconds);
+            TestNull(TEXT("Despawned"), Subsystem->FindObjectById(TestObjectId));
+        });
+
+        It("should keep objects that arrived before the first connection was reported", [this]()
+        {
+            // Start over with a subsystem that has never been connected
+            Subsystem->Disconnect();
+            TestWorld.Destroy();
+            FSpacetimeDBMockFFI::Reset();
+            FSpacetimeDBMockFFI::bDeferConnected = true;
+            TestWorld.Create(true);
+            Subsystem = TestWorld.GameInstance->GetSubsystem<USpacetimeDBSubsystem>();
+            TestTrue(TEXT("Connect"), Subsystem->Connect(TEXT("localhost:3000"), TEXT("test_db")));
+            Subsystem->Tick(FrameSeconds);
+
+            TestNotNull(TEXT("Spawned"), CreateFromServer(TestObjectId));
+            FSpacetimeDBMockFFI::SimulateConnected(GetHandle());
+            Subsystem->Tick(FrameSeconds);
+            FSpacetimeDBMockFFI::SimulateSubscriptionApplied(GetHandle(), TEXT("object"));
+            Subsystem->Tick(FrameSeconds);
+
+            TestNotNull(TEXT("Kept"), Subsystem->FindObjectById(TestObjectId));
+        });
+    });
+
+    Describe("SendPredictedTransforms", [this]()
+    {
+        It("should resend unchanged fields once per full record interval", [this]()
+        {
+            USpacetimeDBSettings* Settings = GetMutableDefault<USpacetimeDBSettings>();
+            const int32 OldInterval = Settings->PredictionFullRecordInterval;
+            Settings->PredictionFullRecordInterval = 4;
+
+            // The same pose every time, so only the first record and the interval boundaries carry the cell
+            TArray<FPredictedTransformData> Transforms;
+            FPredictedTransformData& Data = Transforms.AddDefaulted_GetRef();
+            Data.ObjectID.Value = TestObjectId;
+            Data.Transform = FTransform(FVector(100.0, 200.0, 300.0));
+            for (int32 Sequence = 1; Sequence <= 9; ++Sequence)
+            {
+                Data.SequenceNumber = Sequence;
+                TestTrue(TEXT("Sent"), Subsystem->SendPredictedTransforms(Transforms));
+            }
+            Settings->PredictionFullRecordInterval = OldInterval;
+
+            const FSpacetimeDBMockConnection* Connection = FSpacetimeDBMockFFI::FindConnection(GetHandle());
+            if (!TestNotNull(TEXT("Connection"), Connection) || !TestEqual(TEXT("Batches"), Connection->PredictedTransformBatches.Num(), 9))
+            {
+                return;
+            }
+
+            TArray<int32> FullSequences;
+            for (const TArray<uint8>& Batch : Connection->PredictedTransformBatches)
+            {
+                // Skip the cell size and velocity step in front of the records
+                FSpacetimeDBBinaryReader Reader(Batch.GetData(), Batch.Num());
+                Reader.ReadFloat();
+                Reader.ReadFloat();
+                FSpacetimeDBQuantizedTransform Record;
+                if (TestTrue(TEXT("Record read"), FSpacetimeDBTypeConversions::ReadQuantizedTransform(Reader, Record))
+                    && EnumHasAnyFlags(Record.Flags, ESpacetimeDBQuantizedTransformFlags::HasCell))
+                {
+                    FullSequences.Add(static_cast<int32>(Record.Sequence));
+                }
+            }
+            TestEqual(TEXT("Sequences with the cell"), FullSequences, TArray<int32>({ 1, 4, 8 }));
+        });
+
+        It("should diff a record against an earlier record for the object in the same batch", [this]()
+        {
+            const FVector Home(100.0, 200.0, 300.0);
+            const FVector Away = Home + FVector(USpacetimeDBSettings::Get()->PredictionWorldCellSize * 2.0, 0.0, 0.0);
+
+            TArray<FPredictedTransformData> Transforms;
+            FPredictedTransformData& First = Transforms.AddDefaulted_GetRef();
+            First.ObjectID.Value = TestObjectId;
+            First.SequenceNumber = 1;
+            First.Transform = FTransform(Home);
+            TestTrue(TEXT("Baseline sent"), Subsystem->SendPredictedTransforms(Transforms));
+
+            // Leaves the cell and comes back within one batch; the return must carry the cell again
+            Transforms.Reset();
+            for (int32 Sequence = 2; Sequence <= 3; ++Sequence)
+            {
+                FPredictedTransformData& Data = Transforms.AddDefaulted_GetRef();
+                Data.ObjectID.Value = TestObjectId;
+                Data.SequenceNumber = Sequence;
+                Data.Transform = FTransform(Sequence == 2 ? Away : Home);
+            }
+            TestTrue(TEXT("Batch sent"), Subsystem->SendPredictedTransforms(Transforms));
+
+            const FSpacetimeDBMockConnection* Connection = FSpacetimeDBMockFFI::FindConnection(GetHandle());
+            if (!TestNotNull(TEXT("Connection"), Connection) || !TestEqual(TEXT("Batches"), Connection->PredictedTransformBatches.Num(), 2))
+            {
+                return;
+            }
+
+            const TArray<uint8>& Batch = Connection->PredictedTransformBatches[1];
+            FSpacetimeDBBinaryReader Reader(Batch.GetData(), Batch.Num());
+            Reader.ReadFloat();
+            Reader.ReadFloat();
+            FSpacetimeDBQuantizedTransform Record;
+            TestTrue(TEXT("Away read"), FSpacetimeDBTypeConversions::ReadQuantizedTransform(Reader, Record));
+            TestTrue(TEXT("Away has the cell"), EnumHasAnyFlags(Record.Flags, ESpacetimeDBQuantizedTransformFlags::HasCell));
+            TestTrue(TEXT("Return read"), FSpacetimeDBTypeConversions::ReadQuantizedTransform(Reader, Record));
+            TestTrue(TEXT("Return has the cell"), EnumHasAnyFlags(Record.Flags, ESpacetimeDBQuantizedTransformFlags::HasCell));
+        });
+    });
+
+    Describe("CallReducer", [this]()
+    {
+        It("should send the calls of a frame as one batch in call order", [this]()
+        {
+            USpacetimeDBSettings* Settings = GetMutableDefault<USpacetimeDBSettings>();
+            const bool bWasBatching = Settings->bBatchReducerCalls;
+            Settings->bBatchReducerCalls = true;
+
+            TestTrue(TEXT("First"), Subsystem->CallReducer(TEXT("first"), TEXT("[1]")));
+            TestTrue(TEXT("Second"), Subsystem->CallReducer(TEXT("second"), TEXT("[2]")));
+            TestTrue(TEXT("Third"), Subsystem->CallReducer(TEXT("third"), TEXT("[3]")));
+            Subsystem->Tick(FrameSeconds);
+
+            Settings->bBatchReducerCalls = bWasBatching;
+
+            const FSpacetimeDBMockConnection* Connection = FSpacetimeDBMockFFI::FindConnection(GetHandle());
+            if (TestNotNull(TEXT("Connection"), Connection) && TestEqual(TEXT("Calls"), Connection->ReducerCalls.Num(), 3))
+            {
+                TestEqual(TEXT("Batches"), Connection->NumReducerBatches, 1);
+                TestEqual(TEXT("First name"), Connection->ReducerCalls[0].Key, FString(TEXT("first")));
+                TestEqual(TEXT("Third name"), Connection->ReducerCalls[2].Key, FString(TEXT("third")));
+                TestEqual(TEXT("Third args"), Connection->ReducerCalls[2].Value, FString(TEXT("[3]")));
+            }
+        });
+
+        It("should refuse calls while disconnected", [this]()
+        {
+            Subsystem->Disconnect();
+            Subsystem->Tick(FrameSeconds);
+
+            AddExpectedError(TEXT("Not connected"), EAutomationExpectedErrorFlags::Contains, 0);
+            TestFalse(TEXT("Call"), Subsystem->CallReducer(TEXT("first"), TEXT("[]")));
+        });
+    });
+
+    AfterEach([this]()
+    {
+        Subsystem->Disconnect();
+        Subsystem = nullptr;
+        Source = nullptr;
+        TestWorld.Destroy();
+        FSpacetimeDBMockFFI::Reset();
+    });
+}
+
+#endif // SPACETIMEDB_MOCK_FFI
@@ -0,0 +1,34 @@
+// Copyright SpacetimeDB. All Rights Reserved.
+
+using System;
+using System.IO;
+using UnrealBuildTool;
+
+public class SpacetimeDB_UnrealClientTests : ModuleRules
+{
+    public SpacetimeDB_UnrealClientTests(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PrivateDependencyModuleNames.AddRange(new string[]
+        {
+            "Core",
+            "CoreUObject",
+            "Engine",
+            "Json",
+            "Projects",
+            "SpacetimeDB_UnrealClient"
+        });
+
+        // ffi.h is generated by cxx when the client library is built
+        PrivateIncludePaths.Add(Path.Combine(PluginDirectory, "ClientModule", "target", "cxxbridge"));
+
+        // With SPACETIMEDB_MOCK_FFI=1 in the environment, Private/Mock provides the client library's
+        // symbols instead of stdb_client, so the specs that drive the subsystem run without a server.
+        // The client module's rules leave stdb_client out on the same condition. The mock replaces
+        // the library at link time, which only works when everything links into one binary.
+        bool bUseMockFFI = Environment.GetEnvironmentVariable("SPACETIMEDB_MOCK_FFI") == "1"
+            && Target.LinkType == TargetLinkType.Monolithic;
+        PublicDefinitions.Add("SPACETIMEDB_MOCK_FFI=" + (bUseMockFFI ? "1" : "0"));
+    }
+}